@@ -54,6 +54,9 @@ function print_help {
     echo "        For macOS, this builds universal binaries for both Apple silicon and Intel-based Macs."
     echo "    -w"
     echo "        Build Web documents (compiles .md.html files to .html)."
+    echo "    -x"
+    echo "        Build the WebGL flavor with wasm SIMD and pthreads."
+    echo "        The resulting module requires a cross-origin isolated page (SharedArrayBuffer)."
     echo "    -k sample1,sample2,..."
     echo "        When building for Android, also build select sample APKs."
     echo "        sampleN is an Android sample, e.g., sample-gltf-viewer."
@@ -289,6 +292,7 @@ function build_webgl_with_target {
             -DCMAKE_BUILD_TYPE="$1" \
             -DCMAKE_INSTALL_PREFIX="../webgl-${lc_target}/filament" \
             -DWEBGL=1 \
+            ${WEBGL_SIMD_THREADS_OPTION} \
             ../..
         ln -sf "out/cmake-webgl-${lc_target}/compile_commands.json" \
            ../../compile_commands.json
@@ -776,7 +780,7 @@ function check_debug_release_build {
 
 pushd "$(dirname "$0")" > /dev/null
 
-while getopts ":hacCfgijmp:q:uvslwtedk:b" opt; do
+while getopts ":hacCfgijmp:q:uvslwtedk:bx" opt; do
     case ${opt} in
         h)
             print_help
@@ -918,6 +922,10 @@ while getopts ":hacCfgijmp:q:uvslwtedk:b" opt; do
         b)  ASAN_UBSAN_OPTION="-DFILAMENT_ENABLE_ASAN_UBSAN=ON"
             echo "Enabled ASAN/UBSAN"
             ;;
+        x)
+            WEBGL_SIMD_THREADS_OPTION="-DWEBGL_SIMD=ON -DWEBGL_PTHREADS=ON"
+            echo "Building the WebGL flavor with wasm SIMD and pthreads."
+            ;;
         \?)
             echo "Invalid option: -${OPTARG}" >&2
             echo ""
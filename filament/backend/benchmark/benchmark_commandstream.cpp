@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "noop/NoopDriver.h"
+
+#include "DriverBase.h"
+
+#include "private/backend/CircularBuffer.h"
+#include "private/backend/DriverApi.h"
+#include "private/backend/HandleAllocator.h"
+
+#include <backend/DriverEnums.h>
+#include <backend/Handle.h>
+#include <backend/PipelineState.h>
+#include <backend/TargetBufferInfo.h>
+
+#include <array>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace filament;
+using namespace filament::backend;
+
+/*
+ * These benchmarks measure the CPU cost of the backend command stream in isolation: each
+ * iteration replays a deterministic synthetic frame against the noop driver, which executes
+ * every command without touching any graphics API. This isolates CommandStream encode/decode
+ * overhead from both the GPU and application variance, so the numbers are stable enough to
+ * track in CI and to compare across commits.
+ *
+ * Commands are destroyed in-place as they execute, so a recorded buffer cannot be replayed
+ * twice; each iteration re-records the frame. The encode-only benchmark drains the buffer
+ * outside of the timed section, and can be subtracted from the encode+execute numbers to
+ * estimate the decode cost alone.
+ */
+
+class CommandStreamFixture : public benchmark::Fixture {
+protected:
+    // large enough for the biggest synthetic frame, x3 as recommended by CircularBuffer
+    static constexpr size_t CIRCULAR_BUFFER_SIZE = 32u * 1024u * 1024u;
+
+    void SetUp(benchmark::State& state) override {
+        mDriver.reset(NoopDriver::create());
+        mBuffer = std::make_unique<CircularBuffer>(CIRCULAR_BUFFER_SIZE);
+        mStream = std::make_unique<CommandStream>(*mDriver, *mBuffer);
+        DriverApi& api = *mStream;
+        mSwapChain = api.createSwapChainHeadless(1920, 1080, 0);
+        mRenderTarget = api.createRenderTarget(
+                TargetBufferFlags::COLOR, 1920, 1080, 1, {}, {}, {});
+        mRenderPrimitive = api.createRenderPrimitive({}, {},
+                PrimitiveType::TRIANGLES, 0, 0, 2, 3);
+        for (auto& ubo : mUniformBuffers) {
+            ubo = api.createBufferObject(16384,
+                    BufferObjectBinding::UNIFORM, BufferUsage::DYNAMIC);
+        }
+        drain();
+    }
+
+    void TearDown(benchmark::State& state) override {
+        DriverApi& api = *mStream;
+        for (auto& ubo : mUniformBuffers) {
+            api.destroyBufferObject(ubo);
+        }
+        api.destroyRenderPrimitive(mRenderPrimitive);
+        api.destroyRenderTarget(mRenderTarget);
+        api.destroySwapChain(mSwapChain);
+        drain();
+        api.terminate();
+        mStream.reset();
+        mBuffer.reset();
+        mDriver.reset();
+    }
+
+    // records a frame's worth of commands, approximating what the engine emits per draw call
+    void recordFrame(size_t const drawCount) noexcept {
+        DriverApi& api = *mStream;
+        api.makeCurrent(mSwapChain, mSwapChain);
+        api.beginFrame(0, 0);
+        api.beginRenderPass(mRenderTarget, {});
+        for (size_t i = 0; i < drawCount; i++) {
+            api.bindUniformBuffer(0, mUniformBuffers[i % mUniformBuffers.size()]);
+            api.draw({}, mRenderPrimitive, 1);
+        }
+        api.endRenderPass();
+        api.commit(mSwapChain);
+        api.endFrame(0);
+    }
+
+    // executes everything recorded so far, mimicking CommandBufferQueue::flush() followed
+    // by the driver-thread side of FEngine::execute(), without the queue in between
+    void drain() noexcept {
+        CircularBuffer& buffer = *mBuffer;
+        if (buffer.empty()) {
+            return;
+        }
+        new(buffer.allocate(sizeof(NoopCommand))) NoopCommand(nullptr);
+        void* const begin = buffer.getTail();
+        buffer.circularize();
+        mStream->execute(begin);
+    }
+
+    std::unique_ptr<Driver> mDriver;
+    std::unique_ptr<CircularBuffer> mBuffer;
+    std::unique_ptr<CommandStream> mStream;
+    SwapChainHandle mSwapChain;
+    RenderTargetHandle mRenderTarget;
+    RenderPrimitiveHandle mRenderPrimitive;
+    std::array<BufferObjectHandle, 8> mUniformBuffers;
+};
+
+BENCHMARK_DEFINE_F(CommandStreamFixture, frameEncode)(benchmark::State& state) {
+    size_t const drawCount = state.range(0);
+    for (auto _ : state) {
+        recordFrame(drawCount);
+        state.PauseTiming();
+        drain();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * drawCount);
+}
+
+BENCHMARK_DEFINE_F(CommandStreamFixture, frameEncodeExecute)(benchmark::State& state) {
+    size_t const drawCount = state.range(0);
+    for (auto _ : state) {
+        recordFrame(drawCount);
+        drain();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * drawCount);
+}
+
+BENCHMARK_REGISTER_F(CommandStreamFixture, frameEncode)
+        ->RangeMultiplier(4)->Range(256, 16384);
+
+BENCHMARK_REGISTER_F(CommandStreamFixture, frameEncodeExecute)
+        ->RangeMultiplier(4)->Range(256, 16384);
+
+/*
+ * Handle-allocator churn: the OpenGL and Vulkan drivers allocate their concrete object
+ * state from a HandleAllocator; this measures its steady-state cost with a large live set,
+ * replacing a pseudo-randomly chosen live handle each time, the way a scene with streaming
+ * resources behaves. The GL pool geometry is used, the other backends only differ by the
+ * size of the largest pool.
+ */
+static void handleAllocatorChurn(benchmark::State& state) {
+    size_t const liveCount = state.range(0);
+    HandleAllocatorGL allocator("benchmark-handles", 4u * 1024u * 1024u);
+
+    std::vector<Handle<HwBufferObject>> handles(liveCount);
+    for (auto& handle : handles) {
+        handle = allocator.allocateAndConstruct<HwBufferObject>(256);
+    }
+
+    std::default_random_engine gen{ 0xf10a31 }; // NOLINT
+    std::uniform_int_distribution<size_t> rand(0, liveCount - 1);
+
+    for (auto _ : state) {
+        size_t const i = rand(gen);
+        allocator.deallocate(handles[i]);
+        handles[i] = allocator.allocateAndConstruct<HwBufferObject>(256);
+    }
+
+    for (auto& handle : handles) {
+        allocator.deallocate(handle);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(handleAllocatorChurn)->RangeMultiplier(4)->Range(1024, 16384);
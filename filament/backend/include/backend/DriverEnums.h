@@ -82,6 +82,24 @@ static constexpr uint64_t SWAP_CHAIN_CONFIG_SRGB_COLORSPACE     = 0x10;
  */
 static constexpr uint64_t SWAP_CHAIN_HAS_STENCIL_BUFFER         = 0x20;
 
+/**
+ * Indicates that the images of a headless SwapChain should be allocated from external memory,
+ * so that they can be exported to other device-local consumers (e.g. CUDA) without a CPU copy.
+ *
+ * This is only supported by the Vulkan backend, on platforms with VK_KHR_external_memory_fd.
+ */
+static constexpr uint64_t SWAP_CHAIN_CONFIG_EXPORTABLE_IMAGES   = 0x40;
+
+/**
+ * Indicates that the SwapChain should minimize presentation latency: after queuing a present,
+ * the backend waits for the frame to actually reach the display before starting the next one,
+ * capping the in-flight queue depth at one frame.
+ *
+ * This is only supported by the Vulkan backend, on devices with VK_KHR_present_wait; it is
+ * ignored elsewhere.
+ */
+static constexpr uint64_t SWAP_CHAIN_CONFIG_MINIMIZE_LATENCY    = 0x80;
+
 
 static constexpr size_t MAX_VERTEX_ATTRIBUTE_COUNT  = 16;   // This is guaranteed by OpenGL ES.
 static constexpr size_t MAX_SAMPLER_COUNT           = 62;   // Maximum needed at feature level 3.
@@ -658,7 +676,7 @@ enum class TextureFormat : uint16_t {
 };
 
 //! Bitmask describing the intended Texture Usage
-enum class TextureUsage : uint8_t {
+enum class TextureUsage : uint16_t {
     NONE                = 0x00,
     COLOR_ATTACHMENT    = 0x01,                     //!< Texture can be used as a color attachment
     DEPTH_ATTACHMENT    = 0x02,                     //!< Texture can be used as a depth attachment
@@ -668,6 +686,8 @@ enum class TextureUsage : uint8_t {
     SUBPASS_INPUT       = 0x20,                     //!< Texture can be used as a subpass input
     BLIT_SRC            = 0x40,                     //!< Texture can be used the source of a blit()
     BLIT_DST            = 0x80,                     //!< Texture can be used the destination of a blit()
+    TRANSIENT           = 0x100,                    //!< Texture is a short-lived frame graph resource, backends may use a heap allocation
+    MEMORYLESS          = 0x200,                    //!< Texture is only ever used as an attachment, backends may skip the main-memory backing on tile-based GPUs
     DEFAULT             = UPLOADABLE | SAMPLEABLE   //!< Default texture usage
 };
 
@@ -1095,6 +1115,21 @@ struct RenderPassFlags {
     TargetBufferFlags discardEnd;
 };
 
+/**
+ * Requested fragment shading rate, as a fragment footprint in pixels. This is a hint: backends
+ * without coarse shading support (or without support for a particular rate) clamp it to the
+ * nearest supported rate, down to ONE_BY_ONE.
+ */
+enum class ShadingRate : uint8_t {
+    ONE_BY_ONE,     //!< one fragment shader invocation per pixel (default)
+    ONE_BY_TWO,     //!< one invocation per 1x2 pixel block
+    TWO_BY_ONE,     //!< one invocation per 2x1 pixel block
+    TWO_BY_TWO,     //!< one invocation per 2x2 pixel block
+    TWO_BY_FOUR,    //!< one invocation per 2x4 pixel block
+    FOUR_BY_TWO,    //!< one invocation per 4x2 pixel block
+    FOUR_BY_FOUR    //!< one invocation per 4x4 pixel block
+};
+
 /**
  * Parameters of a render pass.
  */
@@ -1132,6 +1167,9 @@ struct RenderPassParams {
 
     static constexpr uint16_t READONLY_DEPTH = 1 << 0;
     static constexpr uint16_t READONLY_STENCIL = 1 << 1;
+
+    //! Fragment shading rate applied to every draw of this pass (a hint, see ShadingRate)
+    ShadingRate shadingRate = ShadingRate::ONE_BY_ONE;
 };
 
 struct PolygonOffset {
@@ -1189,6 +1227,23 @@ static_assert(sizeof(StencilState::StencilOperations) == 5u,
 static_assert(sizeof(StencilState) == 12u,
         "StencilState size not what was intended");
 
+/**
+ * Counters measuring how effective the backend's redundant-state elimination is. "Avoided"
+ * counts binds that were skipped because the cached state already matched, "issued" counts
+ * binds that actually reached the underlying API. The counters cover the last completed
+ * frame. Only the OpenGL backend populates them; other backends return zeros.
+ */
+struct StateCacheStatistics {
+    uint32_t textureBindsAvoided = 0;
+    uint32_t textureBindsIssued = 0;
+    uint32_t samplerBindsAvoided = 0;
+    uint32_t samplerBindsIssued = 0;
+    uint32_t programBindsAvoided = 0;
+    uint32_t programBindsIssued = 0;
+    uint32_t bufferBindsAvoided = 0;
+    uint32_t bufferBindsIssued = 0;
+};
+
 using FrameScheduledCallback = void(*)(PresentCallable callable, void* user);
 
 enum class Workaround : uint16_t {
@@ -1208,7 +1263,10 @@ enum class Workaround : uint16_t {
     POWER_VR_SHADER_WORKAROUNDS,
     // The driver has some threads pinned, and we can't easily know on which core, it can hurt
     // performance more if we end-up pinned on the same one.
-    DISABLE_THREAD_AFFINITY
+    DISABLE_THREAD_AFFINITY,
+    // Running color grading as a subpass of the TAA pass degrades performance, use a
+    // separate full-screen pass instead.
+    DISABLE_SUBPASS_WITH_TAA
 };
 
 } // namespace filament::backend
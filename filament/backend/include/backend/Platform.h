@@ -22,6 +22,7 @@
 #include <backend/DriverEnums.h>
 
 #include <utils/compiler.h>
+#include <utils/CString.h>
 #include <utils/Invocable.h>
 
 namespace filament::backend {
@@ -53,6 +54,24 @@ public:
          * a draw call. 0 disables completely. Currently only respected by the Metal backend.
          */
         size_t textureUseAfterFreePoolSize = 0;
+
+        /*
+         * maximum number of shader programs kept resident in the driver. Above this limit,
+         * programs that haven't been used for a while have their driver-side object destroyed
+         * and are transparently re-created from their binary on next use. 0 disables program
+         * eviction. Currently only respected by the OpenGL backend.
+         */
+        uint32_t residentProgramLimit = 0;
+
+        /*
+         * selects the physical device used by the backend when the system has several. The
+         * first device whose name contains gpuPreferenceDeviceName is selected when the string
+         * is non-empty, otherwise gpuPreferenceIndex selects the device by enumeration order;
+         * a negative index means no preference. Currently only respected by the Vulkan
+         * backend.
+         */
+        int8_t gpuPreferenceIndex = -1;
+        utils::CString gpuPreferenceDeviceName;
     };
 
     Platform() noexcept;
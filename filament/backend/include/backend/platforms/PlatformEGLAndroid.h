@@ -19,6 +19,8 @@
 
 #include <backend/platforms/PlatformEGL.h>
 
+struct AHardwareBuffer;
+
 namespace filament::backend {
 
 class ExternalStreamManagerAndroid;
@@ -73,8 +75,26 @@ protected:
     AcquiredImage transformAcquiredImage(AcquiredImage source) noexcept override;
 
 private:
+    /*
+     * Cache of EGLImages keyed by AHardwareBuffer. Camera and video pipelines rotate through a
+     * small fixed set of buffers, so caching the EGLImage per buffer slot removes the per-frame
+     * create/destroy churn. Each entry holds a reference on its AHardwareBuffer, so a cached
+     * pointer cannot be recycled for a different buffer while the entry exists.
+     */
+    struct AcquiredImageCacheEntry {
+        AHardwareBuffer* buffer = nullptr;
+        EGLImageKHR image = EGL_NO_IMAGE_KHR;
+        uint32_t lastUsed = 0;
+    };
+    static constexpr size_t ACQUIRED_IMAGE_CACHE_MAX_SIZE = 8;
+
+    EGLImageKHR getCachedEGLImage(AHardwareBuffer* buffer, EGLClientBuffer clientBuffer) noexcept;
+    void clearAcquiredImageCache() noexcept;
+
     int mOSVersion;
     ExternalStreamManagerAndroid& mExternalStreamManager;
+    std::vector<AcquiredImageCacheEntry> mAcquiredImageCache;
+    uint32_t mAcquiredImageCacheAge = 0;
 };
 
 } // namespace filament::backend
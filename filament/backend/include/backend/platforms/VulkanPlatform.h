@@ -77,6 +77,25 @@ public:
         VkExtent2D extent = {0, 0};
     };
 
+    /**
+     * Describes an externally-produced image backed by a dma-buf, as produced by video decoders
+     * and camera stacks on Linux/Android. A pointer to this struct is what the client passes to
+     * Texture::setExternalImage() when running on the Vulkan backend. The image is imported
+     * zero-copy via VK_EXT_external_memory_dma_buf; if the device does not support that
+     * extension, the import is silently ignored and the texture keeps its previous contents.
+     *
+     * The fd is duplicated by the import (per the Vulkan spec the implementation takes ownership
+     * of the given fd on success), so the client should pass a dup() of its own fd if it intends
+     * to keep using it.
+     */
+    struct ExternalImageDmaBuf {
+        int fd = -1;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        uint64_t allocationSize = 0;
+    };
+
     VulkanPlatform();
 
     ~VulkanPlatform() override;
@@ -162,6 +181,26 @@ public:
      */
     virtual VkResult present(SwapChainPtr handle, uint32_t index, VkSemaphore finishedDrawing);
 
+    /**
+     * Export the memory backing one of the swapchain's color images as a POSIX fd, suitable for
+     * import by another device-local API (e.g. CUDA). Only valid for headless swapchains created
+     * with SWAP_CHAIN_CONFIG_EXPORTABLE_IMAGES, on platforms with VK_KHR_external_memory_fd.
+     * Each call creates a new fd, owned by the caller.
+     * @param handle   The handle returned by createSwapChain()
+     * @param index    Index that corresponding to an image in the `SwapChainBundle.colors` array.
+     * @return         The fd, or -1 if the swapchain's images are not exportable.
+     */
+    virtual int32_t getSwapChainImageFd(SwapChainPtr handle, uint32_t index);
+
+    /**
+     * Query the acquire-to-display latency of the last presented frame. Only meaningful for
+     * surface swapchains created with SWAP_CHAIN_CONFIG_MINIMIZE_LATENCY on devices with
+     * VK_KHR_present_wait; without it the measurement ends at present submission.
+     * @param handle   The handle returned by createSwapChain()
+     * @return         The latency in nanoseconds, or 0 if unknown.
+     */
+    virtual uint64_t getFrameLatencyNanos(SwapChainPtr handle);
+
     /**
      * Check if the surface size has changed.
      * @param handle             The handle returned by createSwapChain()
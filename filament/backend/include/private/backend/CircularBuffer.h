@@ -26,11 +26,16 @@ namespace filament::backend {
 
 class CircularBuffer {
 public:
-    // bufferSize: total buffer size.
+    // bufferSize: steady-state buffer size.
     //      This must be at least 2*requiredSize to avoid blocking on flush, however
     //      because sometimes the display can get ahead of the render() thread, it's good
     //      to set it to 3*requiredSize to avoid blocking the render thread (usually the UI thread).
-    explicit CircularBuffer(size_t bufferSize);
+    // reservedSize: total virtual capacity of the buffer. The span beyond bufferSize is
+    //      only committed by the OS while a burst of commands is outstanding, and released
+    //      again once it has drained (see rewind()), so it doesn't add to steady-state
+    //      memory usage. Clamped to bufferSize when smaller, or when on-demand paging
+    //      isn't available.
+    explicit CircularBuffer(size_t bufferSize, size_t reservedSize = 0);
 
     // can't be moved or copy-constructed
     CircularBuffer(CircularBuffer const& rhs) = delete;
@@ -48,9 +53,17 @@ public:
         return cur;
     }
 
-    // Total size of circular buffer
+    // Total (reserved) size of circular buffer
     size_t size() const noexcept { return mSize; }
 
+    // steady-state size of the buffer, the span past it only absorbs bursts
+    size_t getSteadySize() const noexcept { return mSteadySize; }
+
+    // current offset of the head from the start of the buffer
+    size_t getHeadOffset() const noexcept {
+        return size_t(uintptr_t(mHead) - uintptr_t(mData));
+    }
+
     // returns true if the buffer is empty (e.g. after calling flush)
     bool empty() const noexcept { return mTail == mHead; }
 
@@ -61,11 +74,20 @@ public:
     // call at least once every getRequiredSize() bytes allocated from the buffer
     void circularize() noexcept;
 
+    // Wraps the head back to the start of the buffer without going through the mirror,
+    // forfeiting the rest of the current lap; returns the number of forfeited bytes, which
+    // the caller must account for as used space (the consumer refunds them when it follows
+    // the wrap). Only legal between slices, with the head within [steady size, capacity].
+    // This is what keeps the burst span untouched in steady state; pages committed by a
+    // previous burst that this lap didn't reach are released back to the OS here.
+    size_t rewind() noexcept;
+
     static size_t getBlockSize() noexcept { return sPageSize; }
 
 private:
     void* alloc(size_t size) noexcept;
     void dealloc() noexcept;
+    void releaseBurstPages(size_t begin, size_t end) noexcept;
 
     // pointer to the beginning of the circular buffer (constant)
     void* mData = nullptr;
@@ -74,6 +96,12 @@ private:
     // size of the circular buffer (constant)
     size_t mSize = 0;
 
+    // steady-state size of the circular buffer (constant)
+    size_t mSteadySize = 0;
+
+    // how far past the start of the buffer the current and previous laps reached
+    size_t mBurstExtent = 0;
+
     // pointer to the beginning of recorded data
     void* mTail = nullptr;
 
@@ -23,37 +23,73 @@
 #include <utils/Condition.h>
 #include <utils/Mutex.h>
 
+#include <atomic>
 #include <vector>
 
+// for gtest
+class CommandBufferQueueTest;
+
 namespace filament::backend {
 
 /*
- * A producer-consumer command queue that uses a CircularBuffer as main storage
+ * A producer-consumer command queue that uses a CircularBuffer as main storage.
+ *
+ * There is exactly one producer (the application thread calling flush()) and one
+ * consumer (the driver thread calling waitForCommands() / releaseBuffer()), so the
+ * handoff is implemented as a wait-free SPSC ring of Slices; mLock/mCondition are
+ * only used for sleeping when one side genuinely has to wait (utils::Condition is
+ * futex-based on Android).
  */
 class CommandBufferQueue {
+    friend class ::CommandBufferQueueTest;
+
     struct Slice {
         void* begin;
         void* end;
     };
 
+    // Virtual capacity reserved beyond bufferSize to absorb command bursts (e.g. loading
+    // spikes). It is only committed by the OS while a burst is outstanding and released
+    // once it has drained, so it doesn't affect steady-state memory usage.
+    static constexpr size_t BURST_CAPACITY_FACTOR = 8;
+
     const size_t mRequiredSize;
 
     CircularBuffer mCircularBuffer;
 
+    // slices published by flush() and consumed by waitForCommands(). Only the producer
+    // writes mSliceHead, only the consumer writes mSliceTail.
+    static constexpr uint32_t SLICE_COUNT = 64;  // must be a power-of-two
+    Slice mSlices[SLICE_COUNT];
+    std::atomic<uint32_t> mSliceHead{ 0 };
+    mutable std::atomic<uint32_t> mSliceTail{ 0 };
+
     // space available in the circular buffer
+    std::atomic<size_t> mFreeSpace{ 0 };
+
+    // end of the last released slice, used to detect buffer wraps. Consumer side only.
+    void* mLastReleasedEnd = nullptr;
 
+    // only used for going to sleep; never touched on the fast path
     mutable utils::Mutex mLock;
     mutable utils::Condition mCondition;
-    mutable std::vector<Slice> mCommandBuffersToExecute;
-    size_t mFreeSpace = 0;
+    std::atomic<bool> mProducerSleeping{ false };
+    mutable std::atomic<bool> mConsumerSleeping{ false };
+
     size_t mHighWatermark = 0;
-    uint32_t mExitRequested = 0;
+    const bool mConsumerWaits;
+    std::atomic<uint32_t> mExitRequested{ 0 };
 
     static constexpr uint32_t EXIT_REQUESTED = 0x31415926;
 
 public:
     // requiredSize: guaranteed available space after flush()
-    CommandBufferQueue(size_t requiredSize, size_t bufferSize);
+    // bufferSize: steady-state size of the circular buffer; bursts can use up to
+    //             BURST_CAPACITY_FACTOR times this much before the producer blocks.
+    // consumerWaits: whether waitForCommands() blocks until commands are available. Pass
+    //                false when producer and consumer run on the same thread, where
+    //                sleeping could never be interrupted.
+    CommandBufferQueue(size_t requiredSize, size_t bufferSize, bool consumerWaits = true);
     ~CommandBufferQueue();
 
     CircularBuffer& getCircularBuffer() { return mCircularBuffer; }
@@ -255,6 +255,40 @@ public:
 
     void execute(void* buffer);
 
+    /*
+     * Parallel command recording
+     * --------------------------
+     * The CircularBuffer can only be written from a single thread, which serializes
+     * command generation. To spread recording across JobSystem workers, the recording
+     * thread carves fixed-size segments out of the stream with beginParallelRecording();
+     * each worker then binds one segment with bindSegment() and records commands normally
+     * into its private region. Segments are laid out in the stream in index order, so the
+     * merged execution order is deterministic regardless of which worker finishes first.
+     * After all workers have joined, endParallelRecording() (again on the recording
+     * thread) stitches the unused tail of each segment with a NoopCommand.
+     *
+     * Only asynchronous commands may be recorded from a worker; the synchronous and
+     * "return" driver APIs call into the Driver immediately and must stay on the
+     * recording thread.
+     */
+    struct Segment {
+        char* current = nullptr;    // where the next command is recorded
+        char* end = nullptr;        // exclusive; leaves room for the trailing NoopCommand
+        char* tail = nullptr;       // actual end of this segment's storage
+    };
+
+    // Carves `count` contiguous segments of `size` bytes each out of the stream.
+    // Must be called from the recording thread.
+    void beginParallelRecording(Segment* segments, size_t count, size_t size) noexcept;
+
+    // Routes all subsequent commands recorded from the calling thread into `segment`.
+    // Pass nullptr to restore the default (direct) recording path.
+    static void bindSegment(Segment* segment) noexcept;
+
+    // Stitches the segments back into the stream. Must be called from the recording
+    // thread, after all workers are done recording.
+    void endParallelRecording(Segment* segments, size_t count) noexcept;
+
     /*
      * queueCommand() allows to queue a lambda function as a command.
      * This is much less efficient than using the Driver* API.
@@ -278,10 +312,21 @@ public:
 
 private:
     inline void* allocateCommand(size_t size) {
+        Segment* const segment = sCurrentSegment;
+        if (UTILS_UNLIKELY(segment)) {
+            // worker thread, recording into its private segment
+            char* const p = segment->current;
+            assert_invariant(p + size <= segment->end);
+            segment->current = p + size;
+            return p;
+        }
         assert_invariant(utils::ThreadUtils::isThisThread(mThreadId));
         return mCurrentBuffer.allocate(size);
     }
 
+    // segment the calling thread records into, or nullptr for the default path
+    static thread_local Segment* sCurrentSegment;
+
     // We use a copy of Dispatcher (instead of a pointer) because this removes one dereference
     // when executing driver commands.
     Driver& UTILS_RESTRICT mDriver;
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_BACKEND_PRIVATE_DISKBLOBCACHE_H
+#define TNT_FILAMENT_BACKEND_PRIVATE_DISKBLOBCACHE_H
+
+#include <backend/DriverEnums.h>
+
+#include <string>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament::backend {
+
+/*
+ * A simple file-per-entry blob cache used to persist the backend's program/pipeline binaries
+ * across runs (see Platform::setBlobFunc). Each entry lives in a file named after a hash of its
+ * key; the full key is stored in the file and verified on retrieval, so a hash collision only
+ * costs us a cache miss.
+ *
+ * Entries are keyed by backend (and cache format version) only; GL program binaries and Vulkan
+ * pipeline-cache blobs embed their own driver identification and are rejected by the driver
+ * when stale, so a driver update simply results in cache misses rather than corruption.
+ *
+ * insert() and retrieve() can be called concurrently from any thread; writes go through a
+ * temporary file followed by a rename, so readers never observe a partially written entry.
+ */
+class DiskBlobCache {
+public:
+    DiskBlobCache(const char* directory, Backend backend) noexcept;
+
+    // insert or replace the value associated with the given key. failures (e.g. disk full,
+    // directory missing) are silently ignored, the cache is best-effort.
+    void insert(const void* key, size_t keySize,
+            const void* value, size_t valueSize) const noexcept;
+
+    // returns the size of the value associated with the given key, or 0 if not found. the value
+    // is copied into the supplied buffer only if it fits entirely.
+    size_t retrieve(const void* key, size_t keySize,
+            void* value, size_t valueSize) const noexcept;
+
+private:
+    std::string pathForKey(const void* key, size_t keySize) const noexcept;
+
+    std::string mDirectory;
+    uint64_t mSalt;
+};
+
+} // namespace filament::backend
+
+#endif // TNT_FILAMENT_BACKEND_PRIVATE_DISKBLOBCACHE_H
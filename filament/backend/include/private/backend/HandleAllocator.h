@@ -21,8 +21,14 @@
 
 #include <utils/Allocator.h>
 #include <utils/Log.h>
+#include <utils/Mutex.h>
 #include <utils/compiler.h>
 #include <tsl/robin_map.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 
 #if !defined(NDEBUG) && UTILS_HAS_RTTI
@@ -213,10 +219,58 @@ private:
     // template <int P0, int P1, int P2>
     class Allocator {
         friend class HandleAllocator;
-        utils::PoolAllocator<P0, 16>   mPool0;
-        utils::PoolAllocator<P1, 16>   mPool1;
-        utils::PoolAllocator<P2, 16>   mPool2;
+
+#ifndef NDEBUG
+        // in debug builds the arena is synchronized with a mutex (see HandleArena below),
+        // so the pools can use the plain free list
+        template<size_t SIZE>
+        using Pool = utils::PoolAllocator<SIZE, 16>;
+#else
+        // lock-free free lists: the allocation hot path doesn't take any lock
+        template<size_t SIZE>
+        using Pool = utils::PoolAllocator<SIZE, 16, 0, utils::AtomicFreeList>;
+#endif
+
+        // pools are grown on demand in slabs of this size, carved out of the area, so
+        // their relative sizes adapt to the actual workload instead of being fixed
+        static constexpr size_t SLAB_SIZE = 16384;
+
+        Pool<P0> mPool0;
+        Pool<P1> mPool1;
+        Pool<P2> mPool2;
+        char* mSlabCurrent = nullptr;   // next slab is carved here
+        char* mSlabEnd = nullptr;
+        utils::Mutex mSlabLock;         // only taken when a pool runs dry
         UTILS_UNUSED_IN_RELEASE const utils::AreaPolicy::HeapArea& mArea;
+
+        template<typename POOL>
+        void* allocFromPool(POOL& pool, size_t size, size_t extra) noexcept {
+            void* p = pool.alloc(size, 16, extra);
+            while (UTILS_UNLIKELY(!p)) {
+                if (!extendPool(pool)) {
+                    break;  // the whole area is exhausted
+                }
+                p = pool.alloc(size, 16, extra);
+            }
+            return p;
+        }
+
+        // grows the pool by one slab; returns false if the area is exhausted
+        template<typename POOL>
+        UTILS_NOINLINE
+        bool extendPool(POOL& pool) noexcept {
+            std::lock_guard const lock(mSlabLock);
+            size_t const slab = std::min(SLAB_SIZE, size_t(mSlabEnd - mSlabCurrent));
+            // the free-list needs at least two elements to initialize a range
+            if (UTILS_UNLIKELY(slab < 2 * pool.getSize())) {
+                return false;
+            }
+            char* const begin = mSlabCurrent;
+            mSlabCurrent = begin + slab;
+            pool.extend(begin, begin + slab);
+            return true;
+        }
+
     public:
         static constexpr size_t MIN_ALIGNMENT_SHIFT = 4;
         explicit Allocator(const utils::AreaPolicy::HeapArea& area);
@@ -224,9 +278,9 @@ private:
         // this is in fact always called with a constexpr size argument
         [[nodiscard]] inline void* alloc(size_t size, size_t alignment, size_t extra) noexcept {
             void* p = nullptr;
-                 if (size <= mPool0.getSize()) p = mPool0.alloc(size, 16, extra);
-            else if (size <= mPool1.getSize()) p = mPool1.alloc(size, 16, extra);
-            else if (size <= mPool2.getSize()) p = mPool2.alloc(size, 16, extra);
+                 if (size <= mPool0.getSize()) p = allocFromPool(mPool0, size, extra);
+            else if (size <= mPool1.getSize()) p = allocFromPool(mPool1, size, extra);
+            else if (size <= mPool2.getSize()) p = allocFromPool(mPool2, size, extra);
             return p;
         }
 
@@ -239,16 +293,16 @@ private:
         }
     };
 
-// FIXME: We should be using a Spinlock here, at least on platforms where mutexes are not
-//        efficient (i.e. non-Linux). However, we've seen some hangs on that spinlock, which
-//        we don't understand well (b/308029108).
 #ifndef NDEBUG
     using HandleArena = utils::Arena<Allocator,
             utils::LockingPolicy::Mutex,
             utils::TrackingPolicy::DebugAndHighWatermark>;
 #else
+    // The pools use lock-free free lists and slab growth takes its own (rarely contended)
+    // lock inside Allocator, so the arena itself doesn't need any locking. This also
+    // side-steps the spinlock hangs we've investigated before (b/308029108).
     using HandleArena = utils::Arena<Allocator,
-            utils::LockingPolicy::Mutex>;
+            utils::LockingPolicy::NoLock>;
 #endif
 
     // allocateHandle()/deallocateHandle() selects the pool to use at compile-time based on the
@@ -282,7 +336,13 @@ private:
     HandleBase::HandleId allocateHandleInPool() noexcept {
         void* p = mHandleArena.alloc(SIZE);
         if (UTILS_LIKELY(p)) {
-            return pointerToHandle(p);
+            HandleBase::HandleId id = pointerToHandle(p);
+#ifndef NDEBUG
+            // tag the handle with the slot's current generation
+            id |= uint32_t(mGenerations[id].load(std::memory_order_relaxed) & GENERATION_MAX)
+                    << GENERATION_SHIFT;
+#endif
+            return id;
         } else {
             return allocateHandleSlow(SIZE);
         }
@@ -292,7 +352,11 @@ private:
     UTILS_NOINLINE
     void deallocateHandleFromPool(HandleBase::HandleId id) noexcept {
         if (UTILS_LIKELY(isPoolHandle(id))) {
-            void* p = handleToPointer(id);
+            void* p = handleToPointer(id);    // also validates the generation
+#ifndef NDEBUG
+            // bump the slot's generation, invalidating all outstanding handles to it
+            mGenerations[id & HANDLE_INDEX_MASK].fetch_add(1, std::memory_order_relaxed);
+#endif
             mHandleArena.free(p, SIZE);
         } else {
             deallocateHandleSlow(id, SIZE);
@@ -301,6 +365,13 @@ private:
 
     static constexpr uint32_t HEAP_HANDLE_FLAG = 0x80000000u;
 
+    // In debug builds the bits below HEAP_HANDLE_FLAG carry a per-slot generation
+    // counter, bumped when the slot is freed, so stale handles are caught in
+    // handle_cast() instead of silently aliasing whatever recycled the slot.
+    static constexpr uint32_t GENERATION_SHIFT = 27;
+    static constexpr uint32_t GENERATION_MAX = 0xfu;
+    static constexpr uint32_t HANDLE_INDEX_MASK = (1u << GENERATION_SHIFT) - 1u;
+
     static bool isPoolHandle(HandleBase::HandleId id) noexcept {
         return (id & HEAP_HANDLE_FLAG) == 0u;
     }
@@ -313,8 +384,14 @@ private:
         // note: the null handle will end-up returning nullptr b/c it'll be handled as
         // a non-pool handle.
         if (UTILS_LIKELY(isPoolHandle(id))) {
+#ifndef NDEBUG
+            // catch use-after-free: the slot was recycled since this handle was created
+            uint32_t const generation = (id >> GENERATION_SHIFT) & GENERATION_MAX;
+            assert_invariant((mGenerations[id & HANDLE_INDEX_MASK].load(
+                    std::memory_order_relaxed) & GENERATION_MAX) == generation);
+#endif
             char* const base = (char*)mHandleArena.getArea().begin();
-            size_t offset = id << Allocator::MIN_ALIGNMENT_SHIFT;
+            size_t offset = (id & HANDLE_INDEX_MASK) << Allocator::MIN_ALIGNMENT_SHIFT;
             return static_cast<void*>(base + offset);
         }
         return handleToPointerSlow(id);
@@ -327,12 +404,17 @@ private:
         char* const base = (char*)mHandleArena.getArea().begin();
         size_t offset = (char*)p - base;
         auto id = HandleBase::HandleId(offset >> Allocator::MIN_ALIGNMENT_SHIFT);
-        assert_invariant((id & HEAP_HANDLE_FLAG) == 0);
+        assert_invariant((id & ~HANDLE_INDEX_MASK) == 0);
         return id;
     }
 
     HandleArena mHandleArena;
 
+#ifndef NDEBUG
+    // one generation counter per 16-byte slot of the arena, see GENERATION_SHIFT above
+    std::unique_ptr<std::atomic<uint8_t>[]> mGenerations;
+#endif
+
     // Below is only used when running out of space in the HandleArena
     mutable utils::Mutex mLock;
     tsl::robin_map<HandleBase::HandleId, void*> mOverflowMap;
@@ -19,6 +19,7 @@
 
 #include "backend/DriverApiForward.h"
 
+#include <utils/bitset.h>
 #include <utils/compiler.h>
 #include <utils/FixedCapacityVector.h>
 
@@ -64,11 +65,15 @@ public:
 
     // return if any samplers has been changed
     bool isDirty() const noexcept {
-        return mDirty;
+        return mDirty.any();
     }
 
+    // bit i is set if sampler i has been changed since the last clean().
+    // The group never has more than MAX_SAMPLER_COUNT (62) samplers, so this always fits.
+    uint64_t getDirtyMask() const noexcept { return mDirty.getValue(); }
+
     // mark the whole group as clean (no modified uniforms)
-    void clean() const noexcept { mDirty = false; }
+    void clean() const noexcept { mDirty.reset(); }
 
     // set sampler at given index
     void setSampler(size_t index, backend::SamplerDescriptor sampler) noexcept;
@@ -87,7 +92,7 @@ private:
 #endif
 
     utils::FixedCapacityVector<backend::SamplerDescriptor> mBuffer;
-    mutable bool mDirty = false;
+    mutable utils::bitset64 mDirty;
 };
 
 } // namespace filament::backend
@@ -544,7 +544,7 @@ namespace utils {
 template<>
 CString to_string<filament::backend::TextureUsage>(filament::backend::TextureUsage value) noexcept {
     using namespace filament::backend;
-    char string[7] = {'-', '-', '-', '-', '-', '-', 0};
+    char string[9] = {'-', '-', '-', '-', '-', '-', '-', '-', 0};
     if (any(value & TextureUsage::UPLOADABLE)) {
         string[0]='U';
     }
@@ -563,7 +563,13 @@ CString to_string<filament::backend::TextureUsage>(filament::backend::TextureUsa
     if (any(value & TextureUsage::SUBPASS_INPUT)) {
         string[5]='f';
     }
-    return { string, 6 };
+    if (any(value & TextureUsage::TRANSIENT)) {
+        string[6]='t';
+    }
+    if (any(value & TextureUsage::MEMORYLESS)) {
+        string[7]='m';
+    }
+    return { string, 8 };
 }
 
 template<>
@@ -38,9 +38,16 @@ namespace filament::backend {
 
 size_t CircularBuffer::sPageSize = arch::getPageSize();
 
-CircularBuffer::CircularBuffer(size_t size) {
-    mData = alloc(size);
+CircularBuffer::CircularBuffer(size_t size, size_t reservedSize) {
+#if HAS_MMAP
+    // the span beyond `size` is only virtual address space until a burst commits it
+    mSize = reservedSize > size ? reservedSize : size;
+#else
+    // without on-demand paging, the whole reserve would be committed up front
     mSize = size;
+#endif
+    mSteadySize = size;
+    mData = alloc(mSize);
     mTail = mData;
     mHead = mData;
 }
@@ -155,6 +162,7 @@ void CircularBuffer::circularize() noexcept {
         if (overflow >= 0) {
             assert_invariant(size_t(overflow) <= mSize);
             mHead = (void *) (intptr_t(mData) + overflow);
+            mBurstExtent = mSize;   // this lap used the whole buffer
             #ifndef NDEBUG
             memset(mData, 0xA5, size_t(overflow));
             #endif
@@ -163,9 +171,49 @@ void CircularBuffer::circularize() noexcept {
         // Only circularize if mHead if in the second buffer.
         if (intptr_t(mHead) - intptr_t(mData) > ssize_t(mSize)) {
             mHead = mData;
+            mBurstExtent = mSize;   // this lap used the whole buffer
         }
     }
     mTail = mHead;
 }
 
+size_t CircularBuffer::rewind() noexcept {
+    size_t const offset = getHeadOffset();
+    assert_invariant(offset >= mSteadySize && offset <= mSize);
+    if (UTILS_UNLIKELY(mBurstExtent > offset + mSteadySize / 2)) {
+        // A previous lap reached significantly further into the burst span than this one
+        // did: the burst has drained, release its pages back to the OS. The half steady
+        // size of hysteresis avoids releasing and re-faulting pages over lap-to-lap jitter
+        // in where the wrap lands.
+        releaseBurstPages(offset, mBurstExtent);
+        mBurstExtent = offset;
+    } else if (mBurstExtent < offset) {
+        mBurstExtent = offset;
+    }
+    mHead = mData;
+    mTail = mData;
+    return mSize - offset;
+}
+
+UTILS_NOINLINE
+void CircularBuffer::releaseBurstPages(size_t begin, size_t end) noexcept {
+#if HAS_MMAP
+    // Return the physical pages of [begin, end) to the OS; the virtual range stays mapped
+    // and is committed again on demand by the next burst. The begin offset is rounded up so
+    // the page shared with the live part of the buffer is left alone. Our mappings are
+    // MAP_PRIVATE, so the committed memory is the CoW copies, which is exactly what
+    // MADV_DONTNEED drops -- including in the ashmem case, where the region itself is
+    // never dirtied.
+    size_t const BLOCK_SIZE = getBlockSize();
+    begin = (begin + BLOCK_SIZE - 1) & ~(BLOCK_SIZE - 1);
+    end = (end + BLOCK_SIZE - 1) & ~(BLOCK_SIZE - 1);
+    if (begin < end) {
+        madvise((char*)mData + begin, end - begin, MADV_DONTNEED);
+    }
+#else
+    (void)begin;
+    (void)end;
+#endif
+}
+
 } // namespace filament::backend
@@ -28,28 +28,31 @@ using namespace utils;
 
 namespace filament::backend {
 
-CommandBufferQueue::CommandBufferQueue(size_t requiredSize, size_t bufferSize)
+CommandBufferQueue::CommandBufferQueue(size_t requiredSize, size_t bufferSize, bool consumerWaits)
         : mRequiredSize((requiredSize + (CircularBuffer::getBlockSize() - 1u)) & ~(CircularBuffer::getBlockSize() -1u)),
-          mCircularBuffer(bufferSize),
-          mFreeSpace(mCircularBuffer.size()) {
+          mCircularBuffer(bufferSize, bufferSize * BURST_CAPACITY_FACTOR),
+          mFreeSpace(mCircularBuffer.size()),
+          mConsumerWaits(consumerWaits) {
     assert_invariant(mCircularBuffer.size() > requiredSize);
 }
 
 CommandBufferQueue::~CommandBufferQueue() {
-    assert_invariant(mCommandBuffersToExecute.empty());
+    assert_invariant(mSliceHead.load() == mSliceTail.load());
 }
 
 void CommandBufferQueue::requestExit() {
+    mExitRequested.store(EXIT_REQUESTED, std::memory_order_seq_cst);
+    // take the lock so the wake-up can't slip between a sleeper's predicate check and
+    // its wait()
     std::lock_guard<utils::Mutex> const lock(mLock);
-    mExitRequested = EXIT_REQUESTED;
-    mCondition.notify_one();
+    mCondition.notify_all();
 }
 
 bool CommandBufferQueue::isExitRequested() const {
-    std::lock_guard<utils::Mutex> const lock(mLock);
-    ASSERT_PRECONDITION( mExitRequested == 0 || mExitRequested == EXIT_REQUESTED,
-            "mExitRequested is corrupted (value = 0x%08x)!", mExitRequested);
-    return (bool)mExitRequested;
+    uint32_t const exitRequested = mExitRequested.load(std::memory_order_relaxed);
+    ASSERT_PRECONDITION( exitRequested == 0 || exitRequested == EXIT_REQUESTED,
+            "mExitRequested is corrupted (value = 0x%08x)!", exitRequested);
+    return (bool)exitRequested;
 }
 
 
@@ -74,24 +77,62 @@ void CommandBufferQueue::flush() noexcept {
     // size of this slice
     uint32_t const used = uint32_t(intptr_t(head) - intptr_t(tail));
 
-    circularBuffer.circularize();
+    // Wrap back to the start of the buffer as soon as we're past the steady-state span
+    // and the space accounting allows forfeiting the rest of the lap (the forfeited bytes
+    // are counted as used below and refunded by releaseBuffer() when the consumer follows
+    // the wrap). When the buffer is backed-up -- typically a loading-time command flood --
+    // the check fails and the stream extends into the burst reserve instead of blocking
+    // this thread below. The relaxed load of mFreeSpace is safe: only the consumer adds
+    // to it, so the true value can only be larger.
+    size_t skipped = 0;
+    bool wrapped = false;
+    size_t const headOffset = circularBuffer.getHeadOffset();
+    if (headOffset >= circularBuffer.getSteadySize() && headOffset <= circularBuffer.size()) {
+        size_t const skip = circularBuffer.size() - headOffset;
+        if (mFreeSpace.load(std::memory_order_relaxed) >= used + skip + mRequiredSize) {
+            skipped = circularBuffer.rewind();
+            assert_invariant(skipped == skip);
+            wrapped = true;
+        }
+    }
+    if (!wrapped) {
+        circularBuffer.circularize();
+    }
 
-    std::unique_lock<utils::Mutex> lock(mLock);
-    mCommandBuffersToExecute.push_back({ tail, head });
+    // publish the slice. Single producer: only flush() writes mSliceHead. If the ring is
+    // full the driver thread is severely backed-up, just wait for it to catch up.
+    uint32_t const h = mSliceHead.load(std::memory_order_relaxed);
+    if (UTILS_UNLIKELY(h - mSliceTail.load(std::memory_order_acquire) >= SLICE_COUNT)) {
+        // with the consumer on this very thread, waiting could never be interrupted
+        ASSERT_POSTCONDITION(mConsumerWaits,
+                "CommandBufferQueue overflow without a consumer thread; "
+                "Engine::execute() must be called more often.");
+        SYSTRACE_NAME("waiting: CommandBufferQueue ring full");
+        std::unique_lock<utils::Mutex> lock(mLock);
+        mProducerSleeping.store(true, std::memory_order_seq_cst);
+        mCondition.wait(lock, [this, h]() -> bool {
+            return h - mSliceTail.load(std::memory_order_acquire) < SLICE_COUNT;
+        });
+        mProducerSleeping.store(false, std::memory_order_relaxed);
+    }
+    mSlices[h & (SLICE_COUNT - 1u)] = { tail, head };
+    mSliceHead.store(h + 1u, std::memory_order_release);
+
+    size_t const freeSpace = mFreeSpace.load(std::memory_order_relaxed);
 
     // circular buffer is too small, we corrupted the stream
-    ASSERT_POSTCONDITION(used <= mFreeSpace,
+    ASSERT_POSTCONDITION(used <= freeSpace,
             "Backend CommandStream overflow. Commands are corrupted and unrecoverable.\n"
             "Please increase minCommandBufferSizeMB inside the Config passed to Engine::create.\n"
             "Space used at this time: %u bytes",
             (unsigned)used);
 
-    // wait until there is enough space in the buffer
-    mFreeSpace -= used;
+    size_t const remaining =
+            mFreeSpace.fetch_sub(used + skipped, std::memory_order_seq_cst) - (used + skipped);
     const size_t requiredSize = mRequiredSize;
 
 #ifndef NDEBUG
-    size_t totalUsed = circularBuffer.size() - mFreeSpace;
+    size_t totalUsed = circularBuffer.size() - remaining;
     mHighWatermark = std::max(mHighWatermark, totalUsed);
     if (UTILS_UNLIKELY(totalUsed > requiredSize)) {
         slog.d << "CommandStream used too much space: " << totalUsed
@@ -99,34 +140,81 @@ void CommandBufferQueue::flush() noexcept {
     }
 #endif
 
-    mCondition.notify_one();
-    if (UTILS_LIKELY(mFreeSpace < requiredSize)) {
+    // wake the driver thread, but only if it's actually asleep
+    if (UTILS_UNLIKELY(mConsumerSleeping.load(std::memory_order_seq_cst))) {
+        std::lock_guard<utils::Mutex> const lock(mLock);
+        mCondition.notify_all();
+    }
+
+    // wait until there is enough space in the buffer. When the consumer runs on this very
+    // thread, waiting could never be interrupted; instead we rely on the overflow assertion
+    // above, as on single-threaded platforms.
+    if (mConsumerWaits && UTILS_LIKELY(remaining < requiredSize)) {
         SYSTRACE_NAME("waiting: CircularBuffer::flush()");
+        std::unique_lock<utils::Mutex> lock(mLock);
+        mProducerSleeping.store(true, std::memory_order_seq_cst);
         mCondition.wait(lock, [this, requiredSize]() -> bool {
-            return mFreeSpace >= requiredSize;
+            // seq_cst so this load can't be reordered before the mProducerSleeping store
+            // above; otherwise we could read a stale mFreeSpace and go to sleep while the
+            // consumer, having already added the space, sees the flag still clear and
+            // skips the wake-up.
+            return mFreeSpace.load(std::memory_order_seq_cst) >= requiredSize;
         });
+        mProducerSleeping.store(false, std::memory_order_relaxed);
     }
 }
 
 std::vector<CommandBufferQueue::Slice> CommandBufferQueue::waitForCommands() const {
-    if (!UTILS_HAS_THREADING) {
-        return std::move(mCommandBuffersToExecute);
-    }
-    std::unique_lock<utils::Mutex> lock(mLock);
-    while (mCommandBuffersToExecute.empty() && !mExitRequested) {
-        mCondition.wait(lock);
+    // single consumer: only waitForCommands() writes mSliceTail
+    uint32_t tail = mSliceTail.load(std::memory_order_relaxed);
+    uint32_t head = mSliceHead.load(std::memory_order_acquire);
+
+    if (UTILS_HAS_THREADING && mConsumerWaits &&
+            UTILS_UNLIKELY(tail == head && !mExitRequested.load(std::memory_order_seq_cst))) {
+        std::unique_lock<utils::Mutex> lock(mLock);
+        mConsumerSleeping.store(true, std::memory_order_seq_cst);
+        mCondition.wait(lock, [this, tail]() -> bool {
+            return mSliceHead.load(std::memory_order_acquire) != tail ||
+                   mExitRequested.load(std::memory_order_relaxed);
+        });
+        mConsumerSleeping.store(false, std::memory_order_relaxed);
+        head = mSliceHead.load(std::memory_order_acquire);
     }
 
-    ASSERT_PRECONDITION( mExitRequested == 0 || mExitRequested == EXIT_REQUESTED,
-            "mExitRequested is corrupted (value = 0x%08x)!", mExitRequested);
+    uint32_t const exitRequested = mExitRequested.load(std::memory_order_relaxed);
+    ASSERT_PRECONDITION( exitRequested == 0 || exitRequested == EXIT_REQUESTED,
+            "mExitRequested is corrupted (value = 0x%08x)!", exitRequested);
 
-    return std::move(mCommandBuffersToExecute);
+    std::vector<Slice> commandBuffersToExecute;
+    commandBuffersToExecute.reserve(head - tail);
+    for (; tail != head; ++tail) {
+        commandBuffersToExecute.push_back(mSlices[tail & (SLICE_COUNT - 1u)]);
+    }
+    mSliceTail.store(tail, std::memory_order_release);
+    return commandBuffersToExecute;
 }
 
 void CommandBufferQueue::releaseBuffer(CommandBufferQueue::Slice const& buffer) {
-    std::lock_guard<utils::Mutex> const lock(mLock);
-    mFreeSpace += uintptr_t(buffer.end) - uintptr_t(buffer.begin);
-    mCondition.notify_one();
+    size_t released = uintptr_t(buffer.end) - uintptr_t(buffer.begin);
+    // when this slice starts before the end of the previous one, the producer wrapped
+    // in-between; refund the bytes it forfeited with CircularBuffer::rewind(). A wrap
+    // through the mirror computes to a refund of exactly zero here. On a soft buffer
+    // (no mirror mapping), circularize() wraps from past the end of the buffer instead,
+    // making the stride exceed the buffer size; nothing was forfeited in that case, so
+    // there is nothing to refund (and the subtraction would underflow).
+    if (UTILS_UNLIKELY(buffer.begin < mLastReleasedEnd)) {
+        size_t const stride = uintptr_t(mLastReleasedEnd) - uintptr_t(buffer.begin);
+        if (UTILS_LIKELY(stride <= mCircularBuffer.size())) {
+            released += mCircularBuffer.size() - stride;
+        }
+    }
+    mLastReleasedEnd = buffer.end;
+    mFreeSpace.fetch_add(released, std::memory_order_seq_cst);
+    // wake the producer, but only if it's actually asleep
+    if (UTILS_UNLIKELY(mProducerSleeping.load(std::memory_order_seq_cst))) {
+        std::lock_guard<utils::Mutex> const lock(mLock);
+        mCondition.notify_all();
+    }
 }
 
 } // namespace filament::backend
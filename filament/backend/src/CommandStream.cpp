@@ -114,6 +114,40 @@ void CommandStream::queueCommand(std::function<void()> command) {
     new(allocateCommand(CustomCommand::align(sizeof(CustomCommand)))) CustomCommand(std::move(command));
 }
 
+thread_local CommandStream::Segment* CommandStream::sCurrentSegment = nullptr;
+
+void CommandStream::beginParallelRecording(Segment* segments, size_t count, size_t size) noexcept {
+    assert_invariant(sCurrentSegment == nullptr);
+    assert_invariant(ThreadUtils::isThisThread(mThreadId));
+    size = CommandBase::align(size);
+    // segments are carved out of the stream back-to-back, in index order; this is what
+    // makes the merged execution order deterministic.
+    for (size_t i = 0; i < count; i++) {
+        char* const begin = static_cast<char*>(mCurrentBuffer.allocate(size));
+        segments[i].current = begin;
+        segments[i].tail = begin + size;
+        // always leave room for the NoopCommand that endParallelRecording() adds
+        segments[i].end = begin + size - CommandBase::align(sizeof(NoopCommand));
+    }
+}
+
+void CommandStream::bindSegment(Segment* segment) noexcept {
+    sCurrentSegment = segment;
+}
+
+void CommandStream::endParallelRecording(Segment* segments, size_t count) noexcept {
+    assert_invariant(sCurrentSegment == nullptr);
+    assert_invariant(ThreadUtils::isThisThread(mThreadId));
+    for (size_t i = 0; i < count; i++) {
+        Segment& segment = segments[i];
+        assert_invariant(segment.current && segment.current <= segment.end);
+        // jump over this segment's unused tail, to the next segment (or back to the
+        // regular stream after the last one)
+        new(segment.current) NoopCommand(segment.tail);
+        segment = {};
+    }
+}
+
 template<typename... ARGS>
 template<void (Driver::*METHOD)(ARGS...)>
 template<std::size_t... I>
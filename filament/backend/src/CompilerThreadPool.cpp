@@ -16,7 +16,9 @@
 
 #include "CompilerThreadPool.h"
 
+#include <utils/architecture.h>
 #include <utils/Systrace.h>
+#include <utils/ThreadUtils.h>
 
 #include <memory>
 
@@ -45,6 +47,10 @@ void CompilerThreadPool::init(uint32_t threadCount,
 
             (*setup)();
 
+            // on heterogeneous (big.LITTLE) CPUs, keep background compiles off the
+            // performance cores, so they don't compete with frame-critical work
+            ThreadUtils::setThisThreadAffinity(arch::getEfficiencyCoreMask());
+
             // process jobs from the queue until we're asked to exit
             while (!mExitRequested) {
                 std::unique_lock lock(mQueueLock);
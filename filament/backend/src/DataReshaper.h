@@ -26,6 +26,12 @@
 
 #include <utils/debug.h>
 
+#if defined(__ARM_NEON)
+#   include <arm_neon.h>
+#elif defined(__SSSE3__)
+#   include <tmmintrin.h>
+#endif
+
 namespace filament {
 namespace backend {
 
@@ -47,7 +53,26 @@ public:
         componentType* out = (componentType*) dest;
         const size_t width = (numSrcBytes / sizeof(componentType)) / srcChannelCount;
         constexpr size_t minChannelCount = math::min(srcChannelCount, dstChannelCount);
-        for (size_t column = 0; column < width; ++column) {
+        size_t column = 0;
+        // RGB -> RGBA expansion is by far the most common case (e.g. the video path reshapes
+        // every frame), process the bulk of it with SIMD kernels when available and fall
+        // through to the scalar loop for the remainder.
+        if constexpr (srcChannelCount == 3 && dstChannelCount == 4) {
+            if constexpr (sizeof(componentType) == 1) {
+                column = expandRgb8((uint8_t*) out, (const uint8_t*) in, width,
+                        (uint8_t) maxValue);
+            } else if constexpr (sizeof(componentType) == 2) {
+                column = expandRgb16((uint16_t*) out, (const uint16_t*) in, width,
+                        (uint16_t) maxValue);
+            } else if constexpr (sizeof(componentType) == 4) {
+                uint32_t alphaBits;
+                std::memcpy(&alphaBits, &maxValue, sizeof(alphaBits));
+                column = expandRgb32((uint32_t*) out, (const uint32_t*) in, width, alphaBits);
+            }
+            in += column * srcChannelCount;
+            out += column * dstChannelCount;
+        }
+        for (; column < width; ++column) {
             for (size_t channel = 0; channel < minChannelCount; ++channel) {
                 out[channel] = in[channel];
             }
@@ -184,6 +209,91 @@ public:
                 dstChannelCount, width, height, swizzle);
         return true;
     }
+
+private:
+    // Bulk RGB -> RGBA expansion kernels. Each processes a prefix of `width` pixels and
+    // returns the number of pixels handled; the caller finishes the rest with the scalar
+    // loop. The ISA is selected at compile time, consistent with utils/bitset.h.
+
+    static size_t expandRgb8(uint8_t* UTILS_RESTRICT out, const uint8_t* UTILS_RESTRICT in,
+            size_t width, uint8_t alpha) noexcept {
+#if defined(__ARM_NEON)
+        size_t const n = width & ~size_t(15);
+        uint8x16_t const a = vdupq_n_u8(alpha);
+        for (size_t i = 0; i < n; i += 16, in += 48, out += 64) {
+            uint8x16x3_t const rgb = vld3q_u8(in);
+            uint8x16x4_t const rgba = {{ rgb.val[0], rgb.val[1], rgb.val[2], a }};
+            vst4q_u8(out, rgba);
+        }
+        return n;
+#elif defined(__SSSE3__)
+        // each iteration reads 16 source bytes but only consumes 12 (4 pixels), so leave at
+        // least 4 pixels to the scalar loop to avoid reading past the end of the buffer
+        if (width < 8) {
+            return 0;
+        }
+        size_t const n = (width - 4) & ~size_t(3);
+        __m128i const shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1,
+                9, 10, 11, -1);
+        __m128i const a = _mm_set1_epi32(int32_t(uint32_t(alpha) << 24u));
+        for (size_t i = 0; i < n; i += 4, in += 12, out += 16) {
+            __m128i const rgb = _mm_loadu_si128((const __m128i*) in);
+            _mm_storeu_si128((__m128i*) out, _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), a));
+        }
+        return n;
+#else
+        (void) out, (void) in, (void) width, (void) alpha;
+        return 0;
+#endif
+    }
+
+    static size_t expandRgb16(uint16_t* UTILS_RESTRICT out, const uint16_t* UTILS_RESTRICT in,
+            size_t width, uint16_t alpha) noexcept {
+#if defined(__ARM_NEON)
+        size_t const n = width & ~size_t(7);
+        uint16x8_t const a = vdupq_n_u16(alpha);
+        for (size_t i = 0; i < n; i += 8, in += 24, out += 32) {
+            uint16x8x3_t const rgb = vld3q_u16(in);
+            uint16x8x4_t const rgba = {{ rgb.val[0], rgb.val[1], rgb.val[2], a }};
+            vst4q_u16(out, rgba);
+        }
+        return n;
+#elif defined(__SSSE3__)
+        // reads 16 source bytes but consumes 12 (2 pixels), see expandRgb8
+        if (width < 4) {
+            return 0;
+        }
+        size_t const n = (width - 2) & ~size_t(1);
+        __m128i const shuffle = _mm_setr_epi8(0, 1, 2, 3, 4, 5, -1, -1, 6, 7, 8, 9, 10, 11,
+                -1, -1);
+        __m128i const a = _mm_setr_epi16(0, 0, 0, int16_t(alpha), 0, 0, 0, int16_t(alpha));
+        for (size_t i = 0; i < n; i += 2, in += 6, out += 8) {
+            __m128i const rgb = _mm_loadu_si128((const __m128i*) in);
+            _mm_storeu_si128((__m128i*) out, _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), a));
+        }
+        return n;
+#else
+        (void) out, (void) in, (void) width, (void) alpha;
+        return 0;
+#endif
+    }
+
+    static size_t expandRgb32(uint32_t* UTILS_RESTRICT out, const uint32_t* UTILS_RESTRICT in,
+            size_t width, uint32_t alpha) noexcept {
+#if defined(__ARM_NEON)
+        size_t const n = width & ~size_t(3);
+        uint32x4_t const a = vdupq_n_u32(alpha);
+        for (size_t i = 0; i < n; i += 4, in += 12, out += 16) {
+            uint32x4x3_t const rgb = vld3q_u32(in);
+            uint32x4x4_t const rgba = {{ rgb.val[0], rgb.val[1], rgb.val[2], a }};
+            vst4q_u32(out, rgba);
+        }
+        return n;
+#else
+        (void) out, (void) in, (void) width, (void) alpha;
+        return 0;
+#endif
+    }
 };
 
 template<> inline float getMaxValue() { return 1.0f; }
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "private/backend/DiskBlobCache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace filament::backend {
+
+namespace {
+
+// bump when the on-disk layout below changes, old entries then simply miss
+constexpr uint32_t BLOB_CACHE_VERSION = 1;
+constexpr uint32_t BLOB_CACHE_MAGIC = 'F' | 'B' << 8 | 'L' << 16 | 'B' << 24;
+
+struct EntryHeader {
+    uint32_t magic;
+    uint32_t keySize;
+    uint64_t valueSize;
+};
+
+// FNV-1a, we just need a stable hash to derive filenames from keys
+uint64_t hash(const void* data, size_t size, uint64_t h) noexcept {
+    uint8_t const* p = static_cast<uint8_t const*>(data);
+    for (size_t i = 0; i < size; i++) {
+        h = (h ^ p[i]) * 0x100000001b3ull;
+    }
+    return h;
+}
+
+} // anonymous namespace
+
+DiskBlobCache::DiskBlobCache(const char* directory, Backend backend) noexcept
+        : mDirectory(directory) {
+    // fold the backend and cache version into every filename, so e.g. GL and Vulkan
+    // blobs never alias when the application switches backend
+    uint32_t const salt[2] = { uint32_t(backend), BLOB_CACHE_VERSION };
+    mSalt = hash(salt, sizeof(salt), 0xcbf29ce484222325ull);
+}
+
+std::string DiskBlobCache::pathForKey(const void* key, size_t keySize) const noexcept {
+    char name[32];
+    snprintf(name, sizeof(name), "/%016llx.blob",
+            (unsigned long long)hash(key, keySize, mSalt));
+    return mDirectory + name;
+}
+
+void DiskBlobCache::insert(const void* key, size_t keySize,
+        const void* value, size_t valueSize) const noexcept {
+    std::string const path = pathForKey(key, keySize);
+    std::string const tmp = path + ".tmp";
+
+    FILE* const file = fopen(tmp.c_str(), "wb");
+    if (!file) {
+        return;
+    }
+
+    EntryHeader const header = { BLOB_CACHE_MAGIC, uint32_t(keySize), uint64_t(valueSize) };
+    bool const ok = fwrite(&header, sizeof(header), 1, file) == 1
+            && fwrite(key, 1, keySize, file) == keySize
+            && fwrite(value, 1, valueSize, file) == valueSize;
+    fclose(file);
+
+    // publish the entry atomically, so a concurrent retrieve() never sees a torn blob
+    if (!ok || rename(tmp.c_str(), path.c_str())) {
+        remove(tmp.c_str());
+    }
+}
+
+size_t DiskBlobCache::retrieve(const void* key, size_t keySize,
+        void* value, size_t valueSize) const noexcept {
+    std::string const path = pathForKey(key, keySize);
+
+    FILE* const file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return 0;
+    }
+
+    size_t result = 0;
+    EntryHeader header;
+    if (fread(&header, sizeof(header), 1, file) == 1
+            && header.magic == BLOB_CACHE_MAGIC
+            && header.keySize == keySize) {
+        // verify the full key, the filename is only a hash of it
+        void* const storedKey = malloc(keySize);
+        bool const match = storedKey
+                && fread(storedKey, 1, keySize, file) == keySize
+                && !memcmp(storedKey, key, keySize);
+        free(storedKey);
+        if (match) {
+            result = size_t(header.valueSize);
+            if (result <= valueSize && fread(value, 1, result, file) != result) {
+                result = 0;
+            }
+        }
+    }
+    fclose(file);
+    return result;
+}
+
+} // namespace filament::backend
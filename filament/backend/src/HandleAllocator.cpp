@@ -27,15 +27,15 @@ using namespace utils;
 template <size_t P0, size_t P1, size_t P2>
 UTILS_NOINLINE
 HandleAllocator<P0, P1, P2>::Allocator::Allocator(AreaPolicy::HeapArea const& area)
-        : mArea(area) {
-    // TODO: we probably need a better way to set the size of these pools
-    const size_t unit = area.size() / 32;
-    const size_t offsetPool1 =      unit;
-    const size_t offsetPool2 = 16 * unit;
-    char* const p = (char*)area.begin();
-    mPool0 = PoolAllocator< P0, 16>(p, p + offsetPool1);
-    mPool1 = PoolAllocator< P1, 16>(p + offsetPool1, p + offsetPool2);
-    mPool2 = PoolAllocator< P2, 16>(p + offsetPool2, area.end());
+        : mPool0((char*)area.begin(),                 (char*)area.begin() +     SLAB_SIZE),
+          mPool1((char*)area.begin() +     SLAB_SIZE, (char*)area.begin() + 2 * SLAB_SIZE),
+          mPool2((char*)area.begin() + 2 * SLAB_SIZE, (char*)area.begin() + 3 * SLAB_SIZE),
+          mSlabCurrent((char*)area.begin() + 3 * SLAB_SIZE),
+          mSlabEnd((char*)area.end()),
+          mArea(area) {
+    // each pool gets one slab up-front (which also establishes the base of its free
+    // list), the rest of the area is carved on demand as the pools run dry
+    assert_invariant(area.size() >= 3 * SLAB_SIZE);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -43,6 +43,10 @@ HandleAllocator<P0, P1, P2>::Allocator::Allocator(AreaPolicy::HeapArea const& ar
 template <size_t P0, size_t P1, size_t P2>
 HandleAllocator<P0, P1, P2>::HandleAllocator(const char* name, size_t size) noexcept
     : mHandleArena(name, size) {
+#ifndef NDEBUG
+    size_t const count = mHandleArena.getArea().size() >> Allocator::MIN_ALIGNMENT_SHIFT;
+    mGenerations.reset(new std::atomic<uint8_t>[count]());
+#endif
 }
 
 template <size_t P0, size_t P1, size_t P2>
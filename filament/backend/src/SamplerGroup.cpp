@@ -22,19 +22,24 @@
 
 namespace filament::backend {
 
+static constexpr uint64_t fullDirtyMask(size_t count) noexcept {
+    return count >= 64 ? ~uint64_t(0) : (uint64_t(1) << count) - 1;
+}
+
 // create a sampler buffer
 SamplerGroup::SamplerGroup(size_t count) noexcept
         : mBuffer(count) {
 }
 
 SamplerGroup::SamplerGroup(const SamplerGroup& rhs) noexcept :
-    mBuffer(rhs.mBuffer), mDirty(true) {
+    mBuffer(rhs.mBuffer) {
+    mDirty.setValue(fullDirtyMask(mBuffer.size()));
 }
 
 SamplerGroup& SamplerGroup::operator=(const SamplerGroup& rhs) noexcept {
     if (this != &rhs) {
         mBuffer = rhs.mBuffer;
-        mDirty = true;
+        mDirty.setValue(fullDirtyMask(mBuffer.size()));
     }
     return *this;
 }
@@ -46,7 +51,7 @@ void SamplerGroup::setSampler(size_t index, SamplerDescriptor sampler) noexcept
         // texture is destroyed, its handle could be reused quickly by another texture.
         // TODO: find a way to avoid marking dirty if the texture does not change.
         mBuffer[index] = sampler;
-        mDirty = true;
+        mDirty.set(index);
     }
 }
 
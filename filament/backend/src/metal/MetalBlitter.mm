@@ -179,6 +179,11 @@ bool MetalBlitter::blitFastPath(id<MTLCommandBuffer> cmdBuffer,
 
         id<MTLBlitCommandEncoder> const blitEncoder = [cmdBuffer blitCommandEncoder];
         blitEncoder.label = @(label);
+        if (!mContext.transientHeaps.empty()) {
+            // Either side of the blit can be an untracked transient,
+            // see MetalContext::transientHazardFence.
+            [blitEncoder waitForFence:getTransientHazardFence(&mContext)];
+        }
         [blitEncoder copyFromTexture:args.source.texture
                          sourceSlice:args.source.slice
                          sourceLevel:args.source.level
@@ -188,6 +193,9 @@ bool MetalBlitter::blitFastPath(id<MTLCommandBuffer> cmdBuffer,
                     destinationSlice:args.destination.slice
                     destinationLevel:args.destination.level
                    destinationOrigin:args.destination.region.origin];
+        if (!mContext.transientHeaps.empty()) {
+            [blitEncoder updateFence:getTransientHazardFence(&mContext)];
+        }
         [blitEncoder endEncoding];
 
         return true;
@@ -230,6 +238,12 @@ void MetalBlitter::blitDepthPlane(id<MTLCommandBuffer> cmdBuffer, bool blitColor
     id<MTLRenderCommandEncoder> const encoder =
             [cmdBuffer renderCommandEncoderWithDescriptor:descriptor];
     encoder.label = @(label);
+    if (!mContext.transientHeaps.empty()) {
+        // Either side of the blit can be an untracked transient,
+        // see MetalContext::transientHazardFence.
+        [encoder waitForFence:getTransientHazardFence(&mContext)
+                 beforeStages:MTLRenderStageVertex];
+    }
 
     BlitFunctionKey key;
     key.blitColor = blitColor;
@@ -345,6 +359,10 @@ void MetalBlitter::blitDepthPlane(id<MTLCommandBuffer> cmdBuffer, bool blitColor
     [encoder setVertexBytes:vertices length:(sizeof(math::float2) * 3) atIndex:0];
     [encoder setFragmentBytes:&fargs length:sizeof(FragmentArgs) atIndex:0];
     [encoder drawPrimitives:MTLPrimitiveTypeTriangle vertexStart:0 vertexCount:3];
+    if (!mContext.transientHeaps.empty()) {
+        [encoder updateFence:getTransientHazardFence(&mContext)
+                 afterStages:MTLRenderStageFragment];
+    }
     [encoder endEncoding];
 }
 
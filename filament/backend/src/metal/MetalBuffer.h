@@ -50,6 +50,12 @@ public:
     void copyIntoBuffer(void* src, size_t size, size_t byteOffset);
     void copyIntoBufferUnsynchronized(void* src, size_t size, size_t byteOffset);
 
+    /**
+     * Copy a region of another MetalBuffer into this buffer, on the GPU when both buffers have a
+     * device allocation. Must be called outside of a render pass.
+     */
+    void copyFromBuffer(MetalBuffer& src, size_t size, size_t srcOffset, size_t dstOffset);
+
     /**
      * Denotes that this buffer is used for a draw call ensuring that its allocation remains valid
      * until the end of the current frame.
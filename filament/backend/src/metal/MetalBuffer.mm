@@ -86,6 +86,48 @@ void MetalBuffer::copyIntoBufferUnsynchronized(void* src, size_t size, size_t by
     copyIntoBuffer(src, size, byteOffset);
 }
 
+void MetalBuffer::copyFromBuffer(MetalBuffer& src, size_t size, size_t srcOffset,
+        size_t dstOffset) {
+    if (size <= 0) {
+        return;
+    }
+    ASSERT_PRECONDITION(size + srcOffset <= src.mBufferSize,
+            "Attempting to copy %zu bytes out of a buffer of size %zu at offset %zu",
+            size, src.mBufferSize, srcOffset);
+    ASSERT_PRECONDITION(size + dstOffset <= mBufferSize,
+            "Attempting to copy %zu bytes into a buffer of size %zu at offset %zu",
+            size, mBufferSize, dstOffset);
+
+    // Small dynamic buffers don't have a device allocation; copy their CPU-side storage instead.
+    if (src.mCpuBuffer && mCpuBuffer) {
+        memcpy(static_cast<uint8_t*>(mCpuBuffer) + dstOffset,
+                static_cast<uint8_t const*>(src.mCpuBuffer) + srcOffset, size);
+        return;
+    }
+    if (src.mCpuBuffer) {
+        copyIntoBuffer(static_cast<uint8_t*>(src.mCpuBuffer) + srcOffset, size, dstOffset);
+        return;
+    }
+    // The destination's private storage cannot be read back, so there is no path from a GPU
+    // buffer into a CPU-side buffer; the frontend never asks for one.
+    ASSERT_PRECONDITION(!mCpuBuffer,
+            "Cannot copy a GPU buffer into a CPU-side buffer of size %zu", mBufferSize);
+
+    // The blit below requires that both offsets be a multiple of 4.
+    ASSERT_PRECONDITION(!(srcOffset & 0x3u) && !(dstOffset & 0x3u),
+            "srcOffset and dstOffset must be multiples of 4");
+
+    id<MTLCommandBuffer> cmdBuffer = getPendingCommandBuffer(&mContext);
+    id<MTLBlitCommandEncoder> blitEncoder = [cmdBuffer blitCommandEncoder];
+    blitEncoder.label = @"Buffer copy blit";
+    [blitEncoder copyFromBuffer:src.mBuffer
+                   sourceOffset:srcOffset
+                       toBuffer:mBuffer
+              destinationOffset:dstOffset
+                           size:size];
+    [blitEncoder endEncoding];
+}
+
 id<MTLBuffer> MetalBuffer::getGpuBufferForDraw(id<MTLCommandBuffer> cmdBuffer) noexcept {
     // If there's a CPU buffer, then we return nil here, as the CPU-side buffer will be bound
     // separately.
@@ -30,6 +30,7 @@
 #include <array>
 #include <atomic>
 #include <stack>
+#include <vector>
 
 #if defined(FILAMENT_METAL_PROFILING)
 #include <os/log.h>
@@ -66,6 +67,36 @@ struct MetalContext {
     id<MTLCommandBuffer> pendingCommandBuffer = nullptr;
     id<MTLRenderCommandEncoder> currentRenderPassEncoder = nullptr;
 
+    // Heavy render passes are encoded through a MTLParallelRenderCommandEncoder, whose
+    // sub-encoders can legally record on any thread (see createParallelSubEncoder). nil when
+    // the current pass uses a plain encoder; currentRenderPassEncoder is then the first
+    // sub-encoder and everything else is unaffected.
+    id<MTLParallelRenderCommandEncoder> currentParallelRenderPassEncoder = nullptr;
+
+    // Number of draws encoded in the current render pass, plus the per-pass counts observed
+    // during the previous frame. The actual count of a pass isn't known when it begins (draws
+    // stream in one at a time), but the frame graph emits passes in a stable order, so last
+    // frame's count at the same index predicts whether the upcoming pass is heavy enough to
+    // warrant a parallel encoder.
+    uint32_t currentRenderPassDrawCount = 0;
+    uint32_t currentRenderPassIndex = 0;
+    std::vector<uint32_t> currentFrameDrawCounts;
+    std::vector<uint32_t> previousFrameDrawCounts;
+
+    // Frame graph transients are sub-allocated from these heaps with hazard tracking disabled
+    // (see createTransientTexture). Hazards are handled explicitly instead: every encoder that
+    // can touch a transient waits on and updates this single fence, which re-establishes
+    // encoding order exactly; the frame graph executes its passes in dependency order, so
+    // pass-granular fencing covers every dependency edge.
+    std::vector<id<MTLHeap>> transientHeaps;
+    id<MTLFence> transientHazardFence = nil;
+
+    // Persistent residency table for material textures: sampleable textures are sub-allocated
+    // from these shared, hazard-tracked heaps and made resident for a whole pass with a single
+    // useHeap: call, instead of a per-sampler-group useResources walk (see
+    // createResidentTexture).
+    std::vector<id<MTLHeap>> residentTextureHeaps;
+
     std::atomic<bool> memorylessLimitsReached = false;
 
     // Supported features.
@@ -169,6 +200,14 @@ id<MTLTexture> getOrCreateEmptyTexture(MetalContext* context);
 
 bool isInRenderPass(MetalContext* context);
 
+id<MTLRenderCommandEncoder> createParallelSubEncoder(MetalContext* context);
+
+id<MTLTexture> createTransientTexture(MetalContext* context, MTLTextureDescriptor* descriptor);
+
+id<MTLTexture> createResidentTexture(MetalContext* context, MTLTextureDescriptor* descriptor);
+
+id<MTLFence> getTransientHazardFence(MetalContext* context);
+
 } // namespace backend
 } // namespace filament
 
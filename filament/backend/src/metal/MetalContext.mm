@@ -21,6 +21,7 @@
 #include <utils/debug.h>
 #include <utils/FixedCapacityVector.h>
 
+#include <algorithm>
 #include <utility>
 
 namespace filament {
@@ -153,5 +154,83 @@ bool isInRenderPass(MetalContext* context) {
     return context->currentRenderPassEncoder != nil;
 }
 
+// Texture heaps grow in fixed increments; large enough for a 4K RGBA16F attachment.
+constexpr NSUInteger TEXTURE_HEAP_SIZE_INCREMENT = 64 * 1024 * 1024;
+
+API_AVAILABLE(macos(10.15), ios(13.0))
+static id<MTLTexture> createHeapBackedTexture(MetalContext* context,
+        MTLTextureDescriptor* descriptor, MTLHazardTrackingMode hazardTrackingMode,
+        std::vector<id<MTLHeap>>& heaps) {
+    descriptor.hazardTrackingMode = hazardTrackingMode;
+    for (id<MTLHeap> heap : heaps) {
+        if (id<MTLTexture> texture = [heap newTextureWithDescriptor:descriptor]) {
+            return texture;
+        }
+    }
+    MTLSizeAndAlign const sizeAndAlign =
+            [context->device heapTextureSizeAndAlignWithDescriptor:descriptor];
+    MTLHeapDescriptor* heapDescriptor = [MTLHeapDescriptor new];
+    heapDescriptor.storageMode = MTLStorageModePrivate;
+    heapDescriptor.hazardTrackingMode = hazardTrackingMode;
+    heapDescriptor.size = std::max(NSUInteger(sizeAndAlign.size), TEXTURE_HEAP_SIZE_INCREMENT);
+    id<MTLHeap> heap = [context->device newHeapWithDescriptor:heapDescriptor];
+    if (!heap) {
+        // The caller falls back to a committed allocation.
+        return nil;
+    }
+    heaps.push_back(heap);
+    return [heap newTextureWithDescriptor:descriptor];
+}
+
+id<MTLTexture> createTransientTexture(MetalContext* context, MTLTextureDescriptor* descriptor) {
+    if (@available(macOS 10.15, iOS 13, *)) {
+        // Transients are sub-allocated from shared MTLHeaps with hazard tracking disabled:
+        // automatic per-resource tracking is pure encoder overhead on long post-processing
+        // chains, where the dependencies are already known to the frame graph. Correctness is
+        // preserved with a single explicit fence at encoder granularity, see
+        // MetalContext::transientHazardFence.
+        return createHeapBackedTexture(context, descriptor, MTLHazardTrackingModeUntracked,
+                context->transientHeaps);
+    }
+    return nil;
+}
+
+id<MTLTexture> createResidentTexture(MetalContext* context, MTLTextureDescriptor* descriptor) {
+    if (@available(macOS 10.15, iOS 13, *)) {
+        // Material textures live in shared heaps so that a single useHeap: call per pass makes
+        // all of them resident at once; sampler groups then skip their per-texture useResources
+        // walk, which dominates CPU encode time at high material diversity. Unlike the
+        // transient heaps these are hazard tracked (heaps are untracked by default), so uploads
+        // and mipmap blits still synchronize automatically.
+        return createHeapBackedTexture(context, descriptor, MTLHazardTrackingModeTracked,
+                context->residentTextureHeaps);
+    }
+    return nil;
+}
+
+id<MTLFence> getTransientHazardFence(MetalContext* context) {
+    if (!context->transientHazardFence) {
+        context->transientHazardFence = [context->device newFence];
+        context->transientHazardFence.label = @"Transient hazard fence";
+    }
+    return context->transientHazardFence;
+}
+
+id<MTLRenderCommandEncoder> createParallelSubEncoder(MetalContext* context) {
+    assert_invariant(context->currentParallelRenderPassEncoder);
+    // Sub-encoders execute in creation order, so each worker's encoder must be created here, on
+    // the driver thread, before any concurrent recording starts; the returned encoder can then
+    // record on any thread. Sub-encoders only inherit the render pass attachments, so the
+    // viewport has to be re-applied.
+    id<MTLRenderCommandEncoder> encoder =
+            [context->currentParallelRenderPassEncoder renderCommandEncoder];
+    [encoder setViewport:context->currentViewport];
+    // Residency is per-encoder, each sub-encoder needs its own useHeap: calls.
+    for (id<MTLHeap> heap : context->residentTextureHeaps) {
+        [encoder useHeap:heap];
+    }
+    return encoder;
+}
+
 } // namespace backend
 } // namespace filament
@@ -42,6 +42,10 @@
 namespace filament {
 namespace backend {
 
+// A render pass whose draw count reached this threshold during the previous frame is encoded
+// through a MTLParallelRenderCommandEncoder (see MetalContext::currentParallelRenderPassEncoder).
+constexpr uint32_t METAL_PARALLEL_ENCODER_DRAW_THRESHOLD = 2048;
+
 Driver* MetalDriverFactory::create(MetalPlatform* const platform, const Platform::DriverConfig& driverConfig) {
     return MetalDriver::create(platform, driverConfig);
 }
@@ -210,6 +214,11 @@ void MetalDriver::endFrame(uint32_t frameId) {
 
     CVMetalTextureCacheFlush(mContext->textureCache, 0);
 
+    // Keep this frame's per-pass draw counts around to size up next frame's passes.
+    mContext->previousFrameDrawCounts.swap(mContext->currentFrameDrawCounts);
+    mContext->currentFrameDrawCounts.clear();
+    mContext->currentRenderPassIndex = 0;
+
     assert_invariant(mContext->groupMarkers.empty());
 
     // If we exceeded memoryless limits, turn it off for the rest of the lifetime of the driver.
@@ -649,6 +658,10 @@ bool MetalDriver::isTextureSwizzleSupported() {
     return mContext->supportsTextureSwizzling;
 }
 
+StateCacheStatistics MetalDriver::getStateCacheStatistics() {
+    return {};
+}
+
 bool MetalDriver::isTextureFormatMipmappable(TextureFormat format) {
     // Derived from the Metal 3.0 Feature Set Tables.
     // In order for a format to be mipmappable, it must be color-renderable and filterable.
@@ -722,6 +735,16 @@ bool MetalDriver::isSRGBSwapChainSupported() {
     return false;
 }
 
+int32_t MetalDriver::getSwapChainImageFd(Handle<HwSwapChain> sch, uint32_t index) {
+    // an IOSurface-based export path could be added here; not implemented
+    return -1;
+}
+
+uint64_t MetalDriver::getFrameLatencyNanos(Handle<HwSwapChain> sch) {
+    // presentAfterMinimumDuration is a pacing API, not a wait; no latency measurement here
+    return 0;
+}
+
 bool MetalDriver::isStereoSupported() {
     return true;
 }
@@ -797,6 +820,15 @@ void MetalDriver::updateBufferObjectUnsynchronized(Handle<HwBufferObject> boh,
     scheduleDestroy(std::move(data));
 }
 
+void MetalDriver::copyBufferObject(Handle<HwBufferObject> dboh, uint32_t dstOffset,
+        Handle<HwBufferObject> sboh, uint32_t srcOffset, uint32_t size) {
+    ASSERT_PRECONDITION(!isInRenderPass(mContext),
+            "copyBufferObject must be called outside of a render pass.");
+    auto* dbo = handle_cast<MetalBufferObject>(dboh);
+    auto* sbo = handle_cast<MetalBufferObject>(sboh);
+    dbo->getBuffer()->copyFromBuffer(*sbo->getBuffer(), size, srcOffset, dstOffset);
+}
+
 void MetalDriver::resetBufferObject(Handle<HwBufferObject> boh) {
     // TODO: implement resetBufferObject(). This is equivalent to calling
     // destroyBufferObject() followed by createBufferObject() keeping the same handle.
@@ -868,9 +900,12 @@ void MetalDriver::generateMipmaps(Handle<HwTexture> th) {
     tex->generateMipmaps();
 }
 
-void MetalDriver::updateSamplerGroup(Handle<HwSamplerGroup> sbh, BufferDescriptor&& data) {
+void MetalDriver::updateSamplerGroup(Handle<HwSamplerGroup> sbh, BufferDescriptor&& data,
+        uint64_t dirtyMask) {
     ASSERT_PRECONDITION(!isInRenderPass(mContext),
             "updateSamplerGroup must be called outside of a render pass.");
+    // dirtyMask is unused here: resetting the argument encoder below requires re-encoding
+    // every slot anyway, and the full data is always provided.
 
     auto sb = handle_cast<MetalSamplerGroup>(sbh);
     assert_invariant(sb->size == data.size / sizeof(SamplerDescriptor));
@@ -984,8 +1019,42 @@ void MetalDriver::beginRenderPass(Handle<HwRenderTarget> rth,
     MTLRenderPassDescriptor* descriptor = [MTLRenderPassDescriptor renderPassDescriptor];
     renderTarget->setUpRenderPassAttachments(descriptor, params);
 
-    mContext->currentRenderPassEncoder =
-            [getPendingCommandBuffer(mContext) renderCommandEncoderWithDescriptor:descriptor];
+    // Encoding is single threaded on the Mac deployments we care about and becomes the
+    // bottleneck on passes with many draws, so those go through a parallel encoder: its
+    // sub-encoders can record concurrently (see createParallelSubEncoder), and the first one
+    // stands in for the regular encoder so the rest of the driver is unaffected.
+    uint32_t const passIndex = mContext->currentRenderPassIndex++;
+    uint32_t const expectedDraws = passIndex < mContext->previousFrameDrawCounts.size()
+            ? mContext->previousFrameDrawCounts[passIndex] : 0;
+    // Sub-encoders of a parallel encoder cannot wait on or update MTLFences, so once untracked
+    // transient heaps are in use (see createTransientTexture) every pass has to stay on a plain
+    // encoder; removing hazard tracking is the bigger win on our workloads.
+    if (expectedDraws >= METAL_PARALLEL_ENCODER_DRAW_THRESHOLD
+            && mContext->transientHeaps.empty()) {
+        mContext->currentParallelRenderPassEncoder = [getPendingCommandBuffer(mContext)
+                parallelRenderCommandEncoderWithDescriptor:descriptor];
+        mContext->currentRenderPassEncoder =
+                [mContext->currentParallelRenderPassEncoder renderCommandEncoder];
+    } else {
+        mContext->currentRenderPassEncoder =
+                [getPendingCommandBuffer(mContext) renderCommandEncoderWithDescriptor:descriptor];
+    }
+    mContext->currentRenderPassDrawCount = 0;
+    // One residency call per heap replaces the per-sampler-group useResources walk (see
+    // createResidentTexture); hazards on tracked heap resources remain automatic.
+    for (id<MTLHeap> heap : mContext->residentTextureHeaps) {
+        [mContext->currentRenderPassEncoder useHeap:heap];
+    }
+    for (id<MTLHeap> heap : mContext->transientHeaps) {
+        [mContext->currentRenderPassEncoder useHeap:heap];
+    }
+    if (!mContext->transientHeaps.empty()) {
+        // Transient attachments and samplers are untracked; the shared fence re-establishes
+        // pass order. Waiting before the vertex stage and updating after the fragment stage
+        // still lets consecutive passes overlap their non-dependent stages.
+        [mContext->currentRenderPassEncoder waitForFence:getTransientHazardFence(mContext)
+                                            beforeStages:MTLRenderStageVertex];
+    }
     if (!mContext->groupMarkers.empty()) {
         mContext->currentRenderPassEncoder.label =
                 [NSString stringWithCString:mContext->groupMarkers.top()
@@ -1018,11 +1087,24 @@ void MetalDriver::endRenderPass(int dummy) {
     os_signpost_interval_end(mContext->log, OS_SIGNPOST_ID_EXCLUSIVE, "Render pass");
 #endif
 
+    mContext->currentFrameDrawCounts.push_back(mContext->currentRenderPassDrawCount);
+
+    if (!mContext->transientHeaps.empty()) {
+        [mContext->currentRenderPassEncoder updateFence:getTransientHazardFence(mContext)
+                                            afterStages:MTLRenderStageFragment];
+    }
+
     [mContext->currentRenderPassEncoder endEncoding];
 
     // Command encoders are one time use. Set it to nil to release the encoder and ensure we don't
     // accidentally use it again.
     mContext->currentRenderPassEncoder = nil;
+
+    if (mContext->currentParallelRenderPassEncoder) {
+        // All sub-encoders must have ended encoding by now.
+        [mContext->currentParallelRenderPassEncoder endEncoding];
+        mContext->currentParallelRenderPassEncoder = nil;
+    }
 }
 
 void MetalDriver::setRenderPrimitiveBuffer(Handle<HwRenderPrimitive> rph,
@@ -1534,12 +1616,17 @@ void MetalDriver::finalizeSamplerGroup(MetalSamplerGroup* samplerGroup) {
     // render pass.
     samplerGroup->useResources(mContext->currentRenderPassEncoder);
 
-    // useResources won't retain references to the textures, so we need to do so manually.
+    // Neither useHeap nor useResources retain references to the textures, so we need to do so
+    // manually until the command buffer completes. The tracker dedups, so a texture bound by
+    // many sampler groups is retained (and gets a completion callback) only once per command
+    // buffer instead of once per finalize.
     for (id<MTLTexture> texture : samplerGroup->textures) {
         const void* retainedTexture = CFBridgingRetain(texture);
-        [cmdBuffer addCompletedHandler:^(id<MTLCommandBuffer> cb) {
+        if (!mContext->resourceTracker.trackResource((__bridge void*) cmdBuffer, retainedTexture,
+                [](const void* resource) { CFBridgingRelease(resource); })) {
+            // This command buffer already retains the texture.
             CFBridgingRelease(retainedTexture);
-        }];
+        }
     }
 }
 
@@ -1793,6 +1880,7 @@ void MetalDriver::draw(PipelineState ps, Handle<HwRenderPrimitive> rph, uint32_t
                                                   indexBuffer:metalIndexBuffer
                                             indexBufferOffset:primitive->offset
                                                 instanceCount:instanceCount];
+    mContext->currentRenderPassDrawCount++;
 }
 
 void MetalDriver::dispatchCompute(Handle<HwProgram> program, math::uint3 workGroupCount) {
@@ -1817,6 +1905,10 @@ void MetalDriver::dispatchCompute(Handle<HwProgram> program, math::uint3 workGro
 
     id<MTLComputeCommandEncoder> computeEncoder =
             [getPendingCommandBuffer(mContext) computeCommandEncoder];
+    if (!mContext->transientHeaps.empty()) {
+        // Compute passes can read untracked transients, see MetalContext::transientHazardFence.
+        [computeEncoder waitForFence:getTransientHazardFence(mContext)];
+    }
 
     NSError* error = nil;
     id<MTLComputePipelineState> computePipelineState =
@@ -1861,6 +1953,10 @@ void MetalDriver::dispatchCompute(Handle<HwProgram> program, math::uint3 workGro
     [computeEncoder dispatchThreadgroups:threadgroupsPerGrid
                    threadsPerThreadgroup:threadsPerThreadgroup];
 
+    if (!mContext->transientHeaps.empty()) {
+        [computeEncoder updateFence:getTransientHazardFence(mContext)];
+    }
+
     [computeEncoder endEncoding];
 }
 
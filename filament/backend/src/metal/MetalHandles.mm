@@ -466,6 +466,21 @@ MetalTexture::MetalTexture(MetalContext& context, SamplerType target, uint8_t le
         }
     };
 
+    // Frame graph transients are short-lived and recreated often; when possible they come out
+    // of a heap with explicit hazard fencing instead of a committed, tracked allocation.
+    auto const allocateTexture = [&context, usage](MTLTextureDescriptor* descriptor) {
+        if (any(usage & TextureUsage::TRANSIENT)) {
+            if (id<MTLTexture> texture = createTransientTexture(&context, descriptor)) {
+                return texture;
+            }
+        } else if (any(usage & TextureUsage::SAMPLEABLE)) {
+            if (id<MTLTexture> texture = createResidentTexture(&context, descriptor)) {
+                return texture;
+            }
+        }
+        return [context.device newTextureWithDescriptor:descriptor];
+    };
+
     MTLTextureDescriptor* descriptor;
     switch (target) {
         case SamplerType::SAMPLER_2D:
@@ -480,7 +495,7 @@ MetalTexture::MetalTexture(MetalContext& context, SamplerType target, uint8_t le
             descriptor.sampleCount = multisampled ? samples : 1;
             descriptor.usage = getMetalTextureUsage(usage);
             descriptor.storageMode = MTLStorageModePrivate;
-            texture = [context.device newTextureWithDescriptor:descriptor];
+            texture = allocateTexture(descriptor);
             ASSERT_POSTCONDITION(texture != nil, "Could not create Metal texture. Out of memory?");
             break;
         case SamplerType::SAMPLER_CUBEMAP:
@@ -494,7 +509,7 @@ MetalTexture::MetalTexture(MetalContext& context, SamplerType target, uint8_t le
             descriptor.mipmapLevelCount = levels;
             descriptor.usage = getMetalTextureUsage(usage);
             descriptor.storageMode = MTLStorageModePrivate;
-            texture = [context.device newTextureWithDescriptor:descriptor];
+            texture = allocateTexture(descriptor);
             ASSERT_POSTCONDITION(texture != nil, "Could not create Metal texture. Out of memory?");
             break;
         case SamplerType::SAMPLER_3D:
@@ -507,7 +522,7 @@ MetalTexture::MetalTexture(MetalContext& context, SamplerType target, uint8_t le
             descriptor.mipmapLevelCount = levels;
             descriptor.usage = getMetalTextureUsage(usage);
             descriptor.storageMode = MTLStorageModePrivate;
-            texture = [context.device newTextureWithDescriptor:descriptor];
+            texture = allocateTexture(descriptor);
             ASSERT_POSTCONDITION(texture != nil, "Could not create Metal texture. Out of memory?");
             break;
         case SamplerType::SAMPLER_EXTERNAL:
@@ -908,15 +923,27 @@ void MetalSamplerGroup::mutate(id<MTLCommandBuffer> cmdBuffer) {
 
 void MetalSamplerGroup::useResources(id<MTLRenderCommandEncoder> renderPassEncoder) {
     assert_invariant(finalized);
+    // Heap-backed textures were already made resident for the whole pass with a single useHeap:
+    // call when the pass began; only committed allocations (external images, the empty texture,
+    // imported textures) still need an individual useResources call.
+    auto nonResident = utils::FixedCapacityVector<id<MTLTexture>>::with_capacity(textures.size());
+    for (id<MTLTexture> texture : textures) {
+        if (!texture.heap) {
+            nonResident.push_back(texture);
+        }
+    }
+    if (nonResident.empty()) {
+        return;
+    }
     if (@available(iOS 13, *)) {
         // TODO: pass only the appropriate stages to useResources.
-        [renderPassEncoder useResources:textures.data()
-                                  count:textures.size()
+        [renderPassEncoder useResources:nonResident.data()
+                                  count:nonResident.size()
                                   usage:MTLResourceUsageRead | MTLResourceUsageSample
                                  stages:MTLRenderStageFragment | MTLRenderStageVertex];
     } else {
-        [renderPassEncoder useResources:textures.data()
-                                  count:textures.size()
+        [renderPassEncoder useResources:nonResident.data()
+                                  count:nonResident.size()
                                   usage:MTLResourceUsageRead | MTLResourceUsageSample];
     }
 }
@@ -146,6 +146,10 @@ bool NoopDriver::isTextureSwizzleSupported() {
     return true;
 }
 
+StateCacheStatistics NoopDriver::getStateCacheStatistics() {
+    return {};
+}
+
 bool NoopDriver::isTextureFormatMipmappable(TextureFormat format) {
     return true;
 }
@@ -174,6 +178,14 @@ bool NoopDriver::isSRGBSwapChainSupported() {
     return false;
 }
 
+int32_t NoopDriver::getSwapChainImageFd(Handle<HwSwapChain> sch, uint32_t index) {
+    return -1;
+}
+
+uint64_t NoopDriver::getFrameLatencyNanos(Handle<HwSwapChain> sch) {
+    return 0;
+}
+
 bool NoopDriver::isStereoSupported() {
     return false;
 }
@@ -217,6 +229,10 @@ void NoopDriver::updateBufferObjectUnsynchronized(Handle<HwBufferObject> ibh, Bu
     scheduleDestroy(std::move(p));
 }
 
+void NoopDriver::copyBufferObject(Handle<HwBufferObject> dboh, uint32_t dstOffset,
+        Handle<HwBufferObject> sboh, uint32_t srcOffset, uint32_t size) {
+}
+
 void NoopDriver::resetBufferObject(Handle<HwBufferObject> boh) {
 }
 
@@ -253,7 +269,7 @@ void NoopDriver::setExternalStream(Handle<HwTexture> th, Handle<HwStream> sh) {
 void NoopDriver::generateMipmaps(Handle<HwTexture> th) { }
 
 void NoopDriver::updateSamplerGroup(Handle<HwSamplerGroup> sbh,
-        BufferDescriptor&& data) {
+        BufferDescriptor&& data, uint64_t dirtyMask) {
     scheduleDestroy(std::move(data));
 }
 
@@ -23,6 +23,11 @@
 
 #include <utils/Systrace.h>
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
 namespace filament::backend {
 
 struct OpenGLBlobCache::Blob {
@@ -37,7 +42,7 @@ OpenGLBlobCache::OpenGLBlobCache(OpenGLContext& gl) noexcept
 GLuint OpenGLBlobCache::retrieve(BlobCacheKey* outKey, Platform& platform,
         Program const& program) const noexcept {
     SYSTRACE_CALL();
-    if (!mCachingSupported || !platform.hasRetrieveBlobFunc()) {
+    if (!mCachingSupported) {
         // the key is never updated in that case
         return 0;
     }
@@ -47,35 +52,41 @@ GLuint OpenGLBlobCache::retrieve(BlobCacheKey* outKey, Platform& platform,
 #ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
     BlobCacheKey key{ program.getCacheId(), program.getSpecializationConstants() };
 
-    // FIXME: use a static buffer to avoid systematic allocation
-    // always attempt with 64 KiB
-    constexpr size_t DEFAULT_BLOB_SIZE = 65536;
-    std::unique_ptr<Blob, decltype(&::free)> blob{ (Blob*)malloc(DEFAULT_BLOB_SIZE), &::free };
-
-    size_t const blobSize = platform.retrieveBlob(
-            key.data(), key.size(), blob.get(), DEFAULT_BLOB_SIZE);
-
-    if (blobSize > 0) {
-        if (blobSize > DEFAULT_BLOB_SIZE) {
-            // our buffer was too small, retry with the correct size
-            blob.reset((Blob*)malloc(blobSize));
-            platform.retrieveBlob(
-                    key.data(), key.size(), blob.get(), blobSize);
-        }
+    // first check the binaries we linked ourselves; this doesn't depend on the
+    // application providing a blob cache
+    programId = retrieveFromMemoryCache(key);
+
+    if (!programId && platform.hasRetrieveBlobFunc()) {
+        // FIXME: use a static buffer to avoid systematic allocation
+        // always attempt with 64 KiB
+        constexpr size_t DEFAULT_BLOB_SIZE = 65536;
+        std::unique_ptr<Blob, decltype(&::free)> blob{ (Blob*)malloc(DEFAULT_BLOB_SIZE), &::free };
+
+        size_t const blobSize = platform.retrieveBlob(
+                key.data(), key.size(), blob.get(), DEFAULT_BLOB_SIZE);
+
+        if (blobSize > 0) {
+            if (blobSize > DEFAULT_BLOB_SIZE) {
+                // our buffer was too small, retry with the correct size
+                blob.reset((Blob*)malloc(blobSize));
+                platform.retrieveBlob(
+                        key.data(), key.size(), blob.get(), blobSize);
+            }
 
-        GLsizei const programBinarySize = GLsizei(blobSize - sizeof(Blob));
+            GLsizei const programBinarySize = GLsizei(blobSize - sizeof(Blob));
 
-        programId = glCreateProgram();
+            programId = glCreateProgram();
 
-        { // scope for systrace
-            SYSTRACE_NAME("glProgramBinary");
-            glProgramBinary(programId, blob->format, blob->data, programBinarySize);
-        }
+            { // scope for systrace
+                SYSTRACE_NAME("glProgramBinary");
+                glProgramBinary(programId, blob->format, blob->data, programBinarySize);
+            }
 
-        if (UTILS_UNLIKELY(glGetError() != GL_NO_ERROR)) {
-            // glProgramBinary can fail if for instance the driver has been updated
-            glDeleteProgram(programId);
-            programId = 0;
+            if (UTILS_UNLIKELY(glGetError() != GL_NO_ERROR)) {
+                // glProgramBinary can fail if for instance the driver has been updated
+                glDeleteProgram(programId);
+                programId = 0;
+            }
         }
     }
 
@@ -91,8 +102,7 @@ GLuint OpenGLBlobCache::retrieve(BlobCacheKey* outKey, Platform& platform,
 void OpenGLBlobCache::insert(Platform& platform,
         BlobCacheKey const& key, GLuint program) noexcept {
     SYSTRACE_CALL();
-    if (!mCachingSupported || !platform.hasInsertBlobFunc()) {
-        // the key is never updated in that case
+    if (!mCachingSupported) {
         return;
     }
 
@@ -115,11 +125,71 @@ void OpenGLBlobCache::insert(Platform& platform,
             GLenum const error = glGetError();
             if (error == GL_NO_ERROR) {
                 blob->format = format;
-                platform.insertBlob(key.data(), key.size(), blob.get(), size);
+                if (platform.hasInsertBlobFunc()) {
+                    platform.insertBlob(key.data(), key.size(), blob.get(), size);
+                }
+                // also keep the binary in memory, so re-specializing this program later
+                // doesn't recompile, even without a platform blob cache
+                auto binary = std::make_unique<char[]>(size_t(programBinarySize));
+                std::memcpy(binary.get(), blob->data, size_t(programBinarySize));
+                insertInMemoryCache(key, format, std::move(binary), size_t(programBinarySize));
             }
         }
     }
 #endif
 }
 
+GLuint OpenGLBlobCache::retrieveFromMemoryCache(BlobCacheKey const& key) const noexcept {
+    std::lock_guard<utils::Mutex> const lock(mMemoryCacheLock);
+    auto& cache = mMemoryCache;
+    auto const pos = std::find_if(cache.begin(), cache.end(), [&key](MemoryEntry const& entry) {
+        return entry.key.size() == key.size()
+                && !std::memcmp(entry.key.data(), key.data(), key.size());
+    });
+    if (pos == cache.end()) {
+        return 0;
+    }
+    pos->lastUsed = ++mMemoryCacheAge;
+
+    GLuint const programId = glCreateProgram();
+    { // scope for systrace
+        SYSTRACE_NAME("glProgramBinary");
+        glProgramBinary(programId, pos->format, pos->binary.get(), GLsizei(pos->binarySize));
+    }
+    if (UTILS_UNLIKELY(glGetError() != GL_NO_ERROR)) {
+        // the binary is stale (e.g. the context was lost), drop it
+        glDeleteProgram(programId);
+        mMemoryCacheSize -= pos->binarySize;
+        cache.erase(pos);
+        return 0;
+    }
+    return programId;
+}
+
+void OpenGLBlobCache::insertInMemoryCache(BlobCacheKey const& key,
+        GLenum format, std::unique_ptr<char[]> binary, size_t binarySize) noexcept {
+    std::lock_guard<utils::Mutex> const lock(mMemoryCacheLock);
+    auto& cache = mMemoryCache;
+    auto const pos = std::find_if(cache.begin(), cache.end(), [&key](MemoryEntry const& entry) {
+        return entry.key.size() == key.size()
+                && !std::memcmp(entry.key.data(), key.data(), key.size());
+    });
+    if (pos != cache.end()) {
+        // already cached (e.g. inserted by another compiler thread), keep the existing entry
+        return;
+    }
+    mMemoryCacheSize += binarySize;
+    cache.push_back({ key, format, std::move(binary), binarySize, ++mMemoryCacheAge });
+
+    // evict least recently used binaries if we're over budget
+    while (mMemoryCacheSize > IN_MEMORY_CACHE_MAX_SIZE && cache.size() > 1) {
+        auto const lru = std::min_element(cache.begin(), cache.end(),
+                [](MemoryEntry const& lhs, MemoryEntry const& rhs) {
+                    return lhs.lastUsed < rhs.lastUsed;
+                });
+        mMemoryCacheSize -= lru->binarySize;
+        cache.erase(lru);
+    }
+}
+
 } // namespace filament::backend
@@ -21,6 +21,14 @@
 
 #include "BlobCacheKey.h"
 
+#include <utils/Mutex.h>
+
+#include <memory>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
 namespace filament::backend {
 
 class Platform;
@@ -39,7 +47,34 @@ public:
 
 private:
     struct Blob;
+
+    // Program binaries we linked ourselves, kept in memory and keyed by the same
+    // (cacheId, specialization constants) tuple as the platform cache. This makes
+    // re-specializing a program (e.g. dynamic quality toggles) cheap even when the
+    // application hasn't installed a platform blob cache.
+    struct MemoryEntry {
+        BlobCacheKey key;
+        GLenum format;
+        std::unique_ptr<char[]> binary;
+        size_t binarySize;
+        uint32_t lastUsed;
+    };
+
+    static constexpr size_t IN_MEMORY_CACHE_MAX_SIZE = 4u * 1024u * 1024u;
+
+    GLuint retrieveFromMemoryCache(BlobCacheKey const& key) const noexcept;
+
+    void insertInMemoryCache(BlobCacheKey const& key,
+            GLenum format, std::unique_ptr<char[]> binary, size_t binarySize) noexcept;
+
     bool mCachingSupported = false;
+
+    // retrieve() runs on the backend thread while insert() can run on a compiler
+    // pool thread, so the in-memory cache needs its own lock.
+    mutable utils::Mutex mMemoryCacheLock;
+    mutable std::vector<MemoryEntry> mMemoryCache;
+    mutable size_t mMemoryCacheSize = 0;
+    mutable uint32_t mMemoryCacheAge = 0;
 };
 
 } // namespace filament::backend
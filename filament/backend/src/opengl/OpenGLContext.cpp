@@ -386,6 +386,9 @@ void OpenGLContext::initBugs(Bugs* bugs, Extensions const& exts,
             // early exit condition is flattened in EASU code
             bugs->split_easu = true;
 
+            // the color grading subpass degrades TAA performance
+            bugs->disable_subpass_with_taa = true;
+
             // initialize the non-used uniform array for Adreno drivers.
             bugs->enable_initialize_non_used_uniform_array = true;
 
@@ -708,10 +711,16 @@ void OpenGLContext::bindBuffer(GLenum target, GLuint buffer) noexcept {
             if (state.vao.p != &mDefaultVAO) {
                 state.vao.p->elementArray = buffer;
             }
+            mStateCacheStatistics.bufferBindsIssued++;
             glBindBuffer(target, buffer);
+        } else {
+            mStateCacheStatistics.bufferBindsAvoided++;
         }
     } else {
         size_t const targetIndex = getIndexForBufferTarget(target);
+        bool const redundant = state.buffers.genericBinding[targetIndex] == buffer;
+        mStateCacheStatistics.bufferBindsAvoided += redundant;
+        mStateCacheStatistics.bufferBindsIssued += !redundant;
         update_state(state.buffers.genericBinding[targetIndex], buffer, [&]() {
             glBindBuffer(target, buffer);
         });
@@ -107,6 +107,17 @@ public:
 
     void resetState() noexcept;
 
+    // Swaps the live redundant-bind counters into the last-frame snapshot and clears them.
+    // Called by the driver at frame boundaries.
+    void snapshotStateCacheStatistics() noexcept {
+        mLastStateCacheStatistics = mStateCacheStatistics;
+        mStateCacheStatistics = {};
+    }
+
+    StateCacheStatistics getStateCacheStatistics() const noexcept {
+        return mLastStateCacheStatistics;
+    }
+
     inline void useProgram(GLuint program) noexcept;
 
           void pixelStore(GLenum, GLint) noexcept;
@@ -250,6 +261,10 @@ public:
         // case we need an alternative algorithm
         bool split_easu;
 
+        // On some tilers, the framebuffer-fetch based color grading subpass degrades the
+        // performance of the TAA pass it is fused with.
+        bool disable_subpass_with_taa;
+
         // As of Android R some qualcomm drivers invalidate buffers for the whole render pass
         // even if glInvalidateFramebuffer() is called at the end of it.
         bool invalidate_end_only_if_invalidate_start;
@@ -373,7 +388,7 @@ public:
                     GLsizeiptr size = 0;
                 } buffers[MAX_BUFFER_BINDINGS];
             } targets[3];   // there are only 3 indexed buffer targets
-            GLuint genericBinding[7] = {};
+            GLuint genericBinding[8] = {};
         } buffers;
 
         struct {
@@ -423,6 +438,11 @@ private:
     ShaderModel mShaderModel = ShaderModel::MOBILE;
     FeatureLevel mFeatureLevel = FeatureLevel::FEATURE_LEVEL_1;
 
+    // Counters for redundant-bind elimination; the "last" copy is the snapshot of the previous
+    // frame that getStateCacheStatistics() reports.
+    StateCacheStatistics mStateCacheStatistics{};
+    StateCacheStatistics mLastStateCacheStatistics{};
+
     const std::array<std::tuple<bool const&, char const*, char const*>, sizeof(bugs)> mBugDatabase{{
             {   bugs.disable_glFlush,
                     "disable_glFlush",
@@ -454,6 +474,9 @@ private:
             {   bugs.split_easu,
                     "split_easu",
                     ""},
+            {   bugs.disable_subpass_with_taa,
+                    "disable_subpass_with_taa",
+                    ""},
             {   bugs.invalidate_end_only_if_invalidate_start,
                     "invalidate_end_only_if_invalidate_start",
                     ""},
@@ -586,6 +609,9 @@ constexpr size_t OpenGLContext::getIndexForBufferTarget(GLenum target) noexcept
 #ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
         case GL_PIXEL_PACK_BUFFER:          index = 5; break;
         case GL_PIXEL_UNPACK_BUFFER:        index = 6; break;
+#if defined(BACKEND_OPENGL_LEVEL_GLES31)
+        case GL_DRAW_INDIRECT_BUFFER:       index = 7; break;
+#endif
 #endif
         default: break;
     }
@@ -606,6 +632,9 @@ void OpenGLContext::bindSampler(GLuint unit, GLuint sampler) noexcept {
     assert_invariant(unit < MAX_TEXTURE_UNIT_COUNT);
     assert_invariant(mFeatureLevel >= FeatureLevel::FEATURE_LEVEL_1);
 #ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
+    bool const redundant = state.textures.units[unit].sampler == sampler;
+    mStateCacheStatistics.samplerBindsAvoided += redundant;
+    mStateCacheStatistics.samplerBindsIssued += !redundant;
     update_state(state.textures.units[unit].sampler, sampler, [&]() {
         glBindSampler(unit, sampler);
     });
@@ -673,7 +702,10 @@ void OpenGLContext::bindBufferRange(GLenum target, GLuint index, GLuint buffer,
         state.buffers.targets[targetIndex].buffers[index].offset = offset;
         state.buffers.targets[targetIndex].buffers[index].size = size;
         state.buffers.genericBinding[targetIndex] = buffer;
+        mStateCacheStatistics.bufferBindsIssued++;
         glBindBufferRange(target, index, buffer, offset, size);
+    } else {
+        mStateCacheStatistics.bufferBindsAvoided++;
     }
 #endif
 }
@@ -708,10 +740,15 @@ void OpenGLContext::bindFramebuffer(GLenum target, GLuint buffer) noexcept {
 void OpenGLContext::bindTexture(GLuint unit, GLuint target, GLuint texId, size_t targetIndex) noexcept {
     assert_invariant(targetIndex == getIndexForTextureTarget(target));
     assert_invariant(targetIndex < TEXTURE_TARGET_COUNT);
+    bool const force = (target == GL_TEXTURE_EXTERNAL_OES) && bugs.texture_external_needs_rebind;
+    bool const redundant = !force
+            && state.textures.units[unit].targets[targetIndex].texture_id == texId;
+    mStateCacheStatistics.textureBindsAvoided += redundant;
+    mStateCacheStatistics.textureBindsIssued += !redundant;
     update_state(state.textures.units[unit].targets[targetIndex].texture_id, texId, [&]() {
         activeTexture(unit);
         glBindTexture(target, texId);
-    }, (target == GL_TEXTURE_EXTERNAL_OES) && bugs.texture_external_needs_rebind);
+    }, force);
 }
 
 void OpenGLContext::bindTexture(GLuint unit, GLuint target, GLuint texId) noexcept {
@@ -719,6 +756,9 @@ void OpenGLContext::bindTexture(GLuint unit, GLuint target, GLuint texId) noexce
 }
 
 void OpenGLContext::useProgram(GLuint program) noexcept {
+    bool const redundant = state.program.use == program;
+    mStateCacheStatistics.programBindsAvoided += redundant;
+    mStateCacheStatistics.programBindsIssued += !redundant;
     update_state(state.program.use, program, [&]() {
         glUseProgram(program);
     });
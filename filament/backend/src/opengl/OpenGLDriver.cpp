@@ -193,6 +193,16 @@ OpenGLDriver::OpenGLDriver(OpenGLPlatform* platform, const Platform::DriverConfi
 
     mTimerQueryImpl = OpenGLTimerQueryFactory::init(mPlatform, *this);
 
+#if defined(BACKEND_OPENGL_VERSION_GL)
+    // glMultiDrawElementsIndirect is core in GL 4.3
+    mMultiDrawIndirectSupported = mContext.isAtLeastGL<4, 3>();
+#endif
+
+    // program eviction requires program binary support to re-create unloaded programs
+    if (!mContext.isES2() && mContext.gets.num_program_binary_formats >= 1) {
+        mResidentProgramLimit = driverConfig.residentProgramLimit;
+    }
+
     mShaderCompilerService.init();
 }
 
@@ -208,6 +218,12 @@ Dispatcher OpenGLDriver::getDispatcher() const noexcept {
 // ------------------------------------------------------------------------------------------------
 
 void OpenGLDriver::terminate() {
+    flushPendingDraws();
+    if (mIndirectDrawBatch.buffer) {
+        glDeleteBuffers(1, &mIndirectDrawBatch.buffer);
+        mIndirectDrawBatch.buffer = 0;
+    }
+
     // wait for the GPU to finish executing all commands
     glFinish();
 
@@ -228,6 +244,11 @@ void OpenGLDriver::terminate() {
     // because we called glFinish(), all callbacks should have been executed
     assert_invariant(mGpuCommandCompleteOps.empty());
 
+    for (auto const& [pbo, size]: mReadPixelsPboPool) {
+        glDeleteBuffers(1, &pbo);
+    }
+    mReadPixelsPboPool.clear();
+
     if (!getContext().isES2()) {
         for (auto& item: mSamplerMap) {
             mContext.unbindSampler(item.second);
@@ -268,6 +289,10 @@ bool OpenGLDriver::useProgram(OpenGLProgram* p) noexcept {
         return false;
     }
 
+    if (UTILS_UNLIKELY(mResidentProgramLimit)) {
+        p->touch(mFrameCount);
+    }
+
     // set-up textures and samplers in the proper TMUs (as specified in setSamplers)
     p->use(this, mContext);
 
@@ -559,6 +584,9 @@ void OpenGLDriver::createProgramR(Handle<HwProgram> ph, Program&& program) {
     }
 
     construct<OpenGLProgram>(ph, *this, std::move(program));
+    if (UTILS_UNLIKELY(mResidentProgramLimit)) {
+        mEvictablePrograms.push_back(handle_cast<OpenGLProgram*>(ph));
+    }
     CHECK_GL_ERROR(utils::slog.e)
 }
 
@@ -1453,6 +1481,14 @@ void OpenGLDriver::destroyProgram(Handle<HwProgram> ph) {
     DEBUG_MARKER()
     if (ph) {
         OpenGLProgram* p = handle_cast<OpenGLProgram*>(ph);
+        if (UTILS_UNLIKELY(mResidentProgramLimit)) {
+            auto& programs = mEvictablePrograms;
+            auto pos = std::find(programs.begin(), programs.end(), p);
+            if (pos != programs.end()) {
+                *pos = programs.back();
+                programs.pop_back();
+            }
+        }
         destruct(ph, p);
     }
 }
@@ -1894,6 +1930,16 @@ bool OpenGLDriver::isSRGBSwapChainSupported() {
     return mPlatform.isSRGBSwapChainSupported();
 }
 
+int32_t OpenGLDriver::getSwapChainImageFd(Handle<HwSwapChain> sch, uint32_t index) {
+    // GL has no external-memory export path for swapchain images
+    return -1;
+}
+
+uint64_t OpenGLDriver::getFrameLatencyNanos(Handle<HwSwapChain> sch) {
+    // EGL_ANDROID_get_frame_timestamps is not wired into the platform layer
+    return 0;
+}
+
 bool OpenGLDriver::isStereoSupported() {
     // Stereo requires instancing and EXT_clip_cull_distance.
     if (UTILS_UNLIKELY(mContext.isES2())) {
@@ -1920,6 +1966,8 @@ bool OpenGLDriver::isWorkaroundNeeded(Workaround workaround) {
             return mContext.bugs.powervr_shader_workarounds;
         case Workaround::DISABLE_THREAD_AFFINITY:
             return mContext.bugs.disable_thread_affinity;
+        case Workaround::DISABLE_SUBPASS_WITH_TAA:
+            return mContext.bugs.disable_subpass_with_taa;
         default:
             return false;
     }
@@ -1946,6 +1994,11 @@ size_t OpenGLDriver::getMaxUniformBufferSize() {
     return mContext.gets.max_uniform_block_size;
 }
 
+StateCacheStatistics OpenGLDriver::getStateCacheStatistics() {
+    // counters for the last completed frame, snapshotted in endFrame()
+    return mContext.getStateCacheStatistics();
+}
+
 // ------------------------------------------------------------------------------------------------
 // Swap chains
 // ------------------------------------------------------------------------------------------------
@@ -2014,6 +2067,7 @@ void OpenGLDriver::setVertexBufferObject(Handle<HwVertexBuffer> vbh,
 void OpenGLDriver::updateIndexBuffer(
         Handle<HwIndexBuffer> ibh, BufferDescriptor&& p, uint32_t byteOffset) {
     DEBUG_MARKER()
+    flushPendingDraws();
 
     auto& gl = mContext;
     GLIndexBuffer* ib = handle_cast<GLIndexBuffer *>(ibh);
@@ -2031,6 +2085,7 @@ void OpenGLDriver::updateIndexBuffer(
 void OpenGLDriver::updateBufferObject(
         Handle<HwBufferObject> boh, BufferDescriptor&& bd, uint32_t byteOffset) {
     DEBUG_MARKER()
+    flushPendingDraws();
 
     auto& gl = mContext;
     GLBufferObject* bo = handle_cast<GLBufferObject *>(boh);
@@ -2066,6 +2121,7 @@ void OpenGLDriver::updateBufferObject(
 void OpenGLDriver::updateBufferObjectUnsynchronized(
         Handle<HwBufferObject> boh, BufferDescriptor&& bd, uint32_t byteOffset) {
     DEBUG_MARKER()
+    flushPendingDraws();
 
     if (UTILS_UNLIKELY(mContext.isES2())) {
         updateBufferObject(boh, std::move(bd), byteOffset);
@@ -2111,8 +2167,49 @@ retry:
 #endif
 }
 
+void OpenGLDriver::copyBufferObject(Handle<HwBufferObject> dboh, uint32_t dstOffset,
+        Handle<HwBufferObject> sboh, uint32_t srcOffset, uint32_t size) {
+    DEBUG_MARKER()
+    flushPendingDraws();
+
+    auto& gl = mContext;
+    GLBufferObject* dbo = handle_cast<GLBufferObject*>(dboh);
+    GLBufferObject* sbo = handle_cast<GLBufferObject*>(sboh);
+
+    assert_invariant(srcOffset + size <= sbo->byteCount);
+    assert_invariant(dstOffset + size <= dbo->byteCount);
+
+    if (UTILS_UNLIKELY(gl.isES2())) {
+        // ES2 has no server-side copies; the only buffers we keep readable copies of are the
+        // emulated uniform buffers, so that's the only combination we can support here.
+        assert_invariant(sbo->bindingType == BufferObjectBinding::UNIFORM);
+        assert_invariant(dbo->bindingType == BufferObjectBinding::UNIFORM);
+        memcpy(static_cast<uint8_t*>(dbo->gl.buffer) + dstOffset,
+                static_cast<uint8_t const*>(sbo->gl.buffer) + srcOffset, size);
+        dbo->age++;
+        return;
+    }
+
+#ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
+    assert_invariant(sbo->gl.id);
+    assert_invariant(dbo->gl.id);
+
+    // the dedicated copy targets leave the state cache and the bound VAO alone, and work
+    // even when source and destination have the same binding type
+    glBindBuffer(GL_COPY_READ_BUFFER, sbo->gl.id);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, dbo->gl.id);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+            srcOffset, dstOffset, size);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    CHECK_GL_ERROR(utils::slog.e)
+#endif
+}
+
 void OpenGLDriver::resetBufferObject(Handle<HwBufferObject> boh) {
     DEBUG_MARKER()
+    flushPendingDraws();
 
     auto& gl = mContext;
     GLBufferObject* bo = handle_cast<GLBufferObject*>(boh);
@@ -2127,8 +2224,9 @@ void OpenGLDriver::resetBufferObject(Handle<HwBufferObject> boh) {
 }
 
 void OpenGLDriver::updateSamplerGroup(Handle<HwSamplerGroup> sbh,
-        BufferDescriptor&& data) {
+        BufferDescriptor&& data, uint64_t dirtyMask) {
     DEBUG_MARKER()
+    flushPendingDraws();
 
     OpenGLContext const& context = getContext();
 
@@ -2147,6 +2245,10 @@ void OpenGLDriver::updateSamplerGroup(Handle<HwSamplerGroup> sbh,
 
     auto const* const pSamplers = (SamplerDescriptor const*)data.buffer;
     for (size_t i = 0, c = sb->textureUnitEntries.size(); i < c; i++) {
+        // only update the slots that changed, the others keep their current entry
+        if (!(dirtyMask & (uint64_t(1) << i))) {
+            continue;
+        }
         GLuint samplerId = 0u;
         const GLTexture* t = nullptr;
         if (UTILS_LIKELY(pSamplers[i].t)) {
@@ -2213,6 +2315,7 @@ void OpenGLDriver::updateSamplerGroup(Handle<HwSamplerGroup> sbh,
 
 void OpenGLDriver::setMinMaxLevels(Handle<HwTexture> th, uint32_t minLevel, uint32_t maxLevel) {
     DEBUG_MARKER()
+    flushPendingDraws();
 
 #ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
     auto& gl = mContext;
@@ -2238,6 +2341,7 @@ void OpenGLDriver::update3DImage(Handle<HwTexture> th,
         uint32_t width, uint32_t height, uint32_t depth,
         PixelBufferDescriptor&& data) {
     DEBUG_MARKER()
+    flushPendingDraws();
 
     GLTexture* t = handle_cast<GLTexture *>(th);
     if (data.type == PixelDataType::COMPRESSED) {
@@ -2251,6 +2355,7 @@ void OpenGLDriver::update3DImage(Handle<HwTexture> th,
 
 void OpenGLDriver::generateMipmaps(Handle<HwTexture> th) {
     DEBUG_MARKER()
+    flushPendingDraws();
 
     auto& gl = mContext;
     GLTexture* t = handle_cast<GLTexture *>(th);
@@ -2645,6 +2750,7 @@ void OpenGLDriver::compilePrograms(CompilerPriorityQueue priority,
 void OpenGLDriver::beginRenderPass(Handle<HwRenderTarget> rth,
         const RenderPassParams& params) {
     DEBUG_MARKER()
+    flushPendingDraws();
 
     getShaderCompilerService().tick();
 
@@ -2721,6 +2827,7 @@ void OpenGLDriver::beginRenderPass(Handle<HwRenderTarget> rth,
 
 void OpenGLDriver::endRenderPass(int) {
     DEBUG_MARKER()
+    flushPendingDraws();
     auto& gl = mContext;
 
     assert_invariant(mRenderPassTarget); // endRenderPass() called without beginRenderPass()?
@@ -2923,6 +3030,14 @@ void OpenGLDriver::bindBufferRange(BufferObjectBinding bindingType, uint32_t ind
         assert_invariant(bindingType == BufferObjectBinding::SHADER_STORAGE ||
                          ub->gl.binding == target);
 
+        // A pending indirect draw batch must be submitted before a binding changes under it.
+        size_t const targetIndex = OpenGLContext::getIndexForBufferTarget(target);
+        auto const& binding = gl.state.buffers.targets[targetIndex].buffers[index];
+        if (binding.name != ub->gl.id || binding.offset != GLintptr(offset)
+                || binding.size != GLsizeiptr(size)) {
+            flushPendingDraws();
+        }
+
         gl.bindBufferRange(target, GLuint(index), ub->gl.id, offset, size);
     }
 
@@ -2938,6 +3053,7 @@ void OpenGLDriver::unbindBuffer(BufferObjectBinding bindingType, uint32_t index)
         return;
     }
 
+    flushPendingDraws();
     GLenum const target = GLUtils::getBufferBindingType(bindingType);
     gl.bindBufferRange(target, GLuint(index), 0, 0, 0);
     CHECK_GL_ERROR(utils::slog.e)
@@ -2948,6 +3064,7 @@ void OpenGLDriver::bindSamplers(uint32_t index, Handle<HwSamplerGroup> sbh) {
     assert_invariant(index < Program::SAMPLER_BINDING_COUNT);
     GLSamplerGroup* sb = handle_cast<GLSamplerGroup *>(sbh);
     mSamplerBindings[index] = sb;
+    mSamplerBindingsVersion++;
     CHECK_GL_ERROR(utils::slog.e)
 }
 
@@ -3035,6 +3152,7 @@ void OpenGLDriver::readPixels(Handle<HwRenderTarget> src,
         uint32_t x, uint32_t y, uint32_t width, uint32_t height,
         PixelBufferDescriptor&& p) {
     DEBUG_MARKER()
+    flushPendingDraws();
     auto& gl = mContext;
 
     GLenum const glFormat = getFormat(p.format);
@@ -3106,10 +3224,8 @@ void OpenGLDriver::readPixels(Handle<HwRenderTarget> src,
     // which we're always emulating. So if we have a resolved fbo (fbo_read), use that instead.
     gl.bindFramebuffer(GL_READ_FRAMEBUFFER, s->gl.fbo_read ? s->gl.fbo_read : s->gl.fbo);
 
-    GLuint pbo;
-    glGenBuffers(1, &pbo);
-    gl.bindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
-    glBufferData(GL_PIXEL_PACK_BUFFER, pboSize, nullptr, GL_STATIC_DRAW);
+    // acquireReadPixelsPbo() leaves the buffer bound to GL_PIXEL_PACK_BUFFER
+    auto const [pbo, pboAllocatedSize] = acquireReadPixelsPbo(pboSize);
     glReadPixels(GLint(x), GLint(y), GLint(width), GLint(height), glFormat, glType, nullptr);
     gl.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
     CHECK_GL_ERROR(utils::slog.e)
@@ -3117,7 +3233,8 @@ void OpenGLDriver::readPixels(Handle<HwRenderTarget> src,
     // we're forced to make a copy on the heap because otherwise it deletes std::function<> copy
     // constructor.
     auto* const pUserBuffer = new PixelBufferDescriptor(std::move(p));
-    whenGpuCommandsComplete([this, width, height, pbo, pboSize, pUserBuffer]() mutable {
+    whenGpuCommandsComplete(
+            [this, width, height, pbo, pboSize, pboAllocatedSize, pUserBuffer]() mutable {
         PixelBufferDescriptor& p = *pUserBuffer;
         auto& gl = mContext;
         gl.bindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
@@ -3149,7 +3266,7 @@ void OpenGLDriver::readPixels(Handle<HwRenderTarget> src,
 #endif
         }
         gl.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-        glDeleteBuffers(1, &pbo);
+        releaseReadPixelsPbo(pbo, pboAllocatedSize);
         scheduleDestroy(std::move(p));
         delete pUserBuffer;
         CHECK_GL_ERROR(utils::slog.e)
@@ -3157,6 +3274,42 @@ void OpenGLDriver::readPixels(Handle<HwRenderTarget> src,
 #endif
 }
 
+std::pair<GLuint, GLsizeiptr> OpenGLDriver::acquireReadPixelsPbo(GLsizeiptr const size) noexcept {
+    auto& gl = mContext;
+    auto& pool = mReadPixelsPboPool;
+
+    // reuse the smallest recycled buffer that is large enough
+    auto best = pool.end();
+    for (auto it = pool.begin(); it != pool.end(); ++it) {
+        if (it->second >= size && (best == pool.end() || it->second < best->second)) {
+            best = it;
+        }
+    }
+    if (best != pool.end()) {
+        auto const entry = *best;
+        pool.erase(best);
+        gl.bindBuffer(GL_PIXEL_PACK_BUFFER, entry.first);
+        return entry;
+    }
+
+    GLuint pbo;
+    glGenBuffers(1, &pbo);
+    gl.bindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+    // STREAM_READ hints the driver to place the buffer in CPU-cached memory; a device-local
+    // placement would make the glMapBufferRange() in the completion callback crawl.
+    glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+    return { pbo, size };
+}
+
+void OpenGLDriver::releaseReadPixelsPbo(GLuint pbo, GLsizeiptr const size) noexcept {
+    auto& pool = mReadPixelsPboPool;
+    if (pool.size() < READ_PIXELS_PBO_POOL_SIZE) {
+        pool.emplace_back(pbo, size);
+    } else {
+        glDeleteBuffers(1, &pbo);
+    }
+}
+
 void OpenGLDriver::readBufferSubData(backend::BufferObjectHandle boh,
         uint32_t offset, uint32_t size, backend::BufferDescriptor&& p) {
     UTILS_UNUSED_IN_RELEASE auto& gl = mContext;
@@ -3168,11 +3321,9 @@ void OpenGLDriver::readBufferSubData(backend::BufferObjectHandle boh,
     // TODO: measure the two solutions
     if constexpr (true) {
         // schedule a copy of the buffer we're reading into a PBO, this *should* happen
-        // asynchronously without stalling the CPU.
-        GLuint pbo;
-        glGenBuffers(1, &pbo);
-        gl.bindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
-        glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)size, nullptr, GL_STATIC_DRAW);
+        // asynchronously without stalling the CPU. The PBO comes from the same recycling
+        // pool as readPixels'.
+        auto const [pbo, pboAllocatedSize] = acquireReadPixelsPbo((GLsizeiptr)size);
         gl.bindBuffer(bo->gl.binding, bo->gl.id);
         glCopyBufferSubData(bo->gl.binding, GL_PIXEL_PACK_BUFFER, offset, 0, size);
         gl.bindBuffer(bo->gl.binding, 0);
@@ -3181,7 +3332,7 @@ void OpenGLDriver::readBufferSubData(backend::BufferObjectHandle boh,
 
         // then, we schedule a mapBuffer of the PBO later, once the fence has signaled
         auto* pUserBuffer = new BufferDescriptor(std::move(p));
-        whenGpuCommandsComplete([this, size, pbo, pUserBuffer]() mutable {
+        whenGpuCommandsComplete([this, size, pbo, pboAllocatedSize, pUserBuffer]() mutable {
             BufferDescriptor& p = *pUserBuffer;
             auto& gl = mContext;
             gl.bindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
@@ -3191,7 +3342,7 @@ void OpenGLDriver::readBufferSubData(backend::BufferObjectHandle boh,
                 glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
             }
             gl.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-            glDeleteBuffers(1, &pbo);
+            releaseReadPixelsPbo(pbo, pboAllocatedSize);
             scheduleDestroy(std::move(p));
             delete pUserBuffer;
             CHECK_GL_ERROR(utils::slog.e)
@@ -3236,6 +3387,12 @@ void OpenGLDriver::whenFrameComplete(const std::function<void()>& fn) noexcept {
 
 void OpenGLDriver::whenGpuCommandsComplete(const std::function<void()>& fn) noexcept {
     GLsync sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    // A fence is allowed to stay unsignaled indefinitely until the command stream is flushed
+    // to the GPU. Readbacks issued after the frame's last flush (screenshots, picking) would
+    // otherwise wait a whole frame -- or forever -- for their callback.
+    if (!mContext.bugs.disable_glFlush) {
+        glFlush();
+    }
     mGpuCommandCompleteOps.emplace_back(sync, fn);
     CHECK_GL_ERROR(utils::slog.e)
 }
@@ -3331,11 +3488,49 @@ void OpenGLDriver::endFrame(UTILS_UNUSED uint32_t frameId) {
     gl.depthFunc(GL_LESS);
     gl.disable(GL_SCISSOR_TEST);
 #endif
+    mContext.snapshotStateCacheStatistics();
+    mFrameCount++;
+    if (UTILS_UNLIKELY(mResidentProgramLimit)) {
+        evictProgramsIfNeeded();
+    }
     //SYSTRACE_NAME("glFinish");
     //glFinish();
     insertEventMarker("endFrame");
 }
 
+UTILS_NOINLINE
+void OpenGLDriver::evictProgramsIfNeeded() noexcept {
+    // don't evict programs used in the last few frames, even if we're over the ceiling,
+    // so that an over-budget working set doesn't thrash
+    constexpr uint32_t MIN_UNUSED_FRAMES = 30;
+
+    auto& programs = mEvictablePrograms;
+    size_t resident = std::count_if(programs.begin(), programs.end(),
+            [](OpenGLProgram const* p) { return p->isResident(); });
+    if (UTILS_LIKELY(resident <= mResidentProgramLimit)) {
+        return;
+    }
+
+    // evict the least recently used programs first
+    std::sort(programs.begin(), programs.end(),
+            [](OpenGLProgram const* lhs, OpenGLProgram const* rhs) {
+                return lhs->getLastUsedFrame() < rhs->getLastUsedFrame();
+            });
+
+    for (OpenGLProgram* const p : programs) {
+        if (resident <= mResidentProgramLimit) {
+            break;
+        }
+        if (p->getLastUsedFrame() + MIN_UNUSED_FRAMES > mFrameCount) {
+            // the list is sorted, all remaining programs are more recent
+            break;
+        }
+        if (p->isResident() && p->unload(mContext)) {
+            resident--;
+        }
+    }
+}
+
 void OpenGLDriver::flush(int) {
     DEBUG_MARKER()
     auto& gl = mContext;
@@ -3346,6 +3541,7 @@ void OpenGLDriver::flush(int) {
 
 void OpenGLDriver::finish(int) {
     DEBUG_MARKER()
+    flushPendingDraws();
     glFinish();
 #ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
     executeGpuCommandsCompleteOps();
@@ -3461,6 +3657,7 @@ void OpenGLDriver::blit(
         Handle<HwTexture> src, uint8_t dstLevel, uint8_t dstLayer, uint2 srcOrigin,
         uint2 size) {
     DEBUG_MARKER()
+    flushPendingDraws();
     UTILS_UNUSED_IN_RELEASE auto& gl = mContext;
     assert_invariant(!gl.isES2());
 
@@ -3601,6 +3798,8 @@ void OpenGLDriver::blitDEPRECATED(TargetBufferFlags buffers,
 
     // Note: blitDEPRECATED is only used by Renderer::copyFrame
 
+    flushPendingDraws();
+
     DEBUG_MARKER()
     UTILS_UNUSED_IN_RELEASE auto& gl = mContext;
     assert_invariant(!gl.isES2());
@@ -3684,20 +3883,54 @@ void OpenGLDriver::updateTextureLodRange(GLTexture* texture, int8_t targetLevel)
 #endif
 }
 
+void OpenGLDriver::flushPendingDraws() noexcept {
+#if defined(BACKEND_OPENGL_VERSION_GL)
+    auto& batch = mIndirectDrawBatch;
+    auto& records = batch.records;
+    if (records.empty()) {
+        return;
+    }
+
+    if (UTILS_LIKELY(records.size() == 1)) {
+        // A batch of one gains nothing from the indirect path, issue it directly.
+        auto const& r = records[0];
+        void const* const indices =
+                reinterpret_cast<void const*>(uintptr_t(r.firstIndex) << batch.indicesShift);
+        if (UTILS_LIKELY(r.instanceCount <= 1)) {
+            glDrawElements(batch.mode, (GLsizei)r.count, batch.indicesType, indices);
+        } else {
+            glDrawElementsInstanced(batch.mode, (GLsizei)r.count, batch.indicesType, indices,
+                    (GLsizei)r.instanceCount);
+        }
+    } else {
+        auto& gl = mContext;
+        if (UTILS_UNLIKELY(!batch.buffer)) {
+            glGenBuffers(1, &batch.buffer);
+        }
+        gl.bindBuffer(GL_DRAW_INDIRECT_BUFFER, batch.buffer);
+        // Orphan the previous records, the GPU may still be consuming them.
+        glBufferData(GL_DRAW_INDIRECT_BUFFER,
+                GLsizeiptr(records.size() * sizeof(DrawElementsIndirectCommand)),
+                records.data(), GL_STREAM_DRAW);
+        glMultiDrawElementsIndirect(batch.mode, batch.indicesType, nullptr,
+                (GLsizei)records.size(), 0);
+    }
+    records.clear();
+
+#ifdef FILAMENT_ENABLE_MATDBG
+    CHECK_GL_ERROR_NON_FATAL(utils::slog.e)
+#else
+    CHECK_GL_ERROR(utils::slog.e)
+#endif
+#endif
+}
+
 void OpenGLDriver::draw(PipelineState state, Handle<HwRenderPrimitive> rph, uint32_t instanceCount) {
     DEBUG_MARKER()
     auto& gl = mContext;
 
     OpenGLProgram* const p = handle_cast<OpenGLProgram*>(state.program);
 
-    bool const success = useProgram(p);
-    if (UTILS_UNLIKELY(!success)) {
-        // Avoid fatal (or cascading) errors that can occur during the draw call when the program
-        // is invalid. The shader compile error has already been dumped to the console at this
-        // point, so it's fine to simply return early.
-        return;
-    }
-
     GLRenderPrimitive* const rp = handle_cast<GLRenderPrimitive*>(rph);
 
     // Gracefully do nothing if the render primitive has not been set up.
@@ -3705,11 +3938,44 @@ void OpenGLDriver::draw(PipelineState state, Handle<HwRenderPrimitive> rph, uint
     if (UTILS_UNLIKELY(!vb)) {
         return;
     }
+    GLVertexBuffer const* const glvb = handle_cast<GLVertexBuffer*>(vb);
+
+#if defined(BACKEND_OPENGL_VERSION_GL)
+    // A draw can extend the pending indirect batch only if it derives exactly the same GL
+    // state; everything draw() sets below is a function of the fields compared here. The
+    // decision is made before any GL state is touched so that a pending batch is always
+    // submitted under the state it was recorded with.
+    bool batchable = false;
+    if (mMultiDrawIndirectSupported) {
+        auto const& batch = mIndirectDrawBatch;
+        batchable = rp->gl.vertexBufferVersion == glvb->bufferObjectsVersion
+                && batch.program == state.program
+                && batch.vertexBufferWithObjects == vb
+                && batch.elementArray == rp->gl.elementArray
+                && batch.mode == GLenum(rp->type)
+                && batch.indicesType == rp->gl.getIndicesType()
+                && batch.samplerBindingsVersion == mSamplerBindingsVersion
+                && !(batch.rasterState != state.rasterState)
+                && !memcmp(&batch.stencilState, &state.stencilState, sizeof(StencilState))
+                && !memcmp(&batch.polygonOffset, &state.polygonOffset, sizeof(PolygonOffset))
+                && !memcmp(&batch.scissor, &state.scissor, sizeof(Viewport));
+        if (!batchable) {
+            flushPendingDraws();
+        }
+    }
+#endif
+
+    bool const success = useProgram(p);
+    if (UTILS_UNLIKELY(!success)) {
+        // Avoid fatal (or cascading) errors that can occur during the draw call when the program
+        // is invalid. The shader compile error has already been dumped to the console at this
+        // point, so it's fine to simply return early.
+        return;
+    }
 
     gl.bindVertexArray(&rp->gl);
 
     // If necessary, mutate the bindings in the VAO.
-    GLVertexBuffer const* const glvb = handle_cast<GLVertexBuffer*>(vb);
     if (UTILS_UNLIKELY(rp->gl.vertexBufferVersion != glvb->bufferObjectsVersion)) {
         updateVertexArrayObject(rp, glvb);
     }
@@ -3721,6 +3987,33 @@ void OpenGLDriver::draw(PipelineState state, Handle<HwRenderPrimitive> rph, uint
 
     setScissor(state.scissor);
 
+#if defined(BACKEND_OPENGL_VERSION_GL)
+    if (mMultiDrawIndirectSupported) {
+        auto& batch = mIndirectDrawBatch;
+        if (!batchable) {
+            batch.program = state.program;
+            batch.vertexBufferWithObjects = vb;
+            batch.elementArray = rp->gl.elementArray;
+            batch.mode = GLenum(rp->type);
+            batch.indicesType = rp->gl.getIndicesType();
+            batch.indicesShift = (rp->gl.indicesSize == 4u) ? 2u : 1u;
+            batch.samplerBindingsVersion = mSamplerBindingsVersion;
+            batch.rasterState = state.rasterState;
+            batch.stencilState = state.stencilState;
+            batch.polygonOffset = state.polygonOffset;
+            batch.scissor = state.scissor;
+        }
+        batch.records.push_back({
+                .count = uint32_t(rp->count),
+                .instanceCount = instanceCount ? instanceCount : 1u,
+                .firstIndex = uint32_t(rp->offset) >> batch.indicesShift,
+                .baseVertex = 0,
+                .baseInstance = 0,
+        });
+        return;
+    }
+#endif
+
     if (UTILS_LIKELY(instanceCount <= 1)) {
         glDrawElements(GLenum(rp->type), (GLsizei)rp->count, rp->gl.getIndicesType(),
                 reinterpret_cast<const void*>(rp->offset));
@@ -3741,6 +4034,7 @@ void OpenGLDriver::draw(PipelineState state, Handle<HwRenderPrimitive> rph, uint
 }
 
 void OpenGLDriver::dispatchCompute(Handle<HwProgram> program, math::uint3 workGroupCount) {
+    flushPendingDraws();
     getShaderCompilerService().tick();
 
     OpenGLProgram* const p = handle_cast<OpenGLProgram*>(program);
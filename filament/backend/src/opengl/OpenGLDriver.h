@@ -217,6 +217,8 @@ private:
         return mShaderCompilerService;
     }
 
+    uint32_t getResidentProgramLimit() const noexcept { return mResidentProgramLimit; }
+
     ShaderModel getShaderModel() const noexcept final;
 
     /*
@@ -289,6 +291,43 @@ private:
 
     void updateVertexArrayObject(GLRenderPrimitive* rp, GLVertexBuffer const* vb);
 
+    // Layout mandated for GL_DRAW_INDIRECT_BUFFER records by glMultiDrawElementsIndirect.
+    struct DrawElementsIndirectCommand {
+        uint32_t count;
+        uint32_t instanceCount;
+        uint32_t firstIndex;
+        uint32_t baseVertex;
+        uint32_t baseInstance;
+    };
+
+    // On GL 4.3+, consecutive draws that share the entire pipeline state and source their
+    // indices from the same buffers (e.g. the primitives of a multi-primitive mesh) are
+    // accumulated here and issued as a single glMultiDrawElementsIndirect() call, which
+    // amortizes the per-draw validation work done by the GL driver. The signature below
+    // captures everything draw() derives GL state from; commands that can change GL state
+    // or resource contents between two draws call flushPendingDraws() instead.
+    struct {
+        std::vector<DrawElementsIndirectCommand> records;
+        Handle<HwProgram> program;
+        Handle<HwVertexBuffer> vertexBufferWithObjects;
+        GLuint elementArray = 0;
+        GLenum mode = 0;
+        GLenum indicesType = 0;
+        uint8_t indicesShift = 0;
+        RasterState rasterState;
+        StencilState stencilState;
+        PolygonOffset polygonOffset;
+        Viewport scissor{};
+        uint32_t samplerBindingsVersion = 0;
+        GLuint buffer = 0;
+    } mIndirectDrawBatch;
+    bool mMultiDrawIndirectSupported = false;
+    uint32_t mSamplerBindingsVersion = 0;
+
+    // Submits (and empties) the pending indirect draw batch, if any. This must be called
+    // before any GL state change that the batched draws could observe.
+    void flushPendingDraws() noexcept;
+
     void framebufferTexture(TargetBufferInfo const& binfo,
             GLRenderTarget const* rt, GLenum attachment) noexcept;
 
@@ -370,6 +409,14 @@ private:
     mutable tsl::robin_map<SamplerParams, GLuint,
             SamplerParams::Hasher, SamplerParams::EqualTo> mSamplerMap;
 
+    // Program residency management (see DriverConfig::residentProgramLimit). All programs
+    // are registered here when eviction is enabled; the per-frame maintenance unloads the
+    // least recently used ones when we're over the resident ceiling.
+    void evictProgramsIfNeeded() noexcept;
+    std::vector<OpenGLProgram*> mEvictablePrograms;
+    uint32_t mResidentProgramLimit = 0;
+    uint32_t mFrameCount = 0;
+
     // this must be accessed from the driver thread only
     std::vector<GLTexture*> mTexturesWithStreamsAttached;
 
@@ -388,6 +435,14 @@ private:
     void executeGpuCommandsCompleteOps() noexcept;
     std::vector<std::pair<GLsync, std::function<void()>>> mGpuCommandCompleteOps;
 
+    // Staging PBOs recycled by readPixels(), so that full-rate readbacks (e.g. per-frame
+    // capture) don't create and destroy a buffer object on every call. The pool size bounds
+    // how many readbacks can be in flight before we start allocating again.
+    static constexpr size_t READ_PIXELS_PBO_POOL_SIZE = 4;
+    std::pair<GLuint, GLsizeiptr> acquireReadPixelsPbo(GLsizeiptr size) noexcept;
+    void releaseReadPixelsPbo(GLuint pbo, GLsizeiptr size) noexcept;
+    std::vector<std::pair<GLuint, GLsizeiptr>> mReadPixelsPboPool;
+
     void whenFrameComplete(const std::function<void()>& fn) noexcept;
     std::vector<std::function<void()>> mFrameCompleteOps;
 #endif
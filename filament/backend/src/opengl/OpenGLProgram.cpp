@@ -57,6 +57,10 @@ OpenGLProgram::OpenGLProgram(OpenGLDriver& gld, Program&& program) noexcept
     mToken = compiler.createProgram(name, std::move(program));
 
     ShaderCompilerService::setUserData(mToken, lazyInitializationData);
+
+    if (UTILS_UNLIKELY(gld.getResidentProgramLimit() > 0)) {
+        mResidency = new(std::nothrow) ResidencyState{};
+    }
 }
 
 OpenGLProgram::~OpenGLProgram() noexcept {
@@ -73,12 +77,69 @@ OpenGLProgram::~OpenGLProgram() noexcept {
     }
 
     delete [] mUniformsRecords;
+    delete mResidency;
     const GLuint program = gl.program;
     if (program) {
         glDeleteProgram(program);
     }
 }
 
+bool OpenGLProgram::unload(OpenGLContext& context) noexcept {
+    if (!mResidency || !gl.program || mToken) {
+        return false;
+    }
+#ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
+    // We snapshot the binary here rather than reusing the blob cache entry, because the
+    // binary captured now includes the block bindings and sampler uniforms set by
+    // initializeProgramState() after linking.
+    GLint binarySize = 0;
+    glGetProgramiv(gl.program, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+    if (binarySize <= 0) {
+        return false;
+    }
+    GLenum format{};
+    auto binary = utils::FixedCapacityVector<char>(size_t(binarySize));
+    glGetProgramBinary(gl.program, binarySize, &binarySize, &format, binary.data());
+    if (UTILS_UNLIKELY(glGetError() != GL_NO_ERROR)) {
+        return false;
+    }
+    mResidency->binaryFormat = format;
+    mResidency->binary = std::move(binary);
+    // a deleted program stays alive in the driver as long as it's the current program
+    context.useProgram(0);
+    glDeleteProgram(gl.program);
+    gl.program = 0;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void OpenGLProgram::restore() noexcept {
+    SYSTRACE_CALL();
+    assert_invariant(canRestore());
+#ifndef FILAMENT_SILENCE_NOT_SUPPORTED_BY_ES2
+    GLuint const program = glCreateProgram();
+    glProgramBinary(program, mResidency->binaryFormat,
+            mResidency->binary.data(), GLsizei(mResidency->binary.size()));
+    GLint status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (UTILS_UNLIKELY(status != GL_TRUE)) {
+        // this can happen e.g. after a driver update; we don't keep the sources around,
+        // so this program is lost for good.
+        slog.w << "Failed to restore unloaded program \"" << name.c_str_safe() << "\""
+               << io::endl;
+        glDeleteProgram(program);
+        mResidency->binary = {};
+        return;
+    }
+    // The binary includes all the program state we initialized after linking, so nothing
+    // else to do. We don't keep the binary around; it's snapshotted again at next unload.
+    gl.program = program;
+    mResidency->binary = {};
+#endif
+}
+
 void OpenGLProgram::initialize(OpenGLDriver& gld) {
 
     SYSTRACE_CALL();
@@ -42,11 +42,16 @@ public:
     OpenGLProgram(OpenGLDriver& gld, Program&& program) noexcept;
     ~OpenGLProgram() noexcept;
 
-    bool isValid() const noexcept { return mToken || gl.program != 0; }
+    bool isValid() const noexcept { return mToken || gl.program != 0 || canRestore(); }
 
     void use(OpenGLDriver* const gld, OpenGLContext& context) noexcept {
         if (UTILS_UNLIKELY(!gl.program)) {
-            initialize(*gld);
+            if (mToken) {
+                initialize(*gld);
+            } else {
+                // the program was unloaded to reduce driver memory, bring it back
+                restore();
+            }
         }
 
         context.useProgram(gl.program);
@@ -75,7 +80,40 @@ public:
     void updateUniforms(uint32_t index, GLuint id, void const* buffer, uint16_t age) noexcept;
     void setRec709ColorSpace(bool rec709) const noexcept;
 
+    // Program residency management (see DriverConfig::residentProgramLimit). The driver
+    // touch()es each program it uses and can unload() those that haven't been used for a
+    // while; use() then re-creates the GL program object from its binary snapshot.
+    void touch(uint32_t frame) noexcept {
+        if (UTILS_LIKELY(mResidency)) {
+            mResidency->lastUsedFrame = frame;
+        }
+    }
+
+    bool isResident() const noexcept { return gl.program != 0; }
+
+    uint32_t getLastUsedFrame() const noexcept {
+        return mResidency ? mResidency->lastUsedFrame : 0;
+    }
+
+    // Destroys the GL program object after snapshotting its binary, which is used to
+    // transparently re-create it on next use. Returns true if the program was unloaded.
+    bool unload(OpenGLContext& context) noexcept;
+
 private:
+    // Only allocated when program residency management is enabled. While the program is
+    // unloaded, holds the binary it'll be re-created from.
+    struct ResidencyState {
+        uint32_t lastUsedFrame = 0;
+        GLenum binaryFormat = 0;
+        utils::FixedCapacityVector<char> binary;
+    };
+
+    bool canRestore() const noexcept {
+        return mResidency && !mResidency->binary.empty();
+    }
+
+    void restore() noexcept;
+
     // keep these away from of other class attributes
     struct LazyInitializationData;
 
@@ -103,6 +141,8 @@ private:
     };
     UniformsRecord const* mUniformsRecords = nullptr;
     GLint mRec709Location = -1;
+
+    ResidencyState* mResidency = nullptr;
 };
 
 // if OpenGLProgram is larger tha 64 bytes, it'll fall in a larger Handle bucket.
@@ -27,6 +27,9 @@
 #include <utils/compiler.h>
 #include <utils/Log.h>
 
+#include <algorithm>
+
+#include <dlfcn.h>
 #include <sys/system_properties.h>
 
 // We require filament to be built with an API 19 toolchain, before that, OpenGLES 3.0 didn't exist
@@ -60,6 +63,12 @@ UTILS_PRIVATE PFNEGLGETFRAMETIMESTAMPSANDROIDPROC eglGetFrameTimestampsANDROID =
 }
 using namespace glext;
 
+// AHardwareBuffer_acquire/release are only available in libandroid from API 26, so we resolve
+// them at runtime; when they're missing we fall back to uncached EGLImages.
+typedef void (AHardwareBufferFn)(AHardwareBuffer*);
+UTILS_PRIVATE AHardwareBufferFn* AHardwareBuffer_acquire_fn = {};
+UTILS_PRIVATE AHardwareBufferFn* AHardwareBuffer_release_fn = {};
+
 using EGLStream = Platform::Stream;
 
 // ---------------------------------------------------------------------------------------------
@@ -95,6 +104,7 @@ PlatformEGLAndroid::~PlatformEGLAndroid() noexcept = default;
 
 
 void PlatformEGLAndroid::terminate() noexcept {
+    clearAcquiredImageCache();
     ExternalStreamManagerAndroid::destroy(&mExternalStreamManager);
     PlatformEGL::terminate();
 }
@@ -107,6 +117,9 @@ Driver* PlatformEGLAndroid::createDriver(void* sharedContext,
     eglGetNativeClientBufferANDROID = (PFNEGLGETNATIVECLIENTBUFFERANDROIDPROC) eglGetProcAddress(
             "eglGetNativeClientBufferANDROID");
 
+    AHardwareBuffer_acquire_fn = (AHardwareBufferFn*) dlsym(RTLD_DEFAULT, "AHardwareBuffer_acquire");
+    AHardwareBuffer_release_fn = (AHardwareBufferFn*) dlsym(RTLD_DEFAULT, "AHardwareBuffer_release");
+
     if (extensions.has("EGL_ANDROID_presentation_time")) {
         eglPresentationTimeANDROID = (PFNEGLPRESENTATIONTIMEANDROIDPROC)eglGetProcAddress(
                 "eglPresentationTimeANDROID");
@@ -164,12 +177,38 @@ int PlatformEGLAndroid::getOSVersion() const noexcept {
 }
 
 AcquiredImage PlatformEGLAndroid::transformAcquiredImage(AcquiredImage source) noexcept {
+    AHardwareBuffer* const buffer = (AHardwareBuffer*)source.image;
+
     // Convert the AHardwareBuffer to EGLImage.
-    EGLClientBuffer clientBuffer = eglGetNativeClientBufferANDROID((const AHardwareBuffer*)source.image);
+    EGLClientBuffer clientBuffer = eglGetNativeClientBufferANDROID(buffer);
     if (!clientBuffer) {
         slog.e << "Unable to get EGLClientBuffer from AHardwareBuffer." << io::endl;
         return {};
     }
+
+    if (UTILS_LIKELY(AHardwareBuffer_acquire_fn && AHardwareBuffer_release_fn)) {
+        EGLImageKHR eglImage = getCachedEGLImage(buffer, clientBuffer);
+        if (eglImage == EGL_NO_IMAGE_KHR) {
+            return {};
+        }
+
+        // The cache owns the EGLImage; we only need to restore the caller's image pointer
+        // before invoking the user's callback.
+        struct Closure {
+            explicit Closure(AcquiredImage const& acquiredImage)
+                    : acquiredImage(acquiredImage) {}
+            AcquiredImage acquiredImage;
+        };
+        Closure* closure = new(std::nothrow) Closure(source);
+        auto patchedCallback = [](void*, void* userdata) {
+            Closure* closure = (Closure*)userdata;
+            closure->acquiredImage.callback(closure->acquiredImage.image, closure->acquiredImage.userData);
+            delete closure;
+        };
+
+        return { eglImage, patchedCallback, closure, source.handler };
+    }
+
     // Note that this cannot be used to stream protected video (for now) because we do not set EGL_PROTECTED_CONTENT_EXT.
     EGLint attrs[] = { EGL_NONE, EGL_NONE };
     EGLImageKHR eglImage = eglCreateImageKHR(mEGLDisplay, EGL_NO_CONTEXT, EGL_NATIVE_BUFFER_ANDROID, clientBuffer, attrs);
@@ -198,6 +237,55 @@ AcquiredImage PlatformEGLAndroid::transformAcquiredImage(AcquiredImage source) n
     return { eglImage, patchedCallback, closure, source.handler };
 }
 
+EGLImageKHR PlatformEGLAndroid::getCachedEGLImage(AHardwareBuffer* buffer,
+        EGLClientBuffer clientBuffer) noexcept {
+    auto& cache = mAcquiredImageCache;
+    auto pos = std::find_if(cache.begin(), cache.end(),
+            [buffer](AcquiredImageCacheEntry const& entry) { return entry.buffer == buffer; });
+    if (pos != cache.end()) {
+        pos->lastUsed = ++mAcquiredImageCacheAge;
+        return pos->image;
+    }
+
+    // Note that this cannot be used to stream protected video (for now) because we do not set EGL_PROTECTED_CONTENT_EXT.
+    EGLint attrs[] = { EGL_NONE, EGL_NONE };
+    EGLImageKHR eglImage = eglCreateImageKHR(mEGLDisplay, EGL_NO_CONTEXT, EGL_NATIVE_BUFFER_ANDROID, clientBuffer, attrs);
+    if (eglImage == EGL_NO_IMAGE_KHR) {
+        slog.e << "eglCreateImageKHR returned no image." << io::endl;
+        return EGL_NO_IMAGE_KHR;
+    }
+
+    while (cache.size() >= ACQUIRED_IMAGE_CACHE_MAX_SIZE) {
+        auto lru = std::min_element(cache.begin(), cache.end(),
+                [](AcquiredImageCacheEntry const& lhs, AcquiredImageCacheEntry const& rhs) {
+                    return lhs.lastUsed < rhs.lastUsed;
+                });
+        // Destroying the EGLImage here is safe even if a frame is in flight, because the GL
+        // textures created from it keep the underlying buffer alive.
+        if (eglDestroyImageKHR(mEGLDisplay, lru->image) == EGL_FALSE) {
+            slog.e << "eglDestroyImageKHR failed." << io::endl;
+        }
+        AHardwareBuffer_release_fn(lru->buffer);
+        cache.erase(lru);
+    }
+
+    // Hold a reference on the AHardwareBuffer, so its address can't be recycled for a
+    // different buffer while this entry exists.
+    AHardwareBuffer_acquire_fn(buffer);
+    cache.push_back({ buffer, eglImage, ++mAcquiredImageCacheAge });
+    return eglImage;
+}
+
+void PlatformEGLAndroid::clearAcquiredImageCache() noexcept {
+    for (AcquiredImageCacheEntry const& entry : mAcquiredImageCache) {
+        if (eglDestroyImageKHR(mEGLDisplay, entry.image) == EGL_FALSE) {
+            slog.e << "eglDestroyImageKHR failed." << io::endl;
+        }
+        AHardwareBuffer_release_fn(entry.buffer);
+    }
+    mAcquiredImageCache.clear();
+}
+
 } // namespace filament::backend
 
 // ---------------------------------------------------------------------------------------------
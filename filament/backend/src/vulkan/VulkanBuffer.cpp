@@ -15,6 +15,7 @@
  */
 
 #include "VulkanBuffer.h"
+#include "VulkanBufferPool.h"
 #include "VulkanMemory.h"
 
 #include <utils/Panic.h>
@@ -24,42 +25,93 @@ using namespace bluevk;
 namespace filament::backend {
 
 VulkanBuffer::VulkanBuffer(VmaAllocator allocator, VulkanStagePool& stagePool,
-        VkBufferUsageFlags usage, uint32_t numBytes)
+        VkBufferUsageFlags usage, uint32_t numBytes, VulkanBufferPool* bufferPool, bool dynamic)
     : mAllocator(allocator),
       mStagePool(stagePool),
+      mNumBytes(numBytes),
       mUsage(usage) {
 
     // for now make sure that only 1 bit is set in usage
     // (because loadFromCpu() assumes that somewhat)
     assert_invariant(usage && !(usage & (usage - 1)));
 
-    // Create the VkBuffer.
+    // Small vertex/index buffers are sub-allocated out of a shared slab.
+    if (bufferPool && bufferPool->allocate(usage, numBytes, &mGpuBuffer, &mGpuOffset)) {
+        mBufferPool = bufferPool;
+        return;
+    }
+
+    // Create the VkBuffer. TRANSFER_SRC is included so that the contents can be copied out
+    // when the allocation is moved by a defragmentation pass (see relocate()).
     VkBufferCreateInfo bufferInfo {
         .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
         .size = numBytes,
-        .usage = usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT
+        .usage = usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT
     };
 
     VmaAllocationCreateInfo allocInfo { .usage = VMA_MEMORY_USAGE_GPU_ONLY };
-    vmaCreateBuffer(mAllocator, &bufferInfo, &allocInfo, &mGpuBuffer, &mGpuMemory, nullptr);
+    if (dynamic) {
+        // Frequently-updated buffers are placed in host-visible device-local memory when the
+        // device exposes such a heap (resizable BAR), so that updates can skip the staging
+        // copy. ALLOW_TRANSFER_INSTEAD lets VMA fall back to plain device-local memory
+        // otherwise, in which case the mapping below stays null and updates go through
+        // loadFromCpu() as usual.
+        allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+                VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT |
+                VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+    }
+    VmaAllocationInfo allocationInfo{};
+    vmaCreateBuffer(mAllocator, &bufferInfo, &allocInfo, &mGpuBuffer, &mGpuMemory,
+            &allocationInfo);
+
+    // Lets VulkanDefragmenter find us when this allocation is selected for a move.
+    if (mGpuMemory) {
+        vmaSetAllocationUserData(mAllocator, mGpuMemory, this);
+        if (dynamic) {
+            VkMemoryPropertyFlags memFlags = 0;
+            vmaGetAllocationMemoryProperties(mAllocator, mGpuMemory, &memFlags);
+            if (memFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) {
+                mMapping = allocationInfo.pMappedData;
+            }
+        }
+    }
 }
 
 VulkanBuffer::~VulkanBuffer() {
-    vmaDestroyBuffer(mAllocator, mGpuBuffer, mGpuMemory);
+    if (mBufferPool) {
+        mBufferPool->free(mGpuBuffer, mGpuOffset, mNumBytes);
+    } else {
+        vmaDestroyBuffer(mAllocator, mGpuBuffer, mGpuMemory);
+    }
 }
 
 void VulkanBuffer::loadFromCpu(VkCommandBuffer cmdbuf, const void* cpuData, uint32_t byteOffset,
         uint32_t numBytes) const {
     assert_invariant(byteOffset == 0);
-    VulkanStage const* stage = mStagePool.acquireStage(numBytes);
-    void* mapped;
-    vmaMapMemory(mAllocator, stage->memory, &mapped);
-    memcpy(mapped, cpuData, numBytes);
-    vmaUnmapMemory(mAllocator, stage->memory);
-    vmaFlushAllocation(mAllocator, stage->memory, byteOffset, numBytes);
 
-    VkBufferCopy region{ .size = numBytes };
-    vkCmdCopyBuffer(cmdbuf, stage->buffer, mGpuBuffer, 1, &region);
+    // Common case: stream the data through the persistently-mapped staging ring, which avoids
+    // a vmaCreateBuffer and a map/unmap round trip per upload. Uploads that are too large for
+    // the ring (or arrive while it is full) fall back to a discrete stage.
+    VulkanStageSegment segment;
+    if (UTILS_LIKELY(mStagePool.acquireSegment(numBytes, &segment))) {
+        memcpy(segment.mapping, cpuData, numBytes);
+        mStagePool.flushSegment(segment, numBytes);
+
+        VkBufferCopy region{
+            .srcOffset = segment.offset, .dstOffset = mGpuOffset, .size = numBytes };
+        vkCmdCopyBuffer(cmdbuf, segment.buffer, mGpuBuffer, 1, &region);
+    } else {
+        VulkanStage const* stage = mStagePool.acquireStage(numBytes);
+        void* mapped;
+        vmaMapMemory(mAllocator, stage->memory, &mapped);
+        memcpy(mapped, cpuData, numBytes);
+        vmaUnmapMemory(mAllocator, stage->memory);
+        vmaFlushAllocation(mAllocator, stage->memory, byteOffset, numBytes);
+
+        VkBufferCopy region{ .dstOffset = mGpuOffset, .size = numBytes };
+        vkCmdCopyBuffer(cmdbuf, stage->buffer, mGpuBuffer, 1, &region);
+    }
 
     // Firstly, ensure that the copy finishes before the next draw call.
     // Secondly, in case the user decides to upload another chunk (without ever using the first one)
@@ -90,11 +142,121 @@ void VulkanBuffer::loadFromCpu(VkCommandBuffer cmdbuf, const void* cpuData, uint
 	    .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
 	    .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
 	    .buffer = mGpuBuffer,
-	    .size = VK_WHOLE_SIZE,
+	    .offset = mGpuOffset,
+	    .size = mBufferPool ? VkDeviceSize(numBytes) : VK_WHOLE_SIZE,
     };
 
     vkCmdPipelineBarrier(cmdbuf, VK_PIPELINE_STAGE_TRANSFER_BIT, dstStageMask, 0, 0, nullptr, 1,
 	    &barrier, 0, nullptr);
 }
 
+void VulkanBuffer::copyFrom(VkCommandBuffer cmdbuf, VulkanBuffer const& src, uint32_t srcOffset,
+        uint32_t dstOffset, uint32_t numBytes) const {
+    assert_invariant(srcOffset + numBytes <= src.mNumBytes);
+    assert_invariant(dstOffset + numBytes <= mNumBytes);
+
+    // Server-side copies are used for compaction/defragmentation of pooled buffers, so they are
+    // comparatively rare; like relocate(), the barriers are deliberately conservative. Make all
+    // prior writes to the source visible to the transfer...
+    VkBufferMemoryBarrier srcBarrier{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .buffer = src.mGpuBuffer,
+            .offset = src.mGpuOffset + srcOffset,
+            .size = numBytes,
+    };
+    vkCmdPipelineBarrier(cmdbuf, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 1, &srcBarrier, 0, nullptr);
+
+    VkBufferCopy const region{
+            .srcOffset = src.mGpuOffset + srcOffset,
+            .dstOffset = mGpuOffset + dstOffset,
+            .size = numBytes,
+    };
+    vkCmdCopyBuffer(cmdbuf, src.mGpuBuffer, mGpuBuffer, 1, &region);
+
+    // ... and the copy visible to any subsequent use of the destination.
+    VkBufferMemoryBarrier dstBarrier{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .buffer = mGpuBuffer,
+            .offset = mGpuOffset + dstOffset,
+            .size = numBytes,
+    };
+    vkCmdPipelineBarrier(cmdbuf, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 1, &dstBarrier, 0, nullptr);
+}
+
+bool VulkanBuffer::tryDirectWrite(const void* cpuData, uint32_t byteOffset,
+        uint32_t numBytes) const {
+    if (!mMapping) {
+        return false;
+    }
+    memcpy(static_cast<char*>(mMapping) + byteOffset, cpuData, numBytes);
+    // no-op when the memory type is coherent, which the BAR heap usually is
+    vmaFlushAllocation(mAllocator, mGpuMemory, byteOffset, numBytes);
+    return true;
+}
+
+VkBuffer VulkanBuffer::relocate(VkCommandBuffer cmdbuf, VmaAllocation dstMemory) noexcept {
+    // slab sub-allocations don't own their memory and are never moved
+    assert_invariant(!mBufferPool);
+
+    // Persistently-mapped buffers stay put: the mapping wouldn't survive the move.
+    if (mMapping) {
+        return VK_NULL_HANDLE;
+    }
+
+    VkBufferCreateInfo bufferInfo {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size = mNumBytes,
+        .usage = mUsage | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT
+    };
+    VkBuffer newBuffer = VK_NULL_HANDLE;
+    if (vmaCreateAliasingBuffer(mAllocator, dstMemory, &bufferInfo, &newBuffer) != VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+
+    // Relocation is rare, so the barriers are deliberately conservative: make all prior
+    // writes to the buffer visible to the copy...
+    VkBufferMemoryBarrier srcBarrier{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .buffer = mGpuBuffer,
+            .size = VK_WHOLE_SIZE,
+    };
+    vkCmdPipelineBarrier(cmdbuf, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 1, &srcBarrier, 0, nullptr);
+
+    VkBufferCopy const region{ .size = mNumBytes };
+    vkCmdCopyBuffer(cmdbuf, mGpuBuffer, newBuffer, 1, &region);
+
+    // ... and the copy visible to any subsequent use of the new buffer.
+    VkBufferMemoryBarrier dstBarrier{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .buffer = newBuffer,
+            .size = VK_WHOLE_SIZE,
+    };
+    vkCmdPipelineBarrier(cmdbuf, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 1, &dstBarrier, 0, nullptr);
+
+    VkBuffer const oldBuffer = mGpuBuffer;
+    mGpuBuffer = newBuffer;
+    // note: mGpuMemory stays valid, vmaEndDefragmentationPass() re-points it to dstMemory
+    return oldBuffer;
+}
+
 } // namespace filament::backend
@@ -22,24 +22,58 @@
 
 namespace filament::backend {
 
-// Encapsulates a Vulkan buffer, its attached DeviceMemory and a staging area.
+class VulkanBufferPool;
+
+// Encapsulates a Vulkan buffer, its attached DeviceMemory and a staging area. Small vertex
+// and index buffers are transparently sub-allocated out of a slab from the given
+// VulkanBufferPool, in which case getGpuOffset() returns the sub-allocation's base offset
+// within the shared VkBuffer. Buffers created with dynamic=true are placed in host-visible
+// device-local memory (the resizable BAR heap) when the device exposes one, which allows
+// updates to skip the staging copy entirely (see tryDirectWrite()).
 class VulkanBuffer {
 public:
     VulkanBuffer(VmaAllocator allocator, VulkanStagePool& stagePool, VkBufferUsageFlags usage,
-            uint32_t numBytes);
+            uint32_t numBytes, VulkanBufferPool* bufferPool = nullptr, bool dynamic = false);
     ~VulkanBuffer();
     void loadFromCpu(VkCommandBuffer cmdbuf, const void* cpuData, uint32_t byteOffset,
             uint32_t numBytes) const;
+
+    // Records a GPU copy of a region of src into this buffer, without any CPU round trip.
+    // Both offsets are relative to the respective buffer's start (slab sub-allocation offsets
+    // are applied internally).
+    void copyFrom(VkCommandBuffer cmdbuf, VulkanBuffer const& src, uint32_t srcOffset,
+            uint32_t dstOffset, uint32_t numBytes) const;
+
+    // Writes cpuData straight into the buffer's persistently-mapped memory, skipping the
+    // staging copy. Returns false when the buffer didn't land in host-visible device-local
+    // memory, in which case the caller must fall back to loadFromCpu(). Unlike a staged
+    // copy, the write is not ordered against GPU reads of the buffer, so this is only
+    // suitable for unsynchronized updates, where the caller owns that responsibility.
+    bool tryDirectWrite(const void* cpuData, uint32_t byteOffset, uint32_t numBytes) const;
+
+    // Moves the buffer's contents to dstMemory as part of a defragmentation pass (see
+    // VulkanDefragmenter): re-creates the VkBuffer on top of the destination allocation and
+    // records a GPU copy of the current contents into it. Returns the old VkBuffer, which
+    // the caller must destroy once the copy has executed, or VK_NULL_HANDLE on failure.
+    VkBuffer relocate(VkCommandBuffer cmdbuf, VmaAllocation dstMemory) noexcept;
+
     VkBuffer getGpuBuffer() const {
         return mGpuBuffer;
     }
+    uint32_t getGpuOffset() const {
+        return mGpuOffset;
+    }
 
 private:
     VmaAllocator mAllocator;
     VulkanStagePool& mStagePool;
+    VulkanBufferPool* mBufferPool = nullptr; // non-null when sub-allocated from a slab
 
     VmaAllocation mGpuMemory = VK_NULL_HANDLE;
+    void* mMapping = nullptr; // non-null when the buffer lives in the BAR heap
     VkBuffer mGpuBuffer = VK_NULL_HANDLE;
+    uint32_t mGpuOffset = 0;
+    uint32_t mNumBytes = 0;
     VkBufferUsageFlags mUsage = {};
 };
 
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "VulkanBufferPool.h"
+#include "VulkanMemory.h"
+
+#include <utils/debug.h>
+
+#include <algorithm>
+
+using namespace bluevk;
+
+namespace filament::backend {
+
+void VulkanBufferPool::initialize(VmaAllocator allocator) noexcept {
+    mAllocator = allocator;
+}
+
+bool VulkanBufferPool::isPoolable(VkBufferUsageFlags usage, uint32_t numBytes) noexcept {
+    // Only vertex and index buffers are pooled. Uniform buffers are excluded because the
+    // pipeline cache identifies their bindings by VkBuffer handle, which sub-allocations
+    // sharing a slab would alias.
+    return (usage == VK_BUFFER_USAGE_VERTEX_BUFFER_BIT
+                   || usage == VK_BUFFER_USAGE_INDEX_BUFFER_BIT)
+            && numBytes <= MAX_SUB_ALLOCATION_SIZE;
+}
+
+bool VulkanBufferPool::allocate(VkBufferUsageFlags usage, uint32_t numBytes,
+        VkBuffer* outBuffer, uint32_t* outOffset) {
+    if (!isPoolable(usage, numBytes)) {
+        return false;
+    }
+
+    uint32_t const size = (numBytes + (SLAB_ALIGNMENT - 1u)) & ~(SLAB_ALIGNMENT - 1u);
+
+    auto allocateFrom = [size, outBuffer, outOffset](Slab& slab) {
+        auto& ranges = slab.freeRanges;
+        // first-fit; the list is small and sorted by offset, so this favors packing
+        // allocations towards the front of the slab
+        for (auto it = ranges.begin(); it != ranges.end(); ++it) {
+            if (it->size >= size) {
+                *outBuffer = slab.buffer;
+                *outOffset = it->offset;
+                it->offset += size;
+                it->size -= size;
+                if (it->size == 0) {
+                    ranges.erase(it);
+                }
+                return true;
+            }
+        }
+        return false;
+    };
+
+    for (Slab& slab : mSlabs) {
+        if (slab.usage == usage && allocateFrom(slab)) {
+            return true;
+        }
+    }
+
+    Slab* const slab = createSlab(usage);
+    if (UTILS_UNLIKELY(!slab)) {
+        return false;
+    }
+    return allocateFrom(*slab);
+}
+
+void VulkanBufferPool::free(VkBuffer buffer, uint32_t offset, uint32_t numBytes) noexcept {
+    uint32_t const size = (numBytes + (SLAB_ALIGNMENT - 1u)) & ~(SLAB_ALIGNMENT - 1u);
+
+    auto const slab = std::find_if(mSlabs.begin(), mSlabs.end(),
+            [buffer](Slab const& slab) { return slab.buffer == buffer; });
+    assert_invariant(slab != mSlabs.end());
+    if (UTILS_UNLIKELY(slab == mSlabs.end())) {
+        return;
+    }
+
+    auto& ranges = slab->freeRanges;
+    auto const pos = std::lower_bound(ranges.begin(), ranges.end(), offset,
+            [](FreeRange const& lhs, uint32_t offset) { return lhs.offset < offset; });
+    auto const it = ranges.insert(pos, { offset, size });
+
+    // coalesce with the next free range
+    auto const next = it + 1;
+    if (next != ranges.end() && it->offset + it->size == next->offset) {
+        it->size += next->size;
+        ranges.erase(next);
+    }
+    // coalesce with the previous free range
+    if (it != ranges.begin()) {
+        auto const prev = it - 1;
+        if (prev->offset + prev->size == it->offset) {
+            prev->size += it->size;
+            ranges.erase(it);
+        }
+    }
+
+    // Release the slab if it became entirely free, but keep one empty slab per usage around
+    // so that creation/destruction churn doesn't thrash slab allocations.
+    if (ranges.size() == 1 && ranges[0].size == SLAB_SIZE) {
+        auto const isEmpty = [usage = slab->usage](Slab const& slab) {
+            return slab.usage == usage
+                    && slab.freeRanges.size() == 1 && slab.freeRanges[0].size == SLAB_SIZE;
+        };
+        if (std::count_if(mSlabs.begin(), mSlabs.end(), isEmpty) > 1) {
+            vmaDestroyBuffer(mAllocator, slab->buffer, slab->memory);
+            mSlabs.erase(slab);
+        }
+    }
+}
+
+VulkanBufferPool::Slab* VulkanBufferPool::createSlab(VkBufferUsageFlags usage) {
+    VkBufferCreateInfo bufferInfo{
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size = SLAB_SIZE,
+        .usage = usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+    };
+    VmaAllocationCreateInfo allocInfo{ .usage = VMA_MEMORY_USAGE_GPU_ONLY };
+    VkBuffer buffer;
+    VmaAllocation memory;
+    if (UTILS_UNLIKELY(vmaCreateBuffer(mAllocator, &bufferInfo, &allocInfo,
+            &buffer, &memory, nullptr) != VK_SUCCESS)) {
+        return nullptr;
+    }
+    mSlabs.push_back({ buffer, memory, usage, {{ 0, SLAB_SIZE }} });
+    return &mSlabs.back();
+}
+
+void VulkanBufferPool::terminate() noexcept {
+    for (Slab const& slab : mSlabs) {
+        vmaDestroyBuffer(mAllocator, slab.buffer, slab.memory);
+    }
+    mSlabs.clear();
+}
+
+} // namespace filament::backend
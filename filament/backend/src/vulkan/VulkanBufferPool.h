@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_BACKEND_VULKANBUFFERPOOL_H
+#define TNT_FILAMENT_BACKEND_VULKANBUFFERPOOL_H
+
+#include "VulkanContext.h"
+
+#include <vector>
+
+namespace filament::backend {
+
+// Sub-allocates small vertex and index buffers out of larger shared slab VkBuffers, so that
+// scenes with many tiny meshes (e.g. UI elements or decals) don't pay for one VkBuffer and
+// one device allocation per buffer object. Allocations are served first-fit from a per-slab
+// free list; freed ranges are coalesced with their neighbors and slabs that become entirely
+// free are released.
+class VulkanBufferPool {
+public:
+    // buffers at most this size are sub-allocated out of slabs
+    static constexpr uint32_t MAX_SUB_ALLOCATION_SIZE = 64u * 1024u;
+
+    void initialize(VmaAllocator allocator) noexcept;
+
+    // Returns true if buffers with this usage and size are served by the pool.
+    static bool isPoolable(VkBufferUsageFlags usage, uint32_t numBytes) noexcept;
+
+    // Sub-allocates out of a slab with the given usage. Returns false if the request is not
+    // poolable or a new slab couldn't be created, in which case the caller should create a
+    // dedicated buffer.
+    bool allocate(VkBufferUsageFlags usage, uint32_t numBytes,
+            VkBuffer* outBuffer, uint32_t* outOffset);
+
+    // Returns a sub-allocation to its slab's free list, merging it with adjacent free
+    // ranges. numBytes must be the size passed to allocate().
+    void free(VkBuffer buffer, uint32_t offset, uint32_t numBytes) noexcept;
+
+    // Destroys all slabs. This should be called while the context's VkDevice is still alive.
+    void terminate() noexcept;
+
+private:
+    static constexpr uint32_t SLAB_SIZE = 1024u * 1024u;
+
+    // alignment of sub-allocations; covers vkCmdBindIndexBuffer's index-type alignment
+    static constexpr uint32_t SLAB_ALIGNMENT = 16u;
+
+    struct FreeRange {
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    struct Slab {
+        VkBuffer buffer;
+        VmaAllocation memory;
+        VkBufferUsageFlags usage;
+        std::vector<FreeRange> freeRanges; // sorted by offset, adjacent ranges merged
+    };
+
+    Slab* createSlab(VkBufferUsageFlags usage);
+
+    VmaAllocator mAllocator = VK_NULL_HANDLE;
+    std::vector<Slab> mSlabs;
+};
+
+} // namespace filament::backend
+
+#endif // TNT_FILAMENT_BACKEND_VULKANBUFFERPOOL_H
@@ -134,6 +134,7 @@ VulkanCommands::VulkanCommands(VkDevice device, VkQueue queue, uint32_t queueFam
     : mDevice(device),
       mQueue(queue),
       mPool(createPool(mDevice, queueFamilyIndex)),
+      mQueueFamilyIndex(queueFamilyIndex),
       mContext(context),
       mStorage(CAPACITY) {
     VkSemaphoreCreateInfo sci{.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
@@ -146,6 +147,16 @@ VulkanCommands::VulkanCommands(VkDevice device, VkQueue queue, uint32_t queueFam
         vkCreateFence(device, &fenceCreateInfo, VKALLOC, &fence);
     }
 
+    if (mContext->isTimelineSemaphoreSupported()) {
+        VkSemaphoreTypeCreateInfoKHR timelineCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR,
+                .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR,
+                .initialValue = 0,
+        };
+        sci.pNext = &timelineCreateInfo;
+        vkCreateSemaphore(mDevice, &sci, VKALLOC, &mTimelineSemaphore);
+    }
+
     for (size_t i = 0; i < CAPACITY; ++i) {
         mStorage[i] = std::make_unique<VulkanCommandBuffer>(allocator, mDevice, mPool);
     }
@@ -158,6 +169,10 @@ VulkanCommands::VulkanCommands(VkDevice device, VkQueue queue, uint32_t queueFam
 VulkanCommands::~VulkanCommands() {
     wait();
     gc();
+    assert_invariant(mPendingSecondaries.empty());
+    for (VkCommandPool pool: mFreeSecondaryPools) {
+        vkDestroyCommandPool(mDevice, pool, VKALLOC);
+    }
     vkDestroyCommandPool(mDevice, mPool, VKALLOC);
     for (VkSemaphore sema: mSubmissionSignals) {
         vkDestroySemaphore(mDevice, sema, VKALLOC);
@@ -165,6 +180,9 @@ VulkanCommands::~VulkanCommands() {
     for (VkFence fence: mFences) {
         vkDestroyFence(mDevice, fence, VKALLOC);
     }
+    if (mTimelineSemaphore) {
+        vkDestroySemaphore(mDevice, mTimelineSemaphore, VKALLOC);
+    }
 }
 
 VulkanCommandBuffer& VulkanCommands::get() {
@@ -276,6 +294,41 @@ bool VulkanCommands::flush() {
         signals[waitSemaphoreCount++] = mInjectedSignal;
     }
     VkCommandBuffer const cmdbuffer = currentbuf->buffer();
+
+    if (mTimelineSemaphore) {
+        // Defer the actual vkQueueSubmit: record this buffer and batch it together with any
+        // subsequent flushes into a single submission (see submitPending()). From the
+        // client's point of view the buffer is now in flight; the submission is guaranteed
+        // to happen before anything that observes its completion.
+        auto& cmdfence = currentbuf->fence;
+        std::unique_lock<utils::Mutex> lock(cmdfence->mutex);
+        cmdfence->timelineValue = ++mTimelineValue;
+        cmdfence->status.store(VK_NOT_READY);
+        cmdfence->condition.notify_all();
+        lock.unlock();
+
+        mPending[mPendingCount++] = {
+                .buffer = cmdbuffer,
+                .waits = { signals[0], signals[1] },
+                .waitCount = waitSemaphoreCount,
+                .signal = renderingFinished,
+                .timelineValue = mTimelineValue,
+        };
+
+#if FVK_ENABLED(FVK_DEBUG_COMMAND_BUFFER)
+        slog.i << "Deferring cmdbuffer=" << cmdbuffer
+               << " wait=(" << signals[0] << ", " << signals[1] << ") "
+               << " signal=" << renderingFinished
+               << " timeline=" << mTimelineValue
+               << utils::io::endl;
+#endif
+
+        mSubmissionSignal = renderingFinished;
+        mInjectedSignal = VK_NULL_HANDLE;
+        mCurrentCommandBufferIndex = -1;
+        return true;
+    }
+
     VkSubmitInfo submitInfo{
             .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
             .waitSemaphoreCount = waitSemaphoreCount,
@@ -315,7 +368,73 @@ bool VulkanCommands::flush() {
     return true;
 }
 
+bool VulkanCommands::submitPending() {
+    if (mPendingCount == 0) {
+        return false;
+    }
+    assert_invariant(mTimelineSemaphore);
+
+    // See the note in flush(): we must assume the worst and stall at ALL_COMMANDS.
+    VkPipelineStageFlags const waitDestStageMasks[2] = {
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+    };
+
+    // Binary wait semaphore values are ignored, they just need to be present.
+    uint64_t const ignoredWaitValues[2] = { 0, 0 };
+
+    VkSubmitInfo submitInfos[CAPACITY];
+    VkTimelineSemaphoreSubmitInfoKHR timelineInfos[CAPACITY];
+    VkSemaphore signalSemaphores[CAPACITY][2];
+    uint64_t signalValues[CAPACITY][2];
+
+    for (uint32_t i = 0; i < mPendingCount; i++) {
+        PendingSubmission const& pending = mPending[i];
+        signalSemaphores[i][0] = pending.signal;
+        signalSemaphores[i][1] = mTimelineSemaphore;
+        signalValues[i][0] = 0; // ignored, binary semaphore
+        signalValues[i][1] = pending.timelineValue;
+        timelineInfos[i] = {
+                .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR,
+                .waitSemaphoreValueCount = pending.waitCount,
+                .pWaitSemaphoreValues = ignoredWaitValues,
+                .signalSemaphoreValueCount = 2,
+                .pSignalSemaphoreValues = signalValues[i],
+        };
+        submitInfos[i] = {
+                .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+                .pNext = &timelineInfos[i],
+                .waitSemaphoreCount = pending.waitCount,
+                .pWaitSemaphores = pending.waitCount > 0 ? pending.waits : nullptr,
+                .pWaitDstStageMask = waitDestStageMasks,
+                .commandBufferCount = 1,
+                .pCommandBuffers = &mPending[i].buffer,
+                .signalSemaphoreCount = 2u,
+                .pSignalSemaphores = signalSemaphores[i],
+        };
+    }
+
+#if FVK_ENABLED(FVK_DEBUG_COMMAND_BUFFER)
+    slog.i << "Submitting " << mPendingCount << " deferred cmdbuffer(s)" << utils::io::endl;
+#endif
+
+    UTILS_UNUSED_IN_RELEASE VkResult result =
+            vkQueueSubmit(mQueue, mPendingCount, submitInfos, VK_NULL_HANDLE);
+#if FVK_ENABLED(FVK_DEBUG_COMMAND_BUFFER)
+    if (result != VK_SUCCESS) {
+        utils::slog.d << "Failed command buffer submission result: " << result << utils::io::endl;
+    }
+#endif
+    assert_invariant(result == VK_SUCCESS);
+
+    mPendingCount = 0;
+    return true;
+}
+
 VkSemaphore VulkanCommands::acquireFinishedSignal() {
+    // The presentation engine will wait on this semaphore, so the submission that signals it
+    // must have reached the queue.
+    submitPending();
     VkSemaphore semaphore = mSubmissionSignal;
     mSubmissionSignal = VK_NULL_HANDLE;
 #if FVK_ENABLED(FVK_DEBUG_COMMAND_BUFFER)
@@ -333,6 +452,34 @@ void VulkanCommands::injectDependency(VkSemaphore next) {
 }
 
 void VulkanCommands::wait() {
+    submitPending();
+
+    if (mTimelineSemaphore) {
+        // Submissions execute in order, so waiting for the highest value waits for all of
+        // them.
+        uint64_t waitValue = 0;
+        for (size_t i = 0; i < CAPACITY; i++) {
+            auto wrapper = mStorage[i].get();
+            if (wrapper->buffer() != VK_NULL_HANDLE
+                    && mCurrentCommandBufferIndex != static_cast<int8_t>(i)) {
+                if (wrapper->fence->timelineValue > waitValue) {
+                    waitValue = wrapper->fence->timelineValue;
+                }
+            }
+        }
+        if (waitValue > 0) {
+            VkSemaphoreWaitInfoKHR const waitInfo{
+                    .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR,
+                    .semaphoreCount = 1,
+                    .pSemaphores = &mTimelineSemaphore,
+                    .pValues = &waitValue,
+            };
+            vkWaitSemaphoresKHR(mDevice, &waitInfo, UINT64_MAX);
+            updateFences();
+        }
+        return;
+    }
+
     VkFence fences[CAPACITY];
     size_t count = 0;
     for (size_t i = 0; i < CAPACITY; i++) {
@@ -352,31 +499,88 @@ void VulkanCommands::gc() {
     FVK_SYSTRACE_CONTEXT();
     FVK_SYSTRACE_START("commands::gc");
 
-    VkFence fences[CAPACITY];
-    size_t count = 0;
-
-    for (size_t i = 0; i < CAPACITY; i++) {
-        auto wrapper = mStorage[i].get();
-        if (wrapper->buffer() == VK_NULL_HANDLE) {
-            continue;
+    submitPending();
+
+    if (mTimelineSemaphore) {
+        // A single counter query covers all in-flight buffers, and there are no fences to
+        // reset.
+        uint64_t counter = 0;
+        vkGetSemaphoreCounterValueKHR(mDevice, mTimelineSemaphore, &counter);
+        for (size_t i = 0; i < CAPACITY; i++) {
+            auto wrapper = mStorage[i].get();
+            if (wrapper->buffer() == VK_NULL_HANDLE) {
+                continue;
+            }
+            uint64_t const value = wrapper->fence->timelineValue;
+            if (value == 0 || value > counter) {
+                // not yet flushed, or still executing
+                continue;
+            }
+            wrapper->fence->status.store(VK_SUCCESS);
+            wrapper->reset();
+            mAvailableBufferCount++;
+        }
+    } else {
+        VkFence fences[CAPACITY];
+        size_t count = 0;
+
+        for (size_t i = 0; i < CAPACITY; i++) {
+            auto wrapper = mStorage[i].get();
+            if (wrapper->buffer() == VK_NULL_HANDLE) {
+                continue;
+            }
+            VkResult const result = vkGetFenceStatus(mDevice, wrapper->fence->fence);
+            if (result != VK_SUCCESS) {
+                continue;
+            }
+            fences[count++] = wrapper->fence->fence;
+            wrapper->fence->status.store(VK_SUCCESS);
+            wrapper->reset();
+            mAvailableBufferCount++;
         }
-        VkResult const result = vkGetFenceStatus(mDevice, wrapper->fence->fence);
-        if (result != VK_SUCCESS) {
-            continue;
+
+        if (count > 0) {
+            vkResetFences(mDevice, count, fences);
         }
-        fences[count++] = wrapper->fence->fence;
-        wrapper->fence->status.store(VK_SUCCESS);
-        wrapper->reset();
-        mAvailableBufferCount++;
     }
 
-    if (count > 0) {
-        vkResetFences(mDevice, count, fences);
+    // Recycle the secondary command buffers whose primary has finished executing.
+    for (auto it = mPendingSecondaries.begin(); it != mPendingSecondaries.end();) {
+        if (it->fence->status.load(std::memory_order_relaxed) == VK_SUCCESS) {
+            // Resetting the pool releases the buffer's resources in bulk, which is cheaper
+            // than freeing the buffer itself (the pool is transient).
+            vkFreeCommandBuffers(mDevice, it->pool, 1, &it->buffer);
+            vkResetCommandPool(mDevice, it->pool, 0);
+            mFreeSecondaryPools.push_back(it->pool);
+            it = mPendingSecondaries.erase(it);
+        } else {
+            ++it;
+        }
     }
+
     FVK_SYSTRACE_END();
 }
 
 void VulkanCommands::updateFences() {
+    submitPending();
+
+    if (mTimelineSemaphore) {
+        uint64_t counter = 0;
+        vkGetSemaphoreCounterValueKHR(mDevice, mTimelineSemaphore, &counter);
+        for (size_t i = 0; i < CAPACITY; i++) {
+            auto wrapper = mStorage[i].get();
+            if (wrapper->buffer() != VK_NULL_HANDLE) {
+                VulkanCmdFence* fence = wrapper->fence.get();
+                if (fence && fence->timelineValue != 0) {
+                    fence->status.store(
+                            fence->timelineValue <= counter ? VK_SUCCESS : VK_NOT_READY,
+                            std::memory_order_relaxed);
+                }
+            }
+        }
+        return;
+    }
+
     for (size_t i = 0; i < CAPACITY; i++) {
         auto wrapper = mStorage[i].get();
         if (wrapper->buffer() != VK_NULL_HANDLE) {
@@ -390,6 +594,54 @@ void VulkanCommands::updateFences() {
     }
 }
 
+VkCommandBuffer VulkanCommands::getSecondary(VkRenderPass renderPass, uint32_t subpass) {
+    // Getting the current primary first ties the secondary's lifetime to its fence.
+    VulkanCommandBuffer& primary = get();
+
+    VkCommandPool pool;
+    if (!mFreeSecondaryPools.empty()) {
+        pool = mFreeSecondaryPools.back();
+        mFreeSecondaryPools.pop_back();
+    } else {
+        pool = createPool(mDevice, mQueueFamilyIndex);
+    }
+
+    VkCommandBuffer buffer;
+    const VkCommandBufferAllocateInfo allocateInfo{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+            .commandPool = pool,
+            .level = VK_COMMAND_BUFFER_LEVEL_SECONDARY,
+            .commandBufferCount = 1,
+    };
+    vkAllocateCommandBuffers(mDevice, &allocateInfo, &buffer);
+
+    // The framebuffer is left null, which is allowed (and slightly slower on some drivers),
+    // so that secondaries can be handed out before the framebuffer is known.
+    const VkCommandBufferInheritanceInfo inheritance{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+            .renderPass = renderPass,
+            .subpass = subpass,
+    };
+    const VkCommandBufferBeginInfo binfo{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+            .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+                     | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+            .pInheritanceInfo = &inheritance,
+    };
+    vkBeginCommandBuffer(buffer, &binfo);
+
+    mPendingSecondaries.push_back({ pool, buffer, primary.fence });
+    return buffer;
+}
+
+void VulkanCommands::executeSecondaries(VkCommandBuffer const* cmdbuffers, uint32_t count) {
+    assert_invariant(mCurrentCommandBufferIndex >= 0);
+    for (uint32_t i = 0; i < count; i++) {
+        vkEndCommandBuffer(cmdbuffers[i]);
+    }
+    vkCmdExecuteCommands(get().buffer(), count, cmdbuffers);
+}
+
 #if FVK_ENABLED(FVK_DEBUG_GROUP_MARKERS)
 
 void VulkanCommands::pushGroupMarker(char const* str, VulkanGroupMarkers::Timestamp timestamp) {
@@ -34,6 +34,7 @@
 #include <list>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace filament::backend {
 
@@ -64,6 +65,10 @@ struct VulkanCmdFence {
     VulkanCmdFence(VkFence ifence);
     ~VulkanCmdFence() = default;
     VkFence fence;
+    // When timeline semaphores are supported, completion is tracked by comparing this value
+    // against the counter of the manager's timeline semaphore instead of querying the VkFence
+    // (0 means "not yet flushed").
+    uint64_t timelineValue = 0;
     utils::Condition condition;
     utils::Mutex mutex;
     std::atomic<VkResult> status;
@@ -133,11 +138,26 @@ public:
 // - Allows 1 user to listen to the most recent flush event using a "finished" VkSemaphore.
 //    - This is used to trigger presentation of the swap chain image.
 //
+// - Batches submissions when VK_KHR_timeline_semaphore is available.
+//    - "flush" then only records the command buffer; all buffers flushed since the last
+//      submission go to the GPU in a single vkQueueSubmit (each vkQueueSubmit costs a
+//      significant amount of driver time, especially on mobile).
+//    - Completion is tracked fence-free by reading the timeline semaphore's counter.
+//    - The batch is submitted automatically before anything that needs the GPU to make
+//      progress: wait(), fence status queries, or handing out the presentation semaphore.
+//
 // - Allows off-thread queries of command buffer status.
 //    - Exposes an "updateFences" method that transfers current fence status into atomics.
 //    - Users can examine these atomic variables (see VulkanCmdFence) to determine status.
 //    - We do this because vkGetFenceStatus must be called from the rendering thread.
 //
+// - Allows render pass contents to be recorded from worker threads.
+//    - "getSecondary" hands out a secondary command buffer backed by its own transient pool,
+//      which is what makes concurrent vkCmd* recording legal (pools require external
+//      synchronization, buffers from distinct pools don't).
+//    - "executeSecondaries" stitches the secondaries back into the current primary with
+//      vkCmdExecuteCommands; pools are recycled once the primary's fence signals.
+//
 class VulkanCommands {
     public:
         VulkanCommands(VkDevice device, VkQueue queue, uint32_t queueFamilyIndex,
@@ -149,8 +169,17 @@ class VulkanCommands {
 
         // Submits the current command buffer if it exists, then sets "current" to null.
         // If there are no outstanding commands then nothing happens and this returns false.
+        // When timeline semaphores are supported, the buffer is only recorded for submission;
+        // the actual vkQueueSubmit is deferred to submitPending().
         bool flush();
 
+        // Submits all command buffers flushed since the last submission in a single
+        // vkQueueSubmit. This is called automatically before anything that requires the GPU
+        // to make progress; it only needs to be called explicitly before submitting work to
+        // the queue from outside this class (e.g. readPixels). Returns false if there was
+        // nothing to submit.
+        bool submitPending();
+
         // Returns the "rendering finished" semaphore for the most recent flush and removes
         // it from the existing dependency chain. This is especially useful for setting up
         // vkQueuePresentKHR.
@@ -169,6 +198,19 @@ class VulkanCommands {
         // Updates the atomic "status" variable in every extant fence.
         void updateFences();
 
+        // Begins recording a secondary command buffer that inherits the given render pass and
+        // subpass from the current primary. Must be called from the driver thread, but the
+        // returned buffer may then be recorded into from a single worker thread until it is
+        // handed back to executeSecondaries(). Its lifetime is tied to the current primary's
+        // fence. The render pass must have been begun with
+        // VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS.
+        VkCommandBuffer getSecondary(VkRenderPass renderPass, uint32_t subpass);
+
+        // Ends the given secondary command buffers and executes them, in order, within the
+        // current primary. Must be called from the driver thread, after all worker threads
+        // are done recording.
+        void executeSecondaries(VkCommandBuffer const* cmdbuffers, uint32_t count);
+
         // Sets an observer who is notified every time a new command buffer has been made "current".
         // The observer's event handler can only be called during get().
         void setObserver(CommandBufferObserver* observer) { mObserver = observer; }
@@ -184,10 +226,19 @@ class VulkanCommands {
 #endif
 
     private:
+        // A secondary command buffer and the transient pool backing it, retired in gc() once
+        // the primary it was executed in has finished on the GPU.
+        struct SecondaryCommandBuffer {
+            VkCommandPool pool;
+            VkCommandBuffer buffer;
+            std::shared_ptr<VulkanCmdFence> fence;
+        };
+
         static constexpr int CAPACITY = FVK_MAX_COMMAND_BUFFERS;
         VkDevice const mDevice;
         VkQueue const mQueue;
         VkCommandPool const mPool;
+        uint32_t const mQueueFamilyIndex;
         VulkanContext const* mContext;
 
         // int8 only goes up to 127, therefore capacity must be less than that.
@@ -195,11 +246,32 @@ class VulkanCommands {
         int8_t mCurrentCommandBufferIndex = -1;
         VkSemaphore mSubmissionSignal = {};
         VkSemaphore mInjectedSignal = {};
+
+        // A command buffer flushed but not yet handed to vkQueueSubmit (timeline semaphore
+        // path only, see submitPending()).
+        struct PendingSubmission {
+            VkCommandBuffer buffer;
+            VkSemaphore waits[2];
+            uint32_t waitCount;
+            VkSemaphore signal;         // binary, for the dependency chain and presentation
+            uint64_t timelineValue;     // value signaled on mTimelineSemaphore
+        };
+        PendingSubmission mPending[CAPACITY] = {};
+        uint32_t mPendingCount = 0;
+
+        // Monotonic counter semaphore signaled by every submission; VK_NULL_HANDLE when
+        // VK_KHR_timeline_semaphore is unavailable, in which case flush() submits immediately
+        // and completion is tracked with mFences.
+        VkSemaphore mTimelineSemaphore = VK_NULL_HANDLE;
+        uint64_t mTimelineValue = 0;
+
         utils::FixedCapacityVector<std::unique_ptr<VulkanCommandBuffer>> mStorage;
         VkFence mFences[CAPACITY] = {};
         VkSemaphore mSubmissionSignals[CAPACITY] = {};
         uint8_t mAvailableBufferCount = CAPACITY;
         CommandBufferObserver* mObserver = nullptr;
+        std::vector<SecondaryCommandBuffer> mPendingSecondaries;
+        std::vector<VkCommandPool> mFreeSecondaryPools;
 
 #if FVK_ENABLED(FVK_DEBUG_GROUP_MARKERS)
         std::unique_ptr<VulkanGroupMarkers> mGroupMarkers;
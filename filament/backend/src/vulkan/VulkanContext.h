@@ -124,6 +124,20 @@ public:
     inline bool isDebugUtilsSupported() const noexcept {
         return mDebugUtilsSupported;
     }
+    inline bool isExternalMemoryDmaBufSupported() const noexcept {
+        return mExternalMemoryDmaBufSupported;
+    }
+    inline bool isFragmentShadingRateSupported() const noexcept {
+        return mFragmentShadingRateSupported;
+    }
+
+    inline bool isPresentWaitSupported() const noexcept {
+        return mPresentWaitSupported;
+    }
+
+    inline bool isTimelineSemaphoreSupported() const noexcept {
+        return mTimelineSemaphoreSupported;
+    }
 
 private:
     VkPhysicalDeviceMemoryProperties mMemoryProperties = {};
@@ -131,6 +145,10 @@ private:
     VkPhysicalDeviceFeatures mPhysicalDeviceFeatures = {};
     bool mDebugMarkersSupported = false;
     bool mDebugUtilsSupported = false;
+    bool mExternalMemoryDmaBufSupported = false;
+    bool mFragmentShadingRateSupported = false;
+    bool mPresentWaitSupported = false;
+    bool mTimelineSemaphoreSupported = false;
 
     VkFormatList mDepthFormats;
 
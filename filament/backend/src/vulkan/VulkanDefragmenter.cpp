@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "VulkanDefragmenter.h"
+
+#include "VulkanBuffer.h"
+#include "VulkanCommands.h"
+#include "VulkanMemory.h"
+
+#include <utils/FixedCapacityVector.h>
+#include <utils/debug.h>
+
+using namespace bluevk;
+
+namespace filament::backend {
+
+void VulkanDefragmenter::initialize(VmaAllocator allocator, VkDevice device,
+        VulkanCommands* commands) noexcept {
+    mAllocator = allocator;
+    mDevice = device;
+    mCommands = commands;
+}
+
+void VulkanDefragmenter::tick() noexcept {
+    if (mUnsupported) {
+        return;
+    }
+    if (++mFrameCount % FRAME_INTERVAL != 0) {
+        return;
+    }
+    runPass();
+}
+
+void VulkanDefragmenter::runPass() noexcept {
+    VmaDefragmentationInfo const info{
+            .flags = VMA_DEFRAGMENTATION_FLAG_ALGORITHM_FAST_BIT,
+            .maxBytesPerPass = MAX_BYTES_PER_PASS,
+            .maxAllocationsPerPass = MAX_ALLOCATIONS_PER_PASS,
+    };
+    VmaDefragmentationContext context = VK_NULL_HANDLE;
+    if (vmaBeginDefragmentation(mAllocator, &info, &context) != VK_SUCCESS) {
+        mUnsupported = true;
+        return;
+    }
+
+    VmaDefragmentationPassMoveInfo pass{};
+    if (vmaBeginDefragmentationPass(mAllocator, context, &pass) == VK_SUCCESS) {
+        // nothing to move
+        vmaEndDefragmentation(mAllocator, context, nullptr);
+        return;
+    }
+
+    // Record one GPU copy per movable allocation. The moves VMA selected for allocations we
+    // can't relocate (slabs, staging buffers, image memory) are ignored; they stay put.
+    auto retired = utils::FixedCapacityVector<VkBuffer>::with_capacity(pass.moveCount);
+    VkCommandBuffer cmdbuf = VK_NULL_HANDLE;
+    for (uint32_t i = 0; i < pass.moveCount; i++) {
+        VmaDefragmentationMove& move = pass.pMoves[i];
+        VmaAllocationInfo allocInfo{};
+        vmaGetAllocationInfo(mAllocator, move.srcAllocation, &allocInfo);
+        auto* const buffer = static_cast<VulkanBuffer*>(allocInfo.pUserData);
+        if (!buffer) {
+            move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+            continue;
+        }
+        if (cmdbuf == VK_NULL_HANDLE) {
+            cmdbuf = mCommands->get().buffer();
+        }
+        VkBuffer const oldBuffer = buffer->relocate(cmdbuf, move.dstTmpAllocation);
+        if (oldBuffer == VK_NULL_HANDLE) {
+            move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+            continue;
+        }
+        retired.push_back(oldBuffer);
+    }
+
+    if (!retired.empty()) {
+        // The copies must have executed before VMA frees the source memory below, and
+        // commands recorded earlier this frame may still reference the old buffers. This
+        // stall is the budgeted cost of a pass, bounded by MAX_BYTES_PER_PASS.
+        mCommands->flush();
+        mCommands->wait();
+        for (VkBuffer buffer: retired) {
+            // only the handle: the source memory is freed by vmaEndDefragmentationPass()
+            vkDestroyBuffer(mDevice, buffer, VKALLOC);
+        }
+    }
+
+    vmaEndDefragmentationPass(mAllocator, context, &pass);
+
+    // One bounded pass per interval: even if more moves are possible, stop here and
+    // re-analyze at the next interval.
+    vmaEndDefragmentation(mAllocator, context, nullptr);
+}
+
+} // namespace filament::backend
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_BACKEND_VULKANDEFRAGMENTER_H
+#define TNT_FILAMENT_BACKEND_VULKANDEFRAGMENTER_H
+
+#include "VulkanContext.h"
+
+namespace filament::backend {
+
+class VulkanCommands;
+
+// Incrementally defragments the VMA device heaps. Long sessions that stream content in and
+// out fragment the heaps until large allocations fail and fall back to slower memory types.
+// Every FRAME_INTERVAL frames this runs a single bounded defragmentation pass: VMA selects
+// at most MAX_BYTES_PER_PASS / MAX_ALLOCATIONS_PER_PASS worth of allocations to move, we
+// record one GPU copy per moved buffer and wait for the copies to execute before VMA commits
+// the moves and frees the source memory. Only allocations owned by a VulkanBuffer are moved
+// (found through the allocation's user data); slab, staging and image allocations are
+// skipped. Everything happens within one tick() call, so no buffer can be destroyed while a
+// pass is in flight.
+class VulkanDefragmenter {
+public:
+    void initialize(VmaAllocator allocator, VkDevice device, VulkanCommands* commands) noexcept;
+
+    // Called once per frame, at the end of the frame; most calls return immediately.
+    void tick() noexcept;
+
+private:
+    // frames between two defragmentation passes; the per-pass budget below bounds the
+    // worst-case stall of a pass
+    static constexpr uint32_t FRAME_INTERVAL = 512;
+    static constexpr VkDeviceSize MAX_BYTES_PER_PASS = 4u * 1024u * 1024u;
+    static constexpr uint32_t MAX_ALLOCATIONS_PER_PASS = 16;
+
+    void runPass() noexcept;
+
+    VmaAllocator mAllocator = VK_NULL_HANDLE;
+    VkDevice mDevice = VK_NULL_HANDLE;
+    VulkanCommands* mCommands = nullptr;
+    uint32_t mFrameCount = 0;
+    bool mUnsupported = false;
+};
+
+} // namespace filament::backend
+
+#endif // TNT_FILAMENT_BACKEND_VULKANDEFRAGMENTER_H
@@ -195,9 +195,12 @@ VulkanDriver::VulkanDriver(VulkanPlatform* platform, VulkanContext const& contex
             &mResourceAllocator);
     mCommands->setObserver(&mPipelineCache);
     mPipelineCache.setDevice(mPlatform->getDevice(), mAllocator);
+    mPipelineCache.setFragmentShadingRateSupported(mContext.isFragmentShadingRateSupported());
 
     // TOOD: move them all to be initialized by constructor
     mStagePool.initialize(mAllocator, mCommands.get());
+    mBufferPool.initialize(mAllocator);
+    mDefragmenter.initialize(mAllocator, mPlatform->getDevice(), mCommands.get());
     mFramebufferCache.initialize(mPlatform->getDevice());
     mSamplerCache.initialize(mPlatform->getDevice());
 
@@ -243,6 +246,7 @@ void VulkanDriver::terminate() {
     mStagePool.gc();
 
     mStagePool.terminate();
+    mBufferPool.terminate();
     mPipelineCache.terminate();
     mFramebufferCache.reset();
     mSamplerCache.terminate();
@@ -294,6 +298,9 @@ void VulkanDriver::setPresentationTime(int64_t monotonic_clock_ns) {
 void VulkanDriver::endFrame(uint32_t frameId) {
     FVK_SYSTRACE_CONTEXT();
     FVK_SYSTRACE_START("endframe");
+    // most calls return immediately; every few hundred frames this runs one bounded
+    // defragmentation pass against the VMA heaps
+    mDefragmenter.tick();
     mCommands->flush();
     collectGarbage();
     FVK_SYSTRACE_END();
@@ -360,7 +367,7 @@ void VulkanDriver::createIndexBufferR(Handle<HwIndexBuffer> ibh, ElementType ele
         uint32_t indexCount, BufferUsage usage) {
     auto elementSize = (uint8_t) getElementTypeSize(elementType);
     auto indexBuffer = mResourceAllocator.construct<VulkanIndexBuffer>(ibh, mAllocator, mStagePool,
-            elementSize, indexCount);
+            mBufferPool, elementSize, indexCount);
     mResourceManager.acquire(indexBuffer);
 }
 
@@ -375,7 +382,7 @@ void VulkanDriver::destroyIndexBuffer(Handle<HwIndexBuffer> ibh) {
 void VulkanDriver::createBufferObjectR(Handle<HwBufferObject> boh, uint32_t byteCount,
         BufferObjectBinding bindingType, BufferUsage usage) {
     auto bufferObject = mResourceAllocator.construct<VulkanBufferObject>(boh, mAllocator,
-            mStagePool, byteCount, bindingType);
+            mStagePool, mBufferPool, byteCount, bindingType, usage);
     mResourceManager.acquire(bufferObject);
 }
 
@@ -721,6 +728,10 @@ bool VulkanDriver::isTextureSwizzleSupported() {
     return true;
 }
 
+StateCacheStatistics VulkanDriver::getStateCacheStatistics() {
+    return {};
+}
+
 bool VulkanDriver::isTextureFormatMipmappable(TextureFormat format) {
     switch (format) {
         case TextureFormat::DEPTH16:
@@ -764,6 +775,16 @@ bool VulkanDriver::isSRGBSwapChainSupported() {
     return mIsSRGBSwapChainSupported;
 }
 
+int32_t VulkanDriver::getSwapChainImageFd(Handle<HwSwapChain> sch, uint32_t index) {
+    VulkanSwapChain* const swapChain = mResourceAllocator.handle_cast<VulkanSwapChain*>(sch);
+    return mPlatform->getSwapChainImageFd(swapChain->swapChain, index);
+}
+
+uint64_t VulkanDriver::getFrameLatencyNanos(Handle<HwSwapChain> sch) {
+    VulkanSwapChain* const swapChain = mResourceAllocator.handle_cast<VulkanSwapChain*>(sch);
+    return mPlatform->getFrameLatencyNanos(swapChain->swapChain);
+}
+
 bool VulkanDriver::isStereoSupported() {
     return true;
 }
@@ -804,6 +825,11 @@ bool VulkanDriver::isWorkaroundNeeded(Workaround workaround) {
             return false;
         case Workaround::DISABLE_BLIT_INTO_TEXTURE_ARRAY:
             return false;
+        case Workaround::DISABLE_SUBPASS_WITH_TAA: {
+            auto const vendorId = mContext.getPhysicalDeviceVendorId();
+            // the color grading subpass degrades TAA performance
+            return vendorId == 0x5143; // Qualcomm
+        }
         default:
             return false;
     }
@@ -885,15 +911,36 @@ void VulkanDriver::updateBufferObject(Handle<HwBufferObject> boh, BufferDescript
 
 void VulkanDriver::updateBufferObjectUnsynchronized(Handle<HwBufferObject> boh,
         BufferDescriptor&& bd, uint32_t byteOffset) {
-    VulkanCommandBuffer& commands = mCommands->get();
     auto bo = mResourceAllocator.handle_cast<VulkanBufferObject*>(boh);
+
+    // An unsynchronized update is not ordered against GPU reads of the buffer -- the caller
+    // took responsibility for that -- so dynamic uniform buffers that landed in the
+    // host-visible device-local heap (resizable BAR) are written directly, skipping the
+    // staging copy. This is the equivalent of the GL backend's GL_MAP_UNSYNCHRONIZED_BIT path.
+    if (bo->buffer.tryDirectWrite(bd.buffer, byteOffset, bd.size)) {
+        scheduleDestroy(std::move(bd));
+        return;
+    }
+
+    VulkanCommandBuffer& commands = mCommands->get();
     commands.acquire(bo);
-    // TODO: implement unsynchronized version
+    // TODO: an unsynchronized version of this fallback (the staging copy is queue-ordered)
     bo->buffer.loadFromCpu(commands.buffer(), bd.buffer, byteOffset, bd.size);
     mResourceManager.acquire(bo);
     scheduleDestroy(std::move(bd));
 }
 
+void VulkanDriver::copyBufferObject(Handle<HwBufferObject> dboh, uint32_t dstOffset,
+        Handle<HwBufferObject> sboh, uint32_t srcOffset, uint32_t size) {
+    VulkanCommandBuffer& commands = mCommands->get();
+
+    auto dbo = mResourceAllocator.handle_cast<VulkanBufferObject*>(dboh);
+    auto sbo = mResourceAllocator.handle_cast<VulkanBufferObject*>(sboh);
+    commands.acquire(dbo);
+    commands.acquire(sbo);
+    dbo->buffer.copyFrom(commands.buffer(), sbo->buffer, srcOffset, dstOffset, size);
+}
+
 void VulkanDriver::resetBufferObject(Handle<HwBufferObject> boh) {
     // TODO: implement resetBufferObject(). This is equivalent to calling
     // destroyBufferObject() followed by createBufferObject() keeping the same handle.
@@ -947,6 +994,15 @@ bool VulkanDriver::getTimerQueryValue(Handle<HwTimerQuery> tqh, uint64_t* elapse
 }
 
 void VulkanDriver::setExternalImage(Handle<HwTexture> th, void* image) {
+    // On this backend, the opaque pointer is a VulkanPlatform::ExternalImageDmaBuf describing a
+    // frame produced outside of Filament (e.g. by a video decoder). Importing it rebinds the
+    // texture's backing store without any CPU copy.
+    if (!mContext.isExternalMemoryDmaBufSupported()) {
+        return;
+    }
+    auto const* dmabuf = static_cast<VulkanPlatform::ExternalImageDmaBuf const*>(image);
+    mResourceAllocator.handle_cast<VulkanTexture*>(th)->attachExternalMemory(mContext,
+            dmabuf->fd, dmabuf->width, dmabuf->height, dmabuf->format, dmabuf->allocationSize);
 }
 
 void VulkanDriver::setExternalImagePlane(Handle<HwTexture> th, void* image, uint32_t plane) {
@@ -995,7 +1051,7 @@ void VulkanDriver::generateMipmaps(Handle<HwTexture> th) {
 }
 
 void VulkanDriver::updateSamplerGroup(Handle<HwSamplerGroup> sbh,
-        BufferDescriptor&& data) {
+        BufferDescriptor&& data, uint64_t dirtyMask) {
     auto* sb = mResourceAllocator.handle_cast<VulkanSamplerGroup*>(sbh);
 
     // FIXME: we shouldn't be using SamplerGroup here, instead the backend should create
@@ -1003,9 +1059,21 @@ void VulkanDriver::updateSamplerGroup(Handle<HwSamplerGroup> sbh,
     //        It's preferable to do as much work as possible here.
     //        Here, we emulate the older backend API by re-creating a SamplerGroup from the
     //        passed data.
-    SamplerGroup samplerGroup(data.size / sizeof(SamplerDescriptor));
-    memcpy(samplerGroup.data(), data.buffer, data.size);
-    *sb->sb = std::move(samplerGroup);
+    size_t const count = data.size / sizeof(SamplerDescriptor);
+    if (UTILS_LIKELY(sb->sb->getSize() == count)) {
+        // only copy the slots that changed, the others keep their current descriptor
+        auto const* const pSamplers = (SamplerDescriptor const*)data.buffer;
+        SamplerDescriptor* const pDest = sb->sb->data();
+        for (size_t i = 0; i < count; i++) {
+            if (dirtyMask & (uint64_t(1) << i)) {
+                pDest[i] = pSamplers[i];
+            }
+        }
+    } else {
+        SamplerGroup samplerGroup(count);
+        memcpy(samplerGroup.data(), data.buffer, data.size);
+        *sb->sb = std::move(samplerGroup);
+    }
 
     scheduleDestroy(std::move(data));
 }
@@ -1131,12 +1199,10 @@ void VulkanDriver::beginRenderPass(Handle<HwRenderTarget> rth, const RenderPassP
         }
     }
 
-    VkRenderPass renderPass = mFramebufferCache.getRenderPass(rpkey);
-    mPipelineCache.bindRenderPass(renderPass, 0);
-
-    // Create the VkFramebuffer or fetch it from cache.
+    // Build the framebuffer key; the renderPass field is filled in when the pass is resolved
+    // below.
     VulkanFboCache::FboKey fbkey {
-        .renderPass = renderPass,
+        .renderPass = VK_NULL_HANDLE,
         .width = (uint16_t) extent.width,
         .height = (uint16_t) extent.height,
         .layers = 1,
@@ -1173,7 +1239,21 @@ void VulkanDriver::beginRenderPass(Handle<HwRenderTarget> rth, const RenderPassP
                 rt->getDepth().texture->samples == 1 &&
                 !any(rpkey.discardEnd & TargetBufferFlags::DEPTH)));
     }
-    VkFramebuffer vkfb = mFramebufferCache.getFramebuffer(fbkey);
+
+    // Resolve the keys into a render pass and framebuffer. Render targets remember the indices
+    // of their recently begun passes, so in steady state this is a straight key comparison
+    // against a remembered pass, with no hashing and no cache lookup.
+    VulkanFboCache::ResolvedPass const* pass
+            = rt->findResolvedPass(mFramebufferCache, rpkey, fbkey);
+    if (UTILS_UNLIKELY(!pass)) {
+        VulkanFboCache::PassIndex const passIndex = mFramebufferCache.resolvePass(rpkey, fbkey);
+        rt->rememberResolvedPass(passIndex);
+        pass = mFramebufferCache.getResolvedPass(passIndex, rpkey, fbkey);
+        assert_invariant(pass);
+    }
+    VkRenderPass const renderPass = pass->fbkey.renderPass;
+    mPipelineCache.bindRenderPass(renderPass, 0);
+    VkFramebuffer const vkfb = pass->framebuffer;
 
     // Assign a label to the framebuffer for debugging purposes.
     #if FVK_ENABLED(FVK_DEBUG_GROUP_MARKERS)
@@ -1261,6 +1341,29 @@ void VulkanDriver::beginRenderPass(Handle<HwRenderTarget> rth, const RenderPassP
     rt->transformClientRectToPlatform(&viewport);
     vkCmdSetViewport(cmdbuffer, 0, 1, &viewport);
 
+#if defined(VK_KHR_fragment_shading_rate)
+    if (mContext.isFragmentShadingRateSupported()) {
+        // The shading rate is dynamic state, so it must be (re)set for every pass. Only the
+        // 1x1, 1x2, 2x1 and 2x2 rates are guaranteed by the extension; larger footprints are
+        // clamped to 2x2 rather than queried, per ShadingRate's "hint" contract.
+        VkExtent2D fragmentSize = { 1, 1 };
+        switch (params.shadingRate) {
+            case ShadingRate::ONE_BY_ONE:                   fragmentSize = { 1, 1 }; break;
+            case ShadingRate::ONE_BY_TWO:                   fragmentSize = { 1, 2 }; break;
+            case ShadingRate::TWO_BY_ONE:                   fragmentSize = { 2, 1 }; break;
+            case ShadingRate::TWO_BY_TWO:
+            case ShadingRate::TWO_BY_FOUR:
+            case ShadingRate::FOUR_BY_TWO:
+            case ShadingRate::FOUR_BY_FOUR:                 fragmentSize = { 2, 2 }; break;
+        }
+        VkFragmentShadingRateCombinerOpKHR const combinerOps[2] = {
+                VK_FRAGMENT_SHADING_RATE_COMBINER_OP_KEEP_KHR,
+                VK_FRAGMENT_SHADING_RATE_COMBINER_OP_KEEP_KHR,
+        };
+        vkCmdSetFragmentShadingRateKHR(cmdbuffer, &fragmentSize, combinerOps);
+    }
+#endif
+
     mCurrentRenderPass = {
         .renderTarget = rt,
         .renderPass = renderPassInfo.renderPass,
@@ -1455,6 +1558,9 @@ void VulkanDriver::readPixels(Handle<HwRenderTarget> src, uint32_t x, uint32_t y
         uint32_t height, PixelBufferDescriptor&& pbd) {
     VulkanRenderTarget* srcTarget = mResourceAllocator.handle_cast<VulkanRenderTarget*>(src);
     mCommands->flush();
+    // VulkanReadPixels submits its own work to the queue, which must land after the
+    // rendering commands flushed above.
+    mCommands->submitPending();
     mReadPixels.run(
             srcTarget, x, y, width, height, mPlatform->getGraphicsQueueFamilyIndex(),
             std::move(pbd),
@@ -1777,8 +1883,8 @@ void VulkanDriver::draw(PipelineState pipelineState, Handle<HwRenderPrimitive> r
     // avoid rebinding these if they are already bound, but since we do not (yet) support subranges
     // it would be rare for a client to make consecutive draw calls with the same render primitive.
     vkCmdBindVertexBuffers(cmdbuffer, 0, bufferCount, buffers, offsets);
-    vkCmdBindIndexBuffer(cmdbuffer, prim.indexBuffer->buffer.getGpuBuffer(), 0,
-            prim.indexBuffer->indexType);
+    vkCmdBindIndexBuffer(cmdbuffer, prim.indexBuffer->buffer.getGpuBuffer(),
+            prim.indexBuffer->buffer.getGpuOffset(), prim.indexBuffer->indexType);
 
     // Finally, make the actual draw call. TODO: support subranges
     const uint32_t indexCount = prim.count;
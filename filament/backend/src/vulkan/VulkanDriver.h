@@ -20,12 +20,14 @@
 #include "VulkanBlitter.h"
 #include "VulkanConstants.h"
 #include "VulkanContext.h"
+#include "VulkanDefragmenter.h"
 #include "VulkanFboCache.h"
 #include "VulkanHandles.h"
 #include "VulkanPipelineCache.h"
 #include "VulkanReadPixels.h"
 #include "VulkanResourceAllocator.h"
 #include "VulkanSamplerCache.h"
+#include "VulkanBufferPool.h"
 #include "VulkanStagePool.h"
 #include "VulkanUtility.h"
 
@@ -107,6 +109,8 @@ private:
 
     VulkanPipelineCache mPipelineCache;
     VulkanStagePool mStagePool;
+    VulkanBufferPool mBufferPool;
+    VulkanDefragmenter mDefragmenter;
     VulkanFboCache mFramebufferCache;
     VulkanSamplerCache mSamplerCache;
     VulkanBlitter mBlitter;
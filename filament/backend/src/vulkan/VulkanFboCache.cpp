@@ -16,11 +16,14 @@
 
 #include "vulkan/VulkanFboCache.h"
 
+#include <utils/debug.h>
 #include <utils/Panic.h>
 
 #include "VulkanConstants.h"
 #include "VulkanUtility.h"
 
+#include <algorithm>
+
 // If any VkRenderPass or VkFramebuffer is unused for more than TIME_BEFORE_EVICTION frames, it
 // is evicted from the cache.
 static constexpr uint32_t TIME_BEFORE_EVICTION = FVK_MAX_COMMAND_BUFFERS;
@@ -323,6 +326,44 @@ VkRenderPass VulkanFboCache::getRenderPass(RenderPassKey config) noexcept {
     return renderPass;
 }
 
+VulkanFboCache::ResolvedPass const* VulkanFboCache::getResolvedPass(PassIndex index,
+        RenderPassKey const& rpkey, FboKey& fbkey) noexcept {
+    if (index >= mResolvedPasses.size()) {
+        return nullptr;
+    }
+    ResolvedPass& pass = mResolvedPasses[index];
+    if (pass.framebuffer == VK_NULL_HANDLE || !RenderPassEq{}(pass.rpkey, rpkey)) {
+        return nullptr;
+    }
+    // The caller hasn't resolved the render pass yet, so the comparison uses the remembered one.
+    fbkey.renderPass = pass.fbkey.renderPass;
+    if (!FboKeyEqualFn{}(pass.fbkey, fbkey)) {
+        return nullptr;
+    }
+    pass.timestamp = mCurrentTime;
+    return &pass;
+}
+
+VulkanFboCache::PassIndex VulkanFboCache::resolvePass(RenderPassKey const& rpkey,
+        FboKey& fbkey) noexcept {
+    fbkey.renderPass = getRenderPass(rpkey);
+    VkFramebuffer const framebuffer = getFramebuffer(fbkey);
+
+    // Reuse a retired slot when there is one, so that the number of slots stays bounded by the
+    // number of passes in recent use.
+    PassIndex index = 0;
+    for (PassIndex const n = mResolvedPasses.size(); index < n; index++) {
+        if (mResolvedPasses[index].framebuffer == VK_NULL_HANDLE) {
+            break;
+        }
+    }
+    if (index == mResolvedPasses.size()) {
+        mResolvedPasses.emplace_back();
+    }
+    mResolvedPasses[index] = { rpkey, fbkey, framebuffer, mCurrentTime };
+    return index;
+}
+
 void VulkanFboCache::reset() noexcept {
     for (auto pair : mFramebufferCache) {
         mRenderPassRefCount[pair.first.renderPass]--;
@@ -333,6 +374,7 @@ void VulkanFboCache::reset() noexcept {
         vkDestroyRenderPass(mDevice, pair.second.handle, VKALLOC);
     }
     mRenderPassCache.clear();
+    mResolvedPasses.clear();
 }
 
 // Frees up old framebuffers and render passes, then nulls out their key.  Doesn't bother removing
@@ -347,6 +389,25 @@ void VulkanFboCache::gc() noexcept {
     }
     const uint32_t evictTime = mCurrentTime - TIME_BEFORE_EVICTION;
 
+    // Resolved passes bind by index and bypass the hashed lookups, so their use must be
+    // propagated into the hashed entries' timestamps before the eviction sweeps below. Passes
+    // that haven't been begun recently are retired; resolvePass() reuses their slots.
+    for (ResolvedPass& pass : mResolvedPasses) {
+        if (pass.framebuffer == VK_NULL_HANDLE) {
+            continue;
+        }
+        if (pass.timestamp < evictTime) {
+            pass.framebuffer = VK_NULL_HANDLE;
+            continue;
+        }
+        auto rpIter = mRenderPassCache.find(pass.rpkey);
+        assert_invariant(rpIter != mRenderPassCache.end());
+        rpIter.value().timestamp = std::max(rpIter->second.timestamp, pass.timestamp);
+        auto fbIter = mFramebufferCache.find(pass.fbkey);
+        assert_invariant(fbIter != mFramebufferCache.end());
+        fbIter.value().timestamp = std::max(fbIter->second.timestamp, pass.timestamp);
+    }
+
     for (auto iter = mFramebufferCache.begin(); iter != mFramebufferCache.end(); ++iter) {
         const FboVal fbo = iter->second;
         if (fbo.timestamp < evictTime && fbo.handle) {
@@ -25,6 +25,8 @@
 
 #include <tsl/robin_map.h>
 
+#include <vector>
+
 namespace filament::backend {
 
 // Simple manager for VkFramebuffer and VkRenderPass objects.
@@ -104,6 +106,19 @@ public:
         bool operator()(const FboKey& k1, const FboKey& k2) const;
     };
 
+    // A render pass and framebuffer pair resolved through the hashed caches exactly once, then
+    // re-bound by index on subsequent frames. VulkanRenderTarget remembers the indices of its
+    // recently begun passes, so steady-state frames validate the keys with a straight comparison
+    // and never hash. The resolved render pass lives in fbkey.renderPass.
+    struct ResolvedPass {
+        RenderPassKey rpkey;
+        FboKey fbkey;
+        VkFramebuffer framebuffer;
+        uint32_t timestamp;
+    };
+    using PassIndex = uint32_t;
+    static constexpr PassIndex INVALID_PASS_INDEX = 0xffffffffu;
+
     ~VulkanFboCache();
 
     void initialize(VkDevice device) noexcept;
@@ -114,6 +129,16 @@ public:
     // Retrieves or creates a VkRenderPass handle.
     VkRenderPass getRenderPass(RenderPassKey config) noexcept;
 
+    // Returns the resolved pass at the given index if it is still alive and matches the given
+    // keys, otherwise null. The renderPass field of fbkey need not be filled in by the caller;
+    // it is taken from the remembered key before the comparison.
+    ResolvedPass const* getResolvedPass(PassIndex index, RenderPassKey const& rpkey,
+            FboKey& fbkey) noexcept;
+
+    // Resolves the given keys through the hashed caches and remembers the result for by-index
+    // retrieval with getResolvedPass. Fills in the renderPass field of fbkey.
+    PassIndex resolvePass(RenderPassKey const& rpkey, FboKey& fbkey) noexcept;
+
     // Evicts old unused Vulkan objects. Call this once per frame.
     void gc() noexcept;
 
@@ -125,6 +150,7 @@ private:
     tsl::robin_map<FboKey, FboVal, FboKeyHashFn, FboKeyEqualFn> mFramebufferCache;
     tsl::robin_map<RenderPassKey, RenderPassVal, RenderPassHash, RenderPassEq> mRenderPassCache;
     tsl::robin_map<VkRenderPass, uint32_t> mRenderPassRefCount;
+    std::vector<ResolvedPass> mResolvedPasses;
     uint32_t mCurrentTime = 0;
 };
 
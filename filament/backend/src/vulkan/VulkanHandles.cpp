@@ -172,9 +172,12 @@ VulkanRenderTarget::VulkanRenderTarget(VkDevice device, VkPhysicalDevice physica
             auto msTexture = texture->getSidecar();
             if (UTILS_UNLIKELY(!msTexture)) {
                 // TODO: This should be allocated with the ResourceAllocator.
+                // The sidecar is only ever a framebuffer attachment and is resolved within the
+                // render pass, so it never needs main-memory backing on tile-based GPUs.
                 msTexture = new VulkanTexture(device, physicalDevice, context, allocator, commands,
                         texture->target, ((VulkanTexture const*) texture)->levels, texture->format,
-                        samples, texture->width, texture->height, texture->depth, texture->usage,
+                        samples, texture->width, texture->height, texture->depth,
+                        texture->usage | TextureUsage::MEMORYLESS,
                         stagePool, true /* heap allocated */);
                 texture->setSidecar(msTexture);
             }
@@ -262,6 +265,21 @@ uint8_t VulkanRenderTarget::getColorTargetCount(const VulkanRenderPass& pass) co
     return count;
 }
 
+VulkanFboCache::ResolvedPass const* VulkanRenderTarget::findResolvedPass(VulkanFboCache& cache,
+        VulkanFboCache::RenderPassKey const& rpkey, VulkanFboCache::FboKey& fbkey) noexcept {
+    for (VulkanFboCache::PassIndex const index : mResolvedPassMemo) {
+        if (auto const* pass = cache.getResolvedPass(index, rpkey, fbkey)) {
+            return pass;
+        }
+    }
+    return nullptr;
+}
+
+void VulkanRenderTarget::rememberResolvedPass(VulkanFboCache::PassIndex index) noexcept {
+    mResolvedPassMemo[mNextResolvedPass] = index;
+    mNextResolvedPass = (mNextResolvedPass + 1) % RESOLVED_PASS_MEMO_SIZE;
+}
+
 VulkanVertexBuffer::VulkanVertexBuffer(VulkanContext& context, VulkanStagePool& stagePool,
         VulkanResourceAllocator* allocator, uint8_t bufferCount, uint8_t attributeCount,
         uint32_t elementCount, AttributeArray const& attribs)
@@ -312,20 +330,29 @@ VulkanVertexBuffer::~VulkanVertexBuffer() {
 void VulkanVertexBuffer::setBuffer(VulkanBufferObject* bufferObject, uint32_t index) {
     size_t count = attributes.size();
     auto vkbuffers = mInfo->mSoa.data<PipelineInfo::VK_BUFFER>();
+    auto offsets = mInfo->mSoa.data<PipelineInfo::OFFSETS>();
     auto attribToBuffer = mInfo->mSoa.data<PipelineInfo::ATTRIBUTE_TO_BUFFER_INDEX>();
     for (uint8_t attribIndex = 0; attribIndex < count; attribIndex++) {
         if (attribToBuffer[attribIndex] == static_cast<int8_t>(index)) {
+            Attribute attrib = attributes[attribIndex];
+            if (attrib.buffer == Attribute::BUFFER_UNUSED) {
+                attrib = attributes[0];
+            }
             vkbuffers[attribIndex] = bufferObject->buffer.getGpuBuffer();
+            // the buffer may be sub-allocated out of a slab, rebase the attribute offset
+            offsets[attribIndex] = attrib.offset + bufferObject->buffer.getGpuOffset();
         }
     }
     mResources.acquire(bufferObject);
 }
 
 VulkanBufferObject::VulkanBufferObject(VmaAllocator allocator, VulkanStagePool& stagePool,
-        uint32_t byteCount, BufferObjectBinding bindingType)
+        VulkanBufferPool& bufferPool, uint32_t byteCount, BufferObjectBinding bindingType,
+        BufferUsage usage)
     : HwBufferObject(byteCount),
       VulkanResource(VulkanResourceType::BUFFER_OBJECT),
-      buffer(allocator, stagePool, getBufferObjectUsage(bindingType), byteCount),
+      buffer(allocator, stagePool, getBufferObjectUsage(bindingType), byteCount, &bufferPool,
+              usage == BufferUsage::DYNAMIC && bindingType == BufferObjectBinding::UNIFORM),
       bindingType(bindingType) {}
 
 void VulkanRenderPrimitive::setPrimitiveType(PrimitiveType pt) {
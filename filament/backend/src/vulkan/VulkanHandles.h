@@ -21,6 +21,7 @@
 #include "DriverBase.h"
 
 #include "VulkanBuffer.h"
+#include "VulkanFboCache.h"
 #include "VulkanPipelineCache.h"
 #include "VulkanResources.h"
 #include "VulkanSwapChain.h"
@@ -118,11 +119,27 @@ struct VulkanRenderTarget : private HwRenderTarget, VulkanResource {
     bool isSwapChain() const { return !mOffscreen; }
     void bindToSwapChain(VulkanSwapChain& surf);
 
+    // Finds a pass recently begun on this render target that matches the given keys, using
+    // VulkanFboCache's by-index path, which does no hashing. Returns null when no remembered
+    // pass matches; the caller then resolves the keys through the hashed caches and records
+    // the result with rememberResolvedPass().
+    VulkanFboCache::ResolvedPass const* findResolvedPass(VulkanFboCache& cache,
+            VulkanFboCache::RenderPassKey const& rpkey, VulkanFboCache::FboKey& fbkey) noexcept;
+    void rememberResolvedPass(VulkanFboCache::PassIndex index) noexcept;
+
 private:
+    // A few memo slots are enough to cover swap chain rotation, where the attachment views
+    // cycle from frame to frame.
+    static constexpr uint8_t RESOLVED_PASS_MEMO_SIZE = 4;
+
     VulkanAttachment mColor[MRT::MAX_SUPPORTED_RENDER_TARGET_COUNT] = {};
     VulkanAttachment mDepth = {};
     VulkanAttachment mMsaaAttachments[MRT::MAX_SUPPORTED_RENDER_TARGET_COUNT] = {};
     VulkanAttachment mMsaaDepthAttachment = {};
+    VulkanFboCache::PassIndex mResolvedPassMemo[RESOLVED_PASS_MEMO_SIZE] = {
+            VulkanFboCache::INVALID_PASS_INDEX, VulkanFboCache::INVALID_PASS_INDEX,
+            VulkanFboCache::INVALID_PASS_INDEX, VulkanFboCache::INVALID_PASS_INDEX };
+    uint8_t mNextResolvedPass = 0;
     const bool mOffscreen : 1;
     uint8_t mSamples : 7;
 };
@@ -182,11 +199,12 @@ private:
 };
 
 struct VulkanIndexBuffer : public HwIndexBuffer, VulkanResource {
-    VulkanIndexBuffer(VmaAllocator allocator, VulkanStagePool& stagePool, uint8_t elementSize,
-            uint32_t indexCount)
+    VulkanIndexBuffer(VmaAllocator allocator, VulkanStagePool& stagePool,
+            VulkanBufferPool& bufferPool, uint8_t elementSize, uint32_t indexCount)
         : HwIndexBuffer(elementSize, indexCount),
           VulkanResource(VulkanResourceType::INDEX_BUFFER),
-          buffer(allocator, stagePool, VK_BUFFER_USAGE_INDEX_BUFFER_BIT, elementSize * indexCount),
+          buffer(allocator, stagePool, VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                  elementSize * indexCount, &bufferPool),
           indexType(elementSize == 2 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32) {}
 
     VulkanBuffer buffer;
@@ -194,8 +212,9 @@ struct VulkanIndexBuffer : public HwIndexBuffer, VulkanResource {
 };
 
 struct VulkanBufferObject : public HwBufferObject, VulkanResource {
-    VulkanBufferObject(VmaAllocator allocator, VulkanStagePool& stagePool, uint32_t byteCount,
-            BufferObjectBinding bindingType);
+    VulkanBufferObject(VmaAllocator allocator, VulkanStagePool& stagePool,
+            VulkanBufferPool& bufferPool, uint32_t byteCount, BufferObjectBinding bindingType,
+            BufferUsage usage);
 
     VulkanBuffer buffer;
     const BufferObjectBinding bindingType;
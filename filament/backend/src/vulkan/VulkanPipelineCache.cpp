@@ -125,24 +125,20 @@ void VulkanPipelineCache::setDevice(VkDevice device, VmaAllocator allocator) {
 }
 
 bool VulkanPipelineCache::bindDescriptors(VkCommandBuffer cmdbuffer) noexcept {
-    DescriptorMap::iterator descriptorIter = mDescriptorSets.find(mDescriptorRequirements);
-
-    // Check if the required descriptors are already bound. If so, there's no need to do anything.
-    if (DescEqual equals; UTILS_LIKELY(equals(mBoundDescriptor, mDescriptorRequirements))) {
-
-        // If the pipeline state during an app's first draw call happens to match the default state
-        // vector of the cache, then the cache is uninitialized and we should not return early.
-        if (UTILS_LIKELY(!mDescriptorSets.empty())) {
-
-            // Since the descriptors are already bound, they should be found in the cache.
-            assert_invariant(descriptorIter != mDescriptorSets.end());
-
-            // Update the LRU "time stamp" (really a count of cmd buf submissions) before returning.
-            descriptorIter.value().lastUsed = mCurrentTime;
-            return true;
-        }
+    // Check if the required descriptors are already bound. If so, there's no need to do anything;
+    // in particular this skips hashing the (large) descriptor key for the map lookup below, which
+    // would otherwise dominate the cost of fully redundant binds. mBoundDescriptorEntry being
+    // non-null guarantees that a successful bind actually took place (so this cannot trigger on
+    // an app's first draw call, whose state could match the cache's default state vector).
+    if (DescEqual equals; UTILS_LIKELY(mBoundDescriptorEntry
+            && equals(mBoundDescriptor, mDescriptorRequirements))) {
+        // Update the LRU "time stamp" (really a count of cmd buf submissions) before returning.
+        mBoundDescriptorEntry->lastUsed = mCurrentTime;
+        return true;
     }
 
+    DescriptorMap::iterator descriptorIter = mDescriptorSets.find(mDescriptorRequirements);
+
     // If a cached object exists, re-use it, otherwise create a new one.
     DescriptorCacheEntry* cacheEntry = UTILS_LIKELY(descriptorIter != mDescriptorSets.end()) ?
             &descriptorIter.value() : createDescriptorSets();
@@ -150,11 +146,13 @@ bool VulkanPipelineCache::bindDescriptors(VkCommandBuffer cmdbuffer) noexcept {
     // If a descriptor set overflow occurred, allow higher levels to handle it gracefully.
     assert_invariant(cacheEntry != nullptr);
     if (UTILS_UNLIKELY(cacheEntry == nullptr)) {
+        mBoundDescriptorEntry = nullptr;
         return false;
     }
 
     cacheEntry->lastUsed = mCurrentTime;
     mBoundDescriptor = mDescriptorRequirements;
+    mBoundDescriptorEntry = cacheEntry;
     // This passes the currently "bound" uniform buffer objects to pipeline that will be used in the
     // draw call.
     auto resourceEntry = mDescriptorResources.find(cacheEntry->id);
@@ -397,11 +395,12 @@ VulkanPipelineCache::PipelineCacheEntry* VulkanPipelineCache::createPipeline() n
     VkDynamicState dynamicStateEnables[] = {
         VK_DYNAMIC_STATE_VIEWPORT,
         VK_DYNAMIC_STATE_SCISSOR,
+        VK_DYNAMIC_STATE_FRAGMENT_SHADING_RATE_KHR,
     };
     VkPipelineDynamicStateCreateInfo dynamicState = {};
     dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
     dynamicState.pDynamicStates = dynamicStateEnables;
-    dynamicState.dynamicStateCount = 2;
+    dynamicState.dynamicStateCount = mFragmentShadingRateSupported ? 3 : 2;
 
     const bool hasFragmentShader = shaderStages[1].module != VK_NULL_HANDLE;
 
@@ -698,6 +697,7 @@ void VulkanPipelineCache::onCommandBuffer(const VulkanCommandBuffer& commands) {
     // buffer is undefined." Therefore, we need to clear all bindings at this time.
     mBoundPipeline = {};
     mBoundDescriptor = {};
+    mBoundDescriptorEntry = nullptr;
     mCurrentScissor = {};
 
     // NOTE: Due to robin_map restrictions, we cannot use auto or range-based loops.
@@ -845,6 +845,7 @@ void VulkanPipelineCache::destroyLayoutsAndDescriptors() noexcept {
     mDescriptorResources.clear();
 
     mBoundDescriptor = {};
+    mBoundDescriptorEntry = nullptr;
 }
 
 void VulkanPipelineCache::growDescriptorPool() noexcept {
@@ -872,6 +873,7 @@ void VulkanPipelineCache::growDescriptorPool() noexcept {
         mExtinctDescriptorBundles.push_back(iter.value());
     }
     mDescriptorSets.clear();
+    mBoundDescriptorEntry = nullptr;
 }
 
 size_t VulkanPipelineCache::PipelineLayoutKeyHashFn::operator()(
@@ -139,6 +139,12 @@ public:
     ~VulkanPipelineCache();
     void setDevice(VkDevice device, VmaAllocator allocator);
 
+    // When VK_KHR_fragment_shading_rate is available, pipelines declare the shading rate as
+    // dynamic state so that a per-pass rate can be set without growing the pipeline key.
+    void setFragmentShadingRateSupported(bool supported) noexcept {
+        mFragmentShadingRateSupported = supported;
+    }
+
     // Creates new descriptor sets if necessary and binds them using vkCmdBindDescriptorSets.
     // Returns false if descriptor set allocation fails.
     bool bindDescriptors(VkCommandBuffer cmdbuffer) noexcept;
@@ -411,6 +417,7 @@ private:
     // Immutable state.
     VkDevice mDevice = VK_NULL_HANDLE;
     VmaAllocator mAllocator = VK_NULL_HANDLE;
+    bool mFragmentShadingRateSupported = false;
 
     // Current requirements for the pipeline layout, pipeline, and descriptor sets.
     RasterState mCurrentRasterState;
@@ -421,6 +428,11 @@ private:
     PipelineKey mBoundPipeline = {};
     DescriptorKey mBoundDescriptor = {};
 
+    // Cache entry for the currently bound descriptor sets, used to refresh its LRU time stamp
+    // without a map lookup when the bindings are unchanged. This must be nulled out whenever
+    // mDescriptorSets is cleared or has entries erased, since it points into the map's storage.
+    DescriptorCacheEntry* mBoundDescriptorEntry = nullptr;
+
     // Current state for scissoring.
     VkRect2D mCurrentScissor = {};
 
@@ -24,6 +24,8 @@
 
 #include <utils/Log.h>
 
+#include <algorithm>
+
 using namespace bluevk;
 
 namespace filament::backend {
@@ -108,11 +110,19 @@ void VulkanReadPixels::terminate() noexcept {
     if (mCommandPool == VK_NULL_HANDLE) {
         return;
     }
-    vkDestroyCommandPool(mDevice, mCommandPool, VKALLOC);
+    VkDevice const device = mDevice;
+    vkDestroyCommandPool(device, mCommandPool, VKALLOC);
     mDevice = VK_NULL_HANDLE;
 
     mTaskHandler->shutdown();
     mTaskHandler.reset();
+
+    // all tasks have completed, nothing can touch the pool anymore
+    for (auto const& staging: mStagingImagePool) {
+        vkDestroyImage(device, staging.image, VKALLOC);
+        vkFreeMemory(device, staging.memory, VKALLOC);
+    }
+    mStagingImagePool.clear();
 }
 
 VulkanReadPixels::VulkanReadPixels(VkDevice device)
@@ -150,58 +160,65 @@ void VulkanReadPixels::run(VulkanRenderTarget const* srcTarget, uint32_t const x
     bool const swizzle
             = srcFormat == VK_FORMAT_B8G8R8A8_UNORM || srcFormat == VK_FORMAT_B8G8R8A8_SRGB;
 
-    // Create a host visible, linearly tiled image as a staging area.
-    VkImageCreateInfo const imageInfo{
-            .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
-            .imageType = VK_IMAGE_TYPE_2D,
-            .format = srcFormat,
-            .extent = {width, height, 1},
-            .mipLevels = 1,
-            .arrayLayers = 1,
-            .samples = VK_SAMPLE_COUNT_1_BIT,
-            .tiling = VK_IMAGE_TILING_LINEAR,
-            .usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT,
-            .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-    };
-
+    // Reuse a staging image from a previous readback if one matches, otherwise create a
+    // host visible, linearly tiled image as a staging area.
     VkImage stagingImage;
-    vkCreateImage(device, &imageInfo, VKALLOC, &stagingImage);
+    VkDeviceMemory stagingMemory;
+    StagingImage staging;
+    if (acquireStagingImage(srcFormat, width, height, &staging)) {
+        stagingImage = staging.image;
+        stagingMemory = staging.memory;
+    } else {
+        VkImageCreateInfo const imageInfo{
+                .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+                .imageType = VK_IMAGE_TYPE_2D,
+                .format = srcFormat,
+                .extent = {width, height, 1},
+                .mipLevels = 1,
+                .arrayLayers = 1,
+                .samples = VK_SAMPLE_COUNT_1_BIT,
+                .tiling = VK_IMAGE_TILING_LINEAR,
+                .usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+                .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+        };
 
-#if FVK_ENABLED(FVK_DEBUG_READ_PIXELS)
-    utils::slog.d << "readPixels created image=" << stagingImage
-                  << " to copy from image=" << srcTexture->getVkImage()
-                  << " src-layout=" << srcTexture->getLayout(0, 0) << utils::io::endl;
-#endif
+        vkCreateImage(device, &imageInfo, VKALLOC, &stagingImage);
 
-    VkMemoryRequirements memReqs;
-    VkDeviceMemory stagingMemory;
-    vkGetImageMemoryRequirements(device, stagingImage, &memReqs);
-
-    uint32_t memoryTypeIndex = selectMemoryFunc(memReqs.memoryTypeBits,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-                    | VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
-
-    // If VK_MEMORY_PROPERTY_HOST_CACHED_BIT is not supported, we try only
-    // HOST_VISIBLE+HOST_COHERENT.  HOST_CACHED helps a lot with readpixels performance.
-    if (memoryTypeIndex >= VK_MAX_MEMORY_TYPES) {
-        memoryTypeIndex = selectMemoryFunc(memReqs.memoryTypeBits,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-        utils::slog.w
-                << "readPixels is slow because VK_MEMORY_PROPERTY_HOST_CACHED_BIT is not available"
-                << utils::io::endl;
-    }
+        VkMemoryRequirements memReqs;
+        vkGetImageMemoryRequirements(device, stagingImage, &memReqs);
 
-    ASSERT_POSTCONDITION(memoryTypeIndex < VK_MAX_MEMORY_TYPES,
-            "VulkanReadPixels: unable to find a memory type that meets requirements.");
+        uint32_t memoryTypeIndex = selectMemoryFunc(memReqs.memoryTypeBits,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+                        | VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
 
-    VkMemoryAllocateInfo const allocInfo = {
-            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-            .allocationSize = memReqs.size,
-            .memoryTypeIndex = memoryTypeIndex,
-    };
+        // If VK_MEMORY_PROPERTY_HOST_CACHED_BIT is not supported, we try only
+        // HOST_VISIBLE+HOST_COHERENT.  HOST_CACHED helps a lot with readpixels performance.
+        if (memoryTypeIndex >= VK_MAX_MEMORY_TYPES) {
+            memoryTypeIndex = selectMemoryFunc(memReqs.memoryTypeBits,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+            utils::slog.w << "readPixels is slow because VK_MEMORY_PROPERTY_HOST_CACHED_BIT is not"
+                             " available"
+                          << utils::io::endl;
+        }
+
+        ASSERT_POSTCONDITION(memoryTypeIndex < VK_MAX_MEMORY_TYPES,
+                "VulkanReadPixels: unable to find a memory type that meets requirements.");
+
+        VkMemoryAllocateInfo const allocInfo = {
+                .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+                .allocationSize = memReqs.size,
+                .memoryTypeIndex = memoryTypeIndex,
+        };
 
-    vkAllocateMemory(device, &allocInfo, VKALLOC, &stagingMemory);
-    vkBindImageMemory(device, stagingImage, stagingMemory, 0);
+        vkAllocateMemory(device, &allocInfo, VKALLOC, &stagingMemory);
+        vkBindImageMemory(device, stagingImage, stagingMemory, 0);
+    }
+
+#if FVK_ENABLED(FVK_DEBUG_READ_PIXELS)
+    utils::slog.d << "readPixels using image=" << stagingImage
+                  << " to copy from image=" << srcTexture->getVkImage()
+                  << " src-layout=" << srcTexture->getLayout(0, 0) << utils::io::endl;
+#endif
 
     VkCommandBuffer cmdbuffer;
     VkCommandBufferAllocateInfo const allocateInfo{
@@ -299,8 +316,8 @@ void VulkanReadPixels::run(VulkanRenderTarget const* srcTarget, uint32_t const x
         readCompleteFunc(std::move(p));
         delete pUserBuffer;
     };
-    auto waitFenceFunc = [device, width, height, swizzle, srcFormat, stagingImage, stagingMemory,
-                                 cmdpool, cmdbuffer, pUserBuffer,
+    auto waitFenceFunc = [this, device, width, height, swizzle, srcFormat, stagingImage,
+                                 stagingMemory, cmdpool, cmdbuffer, pUserBuffer,
                                  fence = readCompleteFence]() mutable {
         VkResult status = vkWaitForFences(device, 1, &fence, VK_TRUE, UINT64_MAX);
         // Fence hasn't been reached. Try waiting again.
@@ -327,14 +344,41 @@ void VulkanReadPixels::run(VulkanRenderTarget const* srcTarget, uint32_t const x
         }
 
         vkUnmapMemory(device, stagingMemory);
-        vkDestroyImage(device, stagingImage, VKALLOC);
-        vkFreeMemory(device, stagingMemory, VKALLOC);
+        releaseStagingImage(device, { stagingImage, stagingMemory, srcFormat, width, height });
         vkDestroyFence(device, fence, VKALLOC);
         vkFreeCommandBuffers(device, cmdpool, 1, &cmdbuffer);
     };
     mTaskHandler->post(std::move(waitFenceFunc), std::move(cleanPbdFunc));
 }
 
+bool VulkanReadPixels::acquireStagingImage(VkFormat const format, uint32_t const width,
+        uint32_t const height, StagingImage* const image) noexcept {
+    std::lock_guard<std::mutex> const lock(mStagingImagePoolMutex);
+    auto& pool = mStagingImagePool;
+    auto const pos = std::find_if(pool.begin(), pool.end(), [&](StagingImage const& staging) {
+        return staging.format == format && staging.width == width && staging.height == height;
+    });
+    if (pos == pool.end()) {
+        return false;
+    }
+    *image = *pos;
+    pool.erase(pos);
+    return true;
+}
+
+void VulkanReadPixels::releaseStagingImage(VkDevice const device,
+        StagingImage const& image) noexcept {
+    {
+        std::lock_guard<std::mutex> const lock(mStagingImagePoolMutex);
+        if (mStagingImagePool.size() < STAGING_IMAGE_POOL_SIZE) {
+            mStagingImagePool.push_back(image);
+            return;
+        }
+    }
+    vkDestroyImage(device, image.image, VKALLOC);
+    vkFreeMemory(device, image.memory, VKALLOC);
+}
+
 void VulkanReadPixels::runUntilComplete() noexcept {
     if (!mTaskHandler) {
         return;
@@ -83,9 +83,30 @@ public:
     void runUntilComplete() noexcept;
 
 private:
+    // A host-visible staging image recycled between readbacks, so that per-frame capture
+    // doesn't allocate and free device memory on every call.
+    struct StagingImage {
+        VkImage image;
+        VkDeviceMemory memory;
+        VkFormat format;
+        uint32_t width;
+        uint32_t height;
+    };
+
+    // bounds how many readbacks can be in flight before we start allocating again
+    static constexpr size_t STAGING_IMAGE_POOL_SIZE = 4;
+
+    bool acquireStagingImage(VkFormat format, uint32_t width, uint32_t height,
+            StagingImage* image) noexcept;
+    void releaseStagingImage(VkDevice device, StagingImage const& image) noexcept;
+
     VkDevice mDevice = VK_NULL_HANDLE;
     VkCommandPool mCommandPool = VK_NULL_HANDLE;
     std::unique_ptr<TaskHandler> mTaskHandler;
+
+    // accessed from both the driver thread and the task handler thread
+    std::mutex mStagingImagePoolMutex;
+    std::vector<StagingImage> mStagingImagePool;
 };
 
 }// namespace filament::backend
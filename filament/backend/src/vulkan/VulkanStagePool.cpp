@@ -24,6 +24,16 @@
 
 static constexpr uint32_t TIME_BEFORE_EVICTION = FVK_MAX_COMMAND_BUFFERS;
 
+// Size of the persistently-mapped staging ring buffer, and the largest suballocation it will
+// serve. Uploads above the threshold (or arriving when reclamation hasn't caught up) fall back
+// to discrete stages, so these only need to cover the steady-state streaming workload.
+static constexpr uint32_t RING_CAPACITY = 8 * 1024 * 1024;
+static constexpr uint32_t RING_MAX_ALLOCATION = RING_CAPACITY / 8;
+
+// Covers optimalBufferCopyOffsetAlignment and nonCoherentAtomSize on every device we care
+// about, so segments can be flushed and copied from without overlapping their neighbors.
+static constexpr uint32_t RING_ALIGNMENT = 256;
+
 namespace filament::backend {
 
 void VulkanStagePool::initialize(VmaAllocator allocator, VulkanCommands* commands) noexcept {
@@ -68,6 +78,67 @@ VulkanStage const* VulkanStagePool::acquireStage(uint32_t numBytes) {
     return stage;
 }
 
+void VulkanStagePool::createRing() noexcept {
+    VkBufferCreateInfo bufferInfo {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size = RING_CAPACITY,
+        .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+    };
+    VmaAllocationCreateInfo allocInfo {
+        .flags = VMA_ALLOCATION_CREATE_MAPPED_BIT,
+        .usage = VMA_MEMORY_USAGE_CPU_ONLY,
+    };
+    VmaAllocationInfo info = {};
+    UTILS_UNUSED_IN_RELEASE VkResult result = vmaCreateBuffer(mAllocator, &bufferInfo,
+            &allocInfo, &mRingBuffer, &mRingMemory, &info);
+    mRingMapping = info.pMappedData;
+
+#if FVK_ENABLED(FVK_DEBUG_ALLOCATION)
+    if (result != VK_SUCCESS) {
+        utils::slog.e << "Staging ring allocation error: " << result << utils::io::endl;
+    }
+#endif
+}
+
+bool VulkanStagePool::acquireSegment(uint32_t numBytes, VulkanStageSegment* segment) noexcept {
+    uint32_t const alignedBytes = (numBytes + RING_ALIGNMENT - 1) & ~(RING_ALIGNMENT - 1);
+    if (UTILS_UNLIKELY(alignedBytes > RING_MAX_ALLOCATION)) {
+        return false;
+    }
+    if (UTILS_UNLIKELY(mRingBuffer == VK_NULL_HANDLE)) {
+        createRing();
+    }
+    if (UTILS_UNLIKELY(mRingMapping == nullptr)) {
+        return false;
+    }
+
+    // Wrap around when the space between the head and the end of the ring is too small; the
+    // skipped tail bytes are accounted as used so reclamation stays strictly FIFO.
+    uint32_t head = mRingHead;
+    uint32_t waste = 0;
+    if (head + alignedBytes > RING_CAPACITY) {
+        waste = RING_CAPACITY - head;
+        head = 0;
+    }
+    if (mRingUsed + waste + alignedBytes > RING_CAPACITY) {
+        // The oldest segments are still potentially in flight on the GPU.
+        return false;
+    }
+
+    mRingUsed += waste + alignedBytes;
+    mRingPerFrameBytes[0] += waste + alignedBytes;
+    mRingHead = head + alignedBytes;
+
+    segment->buffer = mRingBuffer;
+    segment->offset = head;
+    segment->mapping = static_cast<char*>(mRingMapping) + head;
+    return true;
+}
+
+void VulkanStagePool::flushSegment(VulkanStageSegment const& segment, uint32_t numBytes) noexcept {
+    vmaFlushAllocation(mAllocator, mRingMemory, segment.offset, numBytes);
+}
+
 VulkanStageImage const* VulkanStagePool::acquireImage(PixelDataFormat format, PixelDataType type,
         uint32_t width, uint32_t height) {
     const VkFormat vkformat = getVkFormat(format, type);
@@ -138,6 +209,16 @@ void VulkanStagePool::gc() noexcept {
     }
     const uint64_t evictionTime = mCurrentFrame - TIME_BEFORE_EVICTION;
 
+    // Reclaim the oldest frame's worth of staging ring segments; anything suballocated
+    // TIME_BEFORE_EVICTION frames ago can no longer be referenced by a command buffer.
+    uint32_t const reclaimed = mRingPerFrameBytes[TIME_BEFORE_EVICTION - 1];
+    assert_invariant(mRingUsed >= reclaimed);
+    mRingUsed -= reclaimed;
+    for (uint32_t i = TIME_BEFORE_EVICTION - 1; i > 0; i--) {
+        mRingPerFrameBytes[i] = mRingPerFrameBytes[i - 1];
+    }
+    mRingPerFrameBytes[0] = 0;
+
     // Destroy buffers that have not been used for several frames.
     decltype(mFreeStages) freeStages;
     freeStages.swap(mFreeStages);
@@ -212,6 +293,15 @@ void VulkanStagePool::terminate() noexcept {
         delete image;
     }
     mFreeStages.clear();
+
+    if (mRingBuffer) {
+        // The persistent mapping is released by vmaDestroyBuffer (the allocation was created
+        // with VMA_ALLOCATION_CREATE_MAPPED_BIT).
+        vmaDestroyBuffer(mAllocator, mRingBuffer, mRingMemory);
+        mRingBuffer = VK_NULL_HANDLE;
+        mRingMemory = VK_NULL_HANDLE;
+        mRingMapping = nullptr;
+    }
 }
 
 } // namespace filament::backend
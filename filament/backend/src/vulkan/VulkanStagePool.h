@@ -41,6 +41,15 @@ struct VulkanStageImage {
     VkImage image;
 };
 
+// A suballocation out of the persistently-mapped staging ring buffer. Unlike VulkanStage,
+// acquiring one of these performs no Vulkan calls: the caller just writes through "mapping"
+// and copies from "buffer" at "offset".
+struct VulkanStageSegment {
+    VkBuffer buffer;
+    uint32_t offset;
+    void* mapping;
+};
+
 // Manages a pool of stages, periodically releasing stages that have been unused for a while.
 // This class manages two types of host-mappable staging areas: buffer stages and image stages.
 class VulkanStagePool {
@@ -51,6 +60,16 @@ public:
     // The stage is automatically released back to the pool after TIME_BEFORE_EVICTION frames.
     VulkanStage const* acquireStage(uint32_t numBytes);
 
+    // Suballocates the given number of bytes out of the persistently-mapped staging ring
+    // buffer, which avoids both a vmaCreateBuffer and a map/unmap round trip per upload.
+    // Returns false when the request is too large for the ring or reclamation hasn't caught
+    // up, in which case the caller should fall back to acquireStage(). The segment's bytes
+    // are reclaimed TIME_BEFORE_EVICTION frames later, like stages.
+    bool acquireSegment(uint32_t numBytes, VulkanStageSegment* segment) noexcept;
+
+    // Flushes CPU writes to a segment (the ring's memory may be non-coherent).
+    void flushSegment(VulkanStageSegment const& segment, uint32_t numBytes) noexcept;
+
     // Images have VK_IMAGE_LAYOUT_GENERAL and must not be transitioned to any other layout
     VulkanStageImage const* acquireImage(PixelDataFormat format, PixelDataType type,
             uint32_t width, uint32_t height);
@@ -63,9 +82,23 @@ public:
     void terminate() noexcept;
 
 private:
+    void createRing() noexcept;
+
     VmaAllocator mAllocator;
     VulkanCommands* mCommands;
 
+    // The staging ring buffer, created lazily on first use and mapped for its entire
+    // lifetime. mRingHead is the next write offset and mRingUsed the bytes not yet
+    // reclaimed; bytes suballocated during a given frame are recorded in
+    // mRingPerFrameBytes[0] and reclaimed in FIFO order once the slot ages out, which is
+    // when no command buffer can still be reading them.
+    VkBuffer mRingBuffer = VK_NULL_HANDLE;
+    VmaAllocation mRingMemory = VK_NULL_HANDLE;
+    void* mRingMapping = nullptr;
+    uint32_t mRingHead = 0;
+    uint32_t mRingUsed = 0;
+    uint32_t mRingPerFrameBytes[FVK_MAX_COMMAND_BUFFERS] = {};
+
     // Use an ordered multimap for quick (capacity => stage) lookups using lower_bound().
     std::multimap<uint32_t, VulkanStage const*> mFreeStages;
 
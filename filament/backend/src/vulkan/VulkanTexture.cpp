@@ -139,6 +139,16 @@ VulkanTexture::VulkanTexture(VkDevice device, VkPhysicalDevice physicalDevice,
         }
     }
 
+    if (any(usage & TextureUsage::MEMORYLESS)) {
+        // Transient attachments may only carry attachment usages; their contents never leave
+        // tile memory, so the transfer/sampled bits are unnecessary anyway. Callers guarantee
+        // that a MEMORYLESS texture is never sampled, uploaded or blitted.
+        imageInfo.usage &= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+                VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT |
+                VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+        imageInfo.usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+    }
+
     // Constrain the sample count according to the sample count masks in VkPhysicalDeviceProperties.
     // Note that VulkanRenderTarget holds a single MSAA count, so we play it safe if this is used as
     // any kind of attachment (color or depth).
@@ -180,8 +190,18 @@ VulkanTexture::VulkanTexture(VkDevice device, VkPhysicalDevice physicalDevice,
     VkMemoryRequirements memReqs = {};
     vkGetImageMemoryRequirements(mDevice, mTextureImage, &memReqs);
 
-    uint32_t memoryTypeIndex
-            = context.selectMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    uint32_t memoryTypeIndex = VK_MAX_MEMORY_TYPES;
+    if (imageInfo.usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) {
+        // Prefer lazily-allocated memory for transient attachments; tile-based GPUs never
+        // commit main memory for these. Fall back to a regular device-local allocation when
+        // no such memory type exists (i.e. on most immediate-mode GPUs).
+        memoryTypeIndex = context.selectMemoryType(memReqs.memoryTypeBits,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT);
+    }
+    if (memoryTypeIndex >= VK_MAX_MEMORY_TYPES) {
+        memoryTypeIndex = context.selectMemoryType(memReqs.memoryTypeBits,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    }
 
     ASSERT_POSTCONDITION(memoryTypeIndex < VK_MAX_MEMORY_TYPES,
             "VulkanTexture: unable to find a memory type that meets requirements.");
@@ -244,6 +264,154 @@ VulkanTexture::~VulkanTexture() {
     for (auto entry : mCachedImageViews) {
         vkDestroyImageView(mDevice, entry.second, VKALLOC);
     }
+    // By the time a texture is destroyed, the resource tracker has guaranteed that no command
+    // buffer still references it, so retired backings can be destroyed unconditionally.
+    for (auto const& retired : mRetiredBackings) {
+        for (VkImageView view : retired.views) {
+            vkDestroyImageView(mDevice, view, VKALLOC);
+        }
+        if (retired.memory != VK_NULL_HANDLE) {
+            vkDestroyImage(mDevice, retired.image, VKALLOC);
+            vkFreeMemory(mDevice, retired.memory, VKALLOC);
+        }
+    }
+}
+
+bool VulkanTexture::attachExternalMemory(VulkanContext const& context, int fd, uint32_t width,
+        uint32_t height, VkFormat format, uint64_t allocationSize) {
+    // Reclaim backings whose last referencing command buffer has finished on the GPU. Fences
+    // signal in submission order on the queue, so VK_SUCCESS on the recorded fence implies that
+    // all earlier work referencing the backing has retired too.
+    for (auto it = mRetiredBackings.begin(); it != mRetiredBackings.end();) {
+        if (it->fence->status.load(std::memory_order_relaxed) == VK_SUCCESS) {
+            for (VkImageView view : it->views) {
+                vkDestroyImageView(mDevice, view, VKALLOC);
+            }
+            if (it->memory != VK_NULL_HANDLE) {
+                vkDestroyImage(mDevice, it->image, VKALLOC);
+                vkFreeMemory(mDevice, it->memory, VKALLOC);
+            }
+            it = mRetiredBackings.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // External frames are single-level, single-layer 2D images with linear tiling, which is
+    // what dma-buf producers (video decoders, camera stacks) hand out.
+    VkExternalMemoryImageCreateInfo const externalInfo{
+            .sType = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_IMAGE_CREATE_INFO,
+            .handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT,
+    };
+    VkImageCreateInfo const imageInfo{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+            .pNext = &externalInfo,
+            .imageType = VK_IMAGE_TYPE_2D,
+            .format = format,
+            .extent = {width, height, 1},
+            .mipLevels = 1,
+            .arrayLayers = 1,
+            .samples = VK_SAMPLE_COUNT_1_BIT,
+            .tiling = VK_IMAGE_TILING_LINEAR,
+            .usage = VK_IMAGE_USAGE_SAMPLED_BIT,
+    };
+    VkImage image;
+    VkResult error = vkCreateImage(mDevice, &imageInfo, VKALLOC, &image);
+    if (error) {
+        utils::slog.w << "Unable to create image for external memory import, error=" << error
+                      << utils::io::endl;
+        return false;
+    }
+
+    VkMemoryFdPropertiesKHR fdProperties{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_FD_PROPERTIES_KHR,
+    };
+    error = vkGetMemoryFdPropertiesKHR(mDevice, VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT,
+            fd, &fdProperties);
+    VkMemoryRequirements memReqs = {};
+    vkGetImageMemoryRequirements(mDevice, image, &memReqs);
+    uint32_t memoryTypeBits = memReqs.memoryTypeBits;
+    if (!error) {
+        memoryTypeBits &= fdProperties.memoryTypeBits;
+    }
+    uint32_t const memoryTypeIndex = context.selectMemoryType(memoryTypeBits, 0);
+    if (memoryTypeIndex >= VK_MAX_MEMORY_TYPES) {
+        vkDestroyImage(mDevice, image, VKALLOC);
+        return false;
+    }
+
+    // The import takes ownership of the fd on success, and many drivers require a dedicated
+    // allocation for imported images.
+    VkMemoryDedicatedAllocateInfo const dedicatedInfo{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO,
+            .image = image,
+    };
+    VkImportMemoryFdInfoKHR const importInfo{
+            .sType = VK_STRUCTURE_TYPE_IMPORT_MEMORY_FD_INFO_KHR,
+            .pNext = &dedicatedInfo,
+            .handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT,
+            .fd = fd,
+    };
+    VkMemoryAllocateInfo const allocInfo{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+            .pNext = &importInfo,
+            .allocationSize = std::max(allocationSize, (uint64_t) memReqs.size),
+            .memoryTypeIndex = memoryTypeIndex,
+    };
+    VkDeviceMemory memory;
+    error = vkAllocateMemory(mDevice, &allocInfo, nullptr, &memory);
+    if (error) {
+        utils::slog.w << "Unable to import external memory, error=" << error << utils::io::endl;
+        vkDestroyImage(mDevice, image, VKALLOC);
+        return false;
+    }
+    error = vkBindImageMemory(mDevice, image, memory, 0);
+    if (error) {
+        vkDestroyImage(mDevice, image, VKALLOC);
+        vkFreeMemory(mDevice, memory, VKALLOC);
+        return false;
+    }
+
+    VulkanCommandBuffer& commands = mCommands->get();
+    commands.acquire(this);
+
+    // Retire the old backing along with its cached views. If this texture wraps an image it
+    // does not own (mTextureImageMemory is null), only the views are retired.
+    RetiredBacking retired{
+            .image = mTextureImage,
+            .memory = mTextureImageMemory,
+            .fence = commands.fence,
+    };
+    retired.views.reserve(mCachedImageViews.size());
+    for (auto entry : mCachedImageViews) {
+        retired.views.push_back(entry.second);
+    }
+    mCachedImageViews.clear();
+    mRetiredBackings.push_back(std::move(retired));
+
+    // Forget the old backing's layouts before the ranges are rewritten below.
+    setLayout(mFullViewRange, VulkanLayout::UNDEFINED);
+
+    mTextureImage = image;
+    mTextureImageMemory = memory;
+    mVkFormat = format;
+    this->width = width;
+    this->height = height;
+    this->depth = 1;
+
+    mFullViewRange = {
+        .aspectMask = getImageAspect(),
+        .baseMipLevel = 0,
+        .levelCount = 1,
+        .baseArrayLayer = 0,
+        .layerCount = 1,
+    };
+    mPrimaryViewRange = mFullViewRange;
+
+    // Recreate the primary image view and make the imported frame sampleable.
+    getImageView(mPrimaryViewRange, mViewType, mSwizzle);
+    transitionLayout(commands.buffer(), mFullViewRange, VulkanLayout::READ_ONLY);
+    return true;
 }
 
 void VulkanTexture::updateImage(const PixelBufferDescriptor& data, uint32_t width, uint32_t height,
@@ -275,20 +443,39 @@ void VulkanTexture::updateImage(const PixelBufferDescriptor& data, uint32_t widt
     assert_invariant(hostData->size > 0 && "Data is empty");
 
     // Otherwise, use vkCmdCopyBufferToImage.
-    void* mapped = nullptr;
-    VulkanStage const* stage = mStagePool.acquireStage(hostData->size);
-    assert_invariant(stage->memory);
-    vmaMapMemory(mAllocator, stage->memory, &mapped);
-    memcpy(mapped, hostData->buffer, hostData->size);
-    vmaUnmapMemory(mAllocator, stage->memory);
-    vmaFlushAllocation(mAllocator, stage->memory, 0, hostData->size);
+    // Frequent small sub-region updates (e.g. terrain clipmap tiles) go through the
+    // persistently-mapped staging ring, which costs a memcpy and no Vulkan calls; larger
+    // uploads (or when the ring is exhausted) fall back to a discrete stage. The ring's
+    // segments are 256-byte aligned, which satisfies bufferOffset alignment only when the
+    // texel size divides 256, so oddly-sized texels (and compressed data) use the stage.
+    VkBuffer srcBuffer;
+    VkDeviceSize srcOffset = 0;
+    size_t const texelSize = (hostData->type == PixelDataType::COMPRESSED) ? 0 :
+            PixelBufferDescriptor::computeDataSize(hostData->format, hostData->type, 1, 1, 1);
+    VulkanStageSegment segment;
+    if (texelSize && (256 % texelSize) == 0 &&
+            mStagePool.acquireSegment(hostData->size, &segment)) {
+        memcpy(segment.mapping, hostData->buffer, hostData->size);
+        mStagePool.flushSegment(segment, hostData->size);
+        srcBuffer = segment.buffer;
+        srcOffset = segment.offset;
+    } else {
+        void* mapped = nullptr;
+        VulkanStage const* stage = mStagePool.acquireStage(hostData->size);
+        assert_invariant(stage->memory);
+        vmaMapMemory(mAllocator, stage->memory, &mapped);
+        memcpy(mapped, hostData->buffer, hostData->size);
+        vmaUnmapMemory(mAllocator, stage->memory);
+        vmaFlushAllocation(mAllocator, stage->memory, 0, hostData->size);
+        srcBuffer = stage->buffer;
+    }
 
     VulkanCommandBuffer& commands = mCommands->get();
     VkCommandBuffer const cmdbuf = commands.buffer();
     commands.acquire(this);
 
     VkBufferImageCopy copyRegion = {
-        .bufferOffset = {},
+        .bufferOffset = srcOffset,
         .bufferRowLength = {},
         .bufferImageHeight = {},
         .imageSubresource = {
@@ -301,6 +488,16 @@ void VulkanTexture::updateImage(const PixelBufferDescriptor& data, uint32_t widt
         .imageExtent = { width, height, depth }
     };
 
+    // Honor the host buffer's row stride and left/top skip, so a sub-rectangle of a larger
+    // client image (e.g. a clipmap region) uploads without a CPU repack; bufferRowLength = 0
+    // means tightly packed. The adjusted offset stays texel-aligned because the texel size
+    // divides both the segment alignment and the row length.
+    if (texelSize) {
+        size_t const rowLength = hostData->stride ? hostData->stride : size_t(width);
+        copyRegion.bufferRowLength = uint32_t(hostData->stride);
+        copyRegion.bufferOffset += (hostData->top * rowLength + hostData->left) * texelSize;
+    }
+
     VkImageSubresourceRange transitionRange = {
         .aspectMask = getImageAspect(),
         .baseMipLevel = miplevel,
@@ -331,7 +528,7 @@ void VulkanTexture::updateImage(const PixelBufferDescriptor& data, uint32_t widt
 
     transitionLayout(cmdbuf, transitionRange, newLayout);
 
-    vkCmdCopyBufferToImage(cmdbuf, stage->buffer, mTextureImage, newVkLayout, 1, &copyRegion);
+    vkCmdCopyBufferToImage(cmdbuf, srcBuffer, mTextureImage, newVkLayout, 1, &copyRegion);
 
     transitionLayout(cmdbuf, transitionRange, nextLayout);
 }
@@ -26,6 +26,7 @@
 #include <utils/RangeMap.h>
 
 #include <unordered_map>
+#include <vector>
 
 namespace filament::backend {
 
@@ -49,6 +50,15 @@ struct VulkanTexture : public HwTexture, VulkanResource {
     void updateImage(const PixelBufferDescriptor& data, uint32_t width, uint32_t height,
             uint32_t depth, uint32_t xoffset, uint32_t yoffset, uint32_t zoffset, uint32_t miplevel);
 
+    // Replaces the backing image with one imported zero-copy from a dma-buf
+    // (VK_EXT_external_memory_dma_buf). The texture object itself survives the swap, so handles
+    // and descriptor bindings stay valid; the previous backing image is retired and destroyed
+    // once every command buffer recorded against it has finished on the GPU. On success the
+    // implementation owns the fd. Returns false (leaving the texture untouched) if the import
+    // fails.
+    bool attachExternalMemory(VulkanContext const& context, int fd, uint32_t width,
+            uint32_t height, VkFormat format, uint64_t allocationSize);
+
     // Returns the primary image view, which is used for shader sampling.
     VkImageView getPrimaryImageView() {
         return getImageView(mPrimaryViewRange, mViewType, mSwizzle);
@@ -137,9 +147,19 @@ private:
     void updateImageWithBlit(const PixelBufferDescriptor& hostData, uint32_t width, uint32_t height,
             uint32_t depth, uint32_t miplevel);
 
+    // A backing image that was replaced by attachExternalMemory(). It is kept alive until the
+    // last command buffer recorded against it has retired, as observed through the fence.
+    struct RetiredBacking {
+        VkImage image;
+        VkDeviceMemory memory;
+        std::vector<VkImageView> views;
+        std::shared_ptr<VulkanCmdFence> fence;
+    };
+
     // The texture with the sidecar owns the sidecar.
     std::unique_ptr<VulkanTexture> mSidecarMSAA;
-    const VkFormat mVkFormat;
+    // Non-const only because attachExternalMemory() can adopt an external frame's format.
+    VkFormat mVkFormat;
     const VkImageViewType mViewType;
     const VkComponentMapping mSwizzle;
     VkImage mTextureImage = VK_NULL_HANDLE;
@@ -155,6 +175,7 @@ private:
     VkImageSubresourceRange mPrimaryViewRange;
 
     std::unordered_map<ImageViewKey, VkImageView, ImageViewHash> mCachedImageViews;
+    std::vector<RetiredBacking> mRetiredBackings;
     VulkanStagePool& mStagePool;
     VkDevice mDevice;
     VmaAllocator mAllocator;
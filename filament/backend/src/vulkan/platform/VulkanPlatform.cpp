@@ -186,6 +186,12 @@ ExtensionSet getDeviceExtensions(VkPhysicalDevice device) {
             VK_KHR_MAINTENANCE1_EXTENSION_NAME,
             VK_KHR_MAINTENANCE2_EXTENSION_NAME,
             VK_KHR_MAINTENANCE3_EXTENSION_NAME,
+            VK_KHR_EXTERNAL_MEMORY_FD_EXTENSION_NAME,
+            VK_EXT_EXTERNAL_MEMORY_DMA_BUF_EXTENSION_NAME,
+            VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME,
+            VK_KHR_PRESENT_ID_EXTENSION_NAME,
+            VK_KHR_PRESENT_WAIT_EXTENSION_NAME,
+            VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME,
     };
     ExtensionSet exts;
     // Identify supported physical device extensions
@@ -325,6 +331,46 @@ VkDevice createLogicalDevice(VkPhysicalDevice physicalDevice,
         deviceCreateInfo.pNext = &portability;
     }
 
+    // The extension guarantees that at least pipelineFragmentShadingRate is supported, which is
+    // all we use (per-pass rate, see RenderPassParams::shadingRate).
+    VkPhysicalDeviceFragmentShadingRateFeaturesKHR shadingRateFeatures = {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FRAGMENT_SHADING_RATE_FEATURES_KHR,
+            .pNext = const_cast<void*>(deviceCreateInfo.pNext),
+            .pipelineFragmentShadingRate = VK_TRUE,
+    };
+    if (deviceExtensions.find(VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME)
+            != deviceExtensions.end()) {
+        deviceCreateInfo.pNext = &shadingRateFeatures;
+    }
+
+    // VK_KHR_present_wait requires both the presentId and presentWait features.
+    VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures = {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR,
+            .pNext = const_cast<void*>(deviceCreateInfo.pNext),
+            .presentId = VK_TRUE,
+    };
+    VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures = {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR,
+            .pNext = &presentIdFeatures,
+            .presentWait = VK_TRUE,
+    };
+    if (deviceExtensions.find(VK_KHR_PRESENT_ID_EXTENSION_NAME) != deviceExtensions.end()
+            && deviceExtensions.find(VK_KHR_PRESENT_WAIT_EXTENSION_NAME)
+                    != deviceExtensions.end()) {
+        deviceCreateInfo.pNext = &presentWaitFeatures;
+    }
+
+    // Used by VulkanCommands to batch submissions and track their completion without fences.
+    VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineSemaphoreFeatures = {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR,
+            .pNext = const_cast<void*>(deviceCreateInfo.pNext),
+            .timelineSemaphore = VK_TRUE,
+    };
+    if (deviceExtensions.find(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME)
+            != deviceExtensions.end()) {
+        deviceCreateInfo.pNext = &timelineSemaphoreFeatures;
+    }
+
     VkResult result = vkCreateDevice(physicalDevice, &deviceCreateInfo, VKALLOC, &device);
     ASSERT_POSTCONDITION(result == VK_SUCCESS, "vkCreateDevice error.");
 
@@ -614,7 +660,13 @@ Driver* VulkanPlatform::createDriver(void* sharedContext,
 
     bluevk::bindInstance(mImpl->mInstance);
 
-    VulkanPlatform::Customization::GPUPreference const pref = getCustomization().gpu;
+    VulkanPlatform::Customization::GPUPreference pref = getCustomization().gpu;
+    if (pref.index < 0 && pref.deviceName.empty()) {
+        // No preference from the platform itself; fall back to the selection requested
+        // through Engine::Config, if any.
+        pref.index = driverConfig.gpuPreferenceIndex;
+        pref.deviceName = driverConfig.gpuPreferenceDeviceName;
+    }
     bool const hasGPUPreference = pref.index >= 0 || !pref.deviceName.empty();
     ASSERT_PRECONDITION(!(hasGPUPreference && sharedContext),
             "Cannot both share context and indicate GPU preference");
@@ -670,6 +722,16 @@ Driver* VulkanPlatform::createDriver(void* sharedContext,
             = instExts.find(VK_EXT_DEBUG_UTILS_EXTENSION_NAME) != instExts.end();
     context.mDebugMarkersSupported
             = deviceExts.find(VK_EXT_DEBUG_MARKER_EXTENSION_NAME) != deviceExts.end();
+    context.mExternalMemoryDmaBufSupported
+            = deviceExts.find(VK_KHR_EXTERNAL_MEMORY_FD_EXTENSION_NAME) != deviceExts.end()
+            && deviceExts.find(VK_EXT_EXTERNAL_MEMORY_DMA_BUF_EXTENSION_NAME) != deviceExts.end();
+    context.mFragmentShadingRateSupported
+            = deviceExts.find(VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME) != deviceExts.end();
+    context.mPresentWaitSupported
+            = deviceExts.find(VK_KHR_PRESENT_ID_EXTENSION_NAME) != deviceExts.end()
+            && deviceExts.find(VK_KHR_PRESENT_WAIT_EXTENSION_NAME) != deviceExts.end();
+    context.mTimelineSemaphoreSupported
+            = deviceExts.find(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME) != deviceExts.end();
 
     context.mDepthFormats = findAttachmentDepthFormats(mImpl->mPhysicalDevice);
 
@@ -713,6 +775,14 @@ VkResult VulkanPlatform::recreate(SwapChainPtr handle) {
     SWAPCHAIN_RET_FUNC(recreate, handle, )
 }
 
+int32_t VulkanPlatform::getSwapChainImageFd(SwapChainPtr handle, uint32_t index) {
+    SWAPCHAIN_RET_FUNC(getImageFd, handle, index)
+}
+
+uint64_t VulkanPlatform::getFrameLatencyNanos(SwapChainPtr handle) {
+    SWAPCHAIN_RET_FUNC(getLatencyNanos, handle, )
+}
+
 void VulkanPlatform::destroy(SwapChainPtr handle) {
     if (mImpl->mSurfaceSwapChains.erase(handle)) {
         delete static_cast<VulkanPlatformSurfaceSwapChain*>(handle);
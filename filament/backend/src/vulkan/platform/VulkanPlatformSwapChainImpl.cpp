@@ -29,14 +29,19 @@ namespace filament::backend {
 namespace {
 
 std::tuple<VkImage, VkDeviceMemory> createImageAndMemory(VulkanContext const& context,
-        VkDevice device, VkExtent2D extent, VkFormat format) {
+        VkDevice device, VkExtent2D extent, VkFormat format, bool exportable = false) {
     bool const isDepth = isVkDepthFormat(format);
     // Filament expects blit() to work with any texture, so we almost always set these usage flags.
     // TODO: investigate performance implications of setting these flags.
     VkImageUsageFlags const blittable
             = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    VkExternalMemoryImageCreateInfo const externalImageInfo{
+            .sType = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_IMAGE_CREATE_INFO,
+            .handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT,
+    };
     VkImageCreateInfo imageInfo{
             .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+            .pNext = exportable ? &externalImageInfo : nullptr,
             .imageType = VK_IMAGE_TYPE_2D,
             .format = format,
             .extent = {extent.width, extent.height, 1},
@@ -64,8 +69,13 @@ std::tuple<VkImage, VkDeviceMemory> createImageAndMemory(VulkanContext const& co
     ASSERT_POSTCONDITION(memoryTypeIndex < VK_MAX_MEMORY_TYPES,
             "VulkanPlatformSwapChainImpl: unable to find a memory type that meets requirements.");
 
+    VkExportMemoryAllocateInfo const exportAllocInfo{
+            .sType = VK_STRUCTURE_TYPE_EXPORT_MEMORY_ALLOCATE_INFO,
+            .handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT,
+    };
     VkMemoryAllocateInfo allocInfo = {
             .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+            .pNext = exportable ? &exportAllocInfo : nullptr,
             .allocationSize = memReqs.size,
             .memoryTypeIndex = memoryTypeIndex,
     };
@@ -110,12 +120,18 @@ void VulkanPlatformSwapChainImpl::destroy() {
     mSwapChainBundle.colors.clear();
 }
 
-VkImage VulkanPlatformSwapChainImpl::createImage(VkExtent2D extent, VkFormat format) {
-    auto [image, memory] = createImageAndMemory(mContext, mDevice, extent, format);
+VkImage VulkanPlatformSwapChainImpl::createImage(VkExtent2D extent, VkFormat format,
+        bool exportable) {
+    auto [image, memory] = createImageAndMemory(mContext, mDevice, extent, format, exportable);
     mMemory.insert({image, memory});
     return image;
 }
 
+int32_t VulkanPlatformSwapChainImpl::getImageFd(uint32_t index) {
+    // Only exportable headless swapchains can hand out their memory.
+    return -1;
+}
+
 VulkanPlatformSurfaceSwapChain::VulkanPlatformSurfaceSwapChain(VulkanContext const& context,
         VkPhysicalDevice physicalDevice, VkDevice device, VkQueue queue, VkInstance instance,
         VkSurfaceKHR surface, VkExtent2D fallbackExtent, uint64_t flags)
@@ -125,7 +141,9 @@ VulkanPlatformSurfaceSwapChain::VulkanPlatformSurfaceSwapChain(VulkanContext con
       mSurface(surface),
       mFallbackExtent(fallbackExtent),
       mUsesRGB((flags & backend::SWAP_CHAIN_CONFIG_SRGB_COLORSPACE) != 0),
-      mHasStencil((flags & backend::SWAP_CHAIN_HAS_STENCIL_BUFFER) != 0) {
+      mHasStencil((flags & backend::SWAP_CHAIN_HAS_STENCIL_BUFFER) != 0),
+      mMinimizeLatency((flags & backend::SWAP_CHAIN_CONFIG_MINIMIZE_LATENCY) != 0
+              && context.isPresentWaitSupported()) {
     assert_invariant(surface);
     create();
 }
@@ -263,6 +281,8 @@ VkResult VulkanPlatformSurfaceSwapChain::acquire(VkSemaphore clientSignal, uint3
     VkResult result = vkAcquireNextImageKHR(mDevice, mSwapchain, UINT64_MAX, clientSignal,
             VK_NULL_HANDLE, index);
 
+    mAcquireTime = std::chrono::steady_clock::now();
+
     // Users should be notified of a suboptimal surface, but it should not cause a cascade of
     // log messages or a loop of re-creations.
     if (result == VK_SUBOPTIMAL_KHR && !mSuboptimal) {
@@ -283,8 +303,34 @@ VkResult VulkanPlatformSurfaceSwapChain::present(uint32_t index, VkSemaphore fin
             .pSwapchains = &mSwapchain,
             .pImageIndices = &currentIndex,
     };
+
+#if defined(VK_KHR_present_wait)
+    uint64_t const presentId = mPresentId + 1;
+    VkPresentIdKHR const presentIdInfo{
+            .sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR,
+            .swapchainCount = 1,
+            .pPresentIds = &presentId,
+    };
+    if (mMinimizeLatency) {
+        mPresentId = presentId;
+        presentInfo.pNext = &presentIdInfo;
+    }
+#endif
+
     VkResult result = vkQueuePresentKHR(mQueue, &presentInfo);
 
+#if defined(VK_KHR_present_wait)
+    // Wait until the frame has actually reached the display. This bounds the queue depth at one
+    // frame and lets us measure the true acquire-to-display latency, at the cost of throughput.
+    if (mMinimizeLatency && (result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR)) {
+        constexpr uint64_t PRESENT_WAIT_TIMEOUT_NS = 100000000;// 100ms
+        vkWaitForPresentKHR(mDevice, mSwapchain, presentId, PRESENT_WAIT_TIMEOUT_NS);
+    }
+#endif
+
+    mLastFrameLatency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - mAcquireTime).count();
+
     // On Android Q and above, a suboptimal surface is always reported after screen rotation:
     // https://android-developers.googleblog.com/2020/02/handling-device-orientation-efficiently.html
     if (result == VK_SUBOPTIMAL_KHR && !mSuboptimal) {
@@ -315,7 +361,8 @@ VkResult VulkanPlatformSurfaceSwapChain::recreate() {
 VulkanPlatformHeadlessSwapChain::VulkanPlatformHeadlessSwapChain(VulkanContext const& context,
         VkDevice device, VkQueue queue, VkExtent2D extent, uint64_t flags)
     : VulkanPlatformSwapChainImpl(context, device, queue),
-      mCurrentIndex(0) {
+      mCurrentIndex(0),
+      mExportable((flags & backend::SWAP_CHAIN_CONFIG_EXPORTABLE_IMAGES) != 0) {
     mSwapChainBundle.extent = extent;
     mSwapChainBundle.colorFormat = (flags & backend::SWAP_CHAIN_CONFIG_SRGB_COLORSPACE) != 0
                                            ? VK_FORMAT_R8G8B8A8_SRGB
@@ -325,7 +372,7 @@ VulkanPlatformHeadlessSwapChain::VulkanPlatformHeadlessSwapChain(VulkanContext c
     images.reserve(HEADLESS_SWAPCHAIN_SIZE);
     images.resize(HEADLESS_SWAPCHAIN_SIZE);
     for (size_t i = 0; i < HEADLESS_SWAPCHAIN_SIZE; ++i) {
-        images[i] = createImage(extent, mSwapChainBundle.colorFormat);
+        images[i] = createImage(extent, mSwapChainBundle.colorFormat, mExportable);
     }
 
     bool const hasStencil = (flags & backend::SWAP_CHAIN_HAS_STENCIL_BUFFER) != 0;
@@ -349,6 +396,25 @@ VkResult VulkanPlatformHeadlessSwapChain::acquire(VkSemaphore clientSignal, uint
     return VK_SUCCESS;
 }
 
+int32_t VulkanPlatformHeadlessSwapChain::getImageFd(uint32_t index) {
+#if defined(VK_KHR_external_memory_fd)
+    if (!mExportable || index >= mSwapChainBundle.colors.size()) {
+        return -1;
+    }
+    // Each call creates a new fd; the caller owns it and is responsible for closing it.
+    VkMemoryGetFdInfoKHR const getFdInfo{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_GET_FD_INFO_KHR,
+            .memory = mMemory.at(mSwapChainBundle.colors[index]),
+            .handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT,
+    };
+    int fd = -1;
+    VkResult const result = vkGetMemoryFdKHR(mDevice, &getFdInfo, &fd);
+    return result == VK_SUCCESS ? fd : -1;
+#else
+    return -1;
+#endif
+}
+
 void VulkanPlatformHeadlessSwapChain::destroy() {
     // This is only ever called from the destructor since headless does not recreate.
     for (auto image: mSwapChainBundle.colors) {
@@ -23,6 +23,7 @@
 
 #include <bluevk/BlueVK.h>
 
+#include <chrono>
 #include <tuple>
 #include <unordered_map>
 
@@ -64,11 +65,21 @@ struct VulkanPlatformSwapChainImpl : public Platform::SwapChain {
         return false;
     }
 
+    // Non-virtual override-able method. Returns a POSIX fd referencing the memory of the given
+    // color image, or -1 if the swapchain's images are not exportable.
+    int32_t getImageFd(uint32_t index);
+
+    // Non-virtual override-able method. Returns the acquire-to-display latency of the last
+    // presented frame in nanoseconds, or 0 if unknown.
+    uint64_t getLatencyNanos() {
+        return 0;
+    }
+
 protected:
     // Non-virtual override-able method
     void destroy();
 
-    VkImage createImage(VkExtent2D extent, VkFormat format);
+    VkImage createImage(VkExtent2D extent, VkFormat format, bool exportable = false);
 
     VulkanContext const& mContext;
     VkDevice mDevice;
@@ -97,6 +108,11 @@ struct VulkanPlatformSurfaceSwapChain : public VulkanPlatformSwapChainImpl {
     // Non-virtual override-able method
     bool hasResized();
 
+    // Non-virtual override
+    uint64_t getLatencyNanos() {
+        return mLastFrameLatency;
+    }
+
 private:
     VkResult create();
 
@@ -110,6 +126,10 @@ private:
     bool mUsesRGB = false;
     bool mHasStencil = false;
     bool mSuboptimal;
+    bool mMinimizeLatency = false;
+    uint64_t mPresentId = 0;
+    uint64_t mLastFrameLatency = 0;
+    std::chrono::steady_clock::time_point mAcquireTime = {};
 };
 
 struct VulkanPlatformHeadlessSwapChain : public VulkanPlatformSwapChainImpl {
@@ -126,12 +146,16 @@ struct VulkanPlatformHeadlessSwapChain : public VulkanPlatformSwapChainImpl {
     // Non-virtual override
     VkResult present(uint32_t index, VkSemaphore finished);
 
+    // Non-virtual override
+    int32_t getImageFd(uint32_t index);
+
 protected:
     // Non-virtual override-able method
     void destroy();
 
 private:
     uint32_t mCurrentIndex;
+    bool mExportable;
 };
 
 }// namespace filament::backend
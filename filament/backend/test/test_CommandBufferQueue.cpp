@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "private/backend/CommandBufferQueue.h"
+
+#include <stddef.h>
+
+using namespace filament::backend;
+
+// White-box tests for the free-space accounting in CommandBufferQueue::releaseBuffer().
+// The invariant under test: after the consumer has released every slice the producer
+// accounted for, mFreeSpace must be back to exactly the buffer capacity -- never more.
+// The slices here replay the three wrap geometries the producer can hand down; their
+// pointers are only compared, never dereferenced, so it's fine to point some of them
+// past the end of the buffer the way a soft (non-mirrored) CircularBuffer does.
+class CommandBufferQueueTest : public ::testing::Test {
+protected:
+    static size_t getFreeSpace(CommandBufferQueue const& queue) {
+        return queue.mFreeSpace.load();
+    }
+
+    // emulates the producer side of flush(): account for a slice (plus bytes forfeited
+    // by a rewind) and publish it to the consumer.
+    static void consume(CommandBufferQueue& queue, size_t used, size_t skipped = 0) {
+        queue.mFreeSpace.fetch_sub(used + skipped);
+    }
+
+    static void release(CommandBufferQueue& queue, void* begin, void* end) {
+        queue.releaseBuffer({ begin, end });
+    }
+};
+
+// hard (mirrored) buffer: a slice can extend past the end through the mirror, and the
+// next slice starts exactly one capacity behind its end.
+TEST_F(CommandBufferQueueTest, ReleaseBufferMirrorWrap) {
+    CommandBufferQueue queue(4096, 65536, false);
+    size_t const capacity = queue.getCircularBuffer().size();
+    char* const base = static_cast<char*>(queue.getCircularBuffer().getTail());
+
+    consume(queue, capacity - 256);
+    release(queue, base, base + capacity - 256);
+
+    // this slice straddles the end of the buffer via the mirror; circularize() then
+    // brought the head back by exactly one capacity.
+    consume(queue, 512);
+    release(queue, base + capacity - 256, base + capacity + 256);
+
+    consume(queue, 1000);
+    release(queue, base + 256, base + 1256);
+
+    EXPECT_EQ(capacity, getFreeSpace(queue));
+}
+
+// rewind(): the producer wrapped early, forfeiting the bytes between the head and the
+// end of the buffer; releasing the first slice after the wrap must refund them.
+TEST_F(CommandBufferQueueTest, ReleaseBufferRewindWrap) {
+    CommandBufferQueue queue(4096, 65536, false);
+    size_t const capacity = queue.getCircularBuffer().size();
+    size_t const offset = queue.getCircularBuffer().getSteadySize() + 4096;
+    char* const base = static_cast<char*>(queue.getCircularBuffer().getTail());
+
+    // slice ends within [steady size, capacity]; the producer rewound, counting the
+    // remainder of the lap as used.
+    consume(queue, offset, capacity - offset);
+    release(queue, base, base + offset);
+    EXPECT_EQ(offset, getFreeSpace(queue));
+
+    consume(queue, 100);
+    release(queue, base, base + 100);
+
+    EXPECT_EQ(capacity, getFreeSpace(queue));
+}
+
+// soft (non-mirrored) buffer: circularize() only wraps once the head is past the end
+// of the buffer, so the last slice before the wrap ends beyond base + capacity and
+// nothing is forfeited. A refund here used to underflow and break the accounting.
+TEST_F(CommandBufferQueueTest, ReleaseBufferSoftWrap) {
+    CommandBufferQueue queue(4096, 65536, false);
+    size_t const capacity = queue.getCircularBuffer().size();
+    char* const base = static_cast<char*>(queue.getCircularBuffer().getTail());
+
+    consume(queue, capacity - 100);
+    release(queue, base, base + capacity - 100);
+
+    // allocation crossed the end of the buffer into the slack of the soft mapping
+    consume(queue, 150);
+    release(queue, base + capacity - 100, base + capacity + 50);
+
+    consume(queue, 200);
+    release(queue, base, base + 200);
+
+    EXPECT_LE(getFreeSpace(queue), capacity);
+    EXPECT_EQ(capacity, getFreeSpace(queue));
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -196,7 +196,8 @@ TEST_F(BackendTest, FeedbackLoops) {
             samplers.setSampler(0, { texture, sparams });
             auto sgroup =
                     api.createSamplerGroup(samplers.getSize(), utils::FixedSizeString<32>("Test"));
-            api.updateSamplerGroup(sgroup, samplers.toBufferDescriptor(api));
+            uint64_t const dirtyMask = samplers.getDirtyMask();
+            api.updateSamplerGroup(sgroup, samplers.toBufferDescriptor(api), dirtyMask);
             auto ubuffer = api.createBufferObject(sizeof(MaterialParams),
                     BufferObjectBinding::UNIFORM, BufferUsage::STATIC);
             api.makeCurrent(swapChain, swapChain);
@@ -337,7 +337,8 @@ TEST_F(BackendTest, UpdateImage2D) {
                 .filterMin = SamplerMinFilter::NEAREST_MIPMAP_NEAREST } });
 
         auto sgroup = api.createSamplerGroup(samplers.getSize(), utils::FixedSizeString<32>("Test"));
-        api.updateSamplerGroup(sgroup, samplers.toBufferDescriptor(api));
+        uint64_t const dirtyMask = samplers.getDirtyMask();
+        api.updateSamplerGroup(sgroup, samplers.toBufferDescriptor(api), dirtyMask);
 
         api.bindSamplers(0, sgroup);
 
@@ -423,7 +424,8 @@ TEST_F(BackendTest, UpdateImageSRGB) {
     sparams.filterMin = SamplerMinFilter::LINEAR_MIPMAP_NEAREST;
     samplers.setSampler(0, { texture, sparams });
     auto sgroup = api.createSamplerGroup(samplers.getSize(), utils::FixedSizeString<32>("Test"));
-    api.updateSamplerGroup(sgroup, samplers.toBufferDescriptor(api));
+    uint64_t const dirtyMask = samplers.getDirtyMask();
+    api.updateSamplerGroup(sgroup, samplers.toBufferDescriptor(api), dirtyMask);
 
     api.bindSamplers(0, sgroup);
 
@@ -495,7 +497,8 @@ TEST_F(BackendTest, UpdateImageMipLevel) {
     sparams.filterMin = SamplerMinFilter::LINEAR_MIPMAP_NEAREST;
     samplers.setSampler(0, { texture, sparams });
     auto sgroup = api.createSamplerGroup(samplers.getSize(), utils::FixedSizeString<32>("Test"));
-    api.updateSamplerGroup(sgroup, samplers.toBufferDescriptor(api));
+    uint64_t const dirtyMask = samplers.getDirtyMask();
+    api.updateSamplerGroup(sgroup, samplers.toBufferDescriptor(api), dirtyMask);
 
     api.bindSamplers(0, sgroup);
 
@@ -579,7 +582,8 @@ TEST_F(BackendTest, UpdateImage3D) {
     sparams.filterMin = SamplerMinFilter::LINEAR_MIPMAP_NEAREST;
     samplers.setSampler(0, { texture, sparams});
     auto sgroup = api.createSamplerGroup(samplers.getSize(), utils::FixedSizeString<32>("Test"));
-    api.updateSamplerGroup(sgroup, samplers.toBufferDescriptor(api));
+    uint64_t const dirtyMask = samplers.getDirtyMask();
+    api.updateSamplerGroup(sgroup, samplers.toBufferDescriptor(api), dirtyMask);
 
     api.bindSamplers(0, sgroup);
 
@@ -196,7 +196,8 @@ TEST_F(BackendTest, SetMinMaxLevel) {
         samplers.setSampler(0, { texture, samplerParams });
         backend::Handle<HwSamplerGroup> samplerGroup =
                 api.createSamplerGroup(1, utils::FixedSizeString<32>("Test"));
-        api.updateSamplerGroup(samplerGroup, samplers.toBufferDescriptor(api));
+        uint64_t const dirtyMask = samplers.getDirtyMask();
+        api.updateSamplerGroup(samplerGroup, samplers.toBufferDescriptor(api), dirtyMask);
         api.bindSamplers(0, samplerGroup);
 
         // Render a triangle to the screen, sampling from mip level 1.
@@ -115,7 +115,9 @@ TEST_F(BackendTest, RenderExternalImageWithoutSet) {
     samplers.setSampler(0, { texture, {} });
     backend::Handle<HwSamplerGroup> samplerGroup =
             getDriverApi().createSamplerGroup(1, utils::FixedSizeString<32>("Test"));
-    getDriverApi().updateSamplerGroup(samplerGroup, samplers.toBufferDescriptor(getDriverApi()));
+    uint64_t const dirtyMask = samplers.getDirtyMask();
+    getDriverApi().updateSamplerGroup(samplerGroup,
+            samplers.toBufferDescriptor(getDriverApi()), dirtyMask);
     getDriverApi().bindSamplers(0, samplerGroup);
 
     // Render a triangle.
@@ -237,7 +239,9 @@ TEST_F(BackendTest, RenderExternalImage) {
     samplers.setSampler(0, { texture, {} });
     backend::Handle<HwSamplerGroup> samplerGroup =
             getDriverApi().createSamplerGroup(1, utils::FixedSizeString<32>("Test"));
-    getDriverApi().updateSamplerGroup(samplerGroup, samplers.toBufferDescriptor(getDriverApi()));
+    uint64_t const dirtyMask = samplers.getDirtyMask();
+    getDriverApi().updateSamplerGroup(samplerGroup,
+            samplers.toBufferDescriptor(getDriverApi()), dirtyMask);
     getDriverApi().bindSamplers(0, samplerGroup);
 
     // Render a triangle.
@@ -20,11 +20,30 @@
 
 
 #include <filament/Box.h>
+#include <filament/Engine.h>
 #include <filament/Frustum.h>
+#include <filament/IndexBuffer.h>
+#include <filament/LightManager.h>
+#include <filament/RenderableManager.h>
+#include <filament/Scene.h>
+#include <filament/TransformManager.h>
+#include <filament/VertexBuffer.h>
+#include <filament/Viewport.h>
+
+#include "Allocators.h"
 #include "Culler.h"
+#include "Froxelizer.h"
+#include "RenderPass.h"
+
+#include "details/Engine.h"
+#include "details/Material.h"
+#include "details/Scene.h"
 
 #include <utils/Allocator.h>
+#include <utils/EntityManager.h>
+#include <utils/JobSystem.h>
 
+#include <algorithm>
 #include <vector>
 #include <random>
 
@@ -35,8 +54,6 @@ using namespace utils;
 
 class FilamentCullingFixture : public benchmark::Fixture {
 protected:
-    static constexpr size_t BATCH_SIZE = 512;
-
     Frustum frustum{};
     std::vector<float3> boxesCenter;
     std::vector<float3> boxesExtent;
@@ -45,12 +62,11 @@ protected:
 
 
 public:
-    FilamentCullingFixture() {
-
+    void SetUp(benchmark::State& state) override {
         std::default_random_engine gen; // NOLINT
         std::uniform_real_distribution<float> rand(-100.0f, 100.0f);
 
-        const size_t batch = BATCH_SIZE;
+        const size_t batch = state.range(0);
         frustum = Frustum{ mat4f::perspective(45.0f, 1.0f, 0.1f, 100.0f) };
 
         boxesCenter.resize(batch);
@@ -75,31 +91,250 @@ public:
         visibles = (Culler::result_type*)utils::aligned_alloc(batch * sizeof(*visibles), 32);
     }
 
-    ~FilamentCullingFixture() override {
+    void TearDown(benchmark::State&) override {
         utils::aligned_free(visibles);
+        visibles = nullptr;
+    }
+};
+
+BENCHMARK_DEFINE_F(FilamentCullingFixture, boxCulling)(benchmark::State& state) {
+    const size_t batch = state.range(0);
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            Culler::Test::intersects(visibles, frustum, boxesCenter.data(), boxesExtent.data(), batch);
+        }
+        benchmark::ClobberMemory();
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * batch);
+    }
+}
+
+BENCHMARK_DEFINE_F(FilamentCullingFixture, sphereCulling)(benchmark::State& state) {
+    const size_t batch = state.range(0);
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            Culler::Test::intersects(visibles, frustum, spheres.data(), batch);
+        }
+        benchmark::ClobberMemory();
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * batch);
+    }
+}
+
+BENCHMARK_REGISTER_F(FilamentCullingFixture, boxCulling)
+        ->RangeMultiplier(4)->Range(1024, 131072);
+BENCHMARK_REGISTER_F(FilamentCullingFixture, sphereCulling)
+        ->RangeMultiplier(4)->Range(1024, 131072);
+
+
+/*
+ * RenderPass command sorting at various draw counts. Command generation proper needs a live
+ * scene (see the FilamentSceneFixture benchmarks below for that path); the sort however
+ * dominates at high draw counts and can be reproduced exactly from random keys.
+ */
+class FilamentCommandSortFixture : public benchmark::Fixture {
+protected:
+    std::vector<RenderPass::Command> commands;
+    std::vector<RenderPass::Command> scratch;
+
+public:
+    void SetUp(benchmark::State& state) override {
+        std::default_random_engine gen; // NOLINT
+        std::uniform_int_distribution<uint64_t> rand;
+        commands.resize(state.range(0));
+        for (auto& command : commands) {
+            command.key = rand(gen);
+        }
+        scratch.resize(commands.size());
+    }
+
+    void TearDown(benchmark::State&) override {
+        commands = decltype(commands){};
+        scratch = decltype(scratch){};
+    }
+};
+
+BENCHMARK_DEFINE_F(FilamentCommandSortFixture, commandSort)(benchmark::State& state) {
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            // the copy is part of the measurement; it's O(n) against the sort's O(n log n)
+            std::copy(commands.begin(), commands.end(), scratch.begin());
+            std::sort(scratch.begin(), scratch.end());
+            benchmark::DoNotOptimize(scratch.data());
+        }
+        benchmark::ClobberMemory();
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK_REGISTER_F(FilamentCommandSortFixture, commandSort)
+        ->RangeMultiplier(4)->Range(1024, 65536);
+
+
+/*
+ * Scene-level benchmarks running against a real Engine on the NOOP backend, so the full
+ * CPU path (component managers, SoA gathering, froxelization) is exercised without a GPU.
+ * The scenes are generated procedurally from a fixed seed, which keeps runs reproducible
+ * and bisectable.
+ */
+class FilamentSceneFixture : public benchmark::Fixture {
+protected:
+    Engine* mEngine = nullptr;
+    Scene* mScene = nullptr;
+    VertexBuffer* mVertexBuffer = nullptr;
+    IndexBuffer* mIndexBuffer = nullptr;
+    std::vector<Entity> mEntities;
+
+    void createRenderables(size_t count) {
+        static float3 const positions[3] = {{ 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }};
+        static uint16_t const indices[3] = { 0, 1, 2 };
+
+        mVertexBuffer = VertexBuffer::Builder()
+                .vertexCount(3)
+                .bufferCount(1)
+                .attribute(VertexAttribute::POSITION, 0, VertexBuffer::AttributeType::FLOAT3)
+                .build(*mEngine);
+        mVertexBuffer->setBufferAt(*mEngine, 0, { positions, sizeof(positions) });
+
+        mIndexBuffer = IndexBuffer::Builder()
+                .indexCount(3)
+                .bufferType(IndexBuffer::IndexType::USHORT)
+                .build(*mEngine);
+        mIndexBuffer->setBuffer(*mEngine, { indices, sizeof(indices) });
+
+        MaterialInstance const* const mi =
+                downcast(mEngine)->getDefaultMaterial()->getDefaultInstance();
+
+        std::default_random_engine gen; // NOLINT
+        std::uniform_real_distribution<float> rand(-100.0f, 100.0f);
+
+        auto& em = EntityManager::get();
+        auto& tcm = mEngine->getTransformManager();
+        mEntities.reserve(mEntities.size() + count);
+        for (size_t i = 0; i < count; i++) {
+            Entity const entity = em.create();
+            tcm.create(entity, {},
+                    mat4f::translation(float3{ rand(gen), rand(gen), rand(gen) }));
+            RenderableManager::Builder(1)
+                    .boundingBox({{ -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f }})
+                    .material(0, mi)
+                    .geometry(0, RenderableManager::PrimitiveType::TRIANGLES,
+                            mVertexBuffer, mIndexBuffer, 0, 3)
+                    .build(*mEngine, entity);
+            mScene->addEntity(entity);
+            mEntities.push_back(entity);
+        }
+    }
+
+    void createLights(size_t count) {
+        std::default_random_engine gen; // NOLINT
+        std::uniform_real_distribution<float> rand(-50.0f, 50.0f);
+
+        auto& em = EntityManager::get();
+        mEntities.reserve(mEntities.size() + count);
+        for (size_t i = 0; i < count; i++) {
+            Entity const entity = em.create();
+            LightManager::Builder(LightManager::Type::POINT)
+                    .position({ rand(gen), rand(gen), rand(gen) })
+                    .intensity(10000.0f)
+                    .falloff(5.0f)
+                    .build(*mEngine, entity);
+            mScene->addEntity(entity);
+            mEntities.push_back(entity);
+        }
+    }
+
+public:
+    void SetUp(benchmark::State&) override {
+        mEngine = Engine::create(backend::Backend::NOOP);
+        mScene = mEngine->createScene();
+    }
+
+    void TearDown(benchmark::State&) override {
+        auto& em = EntityManager::get();
+        for (Entity const entity : mEntities) {
+            mEngine->destroy(entity);
+            em.destroy(entity);
+        }
+        mEntities.clear();
+        if (mVertexBuffer) {
+            mEngine->destroy(mVertexBuffer);
+            mVertexBuffer = nullptr;
+        }
+        if (mIndexBuffer) {
+            mEngine->destroy(mIndexBuffer);
+            mIndexBuffer = nullptr;
+        }
+        mEngine->destroy(mScene);
+        mScene = nullptr;
+        Engine::destroy(&mEngine);
     }
 };
 
-BENCHMARK_F(FilamentCullingFixture, boxCulling)(benchmark::State& state) {
+BENCHMARK_DEFINE_F(FilamentSceneFixture, scenePrepare)(benchmark::State& state) {
+    createRenderables(state.range(0));
+
+    FEngine& engine = *downcast(mEngine);
+    FScene* const scene = downcast(mScene);
+    JobSystem& js = engine.getJobSystem();
+
     {
         PerformanceCounters pc(state);
         for (auto _ : state) {
-            Culler::Test::intersects(visibles, frustum, boxesCenter.data(), boxesExtent.data(), BATCH_SIZE);
+            filament::ArenaScope rootArena(engine.getPerRenderPassAllocator());
+            scene->prepare(js, rootArena.getAllocator(), mat4{}, false);
         }
         benchmark::ClobberMemory();
         pc.stop();
-        state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
     }
 }
 
-BENCHMARK_F(FilamentCullingFixture, sphereCulling)(benchmark::State& state) {
+BENCHMARK_DEFINE_F(FilamentSceneFixture, froxelizeLights)(benchmark::State& state) {
+    createLights(state.range(0));
+
+    FEngine& engine = *downcast(mEngine);
+    FScene* const scene = downcast(mScene);
+    JobSystem& js = engine.getJobSystem();
+    backend::DriverApi& driver = engine.getDriverApi();
+
+    // gather the lights into the scene's LightSoa, and mimic the truncation that
+    // FView::prepareVisibleLights() performs before froxelization
+    filament::ArenaScope rootArena(engine.getPerRenderPassAllocator());
+    scene->prepare(js, rootArena.getAllocator(), mat4{}, false);
+    FScene::LightSoa& lightData = scene->getLightData();
+    lightData.resize(std::min(lightData.size(),
+            CONFIG_MAX_LIGHT_COUNT + FScene::DIRECTIONAL_LIGHTS_COUNT));
+
+    Viewport const viewport{ 0, 0, 1920, 1080 };
+    mat4f const projection = mat4f::perspective(45.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+    mat4f const viewMatrix; // identity
+
+    Froxelizer froxelizer(engine);
+    froxelizer.setOptions(5.0f, 100.0f);
+
     {
         PerformanceCounters pc(state);
         for (auto _ : state) {
-            Culler::Test::intersects(visibles, frustum, spheres.data(), BATCH_SIZE);
+            filament::ArenaScope arena(engine.getPerRenderPassAllocator());
+            froxelizer.prepare(driver, arena, viewport, projection, 0.1f, 100.0f);
+            froxelizer.froxelizeLights(engine, viewMatrix, lightData);
+            froxelizer.commit(driver);
         }
         benchmark::ClobberMemory();
         pc.stop();
-        state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
     }
+
+    froxelizer.terminate(driver);
 }
+
+BENCHMARK_REGISTER_F(FilamentSceneFixture, scenePrepare)
+        ->RangeMultiplier(4)->Range(1024, 65536);
+// the engine caps dynamic lights at CONFIG_MAX_LIGHT_COUNT, don't benchmark beyond that
+BENCHMARK_REGISTER_F(FilamentSceneFixture, froxelizeLights)
+        ->RangeMultiplier(4)->Range(16, 256);
@@ -105,6 +105,22 @@ public:
      */
     void setBuffer(Engine& engine, BufferDescriptor&& buffer, uint32_t byteOffset = 0);
 
+    /**
+     * Asynchronously copies a region of another BufferObject into this one.
+     *
+     * The copy is performed entirely on the GPU, without round-tripping the data through host
+     * memory, which makes it suitable for compacting or defragmenting buffers that are
+     * sub-allocated from a larger BufferObject. Source and destination regions must not overlap.
+     *
+     * @param engine Reference to the filament::Engine associated with this BufferObject.
+     * @param dstOffset Offset in bytes into this BufferObject
+     * @param src BufferObject to copy from, which can be this BufferObject itself
+     * @param srcOffset Offset in bytes into \p src
+     * @param size Number of bytes to copy
+     */
+    void copyFrom(Engine& engine, uint32_t dstOffset,
+            BufferObject const* src, uint32_t srcOffset, uint32_t size);
+
     /**
      * Returns the size of this BufferObject in elements.
      * @return The maximum capacity of the BufferObject.
@@ -479,6 +479,18 @@ public:
         friend class FColorGrading;
     };
 
+    /**
+     * Returns whether the color grading look-up table has finished baking.
+     *
+     * The look-up table is baked asynchronously when the ColorGrading object is created;
+     * using a ColorGrading object before it is ready stalls rendering until the bake
+     * completes. Applications animating grading parameters can keep using their previous
+     * ColorGrading object and swap to the new one once this returns true.
+     *
+     * @return true if the look-up table is ready, false if it is still baking
+     */
+    bool isReady() const noexcept;
+
 protected:
     // prevent heap allocation
     ~ColorGrading() = default;
@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//! \file
+
+#ifndef TNT_FILAMENT_COROUTINES_H
+#define TNT_FILAMENT_COROUTINES_H
+
+/**
+ * C++20 coroutine support for Filament's asynchronous operations.
+ *
+ * Filament itself is built as C++17, so everything in this header is header-only and only
+ * compiles when the including code is built with C++20 coroutine support; the engine never
+ * includes it. FILAMENT_HAS_COROUTINES tells whether the facilities below are available.
+ *
+ * Task<T> is a minimal, lazily-started coroutine type whose completion can itself be
+ * awaited, and awaitSignal() suspends a coroutine until a Fence signals (see
+ * Fence::onSignal()). Together they let asset-streaming code express load / decode /
+ * upload / activate chains as straight-line coroutines instead of nested callbacks:
+ *
+ *     Task<filament::Texture*> upload(filament::Engine& engine,
+ *             backend::CallbackHandler* handler, Asset const& asset) {
+ *         filament::Texture* texture = createAndSetImage(engine, asset);
+ *         filament::Fence* fence = engine.createFence();
+ *         co_await filament::awaitSignal(fence, handler);
+ *         engine.destroy(fence);
+ *         co_return texture;
+ *     }
+ *
+ * The CallbackHandler passed to awaitSignal() decides which thread the coroutine resumes
+ * on; it must be a thread that is allowed to call whatever engine APIs follow the
+ * co_await. Passing nullptr resumes directly on the backend thread that signals the
+ * Fence, which is only appropriate when the continuation is cheap and engine-free.
+ */
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#define FILAMENT_HAS_COROUTINES 1
+
+#include <filament/Fence.h>
+
+#include <backend/CallbackHandler.h>
+#include <backend/DriverEnums.h>
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+namespace filament {
+
+template<typename T>
+class Task;
+
+namespace internal {
+
+struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+    template<typename P>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept {
+        // resume whoever co_await'ed this task, by symmetric transfer
+        std::coroutine_handle<> const continuation = h.promise().continuation();
+        return continuation ? continuation : std::noop_coroutine();
+    }
+    void await_resume() const noexcept {}
+};
+
+class TaskPromiseBase {
+public:
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    FinalAwaiter final_suspend() noexcept { return {}; }
+
+    // Filament is typically built without exception support, so an exception escaping a
+    // coroutine is simply fatal, as it would be anywhere else in the engine.
+    void unhandled_exception() noexcept { std::terminate(); }
+
+    void setContinuation(std::coroutine_handle<> continuation) noexcept {
+        mContinuation = continuation;
+    }
+
+    std::coroutine_handle<> continuation() const noexcept { return mContinuation; }
+
+private:
+    std::coroutine_handle<> mContinuation;
+};
+
+template<typename T>
+class TaskPromise : public TaskPromiseBase {
+public:
+    Task<T> get_return_object() noexcept;
+    void return_value(T value) noexcept { mValue = std::move(value); }
+    T&& value() noexcept { return std::move(mValue); }
+private:
+    T mValue{};
+};
+
+template<>
+class TaskPromise<void> : public TaskPromiseBase {
+public:
+    Task<void> get_return_object() noexcept;
+    void return_void() noexcept {}
+    void value() noexcept {}
+};
+
+// Eager, self-destroying coroutine used by Task<>::launch() to run a task detached.
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+} // namespace internal
+
+/**
+ * A lightweight coroutine task producing a value of type T.
+ *
+ * A Task is lazy: the coroutine body doesn't start executing until the Task is co_await'ed
+ * (or launch()ed), so building a chain of Tasks allocates the frames but performs no work.
+ * Tasks are move-only and single-shot; the owner must keep a suspended Task alive until it
+ * completes, since destroying it doesn't cancel callbacks that would resume it.
+ */
+template<typename T = void>
+class Task {
+public:
+    using promise_type = internal::TaskPromise<T>;
+
+    Task() noexcept = default;
+
+    Task(Task&& rhs) noexcept : mHandle(std::exchange(rhs.mHandle, nullptr)) {}
+
+    Task& operator=(Task&& rhs) noexcept {
+        if (this != &rhs) {
+            if (mHandle) {
+                mHandle.destroy();
+            }
+            mHandle = std::exchange(rhs.mHandle, nullptr);
+        }
+        return *this;
+    }
+
+    Task(Task const&) = delete;
+    Task& operator=(Task const&) = delete;
+
+    ~Task() noexcept {
+        if (mHandle) {
+            mHandle.destroy();
+        }
+    }
+
+    //! Whether the coroutine has run to completion (an empty Task is considered done).
+    bool isDone() const noexcept { return !mHandle || mHandle.done(); }
+
+    /**
+     * Awaiting a Task starts it and suspends the awaiting coroutine until it completes;
+     * the co_await expression evaluates to the task's result.
+     */
+    auto operator co_await() noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> handle;
+            bool await_ready() const noexcept { return !handle || handle.done(); }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().setContinuation(awaiting);
+                return handle; // symmetric transfer: start executing the task now
+            }
+            T await_resume() noexcept { return handle.promise().value(); }
+        };
+        return Awaiter{ mHandle };
+    }
+
+    /**
+     * Starts the task detached: ownership of the coroutine frame is relinquished, the task
+     * runs to completion and frees itself, and its result (if any) is discarded. This is
+     * how a top-level chain is kicked off from non-coroutine code.
+     */
+    void launch() && noexcept {
+        [](Task task) -> internal::DetachedTask {
+            co_await std::move(task);
+        }(std::move(*this));
+    }
+
+private:
+    friend promise_type;
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept : mHandle(handle) {}
+    std::coroutine_handle<promise_type> mHandle;
+};
+
+namespace internal {
+
+template<typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>{ std::coroutine_handle<TaskPromise>::from_promise(*this) };
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>{ std::coroutine_handle<TaskPromise>::from_promise(*this) };
+}
+
+} // namespace internal
+
+/**
+ * Awaiter suspending a coroutine until a Fence signals (see Fence::onSignal()); the
+ * co_await expression evaluates to the terminal FenceStatus. The Fence is not consumed
+ * and still has to be destroyed by its owner, from a thread allowed to do so.
+ */
+class FenceAwaiter {
+public:
+    explicit FenceAwaiter(Fence* fence, backend::CallbackHandler* handler = nullptr) noexcept
+            : mFence(fence), mHandler(handler) {
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        // `this` lives in the awaiting coroutine's frame, so it's stable until resumption
+        mFence->onSignal(mHandler, [this, awaiting](Fence::FenceStatus const status) {
+            mStatus = status;
+            awaiting.resume();
+        });
+    }
+
+    Fence::FenceStatus await_resume() const noexcept { return mStatus; }
+
+private:
+    Fence* mFence;
+    backend::CallbackHandler* mHandler;
+    Fence::FenceStatus mStatus = Fence::FenceStatus::ERROR;
+};
+
+/**
+ * Suspends the calling coroutine until \p fence signals, resuming it through \p handler
+ * (or directly on the signaling backend thread if \p handler is nullptr).
+ */
+inline FenceAwaiter awaitSignal(Fence* fence,
+        backend::CallbackHandler* handler = nullptr) noexcept {
+    return FenceAwaiter{ fence, handler };
+}
+
+} // namespace filament
+
+#else // no C++20 coroutine support
+
+#define FILAMENT_HAS_COROUTINES 0
+
+#endif // __cpp_impl_coroutine
+
+#endif // TNT_FILAMENT_COROUTINES_H
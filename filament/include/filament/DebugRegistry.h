@@ -124,6 +124,29 @@ public:
     bool getProperty(const char* name, math::float4* v) const noexcept;
     /** @}*/
 
+    /**
+     * Get the value of a property as captured by the last frame snapshot
+     *
+     * Once a snapshot getter has been called at least once, the engine captures the value of
+     * every property at the beginning of each frame. Unlike getProperty(), values read from the
+     * same snapshot are coherent with one another -- they were captured together at a frame
+     * boundary -- so instrumentation tooling can poll a set of properties without racing the
+     * render loop. The first call enables capturing and may not return a value until a frame
+     * has elapsed.
+     *
+     * @param name Name of the property to get the value of
+     * @param v A pointer to a variable which will hold the result
+     * @return true if \p v was updated with the value from the last snapshot
+     * @{
+     */
+    bool getPropertySnapshot(const char* name, bool* v) const noexcept;
+    bool getPropertySnapshot(const char* name, int* v) const noexcept;
+    bool getPropertySnapshot(const char* name, float* v) const noexcept;
+    bool getPropertySnapshot(const char* name, math::float2* v) const noexcept;
+    bool getPropertySnapshot(const char* name, math::float3* v) const noexcept;
+    bool getPropertySnapshot(const char* name, math::float4* v) const noexcept;
+    /** @}*/
+
     struct DataSource {
         void const* data;
         size_t count;
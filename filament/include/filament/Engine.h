@@ -212,7 +212,11 @@ public:
          * This is typically set to minCommandBufferSizeMB * 3, so that up to 3 frames can be
          * batched-up at once.
          *
-         * This value affects the application's memory usage.
+         * This value affects the application's steady-state memory usage. An additional burst
+         * reserve of several times this size exists in virtual memory only; command floods
+         * (e.g. while loading a scene) spill into it instead of stalling the calling thread,
+         * and that memory is returned to the OS once the burst has drained. There is therefore
+         * no need to oversize this value to survive loading spikes.
          */
         uint32_t commandBufferSizeMB = FILAMENT_COMMAND_BUFFER_SIZE_IN_MB;
 
@@ -292,6 +296,38 @@ public:
          */
         size_t textureUseAfterFreePoolSize = 0;
 
+        /*
+         * Size in MiB of the frame graph's transient texture cache.
+         *
+         * Transient render targets (depth pyramid, bloom, SSAO buffers, etc.) are kept alive
+         * across frames up to this budget, so they can be re-used without being re-allocated.
+         * On memory-constrained devices this can be lowered to trade re-allocation cost for a
+         * smaller footprint.
+         *
+         * This value affects the application's memory usage.
+         */
+        uint32_t resourceAllocatorCacheSizeMB = 64;
+
+        /*
+         * Maximum age, measured in frames, of unused entries in the frame graph's transient
+         * texture cache. Older entries are destroyed during the per-frame cache maintenance.
+         *
+         * This value does not affect the application's peak memory usage.
+         */
+        uint32_t resourceAllocatorCacheMaxAge = 30;
+
+        /*
+         * Maximum number of shader programs kept resident in the graphics driver. Long-running
+         * sessions can accumulate one program per material variant used since launch, which
+         * pressures driver memory on some mobile GPUs. Above this ceiling, programs that
+         * haven't been used for a while are unloaded and transparently re-created from their
+         * cached binary the next time they're needed.
+         *
+         * 0 (the default) keeps all programs resident. Currently only respected by the OpenGL
+         * backend, and ignored when the driver doesn't support program binaries (e.g. ES2).
+         */
+        uint32_t residentShaderProgramLimit = 0;
+
         /*
          * The number of eyes to render when stereoscopic rendering is enabled. Supported values are
          * between 1 and Engine::getMaxStereoscopicEyes() (inclusive).
@@ -300,6 +336,65 @@ public:
          * @see Engine::getMaxStereoscopicEyes
          */
         uint8_t stereoscopicEyeCount = 2;
+
+        /*
+         * Path to an existing writable directory where the backend may persist its
+         * program/pipeline binary cache across runs, so subsequent launches start warm.
+         * Cached binaries carry their own driver identification and are dropped when stale.
+         *
+         * Ignored if the Platform provides its own blob cache (see Platform::setBlobFunc).
+         * The string is not copied and must remain valid until Engine::create() returns.
+         * nullptr (the default) disables on-disk caching.
+         */
+        const char* pipelineCacheDirectory = nullptr;
+
+        /*
+         * Selects the GPU used for rendering on systems that have several. The first device
+         * whose name contains gpuPreferenceDeviceName is selected when non-nullptr; otherwise
+         * gpuPreferenceIndex selects the device by enumeration order. -1 (the default) lets
+         * the backend pick the most capable device. Currently only respected by the Vulkan
+         * backend, and ignored when the Platform expresses its own GPU preference (see
+         * VulkanPlatform::Customization).
+         *
+         * To use several GPUs at once — e.g. to render independent Views on different
+         * devices — create one Engine per device from the same process; CPU-side work such
+         * as asset decode can then be shared between them.
+         *
+         * The string is not copied and must remain valid until Engine::create() returns.
+         */
+        int8_t gpuPreferenceIndex = -1;
+        const char* gpuPreferenceDeviceName = nullptr;
+
+        /*
+         * When false, no dedicated driver thread is started: backend commands run on the
+         * thread that calls Engine::execute(), which the application must then invoke
+         * regularly (typically once per frame), exactly as on single-threaded platforms.
+         * On CPUs with very few cores, the dedicated thread can cost more in scheduling
+         * churn than it buys in parallelism.
+         *
+         * Ignored on platforms without threading support (where the driver is always
+         * inline). Must be left enabled when using the asynchronous
+         * Engine::Builder::build(callback), which requires the driver thread.
+         *
+         * JobSystem workers are controlled separately, with jobSystemThreadCount above and
+         * JobSystem::setAffinityPolicy().
+         */
+        bool useDedicatedDriverThread = true;
+
+        /*
+         * Scheduling hints for the dedicated driver thread. The priority maps to the
+         * closest equivalent the platform offers; pinning the thread to a core keeps it
+         * from migrating but can be disabled when it interferes with the application's own
+         * affinity scheme. Both are ignored when useDedicatedDriverThread is false.
+         */
+        enum class ThreadPriority : uint8_t {
+            BACKGROUND,
+            NORMAL,
+            DISPLAY,        //!< elevated priority appropriate for rendering (the default)
+            URGENT_DISPLAY,
+        };
+        ThreadPriority driverThreadPriority = ThreadPriority::DISPLAY;
+        bool driverThreadAffinity = true;
     };
 
 
@@ -789,6 +884,21 @@ public:
       */
     void flush();
 
+    /**
+     * Kicks off asynchronous compilation of all shader variants of the given materials, ahead
+     * of their first use, using the backend's compiler thread pool when available.
+     *
+     * <p>This is typically called during a loading screen, so that pipelines are ready (or
+     * served from the persisted binary cache, see Config::pipelineCacheDirectory) by the time
+     * rendering starts, avoiding mid-frame compilation hitches.</p>
+     *
+     * @param materials array of materials to pre-compile, null entries are skipped
+     * @param count     number of entries in \p materials
+     *
+     * @see Material::compile
+     */
+    void prewarmPipelines(Material* const* materials, size_t count) noexcept;
+
     /**
      * Drains the user callback message queue and immediately execute all pending callbacks.
      *
@@ -799,6 +909,74 @@ public:
      */
     void pumpMessageQueues();
 
+    /**
+     * Writes all engine-internal trace spans recorded so far -- the main and driver threads,
+     * JobSystem workers and FrameGraph pass execution -- to a file in chrome://tracing
+     * (Perfetto) JSON format, then clears the recording.
+     *
+     * <p> Spans are buffered in fixed-size per-thread rings, so the file contains the most
+     * recent window of activity. This is only available on platforms without a native trace
+     * sink (e.g. desktop Linux and Windows); on Android spans go to ATrace instead and this
+     * call is a no-op. Call it between frames. </p>
+     *
+     * @param path path of the JSON file to write
+     * @return true if the file was written successfully
+     */
+    bool dumpTrace(const char* path) noexcept;
+
+    /**
+     * GPU memory used by the resources created through this Engine, attributed by owner type.
+     *
+     * The sizes are estimates computed from the resources' dimensions and formats -- what the
+     * engine asked the backend to allocate. Driver-internal overhead (pipelines, descriptor
+     * heaps, alignment padding) is not visible to the engine and is not included.
+     *
+     * @see getMemoryInfo(), setMemoryBudget()
+     */
+    struct MemoryInfo {
+        uint64_t textureBytes = 0;          //!< Texture objects, all levels and layers
+        uint64_t vertexBufferBytes = 0;     //!< VertexBuffer objects with internal storage
+        uint64_t indexBufferBytes = 0;      //!< IndexBuffer objects
+        uint64_t bufferObjectBytes = 0;     //!< BufferObject objects
+        uint64_t skinningBufferBytes = 0;   //!< SkinningBuffer objects
+        uint64_t morphTargetBufferBytes = 0;//!< MorphTargetBuffer objects
+        uint64_t transientBytes = 0;        //!< transient render targets, in use or cached (see
+                                            //!< Config::resourceAllocatorCacheSizeMB)
+        uint64_t totalBytes = 0;            //!< sum of all of the above
+        uint32_t textureCount = 0;          //!< number of Texture objects alive
+        uint32_t bufferCount = 0;           //!< number of buffer-like objects alive
+    };
+
+    /**
+     * Returns the per-owner-type breakdown of the GPU memory currently used by this Engine.
+     *
+     * This walks the engine's resource lists and must be called from the main thread. It is
+     * cheap enough for a HUD or a periodic telemetry sample, but not meant to be called many
+     * times per frame.
+     */
+    MemoryInfo getMemoryInfo() const noexcept;
+
+    /**
+     * Callback invoked when the engine's memory usage exceeds the budget set with
+     * setMemoryBudget().
+     */
+    using MemoryBudgetCallback = void(*)(void* user, MemoryInfo const& info);
+
+    /**
+     * Sets a soft GPU memory budget for this Engine.
+     *
+     * When the memory accounted by getMemoryInfo() exceeds \p budgetBytes, \p callback is
+     * invoked from the main thread at the end of the frame, so the application can reduce
+     * quality (e.g. drop texture resolution, trim caches) before the OS takes action. The
+     * callback fires once when the budget is crossed and is re-armed when usage falls back
+     * under the budget.
+     *
+     * @param budgetBytes soft budget in bytes, 0 disables the budget check
+     * @param callback    called when the budget is exceeded, nullptr disables it
+     * @param user        opaque pointer passed back to \p callback
+     */
+    void setMemoryBudget(uint64_t budgetBytes, MemoryBudgetCallback callback, void* user) noexcept;
+
     /**
      * Returns the default Material.
      *
@@ -853,7 +1031,8 @@ public:
     void* streamAlloc(size_t size, size_t alignment = alignof(double)) noexcept;
 
     /**
-      * Invokes one iteration of the render loop, used only on single-threaded platforms.
+      * Invokes one iteration of the render loop. Used only when there is no dedicated driver
+      * thread: on single-threaded platforms, or when Config::useDedicatedDriverThread is off.
       *
       * This should be called every time the windowing system needs to paint (e.g. at 60 Hz).
       */
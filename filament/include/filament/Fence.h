@@ -21,9 +21,11 @@
 
 #include <filament/FilamentAPI.h>
 
+#include <backend/CallbackHandler.h>
 #include <backend/DriverEnums.h>
 
 #include <utils/compiler.h>
+#include <utils/Invocable.h>
 
 namespace filament {
 
@@ -76,6 +78,52 @@ public:
      */
     static FenceStatus waitAndDestroy(Fence* fence, Mode mode = Mode::FLUSH);
 
+    /**
+     * Client-side wait on several Fences at once.
+     *
+     * Blocks the current thread until any one of \p fences signals, making it possible to
+     * multiplex several in-flight operations (e.g. streaming uploads) on a single waiting
+     * thread.
+     *
+     * @param fences        Array of \p count Fence objects to wait on. All fences must have
+     *                      been created from the same Engine. None of them may be destroyed
+     *                      before this call returns.
+     * @param count         Number of fences in the array. Must be at least 1.
+     * @param signaledIndex If non-null, set to the index of a signaled fence when
+     *                      FenceStatus::CONDITION_SATISFIED is returned.
+     * @param mode          Whether the command stream is flushed before waiting or not.
+     * @param timeout       Wait time out. Using a \p timeout of 0 is a way to query the state
+     *                      of the fences. A \p timeout value of FENCE_WAIT_FOR_EVER is used to
+     *                      disable the timeout.
+     * @return              FenceStatus::CONDITION_SATISFIED if at least one fence signaled,
+     *                      FenceStatus::TIMEOUT_EXPIRED if the time out expired or
+     *                      FenceStatus::ERROR in other cases.
+     */
+    static FenceStatus waitAny(Fence* const* fences, size_t count, size_t* signaledIndex,
+            Mode mode = Mode::FLUSH, uint64_t timeout = FENCE_WAIT_FOR_EVER);
+
+    /**
+     * Asynchronous completion notification.
+     *
+     * Registers a callback invoked once when the Fence signals, or immediately if it already
+     * has. The callback receives the terminal status of the Fence, either
+     * FenceStatus::CONDITION_SATISFIED or FenceStatus::ERROR (e.g. if the Fence was destroyed
+     * before signaling). This replaces a dedicated waiting thread when the completion should
+     * simply kick off follow-up work.
+     *
+     * At most one callback can be pending on a given Fence; registering a new one replaces
+     * the previous one, which is then never invoked. Use \c Engine::destroy(Fence*) rather
+     * than waitAndDestroy() to release the Fence; a pending callback is still delivered
+     * (with FenceStatus::ERROR if the Fence hadn't signaled yet).
+     *
+     * @param handler   Handler to dispatch the callback, or nullptr to invoke it directly on
+     *                  the backend thread that signals the Fence (it must be cheap in that
+     *                  case, as it delays command execution).
+     * @param callback  Callback called with the terminal status of the Fence.
+     */
+    void onSignal(backend::CallbackHandler* handler,
+            utils::Invocable<void(FenceStatus)>&& callback) noexcept;
+
 protected:
     // prevent heap allocation
     ~Fence() = default;
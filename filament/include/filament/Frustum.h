@@ -112,6 +112,12 @@ public:
 
 private:
     friend class Culler;
+    friend class FView;
+
+    // Creates a frustum directly from six plane equations, in the same order and encoding as
+    // getNormalizedPlanes(). Used to build the conservative culling frustum for stereo rendering.
+    explicit Frustum(math::float4 const planes[6]) noexcept;
+
     math::float4 mPlanes[6];
 };
 
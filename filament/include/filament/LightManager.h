@@ -324,6 +324,10 @@ public:
          * Renderable is a shadow caster.
          * Screen-space contact shadows are typically useful in large scenes.
          * (off by default)
+         *
+         * Contact shadows don't require a shadow map: a light that is not a shadow caster
+         * (see Builder::castShadows()) but has this option enabled gets short-range
+         * screen-space shadowing without the cost of a shadow map render and atlas slot.
          */
         bool screenSpaceContactShadows = false;
 
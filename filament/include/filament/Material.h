@@ -107,6 +107,17 @@ public:
          */
         Builder& package(const void* payload, size_t size);
 
+        /**
+         * Specifies material data that is trusted and valid for the lifetime of the Engine, such
+         * as a package compiled into the executable with resgen. Unlike package(), the data is
+         * referenced in place instead of being copied, and version verification is skipped.
+         *
+         * @param payload Pointer to the material data, must stay valid until the Material and the
+         *                Engine are destroyed.
+         * @param size Size of the material data pointed to by "payload" in bytes.
+         */
+        Builder& trustedPackage(const void* payload, size_t size);
+
         template<typename T>
         using is_supported_constant_parameter_t = typename std::enable_if<
                 std::is_same<int32_t, T>::value ||
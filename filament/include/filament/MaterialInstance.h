@@ -383,6 +383,21 @@ public:
      */
     bool isDepthCullingEnabled() const noexcept;
 
+    /**
+     * Enables or disables uniform deduplication for this instance (disabled by default).
+     *
+     * When enabled, instances of the same material whose uniform values are identical share a
+     * single GPU uniform buffer, which reduces both memory use and the number of buffer updates.
+     * Each parameter change then re-commits the whole uniform block, so deduplication is best
+     * suited to instances whose parameters rarely change after setup.
+     */
+    void setUniformDeduplicationEnabled(bool enabled) noexcept;
+
+    /**
+     * Returns whether uniform deduplication is enabled.
+     */
+    bool isUniformDeduplicationEnabled() const noexcept;
+
     /**
      * Overrides the default stencil-buffer write state that was set on the material.
      */
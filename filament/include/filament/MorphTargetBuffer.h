@@ -84,6 +84,10 @@ public:
      *
      * Both positions and tangents must be provided.
      *
+     * The buffer is initialized with zero deltas, and runs of zero deltas at the beginning and
+     * end of the given range are not uploaded, so sparse morph targets (e.g. facial rigs where
+     * each target displaces a small region of the mesh) only pay for the region they affect.
+     *
      * @param engine Reference to the filament::Engine associated with this MorphTargetBuffer.
      * @param targetIndex the index of morph target to be updated.
      * @param positions pointer to at least "count" positions
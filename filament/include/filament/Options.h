@@ -91,6 +91,14 @@ struct DynamicResolutionOptions {
      * The default upscaling quality is set to LOW.
      */
     QualityLevel quality = QualityLevel::LOW;
+
+    /**
+     * Number of consecutive frames the GPU must be under budget before the resolution is
+     * allowed to scale back up. Scaling down is never delayed. Larger values trade reaction
+     * speed for stability and suppress visible resolution "pumping" around the target frame
+     * time. 0 lets the controller scale up immediately.
+     */
+    uint8_t upscaleHoldFrameCount = 0;
 };
 
 /**
@@ -454,6 +462,13 @@ struct TemporalAntiAliasingOptions {
 
     bool preventFlickering = false;     //!< adjust the feedback dynamically to reduce flickering
     bool historyReprojection = true;    //!< whether to apply history reprojection (debug option)
+
+    /**
+     * Whether to use the TAA pass as a 2x temporal upscaler. The scene is rendered at half
+     * resolution in each dimension and the full resolution output is reconstructed from the
+     * temporal history. This supersedes dynamic resolution. [BETA]
+     */
+    bool upscaling = false;
 };
 
 /**
@@ -465,6 +480,12 @@ struct ScreenSpaceReflectionsOptions {
     float bias = 0.01f;         //!< bias, in world units, to prevent self-intersections
     float maxDistance = 3.0f;   //!< maximum distance, in world units, to raycast
     float stride = 2.0f;        //!< stride, in texels, for samples along the ray.
+    /**
+     * How each dimension of the reflections buffer is scaled. Must be either 0.5 or 1.0.
+     * At 0.5, the ray-marching pass runs at a quarter of its full-resolution cost; the
+     * temporal reprojection of the reflections hides most of the resolution loss.
+     */
+    float resolution = 1.0f;
     bool enabled = false;
 };
 
@@ -107,6 +107,17 @@ public:
      */
     size_t getComponentCount() const noexcept;
 
+    /**
+     * Pre-allocates internal storage for the given total number of components.
+     *
+     * Calling this before populating a large number of renderables (e.g. during level load)
+     * lets the per-entity Builder::build() calls run without growing the internal arrays,
+     * typically in combination with utils::EntityManager::create(n, entities).
+     *
+     * @param count total number of components to reserve storage for
+     */
+    void reserve(size_t count) noexcept;
+
     /**
      * @return true if the this manager has no components
      */
@@ -188,6 +199,31 @@ public:
         Builder& geometry(size_t index, PrimitiveType type, VertexBuffer* vertices, IndexBuffer* indices, size_t offset, size_t count) noexcept; //!< \overload
         Builder& geometry(size_t index, PrimitiveType type, VertexBuffer* vertices, IndexBuffer* indices) noexcept; //!< \overload
 
+        /**
+         * Declares a level-of-detail group for this renderable.
+         *
+         * A lod group is a contiguous range of the primitives declared with geometry(). When at
+         * least one group is declared, only the primitives of a single group are rendered each
+         * frame, selected from the renderable's estimated screen coverage -- the fraction of the
+         * viewport height covered by the renderable's bounding sphere. A group is used when the
+         * coverage is at least \p minCoverage and no more detailed group qualifies; the last
+         * group is used when no threshold is met, so its \p minCoverage is effectively zero.
+         *
+         * Groups must be declared with \p level 0 the most detailed, and with decreasing
+         * \p minCoverage thresholds. At most 4 groups are supported. Renderables without lod
+         * groups render all their primitives, as before.
+         *
+         * The selection happens during View preparation, where the renderable's bounds are
+         * already available; it adds no per-frame cost to the application.
+         *
+         * @param level zero-based index of the group, 0 being the most detailed
+         * @param primitiveOffset index of the first primitive of the group
+         * @param primitiveCount number of primitives in the group
+         * @param minCoverage minimum screen coverage needed to select this group, in [0, 1]
+         */
+        Builder& lodGroup(size_t level, size_t primitiveOffset, size_t primitiveCount,
+                float minCoverage) noexcept;
+
         /**
          * Binds a material instance to the specified primitive.
          *
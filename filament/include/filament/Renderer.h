@@ -23,11 +23,13 @@
 
 #include <utils/compiler.h>
 
+#include <backend/CallbackHandler.h>
 #include <backend/PresentCallable.h>
 #include <backend/DriverEnums.h>
 
 #include <math/vec4.h>
 
+#include <stddef.h>
 #include <stdint.h>
 
 namespace filament {
@@ -167,6 +169,70 @@ public:
      */
     void setFrameRateOptions(FrameRateOptions const& options) noexcept;
 
+    /**
+     * Enables or disables the thermal governor. Disabled by default.
+     *
+     * When enabled, the thermal status of the device is monitored and rendering quality is
+     * proactively reduced (dynamic-resolution ceiling, shadow map resolution, then MSAA)
+     * before the OS starts throttling, which typically sustains a higher frame-rate than
+     * letting the device hit its thermal cliff. Quality is restored progressively once the
+     * device cools down.
+     *
+     * This is only effective on platforms exposing a thermal status (currently Android).
+     */
+    void setThermalGovernorEnabled(bool enabled) noexcept;
+
+    /**
+     * Returns whether the thermal governor is enabled.
+     */
+    bool isThermalGovernorEnabled() const noexcept;
+
+    /**
+     * GPU and CPU timing of a single render pass, see getPassTimings().
+     *
+     * The cpu* fields count hardware PMU events on the thread that generated the pass's
+     * commands, between the start and the end of the pass's execute phase. They are zero on
+     * platforms without perf event access (anything but Linux / Android, or when the PMU is
+     * restricted by perf_event_paranoid).
+     */
+    struct PassTiming {
+        char name[32];              //!< pass name, truncated if needed, always null-terminated
+        uint64_t gpuTimeNs;         //!< GPU time spent in the pass, in nanoseconds
+        uint64_t cpuCycles;         //!< CPU cycles spent generating the pass's commands
+        uint64_t cpuL1DMisses;      //!< CPU data-cache misses while generating the commands
+        uint64_t cpuBranchMisses;   //!< CPU branch mispredictions while generating the commands
+    };
+
+    /**
+     * Enables or disables per-pass profiling. Disabled by default.
+     *
+     * When enabled, every render pass is bracketed with GPU timer queries, and with hardware
+     * PMU counter reads (cycles, cache misses, branch misses) on the thread generating the
+     * pass's commands. The results are made available a few frames later through
+     * getPassTimings(). This is intended for diagnostics in the field and has a small
+     * per-pass cost.
+     *
+     * Because time-elapsed queries can't nest on some backends (OpenGL), the whole-frame
+     * measurement used by dynamic resolution is suspended while profiling is active, so
+     * dynamic resolution holds its current scale.
+     */
+    void setPassProfilingEnabled(bool enabled) noexcept;
+
+    /**
+     * Returns whether per-pass profiling is enabled.
+     */
+    bool isPassProfilingEnabled() const noexcept;
+
+    /**
+     * Retrieves the per-pass timings of the most recent fully measured frame, in pass
+     * execution order. Only valid if setPassProfilingEnabled() was called a few frames ago.
+     *
+     * @param timings pointer to an array of at least count entries
+     * @param count   capacity of the timings array
+     * @return the number of passes measured; only min(count, passes) entries are written
+     */
+    size_t getPassTimings(PassTiming* timings, size_t count) const noexcept;
+
     /**
      * Set ClearOptions which are used at the beginning of a frame to clear or retain the
      * SwapChain content.
@@ -431,6 +497,33 @@ public:
      */
     void endFrame();
 
+    /**
+     * Starts a frame group, for applications driving several windows (one SwapChain each) from
+     * the same Engine.
+     *
+     * Within a frame group, endFrame() records and submits each window's command stream but
+     * defers its present. endFrameGroup() then issues all deferred presents back-to-back, so a
+     * present stall on one window (e.g. waiting for its vsync) overlaps the rendering of the
+     * other windows instead of serializing it.
+     *
+     * Each SwapChain may be submitted at most once per frame group. Per-window completion can
+     * be tracked with SwapChain::setFrameCompletedCallback().
+     *
+     * @see
+     * endFrameGroup(), beginFrame(), endFrame()
+     */
+    void beginFrameGroup() noexcept;
+
+    /**
+     * Presents all the frames submitted since beginFrameGroup() and closes the frame group.
+     *
+     * Presents are issued in submission order.
+     *
+     * @see
+     * beginFrameGroup()
+     */
+    void endFrameGroup();
+
 
     /**
      * Reads back the content of the provided RenderTarget.
@@ -522,6 +615,36 @@ public:
      */
     void renderStandaloneView(View const* view);
 
+    /**
+     * Renders a batch of standalone Views into their associated RenderTargets.
+     *
+     * This is equivalent to calling renderStandaloneView() for each View, except that the
+     * engine-wide state (lights, materials, ...) is uploaded once for the whole batch, and
+     * the frames are submitted to the backend without any synchronization in between, so
+     * the CPU encoding, backend execution and GPU work of consecutive frames overlap.
+     * This is intended for headless server-side rendering, where many frames sharing the
+     * same scene data are produced back to back.
+     *
+     * Readbacks issued against the Views' RenderTargets (e.g. readPixels()) are pipelined
+     * with the following frames and deliver their results through their own callbacks,
+     * there is no need to wait for the batch between frames.
+     *
+     * @param views    Array of Views to render. Each View must have a RenderTarget
+     *                 associated to it.
+     * @param count    Number of views in the array.
+     * @param handler  Handler to dispatch the callback, or nullptr for the default
+     *                 (the callback is then invoked on the backend thread).
+     * @param callback Called once the backend has processed every frame of the batch.
+     *                 May be nullptr if no notification is needed.
+     * @param user     User data passed to the callback.
+     *
+     * @attention
+     * renderStandaloneViews() must be called outside of beginFrame() / endFrame(), with
+     * the same threading requirements as renderStandaloneView().
+     */
+    void renderStandaloneViews(View const* const* views, size_t count,
+            backend::CallbackHandler* handler = nullptr,
+            void(*callback)(void* user) = nullptr, void* user = nullptr);
 
     /**
      * Returns the time in second of the last call to beginFrame(). This value is constant for all
@@ -24,6 +24,8 @@
 #include <utils/compiler.h>
 #include <utils/Invocable.h>
 
+#include <stdint.h>
+
 namespace utils {
     class Entity;
 } // namespace utils
@@ -120,6 +122,22 @@ public:
      */
     void addEntities(const utils::Entity* entities, size_t count);
 
+    /**
+     * Adds a list of entities to a partition of the Scene.
+     *
+     * A partition groups entities that are streamed in and out together, e.g. a world
+     * chunk. The entities of a partition are kept contiguous when the Scene is prepared
+     * for rendering, which allows culling to reject a whole partition by bounds before
+     * the per-renderable tests, and removePartition() removes all of them at once.
+     *
+     * Entities added with addEntity() or addEntities() belong to partition 0.
+     *
+     * @param entities Array containing entities to add to the scene.
+     * @param count Size of the entity array.
+     * @param partition An arbitrary partition id chosen by the application.
+     */
+    void addEntities(const utils::Entity* entities, size_t count, uint32_t partition);
+
     /**
      * Removes the Renderable from the Scene.
      *
@@ -139,6 +157,16 @@ public:
      */
     void removeEntities(const utils::Entity* entities, size_t count);
 
+    /**
+     * Removes all entities of a partition from the Scene.
+     *
+     * Unlike removeEntities(), the cost doesn't depend on the size of the rest of the
+     * Scene. If the specified \p partition doesn't exist, this call is ignored.
+     *
+     * @param partition The partition id passed to addEntities().
+     */
+    void removePartition(uint32_t partition);
+
     /**
      * Returns the total number of Entities in the Scene, whether alive or not.
      * @return Total number of Entities in the Scene.
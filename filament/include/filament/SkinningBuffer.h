@@ -90,6 +90,11 @@ public:
 
     /**
      * Updates the bone transforms in the range [offset, offset + count).
+     *
+     * If the palette is identical to the one last set at the same offset, the update is
+     * skipped entirely; it is therefore cheap to call this every frame for skeletons that
+     * are often idle (e.g. crowds pooled in a single large SkinningBuffer).
+     *
      * @param engine Reference to the filament::Engine to associate this SkinningBuffer with.
      * @param transforms pointer to at least count Bone
      * @param count number of Bone elements in transforms
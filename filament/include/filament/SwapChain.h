@@ -226,6 +226,33 @@ public:
      */
     static constexpr uint64_t CONFIG_HAS_STENCIL_BUFFER = backend::SWAP_CHAIN_HAS_STENCIL_BUFFER;
 
+    /**
+     * Indicates that the images of a headless SwapChain should be allocated from external
+     * memory, so that they can be exported to other device-local consumers (e.g. CUDA) with
+     * getExportedImageFd(), without any CPU copy.
+     *
+     * This is only supported by the Vulkan backend, on platforms with
+     * VK_KHR_external_memory_fd. The flag is ignored for windowed SwapChains.
+     *
+     * @see getExportedImageFd()
+     */
+    static constexpr uint64_t CONFIG_EXPORTABLE_IMAGES =
+            backend::SWAP_CHAIN_CONFIG_EXPORTABLE_IMAGES;
+
+    /**
+     * Indicates that this SwapChain should minimize the latency between rendering a frame and
+     * that frame reaching the display, at the cost of throughput: after each present, Filament
+     * waits until the frame has actually reached the display, which caps the presentation queue
+     * depth at one frame. The measured latency can be queried with getFrameLatencyNanos().
+     *
+     * This is only supported by the Vulkan backend, on devices with VK_KHR_present_wait. The
+     * flag is ignored elsewhere.
+     *
+     * @see getFrameLatencyNanos()
+     */
+    static constexpr uint64_t CONFIG_MINIMIZE_LATENCY =
+            backend::SWAP_CHAIN_CONFIG_MINIMIZE_LATENCY;
+
     /**
      * Return whether createSwapChain supports the SWAP_CHAIN_CONFIG_SRGB_COLORSPACE flag.
      * The default implementation returns false.
@@ -237,6 +264,42 @@ public:
 
     void* getNativeWindow() const noexcept;
 
+    /**
+     * Export the memory backing one of this SwapChain's color images as a POSIX fd, suitable
+     * for import by another device-local API (e.g. cudaImportExternalMemory). Headless
+     * SwapChains have two images; rendering alternates between them, so a consumer typically
+     * imports both once and picks the image of the frame it was notified about.
+     *
+     * Only valid for headless SwapChains created with CONFIG_EXPORTABLE_IMAGES, on the Vulkan
+     * backend. Each call creates a new fd, owned by the caller. Frame completion should be
+     * tracked with setFrameCompletedCallback() before a consumer reads an image.
+     *
+     * This function is synchronous, so the SwapChain must exist on the backend when it is
+     * called; issue an Engine::flushAndWait() after creating the SwapChain.
+     *
+     * @param index index of the image, in [0, 2)
+     * @return the fd, or -1 if this SwapChain's images are not exportable.
+     *
+     * @see CONFIG_EXPORTABLE_IMAGES
+     */
+    int32_t getExportedImageFd(size_t index) noexcept;
+
+    /**
+     * Returns the acquire-to-display latency of the last presented frame, in nanoseconds.
+     *
+     * An accurate measurement requires this SwapChain to have been created with
+     * CONFIG_MINIMIZE_LATENCY, on the Vulkan backend with VK_KHR_present_wait; without it the
+     * measurement ends at present submission, and backends without support return 0.
+     *
+     * This function is synchronous, so it reflects the last frame the backend has actually
+     * presented, which may lag the last Renderer::endFrame() by a frame.
+     *
+     * @return the latency in nanoseconds, or 0 if unknown.
+     *
+     * @see CONFIG_MINIMIZE_LATENCY
+     */
+    uint64_t getFrameLatencyNanos() noexcept;
+
     /**
      * FrameScheduledCallback is a callback function that notifies an application when Filament has
      * completed processing a frame and that frame is ready to be scheduled for presentation.
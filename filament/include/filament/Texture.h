@@ -24,6 +24,7 @@
 #include <backend/PixelBufferDescriptor.h>
 
 #include <utils/compiler.h>
+#include <utils/Invocable.h>
 
 #include <stddef.h>
 
@@ -460,6 +461,53 @@ public:
      */
     void generateMipmaps(Engine& engine) const noexcept;
 
+    /**
+     * Like generateMipmaps(), but deferred: the request is queued and the engine issues a
+     * bounded number of pending mipmap generations per frame, so that streaming many textures
+     * in doesn't create a bursty GPU cost in any single frame. Until the request is processed
+     * (typically within a few frames), the content of the non-base levels is unchanged.
+     *
+     * @param engine        Engine this texture is associated to.
+     * @param callback      Called from the backend thread once the mipmaps have been generated.
+     *
+     * @attention \p engine must be the instance passed to Builder::build()
+     * @attention This Texture instance must NOT use SamplerType::SAMPLER_3D or it has no effect
+     */
+    void generateMipmapsAsync(Engine& engine,
+            utils::Invocable<void()>&& callback = {}) const noexcept;
+
+    /**
+     * Asynchronously copies a region of this texture into another texture.
+     *
+     * The copy maps directly to the backend's native copy command and doesn't involve a render
+     * pass, which makes many small copies per frame cheap -- e.g. when repacking a texture
+     * atlas or updating pages of a virtual texture. Each call copies one region; issue one
+     * call per region.
+     *
+     * Both textures must have the same format, this texture must have been created with
+     * TextureUsage::BLIT_SRC and \p dst with TextureUsage::BLIT_DST. Compressed and
+     * multisampled textures are not supported.
+     *
+     * @param engine    Engine this texture is associated to.
+     * @param dst       Texture to copy into.
+     * @param dstLevel  Destination level.
+     * @param dstLayer  Destination layer (or cubemap face).
+     * @param dstX      Left offset of the destination region.
+     * @param dstY      Bottom offset of the destination region.
+     * @param srcLevel  Source level.
+     * @param srcLayer  Source layer (or cubemap face).
+     * @param srcX      Left offset of the source region.
+     * @param srcY      Bottom offset of the source region.
+     * @param width     Width of the region to copy.
+     * @param height    Height of the region to copy.
+     *
+     * @attention \p engine must be the instance passed to Builder::build()
+     */
+    void copyTo(Engine& engine, Texture* dst,
+            size_t dstLevel, uint32_t dstLayer, uint32_t dstX, uint32_t dstY,
+            size_t srcLevel, uint32_t srcLayer, uint32_t srcX, uint32_t srcY,
+            uint32_t width, uint32_t height) const;
+
     /**
      * Creates a reflection map from an environment map.
      *
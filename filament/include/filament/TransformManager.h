@@ -123,6 +123,17 @@ public:
      */
     size_t getComponentCount() const noexcept;
 
+    /**
+     * Pre-allocates internal storage for the given total number of components.
+     *
+     * Calling this before populating a large number of transforms (e.g. during level load)
+     * lets the per-entity create() calls run without growing the internal arrays, typically
+     * in combination with utils::EntityManager::create(n, entities).
+     *
+     * @param count total number of components to reserve storage for
+     */
+    void reserve(size_t count) noexcept;
+
     /**
      * @return true if the this manager has no components
      */
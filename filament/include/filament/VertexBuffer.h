@@ -142,6 +142,29 @@ public:
          */
         Builder& normalized(VertexAttribute attribute, bool normalize = true) noexcept;
 
+        /**
+         * Requests engine-side quantization of float attribute data.
+         *
+         * When enabled, attributes declared with float types are stored in the compact formats
+         * returned by getQuantizedAttributeType() -- e.g. HALF4 positions, SHORT4 normalized
+         * tangents -- roughly halving vertex fetch bandwidth. setBufferAt() then expects data
+         * in the layout that was declared on this Builder and converts it on the fly; the
+         * declared byte offsets and strides are recomputed internally, so buffers holding a
+         * mix of attributes are repacked as a whole.
+         *
+         * Positions are quantized to half floats, which preserve magnitude (up to +/-65504),
+         * so no dequantization transform needs to be applied to the world matrix or anywhere
+         * else; the cost is reduced precision, roughly 3 decimal digits. Do not enable this
+         * for very large meshes, or meshes far from the origin, that need full float precision.
+         *
+         * Quantized buffers do not support partial updates: setBufferAt() must be called with
+         * a zero byte offset. This setting is incompatible with enableBufferObjects().
+         *
+         * @param enabled If true, enables attribute quantization. False by default.
+         * @return A reference to this Builder for chaining calls.
+         */
+        Builder& quantizeAttributes(bool enabled = true) noexcept;
+
         /**
          * Sets advanced skinning mode. Bone data, indices and weights will be
          * set in RenderableManager:Builder:boneIndicesAndWeights methods.
@@ -173,6 +196,21 @@ public:
         friend class FVertexBuffer;
     };
 
+    /**
+     * Returns the storage format used for the given attribute when quantization is enabled.
+     *
+     * This maps float types to a compact equivalent on attributes whose semantics permit it:
+     * POSITION FLOAT3/FLOAT4 to HALF4, TANGENTS FLOAT4 to normalized SHORT4, COLOR FLOAT4 to
+     * normalized UBYTE4, and UV0/UV1 FLOAT2 to HALF2. Everything else is returned unchanged.
+     * This is also useful as a format recommendation for pipelines that quantize offline.
+     *
+     * @param attribute The attribute of interest.
+     * @param type The type the attribute data is supplied in.
+     * @return The storage format used when Builder::quantizeAttributes() is enabled.
+     */
+    static AttributeType getQuantizedAttributeType(VertexAttribute attribute,
+            AttributeType type) noexcept;
+
     /**
      * Returns the vertex count.
      * @return Number of vertices in this vertex buffer set.
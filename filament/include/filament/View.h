@@ -678,6 +678,48 @@ public:
      */
     bool isStencilBufferEnabled() const noexcept;
 
+    /**
+     * Enables or disables the on-screen performance HUD for this View.
+     *
+     * The HUD is rendered by the engine at the end of the post-processing chain and requires
+     * no application code: it shows the recent frame-time history against the display's
+     * refresh period, along with JobSystem occupancy and the transient render-target memory
+     * managed by the engine. It is meant for performance triage in the field, where attaching
+     * a profiler or shipping a custom instrumented build isn't practical.
+     *
+     * Post-processing must be enabled on this View for the HUD to be visible.
+     *
+     * @param enabled True to enable the performance HUD, false disables it (default)
+     */
+    void setPerformanceHudEnabled(bool enabled) noexcept;
+
+    /**
+     * Returns true if the performance HUD is enabled.
+     * See setPerformanceHudEnabled() for more information.
+     */
+    bool isPerformanceHudEnabled() const noexcept;
+
+    /**
+     * Sets the fragment shading rate for this View's color pass.
+     *
+     * Coarse shading runs the fragment shader once per block of pixels instead of once per
+     * pixel, trading shading resolution for GPU time. It is most useful on Views whose content
+     * is dominated by low-frequency shading (e.g. heavily blurred or fast-moving content).
+     *
+     * This is a hint. Backends without coarse shading support ignore it, and backends that
+     * don't support the requested rate clamp it to the nearest supported rate. Shadow maps and
+     * post-processing always run at full rate.
+     *
+     * @param rate The fragment shading rate (default is ShadingRate::ONE_BY_ONE)
+     */
+    void setShadingRate(backend::ShadingRate rate) noexcept;
+
+    /**
+     * Returns the fragment shading rate of this View.
+     * See setShadingRate() for more information.
+     */
+    backend::ShadingRate getShadingRate() const noexcept;
+
     /**
      * Sets the stereoscopic rendering options for this view.
      *
@@ -705,6 +747,26 @@ public:
      */
     StereoscopicOptions const& getStereoscopicOptions() const noexcept;
 
+    /**
+     * Enables or disables GPU-assisted occlusion culling. Disabled by default.
+     *
+     * When enabled, the depth buffer of the previous frame is reduced on the GPU and read back
+     * asynchronously; renderables whose bounding box was entirely hidden behind closer geometry
+     * are then skipped during rendering. The test is conservative and has one frame of latency,
+     * so it can only produce false positives (occluded objects drawn for an extra frame), never
+     * missing objects. This helps scenes with high depth complexity, at the cost of a small
+     * reduction pass and readback each frame.
+     *
+     * Occlusion culling only affects the color pass; occluded renderables still cast shadows.
+     * It is ignored at feature level 0.
+     *
+     * @param enabled true to enable occlusion culling, false to disable it.
+     */
+    void setOcclusionCullingEnabled(bool enabled) noexcept;
+
+    //! Returns whether occlusion culling is enabled.
+    bool isOcclusionCullingEnabled() const noexcept;
+
     // for debugging...
 
     //! debugging: allows to entirely disable frustum culling. (culling enabled by default).
@@ -36,7 +36,8 @@ using HeapAllocatorArena = utils::Arena<
 using LinearAllocatorArena = utils::Arena<
         utils::LinearAllocator,
         utils::LockingPolicy::NoLock,
-        utils::TrackingPolicy::DebugAndHighWatermark>;
+        utils::TrackingPolicy::DebugAndHighWatermark,
+        utils::AreaPolicy::VirtualArea>;
 
 #else
 
@@ -48,9 +49,13 @@ using HeapAllocatorArena = utils::Arena<
         utils::TrackingPolicy::Untracked,
         utils::AreaPolicy::NullArea>;
 
+// the area is only committed as it is touched, so the arena can be sized for the worst
+// case without overcommitting physical memory (see FRenderer::endFrame())
 using LinearAllocatorArena = utils::Arena<
         utils::LinearAllocator,
-        utils::LockingPolicy::NoLock>;
+        utils::LockingPolicy::NoLock,
+        utils::TrackingPolicy::Untracked,
+        utils::AreaPolicy::VirtualArea>;
 
 #endif
 
@@ -53,20 +53,44 @@ AtlasAllocator::Allocation AtlasAllocator::allocate(size_t textureSize) noexcept
     const NodeId loc = allocateInLayer(LAYERS_DEPTH + layer);
     if (loc.l >= 0) {
         assert_invariant(loc.l - LAYERS_DEPTH == int8_t(layer));
-        const size_t dimension = 1u << powerOfTwo;
-        // find the location of in the texture from the morton code (quadtree position)
-        const auto [x, y] = unmorton(loc.code);
-        // scale to our maximum allocation size
-        const uint32_t mask = (1u << layer) - 1u;
-        result.viewport.left   = int32_t(x & mask) << powerOfTwo;
-        result.viewport.bottom = int32_t(y & mask) << powerOfTwo;
-        result.viewport.width  = dimension;
-        result.viewport.height = dimension;
-        result.layer = loc.code >> (2 * layer);
+        result = toAllocation(loc);
     }
     return result;
 }
 
+AtlasAllocator::Allocation AtlasAllocator::toAllocation(NodeId loc) const noexcept {
+    Allocation result{};
+    const size_t layer = size_t(loc.l) - LAYERS_DEPTH;
+    const size_t powerOfTwo = mMaxTextureSizePot - layer;
+    const size_t dimension = 1u << powerOfTwo;
+    // find the location of in the texture from the morton code (quadtree position)
+    const auto [x, y] = unmorton(loc.code);
+    // scale to our maximum allocation size
+    const uint32_t mask = (1u << layer) - 1u;
+    result.viewport.left   = int32_t(x & mask) << powerOfTwo;
+    result.viewport.bottom = int32_t(y & mask) << powerOfTwo;
+    result.viewport.width  = dimension;
+    result.viewport.height = dimension;
+    result.layer = loc.code >> (2 * layer);
+    return result;
+}
+
+AtlasAllocator::NodeId AtlasAllocator::fromAllocation(Allocation const& allocation) const noexcept {
+    assert_invariant(allocation.layer >= 0);
+    const size_t powerOfTwo =
+            (sizeof(size_t) * 8 - 1u) - utils::clz(size_t(allocation.viewport.width));
+    const size_t layer = mMaxTextureSizePot - powerOfTwo;
+    const uint16_t code = QuadTreeUtils::morton(
+            uint8_t(allocation.viewport.left >> powerOfTwo),
+            uint8_t(allocation.viewport.bottom >> powerOfTwo));
+    return { int8_t(LAYERS_DEPTH + layer),
+             QuadTree::code_t((allocation.layer << (2 * layer)) | code) };
+}
+
+void AtlasAllocator::free(Allocation const& allocation) noexcept {
+    freeNode(fromAllocation(allocation));
+}
+
 void AtlasAllocator::clear(size_t maxTextureSize) noexcept {
     std::fill(mQuadTree.begin(), mQuadTree.end(), Node{});
     mMaxTextureSizePot = (sizeof(maxTextureSize) * 8 - 1u) - utils::clz(maxTextureSize);
@@ -142,7 +166,7 @@ AtlasAllocator::NodeId AtlasAllocator::allocateInLayer(size_t maxHeight) noexcep
                 NodeId ppp = candidate;
                 while (ppp.l > 0) {
                     const size_t pi = QuadTreeUtils::parent(ppp.l, ppp.code);
-                    ppp = NodeId{ int8_t(ppp.l - 1), uint8_t(ppp.code >> 2) };
+                    ppp = NodeId{ int8_t(ppp.l - 1), QuadTree::code_t(ppp.code >> 2) };
                     Node const& node = mQuadTree[pi];
                     assert_invariant(!node.isAllocated());
                     assert_invariant(node.hasChildren());
@@ -168,10 +192,128 @@ AtlasAllocator::NodeId AtlasAllocator::allocateInLayer(size_t maxHeight) noexcep
                     });
 
             assert_invariant(found.l != -1);
+
+            // the candidate was empty, so it just became a new child of its parent
+            if (candidate.l > 0) {
+                Node& parent = mQuadTree[QuadTreeUtils::parent(candidate.l, candidate.code)];
+                assert_invariant(!parent.isAllocated());
+                assert_invariant(!parent.hasAllChildren());
+                parent.children++;
+            }
+
             candidate = found;
         }
     }
     return candidate;
 }
 
+void AtlasAllocator::allocateNode(NodeId loc) noexcept {
+    using namespace QuadTreeUtils;
+
+    Node& node = mQuadTree[index(size_t(loc.l), loc.code)];
+    assert_invariant(!node.isAllocated());
+    assert_invariant(!node.hasChildren());
+    node.allocated = true;
+
+    // create the hierarchy above us, stopping at the first ancestor that already exists
+    NodeId curr = loc;
+    while (curr.l > 0) {
+        Node& parent = mQuadTree[QuadTreeUtils::parent(size_t(curr.l), curr.code)];
+        assert_invariant(!parent.isAllocated());
+        assert_invariant(!parent.hasAllChildren());
+        const bool parentExisted = parent.hasChildren();
+        parent.children++;
+        if (parentExisted) {
+            break;
+        }
+        curr = NodeId{ int8_t(curr.l - 1), QuadTree::code_t(curr.code >> 2) };
+    }
+}
+
+void AtlasAllocator::freeNode(NodeId loc) noexcept {
+    using namespace QuadTreeUtils;
+
+    Node& node = mQuadTree[index(size_t(loc.l), loc.code)];
+    assert_invariant(node.isAllocated());
+    assert_invariant(!node.hasChildren());
+    node.allocated = false;
+
+    // remove the hierarchy above us, as long as it becomes empty
+    NodeId curr = loc;
+    while (curr.l > 0) {
+        Node const& child = mQuadTree[index(size_t(curr.l), curr.code)];
+        if (child.isAllocated() || child.hasChildren()) {
+            break;
+        }
+        Node& parent = mQuadTree[QuadTreeUtils::parent(size_t(curr.l), curr.code)];
+        assert_invariant(parent.hasChildren());
+        parent.children--;
+        curr = NodeId{ int8_t(curr.l - 1), QuadTree::code_t(curr.code >> 2) };
+    }
+}
+
+size_t AtlasAllocator::getLayerCount() const noexcept {
+    using namespace QuadTreeUtils;
+
+    // each node at depth LAYERS_DEPTH is a layer, and its morton code is the layer index
+    size_t count = 0;
+    for (size_t layer = 0; layer < (1u << (2u * LAYERS_DEPTH)); layer++) {
+        Node const& node = mQuadTree[index(LAYERS_DEPTH, layer)];
+        if (node.isAllocated() || node.hasChildren()) {
+            count = layer + 1;
+        }
+    }
+    return count;
+}
+
+bool AtlasAllocator::defragment(Relocation& relocation) noexcept {
+    using namespace QuadTreeUtils;
+
+    // normalize a morton code so that nodes of different levels can be compared by address
+    auto const addressOf = [](NodeId const& loc) -> size_t {
+        return size_t(loc.code) << (2u * (QuadTree::height() - 1u - size_t(loc.l)));
+    };
+
+    // find the allocation with the highest address in the atlas
+    NodeId victim{ -1, 0 };
+    QuadTree::traverse(0, 0, QuadTree::height() - 1,
+            [this, &victim, &addressOf](NodeId const& curr) -> QuadTree::TraversalResult {
+                Node const& node = mQuadTree[index(size_t(curr.l), curr.code)];
+                if (node.isAllocated()) {
+                    if (victim.l < 0 || addressOf(curr) > addressOf(victim)) {
+                        victim = curr;
+                    }
+                    return QuadTree::TraversalResult::SKIP_CHILDREN;
+                }
+                // empty subtrees can't contain allocations
+                return node.hasChildren() ?
+                       QuadTree::TraversalResult::RECURSE :
+                       QuadTree::TraversalResult::SKIP_CHILDREN;
+            });
+
+    if (victim.l < 0) {
+        // the atlas is empty
+        return false;
+    }
+
+    // try to re-allocate the victim at a lower address
+    freeNode(victim);
+    const NodeId loc = allocateInLayer(size_t(victim.l));
+    assert_invariant(loc.l == victim.l); // at worst, the victim's old spot is still free
+
+    if (addressOf(loc) >= addressOf(victim)) {
+        // no better spot was found, put the victim back where it was. The strictly-decreasing
+        // address guarantees forward progress (no oscillation between equivalent spots).
+        if (loc.code != victim.code) {
+            freeNode(loc);
+            allocateNode(victim);
+        }
+        return false;
+    }
+
+    relocation.from = toAllocation(victim);
+    relocation.to = toAllocation(loc);
+    return true;
+}
+
 } // namespace filament
@@ -28,6 +28,9 @@ class AtlasAllocator_AllocateSecondLevel_Test;
 class AtlasAllocator_AllocateMixed0_Test;
 class AtlasAllocator_AllocateMixed1_Test;
 class AtlasAllocator_AllocateMixed2_Test;
+class AtlasAllocator_FreeAndReallocate_Test;
+class AtlasAllocator_LayerCount_Test;
+class AtlasAllocator_Defragment_Test;
 
 namespace filament {
 
@@ -87,19 +90,52 @@ public:
     };
     Allocation allocate(size_t textureSize) noexcept;
 
+    /*
+     * Frees an allocation previously returned by allocate(). The Allocation must be valid.
+     */
+    void free(Allocation const& allocation) noexcept;
+
     /*
      * Frees all allocations and reset the maximum texture size.
      */
     void clear(size_t maxTextureSize = 1024) noexcept;
 
+    /*
+     * Number of texture layers needed to store the current allocations, that is, one past the
+     * highest layer in use. Allocations always prefer the lowest address available, so the
+     * backing texture array only needs to grow when this count does, and can shrink back
+     * after defragmentation.
+     */
+    size_t getLayerCount() const noexcept;
+
+    /*
+     * Incremental defragmentation. Moves at most one allocation to a lower address and returns
+     * true, filling `relocation` with its old and new locations so the caller can copy the
+     * texels (or just re-render them). Returns false when no move would help; calling this
+     * once per frame -- typically on frames where the atlas content is unchanged -- is enough
+     * to keep a long-running atlas compact.
+     */
+    struct Relocation {
+        Allocation from;
+        Allocation to;
+    };
+    bool defragment(Relocation& relocation) noexcept;
+
 private:
     friend AtlasAllocator_AllocateFirstLevel_Test;
     friend AtlasAllocator_AllocateSecondLevel_Test;
     friend AtlasAllocator_AllocateMixed0_Test;
     friend AtlasAllocator_AllocateMixed1_Test;
     friend AtlasAllocator_AllocateMixed2_Test;
+    friend AtlasAllocator_FreeAndReallocate_Test;
+    friend AtlasAllocator_LayerCount_Test;
+    friend AtlasAllocator_Defragment_Test;
 
     QuadTree::NodeId allocateInLayer(size_t n) noexcept;
+    void allocateNode(QuadTree::NodeId loc) noexcept;
+    void freeNode(QuadTree::NodeId loc) noexcept;
+    Allocation toAllocation(QuadTree::NodeId loc) const noexcept;
+    QuadTree::NodeId fromAllocation(Allocation const& allocation) const noexcept;
 
     // quad-tree array to store the allocated list
     QuadTree mQuadTree{};
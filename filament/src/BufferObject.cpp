@@ -27,6 +27,11 @@ void BufferObject::setBuffer(Engine& engine,
     downcast(this)->setBuffer(downcast(engine), std::move(buffer), byteOffset);
 }
 
+void BufferObject::copyFrom(Engine& engine, uint32_t dstOffset,
+        BufferObject const* src, uint32_t srcOffset, uint32_t size) {
+    downcast(this)->copyFrom(downcast(engine), dstOffset, downcast(src), srcOffset, size);
+}
+
 size_t BufferObject::getByteCount() const noexcept {
     return downcast(this)->getByteCount();
 }
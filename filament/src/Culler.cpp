@@ -20,6 +20,10 @@
 
 #include <math/fast.h>
 
+#include <utils/debug.h>
+
+#include <algorithm>
+
 using namespace filament::math;
 
 // use 8 if Culler::result_type is 8-bits, on ARMv8 it allows the compiler to write eight
@@ -68,6 +72,14 @@ void Culler::intersects(
 
     float4 const * UTILS_RESTRICT const planes = frustum.mPlanes;
 
+    // the absolute plane normals are loop invariants, hoist them out of the hot loop
+    // so the vectorized body is pure fma/and work
+    float4 absPlanes[6];
+    #pragma clang loop unroll(full)
+    for (size_t j = 0; j < 6; j++) {
+        absPlanes[j] = abs(planes[j]);
+    }
+
     count = round(count);
     #pragma clang loop vectorize_width(FILAMENT_CULLER_VECTORIZE_HINT)
     for (size_t i = 0; i < count; i++) {
@@ -78,9 +90,9 @@ void Culler::intersects(
             // clang doesn't seem to generate vector * scalar instructions, which leads
             // to increased register pressure and stack spills
             const float dot =
-                    planes[j].x * center[i].x - std::abs(planes[j].x) * extent[i].x +
-                    planes[j].y * center[i].y - std::abs(planes[j].y) * extent[i].y +
-                    planes[j].z * center[i].z - std::abs(planes[j].z) * extent[i].z +
+                    planes[j].x * center[i].x - absPlanes[j].x * extent[i].x +
+                    planes[j].y * center[i].y - absPlanes[j].y * extent[i].y +
+                    planes[j].z * center[i].z - absPlanes[j].z * extent[i].z +
                     planes[j].w;
 
             visible &= fast::signbit(dot) << bit;
@@ -93,6 +105,70 @@ void Culler::intersects(
     }
 }
 
+void Culler::intersects(
+        result_type* UTILS_RESTRICT results,
+        Frustum const* UTILS_RESTRICT frusta,
+        size_t frustumCount,
+        float3 const* UTILS_RESTRICT center,
+        float3 const* UTILS_RESTRICT extent,
+        size_t count) noexcept {
+
+    assert_invariant(frustumCount <= MAX_BATCH_FRUSTUM_COUNT);
+    frustumCount = std::min(frustumCount, MAX_BATCH_FRUSTUM_COUNT);
+
+    // precompute the planes and their absolute normals for all frusta, so that the
+    // AABB arrays are streamed from memory only once regardless of the frustum count
+    // (e.g. all cascades of a shadow view in a single pass)
+    float4 planes[MAX_BATCH_FRUSTUM_COUNT][6];
+    float4 absPlanes[MAX_BATCH_FRUSTUM_COUNT][6];
+    for (size_t v = 0; v < frustumCount; v++) {
+        #pragma clang loop unroll(full)
+        for (size_t j = 0; j < 6; j++) {
+            planes[v][j] = frusta[v].mPlanes[j];
+            absPlanes[v][j] = abs(planes[v][j]);
+        }
+    }
+
+    count = round(count);
+    #pragma clang loop vectorize_width(FILAMENT_CULLER_VECTORIZE_HINT)
+    for (size_t i = 0; i < count; i++) {
+        int r = 0;
+        for (size_t v = 0; v < frustumCount; v++) {
+            int visible = ~0;
+            #pragma clang loop unroll(full)
+            for (size_t j = 0; j < 6; j++) {
+                const float dot =
+                        planes[v][j].x * center[i].x - absPlanes[v][j].x * extent[i].x +
+                        planes[v][j].y * center[i].y - absPlanes[v][j].y * extent[i].y +
+                        planes[v][j].z * center[i].z - absPlanes[v][j].z * extent[i].z +
+                        planes[v][j].w;
+                visible &= fast::signbit(dot);
+            }
+            r |= (visible & 1) << v;
+        }
+        results[i] = result_type(r);
+    }
+}
+
+Culler::Containment Culler::classify(Frustum const& frustum,
+        float3 const& center, float3 const& extent) noexcept {
+    float4 const * const UTILS_RESTRICT planes = frustum.mPlanes;
+    bool inside = true;
+    #pragma clang loop unroll(full)
+    for (size_t j = 0; j < 6; j++) {
+        float3 const p = planes[j].xyz;
+        float const d = dot(p, center) + planes[j].w;
+        float const r = dot(abs(p), extent);
+        if (d - r >= 0.0f) {
+            // the nearest corner is outside this plane, so is the whole box
+            return Containment::OUTSIDE;
+        }
+        // the farthest corner must be inside every plane for full containment
+        inside = inside && (d + r < 0.0f);
+    }
+    return inside ? Containment::INSIDE : Containment::INTERSECTING;
+}
+
 /*
  * returns whether a box intersects with the frustum
  */
@@ -44,6 +44,10 @@ public:
 
     using result_type = uint8_t;
 
+    // maximum number of frusta handled by the batched variant below
+    // (one bit per frustum in result_type)
+    static constexpr size_t MAX_BATCH_FRUSTUM_COUNT = sizeof(result_type) * 8;
+
     /*
      * returns whether each AABB in an array intersects with the frustum
      */
@@ -53,6 +57,17 @@ public:
             math::float3 const* extent,
             size_t count, size_t bit) noexcept;
 
+    /*
+     * culls an array of AABBs against several frusta in a single pass over the
+     * input arrays; bit v of each result is set if the AABB intersects frusta[v]
+     */
+    static void intersects(result_type* results,
+            Frustum const* frusta,
+            size_t frustumCount,
+            math::float3 const* center,
+            math::float3 const* extent,
+            size_t count) noexcept;
+
     /*
      * returns whether each sphere in an array intersects with the frustum
      */
@@ -62,6 +77,23 @@ public:
             math::float4 const* b,
             size_t count) noexcept;
 
+    // coarse classification of an AABB against a frustum, used for hierarchical culling
+    enum class Containment {
+        OUTSIDE,        // the box is entirely outside the frustum
+        INTERSECTING,   // the box straddles the frustum (conservative)
+        INSIDE          // the box is entirely inside the frustum
+    };
+
+    /*
+     * conservatively classifies an AABB against the frustum. When the box encloses a group
+     * of objects, OUTSIDE (resp. INSIDE) guarantees all enclosed objects are culled
+     * (resp. visible), allowing whole groups to skip the per-object tests.
+     */
+    static Containment classify(
+            Frustum const& frustum,
+            math::float3 const& center,
+            math::float3 const& extent) noexcept;
+
     /*
      * returns whether an AABB intersects with the frustum
      */
@@ -26,21 +26,46 @@ const uint16_t DFG::DFG_LUT[] = {
 };
 
 void DFG::init(FEngine& engine) noexcept {
-    constexpr size_t fp16Count = DFG_LUT_SIZE * DFG_LUT_SIZE * 3;
+    constexpr size_t texelCount = DFG_LUT_SIZE * DFG_LUT_SIZE;
+    constexpr size_t fp16Count = texelCount * 3;
     constexpr size_t byteCount = fp16Count * sizeof(uint16_t);
 
     static_assert(sizeof(DFG_LUT) == byteCount, "DFG_LUT_SIZE doesn't match size of the DFG LUT");
 
+    // The DFG terms are non-negative and well within the range of the small floating-point
+    // formats, so when the backend supports it we store the LUT as R11F_G11F_B10F, which
+    // saves a third of the memory and of the upload.
+    bool const packed =
+            FTexture::isTextureFormatSupported(engine, backend::TextureFormat::R11F_G11F_B10F);
+
     Texture* lut = Texture::Builder()
             .width(DFG_LUT_SIZE)
             .height(DFG_LUT_SIZE)
-            .format(backend::TextureFormat::RGB16F)
+            .format(packed ? backend::TextureFormat::R11F_G11F_B10F
+                           : backend::TextureFormat::RGB16F)
             .build(engine);
 
-    Texture::PixelBufferDescriptor buffer(DFG_LUT, byteCount,
-            Texture::Format::RGB, Texture::Type::HALF);
-
-    lut->setImage(engine, 0, std::move(buffer));
+    if (packed) {
+        // repack the half-float data as B10F:G11F:R11F. The values are positive, so we can
+        // simply shift the sign bit out; rounding a mantissa up can only carry into the
+        // exponent, which is still correct (the LUT holds nothing close to the max value).
+        auto const to11F = [](uint16_t h) -> uint32_t { return ((h & 0x7FFFu) + 0x08u) >> 4u; };
+        auto const to10F = [](uint16_t h) -> uint32_t { return ((h & 0x7FFFu) + 0x10u) >> 5u; };
+        uint32_t* const data = new uint32_t[texelCount];
+        for (size_t i = 0; i < texelCount; i++) {
+            data[i] = to11F(DFG_LUT[i * 3 + 0])
+                    | (to11F(DFG_LUT[i * 3 + 1]) << 11u)
+                    | (to10F(DFG_LUT[i * 3 + 2]) << 22u);
+        }
+        Texture::PixelBufferDescriptor buffer(data, texelCount * sizeof(uint32_t),
+                Texture::Format::RGB, Texture::Type::UINT_10F_11F_11F_REV, 1, 0, 0, 0,
+                [](void* b, size_t, void*) { delete[] static_cast<uint32_t*>(b); });
+        lut->setImage(engine, 0, std::move(buffer));
+    } else {
+        Texture::PixelBufferDescriptor buffer(DFG_LUT, byteCount,
+                Texture::Format::RGB, Texture::Type::HALF);
+        lut->setImage(engine, 0, std::move(buffer));
+    }
 
     mLUT = downcast(lut);
 }
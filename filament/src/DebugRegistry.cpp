@@ -77,6 +77,31 @@ bool DebugRegistry::getProperty(const char* name, float4* v) const noexcept {
     return downcast(this)->getProperty(name, v);
 }
 
+
+bool DebugRegistry::getPropertySnapshot(const char* name, bool* v) const noexcept {
+    return downcast(this)->getPropertySnapshot(name, v);
+}
+
+bool DebugRegistry::getPropertySnapshot(const char* name, int* v) const noexcept {
+    return downcast(this)->getPropertySnapshot(name, v);
+}
+
+bool DebugRegistry::getPropertySnapshot(const char* name, float* v) const noexcept {
+    return downcast(this)->getPropertySnapshot(name, v);
+}
+
+bool DebugRegistry::getPropertySnapshot(const char* name, float2* v) const noexcept {
+    return downcast(this)->getPropertySnapshot(name, v);
+}
+
+bool DebugRegistry::getPropertySnapshot(const char* name, float3* v) const noexcept {
+    return downcast(this)->getPropertySnapshot(name, v);
+}
+
+bool DebugRegistry::getPropertySnapshot(const char* name, float4* v) const noexcept {
+    return downcast(this)->getPropertySnapshot(name, v);
+}
+
 void *DebugRegistry::getPropertyAddress(const char *name) {
     return  downcast(this)->getPropertyAddress(name);
 }
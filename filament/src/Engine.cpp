@@ -259,6 +259,10 @@ void Engine::flush() {
     downcast(this)->flush();
 }
 
+void Engine::prewarmPipelines(Material* const* materials, size_t count) noexcept {
+    downcast(this)->prewarmPipelines(materials, count);
+}
+
 utils::EntityManager& Engine::getEntityManager() noexcept {
     return downcast(this)->getEntityManager();
 }
@@ -283,10 +287,12 @@ void* Engine::streamAlloc(size_t size, size_t alignment) noexcept {
     return downcast(this)->streamAlloc(size, alignment);
 }
 
-// The external-facing execute does a flush, and is meant only for single-threaded environments.
-// It also discards the boolean return value, which would otherwise indicate a thread exit.
+// The external-facing execute does a flush, and is meant only for engines without a dedicated
+// driver thread. It also discards the boolean return value, which would otherwise indicate a
+// thread exit.
 void Engine::execute() {
-    ASSERT_PRECONDITION(!UTILS_HAS_THREADING, "Execute is meant for single-threaded platforms.");
+    ASSERT_PRECONDITION(!downcast(this)->hasDedicatedDriverThread(),
+            "Execute is meant for engines without a dedicated driver thread.");
     downcast(this)->flush();
     downcast(this)->execute();
 }
@@ -303,6 +309,19 @@ void Engine::pumpMessageQueues() {
     downcast(this)->pumpMessageQueues();
 }
 
+bool Engine::dumpTrace(const char* path) noexcept {
+    return downcast(this)->dumpTrace(path);
+}
+
+Engine::MemoryInfo Engine::getMemoryInfo() const noexcept {
+    return downcast(this)->getMemoryInfo();
+}
+
+void Engine::setMemoryBudget(uint64_t budgetBytes,
+        MemoryBudgetCallback callback, void* user) noexcept {
+    downcast(this)->setMemoryBudget(budgetBytes, callback, user);
+}
+
 void Engine::setAutomaticInstancingEnabled(bool enable) noexcept {
     downcast(this)->setAutomaticInstancingEnabled(enable);
 }
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_FEATUREFLAGS_H
+#define TNT_FILAMENT_FEATUREFLAGS_H
+
+namespace filament::features {
+
+/*
+ * Build-time feature stripping. Each flag below compiles out an entire feature family:
+ * the corresponding runtime checks become constant-false, so the dead branches are removed
+ * from the draw-loop hot paths and the feature's code doesn't make it into the binary.
+ *
+ * This is intended for constrained products that know up-front which features their
+ * materials use (typically in combination with matc's variant filtering). The public APIs
+ * remain available, but the options they set have no effect in a stripped build.
+ *
+ * These flags are controlled by the FILAMENT_DISABLE_* CMake options.
+ */
+
+// screen-space reflections and screen-space refraction
+#if defined(FILAMENT_DISABLE_SSR)
+constexpr bool SSR = false;
+#else
+constexpr bool SSR = true;
+#endif
+
+// large-scale fog
+#if defined(FILAMENT_DISABLE_FOG)
+constexpr bool FOG = false;
+#else
+constexpr bool FOG = true;
+#endif
+
+// variance shadow mapping
+#if defined(FILAMENT_DISABLE_VSM)
+constexpr bool VSM = false;
+#else
+constexpr bool VSM = true;
+#endif
+
+} // namespace filament::features
+
+#endif // TNT_FILAMENT_FEATUREFLAGS_H
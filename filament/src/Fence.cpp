@@ -24,8 +24,18 @@ FenceStatus Fence::waitAndDestroy(Fence* fence, Mode mode) {
     return FFence::waitAndDestroy(downcast(fence), mode);
 }
 
+FenceStatus Fence::waitAny(Fence* const* fences, size_t count, size_t* signaledIndex,
+        Mode mode, uint64_t timeout) {
+    return FFence::waitAny(fences, count, signaledIndex, mode, timeout);
+}
+
 FenceStatus Fence::wait(Mode mode, uint64_t timeout) {
     return downcast(this)->wait(mode, timeout);
 }
 
+void Fence::onSignal(backend::CallbackHandler* handler,
+        utils::Invocable<void(FenceStatus)>&& callback) noexcept {
+    downcast(this)->onSignal(handler, std::move(callback));
+}
+
 } // namespace filament
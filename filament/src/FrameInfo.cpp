@@ -41,6 +41,9 @@ FrameInfoManager::FrameInfoManager(DriverApi& driver) noexcept {
     for (auto& query : mQueries) {
         query = driver.createTimerQuery();
     }
+    for (auto& query : mScaledQueries) {
+        query = driver.createTimerQuery();
+    }
 }
 
 FrameInfoManager::~FrameInfoManager() noexcept = default;
@@ -49,37 +52,74 @@ void FrameInfoManager::terminate(DriverApi& driver) noexcept {
     for (auto& query : mQueries) {
         driver.destroyTimerQuery(query);
     }
+    for (auto& query : mScaledQueries) {
+        driver.destroyTimerQuery(query);
+    }
 }
 
 void FrameInfoManager::beginFrame(DriverApi& driver,Config const& config, uint32_t) noexcept {
     driver.beginTimerQuery(mQueries[mIndex]);
+    mFrameBegun = true;
+    mSplitThisFrame = false;
     uint64_t elapsed = 0;
-    if (driver.getTimerQueryValue(mQueries[mLast], &elapsed)) {
+    uint64_t scaledElapsed = 0;
+    bool const split = mSplit[mLast];
+    // when the frame was split in two, the scaled-pass query is the last one to finish, so
+    // check it first -- if it's available, the first segment necessarily is too.
+    bool const ready = (!split || driver.getTimerQueryValue(mScaledQueries[mLast], &scaledElapsed))
+            && driver.getTimerQueryValue(mQueries[mLast], &elapsed);
+    if (ready) {
         mLast = (mLast + 1) % POOL_COUNT;
         // conversion to our duration happens here
-        mFrameTime = std::chrono::duration<uint64_t, std::nano>(elapsed);
+        mScaledValid = split;
+        mScaledFrameTime = std::chrono::duration<uint64_t, std::nano>(scaledElapsed);
+        // when the frame was split, the whole-frame time is the sum of both segments
+        mFrameTime = std::chrono::duration<uint64_t, std::nano>(elapsed) + mScaledFrameTime;
     }
-    update(config, mFrameTime);
+    update(config, mFrameTime, mScaledFrameTime, mScaledValid);
 }
 
-void FrameInfoManager::endFrame(DriverApi& driver) noexcept {
+void FrameInfoManager::beginScaledPasses(DriverApi& driver) noexcept {
+    if (UTILS_UNLIKELY(!mFrameBegun || mSplitThisFrame)) {
+        // with multiple views we only split at the first one; the scale-independent passes of
+        // the other views are then accounted with the resolution-sensitive work, which is a
+        // good-enough approximation.
+        return;
+    }
+    mSplitThisFrame = true;
+    // GL doesn't support nested time-elapsed queries, so the whole-frame query is split into
+    // two back-to-back segments instead: [beginFrame, here) and [here, endFrame).
     driver.endTimerQuery(mQueries[mIndex]);
+    driver.beginTimerQuery(mScaledQueries[mIndex]);
+}
+
+void FrameInfoManager::endFrame(DriverApi& driver) noexcept {
+    if (UTILS_UNLIKELY(!mFrameBegun)) {
+        // beginFrame() was skipped for this frame (e.g. while pass profiling is active)
+        return;
+    }
+    driver.endTimerQuery(mSplitThisFrame ? mScaledQueries[mIndex] : mQueries[mIndex]);
+    mSplit[mIndex] = mSplitThisFrame;
+    mFrameBegun = false;
     mIndex = (mIndex + 1) % POOL_COUNT;
 }
 
 void FrameInfoManager::update(Config const& config,
-        FrameInfoManager::duration lastFrameTime) noexcept {
+        FrameInfoManager::duration lastFrameTime,
+        FrameInfoManager::duration lastScaledTime, bool scaledValid) noexcept {
     // keep an history of frame times
     auto& history = mFrameTimeHistory;
 
     // this is like doing { pop_back(); push_front(); }
     filament::move_backward(history.begin(), history.end() - 1, history.end());
     history[0].frameTime = lastFrameTime;
+    history[0].scaledFrameTime = scaledValid ? lastScaledTime : duration{};
 
     mFrameTimeHistorySize = std::min(++mFrameTimeHistorySize, uint32_t(MAX_FRAMETIME_HISTORY));
     if (UTILS_UNLIKELY(mFrameTimeHistorySize < 3)) {
         // not enough history to do anything useful
         history[0].valid = false;
+        history[0].scaledValid = false;
         return;
     }
 
@@ -96,6 +136,22 @@ void FrameInfoManager::update(Config const& config,
 
     history[0].denoisedFrameTime = denoisedFrameTime;
     history[0].valid = true;
+
+    // same median filter for the resolution-sensitive GPU time, restricted to the frames that
+    // actually measured it (a 0 time means no measurement).
+    size_t scaledSize = 0;
+    for (size_t i = 0; i < size; ++i) {
+        if (history[i].scaledFrameTime > duration{}) {
+            median[scaledSize++] = history[i].scaledFrameTime;
+        }
+    }
+    if (scaledSize >= 3) {
+        std::sort(median.begin(), median.begin() + scaledSize);
+        history[0].denoisedScaledFrameTime = median[scaledSize / 2];
+        history[0].scaledValid = true;
+    } else {
+        history[0].scaledValid = false;
+    }
 }
 
 
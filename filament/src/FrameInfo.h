@@ -30,9 +30,12 @@ class FEngine;
 
 struct FrameInfo {
     using duration = std::chrono::duration<float, std::milli>;
-    duration frameTime{};            // frame period
-    duration denoisedFrameTime{};    // frame period (median filter)
+    duration frameTime{};                   // frame period
+    duration denoisedFrameTime{};           // frame period (median filter)
+    duration scaledFrameTime{};             // resolution-sensitive portion of the frame, 0 if unknown
+    duration denoisedScaledFrameTime{};     // resolution-sensitive portion (median filter)
     bool valid = false;
+    bool scaledValid = false;               // denoisedScaledFrameTime is usable
 };
 
 class FrameInfoManager {
@@ -54,6 +57,11 @@ public:
     // call this immediately after "make current"
     void beginFrame(backend::DriverApi& driver, Config const& config, uint32_t frameId) noexcept;
 
+    // call this when the resolution-sensitive passes start executing; from this point until
+    // endFrame() the GPU time is accounted separately, so the dynamic resolution controller
+    // can ignore the scale-independent part of the frame (e.g. shadow maps).
+    void beginScaledPasses(backend::DriverApi& driver) noexcept;
+
     // call this immediately before "swap buffers"
     void endFrame(backend::DriverApi& driver) noexcept;
 
@@ -65,10 +73,26 @@ public:
         return getLastFrameInfo().frameTime;
     }
 
+    // frame-time history, most recent entry first; used by the performance HUD
+    FrameInfo const* getFrameHistory() const noexcept {
+        return mFrameTimeHistory.data();
+    }
+
+    uint32_t getFrameHistorySize() const noexcept {
+        return mFrameTimeHistorySize;
+    }
+
 private:
-    void update(Config const& config, duration lastFrameTime) noexcept;
+    void update(Config const& config, duration lastFrameTime,
+            duration lastScaledTime, bool scaledValid) noexcept;
     backend::Handle<backend::HwTimerQuery> mQueries[POOL_COUNT];
+    backend::Handle<backend::HwTimerQuery> mScaledQueries[POOL_COUNT];
+    bool mSplit[POOL_COUNT] = {};   // whether the frame's timer query was split in two
     duration mFrameTime{};
+    duration mScaledFrameTime{};
+    bool mScaledValid = false;
+    bool mFrameBegun = false;       // a whole-frame timer query is in flight
+    bool mSplitThisFrame = false;
     uint32_t mIndex = 0;
     uint32_t mLast = 0;
 
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FramePacer.h"
+
+#include <utils/compiler.h>
+
+#include <algorithm>
+
+namespace filament {
+
+using namespace backend;
+
+void FramePacer::beginFrame(DriverApi& driver,
+        int64_t const vsyncNs, int64_t const nowNs, bool const lowLatency) noexcept {
+    constexpr int64_t ONE_MS = 1'000'000;
+    constexpr int64_t MAX_PERIOD = 100 * ONE_MS; // 10 Hz, anything slower isn't a vsync
+
+    int64_t const delta = vsyncNs - mLastVsync;
+    mLastVsync = vsyncNs;
+    if (UTILS_UNLIKELY(!vsyncNs || delta <= 0 || delta > MAX_PERIOD)) {
+        // no usable vsync timestamps (first frame, app paused, or the app doesn't
+        // provide them), don't try to pace
+        return;
+    }
+
+    // delta spans one refresh period when we make rate, more when we missed a vsync
+    // (a double-present); use the rounded period count to keep the estimate honest
+    // in both cases.
+    int64_t const periods = mPeriod > 0 ? std::max(int64_t(1), (delta + mPeriod / 2) / mPeriod) : 1;
+    int64_t const sample = delta / periods;
+    mPeriod = mPeriod > 0 ? mPeriod + (sample - mPeriod) / 8 : sample;
+    mStats.vsyncPeriodMs = float(mPeriod) / float(ONE_MS);
+    if (periods >= 2) {
+        mStats.missedVsyncCount += 1.0f;
+    }
+
+    // how late after its vsync this frame started processing
+    int64_t const jitterNs = std::max(nowNs - vsyncNs, int64_t(0));
+    size_t const bucket = std::min(size_t(jitterNs / ONE_MS), JITTER_HISTOGRAM_SIZE - 1);
+    mStats.jitterHistogram[bucket] += 1.0f;
+
+    // schedule the present on a vsync boundary, so that a frame finishing a little early or
+    // a little late still presents at a steady cadence instead of drifting by one vsync
+    int64_t const latency = lowLatency ? 1 : 2;
+    driver.setPresentationTime(vsyncNs + latency * mPeriod);
+}
+
+} // namespace filament
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_DETAILS_FRAMEPACER_H
+#define TNT_FILAMENT_DETAILS_FRAMEPACER_H
+
+#include <private/backend/DriverApi.h>
+
+#include <stdint.h>
+
+namespace filament {
+
+/*
+ * FramePacer estimates the display's refresh period from the vsync timestamps passed to
+ * Renderer::beginFrame(), schedules each present on a vsync boundary through
+ * DriverApi::setPresentationTime() -- the same idea as Android's Swappy -- and keeps
+ * simple jitter statistics that can be inspected through the DebugRegistry
+ * ("d.renderer.pacing.stats").
+ *
+ * It only does something useful when the application passes real vsync timestamps to
+ * Renderer::beginFrame().
+ */
+class FramePacer {
+public:
+    // bucket i counts frames that started i ms after the reported vsync,
+    // the last bucket also counts everything above
+    static constexpr size_t JITTER_HISTOGRAM_SIZE = 16;
+
+    struct Stats {
+        float jitterHistogram[JITTER_HISTOGRAM_SIZE] = {};
+        float vsyncPeriodMs = 0.0f;     // current refresh period estimate
+        float missedVsyncCount = 0.0f;  // frames that skipped at least one vsync (double-presents)
+    };
+
+    /*
+     * Updates the refresh-period estimate and schedules the present of this frame,
+     * 2 periods out by default so the CPU and GPU can each overlap a full frame,
+     * 1 period out in low-latency mode.
+     */
+    void beginFrame(backend::DriverApi& driver,
+            int64_t vsyncNs, int64_t nowNs, bool lowLatency) noexcept;
+
+    Stats const& getStats() const noexcept { return mStats; }
+
+private:
+    int64_t mLastVsync = 0;
+    int64_t mPeriod = 0;    // filtered estimate, ns
+    Stats mStats;
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_DETAILS_FRAMEPACER_H
@@ -31,6 +31,11 @@ FrameSkipper::FrameSkipper(size_t latency) noexcept
 
 FrameSkipper::~FrameSkipper() noexcept = default;
 
+void FrameSkipper::setLatency(size_t latency) noexcept {
+    assert_invariant(latency >= 1 && latency <= MAX_FRAME_LATENCY);
+    mLast = latency - 1;
+}
+
 void FrameSkipper::terminate(DriverApi& driver) noexcept {
     for (auto fence : mDelayedFences) {
         if (fence) {
@@ -48,6 +48,10 @@ public:
     explicit FrameSkipper(size_t latency = 2) noexcept;
     ~FrameSkipper() noexcept;
 
+    // Changes the accepted number of in-flight frames (1 to MAX_FRAME_LATENCY). Takes effect
+    // on the next endFrame(); fences placed under the previous setting drain naturally.
+    void setLatency(size_t latency) noexcept;
+
     void terminate(backend::DriverApi& driver) noexcept;
 
     // Returns false if we need to skip this frame, because the GPU is running behind the CPU;
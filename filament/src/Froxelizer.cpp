@@ -26,6 +26,8 @@
 #include <filament/Viewport.h>
 
 #include <utils/BinaryTreeArray.h>
+#include <utils/JobSystem.h>
+#include <utils/Mutex.h>
 #include <utils/Systrace.h>
 #include <utils/debug.h>
 
@@ -36,6 +38,7 @@
 #include <algorithm>
 
 #include <stddef.h>
+#include <string.h>
 
 using namespace filament::math;
 using namespace utils;
@@ -97,7 +100,8 @@ static bool fuzzyEqual(mat4f const& UTILS_RESTRICT l, mat4f const& UTILS_RESTRIC
 
 
 Froxelizer::Froxelizer(FEngine& engine)
-        : mArena("froxel", PER_FROXELDATA_ARENA_SIZE),
+        : mEngine(engine),
+          mArena("froxel", PER_FROXELDATA_ARENA_SIZE),
           mZLightNear(FROXEL_FIRST_SLICE_DEPTH),
           mZLightFar(FROXEL_LAST_SLICE_DISTANCE)
 {
@@ -134,6 +138,10 @@ void Froxelizer::terminate(DriverApi& driverApi) noexcept {
     mPlanesX = nullptr;
     mDistancesZ = nullptr;
 
+    delete [] mFroxelShardedData.data();
+    mFroxelShardedData.clear();
+    mLightParamsCache.reset();
+
     if (mRecordsBuffer) {
         driverApi.destroyBufferObject(mRecordsBuffer);
     }
@@ -202,11 +210,17 @@ bool Froxelizer::prepare(
             arena.allocate<LightRecord>(getFroxelBufferEntryCount(), CACHELINE_SIZE),
             getFroxelBufferEntryCount() };
 
-    // froxel thread data (~256 KiB)
-    mFroxelShardedData = {
-            arena.allocate<FroxelThreadData>(GROUP_COUNT, CACHELINE_SIZE),
-            uint32_t(GROUP_COUNT)
-    };
+    /*
+     * Persistent allocations
+     */
+
+    // froxel thread data and light parameter cache (~264 KiB). These are kept across
+    // frames so froxelizeLoop() can reuse the bits of lights that haven't changed;
+    // value-initialization guarantees the shards start with no bits set.
+    if (UTILS_UNLIKELY(!mFroxelShardedData.data())) {
+        mFroxelShardedData = { new FroxelThreadData[GROUP_COUNT](), uint32_t(GROUP_COUNT) };
+        mLightParamsCache.reset(new LightParams[CONFIG_MAX_LIGHT_COUNT]);
+    }
 
     assert_invariant(mFroxelBufferUser.begin());
     assert_invariant(mRecordBufferUser.begin());
@@ -261,7 +275,7 @@ void Froxelizer::computeFroxelLayout(
 }
 
 UTILS_NOINLINE
-void Froxelizer::updateBoundingSpheres(
+void Froxelizer::updateBoundingSpheres(JobSystem& js,
         math::float4* const UTILS_RESTRICT boundingSpheres,
         size_t froxelCountX, size_t froxelCountY, size_t froxelCountZ,
         math::float4 const* UTILS_RESTRICT planesX,
@@ -270,8 +284,6 @@ void Froxelizer::updateBoundingSpheres(
 
     SYSTRACE_CALL();
 
-    // TODO: this could potentially be parallel_for'ized
-
     /*
      * Now compute the bounding sphere of each froxel, which is needed for spotlights
      * We intersect 3 planes of the frustum to find each 8 corners.
@@ -280,44 +292,55 @@ void Froxelizer::updateBoundingSpheres(
     UTILS_ASSUME(froxelCountX > 0);
     UTILS_ASSUME(froxelCountY > 0);
 
-    for (size_t iz = 0, fi = 0, nz = froxelCountZ; iz < nz; ++iz) {
-        float4 planes[6];
-        planes[4] =  float4{ 0, 0, 1, planesZ[iz + 0] };
-        planes[5] = -float4{ 0, 0, 1, planesZ[iz + 1] };
-        for (size_t iy = 0, ny = froxelCountY; iy < ny; ++iy) {
-            planes[2] =  planesY[iy];
-            planes[3] = -planesY[iy + 1];
-            for (size_t ix = 0, nx = froxelCountX; ix < nx; ++ix) {
-                planes[0] =  planesX[ix];
-                planes[1] = -planesX[ix + 1];
-
-                float3 const p0 = planeIntersection(planes[0], planes[2], planes[4]);
-                float3 const p1 = planeIntersection(planes[1], planes[2], planes[4]);
-                float3 const p2 = planeIntersection(planes[0], planes[3], planes[4]);
-                float3 const p3 = planeIntersection(planes[1], planes[3], planes[4]);
-                float3 const p4 = planeIntersection(planes[0], planes[2], planes[5]);
-                float3 const p5 = planeIntersection(planes[1], planes[2], planes[5]);
-                float3 const p6 = planeIntersection(planes[0], planes[3], planes[5]);
-                float3 const p7 = planeIntersection(planes[1], planes[3], planes[5]);
-
-                float3 const c = (p0 + p1 + p2 + p3 + p4 + p5 + p6 + p7) * 0.125f;
-
-                float const d0 = length2(p0 - c);
-                float const d1 = length2(p1 - c);
-                float const d2 = length2(p2 - c);
-                float const d3 = length2(p3 - c);
-                float const d4 = length2(p4 - c);
-                float const d5 = length2(p5 - c);
-                float const d6 = length2(p6 - c);
-                float const d7 = length2(p7 - c);
-
-                float const r = std::sqrt(std::max({ d0, d1, d2, d3, d4, d5, d6, d7 }));
-
-                assert_invariant(getFroxelIndex(ix, iy, iz, froxelCountX, froxelCountY) == fi);
-                boundingSpheres[fi++] = { c, r };
+    // each z-slice is independent, so we spread the work over slices. This only runs when the
+    // viewport or projection changes, but with 8192 froxels the serial loop is long enough to
+    // cause a visible hitch on e.g. window resizes.
+    auto process = [=](uint32_t const startZ, uint32_t const countZ) {
+        SYSTRACE_NAME("FroxelBoundingSpheres Job");
+        for (size_t iz = startZ, nz = startZ + countZ,
+                fi = startZ * froxelCountX * froxelCountY; iz < nz; ++iz) {
+            float4 planes[6];
+            planes[4] =  float4{ 0, 0, 1, planesZ[iz + 0] };
+            planes[5] = -float4{ 0, 0, 1, planesZ[iz + 1] };
+            for (size_t iy = 0, ny = froxelCountY; iy < ny; ++iy) {
+                planes[2] =  planesY[iy];
+                planes[3] = -planesY[iy + 1];
+                for (size_t ix = 0, nx = froxelCountX; ix < nx; ++ix) {
+                    planes[0] =  planesX[ix];
+                    planes[1] = -planesX[ix + 1];
+
+                    float3 const p0 = planeIntersection(planes[0], planes[2], planes[4]);
+                    float3 const p1 = planeIntersection(planes[1], planes[2], planes[4]);
+                    float3 const p2 = planeIntersection(planes[0], planes[3], planes[4]);
+                    float3 const p3 = planeIntersection(planes[1], planes[3], planes[4]);
+                    float3 const p4 = planeIntersection(planes[0], planes[2], planes[5]);
+                    float3 const p5 = planeIntersection(planes[1], planes[2], planes[5]);
+                    float3 const p6 = planeIntersection(planes[0], planes[3], planes[5]);
+                    float3 const p7 = planeIntersection(planes[1], planes[3], planes[5]);
+
+                    float3 const c = (p0 + p1 + p2 + p3 + p4 + p5 + p6 + p7) * 0.125f;
+
+                    float const d0 = length2(p0 - c);
+                    float const d1 = length2(p1 - c);
+                    float const d2 = length2(p2 - c);
+                    float const d3 = length2(p3 - c);
+                    float const d4 = length2(p4 - c);
+                    float const d5 = length2(p5 - c);
+                    float const d6 = length2(p6 - c);
+                    float const d7 = length2(p7 - c);
+
+                    float const r = std::sqrt(std::max({ d0, d1, d2, d3, d4, d5, d6, d7 }));
+
+                    assert_invariant(getFroxelIndex(ix, iy, iz, froxelCountX, froxelCountY) == fi);
+                    boundingSpheres[fi++] = { c, r };
+                }
             }
         }
-    }
+    };
+
+    js.runAndWait(jobs::parallel_for(js, nullptr,
+            0, uint32_t(froxelCountZ),
+            std::cref(process), jobs::CountSplitter<1, 4>()));
 }
 
 UTILS_NOINLINE
@@ -422,7 +445,7 @@ bool Froxelizer::update() noexcept {
             planesY[i] = float4{ normalize(p.xyz), 0 };  // p.w is guaranteed to be 0
         }
 
-        updateBoundingSpheres(mBoundingSpheres,
+        updateBoundingSpheres(mEngine.getJobSystem(), mBoundingSpheres,
                 mFroxelCountX, mFroxelCountY, mFroxelCountZ,
                 planesX, planesY, mDistancesZ);
 
@@ -452,6 +475,8 @@ bool Froxelizer::update() noexcept {
         uniformsNeedUpdating = true;
     }
     assert_invariant(mZLightNear >= mNear);
+    // the froxel grid changed, every cached light/froxel assignment is stale
+    mShardedDataValid = false;
     mDirtyFlags = 0;
     return uniformsNeedUpdating;
 }
@@ -502,16 +527,24 @@ std::pair<size_t, size_t> Froxelizer::clipToIndices(float2 const& clip) const no
 
 void Froxelizer::commit(backend::DriverApi& driverApi) {
     // send data to GPU
-    driverApi.updateBufferObject(mFroxelsBuffer,
-            { mFroxelBufferUser.data(), getFroxelBufferEntryCount() * 16u }, 0);
 
-    driverApi.updateBufferObject(mRecordsBuffer,
-            { mRecordBufferUser.data(), RECORD_BUFFER_ENTRY_COUNT }, 0);
+    // the froxel grid can be smaller than the buffer's capacity (some entries are lost to
+    // the viewport's aspect ratio), so only upload the entries the shader can index.
+    size_t const froxelsSize = (mFroxelCount * sizeof(FroxelEntry) + 15u) & ~15u;  // round up to uint4
+    driverApi.updateBufferObject(mFroxelsBuffer,
+            { mFroxelBufferUser.data(), froxelsSize }, 0);
+
+    // only the records actually referenced by froxels need to be uploaded -- scenes with few
+    // lights use a small fraction of the buffer.
+    size_t const recordsSize = (size_t(mRecordBufferUsed) + 15u) & ~15u;  // round up to uint4
+    if (recordsSize) {
+        driverApi.updateBufferObject(mRecordsBuffer,
+                { mRecordBufferUser.data(), recordsSize }, 0);
+    }
 
 #ifndef NDEBUG
     mFroxelBufferUser.clear();
     mRecordBufferUser.clear();
-    mFroxelShardedData.clear();
 #endif
 }
 
@@ -520,7 +553,7 @@ void Froxelizer::froxelizeLights(FEngine& engine,
         const FScene::LightSoa& UTILS_RESTRICT lightData) noexcept {
     // note: this is called asynchronously
     froxelizeLoop(engine, viewMatrix, lightData);
-    froxelizeAssignRecordsCompress();
+    froxelizeAssignRecordsCompress(engine);
 
 #ifndef NDEBUG
     if (lightData.size()) {
@@ -552,14 +585,23 @@ void Froxelizer::froxelizeLoop(FEngine& engine,
     SYSTRACE_CALL();
 
     Slice<FroxelThreadData> froxelThreadData = mFroxelShardedData;
-    memset(froxelThreadData.data(), 0, froxelThreadData.sizeInBytes());
 
     auto& lcm = engine.getLightManager();
     auto const* UTILS_RESTRICT spheres      = lightData.data<FScene::POSITION_RADIUS>();
     auto const* UTILS_RESTRICT directions   = lightData.data<FScene::DIRECTION>();
     auto const* UTILS_RESTRICT instances    = lightData.data<FScene::LIGHT_INSTANCE>();
 
-    auto process = [ this, &froxelThreadData,
+    // A light's froxel bits depend only on the froxel grid (which invalidates the cache
+    // wholesale, see update()) and on its view-space parameters; comparing the parameters
+    // against the previous frame's tells us exactly which lights need re-froxelizing.
+    // Because positions and axes are in view-space, a camera move naturally dirties every
+    // light, while a static camera over static lights skips (almost) all of the
+    // sphere/froxel intersection work.
+    LightParams* const UTILS_RESTRICT cache = mLightParamsCache.get();
+    bool const cacheValid = mShardedDataValid;
+    size_t const cachedCount = mCachedLightCount;
+
+    auto process = [ this, &froxelThreadData, cache, cacheValid, cachedCount,
                      spheres, directions, instances, &viewMatrix, &lcm ]
             (size_t count, size_t offset, size_t stride) {
 
@@ -573,7 +615,21 @@ void Froxelizer::froxelizeLoop(FEngine& engine,
         constexpr float maxInvSin = 114.59301f;         // 1 / sin(0.5 degrees)
         constexpr float maxCosSquared = 0.99992385f;    // cos(0.5 degrees)^2
 
-        for (size_t i = offset; i < count; i += stride) {
+        // update this job's slots of the parameter cache, and record which lights changed
+        // or disappeared since the previous frame. Stale bits must be cleared even when
+        // the cache is invalid, because the shards persist across frames.
+        LightGroupType dirty[GROUP_COUNT] = {};
+        for (size_t i = offset, n = std::max(count, cachedCount); i < n; i += stride) {
+            const size_t group = i % GROUP_COUNT;
+            const size_t bit   = i / GROUP_COUNT;
+            assert_invariant(bit < LIGHT_PER_GROUP);
+
+            if (UTILS_UNLIKELY(i >= count)) {
+                // this light no longer exists, its bits just need to be cleared
+                dirty[group] |= LightGroupType(1) << bit;
+                continue;
+            }
+
             const size_t j = i + FScene::DIRECTIONAL_LIGHTS_COUNT;
             FLightManager::Instance const li = instances[j];
             LightParams light = {
@@ -588,12 +644,34 @@ void Froxelizer::froxelizeLoop(FEngine& engine,
                 light.invSin = std::min(maxInvSin, light.invSin);
             }
 
+            // bitwise comparison is conservative (e.g. -0 vs +0 re-froxelizes), which is
+            // exactly what we want -- a false "equal" is impossible.
+            bool const changed = !cacheValid || i >= cachedCount
+                    || memcmp(&cache[i], &light, sizeof(LightParams)) != 0;
+            cache[i] = light;
+            dirty[group] |= LightGroupType(changed ? 1 : 0) << bit;
+        }
+
+        // clear the changed lights' bits from the shards, one sweep per dirty group
+        // (this job only ever sets dirty bits for the groups it owns)
+        for (size_t group = 0; group < GROUP_COUNT; group++) {
+            LightGroupType const mask = dirty[group];
+            if (mask) {
+                LightGroupType* const UTILS_RESTRICT shard = froxelThreadData[group].data();
+                // this loop vectorizes
+                for (size_t f = 0; f < FROXEL_BUFFER_MAX_ENTRY_COUNT; f++) {
+                    shard[f] &= ~mask;
+                }
+            }
+        }
+
+        // finally, froxelize the changed lights only
+        for (size_t i = offset; i < count; i += stride) {
             const size_t group = i % GROUP_COUNT;
             const size_t bit   = i / GROUP_COUNT;
-            assert_invariant(bit < LIGHT_PER_GROUP);
-
-            FroxelThreadData& threadData = froxelThreadData[group];
-            froxelizePointAndSpotLight(threadData, bit, projection, light);
+            if (dirty[group] & (LightGroupType(1) << bit)) {
+                froxelizePointAndSpotLight(froxelThreadData[group], bit, projection, cache[i]);
+            }
         }
     };
 
@@ -613,9 +691,13 @@ void Froxelizer::froxelizeLoop(FEngine& engine,
                 lightData.size() - FScene::DIRECTIONAL_LIGHTS_COUNT, 0, 1)
         );
     }
+
+    // the shards and the parameter cache now reflect this frame's lights
+    mCachedLightCount = uint32_t(lightData.size() - FScene::DIRECTIONAL_LIGHTS_COUNT);
+    mShardedDataValid = true;
 }
 
-void Froxelizer::froxelizeAssignRecordsCompress() noexcept {
+void Froxelizer::froxelizeAssignRecordsCompress(FEngine& engine) noexcept {
 
     SYSTRACE_CALL();
 
@@ -625,25 +707,39 @@ void Froxelizer::froxelizeAssignRecordsCompress() noexcept {
     // easily compare adjacent froxels, for compaction. The conversion loops below get
     // inlined and vectorized in release builds.
 
-    // this gets very well vectorized...
+    // each froxel is independent here, so we spread the conversion over froxel ranges
+    // (the per-range loop itself gets very well vectorized); each job also computes a
+    // partial "all lights" reduction, merged below.
 
     utils::Slice<LightRecord> records(mLightRecords);
-    for (size_t j = 0, jc = getFroxelBufferEntryCount(); j < jc; j++) {
-        for (size_t i = 0; i < LightRecord::bitset::WORLD_COUNT; i++) {
-            using container_type = LightRecord::bitset::container_type;
-            constexpr size_t r = sizeof(container_type) / sizeof(LightGroupType);
-            container_type b = froxelThreadData[i * r][j];
-            for (size_t k = 0; k < r; k++) {
-                b |= (container_type(froxelThreadData[i * r + k][j]) << (LIGHT_PER_GROUP * k));
+
+    utils::Mutex allLightsLock;
+    LightRecord::bitset allLights{};
+
+    auto convert = [&froxelThreadData, &records, &allLightsLock, &allLights]
+            (uint32_t const start, uint32_t const c) {
+        SYSTRACE_NAME("FroxelizeConvert Job");
+        LightRecord::bitset partial{};
+        for (size_t j = start, jc = start + c; j < jc; j++) {
+            for (size_t i = 0; i < LightRecord::bitset::WORLD_COUNT; i++) {
+                using container_type = LightRecord::bitset::container_type;
+                constexpr size_t r = sizeof(container_type) / sizeof(LightGroupType);
+                container_type b = froxelThreadData[i * r][j];
+                for (size_t k = 0; k < r; k++) {
+                    b |= (container_type(froxelThreadData[i * r + k][j]) << (LIGHT_PER_GROUP * k));
+                }
+                records[j].lights.getBitsAt(i) = b;
             }
-            records[j].lights.getBitsAt(i) = b;
+            partial |= records[j].lights;
         }
-    }
+        std::lock_guard const guard(allLightsLock);
+        allLights |= partial;
+    };
 
-    LightRecord::bitset allLights{};
-    for (size_t j = 0, jc = getFroxelBufferEntryCount(); j < jc; j++) {
-        allLights |= records[j].lights;
-    }
+    JobSystem& js = engine.getJobSystem();
+    js.runAndWait(jobs::parallel_for(js, nullptr,
+            0, uint32_t(getFroxelBufferEntryCount()),
+            std::cref(convert), jobs::CountSplitter<512, 4>()));
 
     uint16_t offset = 0;
     FroxelEntry* const UTILS_RESTRICT froxels = mFroxelBufferUser.data();
@@ -732,7 +828,7 @@ void Froxelizer::froxelizeAssignRecordsCompress() noexcept {
     }
 out_of_memory:
     // FIXME: on big-endian systems we need to change the endianness of the record buffer
-    ;
+    mRecordBufferUsed = offset;
 }
 
 static inline float2 project(mat4f const& p, float3 const& v) noexcept {
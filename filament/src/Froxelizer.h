@@ -33,6 +33,8 @@
 #include <math/mat4.h>
 #include <math/vec4.h>
 
+#include <memory>
+
 namespace filament {
 
 // Max number of froxels limited by:
@@ -198,7 +200,7 @@ private:
     void froxelizeLoop(FEngine& engine,
             math::mat4f const& viewMatrix, const FScene::LightSoa& lightData) noexcept;
 
-    void froxelizeAssignRecordsCompress() noexcept;
+    void froxelizeAssignRecordsCompress(FEngine& engine) noexcept;
 
     void froxelizePointAndSpotLight(FroxelThreadData& froxelThread, size_t bit,
             math::mat4f const& projection, const LightParams& light) const noexcept;
@@ -207,7 +209,7 @@ private:
             utils::Slice<RecordBufferType> const& lightList,
             const FScene::LightSoa& lightData, size_t lightRecordsOffset) noexcept;
 
-    static void updateBoundingSpheres(
+    static void updateBoundingSpheres(utils::JobSystem& js,
             math::float4* UTILS_RESTRICT boundingSpheres,
             size_t froxelCountX, size_t froxelCountY, size_t froxelCountZ,
             math::float4 const* UTILS_RESTRICT planesX,
@@ -231,6 +233,8 @@ private:
             math::uint2* dim, uint16_t* countX, uint16_t* countY, uint16_t* countZ,
             size_t froxelBufferEntryCount, Viewport const& viewport) noexcept;
 
+    FEngine& mEngine;
+
     // internal state dependent on the viewport and needed for froxelizing
     LinearAllocatorArena mArena;                        // ~256 KiB
 
@@ -243,14 +247,22 @@ private:
     math::float4* mPlanesY = nullptr;
     math::float4* mBoundingSpheres = nullptr;           // 128 KiB w/ 8192 froxels
 
-    // allocations in the per frame arena
+    // persistent state for incremental froxelization: the sharded froxel bits and the
+    // view-space light parameters they were computed from are kept across frames, so
+    // froxelizeLoop() only re-froxelizes the lights whose parameters actually changed.
     utils::Slice<FroxelThreadData> mFroxelShardedData;  // 256 KiB w/  256 lights and 8192 froxels
+    std::unique_ptr<LightParams[]> mLightParamsCache;   //   9 KiB w/  256 lights
+    uint32_t mCachedLightCount = 0;                     // number of lights froxelized last frame
+    bool mShardedDataValid = false;                     // cleared when the froxel grid changes
+
+    // allocations in the per frame arena
     utils::Slice<FroxelEntry> mFroxelBufferUser;        //  32 KiB w/ 8192 froxels
     utils::Slice<LightRecord> mLightRecords;            // 256 KiB w/  256 lights
 
     // allocations in the command stream
     utils::Slice<RecordBufferType> mRecordBufferUser;   //  16 KiB
 
+    uint16_t mRecordBufferUsed = 0;     // number of record buffer entries referenced by froxels
     uint16_t mFroxelCountX = 0;
     uint16_t mFroxelCountY = 0;
     uint16_t mFroxelCountZ = 0;
@@ -29,6 +29,15 @@ Frustum::Frustum(const mat4f& pv) {
     Frustum::setProjection(pv);
 }
 
+Frustum::Frustum(float4 const planes[6]) noexcept {
+    mPlanes[0] = planes[0];
+    mPlanes[1] = planes[1];
+    mPlanes[2] = planes[2];
+    mPlanes[3] = planes[3];
+    mPlanes[4] = planes[4];
+    mPlanes[5] = planes[5];
+}
+
 // NOTE: if we don't specify noinline here, LLVM inlines this huge function into
 // two (?!) version of the Frustum(const mat4f& pv) constructor!
 
@@ -23,55 +23,16 @@ namespace filament {
 using namespace utils;
 using namespace backend;
 
-bool operator<(HwRenderPrimitiveFactory::Key const& lhs,
-        HwRenderPrimitiveFactory::Key const& rhs) noexcept {
-    if (lhs.vbh == rhs.vbh) {
-        if (lhs.ibh == rhs.ibh) {
-            if (lhs.offset == rhs.offset) {
-                if (lhs.count == rhs.count) {
-                    return lhs.type < rhs.type;
-                } else {
-                    return lhs.count < rhs.count;
-                }
-            } else {
-                return lhs.offset < rhs.offset;
-            }
-        } else {
-            return lhs.ibh < rhs.ibh;
-        }
-    } else {
-        return lhs.vbh < rhs.vbh;
-    }
-}
-
-inline bool operator<(HwRenderPrimitiveFactory::Entry const& lhs,
-        HwRenderPrimitiveFactory::Entry const& rhs) noexcept {
-    return lhs.key < rhs.key;
-}
-
-inline bool operator<(HwRenderPrimitiveFactory::Key const& lhs,
-        HwRenderPrimitiveFactory::Entry const& rhs) noexcept {
-    return lhs < rhs.key;
-}
-
-inline bool operator<(HwRenderPrimitiveFactory::Entry const& lhs,
-        HwRenderPrimitiveFactory::Key const& rhs) noexcept {
-    return lhs.key < rhs;
-}
-
-// ------------------------------------------------------------------------------------------------
-
-HwRenderPrimitiveFactory::HwRenderPrimitiveFactory()
-        : mArena("HwRenderPrimitiveFactory::mArena", SET_ARENA_SIZE),
-          mSet(mArena) {
+HwRenderPrimitiveFactory::HwRenderPrimitiveFactory() {
     mMap.reserve(256);
+    mReverseMap.reserve(256);
 }
 
 HwRenderPrimitiveFactory::~HwRenderPrimitiveFactory() noexcept = default;
 
 void HwRenderPrimitiveFactory::terminate(DriverApi& driver) noexcept {
     assert_invariant(mMap.empty());
-    assert_invariant(mSet.empty());
+    assert_invariant(mReverseMap.empty());
 }
 
 RenderPrimitiveHandle HwRenderPrimitiveFactory::create(DriverApi& driver,
@@ -82,36 +43,37 @@ RenderPrimitiveHandle HwRenderPrimitiveFactory::create(DriverApi& driver,
     const Key key = { vbh, ibh, offset, count, type };
 
     // see if we already have seen this RenderPrimitive
-    auto pos = mSet.find(key);
+    auto pos = mMap.find(key);
 
     // the common case is that we've never seen it (i.e.: no reuse)
-    if (UTILS_LIKELY(pos == mSet.end())) {
+    if (UTILS_LIKELY(pos == mMap.end())) {
         // create the backend object
         auto handle = driver.createRenderPrimitive(vbh, ibh,
                 type, offset, minIndex, maxIndex, count);
-        // insert key/handle in our set with a refcount of 1
-        // IMPORTANT: std::set<> doesn't invalidate iterators in insert/erase
-        auto [ipos, _] = mSet.insert({ key, handle, 1 });
-        // map the handle back to the key/payload
-        mMap.insert({ handle.getId(), ipos });
+        // insert key/handle in our map with a refcount of 1
+        mMap.insert({ key, { handle, 1 }});
+        // map the handle back to the key. The key is stored by value because the
+        // map's iterators don't survive a rehash.
+        mReverseMap.insert({ handle.getId(), key });
         return handle;
     }
-    pos->refs++;
-    return pos->handle;
+    pos.value().refs++;
+    return pos->second.handle;
 }
 
 void HwRenderPrimitiveFactory::destroy(DriverApi& driver, RenderPrimitiveHandle rph) noexcept {
-    // look for this handle in our map
-    auto pos = mMap.find(rph.getId());
+    // look for this handle in our reverse map
+    auto pos = mReverseMap.find(rph.getId());
 
     // it must be there
-    assert_invariant(pos != mMap.end());
+    assert_invariant(pos != mReverseMap.end());
 
     // check the refcount and destroy if needed
-    auto ipos = pos->second;
-    if (--ipos->refs == 0) {
-        mSet.erase(ipos);
-        mMap.erase(pos);
+    auto ipos = mMap.find(pos->second);
+    assert_invariant(ipos != mMap.end());
+    if (--ipos.value().refs == 0) {
+        mMap.erase(ipos);
+        mReverseMap.erase(pos);
         driver.destroyRenderPrimitive(rph);
     }
 }
@@ -22,12 +22,10 @@
 
 #include <private/backend/DriverApi.h>
 
-#include <utils/Allocator.h>
+#include <utils/Hash.h>
 
 #include <tsl/robin_map.h>
 
-#include <set>
-
 #include <stdint.h>
 
 namespace filament {
@@ -65,52 +63,45 @@ private:
         backend::IndexBufferHandle ibh;             // 4
         uint32_t offset;                            // 4
         uint32_t count;                             // 4
-        backend::PrimitiveType type;                // 4
+        backend::PrimitiveType type;                // 1 (+3 padding)
     };
 
-    struct Entry { // 28 bytes
-        Key key;                                    // 20
-        backend::RenderPrimitiveHandle handle;      //  4
-        mutable uint32_t refs;                      //  4
+    struct Entry { // 8 bytes
+        backend::RenderPrimitiveHandle handle;      // 4
+        uint32_t refs;                              // 4
     };
 
+    // hash/compare the key field by field, the struct has padding bytes
+    struct KeyHasher {
+        size_t operator()(Key const& key) const noexcept {
+            uint32_t const words[5] = {
+                    key.vbh.getId(), key.ibh.getId(),
+                    key.offset, key.count, uint32_t(key.type) };
+            return utils::hash::murmur3(words, 5, 0);
+        }
+    };
 
-    // Size of the arena used for the "set" part of the bimap
-    static constexpr size_t SET_ARENA_SIZE = 4 * 1024 * 1024;
-
-    // Arena for the set<>, using a pool allocator inside a heap area.
-    using Arena = utils::Arena<
-            utils::PoolAllocator<64>,   // this seems to work with clang and msvc
-            utils::LockingPolicy::NoLock,
-#ifndef NDEBUG
-            utils::TrackingPolicy::HighWatermark,
-#else
-            utils::TrackingPolicy::Untracked,
-#endif
-            utils::AreaPolicy::HeapArea>;
+    struct KeyEqual {
+        bool operator()(Key const& lhs, Key const& rhs) const noexcept {
+            return lhs.vbh == rhs.vbh && lhs.ibh == rhs.ibh
+                    && lhs.offset == rhs.offset && lhs.count == rhs.count
+                    && lhs.type == rhs.type;
+        }
+    };
 
-    using Set = std::set<
-            Entry,
-            std::less<>,
-            utils::STLAllocator<Entry, Arena>>;
+    // both sides of the bimap are open-addressing flat maps, render-loop lookups
+    // don't chase nodes
+    using Map = tsl::robin_map<Key, Entry, KeyHasher, KeyEqual>;
 
-    using Map = tsl::robin_map<
+    using ReverseMap = tsl::robin_map<
             backend::RenderPrimitiveHandle::HandleId,
-            Set::const_iterator>;
-
-    // Arena where the set memory is allocated
-    Arena mArena;
-
-    // set of HwRenderPrimitive data
-    Set mSet;
+            Key>;
 
-    // map of RenderPrimitiveHandle to Set Entry
+    // HwRenderPrimitive data keyed by the construction parameters
     Map mMap;
 
-    friend bool operator<(Key const& lhs, Key const& rhs) noexcept;
-    friend bool operator<(Key const& lhs, Entry const& rhs) noexcept;
-    friend bool operator<(Entry const& lhs, Key const& rhs) noexcept;
-    friend bool operator<(Entry const& lhs, Entry const& rhs) noexcept;
+    // maps a RenderPrimitiveHandle back to its construction key
+    ReverseMap mReverseMap;
 };
 
 } // namespace filament
@@ -340,4 +340,12 @@ bool MaterialInstance::isDepthCullingEnabled() const noexcept {
     return downcast(this)->isDepthCullingEnabled();
 }
 
+void MaterialInstance::setUniformDeduplicationEnabled(bool enabled) noexcept {
+    downcast(this)->setUniformDeduplicationEnabled(enabled);
+}
+
+bool MaterialInstance::isUniformDeduplicationEnabled() const noexcept {
+    return downcast(this)->isUniformDeduplicationEnabled();
+}
+
 } // namespace filament
@@ -44,8 +44,9 @@ namespace filament {
 
 // ------------------------------------------------------------------------------------------------
 
-MaterialParser::MaterialParserDetails::MaterialParserDetails(ShaderLanguage language, const void* data, size_t size)
-        : mManagedBuffer(data, size),
+MaterialParser::MaterialParserDetails::MaterialParserDetails(ShaderLanguage language,
+        const void* data, size_t size, bool copyPayload)
+        : mManagedBuffer(data, size, copyPayload),
           mChunkContainer(mManagedBuffer.data(), mManagedBuffer.size()),
           mMaterialChunk(mChunkContainer) {
     switch (language) {
@@ -83,8 +84,9 @@ bool MaterialParser::MaterialParserDetails::getFromSimpleChunk(
 
 // ------------------------------------------------------------------------------------------------
 
-MaterialParser::MaterialParser(ShaderLanguage language, const void* data, size_t size)
-        : mImpl(language, data, size) {
+MaterialParser::MaterialParser(ShaderLanguage language, const void* data, size_t size,
+        bool copyPayload)
+        : mImpl(language, data, size, copyPayload) {
 }
 
 ChunkContainer& MaterialParser::getChunkContainer() noexcept {
@@ -48,7 +48,11 @@ struct MaterialConstant;
 
 class MaterialParser {
 public:
-    MaterialParser(backend::ShaderLanguage language, const void* data, size_t size);
+    // When copyPayload is false, the material data is referenced in place instead of being
+    // copied; the caller guarantees it stays valid and immutable for the parser's lifetime
+    // (e.g. a package compiled into the executable with resgen).
+    MaterialParser(backend::ShaderLanguage language, const void* data, size_t size,
+            bool copyPayload = true);
 
     MaterialParser(MaterialParser const& rhs) noexcept = delete;
     MaterialParser& operator=(MaterialParser const& rhs) noexcept = delete;
@@ -129,7 +133,8 @@ public:
 
 private:
     struct MaterialParserDetails {
-        MaterialParserDetails(backend::ShaderLanguage language, const void* data, size_t size);
+        MaterialParserDetails(backend::ShaderLanguage language, const void* data, size_t size,
+                bool copyPayload);
 
         template<typename T>
         bool getFromSimpleChunk(filamat::ChunkType type, T* value) const noexcept;
@@ -140,12 +145,18 @@ private:
         class ManagedBuffer {
             void* mStart = nullptr;
             size_t mSize = 0;
+            bool mOwned = true;
         public:
-            explicit ManagedBuffer(const void* start, size_t size)
-                    : mStart(malloc(size)), mSize(size) {
-                memcpy(mStart, start, size);
+            explicit ManagedBuffer(const void* start, size_t size, bool copy = true)
+                    : mSize(size), mOwned(copy) {
+                if (copy) {
+                    mStart = malloc(size);
+                    memcpy(mStart, start, size);
+                } else {
+                    mStart = const_cast<void*>(start);
+                }
             }
-            ~ManagedBuffer() noexcept { free(mStart); }
+            ~ManagedBuffer() noexcept { if (mOwned) free(mStart); }
             ManagedBuffer(ManagedBuffer const& rhs) = delete;
             ManagedBuffer& operator=(ManagedBuffer const& rhs) = delete;
             void* data() const noexcept { return mStart; }
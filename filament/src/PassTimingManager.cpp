@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PassTimingManager.h"
+
+#include <utils/compiler.h>
+
+#include <algorithm>
+
+#include <string.h>
+
+namespace filament {
+
+using namespace backend;
+
+PassTimingManager::~PassTimingManager() noexcept = default;
+
+void PassTimingManager::terminate(DriverApi& driver) noexcept {
+    for (auto& frame : mFrames) {
+        for (auto& slot : frame.slots) {
+            if (slot.query) {
+                driver.destroyTimerQuery(slot.query);
+                slot.query = {};
+            }
+        }
+    }
+}
+
+void PassTimingManager::beginFrame(DriverApi& driver) noexcept {
+    // harvest the oldest pending frame, once all its results are available
+    Frame& oldest = mFrames[mLast];
+    if (oldest.pending) {
+        uint64_t elapsed[MAX_PASSES];
+        uint32_t ready = 0;
+        while (ready < oldest.count &&
+                driver.getTimerQueryValue(oldest.slots[ready].query, &elapsed[ready])) {
+            ready++;
+        }
+        if (ready == oldest.count) {
+            for (uint32_t i = 0; i < ready; i++) {
+                strncpy(mTimings[i].name, oldest.slots[i].name, sizeof(mTimings[i].name));
+                mTimings[i].gpuTimeNs = elapsed[i];
+                mTimings[i].cpuCycles = oldest.slots[i].cpuCycles;
+                mTimings[i].cpuL1DMisses = oldest.slots[i].cpuL1DMisses;
+                mTimings[i].cpuBranchMisses = oldest.slots[i].cpuBranchMisses;
+            }
+            mTimingsCount = ready;
+            oldest.pending = false;
+            mLast = (mLast + 1) % FRAME_COUNT;
+        }
+    }
+
+    // don't start measuring into a slot whose queries are still in flight
+    mActive = mEnabled && !mFrames[mIndex].pending;
+    if (mActive) {
+        mFrames[mIndex].count = 0;
+        if (UTILS_UNLIKELY(!mProfilerStarted)) {
+            // open the perf fds on first activation only; the counters then run continuously
+            // and each pass reads a snapshot on entry and exit
+            mProfiler.resetEvents(utils::Profiler::EV_CPU_CYCLES |
+                    utils::Profiler::EV_L1D_MISSES | utils::Profiler::EV_BPU_MISSES);
+            mProfiler.start();
+            mProfilerStarted = true;
+        }
+    }
+}
+
+void PassTimingManager::beginPass(DriverApi& driver, char const* name) noexcept {
+    if (!mActive) {
+        return;
+    }
+    Frame& frame = mFrames[mIndex];
+    if (UTILS_UNLIKELY(frame.count >= MAX_PASSES)) {
+        // more passes than we can measure, drop the extra ones
+        return;
+    }
+    Slot& slot = frame.slots[frame.count];
+    if (!slot.query) {
+        slot.query = driver.createTimerQuery();
+    }
+    strncpy(slot.name, name, sizeof(slot.name) - 1);
+    slot.name[sizeof(slot.name) - 1] = '\0';
+    driver.beginTimerQuery(slot.query);
+    mPassStart = mProfiler.readCounters();
+}
+
+void PassTimingManager::endPass(DriverApi& driver) noexcept {
+    if (!mActive) {
+        return;
+    }
+    Frame& frame = mFrames[mIndex];
+    if (UTILS_UNLIKELY(frame.count >= MAX_PASSES)) {
+        return;
+    }
+    Slot& slot = frame.slots[frame.count];
+    // read before enqueueing the end query, so the window excludes both query enqueues
+    auto const counters = mProfiler.readCounters() - mPassStart;
+    slot.cpuCycles = counters.getCpuCycles();
+    slot.cpuL1DMisses = counters.getL1DMisses();
+    slot.cpuBranchMisses = counters.getBranchMisses();
+    driver.endTimerQuery(slot.query);
+    frame.count++;
+}
+
+void PassTimingManager::endFrame(DriverApi&) noexcept {
+    if (mActive) {
+        Frame& frame = mFrames[mIndex];
+        frame.pending = frame.count > 0;
+        if (frame.pending) {
+            mIndex = (mIndex + 1) % FRAME_COUNT;
+        }
+        mActive = false;
+    }
+}
+
+size_t PassTimingManager::getPassTimings(PassTiming* timings, size_t count) const noexcept {
+    size_t const n = std::min(count, size_t(mTimingsCount));
+    std::copy_n(mTimings.begin(), n, timings);
+    return mTimingsCount;
+}
+
+} // namespace filament
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_PASSTIMINGMANAGER_H
+#define TNT_FILAMENT_PASSTIMINGMANAGER_H
+
+#include <filament/Renderer.h>
+
+#include "backend/Handle.h"
+#include <private/backend/DriverApi.h>
+
+#include <utils/Profiler.h>
+
+#include <array>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament {
+
+/*
+ * Brackets every executed FrameGraph pass with GPU timer queries and aggregates the results
+ * into per-pass timings, available a few frames later. Passes execute back-to-back on the
+ * backend, so plain (non-nested) time-elapsed queries are sufficient on every backend; the
+ * flip side is that the whole-frame query of FrameInfoManager must be suspended while this
+ * is active, because time-elapsed queries can't nest on OpenGL.
+ *
+ * Each pass is also bracketed with hardware PMU counter reads (cycles, cache misses, branch
+ * misses) on the calling thread, i.e. the thread generating the pass's commands. Those are
+ * available immediately, but they're surfaced together with the GPU results of the same
+ * frame so that a PassTiming is a coherent record. The perf fds are only opened once
+ * profiling is actually active; on platforms without perf events the counters read as zero.
+ */
+class PassTimingManager {
+    static constexpr size_t FRAME_COUNT = 4;    // frames in flight
+    static constexpr size_t MAX_PASSES = 48;    // per frame, extra passes are not measured
+
+public:
+    using PassTiming = Renderer::PassTiming;
+
+    ~PassTimingManager() noexcept;
+    void terminate(backend::DriverApi& driver) noexcept;
+
+    void setEnabled(bool enabled) noexcept { mEnabled = enabled; }
+    bool isEnabled() const noexcept { return mEnabled; }
+
+    // whether passes are being measured this frame (latched in beginFrame())
+    bool isActive() const noexcept { return mActive; }
+
+    // call this once per frame; harvests finished queries and starts a new measurement
+    void beginFrame(backend::DriverApi& driver) noexcept;
+
+    // called by the FrameGraph around each executed pass
+    void beginPass(backend::DriverApi& driver, char const* name) noexcept;
+    void endPass(backend::DriverApi& driver) noexcept;
+
+    void endFrame(backend::DriverApi& driver) noexcept;
+
+    // timings of the most recent fully measured frame, see Renderer::getPassTimings()
+    size_t getPassTimings(PassTiming* timings, size_t count) const noexcept;
+
+private:
+    struct Slot {
+        backend::Handle<backend::HwTimerQuery> query;   // created lazily
+        char name[sizeof(PassTiming::name)];
+        uint64_t cpuCycles = 0;
+        uint64_t cpuL1DMisses = 0;
+        uint64_t cpuBranchMisses = 0;
+    };
+
+    struct Frame {
+        std::array<Slot, MAX_PASSES> slots;
+        uint32_t count = 0;
+        bool pending = false;   // queries submitted, results not harvested yet
+    };
+
+    std::array<Frame, FRAME_COUNT> mFrames;
+    std::array<PassTiming, MAX_PASSES> mTimings;
+    uint32_t mTimingsCount = 0;
+    uint32_t mIndex = 0;
+    uint32_t mLast = 0;
+    bool mEnabled = false;
+    bool mActive = false;
+    bool mProfilerStarted = false;
+    utils::Profiler mProfiler;                      // events opened on first activation
+    utils::Profiler::Counters mPassStart = {};
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_PASSTIMINGMANAGER_H
@@ -30,7 +30,11 @@ using namespace math;
 
 PerShadowMapUniforms::PerShadowMapUniforms(FEngine& engine) noexcept {
     DriverApi& driver = engine.getDriverApi();
-    mUniformBufferHandle = driver.createBufferObject(sizeof(PerViewUib),
+    // PerViewUib is padded to 2 KiB, a multiple of the worst-case (256 bytes) uniform buffer
+    // offset alignment, so each slot of the UBO can be bound with an offset.
+    static_assert(sizeof(PerViewUib) % 256 == 0);
+    mUniformBufferHandle = driver.createBufferObject(
+            CONFIG_MAX_SHADOWMAPS * sizeof(PerViewUib),
             BufferObjectBinding::UNIFORM, BufferUsage::DYNAMIC);
 }
 
@@ -38,6 +42,26 @@ void PerShadowMapUniforms::terminate(DriverApi& driver) {
     driver.destroyBufferObject(mUniformBufferHandle);
 }
 
+void PerShadowMapUniforms::beginFrame(DriverApi& driver, size_t shadowMapCount) noexcept {
+    assert_invariant(shadowMapCount <= CONFIG_MAX_SHADOWMAPS);
+    assert_invariant(mUsed == 0);
+    // TODO: use out-of-line buffer if too large
+    mStaging = (PerViewUib*)driver.allocate(shadowMapCount * sizeof(PerViewUib), 16);
+    mStagingCapacity = uint32_t(shadowMapCount);
+    mUsed = 0;
+}
+
+void PerShadowMapUniforms::endFrame(DriverApi& driver) noexcept {
+    if (mUsed) {
+        // a single upload covers all the shadow maps committed this frame
+        driver.updateBufferObject(mUniformBufferHandle, {
+            mStaging, mUsed * sizeof(PerViewUib) }, 0);
+    }
+    mStaging = nullptr;
+    mStagingCapacity = 0;
+    mUsed = 0;
+}
+
 PerViewUib& PerShadowMapUniforms::edit(Transaction const& transaction) noexcept {
     assert_invariant(transaction.uniforms);
     return *transaction.uniforms;
@@ -104,23 +128,27 @@ void PerShadowMapUniforms::prepareShadowMapping(Transaction const& transaction,
 }
 
 
-PerShadowMapUniforms::Transaction PerShadowMapUniforms::open(backend::DriverApi& driver) noexcept {
+PerShadowMapUniforms::Transaction PerShadowMapUniforms::open() noexcept {
+    assert_invariant(mUsed < mStagingCapacity);
     Transaction transaction;
-    // TODO: use out-of-line buffer if too large
-    transaction.uniforms = (PerViewUib *)driver.allocate(sizeof(PerViewUib), 16);
+    transaction.uniforms = mStaging + mUsed;
+    transaction.offset = mUsed * sizeof(PerViewUib);
+    mUsed++;
     assert_invariant(transaction.uniforms);
     return transaction;
 }
 
-void PerShadowMapUniforms::commit(Transaction& transaction,
-        backend::DriverApi& driver) noexcept {
-    driver.updateBufferObject(mUniformBufferHandle, {
-        transaction.uniforms, sizeof(PerViewUib) }, 0);
+uint32_t PerShadowMapUniforms::commit(Transaction& transaction) noexcept {
+    // the data was written in-place into the staging area, the actual upload happens
+    // in endFrame(), all slots at once
+    uint32_t const offset = transaction.offset;
     transaction.uniforms = nullptr;
+    return offset;
 }
 
-void PerShadowMapUniforms::bind(backend::DriverApi& driver) noexcept {
-    driver.bindUniformBuffer(+UniformBindingPoints::PER_VIEW, mUniformBufferHandle);
+void PerShadowMapUniforms::bind(backend::DriverApi& driver, uint32_t offset) noexcept {
+    driver.bindBufferRange(BufferObjectBinding::UNIFORM, +UniformBindingPoints::PER_VIEW,
+            mUniformBufferHandle, offset, sizeof(PerViewUib));
 }
 
 } // namespace filament
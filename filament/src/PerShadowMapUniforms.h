@@ -38,10 +38,11 @@ class FEngine;
 class LightManager;
 
 /*
- * PerShadowMapUniforms manages the UBO needed to generate our shadow maps. Internally it just
- * holds onto a `PerViewUniform` UBO handle, but doesn't keep any shadow copy of it, instead it
- * writes the data directly into the commandstream, for this reason partial update of the data
- * is not possible.
+ * PerShadowMapUniforms manages the UBOs needed to generate our shadow maps. It holds a single
+ * UBO large enough for all shadow maps of a frame, each shadow map using its own slot within
+ * it, bound with an offset. It doesn't keep any shadow copy of the data, instead it writes the
+ * data directly into the commandstream, for this reason partial update of the data is not
+ * possible. All slots are uploaded together in a single buffer update per frame.
  */
 class PerShadowMapUniforms {
 
@@ -51,6 +52,7 @@ public:
     class Transaction {
         friend PerShadowMapUniforms;
         PerViewUib* uniforms = nullptr;
+        uint32_t offset = 0;
         Transaction() = default; // disallow creation by the caller
     };
 
@@ -58,6 +60,12 @@ public:
 
     void terminate(backend::DriverApi& driver);
 
+    // stage the uniform data of up to `shadowMapCount` shadow maps in the commandstream
+    void beginFrame(backend::DriverApi& driver, size_t shadowMapCount) noexcept;
+
+    // upload all the slots committed since beginFrame() in one buffer update
+    void endFrame(backend::DriverApi& driver) noexcept;
+
     static void prepareCamera(Transaction const& transaction,
             FEngine& engine, const CameraInfo& camera) noexcept;
 
@@ -73,17 +81,21 @@ public:
     static void prepareShadowMapping(Transaction const& transaction,
             bool highPrecision) noexcept;
 
-    static Transaction open(backend::DriverApi& driver) noexcept;
+    // grab the next free slot of the current frame
+    Transaction open() noexcept;
 
-    // update local data into GPU UBO
-    void commit(Transaction& transaction, backend::DriverApi& driver) noexcept;
+    // close the slot and return its offset in the UBO, to be used with bind()
+    uint32_t commit(Transaction& transaction) noexcept;
 
-    // bind this UBO
-    void bind(backend::DriverApi& driver) noexcept;
+    // bind the slot at `offset` of this UBO
+    void bind(backend::DriverApi& driver, uint32_t offset) noexcept;
 
 private:
     static PerViewUib& edit(Transaction const& transaction) noexcept;
     backend::Handle<backend::HwBufferObject> mUniformBufferHandle;
+    PerViewUib* mStaging = nullptr;
+    uint32_t mStagingCapacity = 0;
+    uint32_t mUsed = 0;
 };
 
 } // namespace filament
@@ -17,6 +17,7 @@
 #include "PerViewUniforms.h"
 
 #include "DFG.h"
+#include "FeatureFlags.h"
 #include "Froxelizer.h"
 #include "ShadowMapManager.h"
 
@@ -49,11 +50,16 @@ PerViewUniforms::PerViewUniforms(FEngine& engine) noexcept
     mUniformBufferHandle = driver.createBufferObject(mUniforms.getSize(),
             BufferObjectBinding::UNIFORM, BufferUsage::DYNAMIC);
 
-    if (engine.getDFG().isValid()) {
-        TextureSampler const sampler(TextureSampler::MagFilter::LINEAR);
-        mSamplers.setSampler(PerViewSib::IBL_DFG_LUT,
-                { engine.getDFG().getTexture(), sampler.getSamplerParams() });
+    // The DFG LUT is sampled by all lit materials, but engines that never create a View
+    // (e.g. headless or UI-only configurations) don't need it, so it's created here,
+    // when the first View appears, rather than at Engine creation.
+    DFG& dfg = engine.getDFG();
+    if (UTILS_UNLIKELY(!dfg.isValid())) {
+        dfg.init(engine);
     }
+    TextureSampler const sampler(TextureSampler::MagFilter::LINEAR);
+    mSamplers.setSampler(PerViewSib::IBL_DFG_LUT,
+            { dfg.getTexture(), sampler.getSamplerParams() });
 }
 
 void PerViewUniforms::terminate(DriverApi& driver) {
@@ -139,6 +145,9 @@ void PerViewUniforms::prepareTemporalNoise(FEngine& engine,
 
 void PerViewUniforms::prepareFog(FEngine& engine, const CameraInfo& cameraInfo,
         mat4 const& userWorldFromFog, FogOptions const& options, FIndirectLight const* ibl) noexcept {
+    if constexpr (!features::FOG) {
+        return; // fog is compiled out, the uniforms keep their disabled defaults
+    }
 
     auto packHalf2x16 = [](math::half2 v) -> uint32_t {
         short2 s;
@@ -249,6 +258,9 @@ void PerViewUniforms::prepareSSR(Handle<HwTexture> ssr,
         bool disableSSR,
         float refractionLodOffset,
         ScreenSpaceReflectionsOptions const& ssrOptions) noexcept {
+    if constexpr (!features::SSR) {
+        return; // ssrDistance stays 0, which disables SSR in the shader
+    }
 
     mSamplers.setSampler(PerViewSib::SSR, { ssr, {
         .filterMag = SamplerMagFilter::LINEAR,
@@ -264,6 +276,9 @@ void PerViewUniforms::prepareHistorySSR(Handle<HwTexture> ssr,
         math::mat4f const& historyProjection,
         math::mat4f const& uvFromViewMatrix,
         ScreenSpaceReflectionsOptions const& ssrOptions) noexcept {
+    if constexpr (!features::SSR) {
+        return;
+    }
 
     mSamplers.setSampler(PerViewSib::SSR, { ssr, {
         .filterMag = SamplerMagFilter::LINEAR,
@@ -377,6 +392,8 @@ void PerViewUniforms::prepareShadowSampling(PerViewUib& uniforms,
 void PerViewUniforms::prepareShadowVSM(Handle<HwTexture> texture,
         ShadowMappingUniforms const& shadowMappingUniforms,
         VsmShadowOptions const& options) noexcept {
+    // with VSM compiled out, FView::hasVSM() is constant-false and we can't be called
+    assert_invariant(features::VSM);
     constexpr float low  = 5.54f; // ~ std::log(std::numeric_limits<math::half>::max()) * 0.5f;
     constexpr float high = 42.0f; // ~ std::log(std::numeric_limits<float>::max()) * 0.5f;
     SamplerMinFilter filterMin = SamplerMinFilter::LINEAR;
@@ -447,7 +464,9 @@ void PerViewUniforms::commit(backend::DriverApi& driver) noexcept {
         driver.updateBufferObject(mUniformBufferHandle, mUniforms.toBufferDescriptor(driver), 0);
     }
     if (mSamplers.isDirty()) {
-        driver.updateSamplerGroup(mSamplerGroupHandle, mSamplers.toBufferDescriptor(driver));
+        uint64_t const dirtyMask = mSamplers.getDirtyMask();
+        driver.updateSamplerGroup(mSamplerGroupHandle,
+                mSamplers.toBufferDescriptor(driver), dirtyMask);
     }
 }
 
@@ -47,6 +47,7 @@
 #include <math/mat2.h>
 
 #include <utils/BitmaskEnum.h>
+#include <utils/Slice.h>
 
 #include <algorithm>
 #include <limits>
@@ -132,7 +133,7 @@ void PostProcessManager::PostProcessMaterial::loadMaterial(FEngine& engine) cons
     //       domain, load both OPAQUE and TRANSPARENT variants here.
     mHasMaterial = true;
     auto builder = Material::Builder();
-    builder.package(mData, mSize);
+    builder.trustedPackage(mData, mSize);
     for (auto const& constant : mConstants) {
         std::visit([&](auto&& arg) {
             builder.constant(constant.name.data(), constant.name.size(), arg);
@@ -236,6 +237,8 @@ static const PostProcessManager::MaterialInfo sMaterialList[] = {
         { "flare",                      MATERIAL(FLARE) },
         { "fxaa",                       MATERIAL(FXAA) },
         { "mipmapDepth",                MATERIAL(MIPMAPDEPTH) },
+        { "occlusionDepth",             MATERIAL(OCCLUSIONDEPTH) },
+        { "performanceHud",             MATERIAL(PERFORMANCEHUD) },
         { "sao",                        MATERIAL(SAO) },
         { "saoBentNormals",             MATERIAL(SAOBENTNORMALS) },
         { "separableGaussianBlur1",     MATERIAL(SEPARABLEGAUSSIANBLUR),
@@ -290,6 +293,16 @@ void PostProcessManager::init() noexcept {
         }
     }
 
+    // the starburst texture is created lazily, lens flare is typically disabled
+}
+
+Handle<HwTexture> PostProcessManager::getStarburstTexture() noexcept {
+    if (UTILS_LIKELY(mStarburstTexture)) {
+        return mStarburstTexture;
+    }
+
+    DriverApi& driver = mEngine.getDriverApi();
+
     mStarburstTexture = driver.createTexture(SamplerType::SAMPLER_2D, 1,
             TextureFormat::R8, 1, 256, 1, 1, TextureUsage::DEFAULT);
 
@@ -303,11 +316,15 @@ void PostProcessManager::init() noexcept {
     driver.update3DImage(mStarburstTexture,
             0, 0, 0, 0, 256, 1, 1,
             std::move(dataStarburst));
+
+    return mStarburstTexture;
 }
 
 void PostProcessManager::terminate(DriverApi& driver) noexcept {
     FEngine& engine = mEngine;
-    driver.destroyTexture(mStarburstTexture);
+    if (mStarburstTexture) {
+        driver.destroyTexture(mStarburstTexture);
+    }
     auto first = mMaterialRegistry.begin();
     auto last = mMaterialRegistry.end();
     while (first != last) {
@@ -420,7 +437,7 @@ PostProcessManager::StructurePassOutput PostProcessManager::structure(FrameGraph
                 });
             },
             [=, renderPass = pass](FrameGraphResources const& resources,
-                    auto const&, DriverApi&) mutable {
+                    auto const&, DriverApi& driver) mutable {
                 Variant structureVariant(Variant::DEPTH_VARIANT);
                 structureVariant.setPicking(config.picking);
 
@@ -429,7 +446,17 @@ PostProcessManager::StructurePassOutput PostProcessManager::structure(FrameGraph
                 renderPass.setVariant(structureVariant);
                 renderPass.appendCommands(mEngine, RenderPass::CommandTypeFlags::SSAO);
                 renderPass.sortCommands(mEngine);
-                renderPass.execute(mEngine, resources.getPassName(), out.target, out.params);
+                if (UTILS_UNLIKELY(!config.scissor.empty())) {
+                    // picking-only pass, only rasterize around the pending picking queries
+                    auto executor = renderPass.getExecutor();
+                    executor.overrideScissor(config.scissor);
+                    mEngine.flush(); // see RenderPass::execute()
+                    driver.beginRenderPass(out.target, out.params);
+                    executor.execute(mEngine, resources.getPassName());
+                    driver.endRenderPass();
+                } else {
+                    renderPass.execute(mEngine, resources.getPassName(), out.target, out.params);
+                }
             });
 
     auto depth = structurePass->depth;
@@ -473,6 +500,52 @@ PostProcessManager::StructurePassOutput PostProcessManager::structure(FrameGraph
     return { depth, structurePass->picking };
 }
 
+FrameGraphId<FrameGraphTexture> PostProcessManager::occlusionDepth(FrameGraph& fg,
+        FrameGraphId<FrameGraphTexture> structure) noexcept {
+
+    // size in pixels of the structure buffer tile covered by each texel of the reduced buffer
+    constexpr uint32_t kOcclusionTileSize = 16u;
+
+    struct OcclusionDepthPassData {
+        FrameGraphId<FrameGraphTexture> depth;
+        FrameGraphId<FrameGraphTexture> reduced;
+    };
+
+    // Reduce the structure buffer to a small grid holding the farthest depth of each tile.
+    // FView reads this buffer back asynchronously and uses it to occlusion-cull renderables
+    // one frame later (see FView::prepare()). We reduce from level 0 because the structure
+    // mip chain is decimated -- not conservative -- and can't be used for occlusion.
+    auto& occlusionDepthPass = fg.addPass<OcclusionDepthPassData>("Occlusion Depth Pass",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                auto const& desc = fg.getDescriptor(structure);
+                data.depth = builder.sample(structure);
+                data.reduced = builder.createTexture("Occlusion Depth Buffer", {
+                        .width  = (desc.width  + kOcclusionTileSize - 1u) / kOcclusionTileSize,
+                        .height = (desc.height + kOcclusionTileSize - 1u) / kOcclusionTileSize,
+                        .format = TextureFormat::R32F });
+                data.reduced = builder.write(data.reduced,
+                        FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+                builder.declareRenderPass("Occlusion Depth Target", {
+                        .attachments = { .color = { data.reduced }}});
+            },
+            [=](FrameGraphResources const& resources, auto const& data, DriverApi& driver) {
+                auto depth = resources.getTexture(data.depth);
+                auto const& outDesc = resources.getDescriptor(data.reduced);
+                auto out = resources.getRenderPassInfo();
+                auto& material = getPostProcessMaterial("occlusionDepth");
+                FMaterialInstance* const mi = material.getMaterialInstance(mEngine);
+                mi->setParameter("depth", depth,
+                        { .filterMin = SamplerMinFilter::NEAREST_MIPMAP_NEAREST });
+                mi->setParameter("resolution", float4{
+                        outDesc.width, outDesc.height,
+                        1.0f / outDesc.width, 1.0f / outDesc.height });
+                mi->setParameter("footprint", uint2{ kOcclusionTileSize, kOcclusionTileSize });
+                commitAndRender(out, material, driver);
+            });
+
+    return occlusionDepthPass->reduced;
+}
+
 // ------------------------------------------------------------------------------------------------
 
 FrameGraphId<FrameGraphTexture> PostProcessManager::ssr(FrameGraph& fg,
@@ -713,6 +786,9 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::screenSpaceAmbientOcclusion(
             [&](FrameGraph::Builder& builder, auto& data) {
                 auto const& desc = builder.getDescriptor(depth);
 
+                // only depends on the structure pass, may overlap other rendering
+                builder.queueHint(FrameGraph::QueueHint::ASYNC_COMPUTE);
+
                 data.depth = builder.sample(depth);
                 data.ssao = builder.createTexture("SSAO Buffer", {
                         .width = desc.width,
@@ -961,16 +1037,21 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::generateGaussianMipmap(Frame
     // create one subresource per level to be generated from the input. These will be our
     // destinations.
     struct MipmapPassData {
-        FixedCapacityVector<FrameGraphId<FrameGraphTexture>> out;
+        utils::Slice<FrameGraphId<FrameGraphTexture>> out;
     };
     auto& mipmapPass = fg.addPass<MipmapPassData>("Mipmap Pass",
             [&](FrameGraph::Builder& builder, auto& data) {
-                data.out.reserve(levels - 1);
+                // FrameGraphId is trivially destructible, so the list can live in the
+                // per-frame arena and be reclaimed wholesale at the end of the frame
+                // (no heap allocation).
+                auto* const out = mEngine.getPerRenderPassAllocator()
+                        .alloc<FrameGraphId<FrameGraphTexture>>(levels - 1);
+                data.out = { out, uint32_t(levels - 1) };
                 for (size_t i = 1; i < levels; i++) {
-                    data.out.push_back(builder.createSubresource(input,
+                    out[i - 1] = builder.createSubresource(input,
                             "Mipmap output", {
                                     .level = uint8_t(subResourceDesc.level + i),
-                                    .layer = subResourceDesc.layer }));
+                                    .layer = subResourceDesc.layer });
                 }
             });
 
@@ -1049,6 +1130,9 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::gaussianBlurPass(FrameGraph&
 
     auto& blurPass = fg.addPass<BlurPassData>("Gaussian Blur Pass (separable)",
             [&](FrameGraph::Builder& builder, auto& data) {
+                // only depends on its input (e.g. a VSM cascade), may overlap other rendering
+                builder.queueHint(FrameGraph::QueueHint::ASYNC_COMPUTE);
+
                 auto inDesc = builder.getDescriptor(input);
 
                 if (!output) {
@@ -2004,6 +2088,9 @@ PostProcessManager::BloomPassOutput PostProcessManager::bloomPass(FrameGraph& fg
 
     auto& bloomDownsamplePass = fg.addPass<BloomPassData>("Bloom Downsample",
             [&](FrameGraph::Builder& builder, auto& data) {
+                // self-contained mip chain generation, may overlap other rendering
+                builder.queueHint(FrameGraph::QueueHint::ASYNC_COMPUTE);
+
                 data.out = builder.createTexture("Bloom Out Texture", {
                         .width = width,
                         .height = height,
@@ -2291,7 +2378,6 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::customResolveUncompressPass(
             [=](FrameGraphResources const& resources, auto const&, DriverApi& driver) {
                 customResolvePrepareSubpass(driver, CustomResolveOp::UNCOMPRESS);
                 auto out = resources.getRenderPassInfo();
-                out.params.subpassMask = 1;
                 driver.beginRenderPass(out.target, out.params);
                 customResolveSubpass(driver);
                 driver.endRenderPass();
@@ -2328,7 +2414,7 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::colorGrading(FrameGraph& fg,
             starburst = fg.import("starburst", {
                     .width = 256, .height = 1, .format = TextureFormat::R8
             }, FrameGraphTexture::Usage::SAMPLEABLE,
-                    FrameGraphTexture{ .handle = mStarburstTexture });
+                    FrameGraphTexture{ .handle = getStarburstTexture() });
         }
     }
 
@@ -2554,6 +2640,7 @@ void PostProcessManager::configureTemporalAntiAliasingMaterial(
     setConstantParameter(ma, "preventFlickering", taaOptions.preventFlickering);
     setConstantParameter(ma, "boxType", (int32_t)taaOptions.boxType);
     setConstantParameter(ma, "boxClipping", (int32_t)taaOptions.boxClipping);
+    setConstantParameter(ma, "upscaling", taaOptions.upscaling);
     if (dirty) {
         ma->invalidate();
         // TODO: call Material::compile(), we can't si that now because it works only
@@ -2561,6 +2648,27 @@ void PostProcessManager::configureTemporalAntiAliasingMaterial(
     }
 }
 
+void PostProcessManager::applyStageScalePolicies(float2 scale,
+        AmbientOcclusionOptions& inoutAoOptions,
+        BloomOptions& inoutBloomOptions) const noexcept {
+    float const area = scale.x * scale.y;
+
+    // SSAO is low frequency and smoothed by its bilateral filter, it is the first stage
+    // to drop, to half of the scaled resolution.
+    constexpr float SSAO_HALF_RESOLUTION_AREA = 0.8f;
+    if (area <= SSAO_HALF_RESOLUTION_AREA) {
+        inoutAoOptions.resolution = 0.5f;
+    }
+
+    // The bloom chain is heavily blurred, cap its minor axis at 3/4 of the requested
+    // resolution before the primary scale factor reaches its floor.
+    constexpr float BLOOM_REDUCED_RESOLUTION_AREA = 0.6f;
+    if (area <= BLOOM_REDUCED_RESOLUTION_AREA) {
+        inoutBloomOptions.resolution = std::max(1u << inoutBloomOptions.levels,
+                inoutBloomOptions.resolution * 3u / 4u);
+    }
+}
+
 FrameGraphId<FrameGraphTexture> PostProcessManager::taa(FrameGraph& fg,
         FrameGraphId<FrameGraphTexture> input,
         FrameGraphId<FrameGraphTexture> depth,
@@ -2593,6 +2701,12 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::taa(FrameGraph& fg,
     auto& taaPass = fg.addPass<TAAData>("TAA",
             [&](FrameGraph::Builder& builder, auto& data) {
                 auto desc = fg.getDescriptor(input);
+                if (taaOptions.upscaling) {
+                    // the history (and output) lives at 2x the rendering resolution, the
+                    // resolve pass performs the reconstruction
+                    desc.width *= 2;
+                    desc.height *= 2;
+                }
                 data.color = builder.sample(input);
                 data.depth = builder.sample(depth);
                 data.history = builder.sample(colorHistory);
@@ -2670,9 +2784,6 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::taa(FrameGraph& fg,
                 const uint8_t variant = uint8_t(colorGradingConfig.translucent ?
                         PostProcessVariant::TRANSLUCENT : PostProcessVariant::OPAQUE);
 
-                if (colorGradingConfig.asSubpass) {
-                    out.params.subpassMask = 1;
-                }
                 PipelineState const pipeline(material.getPipelineState(mEngine, variant));
                 driver.beginRenderPass(out.target, out.params);
                 driver.draw(pipeline, mEngine.getFullScreenRenderPrimitive(), 1);
@@ -3034,6 +3145,9 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::vsmMipmapPass(FrameGraph& fg
 
     auto& depthMipmapPass = fg.addPass<VsmMipData>("VSM Generate Mipmap Pass",
             [&](FrameGraph::Builder& builder, auto& data) {
+                // only depends on the shadow map, may overlap the color passes
+                builder.queueHint(FrameGraph::QueueHint::ASYNC_COMPUTE);
+
                 const char* name = builder.getName(input);
                 data.in = builder.sample(input);
 
@@ -3122,4 +3236,40 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::debugShadowCascades(FrameGra
     return debugShadowCascadePass->output;
 }
 
+FrameGraphId<FrameGraphTexture> PostProcessManager::performanceHud(FrameGraph& fg,
+        FrameGraphId<FrameGraphTexture> input,
+        PerformanceHudInfo const& info) noexcept {
+
+    struct PerformanceHudData {
+        FrameGraphId<FrameGraphTexture> color;
+        FrameGraphId<FrameGraphTexture> output;
+    };
+    auto& performanceHudPass = fg.addPass<PerformanceHudData>("PerformanceHud",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                auto const& desc = builder.getDescriptor(input);
+                data.color = builder.sample(input);
+                data.output = builder.createTexture("Performance HUD", desc);
+                builder.declareRenderPass(data.output);
+            },
+            [=](FrameGraphResources const& resources, auto const& data, DriverApi& driver) {
+                auto color = resources.getTexture(data.color);
+                auto out = resources.getRenderPassInfo();
+                auto& material = getPostProcessMaterial("performanceHud");
+                PipelineState const pipeline(material.getPipelineState(mEngine));
+                FMaterialInstance* mi = material.getMaterialInstance(mEngine);
+                mi->setParameter("color", color, {});  // nearest
+                mi->setParameter("frameTimes", info.frameTimesMs,
+                        PerformanceHudInfo::HISTORY_SIZE / 4u);
+                mi->setParameter("params", float4{
+                        info.targetFrameTimeMs, float(info.frameTimeCount),
+                        info.jobSystemOccupancy, info.transientMemoryUsage });
+                mi->commit(driver);
+                mi->use(driver);
+
+                render(out, pipeline, driver);
+            });
+
+    return performanceHudPass->output;
+}
+
 } // namespace filament
@@ -25,6 +25,7 @@
 #include <fg/FrameGraphResources.h>
 
 #include <filament/Options.h>
+#include <filament/Viewport.h>
 
 #include <backend/DriverEnums.h>
 #include <backend/PipelineState.h>
@@ -78,6 +79,10 @@ public:
     struct StructurePassConfig {
         float scale = 0.5f;
         bool picking{};
+        // when non-empty, rasterization is restricted to this region of the structure
+        // buffer. Only used for picking-only passes, where the readbacks never touch
+        // pixels outside of it (see FView::getPickingQueriesArea()).
+        Viewport scissor{};
     };
 
     explicit PostProcessManager(FEngine& engine) noexcept;
@@ -90,6 +95,15 @@ public:
     void configureTemporalAntiAliasingMaterial(
             TemporalAntiAliasingOptions const& taaOptions) noexcept;
 
+    // Per-stage scale policies for dynamic resolution: instead of following the primary
+    // scale factor uniformly, the cheapest-looking stages give up resolution first. The
+    // adjusted options then drive the FrameGraph resource sizing of their respective
+    // passes. Shadow maps are deliberately left out, they are not tied to the rendering
+    // resolution at all.
+    void applyStageScalePolicies(math::float2 scale,
+            AmbientOcclusionOptions& inoutAoOptions,
+            BloomOptions& inoutBloomOptions) const noexcept;
+
     // methods below are ordered relative to their position in the pipeline (as much as possible)
 
     // structure (depth) pass
@@ -101,6 +115,11 @@ public:
             RenderPass const& pass, uint8_t structureRenderFlags,
             uint32_t width, uint32_t height, StructurePassConfig const& config) noexcept;
 
+    // depth reduction pass for occlusion culling, reduces the structure buffer to a small
+    // grid holding the farthest depth of each tile (see FView::prepare())
+    FrameGraphId<FrameGraphTexture> occlusionDepth(FrameGraph& fg,
+            FrameGraphId<FrameGraphTexture> structure) noexcept;
+
     // reflections pass
     FrameGraphId<FrameGraphTexture> ssr(FrameGraph& fg,
             RenderPass const& pass,
@@ -264,6 +283,20 @@ public:
             FrameGraphId<FrameGraphTexture> input,
             FrameGraphId<FrameGraphTexture> depth) noexcept;
 
+    // Performance HUD overlay (see View::setPerformanceHudEnabled)
+    struct PerformanceHudInfo {
+        static constexpr size_t HISTORY_SIZE = 32;
+        math::float4 frameTimesMs[HISTORY_SIZE / 4u] = {};  // packed, [0].x is the newest frame
+        uint32_t frameTimeCount = 0;
+        float targetFrameTimeMs = 0.0f;                     // the display's refresh period
+        float jobSystemOccupancy = 0.0f;                    // in [0, 1]
+        float transientMemoryUsage = 0.0f;                  // in [0, 1], of the cache budget
+    };
+
+    FrameGraphId<FrameGraphTexture> performanceHud(FrameGraph& fg,
+            FrameGraphId<FrameGraphTexture> input,
+            PerformanceHudInfo const& info) noexcept;
+
     backend::Handle<backend::HwTexture> getOneTexture() const;
     backend::Handle<backend::HwTexture> getZeroTexture() const;
     backend::Handle<backend::HwTexture> getOneTextureArray() const;
@@ -353,6 +386,8 @@ private:
 
     MaterialRegistryMap mMaterialRegistry;
 
+    // lazily created on first use, lens flare is typically disabled
+    backend::Handle<backend::HwTexture> getStarburstTexture() noexcept;
     backend::Handle<backend::HwTexture> mStarburstTexture;
 
     std::uniform_real_distribution<float> mUniformDistribution{0.0f, 1.0f};
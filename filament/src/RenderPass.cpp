@@ -16,6 +16,7 @@
 
 #include "RenderPass.h"
 
+#include "FeatureFlags.h"
 #include "RenderPrimitive.h"
 #include "ShadowMap.h"
 
@@ -28,6 +29,7 @@
 #include <utils/JobSystem.h>
 #include <utils/Systrace.h>
 
+#include <tuple>
 #include <utility>
 
 using namespace utils;
@@ -119,14 +121,21 @@ void RenderPass::appendCommands(FEngine& engine, CommandTypeFlags const commandT
     auto stereoscopicEyeCount =
             renderFlags & IS_STEREOSCOPIC ? engine.getConfig().stereoscopicEyeCount : 1;
 
+    // opaque casters that render with the default material's (shared) depth variant don't read
+    // any per-instance state, so they can all share the default material instance; the executor
+    // then binds material state once for the whole run instead of once per instance.
+    FMaterialInstance const* const sharedDepthMaterialInstance =
+            depthPass ? engine.getDefaultMaterial()->getDefaultInstance() : nullptr;
+
     const float3 cameraPosition(mCameraPosition);
     const float3 cameraForwardVector(mCameraForwardVector);
     auto work = [commandTypeFlags, curr, &soa, variant, renderFlags, visibilityMask, cameraPosition,
-                 cameraForwardVector, stereoscopicEyeCount]
+                 cameraForwardVector, stereoscopicEyeCount, sharedDepthMaterialInstance]
             (uint32_t startIndex, uint32_t indexCount) {
         RenderPass::generateCommands(commandTypeFlags, curr,
                 soa, { startIndex, startIndex + indexCount }, variant, renderFlags, visibilityMask,
-                cameraPosition, cameraForwardVector, stereoscopicEyeCount);
+                cameraPosition, cameraForwardVector, stereoscopicEyeCount,
+                sharedDepthMaterialInstance);
     };
 
     if (vr.size() <= JOBS_PARALLEL_FOR_COMMANDS_COUNT) {
@@ -175,7 +184,15 @@ void RenderPass::appendCustomCommand(uint8_t channel, Pass pass, CustomCommand c
 void RenderPass::sortCommands(FEngine& engine) noexcept {
     SYSTRACE_NAME("sort and trim commands");
 
-    std::sort(mCommandBegin, mCommandEnd);
+    if (UTILS_UNLIKELY(mSortCache)) {
+        sortCommandsIncremental(*mSortCache);
+    } else if (UTILS_UNLIKELY(mBucketedSorting)) {
+        sortCommandsBucketed();
+    } else if (size_t(mCommandEnd - mCommandBegin) >= PARALLEL_SORT_COMMANDS_COUNT) {
+        sortCommandsParallel(engine.getJobSystem(), mCommandBegin, mCommandEnd);
+    } else {
+        std::sort(mCommandBegin, mCommandEnd);
+    }
 
     // find the last command
     Command const* const last = std::partition_point(mCommandBegin, mCommandEnd,
@@ -190,6 +207,179 @@ void RenderPass::sortCommands(FEngine& engine) noexcept {
     }
 }
 
+// Parallel merge sort on the JobSystem. The recursion sorts the right half on the calling
+// thread while a job sorts the left half (the wait below work-steals), then merges the two
+// sorted runs. This spreads the sort -- the dominant serial cost of large passes, notably the
+// per-shadow-map sorts that run while the FrameGraph executes -- across idle worker threads.
+void RenderPass::sortCommandsParallel(JobSystem& js, Command* const begin,
+        Command* const end) noexcept {
+    size_t const count = end - begin;
+    if (count < PARALLEL_SORT_COMMANDS_COUNT) {
+        std::sort(begin, end);
+        return;
+    }
+    Command* const middle = begin + count / 2;
+    auto* job = js.createJob(nullptr,
+            [begin, middle](JobSystem& js, JobSystem::Job*) {
+                sortCommandsParallel(js, begin, middle);
+            });
+    job = js.runAndRetain(job);
+    sortCommandsParallel(js, middle, end);
+    js.waitAndRelease(job);
+    std::inplace_merge(begin, middle, end);
+}
+
+void RenderPass::sortCommandsIncremental(SortCache& cache) noexcept {
+    Command* const UTILS_RESTRICT commands = mCommandBegin;
+    size_t const count = mCommandEnd - mCommandBegin;
+
+    // full sort, recording the sorted order and this frame's keys for next frame
+    auto rebuildCache = [commands, count, &cache]() {
+        cache.keys.resize(count);
+        cache.order.resize(count);
+        cache.scratch.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            cache.keys[i] = commands[i].key;
+            cache.order[i] = uint32_t(i);
+        }
+        std::sort(cache.order.begin(), cache.order.end(),
+                [commands](uint32_t const lhs, uint32_t const rhs) {
+                    return commands[lhs].key < commands[rhs].key;
+                });
+        Command* const scratch = cache.scratch.data();
+        for (size_t i = 0; i < count; i++) {
+            scratch[i] = commands[cache.order[i]];
+        }
+        std::copy_n(scratch, count, commands);
+    };
+
+    if (cache.keys.size() != count) {
+        // the command stream changed shape (renderables added/removed), start over
+        rebuildCache();
+        return;
+    }
+
+    // commands are generated in a deterministic order (renderable index), so comparing
+    // against last frame's keys index-by-index finds exactly the commands that moved
+    size_t dirtyCount = 0;
+    for (size_t i = 0; i < count; i++) {
+        dirtyCount += commands[i].key != cache.keys[i] ? 1 : 0;
+    }
+
+    if (dirtyCount > count / INCREMENTAL_SORT_MAX_DIRTY_DENOMINATOR) {
+        rebuildCache();
+        return;
+    }
+
+    // commands with unchanged keys are already relatively sorted by last frame's order
+    auto& clean = cache.cleanIndices;
+    auto& dirty = cache.dirtyIndices;
+    clean.clear();
+    dirty.clear();
+    for (uint32_t const v : cache.order) {
+        if (commands[v].key == cache.keys[v]) {
+            clean.push_back(v);
+        }
+    }
+    for (uint32_t i = 0; i < uint32_t(count); i++) {
+        if (commands[i].key != cache.keys[i]) {
+            dirty.push_back(i);
+            cache.keys[i] = commands[i].key;
+        }
+    }
+    std::sort(dirty.begin(), dirty.end(),
+            [commands](uint32_t const lhs, uint32_t const rhs) {
+                return commands[lhs].key < commands[rhs].key;
+            });
+
+    // merge the two sorted runs, gathering commands and the new sorted order
+    cache.scratch.resize(count);
+    cache.orderScratch.resize(count);
+    Command* const UTILS_RESTRICT scratch = cache.scratch.data();
+    uint32_t* const UTILS_RESTRICT newOrder = cache.orderScratch.data();
+    size_t a = 0, b = 0;
+    size_t const na = clean.size(), nb = dirty.size();
+    for (size_t out = 0; out < count; out++) {
+        bool takeClean;
+        if (a == na)        { takeClean = false; }
+        else if (b == nb)   { takeClean = true; }
+        else                { takeClean = commands[clean[a]].key <= commands[dirty[b]].key; }
+        uint32_t const v = takeClean ? clean[a++] : dirty[b++];
+        scratch[out] = commands[v];
+        newOrder[out] = v;
+    }
+    std::copy_n(scratch, count, commands);
+    cache.order.swap(cache.orderScratch);
+}
+
+void RenderPass::sortCommandsBucketed() noexcept {
+    size_t const count = mCommandEnd - mCommandBegin;
+    if (UTILS_UNLIKELY(count == 0)) {
+        return;
+    }
+    Command* const UTILS_RESTRICT commands = mCommandBegin;
+
+    // The bucket id concatenates the key's correctness fields -- channel, pass, custom,
+    // blending/alpha-masking bit, priority -- in key order, followed by the top
+    // BUCKETED_SORT_DEPTH_BITS bits of the Z-bucket. Binning on it is therefore exactly as
+    // correct as the full sort; what's given up is the ordering *within* a bucket (the
+    // remaining Z-bucket bits and the material bits), which only affects overdraw and state
+    // grouping of opaques.
+    constexpr unsigned DEPTH_SHIFT = Z_BUCKET_SHIFT + 10 - BUCKETED_SORT_DEPTH_BITS;
+    constexpr uint32_t BUCKET_COUNT = 1u << (11u + BUCKETED_SORT_DEPTH_BITS);
+    auto makeBucketId = [](CommandKey key) -> uint32_t {
+        uint32_t id;
+        id  = uint32_t((key & CHANNEL_MASK)  >> CHANNEL_SHIFT)  << (9u + BUCKETED_SORT_DEPTH_BITS);
+        id |= uint32_t((key & PASS_MASK)     >> PASS_SHIFT)     << (7u + BUCKETED_SORT_DEPTH_BITS);
+        id |= uint32_t((key & CUSTOM_MASK)   >> CUSTOM_SHIFT)   << (5u + BUCKETED_SORT_DEPTH_BITS);
+        id |= uint32_t((key & BLENDING_MASK) >> BLENDING_SHIFT) << (4u + BUCKETED_SORT_DEPTH_BITS);
+        id |= uint32_t((key & PRIORITY_MASK) >> PRIORITY_SHIFT) << (1u + BUCKETED_SORT_DEPTH_BITS);
+        // BLENDED keys store their camera distance where opaque keys store the Z-bucket, and
+        // its most significant bits lie above Z_BUCKET_MASK, so binning on them would break
+        // their ordering; leave the depth bits clear instead, which gathers all blended
+        // commands of a bucket together for the exact sort below. Same for custom commands
+        // (PROLOG/EPILOG), whose keys store their submission order there: most of its bits
+        // lie above Z_BUCKET_MASK, so binning on the overlap would order them incorrectly.
+        if ((key & PASS_MASK) != uint64_t(Pass::BLENDED) &&
+                (key & CUSTOM_MASK) == uint64_t(CustomCommand::PASS)) {
+            id |= uint32_t((key & Z_BUCKET_MASK) >> DEPTH_SHIFT);
+        }
+        return id;
+    };
+
+    // counting sort: histogram, exclusive prefix sum, then a stable scatter which preserves
+    // generation order within each bucket ("per-bucket insertion")
+    std::vector<uint32_t> offsets(BUCKET_COUNT + 1, 0);
+    for (size_t i = 0; i < count; i++) {
+        offsets[makeBucketId(commands[i].key) + 1]++;
+    }
+    for (uint32_t b = 1; b <= BUCKET_COUNT; b++) {
+        offsets[b] += offsets[b - 1];
+    }
+    std::vector<uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+    std::vector<Command> scratch(count);
+    for (size_t i = 0; i < count; i++) {
+        scratch[cursors[makeBucketId(commands[i].key)]++] = commands[i];
+    }
+    std::copy_n(scratch.data(), count, commands);
+
+    // blended commands encode their exact camera distance and blend order in the key, and
+    // custom commands their submission order; those buckets still get a real sort -- they are
+    // a small fraction of the commands in the scenes this mode targets
+    for (uint32_t b = 0; b < BUCKET_COUNT; b++) {
+        uint32_t const begin = offsets[b];
+        uint32_t const end = offsets[b + 1];
+        if (end - begin <= 1) {
+            continue;
+        }
+        uint64_t const pass = uint64_t((b >> (7u + BUCKETED_SORT_DEPTH_BITS)) & 0x3u) << PASS_SHIFT;
+        uint64_t const custom = uint64_t((b >> (5u + BUCKETED_SORT_DEPTH_BITS)) & 0x3u) << CUSTOM_SHIFT;
+        if (pass == uint64_t(Pass::BLENDED) || custom != uint64_t(CustomCommand::PASS)) {
+            std::sort(commands + begin, commands + end);
+        }
+    }
+}
+
 void RenderPass::execute(FEngine& engine, const char* name,
         backend::Handle<backend::HwRenderTarget> renderTarget,
         backend::RenderPassParams params) const noexcept {
@@ -212,16 +402,40 @@ void RenderPass::instanceify(FEngine& engine) noexcept {
     // instanceify works by scanning the **sorted** command stream, looking for repeat draw
     // commands. When one is found, it is replaced by an instanced command.
     // A "repeat" draw is one that ends-up using the same draw parameters and state.
-    // Currently, this relies somewhat on luck that "repeat draws" are found consecutively,
-    // we could improve this by including some or all of these "repeat" parameters in the
-    // sorting key (e.g. raster state, primitive handle, etc...), the key could even use a small
-    // hash of those parameters.
 
     UTILS_UNUSED uint32_t drawCallsSavedCount = 0;
 
     Command* curr = mCommandBegin;
     Command* const last = mCommandEnd;
 
+    // The sort key doesn't encode the primitive handle, so commands that compare equal on
+    // their key (e.g. thousands of renderables sharing one material) are in an arbitrary
+    // relative order, and identical primitives end up interleaved with the other primitives
+    // of that material -- the scan below then only merges whatever happens to be adjacent.
+    // Reordering commands within an equal-key run doesn't change what the sort guarantees,
+    // so group each run by the same identity the merge loop matches on.
+    for (Command* p = curr; p != last;) {
+        Command* const e = const_cast<Command*>(std::find_if(p, last,
+                [key = p->key](Command const& c) {
+                    return c.key != key;
+                }));
+        if (UTILS_UNLIKELY(e - p > 1)) {
+            std::sort(p, e, [](Command const& lhs, Command const& rhs) {
+                auto const& l = lhs.primitive;
+                auto const& r = rhs.primitive;
+                return std::make_tuple(l.mi, l.primitiveHandle.getId(), l.rasterState.u,
+                               l.skinningHandle.getId(), l.skinningOffset,
+                               l.morphWeightBuffer.getId(), l.morphTargetBuffer.getId(),
+                               l.skinningTexture.getId())
+                     < std::make_tuple(r.mi, r.primitiveHandle.getId(), r.rasterState.u,
+                               r.skinningHandle.getId(), r.skinningOffset,
+                               r.morphWeightBuffer.getId(), r.morphTargetBuffer.getId(),
+                               r.skinningTexture.getId());
+            });
+        }
+        p = e;
+    }
+
     Command* firstSentinel = nullptr;
     PerRenderableData const* uboData = nullptr;
     PerRenderableData* stagingBuffer = nullptr;
@@ -339,7 +553,8 @@ void RenderPass::setupColorCommand(Command& cmdDraw, Variant variant,
     keyBlending |= uint64_t(CustomCommand::PASS);
 
     BlendingMode const blendingMode = ma->getBlendingMode();
-    bool const hasScreenSpaceRefraction = ma->getRefractionMode() == RefractionMode::SCREEN_SPACE;
+    bool const hasScreenSpaceRefraction =
+            features::SSR && ma->getRefractionMode() == RefractionMode::SCREEN_SPACE;
     bool const isBlendingCommand = !hasScreenSpaceRefraction &&
             (blendingMode != BlendingMode::OPAQUE && blendingMode != BlendingMode::MASKED);
 
@@ -378,7 +593,8 @@ void RenderPass::generateCommands(uint32_t commandTypeFlags, Command* const comm
         FScene::RenderableSoa const& soa, Range<uint32_t> range,
         Variant variant, RenderFlags renderFlags,
         FScene::VisibleMaskType visibilityMask, float3 cameraPosition, float3 cameraForward,
-        uint8_t instancedStereoEyeCount) noexcept {
+        uint8_t instancedStereoEyeCount,
+        FMaterialInstance const* sharedDepthMaterialInstance) noexcept {
 
     SYSTRACE_CALL();
 
@@ -410,12 +626,12 @@ void RenderPass::generateCommands(uint32_t commandTypeFlags, Command* const comm
         case CommandTypeFlags::COLOR:
             curr = generateCommandsImpl<CommandTypeFlags::COLOR>(commandTypeFlags, curr,
                     soa, range, variant, renderFlags, visibilityMask, cameraPosition, cameraForward,
-                    instancedStereoEyeCount);
+                    instancedStereoEyeCount, sharedDepthMaterialInstance);
             break;
         case CommandTypeFlags::DEPTH:
             curr = generateCommandsImpl<CommandTypeFlags::DEPTH>(commandTypeFlags, curr,
                     soa, range, variant, renderFlags, visibilityMask, cameraPosition, cameraForward,
-                    instancedStereoEyeCount);
+                    instancedStereoEyeCount, sharedDepthMaterialInstance);
             break;
         default:
             // we should never end-up here
@@ -438,7 +654,8 @@ RenderPass::Command* RenderPass::generateCommandsImpl(uint32_t extraFlags,
         Command* UTILS_RESTRICT curr,
         FScene::RenderableSoa const& UTILS_RESTRICT soa, Range<uint32_t> range,
         Variant const variant, RenderFlags renderFlags, FScene::VisibleMaskType visibilityMask,
-        float3 cameraPosition, float3 cameraForward, uint8_t instancedStereoEyeCount) noexcept {
+        float3 cameraPosition, float3 cameraForward, uint8_t instancedStereoEyeCount,
+        FMaterialInstance const* sharedDepthMaterialInstance) noexcept {
 
     // generateCommands() writes both the draw and depth commands simultaneously such that
     // we go throw the list of renderables just once.
@@ -565,7 +782,8 @@ RenderPass::Command* RenderPass::generateCommandsImpl(uint32_t extraFlags,
             }
         }
         if constexpr (isColorPass) {
-            renderableVariant.setFog(soaVisibility[i].fog && Variant::isFogVariant(variant));
+            renderableVariant.setFog(
+                    features::FOG && soaVisibility[i].fog && Variant::isFogVariant(variant));
         }
 
         const bool shadowCaster = soaVisibility[i].castShadows & hasShadowing;
@@ -688,11 +906,27 @@ RenderPass::Command* RenderPass::generateCommandsImpl(uint32_t extraFlags,
                 const bool translucent = (blendingMode != BlendingMode::OPAQUE
                         && blendingMode != BlendingMode::MASKED);
 
-                cmdDepth.key |= mi->getSortingKey(); // already all set-up for direct or'ing
+                // Opaque casters without a custom depth shader render with the default
+                // material's (shared) depth variant and don't read any per-instance state;
+                // substituting the default material instance groups them under a single
+                // sorting key, so the executor binds material state once for the whole run.
+                // The rasterState fields that do come from the instance are copied into the
+                // command below, before the substitution.
+                FMaterialInstance const* miDepth = mi;
+                if (sharedDepthMaterialInstance
+                        && !ma->hasCustomDepthShader()
+                        && blendingMode == BlendingMode::OPAQUE && !rs.alphaToCoverage
+                        && !mi->hasScissor()
+                        && mi->getPolygonOffset().slope == 0.0f
+                        && mi->getPolygonOffset().constant == 0.0f) {
+                    miDepth = sharedDepthMaterialInstance;
+                }
+
+                cmdDepth.key |= miDepth->getSortingKey(); // already all set-up for direct or'ing
 
                 // unconditionally write the command
                 cmdDepth.primitive.primitiveHandle = primitive.getHwHandle();
-                cmdDepth.primitive.mi = mi;
+                cmdDepth.primitive.mi = miDepth;
                 cmdDepth.primitive.rasterState.culling = mi->getCullingMode();
 
                 cmdDepth.primitive.skinningHandle = skinning.handle;
@@ -781,6 +1015,15 @@ void RenderPass::Executor::execute(backend::DriverApi& driver,
         FMaterial const* UTILS_RESTRICT ma = nullptr;
         auto const* UTILS_RESTRICT pCustomCommands = mCustomCommands.data();
 
+        // current skinning/morphing bindings; a skinned renderable is usually drawn with
+        // several primitives in a row (and many times across shadow passes), all sharing the
+        // same bone and morph-target data, so we skip the redundant binds.
+        Handle<HwBufferObject> boundBoneUbo;
+        uint32_t boundBoneUboOffset = 0;
+        Handle<HwSamplerGroup> boundSkinningTexture;
+        Handle<HwSamplerGroup> boundMorphTargetBuffer;
+        Handle<HwBufferObject> boundMorphWeightBuffer;
+
         first--;
         while (++first != last) {
             assert_invariant(first->key != uint64_t(Pass::SENTINEL));
@@ -791,6 +1034,11 @@ void RenderPass::Executor::execute(backend::DriverApi& driver,
 
             if (UTILS_UNLIKELY((first->key & CUSTOM_MASK) != uint64_t(CustomCommand::PASS))) {
                 mi = nullptr; // custom command could change the currently bound MaterialInstance
+                // ... as well as the skinning/morphing bindings
+                boundBoneUbo.clear();
+                boundSkinningTexture.clear();
+                boundMorphTargetBuffer.clear();
+                boundMorphWeightBuffer.clear();
                 uint32_t const index = (first->key & CUSTOM_INDEX_MASK) >> CUSTOM_INDEX_SHIFT;
                 assert_invariant(index < mCustomCommands.size());
                 pCustomCommands[index]();
@@ -874,30 +1122,50 @@ void RenderPass::Executor::execute(backend::DriverApi& driver,
                     sizeof(PerRenderableUib));
 
             if (UTILS_UNLIKELY(info.skinningHandle)) {
-                // note: we can't bind less than sizeof(PerRenderableBoneUib) due to glsl limitations
-                driver.bindBufferRange(BufferObjectBinding::UNIFORM,
-                        +UniformBindingPoints::PER_RENDERABLE_BONES,
-                        info.skinningHandle,
-                        info.skinningOffset * sizeof(PerRenderableBoneUib::BoneData),
-                        sizeof(PerRenderableBoneUib));
+                if (info.skinningHandle != boundBoneUbo
+                        || info.skinningOffset != boundBoneUboOffset) {
+                    boundBoneUbo = info.skinningHandle;
+                    boundBoneUboOffset = info.skinningOffset;
+                    // note: we can't bind less than sizeof(PerRenderableBoneUib) due to glsl limitations
+                    driver.bindBufferRange(BufferObjectBinding::UNIFORM,
+                            +UniformBindingPoints::PER_RENDERABLE_BONES,
+                            info.skinningHandle,
+                            info.skinningOffset * sizeof(PerRenderableBoneUib::BoneData),
+                            sizeof(PerRenderableBoneUib));
+                }
                 // note: always bind the skinningTexture because the shader needs it.
-                driver.bindSamplers(+SamplerBindingPoints::PER_RENDERABLE_SKINNING,
-                        info.skinningTexture);
+                if (info.skinningTexture != boundSkinningTexture) {
+                    boundSkinningTexture = info.skinningTexture;
+                    driver.bindSamplers(+SamplerBindingPoints::PER_RENDERABLE_SKINNING,
+                            info.skinningTexture);
+                }
                 // note: even if only skinning is enabled, binding morphTargetBuffer is needed.
-                driver.bindSamplers(+SamplerBindingPoints::PER_RENDERABLE_MORPHING,
-                        info.morphTargetBuffer);
+                if (info.morphTargetBuffer != boundMorphTargetBuffer) {
+                    boundMorphTargetBuffer = info.morphTargetBuffer;
+                    driver.bindSamplers(+SamplerBindingPoints::PER_RENDERABLE_MORPHING,
+                            info.morphTargetBuffer);
+                }
            }
 
             if (UTILS_UNLIKELY(info.morphWeightBuffer)) {
-                // Instead of using a UBO per primitive, we could also have a single UBO for all
-                // primitives and use bindUniformBufferRange which might be more efficient.
-                driver.bindUniformBuffer(+UniformBindingPoints::PER_RENDERABLE_MORPHING,
-                        info.morphWeightBuffer);
-                driver.bindSamplers(+SamplerBindingPoints::PER_RENDERABLE_MORPHING,
-                        info.morphTargetBuffer);
+                if (info.morphWeightBuffer != boundMorphWeightBuffer) {
+                    boundMorphWeightBuffer = info.morphWeightBuffer;
+                    // Instead of using a UBO per primitive, we could also have a single UBO for all
+                    // primitives and use bindUniformBufferRange which might be more efficient.
+                    driver.bindUniformBuffer(+UniformBindingPoints::PER_RENDERABLE_MORPHING,
+                            info.morphWeightBuffer);
+                }
+                if (info.morphTargetBuffer != boundMorphTargetBuffer) {
+                    boundMorphTargetBuffer = info.morphTargetBuffer;
+                    driver.bindSamplers(+SamplerBindingPoints::PER_RENDERABLE_MORPHING,
+                            info.morphTargetBuffer);
+                }
                 // note: even if only morphing is enabled, binding skinningTexture is needed.
-                driver.bindSamplers(+SamplerBindingPoints::PER_RENDERABLE_SKINNING,
-                        info.skinningTexture);
+                if (info.skinningTexture != boundSkinningTexture) {
+                    boundSkinningTexture = info.skinningTexture;
+                    driver.bindSamplers(+SamplerBindingPoints::PER_RENDERABLE_SKINNING,
+                            info.skinningTexture);
+                }
             }
 
             driver.draw(pipeline, info.primitiveHandle, instanceCount);
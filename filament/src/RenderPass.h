@@ -39,6 +39,10 @@
 #include <limits>
 #include <vector>
 
+namespace utils {
+class JobSystem;
+} // namespace utils
+
 namespace filament {
 
 class FMaterialInstance;
@@ -262,6 +266,22 @@ public:
     static_assert(std::is_trivially_destructible_v<Command>,
             "Command isn't trivially destructible");
 
+    /*
+     * Persistent state for incremental command sorting. This is owned by the caller (which,
+     * unlike the per-frame RenderPass, survives across frames) and attached with setSortCache().
+     * When attached, sortCommands() reuses last frame's sorted order for commands whose keys
+     * didn't change, and only sorts and merges the commands whose keys did -- in mostly-static
+     * scenes this replaces the full sort with a linear scan and a small merge.
+     */
+    struct SortCache {
+        std::vector<CommandKey> keys;       // last frame's keys, in generation order
+        std::vector<uint32_t> order;        // sorted position -> generation index
+        std::vector<Command> scratch;       // gather buffer used while reordering
+        std::vector<uint32_t> cleanIndices; // commands whose key didn't change, sorted
+        std::vector<uint32_t> dirtyIndices; // commands whose key changed
+        std::vector<uint32_t> orderScratch; // next frame's `order` being built
+    };
+
     using RenderFlags = uint8_t;
     static constexpr RenderFlags HAS_SHADOWING           = 0x01;
     static constexpr RenderFlags HAS_INVERSE_FRONT_FACES = 0x02;
@@ -309,6 +329,19 @@ public:
     // Defaults to all 1's, which means all renderables in this render pass will be rendered.
     void setVisibilityMask(FScene::VisibleMaskType mask) noexcept { mVisibilityMask = mask; }
 
+    // Attaches a persistent sort cache, enabling incremental sorting in sortCommands().
+    // The cache must outlive this RenderPass.
+    void setSortCache(SortCache* cache) noexcept { mSortCache = cache; }
+
+    // Enables bucketed sorting in sortCommands(): commands are binned with a counting sort on
+    // their correctness bits plus a few coarse depth bits instead of being comparison-sorted
+    // on their full key; blended and custom commands keep their exact order. Intended for
+    // depth-prepass pipelines with very high draw counts, where the full sort dominates and
+    // exact front-to-back order of opaques doesn't pay for itself. Within a bucket, commands
+    // keep generation order, so some material state-grouping is lost. Ignored when a sort
+    // cache is attached.
+    void setBucketedSorting(bool enabled) noexcept { mBucketedSorting = enabled; }
+
     Command const* begin() const noexcept { return mCommandBegin; }
     Command const* end() const noexcept { return mCommandEnd; }
     bool empty() const noexcept { return begin() == end(); }
@@ -394,6 +427,20 @@ private:
     Command* append(size_t count) noexcept;
     void resize(size_t count) noexcept;
     void instanceify(FEngine& engine) noexcept;
+    void sortCommandsIncremental(SortCache& cache) noexcept;
+    void sortCommandsBucketed() noexcept;
+    static void sortCommandsParallel(utils::JobSystem& js, Command* begin, Command* end) noexcept;
+
+    // above this fraction of changed keys, the incremental sort falls back to a full sort
+    // (the merge bookkeeping stops paying for itself)
+    static constexpr size_t INCREMENTAL_SORT_MAX_DIRTY_DENOMINATOR = 8;
+
+    // number of high-order Z-bucket bits kept by sortCommandsBucketed(); the remaining
+    // Z-bucket bits and the material bits are left unsorted within a bucket
+    static constexpr unsigned BUCKETED_SORT_DEPTH_BITS = 3;
+
+    // below this number of commands a plain std::sort beats the parallel merge sort
+    static constexpr size_t PARALLEL_SORT_COMMANDS_COUNT = 8192;
 
     // we choose the command count per job to minimize JobSystem overhead.
     // on a Pixel 4, 2048 commands is about half a millisecond of processing.
@@ -409,14 +456,16 @@ private:
             Variant variant, RenderFlags renderFlags,
             FScene::VisibleMaskType visibilityMask,
             math::float3 cameraPosition, math::float3 cameraForward,
-            uint8_t instancedStereoEyeCount) noexcept;
+            uint8_t instancedStereoEyeCount,
+            FMaterialInstance const* sharedDepthMaterialInstance) noexcept;
 
     template<uint32_t commandTypeFlags>
     static inline Command* generateCommandsImpl(uint32_t extraFlags, Command* curr,
             FScene::RenderableSoa const& soa, utils::Range<uint32_t> range,
             Variant variant, RenderFlags renderFlags, FScene::VisibleMaskType visibilityMask,
             math::float3 cameraPosition, math::float3 cameraForward,
-            uint8_t instancedStereoEyeCount) noexcept;
+            uint8_t instancedStereoEyeCount,
+            FMaterialInstance const* sharedDepthMaterialInstance) noexcept;
 
     static void setupColorCommand(Command& cmdDraw, Variant variant,
             FMaterialInstance const* mi, bool inverseFrontFaces) noexcept;
@@ -462,6 +511,12 @@ private:
             std::numeric_limits<int32_t>::max(),
             std::numeric_limits<int32_t>::max() };
 
+    // optional persistent cache enabling incremental sorting (not owned)
+    SortCache* mSortCache = nullptr;
+
+    // whether sortCommands() uses coarse depth bucketing instead of a full sort
+    bool mBucketedSorting = false;
+
     // a vector for our custom commands
     using CustomCommandVector = std::vector<Executor::CustomCommandFn,
             utils::STLAllocator<Executor::CustomCommandFn, LinearAllocatorArena>>;
@@ -35,6 +35,10 @@ size_t RenderableManager::getComponentCount() const noexcept {
     return downcast(this)->getComponentCount();
 }
 
+void RenderableManager::reserve(size_t count) noexcept {
+    downcast(this)->reserve(count);
+}
+
 bool RenderableManager::empty() const noexcept {
     return downcast(this)->empty();
 }
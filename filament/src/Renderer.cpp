@@ -61,6 +61,14 @@ void Renderer::endFrame() {
     downcast(this)->endFrame();
 }
 
+void Renderer::beginFrameGroup() noexcept {
+    downcast(this)->beginFrameGroup();
+}
+
+void Renderer::endFrameGroup() {
+    downcast(this)->endFrameGroup();
+}
+
 double Renderer::getUserTime() const {
     return downcast(this)->getUserTime();
 }
@@ -77,6 +85,26 @@ void Renderer::setFrameRateOptions(FrameRateOptions const& options) noexcept {
     downcast(this)->setFrameRateOptions(options);
 }
 
+void Renderer::setThermalGovernorEnabled(bool enabled) noexcept {
+    downcast(this)->setThermalGovernorEnabled(enabled);
+}
+
+bool Renderer::isThermalGovernorEnabled() const noexcept {
+    return downcast(this)->isThermalGovernorEnabled();
+}
+
+void Renderer::setPassProfilingEnabled(bool enabled) noexcept {
+    downcast(this)->setPassProfilingEnabled(enabled);
+}
+
+bool Renderer::isPassProfilingEnabled() const noexcept {
+    return downcast(this)->isPassProfilingEnabled();
+}
+
+size_t Renderer::getPassTimings(PassTiming* timings, size_t count) const noexcept {
+    return downcast(this)->getPassTimings(timings, count);
+}
+
 void Renderer::setClearOptions(const ClearOptions& options) {
     downcast(this)->setClearOptions(options);
 }
@@ -85,6 +113,12 @@ Renderer::ClearOptions const& Renderer::getClearOptions() const noexcept {
     return downcast(this)->getClearOptions();
 }
 
+void Renderer::renderStandaloneViews(View const* const* views, size_t count,
+        backend::CallbackHandler* handler, backend::CallbackHandler::Callback callback,
+        void* user) {
+    downcast(this)->renderStandaloneViews(views, count, handler, callback, user);
+}
+
 void Renderer::renderStandaloneView(View const* view) {
     downcast(this)->renderStandaloneView(downcast(view));
 }
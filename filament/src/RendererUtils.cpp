@@ -215,6 +215,7 @@ FrameGraphId<FrameGraphTexture> RendererUtils::colorPass(
 
                 // TODO: this should be a parameter of FrameGraphRenderPass::Descriptor
                 out.params.clearStencil = config.clearStencil;
+                out.params.shadingRate = view.getShadingRate();
                 if (view.getBlendMode() == BlendMode::TRANSLUCENT) {
                     if (any(out.params.flags.discardStart & TargetBufferFlags::COLOR0)) {
                         // if the buffer is discarded (e.g. it's new) and we're blending,
@@ -224,10 +225,6 @@ FrameGraphId<FrameGraphTexture> RendererUtils::colorPass(
                     }
                 }
 
-                if (colorGradingConfig.asSubpass || colorGradingConfig.customResolve) {
-                    out.params.subpassMask = 1;
-                }
-
                 // this is a good time to flush the CommandStream, because we're about to potentially
                 // output a lot of commands. This guarantees here that we have at least
                 // FILAMENT_MIN_COMMAND_BUFFERS_SIZE_IN_MB bytes (1MiB by default).
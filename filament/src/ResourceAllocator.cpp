@@ -94,8 +94,10 @@ size_t ResourceAllocator::TextureKey::getSize() const noexcept {
     return size;
 }
 
-ResourceAllocator::ResourceAllocator(DriverApi& driverApi) noexcept
-        : mBackend(driverApi) {
+ResourceAllocator::ResourceAllocator(Engine::Config const& config, DriverApi& driverApi) noexcept
+        : mCacheCapacity(size_t(config.resourceAllocatorCacheSizeMB) << 20u),
+          mCacheMaxAge(config.resourceAllocatorCacheMaxAge),
+          mBackend(driverApi) {
 }
 
 ResourceAllocator::~ResourceAllocator() noexcept {
@@ -133,6 +135,19 @@ backend::TextureHandle ResourceAllocator::createTexture(const char* name,
     // backend should always be 1 or greater.
     samples = samples ? samples : uint8_t(1);
 
+    // Everything we allocate is a frame graph transient; let backends know, some of them have
+    // cheaper allocation paths for short-lived textures.
+    usage |= TextureUsage::TRANSIENT;
+
+    // A transient that is only ever an attachment (e.g. an intra-frame depth buffer) never
+    // needs to be read back through main memory, so tile-based GPUs can skip its backing
+    // store altogether (lazily-allocated memory on Vulkan, memoryless storage on Metal).
+    constexpr TextureUsage readBack = TextureUsage::SAMPLEABLE | TextureUsage::UPLOADABLE |
+            TextureUsage::BLIT_SRC | TextureUsage::BLIT_DST;
+    if (!any(usage & readBack)) {
+        usage |= TextureUsage::MEMORYLESS;
+    }
+
     using TS = backend::TextureSwizzle;
     constexpr const auto defaultSwizzle = std::array<backend::TextureSwizzle, 4>{
         TS::CHANNEL_0, TS::CHANNEL_1, TS::CHANNEL_2, TS::CHANNEL_3};
@@ -208,9 +223,9 @@ void ResourceAllocator::gc() noexcept {
     auto& textureCache = mTextureCache;
     for (auto it = textureCache.begin(); it != textureCache.end();) {
         const size_t ageDiff = age - it->second.age;
-        if (ageDiff >= CACHE_MAX_AGE) {
+        if (ageDiff >= mCacheMaxAge) {
             it = purge(it);
-            if (mCacheSize < CACHE_CAPACITY) {
+            if (mCacheSize < mCacheCapacity) {
                 // if we're not at capacity, only purge a single entry per gc, trying to
                 // avoid a burst of work.
                 break;
@@ -220,7 +235,7 @@ void ResourceAllocator::gc() noexcept {
         }
     }
 
-    if (UTILS_UNLIKELY(mCacheSize >= CACHE_CAPACITY)) {
+    if (UTILS_UNLIKELY(mCacheSize >= mCacheCapacity)) {
         // make a copy of our CacheContainer to a vector
         using Vector = FixedCapacityVector<std::pair<TextureKey, TextureCachePayload>>;
         auto cache = Vector::with_capacity(textureCache.size());
@@ -233,7 +248,7 @@ void ResourceAllocator::gc() noexcept {
 
         // now remove entries until we're at capacity
         auto curr = cache.begin();
-        while (mCacheSize >= CACHE_CAPACITY) {
+        while (mCacheSize >= mCacheCapacity) {
             // by construction this entry must exist
             purge(textureCache.find(curr->first));
             ++curr;
@@ -249,6 +264,23 @@ void ResourceAllocator::gc() noexcept {
     //if (mAge % 60 == 0) dump();
 }
 
+ResourceAllocator::MemoryReport ResourceAllocator::getMemoryReport() const noexcept {
+    auto const isDepth = [](TextureKey const& key) {
+        return any(key.usage & (TextureUsage::DEPTH_ATTACHMENT | TextureUsage::STENCIL_ATTACHMENT));
+    };
+    MemoryReport report;
+    report.capacity = mCacheCapacity;
+    for (auto const& it : mTextureCache) {
+        (isDepth(it.first) ? report.cachedDepthSize : report.cachedColorSize) += it.second.size;
+        report.cachedCount++;
+    }
+    for (auto const& it : mInUseTextures) {
+        (isDepth(it.second) ? report.inUseDepthSize : report.inUseColorSize) += it.second.getSize();
+        report.inUseCount++;
+    }
+    return report;
+}
+
 UTILS_NOINLINE
 void ResourceAllocator::dump(bool brief) const noexcept {
     slog.d << "# entries=" << mTextureCache.size() << ", sz=" << mCacheSize / float(1u << 20u)
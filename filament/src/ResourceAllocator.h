@@ -17,6 +17,8 @@
 #ifndef TNT_FILAMENT_RESOURCEALLOCATOR_H
 #define TNT_FILAMENT_RESOURCEALLOCATOR_H
 
+#include <filament/Engine.h>
+
 #include <backend/DriverEnums.h>
 #include <backend/Handle.h>
 #include <backend/TargetBufferInfo.h>
@@ -62,7 +64,7 @@ protected:
 
 class ResourceAllocator final : public ResourceAllocatorInterface {
 public:
-    explicit ResourceAllocator(backend::DriverApi& driverApi) noexcept;
+    ResourceAllocator(Engine::Config const& config, backend::DriverApi& driverApi) noexcept;
     ~ResourceAllocator() noexcept override;
 
     void terminate() noexcept;
@@ -88,10 +90,21 @@ public:
 
     void gc() noexcept;
 
+    // memory used by the transient textures managed by this allocator, in bytes
+    struct MemoryReport {
+        size_t cachedColorSize = 0;     // cached (currently unused) color textures
+        size_t cachedDepthSize = 0;     // cached (currently unused) depth/stencil textures
+        size_t inUseColorSize = 0;      // color textures currently used by the frame graph
+        size_t inUseDepthSize = 0;      // depth/stencil textures currently used by the frame graph
+        size_t cachedCount = 0;
+        size_t inUseCount = 0;
+        size_t capacity = 0;            // cache budget (Engine::Config::resourceAllocatorCacheSizeMB)
+    };
+    MemoryReport getMemoryReport() const noexcept;
+
 private:
-    // TODO: these should be settings of the engine
-    static constexpr size_t CACHE_CAPACITY = 64u << 20u;   // 64 MiB
-    static constexpr size_t CACHE_MAX_AGE  = 30u;
+    const size_t mCacheCapacity;
+    const size_t mCacheMaxAge;
 
     struct TextureKey {
         const char* name; // doesn't participate in the hash
@@ -47,6 +47,10 @@ void Scene::addEntities(const Entity* entities, size_t count) {
     downcast(this)->addEntities(entities, count);
 }
 
+void Scene::addEntities(const Entity* entities, size_t count, uint32_t partition) {
+    downcast(this)->addEntities(entities, count, partition);
+}
+
 void Scene::remove(Entity entity) {
     downcast(this)->remove(entity);
 }
@@ -55,6 +59,10 @@ void Scene::removeEntities(const Entity* entities, size_t count) {
     downcast(this)->removeEntities(entities, count);
 }
 
+void Scene::removePartition(uint32_t partition) {
+    downcast(this)->removePartition(partition);
+}
+
 size_t Scene::getEntityCount() const noexcept {
     return downcast(this)->getEntityCount();
 }
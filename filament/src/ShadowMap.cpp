@@ -25,6 +25,8 @@
 
 #include <backend/DriverEnums.h>
 
+#include <math/batch.h>
+
 #include <utils/debug.h>
 #include <utils/Systrace.h>
 
@@ -41,10 +43,10 @@ using namespace backend;
 static constexpr bool USE_DEPTH_CLAMP = false;
 
 ShadowMap::ShadowMap(FEngine& engine) noexcept
-        : mPerShadowMapUniforms(engine),
-          mShadowType(ShadowType::DIRECTIONAL),
+        : mShadowType(ShadowType::DIRECTIONAL),
           mHasVisibleShadows(false),
-          mFace(0) {
+          mFace(0),
+          mCachedContentValid(false) {
     Entity entities[2];
     engine.getEntityManager().create(2, entities);
     mCamera = engine.createCamera(entities[0]);
@@ -62,7 +64,6 @@ void ShadowMap::terminate(FEngine& engine) {
         engine.destroyCameraComponent(e);
     }
     engine.getEntityManager().destroy(sizeof(entities) / sizeof(Entity), entities);
-    mPerShadowMapUniforms.terminate(engine.getDriverApi());
 }
 
 ShadowMap::~ShadowMap() = default;
@@ -796,9 +797,8 @@ ShadowMap::Corners ShadowMap::computeFrustumCorners(
             }
     };
 
-    for (size_t i = 0; i < csViewFrustumCorners.size(); i++) {
-        out[i] = mat4f::project(projectionInverse, csViewFrustumCorners[i]);
-    }
+    batch::projectPoints(out.data(), csViewFrustumCorners.data(),
+            csViewFrustumCorners.size(), projectionInverse);
 
     return out;
 }
@@ -1342,17 +1342,14 @@ void ShadowMap::prepareShadowMapping(Transaction const& transaction,
     PerShadowMapUniforms::prepareShadowMapping(transaction, highPrecision);
 }
 
-PerShadowMapUniforms::Transaction ShadowMap::open(DriverApi& driver) noexcept {
-    return PerShadowMapUniforms::open(driver);
-}
-
 void ShadowMap::commit(Transaction& transaction,
-        backend::DriverApi& driver) const noexcept {
-    mPerShadowMapUniforms.commit(transaction, driver);
+        PerShadowMapUniforms& uniforms) const noexcept {
+    mPerShadowMapUniformsOffset = uniforms.commit(transaction);
 }
 
-void ShadowMap::bind(backend::DriverApi& driver) const noexcept {
-    mPerShadowMapUniforms.bind(driver);
+void ShadowMap::bind(PerShadowMapUniforms& uniforms,
+        backend::DriverApi& driver) const noexcept {
+    uniforms.bind(driver, mPerShadowMapUniformsOffset);
 }
 
 } // namespace filament
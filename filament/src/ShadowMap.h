@@ -177,6 +177,18 @@ public:
     uint16_t getShadowIndex() const { return mShadowIndex; }
     void setLayer(uint8_t layer) noexcept { mLayer = layer; }
     uint8_t getLayer() const noexcept { return mLayer; }
+
+    // Content caching: when shadow-map contents live in a persistent atlas, a map whose
+    // inputs (light parameters, casters, atlas slot) hash to the same value as when it was
+    // last rendered can be skipped entirely.
+    bool isCachedContentValid(uint32_t const hash) const noexcept {
+        return mCachedContentValid && hash == mCachedContentHash;
+    }
+    void setCachedContent(uint32_t const hash) noexcept {
+        mCachedContentHash = hash;
+        mCachedContentValid = true;
+    }
+    void invalidateCachedContent() noexcept { mCachedContentValid = false; }
     backend::Viewport getViewport() const noexcept;
     backend::Viewport getScissor() const noexcept;
 
@@ -196,10 +208,9 @@ public:
             FEngine& engine, math::float4 const& userTime) noexcept;
     static void prepareShadowMapping(Transaction const& transaction,
             bool highPrecision) noexcept;
-    static PerShadowMapUniforms::Transaction open(backend::DriverApi& driver) noexcept;
     void commit(Transaction& transaction,
-            backend::DriverApi& driver) const noexcept;
-    void bind(backend::DriverApi& driver) const noexcept;
+            PerShadowMapUniforms& uniforms) const noexcept;
+    void bind(PerShadowMapUniforms& uniforms, backend::DriverApi& driver) const noexcept;
 
 private:
     struct Segment {
@@ -336,7 +347,8 @@ private:
             { 2, 6, 7, 3 },  // top
     };
 
-    mutable PerShadowMapUniforms mPerShadowMapUniforms;                     // 4
+    // offset of our slot in the shared per-shadow-map UBO, updated each frame on commit()
+    mutable uint32_t mPerShadowMapUniformsOffset = 0;                       // 4
 
     FCamera* mCamera = nullptr;                                             //  8
     FCamera* mDebugCamera = nullptr;                                        //  8
@@ -345,11 +357,13 @@ private:
     // to store it here. This data is always associated with this shadow map anyway.
     LightManager::ShadowOptions const* mOptions = nullptr;                  // 8
     uint32_t mLightIndex = 0;   // which light are we shadowing             // 4
+    uint32_t mCachedContentHash = 0; // inputs hash when last rendered      // 4
     uint16_t mShadowIndex = 0;  // our index in the shadowMap vector        // 2
     uint8_t mLayer = 0;         // our layer in the shadowMap texture       // 1
     ShadowType mShadowType  : 2;                                            // :2
     bool mHasVisibleShadows : 2;                                            // :2
     uint8_t mFace           : 3;                                            // :3
+    bool mCachedContentValid : 1;                                           // :1
 };
 
 } // namespace filament
@@ -25,7 +25,6 @@
 #include <fg/FrameGraph.h>
 
 #include <utils/debug.h>
-#include <utils/FixedCapacityVector.h>
 
 namespace filament {
 
@@ -33,7 +32,8 @@ using namespace backend;
 using namespace math;
 
 ShadowMapManager::ShadowMapManager(FEngine& engine)
-        : mEngine(engine) {
+        : mEngine(engine),
+          mPerShadowMapUniforms(engine) {
     // initialize our ShadowMap array in-place
     UTILS_NOUNROLL
     for (auto& entry : mShadowMapCache) {
@@ -48,6 +48,8 @@ ShadowMapManager::ShadowMapManager(FEngine& engine)
             &engine.debug.shadowmap.visualize_cascades);
     debugRegistry.registerProperty("d.shadowmap.tightly_bound_scene",
             &engine.debug.shadowmap.tightly_bound_scene);
+    debugRegistry.registerProperty("d.shadowmap.caching",
+            &engine.debug.shadowmap.caching);
 }
 
 ShadowMapManager::~ShadowMapManager() {
@@ -61,6 +63,10 @@ ShadowMapManager::~ShadowMapManager() {
 void ShadowMapManager::terminate(FEngine& engine) {
     DriverApi& driver = engine.getDriverApi();
     driver.destroyBufferObject(mShadowUbh);
+    mPerShadowMapUniforms.terminate(driver);
+    if (mCachedAtlasTexture) {
+        driver.destroyTexture(mCachedAtlasTexture);
+    }
     UTILS_NOUNROLL
     for (auto& entry : mShadowMapCache) {
         std::launder(reinterpret_cast<ShadowMap*>(&entry))->terminate(engine);
@@ -127,6 +133,44 @@ void ShadowMapManager::addShadowMap(size_t lightIndex, bool spotlight,
     }
 }
 
+uint32_t ShadowMapManager::hashCasterBounds(FScene::RenderableSoa const& renderableData,
+        utils::Range<uint32_t> const range) noexcept {
+    uint32_t h = 2166136261u;
+    auto mix = [&h](uint32_t const v) {
+        h = (h ^ v) * 16777619u;
+    };
+    float3 const* const centers = renderableData.data<FScene::WORLD_AABB_CENTER>();
+    float3 const* const extents = renderableData.data<FScene::WORLD_AABB_EXTENT>();
+    mix(range.size());
+    for (uint32_t i = range.first; i < range.last; i++) {
+        auto const* const c = reinterpret_cast<uint32_t const*>(&centers[i]);
+        auto const* const e = reinterpret_cast<uint32_t const*>(&extents[i]);
+        mix(c[0]); mix(c[1]); mix(c[2]);
+        mix(e[0]); mix(e[1]); mix(e[2]);
+    }
+    return h;
+}
+
+uint32_t ShadowMapManager::computeShadowMapContentHash(ShadowMap const& shadowMap,
+        FScene::LightSoa const& lightData, uint32_t const casterHash) const noexcept {
+    uint32_t h = casterHash;
+    auto mix = [&h](uint32_t const v) {
+        h = (h ^ v) * 16777619u;
+    };
+    size_t const lightIndex = shadowMap.getLightIndex();
+    float4 const& positionRadius = lightData.elementAt<FScene::POSITION_RADIUS>(lightIndex);
+    float3 const& direction = lightData.elementAt<FScene::DIRECTION>(lightIndex);
+    auto const* const p = reinterpret_cast<uint32_t const*>(&positionRadius);
+    auto const* const d = reinterpret_cast<uint32_t const*>(&direction);
+    mix(p[0]); mix(p[1]); mix(p[2]); mix(p[3]);
+    mix(d[0]); mix(d[1]); mix(d[2]);
+    auto const* const options = shadowMap.getShadowOptions();
+    mix(scaledMapSize(options->mapSize));
+    mix(uint32_t(shadowMap.getLayer()));
+    mix(uint32_t(shadowMap.getFace()));
+    return h;
+}
+
 FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameGraph& fg,
         RenderPass const& pass, FView& view, CameraInfo const& mainCameraInfo,
         float4 const& userTime) noexcept {
@@ -142,38 +186,84 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
     const TextureAtlasRequirements textureRequirements = mTextureAtlasRequirements;
     assert_invariant(textureRequirements.layers <= CONFIG_MAX_SHADOW_LAYERS);
 
+    // With caching enabled, shadow maps render into a persistent atlas imported into the
+    // frame graph, and spot/point maps whose inputs (light, casters, atlas slot) are
+    // unchanged since they were last rendered are skipped entirely. VSM is excluded
+    // because its blur/mipmap chain rewrites the atlas through separate passes.
+    const bool cachingEnabled = engine.debug.shadowmap.caching && !view.hasVSM();
+    if (cachingEnabled) {
+        auto& cached = mCachedAtlasRequirements;
+        if (!mCachedAtlasTexture ||
+                cached.size != textureRequirements.size ||
+                cached.layers != textureRequirements.layers ||
+                cached.levels != textureRequirements.levels ||
+                cached.format != textureRequirements.format) {
+            DriverApi& driver = engine.getDriverApi();
+            if (mCachedAtlasTexture) {
+                driver.destroyTexture(mCachedAtlasTexture);
+            }
+            mCachedAtlasTexture = driver.createTexture(SamplerType::SAMPLER_2D_ARRAY,
+                    textureRequirements.levels, textureRequirements.format, 1,
+                    textureRequirements.size, textureRequirements.size,
+                    textureRequirements.layers,
+                    TextureUsage::DEPTH_ATTACHMENT | TextureUsage::SAMPLEABLE);
+            cached = textureRequirements;
+            // the new atlas is empty, everything must be re-rendered
+            for (size_t i = 0; i < CONFIG_MAX_SHADOWMAPS; i++) {
+                getShadowMap(i).invalidateCachedContent();
+            }
+        }
+    } else if (mCachedAtlasTexture) {
+        engine.getDriverApi().destroyTexture(mCachedAtlasTexture);
+        mCachedAtlasTexture = {};
+        for (size_t i = 0; i < CONFIG_MAX_SHADOWMAPS; i++) {
+            getShadowMap(i).invalidateCachedContent();
+        }
+    }
+
+    // hash of the world-space bounds of all potential dynamic-shadow casters: catches
+    // casters moving, appearing or disappearing
+    uint32_t spotCasterHash = 0;
+    if (cachingEnabled) {
+        spotCasterHash = hashCasterBounds(scene->getRenderableData(),
+                view.getVisibleSpotShadowCasters());
+    }
+
     // -------------------------------------------------------------------------------------------
     // Prepare Shadow Pass
     // -------------------------------------------------------------------------------------------
 
     struct PrepareShadowPassData {
-        struct ShadowPass {
-            mutable RenderPass::Executor executor;
-            ShadowMap* shadowMap;
-            utils::Range<uint32_t> range;
-            FScene::VisibleMaskType visibilityMask;
-        };
         // the actual shadow map atlas (currently a 2D texture array)
         FrameGraphId<FrameGraphTexture> shadows;
-        // a RenderPass per shadow map
-        utils::FixedCapacityVector<ShadowPass> passList;
+        // a RenderPass per shadow map; a view into mShadowPassList, whose storage is
+        // persistent so that we don't hit the heap each frame
+        utils::Slice<ShadowPass> passList;
     };
 
     VsmShadowOptions const& vsmShadowOptions = view.getVsmShadowOptions();
 
     auto& prepareShadowPass = fg.addPass<PrepareShadowPassData>("Prepare Shadow Pass",
             [&](FrameGraph::Builder& builder, auto& data) {
-                data.passList.reserve(CONFIG_MAX_SHADOWMAPS);
-                data.shadows = builder.createTexture("Shadowmap", {
+                mShadowPassList.clear();
+                // no-op unless this view uses more shadow maps than the inline storage holds
+                mShadowPassList.reserve(textureRequirements.layers);
+                FrameGraphTexture::Descriptor const shadowmapDesc{
                         .width = textureRequirements.size, .height = textureRequirements.size,
                         .depth = textureRequirements.layers,
                         .levels = textureRequirements.levels,
                         .type = SamplerType::SAMPLER_2D_ARRAY,
                         .format = textureRequirements.format
-                });
+                };
+                data.shadows = cachingEnabled
+                        ? fg.import("Shadowmap", shadowmapDesc,
+                                FrameGraphTexture::Usage::DEPTH_ATTACHMENT |
+                                FrameGraphTexture::Usage::SAMPLEABLE,
+                                FrameGraphTexture{ .handle = mCachedAtlasTexture })
+                        : builder.createTexture("Shadowmap", shadowmapDesc);
 
                 // these loops create a list of the shadow maps that might need to be rendered
-                auto& passList = data.passList;
+                auto& passList = mShadowPassList;
 
                 // Directional, cascaded shadow maps
                 auto const directionalShadowCastersRange = view.getVisibleDirectionalShadowCasters();
@@ -193,6 +283,15 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
                 if (!spotShadowCastersRange.empty()) {
                     for (auto& shadowMap : getSpotShadowMaps()) {
                         assert_invariant(!shadowMap.isDirectionalShadow());
+                        if (cachingEnabled) {
+                            uint32_t const hash = computeShadowMapContentHash(
+                                    shadowMap, scene->getLightData(), spotCasterHash);
+                            if (shadowMap.isCachedContentValid(hash)) {
+                                // the atlas layer already holds up-to-date contents
+                                continue;
+                            }
+                            shadowMap.setCachedContent(hash);
+                        }
                         passList.push_back({
                                 {}, &shadowMap, spotShadowCastersRange,
                                 VISIBLE_DYN_SHADOW_RENDERABLE });
@@ -200,6 +299,7 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
                 }
 
                 assert_invariant(passList.size() <= textureRequirements.layers);
+                data.passList = { passList.data(), passList.size() };
 
                 // This pass must be declared as having a side effect because it never gets a
                 // "read" from one of its resource (only writes), so the FrameGraph culls it.
@@ -215,7 +315,21 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
                 // pieces of state are needed only until shadowMap.render() returns.
                 // Conceptually, we could store this out-of-band.
 
+                // stage the uniforms of all the shadow maps in one block, they're
+                // uploaded together at the end of this loop
+                mPerShadowMapUniforms.beginFrame(driver, data.passList.size());
+
+                // cull the casters of all spot/point shadow maps upfront, in batches of
+                // several frusta per pass over the caster list. Point lights are culled once
+                // against their bounds, the result is shared by all six faces.
+                cullSpotShadowMaps(engine, scene->getRenderableData(), scene->getLightData(),
+                        data.passList);
+
                 // Generate a RenderPass for each shadow map
+                size_t spotPassIndex = 0;
+                size_t currentPointLight = std::numeric_limits<size_t>::max();
+                RenderPass::Executor pointLightExecutor;
+                bool pointLightExecutorValid = false;
                 for (auto const& entry : data.passList) {
                     ShadowMap& shadowMap = *entry.shadowMap;
 
@@ -223,16 +337,38 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
                     switch (shadowMap.getShadowType()) {
                         case ShadowType::DIRECTIONAL:
                             break;
-                        case ShadowType::SPOT:
+                        case ShadowType::SPOT: {
+                            auto const [cullResults, cullBit] =
+                                    spotShadowCullResultsFor(spotPassIndex++);
                             prepareSpotShadowMap(shadowMap, engine, view, mainCameraInfo,
                                     scene->getRenderableData(), entry.range,
-                                    scene->getLightData(), mSceneInfo);
+                                    scene->getLightData(), mSceneInfo, cullResults, cullBit);
                             break;
-                        case ShadowType::POINT:
+                        }
+                        case ShadowType::POINT: {
+                            if (shadowMap.getLightIndex() != currentPointLight) {
+                                // first face of this light: merge the cull result shared by
+                                // all six faces into the visibility masks, once
+                                currentPointLight = shadowMap.getLightIndex();
+                                pointLightExecutorValid = false;
+                                auto const [cullResults, cullBit] =
+                                        spotShadowCullResultsFor(spotPassIndex++);
+                                auto& renderableData = scene->getRenderableData();
+                                updateSpotVisibilityMasks(
+                                        view.getVisibleLayers(),
+                                        renderableData.data<FScene::LAYERS>()
+                                                + entry.range.first,
+                                        renderableData.data<FScene::VISIBILITY_STATE>()
+                                                + entry.range.first,
+                                        cullResults, cullBit,
+                                        renderableData.data<FScene::VISIBLE_MASK>()
+                                                + entry.range.first,
+                                        entry.range.size());
+                            }
                             preparePointShadowMap(shadowMap, engine, view, mainCameraInfo,
-                                    scene->getRenderableData(), entry.range,
                                     scene->getLightData(), mSceneInfo);
                             break;
+                        }
                     }
 
                     if (shadowMap.hasVisibleShadows()) {
@@ -244,33 +380,50 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
                         //       a lot of unneeded draw calls.
                         //       To do this efficiently, we'd need a way to cull draw calls already
                         //       recorded in the command buffer, per shadow map.
+                        //       We do this for the six faces of a point light, which render
+                        //       the same caster set and share one command list (see below).
 
 
                         // cameraInfo only valid after calling update
                         const CameraInfo cameraInfo{ shadowMap.getCamera(), mainCameraInfo };
 
-                        auto transaction = ShadowMap::open(driver);
+                        auto transaction = mPerShadowMapUniforms.open();
                         ShadowMap::prepareCamera(transaction, engine, cameraInfo);
                         ShadowMap::prepareViewport(transaction, shadowMap.getViewport());
                         ShadowMap::prepareTime(transaction, engine, userTime);
                         ShadowMap::prepareShadowMapping(transaction,
                                 vsmShadowOptions.highPrecision);
-                        shadowMap.commit(transaction, driver);
-
-                        // updatePrimitivesLod must be run before RenderPass::appendCommands.
-                        view.updatePrimitivesLod(engine,
-                                cameraInfo, scene->getRenderableData(), entry.range);
-
-                        // generate and sort the commands for rendering the shadow map
-                        RenderPass pass(passTemplate);
-                        pass.setCamera(cameraInfo);
-                        pass.setVisibilityMask(entry.visibilityMask);
-                        pass.setGeometry(scene->getRenderableData(),
-                                entry.range, scene->getRenderableUBO());
-                        pass.appendCommands(engine, RenderPass::SHADOW);
-                        pass.sortCommands(engine);
-
-                        entry.executor = pass.getExecutor();
+                        shadowMap.commit(transaction, mPerShadowMapUniforms);
+
+                        if (shadowMap.getShadowType() == ShadowType::POINT
+                                && pointLightExecutorValid) {
+                            // The commands are face-independent: the face's camera lives in
+                            // the per-shadow-map UBO, which is bound outside the command list
+                            // (see shadowMap.bind() in the shadow pass below). Reuse the
+                            // command list generated for this light's first face; casters not
+                            // visible from this face are clipped away on the GPU.
+                            entry.executor = pointLightExecutor;
+                        } else {
+                            // updatePrimitivesLod must be run before RenderPass::appendCommands.
+                            view.updatePrimitivesLod(engine,
+                                    cameraInfo, scene->getRenderableData(), entry.range);
+
+                            // generate and sort the commands for rendering the shadow map
+                            RenderPass pass(passTemplate);
+                            pass.setCamera(cameraInfo);
+                            pass.setVisibilityMask(entry.visibilityMask);
+                            pass.setGeometry(scene->getRenderableData(),
+                                    entry.range, scene->getRenderableUBO());
+                            pass.appendCommands(engine, RenderPass::SHADOW);
+                            pass.sortCommands(engine);
+
+                            entry.executor = pass.getExecutor();
+
+                            if (shadowMap.getShadowType() == ShadowType::POINT) {
+                                pointLightExecutor = entry.executor;
+                                pointLightExecutorValid = true;
+                            }
+                        }
 
                         if (!view.hasVSM()) {
                             auto const* options = shadowMap.getShadowOptions();
@@ -283,7 +436,8 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
                     }
                 }
 
-                // Finally update our UBO in one batch
+                // Finally update our UBOs in one batch
+                mPerShadowMapUniforms.endFrame(driver);
                 if (mShadowUb.isDirty()) {
                     driver.updateBufferObject(mShadowUbh,
                             mShadowUb.toBufferDescriptor(driver), 0);
@@ -395,7 +549,7 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
 
                     engine.flush();
                     driver.beginRenderPass(rt.target, rt.params);
-                    entry.shadowMap->bind(driver);
+                    entry.shadowMap->bind(mPerShadowMapUniforms, driver);
                     entry.executor.overrideScissor(entry.shadowMap->getScissor());
                     entry.executor.execute(engine, "Shadow Pass");
                     driver.endRenderPass();
@@ -506,10 +660,11 @@ ShadowMapManager::ShadowTechnique ShadowMapManager::updateCascadeShadowMaps(FEng
         p[3].z = (sf * F.w - sn * N.w) * 0.5f;
     }
 
+    uint16_t const textureDimension = uint16_t(scaledMapSize(options.mapSize));
     const ShadowMap::ShadowMapInfo shadowMapInfo{
             .atlasDimension      = mTextureAtlasRequirements.size,
-            .textureDimension    = uint16_t(options.mapSize),
-            .shadowDimension     = uint16_t(options.mapSize - 2u),
+            .textureDimension    = textureDimension,
+            .shadowDimension     = uint16_t(textureDimension - 2u),
             .textureSpaceFlipped = engine.getBackend() == Backend::METAL ||
                                    engine.getBackend() == Backend::VULKAN,
             .vsm                 = view.hasVSM()
@@ -655,18 +810,19 @@ void ShadowMapManager::updateSpotVisibilityMasks(
         uint8_t visibleLayers,
         uint8_t const* UTILS_RESTRICT layers,
         FRenderableManager::Visibility const* UTILS_RESTRICT visibility,
+        Culler::result_type const* UTILS_RESTRICT cullResults,
+        Culler::result_type cullBit,
         Culler::result_type* UTILS_RESTRICT visibleMask, size_t count) {
     // __restrict__ seems to only be taken into account as function parameters. This is very
     // important here, otherwise, this loop doesn't get vectorized.
     // This is vectorized 16x.
     count = (count + 0xFu) & ~0xFu; // capacity guaranteed to be multiple of 16
     for (size_t i = 0; i < count; ++i) {
-        const Culler::result_type mask = visibleMask[i];
         const FRenderableManager::Visibility v = visibility[i];
         const bool inVisibleLayer = layers[i] & visibleLayers;
 
         const bool visSpotShadowRenderable = v.castShadows && inVisibleLayer &&
-                (!v.culling || (mask & VISIBLE_DYN_SHADOW_RENDERABLE));
+                (!v.culling || (cullResults[i] & cullBit));
 
         using Type = Culler::result_type;
 
@@ -675,57 +831,146 @@ void ShadowMapManager::updateSpotVisibilityMasks(
     }
 }
 
-void ShadowMapManager::prepareSpotShadowMap(ShadowMap& shadowMap,
-        FEngine& engine, FView& view, CameraInfo const& mainCameraInfo,
-        FScene::RenderableSoa& renderableData, utils::Range<uint32_t> range,
-        FScene::LightSoa& lightData, ShadowMap::SceneInfo const& sceneInfo) noexcept {
+// culling frustum of a spot shadow map (same camera setup as ShadowMap::updateSpot())
+static Frustum computeSpotShadowMapFrustum(FEngine& engine,
+        FScene::LightSoa const& lightData, size_t lightIndex) noexcept {
     auto& lcm = engine.getLightManager();
-
-    const size_t lightIndex = shadowMap.getLightIndex();
     const FLightManager::Instance li = lightData.elementAt<FScene::LIGHT_INSTANCE>(lightIndex);
-    FLightManager::ShadowOptions const* const options = shadowMap.getShadowOptions();
-
-    // compute the frustum for this light
-    // for spotlights, we cull shadow casters first because we already know the frustum,
-    // this will help us find better near/far plane later
     const auto position = lightData.elementAt<FScene::POSITION_RADIUS>(lightIndex).xyz;
     const auto direction = lightData.elementAt<FScene::DIRECTION>(lightIndex);
     const auto radius = lightData.elementAt<FScene::POSITION_RADIUS>(lightIndex).w;
     const auto outerConeAngle = lcm.getSpotLightOuterCone(li);
-
-    // compute shadow map frustum for culling
     const mat4f Mv = ShadowMap::getDirectionalLightViewMatrix(direction, { 0, 1, 0 }, position);
     const mat4f Mp = mat4f::perspective(outerConeAngle * f::RAD_TO_DEG * 2.0f, 1.0f, 0.01f, radius);
-    const mat4f MpMv = math::highPrecisionMultiply(Mp, Mv);
-    const Frustum frustum(MpMv);
+    return Frustum{ math::highPrecisionMultiply(Mp, Mv) };
+}
+
+// culling volume of a whole point shadow map (i.e. all six faces at once): the axis-aligned
+// box of half-extent `radius` centered on the light, which bounds the union of the six
+// 90-degree face frusta. The six faces share this single cull result; a caster visible from
+// only some of the faces is clipped away on the GPU for the others.
+static Frustum computePointShadowMapBounds(
+        FScene::LightSoa const& lightData, size_t lightIndex) noexcept {
+    const auto position = lightData.elementAt<FScene::POSITION_RADIUS>(lightIndex).xyz;
+    const auto radius = lightData.elementAt<FScene::POSITION_RADIUS>(lightIndex).w;
+    const mat4f Mv = mat4f::translation(-position);
+    const mat4f Mp = mat4f::ortho(-radius, radius, -radius, radius, -radius, radius);
+    return Frustum{ math::highPrecisionMultiply(Mp, Mv) };
+}
+
+void ShadowMapManager::cullSpotShadowMaps(FEngine& engine,
+        FScene::RenderableSoa const& renderableData, FScene::LightSoa const& lightData,
+        utils::Slice<ShadowPass> passList) noexcept {
+
+    // all spot/point shadow maps share the same caster range. The six faces of a point
+    // light are culled together against the light's bounds and consume a single slot.
+    size_t spotPassCount = 0;
+    size_t lastPointLight = std::numeric_limits<size_t>::max();
+    utils::Range<uint32_t> range{};
+    for (auto const& entry : passList) {
+        switch (entry.shadowMap->getShadowType()) {
+            case ShadowType::DIRECTIONAL:
+                continue;
+            case ShadowType::SPOT:
+                range = entry.range;
+                spotPassCount++;
+                break;
+            case ShadowType::POINT:
+                range = entry.range;
+                if (entry.shadowMap->getLightIndex() != lastPointLight) {
+                    lastPointLight = entry.shadowMap->getLightIndex();
+                    spotPassCount++;
+                }
+                break;
+        }
+    }
+    if (!spotPassCount || range.empty()) {
+        return;
+    }
+
+    // updateSpotVisibilityMasks() reads the results by batches of 16
+    size_t const stride = (range.size() + 0xFu) & ~0xFu;
+    size_t const batchCount =
+            (spotPassCount + Culler::MAX_BATCH_FRUSTUM_COUNT - 1)
+                    / Culler::MAX_BATCH_FRUSTUM_COUNT;
+    mSpotShadowCullStride = stride;
+    mSpotShadowCullResults.resize(batchCount * stride);
 
-    // Cull shadow casters
     float3 const* worldAABBCenter = renderableData.data<FScene::WORLD_AABB_CENTER>();
     float3 const* worldAABBExtent = renderableData.data<FScene::WORLD_AABB_EXTENT>();
-    FScene::VisibleMaskType* visibleArray = renderableData.data<FScene::VISIBLE_MASK>();
-    Culler::intersects(
-            visibleArray + range.first,
-            frustum,
-            worldAABBCenter + range.first,
-            worldAABBExtent + range.first,
-            range.size(),
-            VISIBLE_DYN_SHADOW_RENDERABLE_BIT);
 
-    // update their visibility mask
+    // cull MAX_BATCH_FRUSTUM_COUNT frusta per pass over the caster list, instead of one
+    // full pass per shadow map
+    Frustum frusta[Culler::MAX_BATCH_FRUSTUM_COUNT];
+    size_t batch = 0;
+    size_t frustumCount = 0;
+    auto flush = [&]() {
+        Culler::intersects(
+                mSpotShadowCullResults.data() + batch * stride,
+                frusta, frustumCount,
+                worldAABBCenter + range.first,
+                worldAABBExtent + range.first,
+                range.size());
+        batch++;
+        frustumCount = 0;
+    };
+    lastPointLight = std::numeric_limits<size_t>::max();
+    for (auto const& entry : passList) {
+        ShadowMap const& shadowMap = *entry.shadowMap;
+        switch (shadowMap.getShadowType()) {
+            case ShadowType::DIRECTIONAL:
+                continue;
+            case ShadowType::SPOT:
+                frusta[frustumCount++] = computeSpotShadowMapFrustum(
+                        engine, lightData, shadowMap.getLightIndex());
+                break;
+            case ShadowType::POINT:
+                if (shadowMap.getLightIndex() == lastPointLight) {
+                    continue; // this face shares the slot of the light's first face
+                }
+                lastPointLight = shadowMap.getLightIndex();
+                frusta[frustumCount++] = computePointShadowMapBounds(
+                        lightData, shadowMap.getLightIndex());
+                break;
+        }
+        if (frustumCount == Culler::MAX_BATCH_FRUSTUM_COUNT) {
+            flush();
+        }
+    }
+    if (frustumCount) {
+        flush();
+    }
+}
+
+void ShadowMapManager::prepareSpotShadowMap(ShadowMap& shadowMap,
+        FEngine& engine, FView& view, CameraInfo const& mainCameraInfo,
+        FScene::RenderableSoa& renderableData, utils::Range<uint32_t> range,
+        FScene::LightSoa& lightData, ShadowMap::SceneInfo const& sceneInfo,
+        Culler::result_type const* cullResults, Culler::result_type cullBit) noexcept {
+
+    const size_t lightIndex = shadowMap.getLightIndex();
+    FLightManager::ShadowOptions const* const options = shadowMap.getShadowOptions();
+
+    // Shadow casters were culled upfront in cullSpotShadowMaps(), merge the result for
+    // this shadow map into the visibility mask.
+    FScene::VisibleMaskType* visibleArray = renderableData.data<FScene::VISIBLE_MASK>();
     uint8_t const* layers = renderableData.data<FScene::LAYERS>();
     auto const* visibility = renderableData.data<FScene::VISIBILITY_STATE>();
     updateSpotVisibilityMasks(
             view.getVisibleLayers(),
             layers + range.first,
             visibility + range.first,
+            cullResults,
+            cullBit,
             visibleArray + range.first,
             range.size());
 
     // update the shadow map frustum/camera
+    uint16_t const textureDimension = uint16_t(scaledMapSize(options->mapSize));
     const ShadowMap::ShadowMapInfo shadowMapInfo{
             .atlasDimension      = mTextureAtlasRequirements.size,
-            .textureDimension    = uint16_t(options->mapSize),
-            .shadowDimension     = uint16_t(options->mapSize - 2u),
+            .textureDimension    = textureDimension,
+            .shadowDimension     = uint16_t(textureDimension - 2u),
             .textureSpaceFlipped = engine.getBackend() == Backend::METAL ||
                                    engine.getBackend() == Backend::VULKAN,
             .vsm                 = view.hasVSM()
@@ -761,7 +1006,6 @@ void ShadowMapManager::prepareSpotShadowMap(ShadowMap& shadowMap,
 
 void ShadowMapManager::preparePointShadowMap(ShadowMap& shadowMap,
         FEngine& engine, FView& view, CameraInfo const& mainCameraInfo,
-        FScene::RenderableSoa& renderableData, utils::Range<uint32_t> range,
         FScene::LightSoa& lightData,
         ShadowMap::SceneInfo const& sceneInfo) noexcept {
 
@@ -769,44 +1013,15 @@ void ShadowMapManager::preparePointShadowMap(ShadowMap& shadowMap,
     const size_t lightIndex = shadowMap.getLightIndex();
     FLightManager::ShadowOptions const* const options = shadowMap.getShadowOptions();
 
-    // compute the frustum for this light
-    // for spotlights, we cull shadow casters first because we already know the frustum,
-    // this will help us find better near/far plane later
-    const auto position = lightData.elementAt<FScene::POSITION_RADIUS>(lightIndex).xyz;
-    const auto radius = lightData.elementAt<FScene::POSITION_RADIUS>(lightIndex).w;
-
-    // compute shadow map frustum for culling
-    const mat4f Mv = ShadowMap::getPointLightViewMatrix(TextureCubemapFace(face), position);
-    const mat4f Mp = mat4f::perspective(90.0f, 1.0f, 0.01f, radius);
-    const Frustum frustum{ math::highPrecisionMultiply(Mp, Mv) };
-
-    // Cull shadow casters
-    float3 const* worldAABBCenter = renderableData.data<FScene::WORLD_AABB_CENTER>();
-    float3 const* worldAABBExtent = renderableData.data<FScene::WORLD_AABB_EXTENT>();
-    FScene::VisibleMaskType* visibleArray = renderableData.data<FScene::VISIBLE_MASK>();
-    Culler::intersects(
-            visibleArray + range.first,
-            frustum,
-            worldAABBCenter + range.first,
-            worldAABBExtent + range.first,
-            range.size(),
-            VISIBLE_DYN_SHADOW_RENDERABLE_BIT);
-
-    // update their visibility mask
-    uint8_t const* layers = renderableData.data<FScene::LAYERS>();
-    auto const* visibility = renderableData.data<FScene::VISIBILITY_STATE>();
-    updateSpotVisibilityMasks(
-            view.getVisibleLayers(),
-            layers + range.first,
-            visibility + range.first,
-            visibleArray + range.first,
-            range.size());
+    // Note: the visibility masks were already updated by the caller, once for all six
+    // faces of this light (they all share the same cull result).
 
     // update the shadow map frustum/camera
+    uint16_t const textureDimension = uint16_t(scaledMapSize(options->mapSize));
     const ShadowMap::ShadowMapInfo shadowMapInfo{
             .atlasDimension      = mTextureAtlasRequirements.size,
-            .textureDimension    = uint16_t(options->mapSize),
-            .shadowDimension     = uint16_t(options->mapSize), // point-lights don't have a border
+            .textureDimension    = textureDimension,
+            .shadowDimension     = textureDimension, // point-lights don't have a border
             .textureSpaceFlipped = engine.getBackend() == Backend::METAL ||
                                    engine.getBackend() == Backend::VULKAN,
             .vsm                 = view.hasVSM()
@@ -893,13 +1108,13 @@ void ShadowMapManager::calculateTextureRequirements(FEngine& engine, FView& view
     for (ShadowMap& shadowMap : getCascadedShadowMap()) {
         // Shadow map size should be the same for all cascades.
         auto const& options = shadowMap.getShadowOptions();
-        maxDimension = std::max(maxDimension, options->mapSize);
+        maxDimension = std::max(maxDimension, scaledMapSize(options->mapSize));
         elvsm = elvsm || options->vsm.elvsm;
         shadowMap.setLayer(layer++);
     }
     for (ShadowMap& shadowMap : getSpotShadowMaps()) {
         auto const& options = shadowMap.getShadowOptions();
-        maxDimension = std::max(maxDimension, options->mapSize);
+        maxDimension = std::max(maxDimension, scaledMapSize(options->mapSize));
         elvsm = elvsm || options->vsm.elvsm;
         shadowMap.setLayer(layer++);
     }
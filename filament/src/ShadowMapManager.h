@@ -19,6 +19,7 @@
 
 #include <filament/Viewport.h>
 
+#include "RenderPass.h"
 #include "ShadowMap.h"
 #include "TypedUniformBuffer.h"
 
@@ -31,18 +32,22 @@
 #include <backend/DriverEnums.h>
 #include <backend/Handle.h>
 
+#include <utils/FixedCapacityVector.h>
+#include <utils/Range.h>
 #include <utils/Slice.h>
 
 #include <math/vec3.h>
 
+#include <algorithm>
 #include <array>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace filament {
 
 class FView;
 class FrameGraph;
-class RenderPass;
 
 struct ShadowMappingUniforms {
     math::float4 cascadeSplits;
@@ -89,6 +94,12 @@ public:
     FrameGraphId<FrameGraphTexture> render(FEngine& engine, FrameGraph& fg, RenderPass const& pass,
             FView& view, CameraInfo const& mainCameraInfo, math::float4 const& userTime) noexcept;
 
+    // Applies a global scale to all shadow map dimensions, e.g. to shed GPU load under
+    // thermal pressure. Takes effect at the next call to update().
+    void setShadowResolutionScale(float scale) noexcept {
+        mShadowResolutionScale = std::clamp(scale, 0.125f, 1.0f);
+    }
+
     // valid after calling update() above
     ShadowMappingUniforms getShadowMappingUniforms() const noexcept {
         return mShadowMappingUniforms;
@@ -117,18 +128,30 @@ private:
     void prepareSpotShadowMap(ShadowMap& shadowMap,
             FEngine& engine, FView& view, CameraInfo const& mainCameraInfo,
             FScene::RenderableSoa& renderableData, utils::Range<uint32_t> range,
-            FScene::LightSoa& lightData, ShadowMap::SceneInfo const& sceneInfo) noexcept;
+            FScene::LightSoa& lightData, ShadowMap::SceneInfo const& sceneInfo,
+            Culler::result_type const* cullResults, Culler::result_type cullBit) noexcept;
 
+    // note: unlike prepareSpotShadowMap(), this doesn't merge the cull result into the
+    // visibility masks; the caller does it once for all six faces of the light.
     void preparePointShadowMap(ShadowMap& map,
             FEngine& engine, FView& view, CameraInfo const& mainCameraInfo,
-            FScene::RenderableSoa& renderableData, utils::Range<uint32_t> range,
             FScene::LightSoa& lightData,
             ShadowMap::SceneInfo const& sceneInfo) noexcept;
 
+    // FNV-1a hash of the world-space bounds of the casters in `range`
+    static uint32_t hashCasterBounds(FScene::RenderableSoa const& renderableData,
+            utils::Range<uint32_t> range) noexcept;
+
+    // hash of everything a cached spot/point shadow map's contents depend on
+    uint32_t computeShadowMapContentHash(ShadowMap const& shadowMap,
+            FScene::LightSoa const& lightData, uint32_t casterHash) const noexcept;
+
     static void updateSpotVisibilityMasks(
             uint8_t visibleLayers,
             uint8_t const* UTILS_RESTRICT layers,
             FRenderableManager::Visibility const* UTILS_RESTRICT visibility,
+            Culler::result_type const* UTILS_RESTRICT cullResults,
+            Culler::result_type cullBit,
             Culler::result_type* UTILS_RESTRICT visibleMask, size_t count);
 
     class CascadeSplits {
@@ -171,11 +194,68 @@ private:
         backend::TextureFormat format = backend::TextureFormat::DEPTH16;
     } mTextureAtlasRequirements;
 
+    // persistent shadow atlas, only used when shadow-map caching is enabled
+    // (see engine.debug.shadowmap.caching)
+    backend::Handle<backend::HwTexture> mCachedAtlasTexture;
+    TextureAtlasRequirements mCachedAtlasRequirements{};
+
+    // a RenderPass per shadow map. The list is rebuilt each frame in render(), but its
+    // storage is owned here so that steady-state frames don't allocate from the heap;
+    // common shadow map counts fit the inline storage, only scenes with many shadow
+    // maps spill to the heap (once).
+    struct ShadowPass {
+        mutable RenderPass::Executor executor;
+        ShadowMap* shadowMap;
+        utils::Range<uint32_t> range;
+        FScene::VisibleMaskType visibilityMask;
+    };
+    static constexpr size_t SHADOW_PASS_LIST_INLINE_COUNT = 8;
+    using ShadowPassList = utils::SmallCapacityVector<ShadowPass, SHADOW_PASS_LIST_INLINE_COUNT>;
+    ShadowPassList mShadowPassList{
+            ShadowPassList::with_capacity(SHADOW_PASS_LIST_INLINE_COUNT) };
+
+    // Culls the casters against the frusta of all spot/point shadow maps of the pass list
+    // upfront, in batches of Culler::MAX_BATCH_FRUSTUM_COUNT frusta per pass over the caster
+    // list (instead of one full pass per shadow map). A point light is culled once against
+    // its bounds; its six faces share the slot. Results are consumed through
+    // spotShadowCullResultsFor().
+    void cullSpotShadowMaps(FEngine& engine,
+            FScene::RenderableSoa const& renderableData, FScene::LightSoa const& lightData,
+            utils::Slice<ShadowPass> passList) noexcept;
+
+    // results + bit for the i-th cull slot (one per spot shadow map or point light), valid
+    // after cullSpotShadowMaps()
+    std::pair<Culler::result_type const*, Culler::result_type>
+    spotShadowCullResultsFor(size_t spotPassIndex) const noexcept {
+        return { mSpotShadowCullResults.data()
+                        + (spotPassIndex / Culler::MAX_BATCH_FRUSTUM_COUNT)
+                                * mSpotShadowCullStride,
+                 Culler::result_type(
+                         1u << (spotPassIndex % Culler::MAX_BATCH_FRUSTUM_COUNT)) };
+    }
+
+    // batched culling results, one entry per caster per batch of shadow maps. std::vector
+    // so that the storage is reused from frame to frame.
+    std::vector<Culler::result_type> mSpotShadowCullResults;
+    size_t mSpotShadowCullStride = 0;
+
+    // shadow-map dimension once the global resolution scale is applied. The result is
+    // quantized so that small scale changes don't reallocate the atlas every frame.
+    uint32_t scaledMapSize(uint32_t mapSize) const noexcept {
+        uint32_t const size = uint32_t(float(mapSize) * mShadowResolutionScale + 0.5f) & ~15u;
+        return std::clamp(size, std::min(64u, mapSize), mapSize);
+    }
+
     SoftShadowOptions mSoftShadowOptions;
 
+    float mShadowResolutionScale = 1.0f;
+
     mutable TypedUniformBuffer<ShadowUib> mShadowUb;
     backend::Handle<backend::HwBufferObject> mShadowUbh;
 
+    // UBO shared by all shadow maps, each one using its own slot
+    PerShadowMapUniforms mPerShadowMapUniforms;
+
     ShadowMappingUniforms mShadowMappingUniforms = {};
 
     ShadowMap::SceneInfo mSceneInfo;
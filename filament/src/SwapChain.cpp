@@ -24,6 +24,14 @@ void* SwapChain::getNativeWindow() const noexcept {
     return downcast(this)->getNativeWindow();
 }
 
+int32_t SwapChain::getExportedImageFd(size_t index) noexcept {
+    return downcast(this)->getExportedImageFd(index);
+}
+
+uint64_t SwapChain::getFrameLatencyNanos() noexcept {
+    return downcast(this)->getFrameLatencyNanos();
+}
+
 void SwapChain::setFrameScheduledCallback(FrameScheduledCallback callback, void* user) {
     return downcast(this)->setFrameScheduledCallback(callback, user);
 }
@@ -74,6 +74,20 @@ void Texture::generateMipmaps(Engine& engine) const noexcept {
     downcast(this)->generateMipmaps(downcast(engine));
 }
 
+void Texture::copyTo(Engine& engine, Texture* dst,
+        size_t dstLevel, uint32_t dstLayer, uint32_t dstX, uint32_t dstY,
+        size_t srcLevel, uint32_t srcLayer, uint32_t srcX, uint32_t srcY,
+        uint32_t width, uint32_t height) const {
+    downcast(this)->copyTo(downcast(engine), downcast(dst),
+            dstLevel, dstLayer, dstX, dstY,
+            srcLevel, srcLayer, srcX, srcY, width, height);
+}
+
+void Texture::generateMipmapsAsync(Engine& engine,
+        utils::Invocable<void()>&& callback) const noexcept {
+    downcast(this)->generateMipmapsAsync(downcast(engine), std::move(callback));
+}
+
 bool Texture::isTextureFormatSupported(Engine& engine, InternalFormat format) noexcept {
     return FTexture::isTextureFormatSupported(downcast(engine), format);
 }
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ThermalGovernor.h"
+
+namespace filament {
+
+uint32_t ThermalGovernor::targetStep(ThermalStatus status) noexcept {
+    // the ladder tops out at MODERATE; past that the OS throttles no matter what we do,
+    // so there is no point in degrading further
+    switch (status) {
+        case ThermalStatus::ERROR:
+        case ThermalStatus::NONE:
+            return 0;
+        case ThermalStatus::LIGHT:
+            return 1;
+        case ThermalStatus::MODERATE:
+            return 2;
+        default:
+            return STEP_COUNT;
+    }
+}
+
+ThermalGovernor::Caps ThermalGovernor::capsForStep(uint32_t step) noexcept {
+    // each step sheds a comparable amount of GPU work; resolution goes first because it's
+    // the cheapest to give back visually, then shadow resolution, and MSAA last
+    switch (step) {
+        default:
+        case 0: return {};
+        case 1: return { 0.75f, 1.0f,  true  };
+        case 2: return { 0.60f, 0.5f,  true  };
+        case 3: return { 0.45f, 0.5f,  false };
+    }
+}
+
+void ThermalGovernor::setEnabled(bool enabled) noexcept {
+    if (enabled != mEnabled) {
+        mEnabled = enabled;
+        mStatus = ThermalStatus::NONE;
+        mCurrentStep = 0;
+        mRecoveryFrameCount = 0;
+        mFrameCount = 0;
+        mCaps = {};
+    }
+}
+
+void ThermalGovernor::update() noexcept {
+    if (!mEnabled) {
+        return;
+    }
+
+    if (mFrameCount++ % POLL_INTERVAL_FRAME_COUNT == 0) {
+        mStatus = mThermalManager.getCurrentThermalStatus();
+    }
+
+    uint32_t const target = targetStep(mStatus);
+    if (target > mCurrentStep) {
+        // heating up: degrade immediately, before throttling hits
+        mCurrentStep = target;
+        mRecoveryFrameCount = 0;
+    } else if (target < mCurrentStep) {
+        // cooling down: only give quality back once the status has settled for a while,
+        // one step at a time (hysteresis)
+        if (++mRecoveryFrameCount >= RECOVERY_HOLD_FRAME_COUNT) {
+            mCurrentStep--;
+            mRecoveryFrameCount = 0;
+        }
+    } else {
+        mRecoveryFrameCount = 0;
+    }
+
+    mCaps = capsForStep(mCurrentStep);
+}
+
+} // namespace filament
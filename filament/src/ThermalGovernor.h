@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_THERMALGOVERNOR_H
+#define TNT_FILAMENT_THERMALGOVERNOR_H
+
+#include <utils/ThermalManager.h>
+
+#include <stdint.h>
+
+namespace filament {
+
+/*
+ * Sheds GPU quality proactively as the device heats up, before the OS starts throttling.
+ * The thermal status is polled periodically and mapped to a step on a small degradation
+ * ladder; stepping down (hotter) is immediate, while quality is only given back after the
+ * status has settled, one step at a time, so we don't oscillate around a thermal threshold.
+ */
+class ThermalGovernor {
+public:
+    using ThermalStatus = utils::ThermalManager::ThermalStatus;
+
+    // number of degradation steps on the ladder, step 0 is full quality
+    static constexpr uint32_t STEP_COUNT = 3;
+
+    // quality caps for the current frame, all neutral at step 0
+    struct Caps {
+        float dynamicResolutionScale = 1.0f;    // ceiling on the dynamic resolution scale
+        float shadowResolutionScale = 1.0f;     // scale applied to shadow map dimensions
+        bool msaa = true;                       // whether MSAA is still allowed
+    };
+
+    // call once per frame, before the caps are read
+    void update() noexcept;
+
+    Caps getCaps() const noexcept { return mCaps; }
+
+    void setEnabled(bool enabled) noexcept;
+
+    bool isEnabled() const noexcept { return mEnabled; }
+
+private:
+    // the status query can be a system call, poll at ~1Hz assuming 60fps
+    static constexpr uint32_t POLL_INTERVAL_FRAME_COUNT = 64;
+    // frames the status must stay lower before a step is given back (~10s at 60fps)
+    static constexpr uint32_t RECOVERY_HOLD_FRAME_COUNT = 600;
+
+    static uint32_t targetStep(ThermalStatus status) noexcept;
+    static Caps capsForStep(uint32_t step) noexcept;
+
+    utils::ThermalManager mThermalManager;
+    Caps mCaps;
+    ThermalStatus mStatus = ThermalStatus::NONE;
+    uint32_t mCurrentStep = 0;
+    uint32_t mRecoveryFrameCount = 0;
+    uint32_t mFrameCount = 0;
+    bool mEnabled = false;
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_THERMALGOVERNOR_H
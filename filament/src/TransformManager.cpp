@@ -30,6 +30,10 @@ size_t TransformManager::getComponentCount() const noexcept {
     return downcast(this)->getComponentCount();
 }
 
+void TransformManager::reserve(size_t count) noexcept {
+    downcast(this)->reserve(count);
+}
+
 bool TransformManager::empty() const noexcept {
     return downcast(this)->empty();
 }
@@ -26,7 +26,8 @@ namespace filament {
 UniformBuffer::UniformBuffer(size_t size) noexcept
         : mBuffer(mStorage),
           mSize(uint32_t(size)),
-          mSomethingDirty(true) {
+          mDirtyStart(0),
+          mDirtyEnd(uint32_t(size)) {
     if (UTILS_LIKELY(size > sizeof(mStorage))) {
         mBuffer = UniformBuffer::alloc(size);
     }
@@ -36,7 +37,8 @@ UniformBuffer::UniformBuffer(size_t size) noexcept
 UniformBuffer::UniformBuffer(UniformBuffer&& rhs) noexcept
         : mBuffer(rhs.mBuffer),
           mSize(rhs.mSize),
-          mSomethingDirty(rhs.mSomethingDirty) {
+          mDirtyStart(rhs.mDirtyStart),
+          mDirtyEnd(rhs.mDirtyEnd) {
     if (UTILS_LIKELY(rhs.isLocalStorage())) {
         mBuffer = mStorage;
         memcpy(mBuffer, rhs.mBuffer, mSize);
@@ -47,7 +49,8 @@ UniformBuffer::UniformBuffer(UniformBuffer&& rhs) noexcept
 
 UniformBuffer& UniformBuffer::operator=(UniformBuffer&& rhs) noexcept {
     if (this != &rhs) {
-        mSomethingDirty = rhs.mSomethingDirty;
+        mDirtyStart = rhs.mDirtyStart;
+        mDirtyEnd = rhs.mDirtyEnd;
         if (UTILS_LIKELY(rhs.isLocalStorage())) {
             mBuffer = mStorage;
             mSize = rhs.mSize;
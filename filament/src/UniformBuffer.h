@@ -31,6 +31,8 @@
 #include <math/mat3.h>
 #include <math/mat4.h>
 
+#include <limits>
+
 #include <stddef.h>
 #include <string.h>
 
@@ -69,7 +71,8 @@ public:
     // invalidate a range of uniforms and return a pointer to it. offset and size given in bytes
     void* invalidateUniforms(size_t offset, size_t size) {
         assert_invariant(offset + size <= mSize);
-        mSomethingDirty = true;
+        mDirtyStart = std::min(mDirtyStart, uint32_t(offset));
+        mDirtyEnd = std::max(mDirtyEnd, uint32_t(offset + size));
         return static_cast<char*>(mBuffer) + offset;
     }
 
@@ -84,10 +87,19 @@ public:
     size_t getSize() const noexcept { return mSize; }
 
     // return if any uniform has been changed
-    bool isDirty() const noexcept { return mSomethingDirty; }
+    bool isDirty() const noexcept { return mDirtyStart < mDirtyEnd; }
+
+    // offset in bytes of the modified range, only valid if isDirty() is true
+    size_t getDirtyOffset() const noexcept { return mDirtyStart; }
+
+    // size in bytes of the modified range, only valid if isDirty() is true
+    size_t getDirtySize() const noexcept { return mDirtyEnd - mDirtyStart; }
 
     // mark the whole buffer as clean (no modified uniforms)
-    void clean() const noexcept { mSomethingDirty = false; }
+    void clean() const noexcept {
+        mDirtyStart = std::numeric_limits<uint32_t>::max();
+        mDirtyEnd = 0;
+    }
 
     /*
      * -----------------------------------------------
@@ -203,7 +215,9 @@ private:
     char mStorage[96];
     void *mBuffer = nullptr;
     uint32_t mSize = 0;
-    mutable bool mSomethingDirty = false;
+    // modified byte range [mDirtyStart, mDirtyEnd), empty when clean
+    mutable uint32_t mDirtyStart = std::numeric_limits<uint32_t>::max();
+    mutable uint32_t mDirtyEnd = 0;
 };
 
 // specialization for mat3f (which has a different alignment, see std140 layout rules)
@@ -51,6 +51,14 @@ bool View::isFrustumCullingEnabled() const noexcept {
     return downcast(this)->isFrustumCullingEnabled();
 }
 
+void View::setOcclusionCullingEnabled(bool enabled) noexcept {
+    downcast(this)->setOcclusionCullingEnabled(enabled);
+}
+
+bool View::isOcclusionCullingEnabled() const noexcept {
+    return downcast(this)->isOcclusionCullingEnabled();
+}
+
 void View::setDebugCamera(Camera* camera) noexcept {
     downcast(this)->setViewingCamera(downcast(camera));
 }
@@ -283,6 +291,22 @@ bool View::isStencilBufferEnabled() const noexcept {
     return downcast(this)->isStencilBufferEnabled();
 }
 
+void View::setPerformanceHudEnabled(bool enabled) noexcept {
+    downcast(this)->setPerformanceHudEnabled(enabled);
+}
+
+bool View::isPerformanceHudEnabled() const noexcept {
+    return downcast(this)->isPerformanceHudEnabled();
+}
+
+void View::setShadingRate(backend::ShadingRate rate) noexcept {
+    downcast(this)->setShadingRate(rate);
+}
+
+backend::ShadingRate View::getShadingRate() const noexcept {
+    return downcast(this)->getShadingRate();
+}
+
 void View::setStereoscopicOptions(const StereoscopicOptions& options) noexcept {
     return downcast(this)->setStereoscopicOptions(options);
 }
@@ -67,6 +67,7 @@ struct RenderableManager::BuilderDetails {
     uint32_t mSkinningBufferOffset = 0;
     utils::FixedCapacityVector<math::float2> mBoneIndicesAndWeights;
     size_t mBoneIndicesAndWeightsCount = 0;
+    FRenderableManager::LodGroups mLodGroups;
 
     // bone indices and weights defined for primitive index
     std::unordered_map<size_t, utils::FixedCapacityVector<
@@ -123,6 +124,17 @@ RenderableManager::Builder& RenderableManager::Builder::geometry(size_t index,
     return *this;
 }
 
+RenderableManager::Builder& RenderableManager::Builder::lodGroup(size_t level,
+        size_t primitiveOffset, size_t primitiveCount, float minCoverage) noexcept {
+    FRenderableManager::LodGroups& lodGroups = mImpl->mLodGroups;
+    if (level < FRenderableManager::LodGroups::MAX_LOD_COUNT) {
+        lodGroups.groups[level] = {
+                uint16_t(primitiveOffset), uint16_t(primitiveCount), minCoverage };
+        lodGroups.count = std::max(lodGroups.count, uint8_t(level + 1));
+    }
+    return *this;
+}
+
 RenderableManager::Builder& RenderableManager::Builder::material(size_t index,
         MaterialInstance const* materialInstance) noexcept {
     if (index < mImpl->mEntries.size()) {
@@ -408,6 +420,14 @@ RenderableManager::Builder::Result RenderableManager::Builder::build(Engine& eng
         mImpl->processBoneIndicesAndWights(engine, entity);
     }
 
+    for (size_t i = 0, c = mImpl->mLodGroups.count; i < c; i++) {
+        auto const& group = mImpl->mLodGroups.groups[i];
+        ASSERT_PRECONDITION(group.offset + group.count <= mImpl->mEntries.size(),
+                "[entity=%u, lod group @ %zu] offset (%u) + count (%u) > primitive count (%zu)",
+                entity.getId(), i,
+                group.offset, group.count, mImpl->mEntries.size());
+    }
+
     for (size_t i = 0, c = mImpl->mEntries.size(); i < c; i++) {
         auto& entry = mImpl->mEntries[i];
 
@@ -500,6 +520,7 @@ void FRenderableManager::create(
     if (UTILS_UNLIKELY(manager.hasComponent(entity))) {
         destroy(entity);
     }
+    mVersion++;
     Instance const ci = manager.addComponent(entity);
     assert_invariant(ci);
 
@@ -514,6 +535,7 @@ void FRenderableManager::create(
             rp[i].init(factory, driver, entries[i]);
         }
         setPrimitives(ci, { rp, size_type(entryCount) });
+        setLodGroups(ci, builder->mLodGroups);
 
         setAxisAlignedBoundingBox(ci, builder->mAABB);
         setLayerMask(ci, builder->mLayerMask);
@@ -695,6 +717,7 @@ void FRenderableManager::gc(utils::EntityManager& em) noexcept {
 
 // This is basically a Renderable's destructor.
 void FRenderableManager::destroyComponent(Instance ci) noexcept {
+    mVersion++;
     auto& manager = mManager;
     FEngine& engine = mEngine;
 
@@ -740,6 +763,19 @@ void FRenderableManager::destroyComponentMorphTargets(FEngine&,
     delete[] morphTargets.data();
 }
 
+Slice<FRenderPrimitive> FRenderableManager::getLodPrimitives(
+        Instance instance, uint8_t level) const noexcept {
+    Slice<FRenderPrimitive> const& primitives = mManager[instance].primitives;
+    LodGroups const& lod = mManager[instance].lodGroups;
+    if (UTILS_LIKELY(lod.count == 0)) {
+        return primitives;
+    }
+    auto const& group = lod.groups[std::min(size_t(level), size_t(lod.count) - 1u)];
+    size_t const offset = std::min(size_t(group.offset), primitives.size());
+    size_t const count = std::min(size_t(group.count), primitives.size() - offset);
+    return { primitives.data() + offset, count };
+}
+
 void FRenderableManager::setMaterialInstanceAt(Instance instance, uint8_t level,
         size_t primitiveIndex, FMaterialInstance const* mi) {
     if (instance) {
@@ -883,6 +919,9 @@ void FRenderableManager::setSkinningBuffer(FRenderableManager::Instance ci,
     bones.handle = skinningBuffer->getHwHandle();
     bones.count = uint16_t(count);
     bones.offset = uint16_t(offset);
+
+    // the binding info is gathered into the scene's renderable SoA
+    mVersion++;
 }
 
 static void updateMorphWeights(FEngine& engine, backend::Handle<backend::HwBufferObject> handle,
@@ -38,6 +38,8 @@
 #include <utils/Slice.h>
 #include <utils/Range.h>
 
+#include <algorithm>
+
 namespace filament {
 
 class FBufferObject;
@@ -75,6 +77,19 @@ public:
         uint32_t count = 0;
     };
 
+    // level-of-detail groups, each a contiguous range of the renderable's primitives
+    // (see RenderableManager::Builder::lodGroup())
+    struct LodGroups {
+        static constexpr size_t MAX_LOD_COUNT = 4;
+        struct Group {
+            uint16_t offset = 0;        // first primitive of the group
+            uint16_t count = 0;         // number of primitives in the group
+            float minCoverage = 0.0f;   // group selected when coverage >= minCoverage
+        };
+        Group groups[MAX_LOD_COUNT];
+        uint8_t count = 0;              // number of groups, 0 when the feature is unused
+    };
+
     explicit FRenderableManager(FEngine& engine) noexcept;
     ~FRenderableManager();
 
@@ -99,6 +114,10 @@ public:
         return mManager.getComponentCount();
     }
 
+    void reserve(size_t count) noexcept {
+        mManager.reserve(count);
+    }
+
     bool empty() const noexcept {
         return mManager.empty();
     }
@@ -117,6 +136,10 @@ public:
 
     inline void setAxisAlignedBoundingBox(Instance instance, const Box& aabb) noexcept;
 
+    // Incremented whenever components are created/destroyed or a bounding box changes;
+    // lets FView detect that culling inputs are unchanged (see FView's culling cache).
+    uint32_t getVersion() const noexcept { return mVersion; }
+
     inline void setLayerMask(Instance instance, uint8_t select, uint8_t values) noexcept;
 
     // The priority is clamped to the range [0..7]
@@ -136,6 +159,8 @@ public:
 
     inline void setPrimitives(Instance instance, utils::Slice<FRenderPrimitive> const& primitives) noexcept;
 
+    inline void setLodGroups(Instance instance, LodGroups const& lodGroups) noexcept;
+
     inline void setSkinning(Instance instance, bool enable) noexcept;
     void setBones(Instance instance, Bone const* transforms, size_t boneCount, size_t offset = 0);
     void setBones(Instance instance, math::mat4f const* transforms, size_t boneCount, size_t offset = 0);
@@ -205,6 +230,12 @@ public:
     AttributeBitset getEnabledAttributesAt(Instance instance, uint8_t level, size_t primitiveIndex) const noexcept;
     inline utils::Slice<FRenderPrimitive> const& getRenderPrimitives(Instance instance, uint8_t level) const noexcept;
     inline utils::Slice<FRenderPrimitive>& getRenderPrimitives(Instance instance, uint8_t level) noexcept;
+    // number of lod groups, 0 when the renderable doesn't use them
+    inline uint8_t getLodGroupCount(Instance instance) const noexcept;
+    // selects the lod group for the given estimated screen coverage
+    inline uint8_t getLodLevel(Instance instance, float coverage) const noexcept;
+    // returns the primitives of the given lod group, or all of them when no groups are defined
+    utils::Slice<FRenderPrimitive> getLodPrimitives(Instance instance, uint8_t level) const noexcept;
     inline utils::Slice<MorphTargets> const& getMorphTargets(Instance instance, uint8_t level) const noexcept;
     inline utils::Slice<MorphTargets>& getMorphTargets(Instance instance, uint8_t level) noexcept;
 
@@ -241,7 +272,8 @@ private:
         VISIBILITY,             // user data
         PRIMITIVES,             // user data
         BONES,                  // filament data, UBO storing a pointer to the bones information
-        MORPH_TARGETS
+        MORPH_TARGETS,
+        LOD_GROUPS              // user data
     };
 
     using Base = utils::SingleInstanceComponentManager<
@@ -253,7 +285,8 @@ private:
             Visibility,                      // VISIBILITY
             utils::Slice<FRenderPrimitive>,  // PRIMITIVES
             Bones,                           // BONES
-            utils::Slice<MorphTargets>       // MORPH_TARGETS
+            utils::Slice<MorphTargets>,      // MORPH_TARGETS
+            LodGroups                        // LOD_GROUPS
     >;
 
     struct Sim : public Base {
@@ -277,6 +310,7 @@ private:
                 Field<PRIMITIVES>           primitives;
                 Field<BONES>                bones;
                 Field<MORPH_TARGETS>        morphTargets;
+                Field<LOD_GROUPS>           lodGroups;
             };
         };
 
@@ -291,19 +325,25 @@ private:
     Sim mManager;
     FEngine& mEngine;
     HwRenderPrimitiveFactory mHwRenderPrimitiveFactory;
+    uint32_t mVersion = 0;
 };
 
 FILAMENT_DOWNCAST(RenderableManager)
 
 void FRenderableManager::setAxisAlignedBoundingBox(Instance instance, const Box& aabb) noexcept {
     if (instance) {
+        mVersion++;
         mManager[instance].aabb = aabb;
     }
 }
 
+// All of these mutators bump mVersion because the state they touch is gathered by value
+// into the scene's renderable SoA: a stale version would let FScene::prepare() reuse
+// prepared data that no longer matches.
 void FRenderableManager::setLayerMask(Instance instance,
         uint8_t select, uint8_t values) noexcept {
     if (instance) {
+        mVersion++;
         uint8_t& layers = mManager[instance].layers;
         layers = (layers & ~select) | (values & select);
     }
@@ -311,12 +351,14 @@ void FRenderableManager::setLayerMask(Instance instance,
 
 void FRenderableManager::setLayerMask(Instance instance, uint8_t layerMask) noexcept {
     if (instance) {
+        mVersion++;
         mManager[instance].layers = layerMask;
     }
 }
 
 void FRenderableManager::setPriority(Instance instance, uint8_t priority) noexcept {
     if (instance) {
+        mVersion++;
         Visibility& visibility = mManager[instance].visibility;
         visibility.priority = std::min(priority, uint8_t(0x7));
     }
@@ -324,6 +366,7 @@ void FRenderableManager::setPriority(Instance instance, uint8_t priority) noexce
 
 void FRenderableManager::setChannel(Instance instance, uint8_t channel) noexcept {
     if (instance) {
+        mVersion++;
         Visibility& visibility = mManager[instance].visibility;
         visibility.channel = std::min(channel, uint8_t(0x3));
     }
@@ -331,6 +374,7 @@ void FRenderableManager::setChannel(Instance instance, uint8_t channel) noexcept
 
 void FRenderableManager::setCastShadows(Instance instance, bool enable) noexcept {
     if (instance) {
+        mVersion++;
         Visibility& visibility = mManager[instance].visibility;
         visibility.castShadows = enable;
     }
@@ -338,6 +382,7 @@ void FRenderableManager::setCastShadows(Instance instance, bool enable) noexcept
 
 void FRenderableManager::setReceiveShadows(Instance instance, bool enable) noexcept {
     if (instance) {
+        mVersion++;
         Visibility& visibility = mManager[instance].visibility;
         visibility.receiveShadows = enable;
     }
@@ -345,6 +390,7 @@ void FRenderableManager::setReceiveShadows(Instance instance, bool enable) noexc
 
 void FRenderableManager::setScreenSpaceContactShadows(Instance instance, bool enable) noexcept {
     if (instance) {
+        mVersion++;
         Visibility& visibility = mManager[instance].visibility;
         visibility.screenSpaceContactShadows = enable;
     }
@@ -352,6 +398,7 @@ void FRenderableManager::setScreenSpaceContactShadows(Instance instance, bool en
 
 void FRenderableManager::setCulling(Instance instance, bool enable) noexcept {
     if (instance) {
+        mVersion++;
         Visibility& visibility = mManager[instance].visibility;
         visibility.culling = enable;
     }
@@ -359,6 +406,7 @@ void FRenderableManager::setCulling(Instance instance, bool enable) noexcept {
 
 void FRenderableManager::setFogEnabled(Instance instance, bool enable) noexcept {
     if (instance) {
+        mVersion++;
         Visibility& visibility = mManager[instance].visibility;
         visibility.fog = enable;
     }
@@ -370,6 +418,7 @@ bool FRenderableManager::getFogEnabled(RenderableManager::Instance instance) con
 
 void FRenderableManager::setSkinning(Instance instance, bool enable) noexcept {
     if (instance) {
+        mVersion++;
         Visibility& visibility = mManager[instance].visibility;
         visibility.skinning = enable;
     }
@@ -377,6 +426,7 @@ void FRenderableManager::setSkinning(Instance instance, bool enable) noexcept {
 
 void FRenderableManager::setMorphing(Instance instance, bool enable) noexcept {
     if (instance) {
+        mVersion++;
         Visibility& visibility = mManager[instance].visibility;
         visibility.morphing = enable;
     }
@@ -389,6 +439,29 @@ void FRenderableManager::setPrimitives(Instance instance,
     }
 }
 
+void FRenderableManager::setLodGroups(Instance instance, LodGroups const& lodGroups) noexcept {
+    if (instance) {
+        mManager[instance].lodGroups = lodGroups;
+    }
+}
+
+uint8_t FRenderableManager::getLodGroupCount(Instance instance) const noexcept {
+    LodGroups const& lod = mManager[instance].lodGroups;
+    return lod.count;
+}
+
+uint8_t FRenderableManager::getLodLevel(Instance instance, float coverage) const noexcept {
+    LodGroups const& lod = mManager[instance].lodGroups;
+    // pick the most detailed group whose coverage threshold is met; the last group is the
+    // fallback when no threshold matches
+    int const last = int(lod.count) - 1;
+    int level = 0;
+    while (level < last && coverage < lod.groups[level].minCoverage) {
+        level++;
+    }
+    return uint8_t(std::max(level, 0));
+}
+
 FRenderableManager::Visibility
 FRenderableManager::getVisibility(Instance instance) const noexcept {
     return mManager[instance].visibility;
@@ -19,6 +19,8 @@
 #include <math/mat4.h>
 
 #include <utils/debug.h>
+#include <utils/FixedCapacityVector.h>
+#include <utils/JobSystem.h>
 #include <filament/TransformManager.h>
 
 
@@ -27,6 +29,10 @@ using namespace filament::math;
 
 namespace filament {
 
+// below this number of components the parallel world-transform recomputation isn't worth
+// the scheduling overhead
+constexpr size_t PARALLEL_TRANSFORM_THRESHOLD = 4096;
+
 FTransformManager::FTransformManager() noexcept = default;
 
 FTransformManager::~FTransformManager() noexcept = default;
@@ -147,6 +153,8 @@ void FTransformManager::destroy(Entity e) noexcept {
     Instance const i = manager.getInstance(e);
     validateNode(i);
     if (i) {
+        mVersion++;
+
         // 1) remove the entry from the linked lists
         removeNode(i);
 
@@ -191,9 +199,13 @@ void FTransformManager::setTransform(Instance ci, const mat4& model) noexcept {
 
 void FTransformManager::updateNodeTransform(Instance i) noexcept {
     if (UTILS_UNLIKELY(mLocalTransformTransactionOpen)) {
+        // world transforms don't change until the transaction is committed,
+        // computeAllWorldTransforms() bumps the version then
         return;
     }
 
+    mVersion++;
+
     validateNode(i);
     auto& manager = mManager;
     assert_invariant(i);
@@ -226,6 +238,7 @@ void FTransformManager::commitLocalTransformTransaction() noexcept {
 }
 
 void FTransformManager::computeAllWorldTransforms() noexcept {
+    mVersion++;
     auto& manager = mManager;
 
     // swapNode() below needs some temporary storage which we provide here
@@ -233,20 +246,66 @@ void FTransformManager::computeAllWorldTransforms() noexcept {
     auto& soa = manager.getSoA();
     soa.ensureCapacity(soa.size() + 1);
 
+    JobSystem* const js = mJobSystem;
+    if (UTILS_LIKELY(!js || manager.getComponentCount() < PARALLEL_TRANSFORM_THRESHOLD)) {
+        for (Instance i = manager.begin(), e = manager.end(); i != e; ++i) {
+            // Ensure that children are always sorted after their parent.
+            while (UTILS_UNLIKELY(Instance(manager[i].parent) > i)) {
+                swapNode(i, manager[i].parent);
+            }
+            Instance const parent = manager[i].parent;
+            assert_invariant(parent < i);
+
+            FTransformManager::computeWorldTransform(
+                    manager[i].world, manager[i].worldTranslationLo,
+                    manager[parent].world, manager[i].local,
+                    manager[parent].worldTranslationLo, manager[i].localTranslationLo,
+                    accurate);
+        }
+        return;
+    }
+
+    // Ensure that children are always sorted after their parent. This is almost always a
+    // no-op, the order is only disturbed by setParent().
     for (Instance i = manager.begin(), e = manager.end(); i != e; ++i) {
-        // Ensure that children are always sorted after their parent.
         while (UTILS_UNLIKELY(Instance(manager[i].parent) > i)) {
             swapNode(i, manager[i].parent);
         }
-        Instance const parent = manager[i].parent;
-        assert_invariant(parent < i);
+        assert_invariant(Instance(manager[i].parent) < i);
+    }
 
-        FTransformManager::computeWorldTransform(
-                manager[i].world, manager[i].worldTranslationLo,
-                manager[parent].world, manager[i].local,
-                manager[parent].worldTranslationLo, manager[i].localTranslationLo,
-                accurate);
+    // Collect the hierarchy roots. Each root owns a disjoint subtree, so subtrees can be
+    // processed concurrently in any order; within a subtree the depth-first traversal
+    // preserves the parent-before-child ordering of the serial path above.
+    auto roots = FixedCapacityVector<Instance>::with_capacity(manager.getComponentCount());
+    for (Instance i = manager.begin(), e = manager.end(); i != e; ++i) {
+        Instance const parent = manager[i].parent;
+        if (!parent) {
+            roots.push_back(i);
+        }
     }
+
+    auto work = [this, &manager, accurate](Instance const* r, size_t c) {
+        for (size_t j = 0; j < c; j++) {
+            Instance const i = r[j];
+            // roots have the dummy index 0 as parent, its world transform is identity
+            Instance const parent = manager[i].parent;
+            FTransformManager::computeWorldTransform(
+                    manager[i].world, manager[i].worldTranslationLo,
+                    manager[parent].world, manager[i].local,
+                    manager[parent].worldTranslationLo, manager[i].localTranslationLo,
+                    accurate);
+
+            Instance const child = manager[i].firstChild;
+            if (UTILS_UNLIKELY(child)) {
+                transformChildren(manager, child);
+            }
+        }
+    };
+
+    auto* job = jobs::parallel_for(*js, nullptr, roots.data(), uint32_t(roots.size()),
+            std::cref(work), jobs::CountSplitter<64>());
+    js->runAndWait(job);
 }
 
 // Inserts a parentless node in the hierarchy
@@ -28,6 +28,10 @@
 
 #include <math/mat4.h>
 
+namespace utils {
+class JobSystem;
+} // namespace utils
+
 namespace filament {
 
 class UTILS_PRIVATE FTransformManager : public TransformManager {
@@ -40,6 +44,9 @@ public:
     // free-up all resources
     void terminate() noexcept;
 
+    // when set, large world-transform recomputations are parallelized on the JobSystem
+    void setJobSystem(utils::JobSystem* js) noexcept { mJobSystem = js; }
+
 
     /*
     * Component Manager APIs
@@ -57,6 +64,10 @@ public:
         return mManager.getComponentCount();
     }
 
+    void reserve(size_t count) noexcept {
+        mManager.reserve(count);
+    }
+
     bool empty() const noexcept {
         return mManager.empty();
     }
@@ -105,6 +116,12 @@ public:
         return mManager.slice<WORLD>();
     }
 
+    // Incremented whenever any world transform may have changed; lets FView detect that
+    // nothing moved between two frames (see FView's culling cache).
+    uint32_t getVersion() const noexcept {
+        return mVersion;
+    }
+
     void setTransform(Instance ci, const math::mat4f& model) noexcept;
 
     void setTransform(Instance ci, const math::mat4& model) noexcept;
@@ -209,6 +226,8 @@ private:
     };
 
     Sim mManager;
+    utils::JobSystem* mJobSystem = nullptr;
+    uint32_t mVersion = 0;
     bool mLocalTransformTransactionOpen = false;
     bool mAccurateTranslations = false;
 };
@@ -20,6 +20,8 @@
 
 #include "FilamentAPI-impl.h"
 
+#include <utils/Panic.h>
+
 namespace filament {
 
 struct BufferObject::BuilderDetails {
@@ -67,4 +69,19 @@ void FBufferObject::setBuffer(FEngine& engine, BufferDescriptor&& buffer, uint32
     engine.getDriverApi().updateBufferObject(mHandle, std::move(buffer), byteOffset);
 }
 
+void FBufferObject::copyFrom(FEngine& engine, uint32_t dstOffset,
+        FBufferObject const* src, uint32_t srcOffset, uint32_t size) {
+    ASSERT_PRECONDITION(src, "source BufferObject is null");
+    ASSERT_PRECONDITION(srcOffset + size <= src->mByteCount,
+            "source range [%u, %u) is out of bounds (%u bytes)",
+            srcOffset, srcOffset + size, src->mByteCount);
+    ASSERT_PRECONDITION(dstOffset + size <= mByteCount,
+            "destination range [%u, %u) is out of bounds (%u bytes)",
+            dstOffset, dstOffset + size, mByteCount);
+    ASSERT_PRECONDITION(src != this || srcOffset + size <= dstOffset || dstOffset + size <= srcOffset,
+            "source and destination ranges overlap");
+    engine.getDriverApi().copyBufferObject(mHandle, dstOffset,
+            src->getHwHandle(), srcOffset, size);
+}
+
 } // namespace filament
@@ -45,6 +45,8 @@ public:
 private:
     friend class BufferObject;
     void setBuffer(FEngine& engine, BufferDescriptor&& buffer, uint32_t byteOffset = 0);
+    void copyFrom(FEngine& engine, uint32_t dstOffset,
+            FBufferObject const* src, uint32_t srcOffset, uint32_t size);
     backend::Handle<backend::HwBufferObject> mHandle;
     uint32_t mByteCount;
     BindingType mBindingType;
@@ -301,13 +301,19 @@ ColorGrading* ColorGrading::Builder::build(Engine& engine) {
     FColorGrading* colorGrading = downcast(engine).createColorGrading(*this);
 
     if (needToneMapper) {
-        delete mImpl->toneMapper;
+        // the LUT bake is asynchronous and may still reference the tone mapper, so
+        // ownership of the default one is transferred to the ColorGrading object
+        colorGrading->takeToneMapperOwnership(mImpl->toneMapper);
         mImpl->toneMapper = nullptr;
     }
 
     return colorGrading;
 }
 
+bool ColorGrading::isReady() const noexcept {
+    return downcast(this)->isReady();
+}
+
 #pragma clang diagnostic pop
 
 //------------------------------------------------------------------------------
@@ -636,21 +642,35 @@ struct Config {
     ColorTransform oetf;
 };
 
+// Heap-allocated state shared between the constructor and the asynchronous bake jobs.
+// It outlives the constructor and is freed by finishBake() once the bake completes and
+// the LUT data has been handed over to the driver.
+struct FColorGrading::BakeState {
+    Config config;
+    // This lock protects the data inside config, which is written to by the Filament thread,
+    // and read from multiple Job threads.
+    utils::SpinLock lock;
+    void* data = nullptr;                   // half4 LUT data, filled by the bake jobs
+    void* converted = nullptr;              // optional UINT_2_10_10_10_REV conversion
+    size_t elementCount = 0;
+    backend::PixelDataFormat format{};
+    backend::PixelDataType type{};
+};
+
 // Inside the FColorGrading constructor, TSAN sporadically detects a data race on the config struct;
 // the Filament thread writes and the Job thread reads. In practice there should be no data race, so
 // we force TSAN off to silence the warning.
 UTILS_NO_SANITIZE_THREAD
-FColorGrading::FColorGrading(FEngine& engine, const Builder& builder) {
+FColorGrading::FColorGrading(FEngine& engine, const Builder& builder)
+        : mEngine(engine) {
     SYSTRACE_CALL();
 
     DriverApi& driver = engine.getDriverApi();
 
-    Config c;
-    // This lock protects the data inside Config, which is written to by the Filament thread,
-    // and read from multiple Job threads.
-    utils::SpinLock configLock;
+    BakeState* const state = new BakeState;
     {
-        std::lock_guard<utils::SpinLock> lock(configLock);
+        std::lock_guard<utils::SpinLock> lock(state->lock);
+        Config& c = state->config;
         c.lutDimension          = builder->dimension;
         c.adaptationTransform   = adaptationTransform(builder->whiteBalance);
         c.colorGradingIn        = selectColorGradingTransformIn(builder->toneMapping);
@@ -659,11 +679,10 @@ FColorGrading::FColorGrading(FEngine& engine, const Builder& builder) {
         c.oetf                  = selectOETF(builder->outputColorSpace);
     }
 
-    mDimension = c.lutDimension;
+    mDimension = builder->dimension;
 
-    size_t lutElementCount = c.lutDimension * c.lutDimension * c.lutDimension;
-    size_t elementSize = sizeof(half4);
-    void* data = malloc(lutElementCount * elementSize);
+    size_t const lutElementCount = mDimension * mDimension * mDimension;
+    void* data = malloc(lutElementCount * sizeof(half4));
 
     auto [textureFormat, format, type] = selectLutTextureParams(builder->format);
     assert_invariant(FTexture::isTextureFormatSupported(engine, textureFormat));
@@ -675,20 +694,24 @@ FColorGrading::FColorGrading(FEngine& engine, const Builder& builder) {
         converted = malloc(lutElementCount * sizeof(uint32_t));
     }
 
-    //auto now = std::chrono::steady_clock::now();
+    state->data = data;
+    state->converted = converted;
+    state->elementCount = lutElementCount;
+    state->format = format;
+    state->type = type;
 
     // Multithreadedly generate the tone mapping 3D look-up table using 32 jobs
     // Slices are 8 KiB (128 cache lines) apart.
     // This takes about 3-6ms on Android in Release
     JobSystem& js = engine.getJobSystem();
     auto *slices = js.createJob();
-    for (size_t b = 0; b < c.lutDimension; b++) {
+    for (size_t b = 0; b < mDimension; b++) {
         auto *job = js.createJob(slices,
-                [data, converted, b, &c, &configLock, builder](JobSystem&, JobSystem::Job*) {
+                [data, converted, b, state, builder](JobSystem&, JobSystem::Job*) {
             Config config;
             {
-                std::lock_guard<utils::SpinLock> lock(configLock);
-                config = c;
+                std::lock_guard<utils::SpinLock> lock(state->lock);
+                config = state->config;
             }
             half4* UTILS_RESTRICT p = (half4*) data + b * config.lutDimension * config.lutDimension;
             for (size_t g = 0; g < config.lutDimension; g++) {
@@ -710,7 +733,7 @@ FColorGrading::FColorGrading(FEngine& engine, const Builder& builder) {
                     }
 
                     // Move to color grading color space
-                    v = c.colorGradingIn * v;
+                    v = config.colorGradingIn * v;
 
                     if (builder->hasAdjustments) {
                         // White balance
@@ -723,7 +746,7 @@ FColorGrading::FColorGrading(FEngine& engine, const Builder& builder) {
                         v = channelMixer(v, builder->outRed, builder->outGreen, builder->outBlue);
 
                         // Shadows/mid-tones/highlights
-                        v = tonalRanges(v, c.colorGradingLuminance,
+                        v = tonalRanges(v, config.colorGradingLuminance,
                                 builder->shadows, builder->midtones, builder->highlights,
                                 builder->tonalRanges);
 
@@ -740,10 +763,10 @@ FColorGrading::FColorGrading(FEngine& engine, const Builder& builder) {
                         v = LogC_to_linear(v);
 
                         // Vibrance in linear space
-                        v = vibrance(v, c.colorGradingLuminance, builder->vibrance);
+                        v = vibrance(v, config.colorGradingLuminance, builder->vibrance);
 
                         // Saturation in linear space
-                        v = saturation(v, c.colorGradingLuminance, builder->saturation);
+                        v = saturation(v, config.colorGradingLuminance, builder->saturation);
 
                         // Kill negative values before curves
                         v = max(v, 0.0f);
@@ -755,13 +778,14 @@ FColorGrading::FColorGrading(FEngine& engine, const Builder& builder) {
 
                     // Tone mapping
                     if (builder->luminanceScaling) {
-                        v = luminanceScaling(v, *builder->toneMapper, c.colorGradingLuminance);
+                        v = luminanceScaling(v, *builder->toneMapper,
+                                config.colorGradingLuminance);
                     } else {
                         v = (*builder->toneMapper)(v);
                     }
 
                     // Go back to display color space
-                    v = c.colorGradingOut * v;
+                    v = config.colorGradingOut * v;
 
                     // Apply gamut mapping
                     if (builder->gamutMapping) {
@@ -777,7 +801,7 @@ FColorGrading::FColorGrading(FEngine& engine, const Builder& builder) {
                     v = saturate(v);
 
                     // Apply OETF
-                    v = c.oetf(v);
+                    v = config.oetf(v);
 
                     *p++ = half4{v, 0.0f};
                 }
@@ -805,43 +829,71 @@ FColorGrading::FColorGrading(FEngine& engine, const Builder& builder) {
         js.run(job);
     }
 
-    // TODO: Should we do a runAndRetain() and defer the wait() + texture creation until
-    //       getHwHandle() is invoked?
-    js.runAndWait(slices);
-
-    //std::chrono::duration<float, std::milli> duration = std::chrono::steady_clock::now() - now;
-    //slog.d << "LUT generation time: " << duration.count() << " ms" << io::endl;
+    // The bake is asynchronous: we only wait for it when the LUT is first needed
+    // (see finishBake()), so that creating a ColorGrading object doesn't stall the
+    // Filament thread. The texture itself can be created right away.
+    mBakeJob = js.runAndRetain(slices);
+    mBakeState = state;
 
     mLutHandle = driver.createTexture(
             SamplerType::SAMPLER_3D,
             1,
             textureFormat,
             1,
-            c.lutDimension,
-            c.lutDimension,
-            c.lutDimension,
+            mDimension,
+            mDimension,
+            mDimension,
             TextureUsage::DEFAULT
     );
+}
 
-    if (converted) {
-        free(data);
-        data = converted;
+UTILS_NOINLINE
+void FColorGrading::finishBake() const noexcept {
+    assert_invariant(mBakeJob && mBakeState);
+
+    JobSystem& js = mEngine.getJobSystem();
+    js.waitAndRelease(mBakeJob);
+    mBakeJob = nullptr;
+
+    BakeState* const state = mBakeState;
+    mBakeState = nullptr;
+
+    // the default tone mapper, if any, is not needed anymore
+    delete mOwnedToneMapper;
+    mOwnedToneMapper = nullptr;
+
+    void* data = state->data;
+    size_t elementSize = sizeof(half4);
+    if (state->converted) {
+        free(state->data);
+        data = state->converted;
         elementSize = sizeof(uint32_t);
     }
 
+    DriverApi& driver = mEngine.getDriverApi();
     driver.update3DImage(mLutHandle, 0,
             0, 0, 0,
-            c.lutDimension, c.lutDimension, c.lutDimension,
+            mDimension, mDimension, mDimension,
             PixelBufferDescriptor{
-                    data, lutElementCount * elementSize,format, type,
+                    data, state->elementCount * elementSize, state->format, state->type,
                     [](void* buffer, size_t, void*) { free(buffer); }
             }
     );
+
+    delete state;
+}
+
+bool FColorGrading::isReady() const noexcept {
+    return !mBakeJob || mEngine.getJobSystem().hasJobCompleted(mBakeJob);
 }
 
 FColorGrading::~FColorGrading() noexcept = default;
 
 void FColorGrading::terminate(FEngine& engine) {
+    if (UTILS_UNLIKELY(mBakeJob)) {
+        // the LUT was never used, finish the bake to release the staging buffers
+        finishBake();
+    }
     DriverApi& driver = engine.getDriverApi();
     driver.destroyTexture(mLutHandle);
 }
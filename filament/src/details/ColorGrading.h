@@ -26,6 +26,9 @@
 
 #include <math/mathfwd.h>
 
+#include <utils/compiler.h>
+#include <utils/JobSystem.h>
+
 namespace filament {
 
 class FEngine;
@@ -41,13 +44,39 @@ public:
     // frees driver resources, object becomes invalid
     void terminate(FEngine& engine);
 
-    backend::TextureHandle getHwHandle() const noexcept { return mLutHandle; }
+    // Returns the LUT texture, first finishing a still-pending asynchronous bake
+    // (see the constructor).
+    backend::TextureHandle getHwHandle() const noexcept {
+        if (UTILS_UNLIKELY(mBakeJob)) {
+            finishBake();
+        }
+        return mLutHandle;
+    }
+
+    bool isReady() const noexcept;
 
     uint32_t getDimension() const noexcept { return mDimension; }
 
+    // takes ownership of the given tone mapper, which is deleted once the LUT bake
+    // completes (used by Builder::build() for the default tone mapper)
+    void takeToneMapperOwnership(ToneMapper const* toneMapper) noexcept {
+        mOwnedToneMapper = toneMapper;
+    }
+
 private:
+    struct BakeState;
+
+    // waits for the bake jobs and uploads the LUT data to the texture
+    void finishBake() const noexcept;
+
+    FEngine& mEngine;
     backend::TextureHandle mLutHandle;
     uint32_t mDimension;
+
+    // pending asynchronous bake, cleared by finishBake()
+    mutable utils::JobSystem::Job* mBakeJob = nullptr;
+    mutable BakeState* mBakeState = nullptr;
+    mutable ToneMapper const* mOwnedToneMapper = nullptr;
 };
 
 FILAMENT_DOWNCAST(ColorGrading)
@@ -22,6 +22,10 @@
 #include <math/vec3.h>
 #include <math/vec4.h>
 
+#include <mutex>
+
+#include <string.h>
+
 #ifndef NDEBUG
 #   define DEBUG_PROPERTIES_WRITABLE true
 #else
@@ -38,32 +42,33 @@ FDebugRegistry::FDebugRegistry() noexcept = default;
 auto FDebugRegistry::getPropertyInfo(const char* name) noexcept -> PropertyInfo {
     std::string_view const key{ name };
     auto& propertyMap = mPropertyMap;
-    if (propertyMap.find(key) == propertyMap.end()) {
-        return { nullptr, {} };
+    auto const& it = propertyMap.find(key);
+    if (it == propertyMap.end()) {
+        return { nullptr, BOOL, {} };
     }
-    return propertyMap[key];
+    return it->second;
 }
 
 UTILS_NOINLINE
 void* FDebugRegistry::getPropertyAddress(const char* name) {
     auto info = getPropertyInfo(name);
-    ASSERT_PRECONDITION_NON_FATAL(!info.second,
+    ASSERT_PRECONDITION_NON_FATAL(!info.fn,
             "don't use DebugRegistry::getPropertyAddress() when a callback is set. "
             "Use setProperty() instead.");
-    return info.first;
+    return info.ptr;
 }
 
 UTILS_NOINLINE
 void const* FDebugRegistry::getPropertyAddress(const char* name) const noexcept {
     auto info = const_cast<FDebugRegistry*>(this)->getPropertyInfo(name);
-    return info.first;
+    return info.ptr;
 }
 
-void FDebugRegistry::registerProperty(std::string_view name, void* p, Type,
+void FDebugRegistry::registerProperty(std::string_view name, void* p, Type type,
         std::function<void()> fn) noexcept {
     auto& propertyMap = mPropertyMap;
     if (propertyMap.find(name) == propertyMap.end()) {
-        propertyMap[name] = { p, std::move(fn) };
+        propertyMap[name] = { p, type, std::move(fn) };
     }
 }
 
@@ -75,12 +80,12 @@ template<typename T>
 bool FDebugRegistry::setProperty(const char* name, T v) noexcept {
     if constexpr (DEBUG_PROPERTIES_WRITABLE) {
         auto info = getPropertyInfo(name);
-        T* const addr = static_cast<T*>(info.first);
+        T* const addr = static_cast<T*>(info.ptr);
         if (addr) {
             auto old = *addr;
             *addr = v;
-            if (info.second && old != v) {
-                info.second();
+            if (info.fn && old != v) {
+                info.fn();
             }
             return true;
         }
@@ -112,6 +117,58 @@ template bool FDebugRegistry::getProperty<float2>(const char* name, float2* v) c
 template bool FDebugRegistry::getProperty<float3>(const char* name, float3* v) const noexcept;
 template bool FDebugRegistry::getProperty<float4>(const char* name, float4* v) const noexcept;
 
+static size_t propertySize(DebugRegistry::Type type) noexcept {
+    switch (type) {
+        case DebugRegistry::BOOL:   return sizeof(bool);
+        case DebugRegistry::INT:    return sizeof(int);
+        case DebugRegistry::FLOAT:  return sizeof(float);
+        case DebugRegistry::FLOAT2: return sizeof(float2);
+        case DebugRegistry::FLOAT3: return sizeof(float3);
+        case DebugRegistry::FLOAT4: return sizeof(float4);
+    }
+    return 0;
+}
+
+template<typename T> struct PropertyTypeOf;
+template<> struct PropertyTypeOf<bool>   { static constexpr auto value = DebugRegistry::BOOL; };
+template<> struct PropertyTypeOf<int>    { static constexpr auto value = DebugRegistry::INT; };
+template<> struct PropertyTypeOf<float>  { static constexpr auto value = DebugRegistry::FLOAT; };
+template<> struct PropertyTypeOf<float2> { static constexpr auto value = DebugRegistry::FLOAT2; };
+template<> struct PropertyTypeOf<float3> { static constexpr auto value = DebugRegistry::FLOAT3; };
+template<> struct PropertyTypeOf<float4> { static constexpr auto value = DebugRegistry::FLOAT4; };
+
+void FDebugRegistry::captureFrameSnapshot() noexcept {
+    if (UTILS_LIKELY(!mSnapshotEnabled.load(std::memory_order_relaxed))) {
+        return;
+    }
+    std::lock_guard const lock(mSnapshotLock);
+    for (auto const& [name, info] : mPropertyMap) {
+        PropertyValue& value = mSnapshot[name];
+        value.type = info.type;
+        memcpy(value.data, info.ptr, propertySize(info.type));
+    }
+}
+
+template<typename T>
+bool FDebugRegistry::getPropertySnapshot(const char* name, T* p) const noexcept {
+    // the first query enables per-frame captures, so the first frame may not return a value
+    mSnapshotEnabled.store(true, std::memory_order_relaxed);
+    std::lock_guard const lock(mSnapshotLock);
+    auto const& it = mSnapshot.find(std::string_view{ name });
+    if (it == mSnapshot.end() || it->second.type != PropertyTypeOf<T>::value) {
+        return false;
+    }
+    memcpy(p, it->second.data, sizeof(T));
+    return true;
+}
+
+template bool FDebugRegistry::getPropertySnapshot<bool>(const char* name, bool* v) const noexcept;
+template bool FDebugRegistry::getPropertySnapshot<int>(const char* name, int* v) const noexcept;
+template bool FDebugRegistry::getPropertySnapshot<float>(const char* name, float* v) const noexcept;
+template bool FDebugRegistry::getPropertySnapshot<float2>(const char* name, float2* v) const noexcept;
+template bool FDebugRegistry::getPropertySnapshot<float3>(const char* name, float3* v) const noexcept;
+template bool FDebugRegistry::getPropertySnapshot<float4>(const char* name, float4* v) const noexcept;
+
 void FDebugRegistry::registerDataSource(std::string_view name,
         void const* data, size_t count) noexcept {
     auto& dataSourceMap = mDataSourceMap;
@@ -22,7 +22,11 @@
 #include <filament/DebugRegistry.h>
 
 #include <utils/compiler.h>
+#include <utils/Mutex.h>
 
+#include <math/vec4.h>
+
+#include <atomic>
 #include <functional>
 #include <string_view>
 #include <unordered_map>
@@ -93,14 +97,29 @@ public:
 
     void registerDataSource(std::string_view name, void const* data, size_t count) noexcept;
 
+    // Captures the value of every registered property, so that snapshot readers observe a set
+    // of values that is coherent with a frame. Called once per frame by FRenderer::beginFrame();
+    // a no-op until the first snapshot query, so applications that don't use snapshots don't
+    // pay for them.
+    void captureFrameSnapshot() noexcept;
+
 #if !defined(_MSC_VER)
 private:
 #endif
     template<typename T> bool getProperty(const char* name, T* p) const noexcept;
     template<typename T> bool setProperty(const char* name, T v) noexcept;
+    template<typename T> bool getPropertySnapshot(const char* name, T* p) const noexcept;
 
 private:
-    using PropertyInfo = std::pair<void*, std::function<void()>>;
+    struct PropertyInfo {
+        void* ptr;
+        Type type;
+        std::function<void()> fn;
+    };
+    struct PropertyValue {
+        Type type;
+        char data[sizeof(math::float4)];
+    };
     friend class DebugRegistry;
     void registerProperty(std::string_view name, void* p, Type type, std::function<void()> fn = {}) noexcept;
     bool hasProperty(const char* name) const noexcept;
@@ -110,6 +129,9 @@ private:
     DataSource getDataSource(const char* name) const noexcept;
     std::unordered_map<std::string_view, PropertyInfo> mPropertyMap;
     std::unordered_map<std::string_view, DataSource> mDataSourceMap;
+    mutable utils::Mutex mSnapshotLock;
+    std::unordered_map<std::string_view, PropertyValue> mSnapshot; // guarded by mSnapshotLock
+    mutable std::atomic_bool mSnapshotEnabled{ false };
 };
 
 FILAMENT_DOWNCAST(DebugRegistry)
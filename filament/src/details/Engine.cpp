@@ -38,6 +38,7 @@
 
 #include <filament/MaterialEnums.h>
 
+#include <private/backend/DiskBlobCache.h>
 #include <private/backend/PlatformFactory.h>
 
 #include <backend/DriverEnums.h>
@@ -82,8 +83,9 @@ Engine* FEngine::create(Engine::Builder const& builder) {
     // (this cannot be done safely in the ctor)
 
     // Normally we launch a thread and create the context and Driver from there (see FEngine::loop).
-    // In the single-threaded case, we do so in the here and now.
-    if (!UTILS_HAS_THREADING) {
+    // Without a driver thread -- on single-threaded platforms, or when the dedicated thread was
+    // disabled in the Config -- we do so in the here and now.
+    if (!instance->mUseDriverThread) {
         Platform* platform = builder->mPlatform;
         void* const sharedContext = builder->mSharedContext;
 
@@ -98,7 +100,10 @@ Engine* FEngine::create(Engine::Builder const& builder) {
             return nullptr;
         }
         DriverConfig const driverConfig{
-            .handleArenaSize = instance->getRequestedDriverHandleArenaSize() };
+            .handleArenaSize = instance->getRequestedDriverHandleArenaSize(),
+            .gpuPreferenceIndex = instance->getConfig().gpuPreferenceIndex,
+            .gpuPreferenceDeviceName =
+                    utils::CString{ instance->getConfig().gpuPreferenceDeviceName } };
         instance->mDriver = platform->createDriver(sharedContext, driverConfig);
 
     } else {
@@ -119,7 +124,7 @@ Engine* FEngine::create(Engine::Builder const& builder) {
     // now we can initialize the largest part of the engine
     instance->init();
 
-    if (!UTILS_HAS_THREADING) {
+    if (!instance->mUseDriverThread) {
         instance->execute();
     }
 
@@ -134,6 +139,10 @@ void FEngine::create(Engine::Builder const& builder, Invocable<void(void*)>&& ca
 
     FEngine* instance = new FEngine(builder);
 
+    // this entry point can't operate without the driver thread
+    ASSERT_PRECONDITION(instance->mUseDriverThread,
+            "Engine::Builder::build(callback) requires Config::useDedicatedDriverThread.");
+
     // start the driver thread
     instance->mDriverThread = std::thread(&FEngine::loop, instance);
 
@@ -195,9 +204,11 @@ FEngine::FEngine(Engine::Builder const& builder) :
         mTransformManager(),
         mLightManager(*this),
         mCameraManager(*this),
+        mUseDriverThread(UTILS_HAS_THREADING && builder->mConfig.useDedicatedDriverThread),
         mCommandBufferQueue(
                 builder->mConfig.minCommandBufferSizeMB * MiB,
-                builder->mConfig.commandBufferSizeMB * MiB),
+                builder->mConfig.commandBufferSizeMB * MiB,
+                mUseDriverThread),
         mPerRenderPassAllocator(
                 "FEngine::mPerRenderPassAllocator",
                 builder->mConfig.perRenderPassArenaSizeMB * MiB),
@@ -212,6 +223,8 @@ FEngine::FEngine(Engine::Builder const& builder) :
     // (it may not be the case)
     mJobSystem.adopt();
 
+    mTransformManager.setJobSystem(&mJobSystem);
+
     slog.i << "FEngine (" << sizeof(void*) * 8 << " bits) created at " << this << " "
            << "(threading is " << (UTILS_HAS_THREADING ? "enabled)" : "disabled)") << io::endl;
 }
@@ -252,7 +265,7 @@ void FEngine::init() {
     slog.i << "FEngine feature level: " << int(mActiveFeatureLevel) << io::endl;
 
 
-    mResourceAllocator = new ResourceAllocator(driverApi);
+    mResourceAllocator = new ResourceAllocator(mConfig, driverApi);
 
     mFullScreenTriangleVb = downcast(VertexBuffer::Builder()
             .vertexCount(3)
@@ -333,21 +346,9 @@ void FEngine::init() {
             { zeroes, 4, Texture::Format::RGBA, Texture::Type::UBYTE });
 
 #ifdef FILAMENT_ENABLE_FEATURE_LEVEL_0
-    if (UTILS_UNLIKELY(mActiveFeatureLevel == FeatureLevel::FEATURE_LEVEL_0)) {
-        FMaterial::DefaultMaterialBuilder defaultMaterialBuilder;
-        defaultMaterialBuilder.package(
-                MATERIALS_DEFAULTMATERIAL0_DATA, MATERIALS_DEFAULTMATERIAL0_SIZE);
-        mDefaultMaterial = downcast(defaultMaterialBuilder.build(*const_cast<FEngine*>(this)));
-    } else
+    if (UTILS_LIKELY(mActiveFeatureLevel >= FeatureLevel::FEATURE_LEVEL_1))
 #endif
     {
-        mDefaultColorGrading = downcast(ColorGrading::Builder().build(*this));
-
-        FMaterial::DefaultMaterialBuilder defaultMaterialBuilder;
-        defaultMaterialBuilder.package(
-                MATERIALS_DEFAULTMATERIAL_DATA, MATERIALS_DEFAULTMATERIAL_SIZE);
-        mDefaultMaterial = downcast(defaultMaterialBuilder.build(*const_cast<FEngine*>(this)));
-
         float3 dummyPositions[1] = {};
         short4 dummyTangents[1] = {};
         mDummyMorphTargetBuffer->setPositionsAt(*this, 0, dummyPositions, 1, 0);
@@ -366,9 +367,11 @@ void FEngine::init() {
                 { zeroes, 4, Texture::Format::RGBA, Texture::Type::UBYTE });
 
         mLightManager.init(*this);
-        mDFG.init(*this);
     }
 
+    // the default material, the default color grading and the DFG LUT are created lazily,
+    // when first needed, so that Engine::create() isn't gated on them
+
     mPostProcessManager.init();
 
     mDebugRegistry.registerProperty("d.shadowmap.debug_directional_shadowmap",
@@ -402,6 +405,11 @@ void FEngine::init() {
                     }
                 });
             });
+
+#ifndef NDEBUG
+    mDebugRegistry.registerDataSource("d.backend.state_cache",
+            &debug.backend.stateCache, 1);
+#endif
 }
 
 FEngine::~FEngine() noexcept {
@@ -503,7 +511,7 @@ void FEngine::shutdown() {
 
     // now wait for all pending commands to be executed and the thread to exit
     mCommandBufferQueue.requestExit();
-    if (!UTILS_HAS_THREADING) {
+    if (!mUseDriverThread) {
         execute();
         getDriverApi().terminate();
     } else {
@@ -526,8 +534,74 @@ void FEngine::shutdown() {
     mJobSystem.emancipate();
 }
 
+bool FEngine::dumpTrace(const char* path) noexcept {
+    // make sure no commands are in flight while the trace buffers are read
+    flushAndWait();
+    return SYSTRACE_DUMP(path);
+}
+
+Engine::MemoryInfo FEngine::getMemoryInfo() const noexcept {
+    MemoryInfo info{};
+
+    mTextures.forEach([&info](FTexture const* t) {
+        info.textureBytes += t->getEstimatedSizeInBytes();
+        info.textureCount++;
+    });
+    mBufferObjects.forEach([&info](FBufferObject const* bo) {
+        info.bufferObjectBytes += bo->getByteCount();
+        info.bufferCount++;
+    });
+    mVertexBuffers.forEach([&info](FVertexBuffer const* vb) {
+        info.vertexBufferBytes += vb->getEstimatedSizeInBytes();
+        info.bufferCount++;
+    });
+    mIndexBuffers.forEach([&info](FIndexBuffer const* ib) {
+        info.indexBufferBytes += ib->getEstimatedSizeInBytes();
+        info.bufferCount++;
+    });
+    mSkinningBuffers.forEach([&info](FSkinningBuffer const* sb) {
+        info.skinningBufferBytes += sb->getEstimatedSizeInBytes();
+        info.bufferCount++;
+    });
+    mMorphTargetBuffers.forEach([&info](FMorphTargetBuffer const* mtb) {
+        info.morphTargetBufferBytes += mtb->getEstimatedSizeInBytes();
+        info.bufferCount++;
+    });
+
+    if (mResourceAllocator) {
+        auto const report = mResourceAllocator->getMemoryReport();
+        info.transientBytes = report.inUseColorSize + report.inUseDepthSize
+                + report.cachedColorSize + report.cachedDepthSize;
+    }
+
+    info.totalBytes = info.textureBytes + info.vertexBufferBytes + info.indexBufferBytes
+            + info.bufferObjectBytes + info.skinningBufferBytes + info.morphTargetBufferBytes
+            + info.transientBytes;
+
+    return info;
+}
+
+void FEngine::checkMemoryBudget() noexcept {
+    if (UTILS_LIKELY(!mMemoryBudgetCallback || !mMemoryBudget)) {
+        return;
+    }
+    MemoryInfo const info = getMemoryInfo();
+    if (info.totalBytes > mMemoryBudget) {
+        // fire once when the budget is crossed, re-arm once we're back under it
+        if (!mMemoryOverBudget) {
+            mMemoryOverBudget = true;
+            mMemoryBudgetCallback(mMemoryBudgetUser, info);
+        }
+    } else {
+        mMemoryOverBudget = false;
+    }
+}
+
 void FEngine::prepare() {
     SYSTRACE_CALL();
+
+    mFrameEpoch++;
+
     // prepare() is called once per Renderer frame. Ideally we would upload the content of
     // UBOs that are visible only. It's not such a big issue because the actual upload() is
     // skipped if the UBO hasn't changed. Still we could have a lot of these.
@@ -551,6 +625,9 @@ void FEngine::prepare() {
 void FEngine::gc() {
     // Note: this runs in a Job
     auto& em = mEntityManager;
+    // reclaim the indices of entities queued with destroyDeferred(); their components
+    // are then compacted incrementally by the managers' gc below
+    em.flushDeferredDestroys();
     mRenderableManager.gc(em);
     mLightManager.gc(em);
     mTransformManager.gc(em);
@@ -562,8 +639,74 @@ void FEngine::flush() {
     flushCommandBuffer(mCommandBufferQueue);
 }
 
+void FEngine::prewarmPipelines(Material* const* materials, size_t count) noexcept {
+    for (size_t i = 0; i < count; i++) {
+        if (materials[i]) {
+            // prewarming is a background task, it shouldn't delay compilations needed
+            // for the current frame
+            downcast(materials[i])->compile(backend::CompilerPriorityQueue::LOW,
+                    UserVariantFilterMask(UserVariantFilterBit::ALL), nullptr, {});
+        }
+    }
+    // get the compile commands to the backend now, without waiting for the next frame
+    flush();
+}
+
+void FEngine::scheduleMipmapGeneration(Handle<HwTexture> handle,
+        utils::Invocable<void()>&& callback) noexcept {
+    mPendingMipmapGenerations.emplace_back(handle, std::move(callback));
+}
+
+void FEngine::cancelMipmapGeneration(Handle<HwTexture> handle) noexcept {
+    // the texture is going away, drop its requests without invoking the callbacks
+    auto& pending = mPendingMipmapGenerations;
+    pending.erase(std::remove_if(pending.begin(), pending.end(),
+            [handle](auto const& item) { return item.first == handle; }), pending.end());
+}
+
+void FEngine::flushPendingMipmapGenerations() noexcept {
+    // how many deferred generateMipmaps commands we issue per frame; this bounds the
+    // per-frame GPU cost when a streamer queues many textures in a short time
+    constexpr size_t GENERATIONS_PER_FRAME = 8;
+
+    auto& pending = mPendingMipmapGenerations;
+    if (UTILS_LIKELY(pending.empty())) {
+        return;
+    }
+
+    DriverApi& driver = getDriverApi();
+    size_t const n = std::min(pending.size(), GENERATIONS_PER_FRAME);
+    for (size_t i = 0; i < n; i++) {
+        driver.generateMipmaps(pending[i].first);
+        if (pending[i].second) {
+            // the callback fires once the backend has executed the command above
+            auto callback = std::make_shared<utils::Invocable<void()>>(
+                    std::move(pending[i].second));
+            driver.queueCommand([callback = std::move(callback)] { (*callback)(); });
+        }
+    }
+    pending.erase(pending.begin(), pending.begin() + ptrdiff_t(n));
+}
+
 void FEngine::flushAndWait() {
 
+    // issue any remaining deferred mipmap generations, so that flushAndWait()
+    // really waits on everything that was requested
+    while (UTILS_UNLIKELY(!mPendingMipmapGenerations.empty())) {
+        flushPendingMipmapGenerations();
+    }
+
+    if (UTILS_UNLIKELY(!mUseDriverThread)) {
+        // Without a driver thread there is nothing to wait on: run the command stream --
+        // including the finish() below, which waits until the GPU has completed all work --
+        // right here.
+        getDriverApi().finish();
+        flushCommandBuffer(mCommandBufferQueue);
+        execute();
+        getDriver().purge();
+        return;
+    }
+
 #if defined(__ANDROID__)
 
     // first make sure we've not terminated filament
@@ -647,11 +790,43 @@ int FEngine::loop() {
 #endif
 
     JobSystem::setThreadName("FEngine::loop");
-    JobSystem::setThreadPriority(JobSystem::Priority::DISPLAY);
+    JobSystem::Priority priority;
+    switch (mConfig.driverThreadPriority) {
+        case Config::ThreadPriority::BACKGROUND:
+            priority = JobSystem::Priority::BACKGROUND;
+            break;
+        case Config::ThreadPriority::NORMAL:
+            priority = JobSystem::Priority::NORMAL;
+            break;
+        default:
+        case Config::ThreadPriority::DISPLAY:
+            priority = JobSystem::Priority::DISPLAY;
+            break;
+        case Config::ThreadPriority::URGENT_DISPLAY:
+            priority = JobSystem::Priority::URGENT_DISPLAY;
+            break;
+    }
+    JobSystem::setThreadPriority(priority);
+
+    // give the backend an on-disk blob cache, unless the platform already provides one
+    if (UTILS_UNLIKELY(mConfig.pipelineCacheDirectory && !mPlatform->hasBlobFunc())) {
+        mBlobCache = std::make_unique<DiskBlobCache>(mConfig.pipelineCacheDirectory, mBackend);
+        DiskBlobCache const* const cache = mBlobCache.get();
+        mPlatform->setBlobFunc(
+                [cache](const void* key, size_t keySize, const void* value, size_t valueSize) {
+                    cache->insert(key, keySize, value, valueSize);
+                },
+                [cache](const void* key, size_t keySize, void* value, size_t valueSize) {
+                    return cache->retrieve(key, keySize, value, valueSize);
+                });
+    }
 
     DriverConfig const driverConfig {
             .handleArenaSize = getRequestedDriverHandleArenaSize(),
-            .textureUseAfterFreePoolSize = mConfig.textureUseAfterFreePoolSize
+            .textureUseAfterFreePoolSize = mConfig.textureUseAfterFreePoolSize,
+            .residentProgramLimit = mConfig.residentShaderProgramLimit,
+            .gpuPreferenceIndex = mConfig.gpuPreferenceIndex,
+            .gpuPreferenceDeviceName = utils::CString{ mConfig.gpuPreferenceDeviceName }
     };
     mDriver = mPlatform->createDriver(mSharedGLContext, driverConfig);
 
@@ -665,8 +840,8 @@ int FEngine::loop() {
     // Set thread affinity for the backend thread.
     //  see https://developer.android.com/agi/sys-trace/threads-scheduling#cpu_core_affinity
     // Certain backends already have some threads pinned, and we can't easily know on which core.
-    const bool disableThreadAffinity
-            = mDriver->isWorkaroundNeeded(Workaround::DISABLE_THREAD_AFFINITY);
+    const bool disableThreadAffinity = !mConfig.driverThreadAffinity
+            || mDriver->isWorkaroundNeeded(Workaround::DISABLE_THREAD_AFFINITY);
 
     uint32_t const id = std::thread::hardware_concurrency() - 1;
     while (true) {
@@ -689,6 +864,35 @@ void FEngine::flushCommandBuffer(CommandBufferQueue& commandQueue) {
     commandQueue.flush();
 }
 
+const FMaterial* FEngine::getDefaultMaterial() const noexcept {
+    FMaterial const* material = mDefaultMaterial;
+    if (UTILS_UNLIKELY(material == nullptr)) {
+        FMaterial::DefaultMaterialBuilder defaultMaterialBuilder;
+#ifdef FILAMENT_ENABLE_FEATURE_LEVEL_0
+        if (UTILS_UNLIKELY(mActiveFeatureLevel == FeatureLevel::FEATURE_LEVEL_0)) {
+            defaultMaterialBuilder.trustedPackage(
+                    MATERIALS_DEFAULTMATERIAL0_DATA, MATERIALS_DEFAULTMATERIAL0_SIZE);
+        } else
+#endif
+        {
+            defaultMaterialBuilder.trustedPackage(
+                    MATERIALS_DEFAULTMATERIAL_DATA, MATERIALS_DEFAULTMATERIAL_SIZE);
+        }
+        material = downcast(defaultMaterialBuilder.build(*const_cast<FEngine*>(this)));
+        mDefaultMaterial = material;
+    }
+    return material;
+}
+
+const FColorGrading* FEngine::getDefaultColorGrading() const noexcept {
+    FColorGrading* colorGrading = mDefaultColorGrading;
+    if (UTILS_UNLIKELY(colorGrading == nullptr)) {
+        colorGrading = downcast(ColorGrading::Builder().build(*const_cast<FEngine*>(this)));
+        mDefaultColorGrading = colorGrading;
+    }
+    return colorGrading;
+}
+
 const FMaterial* FEngine::getSkyboxMaterial() const noexcept {
     FMaterial const* material = mSkyboxMaterial;
     if (UTILS_UNLIKELY(material == nullptr)) {
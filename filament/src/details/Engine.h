@@ -71,6 +71,7 @@ using MaterialKey = uint32_t;
 
 #include <utils/compiler.h>
 #include <utils/Allocator.h>
+#include <utils/Invocable.h>
 #include <utils/JobSystem.h>
 #include <utils/CountDownLatch.h>
 
@@ -79,6 +80,8 @@ using MaterialKey = uint32_t;
 #include <new>
 #include <random>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace filament {
 
@@ -86,6 +89,7 @@ class Renderer;
 class MaterialParser;
 
 namespace backend {
+class DiskBlobCache;
 class Driver;
 class Program;
 } // namespace driver
@@ -138,6 +142,7 @@ public:
     }
 
     DFG const& getDFG() const noexcept { return mDFG; }
+    DFG& getDFG() noexcept { return mDFG; }
 
     // the per-frame Area is used by all Renderer, so they must run in sequence and
     // have freed all allocated memory when done. If this needs to change in the future,
@@ -147,11 +152,11 @@ public:
     // Material IDs...
     uint32_t getMaterialId() const noexcept { return mMaterialId++; }
 
-    const FMaterial* getDefaultMaterial() const noexcept { return mDefaultMaterial; }
+    const FMaterial* getDefaultMaterial() const noexcept;
     const FMaterial* getSkyboxMaterial() const noexcept;
     const FIndirectLight* getDefaultIndirectLight() const noexcept { return mDefaultIbl; }
     const FTexture* getDummyCubemap() const noexcept { return mDefaultIblTexture; }
-    const FColorGrading* getDefaultColorGrading() const noexcept { return mDefaultColorGrading; }
+    const FColorGrading* getDefaultColorGrading() const noexcept;
     FMorphTargetBuffer* getDummyMorphTargetBuffer() const { return mDummyMorphTargetBuffer; }
 
     backend::Handle<backend::HwRenderPrimitive> getFullScreenRenderPrimitive() const noexcept {
@@ -342,6 +347,17 @@ public:
     // flush the current buffer
     void flush();
 
+    // kick asynchronous compilation of all variants of the given materials
+    void prewarmPipelines(Material* const* materials, size_t count) noexcept;
+
+    // Deferred mipmap generation (see Texture::generateMipmapsAsync): requests are queued
+    // here and a bounded number of them is issued per frame from Renderer::beginFrame(),
+    // so that a texture streamer doesn't cause bursty GPU frames.
+    void scheduleMipmapGeneration(backend::Handle<backend::HwTexture> handle,
+            utils::Invocable<void()>&& callback) noexcept;
+    void cancelMipmapGeneration(backend::Handle<backend::HwTexture> handle) noexcept;
+    void flushPendingMipmapGenerations() noexcept;
+
     // flush the current buffer based on some heuristics
     void flushIfNeeded() {
         auto counter = mFlushCounter + 1;
@@ -364,6 +380,10 @@ public:
     void prepare();
     void gc();
 
+    // prepare() increments this once per Renderer frame; used to tell whether data cached
+    // during a frame (e.g. FScene::prepare()'s output, shared across views) is still current
+    uint32_t getFrameEpoch() const noexcept { return mFrameEpoch; }
+
     using ShaderContent = utils::FixedCapacityVector<uint8_t>;
 
     ShaderContent& getVertexShaderContent() const noexcept {
@@ -380,6 +400,13 @@ public:
 
     bool execute();
 
+    // false when backend commands run inline on the thread calling Engine::execute(), either
+    // because the platform has no threading support or because the dedicated driver thread
+    // was disabled with Config::useDedicatedDriverThread
+    bool hasDedicatedDriverThread() const noexcept {
+        return mUseDriverThread;
+    }
+
     utils::JobSystem& getJobSystem() noexcept {
         return mJobSystem;
     }
@@ -392,6 +419,21 @@ public:
         getDriver().purge();
     }
 
+    bool dumpTrace(const char* path) noexcept;
+
+    MemoryInfo getMemoryInfo() const noexcept;
+
+    void setMemoryBudget(uint64_t budgetBytes,
+            MemoryBudgetCallback callback, void* user) noexcept {
+        mMemoryBudget = budgetBytes;
+        mMemoryBudgetCallback = callback;
+        mMemoryBudgetUser = user;
+        mMemoryOverBudget = false;
+    }
+
+    // called once per frame from FRenderer::endFrame()
+    void checkMemoryBudget() noexcept;
+
     void setAutomaticInstancingEnabled(bool enable) noexcept {
         // instancing is not allowed at feature level 0
         if (hasFeatureLevel(FeatureLevel::FEATURE_LEVEL_1)) {
@@ -456,7 +498,13 @@ private:
     FeatureLevel mActiveFeatureLevel = FeatureLevel::FEATURE_LEVEL_1;
     Platform* mPlatform = nullptr;
     bool mOwnPlatform = false;
+    std::unique_ptr<backend::DiskBlobCache> mBlobCache;
     bool mAutomaticInstancingEnabled = false;
+    uint64_t mMemoryBudget = 0;
+    MemoryBudgetCallback mMemoryBudgetCallback = nullptr;
+    void* mMemoryBudgetUser = nullptr;
+    bool mMemoryOverBudget = false;
+    uint32_t mFrameEpoch = 0;
     void* mSharedGLContext = nullptr;
     backend::Handle<backend::HwRenderPrimitive> mFullScreenTriangleRph;
     FVertexBuffer* mFullScreenTriangleVb = nullptr;
@@ -502,6 +550,7 @@ private:
     DFG mDFG;
 
     std::thread mDriverThread;
+    bool mUseDriverThread = false;
     backend::CommandBufferQueue mCommandBufferQueue;
     std::aligned_storage<sizeof(DriverApi), alignof(DriverApi)>::type mDriverApiStorage;
     static_assert( sizeof(mDriverApiStorage) >= sizeof(DriverApi) );
@@ -533,6 +582,9 @@ private:
     mutable ShaderContent mFragmentShaderContent;
     FDebugRegistry mDebugRegistry;
 
+    std::vector<std::pair<backend::Handle<backend::HwTexture>,
+            utils::Invocable<void()>>> mPendingMipmapGenerations;
+
     backend::Handle<backend::HwTexture> mDummyOneTexture;
     backend::Handle<backend::HwTexture> mDummyOneTextureArray;
     backend::Handle<backend::HwTexture> mDummyZeroTextureArray;
@@ -552,6 +604,8 @@ public:
             bool focus_shadowcasters = true;
             bool visualize_cascades = false;
             bool tightly_bound_scene = true;
+            // cache static shadow maps in a persistent atlas and skip re-rendering them
+            bool caching = false;
             float dzn = -1.0f;
             float dzf =  1.0f;
         } shadowmap;
@@ -568,10 +622,22 @@ public:
             // capture to file. At the moment, only supported by the Metal backend.
             bool doFrameCapture = false;
             bool disable_buffer_padding = false;
+            struct {
+                // schedule presents on a vsync boundary; requires the application to pass
+                // real vsync timestamps to Renderer::beginFrame()
+                bool enabled = false;
+                // pace for one frame of latency instead of two
+                bool low_latency = false;
+            } pacing;
         } renderer;
         struct {
             bool debug_froxel_visualization = false;
         } lighting;
+        struct {
+            // snapshot of the backend's redundant-bind elimination counters for the last
+            // completed frame, updated by FRenderer::endFrame()
+            backend::StateCacheStatistics stateCache = {};
+        } backend;
         matdbg::DebugServer* server = nullptr;
     } debug;
 };
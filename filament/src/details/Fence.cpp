@@ -61,9 +61,9 @@ FenceStatus FFence::waitAndDestroy(FFence* fence, Mode mode) noexcept {
 
 UTILS_NOINLINE
 FenceStatus FFence::wait(Mode mode, uint64_t timeout) noexcept {
-    ASSERT_PRECONDITION(UTILS_HAS_THREADING || timeout == 0, "Non-zero timeout requires threads.");
-
     FEngine& engine = mEngine;
+    ASSERT_PRECONDITION(engine.hasDedicatedDriverThread() || timeout == 0,
+            "Non-zero timeout requires a driver thread.");
 
     if (mode == Mode::FLUSH) {
         engine.flush();
@@ -100,11 +100,126 @@ FenceStatus FFence::wait(Mode mode, uint64_t timeout) noexcept {
     return status;
 }
 
+UTILS_NOINLINE
+FenceStatus FFence::waitAny(Fence* const* fences, size_t count, size_t* signaledIndex,
+        Mode mode, uint64_t timeout) noexcept {
+    ASSERT_PRECONDITION(count > 0, "waitAny() requires at least one fence.");
+
+    FEngine& engine = downcast(fences[0])->mEngine;
+    ASSERT_PRECONDITION(engine.hasDedicatedDriverThread() || timeout == 0,
+            "Non-zero timeout requires a driver thread.");
+
+    if (mode == Mode::FLUSH) {
+        engine.flush();
+    }
+
+    // all FenceSignals share sLock/sCondition, so we can wait on all of them at once
+    auto const poll = [fences, count, signaledIndex]() -> FenceStatus {
+        for (size_t i = 0; i < count; i++) {
+            FenceSignal const* const fs = downcast(fences[i])->mFenceSignal.get();
+            if (fs->mState == FenceSignal::DESTROYED) {
+                return FenceStatus::ERROR;
+            }
+            if (fs->mState == FenceSignal::SIGNALED) {
+                if (signaledIndex) {
+                    *signaledIndex = i;
+                }
+                return FenceStatus::CONDITION_SATISFIED;
+            }
+        }
+        return FenceStatus::TIMEOUT_EXPIRED;
+    };
+
+    auto const waitLocked = [&poll](uint64_t waitTimeout) -> FenceStatus {
+        std::unique_lock<utils::Mutex> lock(FFence::sLock);
+        FenceStatus status;
+        while ((status = poll()) == FenceStatus::TIMEOUT_EXPIRED) {
+            if (waitTimeout == FENCE_WAIT_FOR_EVER) {
+                sCondition.wait(lock);
+            } else if (waitTimeout == 0 ||
+                    sCondition.wait_for(lock, ns(waitTimeout)) == std::cv_status::timeout) {
+                return FenceStatus::TIMEOUT_EXPIRED;
+            }
+        }
+        return status;
+    };
+
+    if (UTILS_LIKELY(!engine.pumpPlatformEvents())) {
+        return waitLocked(timeout);
+    }
+
+    // see wait() above for why we chop up the waiting time on these platforms
+    const auto startTime = std::chrono::system_clock::now();
+    while (true) {
+        FenceStatus const status = waitLocked(ns(ms(PUMP_INTERVAL_MILLISECONDS)).count());
+        if (status != FenceStatus::TIMEOUT_EXPIRED) {
+            return status;
+        }
+        engine.pumpPlatformEvents();
+        const auto elapsed = std::chrono::system_clock::now() - startTime;
+        if (timeout != FENCE_WAIT_FOR_EVER && elapsed >= ns(timeout)) {
+            return FenceStatus::TIMEOUT_EXPIRED;
+        }
+    }
+}
+
+void FFence::onSignal(backend::CallbackHandler* handler,
+        utils::Invocable<void(FenceStatus)>&& callback) noexcept {
+    mFenceSignal->setCallback(handler, std::move(callback));
+}
+
 UTILS_NOINLINE
 void FFence::FenceSignal::signal(State s) noexcept {
-    std::lock_guard<utils::Mutex> const lock(FFence::sLock);
-    mState = s;
-    FFence::sCondition.notify_all();
+    backend::CallbackHandler* handler = nullptr;
+    utils::Invocable<void(FenceStatus)> callback;
+    {
+        std::lock_guard<utils::Mutex> const lock(FFence::sLock);
+        mState = s;
+        handler = mHandler;
+        callback = std::move(mCallback);
+        mHandler = nullptr;
+        mCallback = {};
+        FFence::sCondition.notify_all();
+    }
+    if (callback) {
+        deliver(handler, std::move(callback),
+                s == SIGNALED ? FenceStatus::CONDITION_SATISFIED : FenceStatus::ERROR);
+    }
+}
+
+void FFence::FenceSignal::setCallback(backend::CallbackHandler* handler,
+        utils::Invocable<void(FenceStatus)>&& callback) noexcept {
+    std::unique_lock<utils::Mutex> lock(FFence::sLock);
+    State const state = mState;
+    if (state == UNSIGNALED) {
+        // replaces the previous callback, if any, which is then never invoked
+        mHandler = handler;
+        mCallback = std::move(callback);
+        return;
+    }
+    // already signaled, deliver immediately from this thread
+    lock.unlock();
+    deliver(handler, std::move(callback),
+            state == SIGNALED ? FenceStatus::CONDITION_SATISFIED : FenceStatus::ERROR);
+}
+
+void FFence::FenceSignal::deliver(backend::CallbackHandler* handler,
+        utils::Invocable<void(FenceStatus)>&& callback, FenceStatus status) noexcept {
+    if (handler) {
+        struct Callback {
+            utils::Invocable<void(FenceStatus)> f;
+            FenceStatus s;
+            static void func(void* user) {
+                auto* const c = reinterpret_cast<Callback*>(user);
+                c->f(c->s);
+                delete c;
+            }
+        };
+        auto* const user = new(std::nothrow) Callback{ std::move(callback), status };
+        handler->post(static_cast<void*>(user), &Callback::func);
+    } else {
+        callback(status);
+    }
 }
 
 UTILS_NOINLINE
@@ -21,10 +21,12 @@
 
 #include <filament/Fence.h>
 
+#include <backend/CallbackHandler.h>
 #include <backend/Handle.h>
 
 #include <utils/compiler.h>
 #include <utils/Condition.h>
+#include <utils/Invocable.h>
 #include <utils/Mutex.h>
 
 namespace filament {
@@ -41,6 +43,12 @@ public:
 
     static FenceStatus waitAndDestroy(FFence* fence, Mode mode) noexcept;
 
+    static FenceStatus waitAny(Fence* const* fences, size_t count, size_t* signaledIndex,
+            Mode mode, uint64_t timeout) noexcept;
+
+    void onSignal(backend::CallbackHandler* handler,
+            utils::Invocable<void(FenceStatus)>&& callback) noexcept;
+
 private:
     // We assume we don't have a lot of contention of fence and have all of them
     // share a single lock/condition
@@ -51,8 +59,15 @@ private:
         explicit FenceSignal() noexcept = default;
         enum State : uint8_t { UNSIGNALED, SIGNALED, DESTROYED };
         State mState = UNSIGNALED;
+        // at most one pending callback, delivered when signal() is called
+        backend::CallbackHandler* mHandler = nullptr;
+        utils::Invocable<void(FenceStatus)> mCallback;
         void signal(State s = SIGNALED) noexcept;
         FenceStatus wait(uint64_t timeout) noexcept;
+        void setCallback(backend::CallbackHandler* handler,
+                utils::Invocable<void(FenceStatus)>&& callback) noexcept;
+        static void deliver(backend::CallbackHandler* handler,
+                utils::Invocable<void(FenceStatus)>&& callback, FenceStatus status) noexcept;
     };
 
     FEngine& mEngine;
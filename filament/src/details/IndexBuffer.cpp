@@ -52,7 +52,8 @@ IndexBuffer* IndexBuffer::Builder::build(Engine& engine) {
 // ------------------------------------------------------------------------------------------------
 
 FIndexBuffer::FIndexBuffer(FEngine& engine, const IndexBuffer::Builder& builder)
-        : mIndexCount(builder->mIndexCount) {
+        : mIndexCount(builder->mIndexCount),
+          mElementSize(builder->mIndexType == IndexType::UINT ? 4 : 2) {
     FEngine::DriverApi& driver = engine.getDriverApi();
     mHandle = driver.createIndexBuffer(
             (backend::ElementType)builder->mIndexType,
@@ -40,12 +40,16 @@ public:
 
     size_t getIndexCount() const noexcept { return mIndexCount; }
 
+    // estimated video memory used by this index buffer, in bytes
+    size_t getEstimatedSizeInBytes() const noexcept { return mIndexCount * mElementSize; }
+
     void setBuffer(FEngine& engine, BufferDescriptor&& buffer, uint32_t byteOffset = 0);
 
 private:
     friend class IndexBuffer;
     backend::Handle<backend::HwIndexBuffer> mHandle;
     uint32_t mIndexCount;
+    uint8_t mElementSize;
 };
 
 FILAMENT_DOWNCAST(IndexBuffer)
@@ -207,6 +207,17 @@ backend::Handle<backend::HwTexture> FIndirectLight::getIrradianceHwHandle() cons
     return mIrradianceTexture ? mIrradianceTexture->getHwHandle() : backend::Handle<backend::HwTexture> {};
 }
 
+math::mat3 FIndirectLight::getWorldRotation() const noexcept {
+    if (UTILS_UNLIKELY(mWorldRotationDirty)) {
+        // the IBL transformation must be a rigid transform; it is important to
+        // orthogonalize the matrix when converting it to doubles, because as float, it
+        // only has about a 1e-8 precision on the size of the basis vectors
+        mWorldRotation = orthogonalize(mat3{ transpose(mRotation) });
+        mWorldRotationDirty = false;
+    }
+    return mWorldRotation;
+}
+
 math::float3 FIndirectLight::getDirectionEstimate(math::float3 const* f) noexcept {
     // The linear direction is found as normalize(-sh[3], -sh[1], sh[2]), but the coefficients
     // we store are already pre-normalized, so the negative sign disappears.
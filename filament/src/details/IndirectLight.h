@@ -47,8 +47,17 @@ public:
     math::float3 const* getSH() const noexcept{ return mIrradianceCoefs.data(); }
     float getIntensity() const noexcept { return mIntensity; }
     void setIntensity(float intensity) noexcept { mIntensity = intensity; }
-    void setRotation(math::mat3f const& rotation) noexcept { mRotation = rotation; }
+    void setRotation(math::mat3f const& rotation) noexcept {
+        mRotation = rotation;
+        mWorldRotationDirty = true;
+    }
     const math::mat3f& getRotation() const noexcept { return mRotation; }
+
+    // inverse of the rotation above, orthogonalized in double precision; this is the
+    // rigid transform the views apply to the world to implement the IBL rotation. The
+    // result is cached so that continuously rendered views only pay for it when the
+    // rotation actually changes (e.g. an animated time-of-day sky).
+    math::mat3 getWorldRotation() const noexcept;
     FTexture const* getReflectionsTexture() const noexcept { return mReflectionsTexture; }
     FTexture const* getIrradianceTexture() const noexcept { return mIrradianceTexture; }
     size_t getLevelCount() const noexcept { return mLevelCount; }
@@ -63,6 +72,9 @@ private:
     std::array<math::float3, 9> mIrradianceCoefs;
     float mIntensity = DEFAULT_INTENSITY;
     math::mat3f mRotation;
+    // cached world transform of mRotation, only accessed from the main thread
+    mutable math::mat3 mWorldRotation;
+    mutable bool mWorldRotationDirty = true;
     uint8_t mLevelCount = 0;
 };
 
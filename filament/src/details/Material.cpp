@@ -46,9 +46,11 @@ using namespace filaflat;
 using namespace utils;
 
 static MaterialParser* createParser(Backend backend, ShaderLanguage language,
-                                    const void* data, size_t size) {
+                                    const void* data, size_t size, bool trusted) {
     // unique_ptr so we don't leak MaterialParser on failures below
-    auto materialParser = std::make_unique<MaterialParser>(language, data, size);
+    // trusted packages are compiled into the executable, so they are referenced in place
+    // instead of being copied
+    auto materialParser = std::make_unique<MaterialParser>(language, data, size, !trusted);
 
     MaterialParser::ParseResult const materialResult = materialParser->parse();
 
@@ -64,10 +66,14 @@ static MaterialParser* createParser(Backend backend, ShaderLanguage language,
     ASSERT_PRECONDITION(materialResult == MaterialParser::ParseResult::SUCCESS,
                 "could not parse the material package");
 
-    uint32_t version = 0;
-    materialParser->getMaterialVersion(&version);
-    ASSERT_PRECONDITION(version == MATERIAL_VERSION,
-            "Material version mismatch. Expected %d but received %d.", MATERIAL_VERSION, version);
+    // trusted packages were produced by this very build, so their version necessarily matches
+    if (!trusted) {
+        uint32_t version = 0;
+        materialParser->getMaterialVersion(&version);
+        ASSERT_PRECONDITION(version == MATERIAL_VERSION,
+                "Material version mismatch. Expected %d but received %d.",
+                MATERIAL_VERSION, version);
+    }
 
     assert_invariant(backend != Backend::DEFAULT && "Default backend has not been resolved.");
 
@@ -79,6 +85,7 @@ struct Material::BuilderDetails {
     size_t mSize = 0;
     MaterialParser* mMaterialParser = nullptr;
     bool mDefaultMaterial = false;
+    bool mTrustedPayload = false;
     std::unordered_map<
         utils::CString,
         std::variant<int32_t, float, bool>,
@@ -100,6 +107,14 @@ BuilderType::Builder& BuilderType::Builder::operator=(BuilderType::Builder&& rhs
 Material::Builder& Material::Builder::package(const void* payload, size_t size) {
     mImpl->mPayload = payload;
     mImpl->mSize = size;
+    mImpl->mTrustedPayload = false;
+    return *this;
+}
+
+Material::Builder& Material::Builder::trustedPackage(const void* payload, size_t size) {
+    mImpl->mPayload = payload;
+    mImpl->mSize = size;
+    mImpl->mTrustedPayload = true;
     return *this;
 }
 
@@ -117,7 +132,7 @@ template Material::Builder& Material::Builder::constant<bool>(const char*, size_
 Material* Material::Builder::build(Engine& engine) {
     std::unique_ptr<MaterialParser> materialParser{ createParser(
         downcast(engine).getBackend(), downcast(engine).getShaderLanguage(),
-        mImpl->mPayload, mImpl->mSize) };
+        mImpl->mPayload, mImpl->mSize, mImpl->mTrustedPayload) };
 
     if (materialParser == nullptr) {
         return nullptr;
@@ -524,6 +539,55 @@ void FMaterial::terminate(FEngine& engine) {
 
     destroyPrograms(engine);
     mDefaultInstance.terminate(engine);
+
+    // the engine guarantees that all instances are destroyed before the material, so the
+    // shared uniform block cache must be empty at this point
+    assert_invariant(mSharedUniformBlocks.empty());
+}
+
+backend::BufferObjectHandle FMaterial::acquireSharedUniformBlock(DriverApi& driver,
+        UniformBuffer const& uniforms) const noexcept {
+    size_t const size = uniforms.getSize();
+    assert_invariant(size > 0 && size % 4 == 0); // std140 blocks are multiple of 4 bytes
+    uint32_t const hash = utils::hash::murmur3(
+            static_cast<uint32_t const*>(uniforms.getBuffer()), size / 4, 0);
+
+    auto& cache = mSharedUniformBlocks;
+    auto pos = std::find_if(cache.begin(), cache.end(), [&](SharedUniformBlock const& block) {
+        // the hash alone is not enough, we must handle collisions
+        return block.hash == hash && !memcmp(block.content.get(), uniforms.getBuffer(), size);
+    });
+
+    if (UTILS_UNLIKELY(pos == cache.end())) {
+        // this content is not in the cache, create a new shared block and upload it
+        auto content = std::make_unique<char[]>(size);
+        memcpy(content.get(), uniforms.getBuffer(), size);
+        auto const handle = driver.createBufferObject(size,
+                BufferObjectBinding::UNIFORM, BufferUsage::STATIC);
+        BufferDescriptor p;
+        p.size = size;
+        p.buffer = driver.allocate(p.size);
+        memcpy(p.buffer, content.get(), size);
+        driver.updateBufferObject(handle, std::move(p), 0);
+        cache.push_back({ hash, 1u, handle, std::move(content) });
+        return handle;
+    }
+
+    pos->refCount++;
+    return pos->handle;
+}
+
+void FMaterial::releaseSharedUniformBlock(DriverApi& driver,
+        backend::BufferObjectHandle handle) const noexcept {
+    auto& cache = mSharedUniformBlocks;
+    auto pos = std::find_if(cache.begin(), cache.end(), [&](SharedUniformBlock const& block) {
+        return block.handle == handle;
+    });
+    assert_invariant(pos != cache.end());
+    if (--pos->refCount == 0) {
+        driver.destroyBufferObject(pos->handle);
+        cache.erase(pos);
+    }
 }
 
 void FMaterial::compile(CompilerPriorityQueue priority,
@@ -804,14 +868,16 @@ void FMaterial::onEditCallback(void* userdata, const utils::CString&, const void
     // This is called on a web server thread, so we defer clearing the program cache
     // and swapping out the MaterialParser until the next getProgram call.
     material->mPendingEdits = createParser(engine.getBackend(), engine.getShaderLanguage(),
-            packageData, packageSize);
+            packageData, packageSize, false);
 }
 
 void FMaterial::onQueryCallback(void* userdata, VariantList* pVariants) {
     FMaterial* material = downcast((Material*) userdata);
-    std::lock_guard<utils::Mutex> const lock(material->mActiveProgramsLock);
-    *pVariants = material->mActivePrograms;
-    material->mActivePrograms.reset();
+    // snapshot-and-clear each word; the render thread keeps setting bits wait-free meanwhile
+    auto& activePrograms = material->mActivePrograms;
+    for (size_t i = 0; i < activePrograms.size(); i++) {
+        pVariants->getBitsAt(i) = activePrograms[i].exchange(0, std::memory_order_relaxed);
+    }
 }
 
 #endif
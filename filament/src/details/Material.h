@@ -32,7 +32,10 @@
 #include <utils/compiler.h>
 #include <utils/Mutex.h>
 
+#include <array>
 #include <atomic>
+#include <memory>
+#include <vector>
 
 namespace filament {
 
@@ -104,9 +107,8 @@ public:
     [[nodiscard]] backend::Handle<backend::HwProgram> getProgram(Variant variant) const noexcept {
 #if FILAMENT_ENABLE_MATDBG
         assert_invariant((size_t)variant.key < VARIANT_COUNT);
-        std::unique_lock<utils::Mutex> lock(mActiveProgramsLock);
-        mActivePrograms.set(variant.key);
-        lock.unlock();
+        mActivePrograms[variant.key / 64].fetch_or(
+                uint64_t(1) << (variant.key % 64), std::memory_order_relaxed);
 #endif
         assert_invariant(mCachedPrograms[variant.key]);
         return mCachedPrograms[variant.key];
@@ -126,6 +128,7 @@ public:
     Shading getShading() const noexcept { return mShading; }
     Interpolation getInterpolation() const noexcept { return mInterpolation; }
     BlendingMode getBlendingMode() const noexcept { return mBlendingMode; }
+    bool hasCustomDepthShader() const noexcept { return mHasCustomDepthShader; }
     BlendingMode getRenderBlendingMode() const noexcept { return mRenderBlendingMode; }
     VertexDomain getVertexDomain() const noexcept { return mVertexDomain; }
     MaterialDomain getMaterialDomain() const noexcept { return mMaterialDomain; }
@@ -163,6 +166,16 @@ public:
 
     uint32_t generateMaterialInstanceId() const noexcept { return mMaterialInstanceId++; }
 
+    // Shared uniform block cache, used by instances with uniform deduplication enabled.
+    // Instances with identical uniform contents share a single immutable GPU buffer.
+    // Returns the shared buffer for `uniforms` content, creating and uploading it if needed.
+    backend::BufferObjectHandle acquireSharedUniformBlock(backend::DriverApi& driver,
+            UniformBuffer const& uniforms) const noexcept;
+
+    // releases a buffer returned by acquireSharedUniformBlock(), destroying it if unreferenced
+    void releaseSharedUniformBlock(backend::DriverApi& driver,
+            backend::BufferObjectHandle handle) const noexcept;
+
     void destroyPrograms(FEngine& engine);
 
     // return the id of a specialization constant specified by name for this material
@@ -221,6 +234,16 @@ private:
     // try to order by frequency of use
     mutable std::array<backend::Handle<backend::HwProgram>, VARIANT_COUNT> mCachedPrograms;
 
+    // shared uniform blocks of instances with uniform deduplication enabled. We don't expect
+    // many unique blocks per material, so a vector is good enough.
+    struct SharedUniformBlock {
+        uint32_t hash;
+        uint32_t refCount;
+        backend::BufferObjectHandle handle;
+        std::unique_ptr<char[]> content;    // CPU copy, to resolve hash collisions
+    };
+    mutable std::vector<SharedUniformBlock> mSharedUniformBlocks;
+
     backend::RasterState mRasterState;
     BlendingMode mRenderBlendingMode = BlendingMode::OPAQUE;
     TransparencyMode mTransparencyMode = TransparencyMode::DEFAULT;
@@ -278,8 +301,10 @@ private:
 
 #if FILAMENT_ENABLE_MATDBG
     matdbg::MaterialKey mDebuggerId;
-    mutable utils::Mutex mActiveProgramsLock;
-    mutable VariantList mActivePrograms;
+    // bits of the variants used since the last debugger query, recorded on the hot path
+    // (getProgram()); atomic words rather than a mutex-protected bitset, so that recording
+    // a draw is wait-free and cheap enough to leave the debugger enabled in production
+    mutable std::array<std::atomic<uint64_t>, VARIANT_COUNT / 64> mActivePrograms = {};
     std::atomic<MaterialParser*> mPendingEdits = {};
 #endif
 
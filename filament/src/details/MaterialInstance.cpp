@@ -48,6 +48,7 @@ FMaterialInstance::FMaterialInstance() noexcept
 FMaterialInstance::FMaterialInstance(FEngine& engine,
         FMaterialInstance const* other, const char* name)
         : mMaterial(other->mMaterial),
+          mUniformDeduplication(other->mUniformDeduplication),
           mPolygonOffset(other->mPolygonOffset),
           mStencilState(other->mStencilState),
           mMaskThreshold(other->mMaskThreshold),
@@ -157,17 +158,48 @@ FMaterialInstance::~FMaterialInstance() noexcept = default;
 
 void FMaterialInstance::terminate(FEngine& engine) {
     FEngine::DriverApi& driver = engine.getDriverApi();
-    driver.destroyBufferObject(mUbHandle);
+    if (mUbShared) {
+        mMaterial->releaseSharedUniformBlock(driver, mUbHandle);
+    } else {
+        driver.destroyBufferObject(mUbHandle);
+    }
     driver.destroySamplerGroup(mSbHandle);
 }
 
 void FMaterialInstance::commitSlow(DriverApi& driver) const {
     // update uniforms if needed
     if (mUniforms.isDirty()) {
-        driver.updateBufferObject(mUbHandle, mUniforms.toBufferDescriptor(driver), 0);
+        if (UTILS_UNLIKELY(mUniformDeduplication)) {
+            // acquire a shared block matching our content (before releasing the current one,
+            // so an unchanged block is found in the cache and simply re-referenced)
+            auto handle = mMaterial->acquireSharedUniformBlock(driver, mUniforms);
+            if (mUbShared) {
+                mMaterial->releaseSharedUniformBlock(driver, mUbHandle);
+            } else {
+                driver.destroyBufferObject(mUbHandle);
+            }
+            mUbHandle = handle;
+            mUbShared = true;
+            mUniforms.clean();
+        } else if (UTILS_UNLIKELY(mUbShared)) {
+            // deduplication was just disabled, detach to a private buffer
+            mMaterial->releaseSharedUniformBlock(driver, mUbHandle);
+            mUbHandle = driver.createBufferObject(mUniforms.getSize(),
+                    BufferObjectBinding::UNIFORM, backend::BufferUsage::DYNAMIC);
+            mUbShared = false;
+            driver.updateBufferObject(mUbHandle, mUniforms.toBufferDescriptor(driver), 0);
+        } else {
+            // only upload the bytes that actually changed
+            size_t const offset = mUniforms.getDirtyOffset();
+            size_t const size = mUniforms.getDirtySize();
+            driver.updateBufferObject(mUbHandle,
+                    mUniforms.toBufferDescriptor(driver, offset, size), offset);
+        }
     }
     if (mSamplers.isDirty()) {
-        driver.updateSamplerGroup(mSbHandle, mSamplers.toBufferDescriptor(driver));
+        // only update the samplers that actually changed (typically one among many)
+        uint64_t const dirtyMask = mSamplers.getDirtyMask();
+        driver.updateSamplerGroup(mSbHandle, mSamplers.toBufferDescriptor(driver), dirtyMask);
     }
 }
 
@@ -105,6 +105,16 @@ public:
         mDepthFunc = depthFunc;
     }
 
+    void setUniformDeduplicationEnabled(bool enabled) noexcept {
+        if (enabled != mUniformDeduplication) {
+            mUniformDeduplication = enabled;
+            // force a full re-commit so we switch between the shared and private buffer
+            mUniforms.invalidate();
+        }
+    }
+
+    bool isUniformDeduplicationEnabled() const noexcept { return mUniformDeduplication; }
+
     void setPolygonOffset(float scale, float constant) noexcept {
         // handle reversed Z
         mPolygonOffset = { -scale, -constant };
@@ -239,11 +249,16 @@ private:
     // keep these grouped, they're accessed together in the render-loop
     FMaterial const* mMaterial = nullptr;
 
-    backend::Handle<backend::HwBufferObject> mUbHandle;
+    mutable backend::Handle<backend::HwBufferObject> mUbHandle;
     backend::Handle<backend::HwSamplerGroup> mSbHandle;
     UniformBuffer mUniforms;
     backend::SamplerGroup mSamplers;
 
+    // whether identical uniform blocks may be shared with other instances of the same material
+    bool mUniformDeduplication = false;
+    // whether mUbHandle currently refers to a shared block owned by the material
+    mutable bool mUbShared = false;
+
     backend::PolygonOffset mPolygonOffset{};
     backend::StencilState mStencilState{};
 
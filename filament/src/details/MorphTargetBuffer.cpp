@@ -25,6 +25,8 @@
 #include <math/mat4.h>
 #include <math/norm.h>
 
+#include <algorithm>
+
 namespace filament {
 
 using namespace backend;
@@ -71,29 +73,6 @@ static inline size_t getHeight(size_t vertexCount) noexcept {
     return (vertexCount + MAX_MORPH_TARGET_BUFFER_WIDTH) / MAX_MORPH_TARGET_BUFFER_WIDTH;
 }
 
-template<VertexAttribute A>
-inline size_t getSize(size_t vertexCount) noexcept;
-
-template<>
-inline size_t getSize<VertexAttribute::POSITION>(size_t vertexCount) noexcept {
-    const size_t stride = getWidth(vertexCount);
-    const size_t height = getHeight(vertexCount);
-    return Texture::PixelBufferDescriptor::computeDataSize(
-            Texture::PixelBufferDescriptor::PixelDataFormat::RGBA,
-            Texture::PixelBufferDescriptor::PixelDataType::FLOAT,
-            stride, height, 1);
-}
-
-template<>
-inline size_t getSize<VertexAttribute::TANGENTS>(size_t vertexCount) noexcept {
-    const size_t stride = getWidth(vertexCount);
-    const size_t height = getHeight(vertexCount);
-    return Texture::PixelBufferDescriptor::computeDataSize(
-            Texture::PixelBufferDescriptor::PixelDataFormat::RGBA_INTEGER,
-            Texture::PixelBufferDescriptor::PixelDataType::SHORT,
-            stride, height, 1);
-}
-
 FMorphTargetBuffer::EmptyMorphTargetBuilder::EmptyMorphTargetBuilder() {
     mImpl->mVertexCount = 1;
     mImpl->mCount = 1;
@@ -130,7 +109,36 @@ FMorphTargetBuffer::FMorphTargetBuffer(FEngine& engine, const Builder& builder)
     SamplerGroup samplerGroup(PerRenderPrimitiveMorphingSib::SAMPLER_COUNT);
     samplerGroup.setSampler(PerRenderPrimitiveMorphingSib::POSITIONS, { mPbHandle, {}});
     samplerGroup.setSampler(PerRenderPrimitiveMorphingSib::TANGENTS, { mTbHandle, {}});
-    driver.updateSamplerGroup(mSbHandle, samplerGroup.toBufferDescriptor(driver));
+    uint64_t const dirtyMask = samplerGroup.getDirtyMask();
+    driver.updateSamplerGroup(mSbHandle, samplerGroup.toBufferDescriptor(driver), dirtyMask);
+
+    // Initialize the position texture with the "zero delta" value, so that setPositionsAt()
+    // only needs to upload the range of each target that actually contains non-zero deltas
+    // (morph targets, facial rigs in particular, typically displace a small region of the mesh).
+    size_t const width = getWidth(mVertexCount);
+    size_t const height = getHeight(mVertexCount);
+    auto* zeroes = (float4*) malloc(width * height * sizeof(float4));
+    std::fill_n(zeroes, width * height, float4{ 0.0f, 0.0f, 0.0f, 1.0f });
+    // the same allocation backs the update of every layer, the shared_ptr keeps it alive until
+    // the driver has consumed the last one
+    std::shared_ptr<void> const allocation(zeroes, ::free);
+    for (size_t targetIndex = 0; targetIndex < mCount; targetIndex++) {
+        driver.update3DImage(mPbHandle, 0, 0, 0, targetIndex, width, height, 1,
+                PixelBufferDescriptor::make(
+                        zeroes, width * height * sizeof(float4),
+                        Texture::Format::RGBA, Texture::Type::FLOAT,
+                        [allocation](void const*, size_t) {}
+                ));
+    }
+}
+
+size_t FMorphTargetBuffer::getEstimatedSizeInBytes() const noexcept {
+    if (UTILS_UNLIKELY(!mPbHandle)) {
+        return 0;
+    }
+    // one RGBA32F position texture and one RGBA16I tangent texture, one layer per target
+    size_t const pixels = getWidth(mVertexCount) * getHeight(mVertexCount) * mCount;
+    return pixels * (sizeof(math::float4) + sizeof(math::short4));
 }
 
 void FMorphTargetBuffer::terminate(FEngine& engine) {
@@ -153,13 +161,24 @@ void FMorphTargetBuffer::setPositionsAt(FEngine& engine, size_t targetIndex,
             "MorphTargetBuffer (size=%lu) overflow (count=%u, offset=%u)",
             (unsigned)mVertexCount, (unsigned)count, (unsigned)offset);
 
-    auto size = getSize<VertexAttribute::POSITION>(mVertexCount);
-
     ASSERT_PRECONDITION(targetIndex < mCount,
             "%d target index must be < %d", targetIndex, mCount);
 
+    // Morph targets are usually sparse -- most of their deltas are zero, facial rigs in
+    // particular only displace a small region of the mesh. The texture is initialized with
+    // zero deltas, so we only upload the live range of this target.
+    while (count && positions[0] == float3{ 0.0f }) {
+        positions++, offset++, count--;
+    }
+    while (count && positions[count - 1] == float3{ 0.0f }) {
+        count--;
+    }
+    if (UTILS_UNLIKELY(count == 0)) {
+        return; // all deltas are zero, there is nothing to upload
+    }
+
     // We could use a pool instead of malloc() directly.
-    auto* out = (float4*) malloc(size);
+    auto* out = (float4*) malloc(count * sizeof(float4));
     std::transform(positions, positions + count, out,
             [](const float3& p) { return float4(p, 1.0f); });
 
@@ -177,13 +196,23 @@ void FMorphTargetBuffer::setPositionsAt(FEngine& engine, size_t targetIndex,
             "MorphTargetBuffer (size=%lu) overflow (count=%u, offset=%u)",
             (unsigned)mVertexCount, (unsigned)count, (unsigned)offset);
 
-    auto size = getSize<VertexAttribute::POSITION>(mVertexCount);
-
     ASSERT_PRECONDITION(targetIndex < mCount,
             "%d target index must be < %d", targetIndex, mCount);
 
+    // Same sparse handling as the float3 variant; the texture's background value is the
+    // zero delta (0, 0, 0, 1).
+    while (count && positions[0] == float4{ 0.0f, 0.0f, 0.0f, 1.0f }) {
+        positions++, offset++, count--;
+    }
+    while (count && positions[count - 1] == float4{ 0.0f, 0.0f, 0.0f, 1.0f }) {
+        count--;
+    }
+    if (UTILS_UNLIKELY(count == 0)) {
+        return; // all deltas are zero, there is nothing to upload
+    }
+
     // We could use a pool instead of malloc() directly.
-    auto* out = (float4*) malloc(size);
+    auto* out = (float4*) malloc(count * sizeof(float4));
     memcpy(out, positions, sizeof(math::float4) * count);
 
     FEngine::DriverApi& driver = engine.getDriverApi();
@@ -200,13 +229,12 @@ void FMorphTargetBuffer::setTangentsAt(FEngine& engine, size_t targetIndex,
             "MorphTargetBuffer (size=%lu) overflow (count=%u, offset=%u)",
             (unsigned)mVertexCount, (unsigned)count, (unsigned)offset);
 
-    const auto size = getSize<VertexAttribute::TANGENTS>(mVertexCount);
-
     ASSERT_PRECONDITION(targetIndex < mCount,
             "%d target index must be < %d", targetIndex, mCount);
 
-    // We could use a pool instead of malloc() directly.
-    auto* out = (short4*) malloc(size);
+    // Tangents are quaternions, they have no natural "zero delta" to trim against, so the
+    // whole range is uploaded. We could use a pool instead of malloc() directly.
+    auto* out = (short4*) malloc(count * sizeof(short4));
     memcpy(out, tangents, sizeof(short4) * count);
 
     FEngine::DriverApi& driver = engine.getDriverApi();
@@ -246,7 +274,7 @@ void FMorphTargetBuffer::updateDataAt(backend::DriverApi& driver,
         driver.update3DImage(handle, 0, xoffset, yoffset, targetIndex,
                 min(count, textureWidth - xoffset), 1, 1,
                 PixelBufferDescriptor::make(
-                        out, (textureWidth - xoffset) * elementSize,
+                        out, min(count, textureWidth - xoffset) * elementSize,
                         format, type,
                         [allocation](void const*, size_t) {}
                 ));
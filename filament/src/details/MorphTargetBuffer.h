@@ -59,6 +59,9 @@ public:
     inline size_t getVertexCount() const noexcept { return mVertexCount; }
     inline size_t getCount() const noexcept { return mCount; }
 
+    // estimated video memory used by the position and tangent textures, in bytes
+    size_t getEstimatedSizeInBytes() const noexcept;
+
 private:
     friend class FView;
     friend class RenderPass;
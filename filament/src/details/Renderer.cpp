@@ -70,6 +70,12 @@ FRenderer::FRenderer(FEngine& engine) :
             &engine.debug.renderer.doFrameCapture);
     debugRegistry.registerProperty("d.renderer.disable_buffer_padding",
             &engine.debug.renderer.disable_buffer_padding);
+    debugRegistry.registerProperty("d.renderer.pacing.enabled",
+            &engine.debug.renderer.pacing.enabled);
+    debugRegistry.registerProperty("d.renderer.pacing.low_latency",
+            &engine.debug.renderer.pacing.low_latency);
+    debugRegistry.registerDataSource("d.renderer.pacing.stats",
+            &mFramePacer.getStats(), 1);
 
     DriverApi& driver = engine.getDriverApi();
 
@@ -111,6 +117,12 @@ FRenderer::~FRenderer() noexcept {
     << wm / 1024 << " KiB (" << wmpct << "%), "
     << wm / sizeof(Command) << " commands, " << sizeof(Command) << " bytes/command"
     << io::endl;
+
+    size_t const am = mPerRenderPassArenaHighWatermark;
+    size_t const ampct = am / (mPerRenderPassArena.getAllocator().allocated() / 100);
+    slog.d << "Renderer: Per-RenderPass Arena High watermark "
+    << am / 1024 << " KiB (" << ampct << "%)"
+    << io::endl;
 #endif
 }
 
@@ -122,13 +134,14 @@ void FRenderer::terminate(FEngine& engine) {
     // Before we can destroy this Renderer's resources, we must make sure
     // that all pending commands have been executed (as they could reference data in this
     // instance, e.g. Fences, Callbacks, etc...)
-    if (UTILS_HAS_THREADING) {
+    if (engine.hasDedicatedDriverThread()) {
         Fence::waitAndDestroy(engine.createFence());
     } else {
         // In single threaded mode, allow recently-created objects (e.g. no-op fences in Skipper)
         // to initialize themselves, otherwise the engine tries to destroy invalid handles.
         engine.execute();
     }
+    mPassTimingManager.terminate(driver);
     mFrameInfoManager.terminate(driver);
     mFrameSkipper.terminate(driver);
 }
@@ -203,9 +216,16 @@ bool FRenderer::beginFrame(FSwapChain* swapChain, uint64_t vsyncSteadyClockTimeN
 
     SYSTRACE_FRAME_ID(mFrameId);
 
+    // re-evaluate the thermal pressure for this frame (no-op when disabled)
+    mThermalGovernor.update();
+
     FEngine& engine = mEngine;
     FEngine::DriverApi& driver = engine.getDriverApi();
 
+    // publish a coherent snapshot of the debug properties for this frame (no-op until
+    // DebugRegistry::getPropertySnapshot() has been used)
+    engine.getDebugRegistry().captureFrameSnapshot();
+
     // start a frame capture, if requested.
     if (UTILS_UNLIKELY(engine.debug.renderer.doFrameCapture)) {
         driver.startCapture();
@@ -231,6 +251,21 @@ bool FRenderer::beginFrame(FSwapChain* swapChain, uint64_t vsyncSteadyClockTimeN
     // the frame skipper.
     driver.tick();
 
+    // issue a bounded amount of the deferred mipmap generation work, if any
+    // (see Texture::generateMipmapsAsync)
+    engine.flushPendingMipmapGenerations();
+
+    // frame pacing: schedule this frame's present on a vsync boundary and record jitter.
+    // In low-latency mode, we also accept only one frame in flight, trading throughput
+    // (the CPU and GPU can no longer fully overlap) for input-to-display latency.
+    if (UTILS_UNLIKELY(engine.debug.renderer.pacing.enabled)) {
+        bool const lowLatency = engine.debug.renderer.pacing.low_latency;
+        mFrameSkipper.setLatency(lowLatency ? 1 : 2);
+        mFramePacer.beginFrame(driver,
+                appVsync.time_since_epoch().count(),
+                now.time_since_epoch().count(), lowLatency);
+    }
+
     /*
     * From this point, we can't do any more work in beginFrame() because the user could choose
     * to ignore the return value and render the frame anyway -- which is perfectly fine.
@@ -245,9 +280,16 @@ bool FRenderer::beginFrame(FSwapChain* swapChain, uint64_t vsyncSteadyClockTimeN
         // This need to occur after the backend beginFrame() because some backends need to start
         // a command buffer before creating a fence.
 
-        mFrameInfoManager.beginFrame(driver, {
-                .historySize = mFrameRateOptions.history
-        }, mFrameId);
+        mPassTimingManager.beginFrame(driver);
+
+        // per-pass timer queries can't nest inside the whole-frame one (time-elapsed queries
+        // are exclusive on GL), so the frame-time measurement is suspended while pass
+        // profiling is active -- dynamic resolution then holds its current scale.
+        if (UTILS_LIKELY(!mPassTimingManager.isActive())) {
+            mFrameInfoManager.beginFrame(driver, {
+                    .historySize = mFrameRateOptions.history
+            }, mFrameId);
+        }
 
         // ask the engine to do what it needs to (e.g. updates light buffer, materials...)
         engine.prepare();
@@ -281,17 +323,24 @@ void FRenderer::endFrame() {
     FEngine& engine = mEngine;
     FEngine::DriverApi& driver = engine.getDriverApi();
 
-    if (UTILS_HAS_THREADING) {
+    if (engine.hasDedicatedDriverThread()) {
         // on debug builds this helps to catch cases where we're writing to
         // the buffer form another thread, which is currently not allowed.
         driver.debugThreading();
     }
 
     if (mSwapChain) {
-        mSwapChain->commit(driver);
+        if (UTILS_UNLIKELY(mGroupFrames)) {
+            // present deferred until endFrameGroup(), so that every window's command stream is
+            // recorded and submitted before any of them can stall on a vsync boundary
+            mDeferredPresents.push_back(mSwapChain);
+        } else {
+            mSwapChain->commit(driver);
+        }
         mSwapChain = nullptr;
     }
 
+    mPassTimingManager.endFrame(driver);
     mFrameInfoManager.endFrame(driver);
     mFrameSkipper.endFrame(driver);
 
@@ -300,6 +349,11 @@ void FRenderer::endFrame() {
     // gives the backend a chance to execute periodic tasks
     driver.tick();
 
+#ifndef NDEBUG
+    // records the backend's redundant-bind counters for the frame that just completed
+    engine.debug.backend.stateCache = driver.getStateCacheStatistics();
+#endif
+
     // stop the frame capture, if one was requested
     if (UTILS_UNLIKELY(engine.debug.renderer.doFrameCapture)) {
         driver.stopCapture();
@@ -309,6 +363,15 @@ void FRenderer::endFrame() {
     // do this before engine.flush()
     engine.getResourceAllocator().gc();
 
+    // fires the application's over-budget callback if one is set (see Engine::setMemoryBudget)
+    engine.checkMemoryBudget();
+
+    // return the per-render-pass arena pages that went unused this frame to the OS;
+    // the release decays, so only a sustained peak (e.g. loading) keeps its pages
+    auto& perRenderPassArena = engine.getPerRenderPassAllocator();
+    perRenderPassArena.getArea().releaseUnusedPages(
+            perRenderPassArena.getAllocator().takeWatermark());
+
     // Run the component managers' GC in parallel
     // WARNING: while doing this we can't access any component manager
     auto& js = engine.getJobSystem();
@@ -321,6 +384,28 @@ void FRenderer::endFrame() {
     js.waitAndRelease(job);
 }
 
+void FRenderer::beginFrameGroup() noexcept {
+    assert_invariant(!mGroupFrames);
+    mGroupFrames = true;
+}
+
+void FRenderer::endFrameGroup() {
+    assert_invariant(mGroupFrames);
+    mGroupFrames = false;
+
+    FEngine::DriverApi& driver = mEngine.getDriverApi();
+
+    // all windows' command streams are recorded at this point; issue the presents back-to-back,
+    // in submission order, so a swap-interval stall on one window overlaps the GPU work of the
+    // others instead of serializing it
+    for (FSwapChain* const swapChain : mDeferredPresents) {
+        swapChain->commit(driver);
+    }
+    mDeferredPresents.clear();
+
+    mEngine.flush();
+}
+
 void FRenderer::readPixels(uint32_t xoffset, uint32_t yoffset, uint32_t width, uint32_t height,
         PixelBufferDescriptor&& buffer) {
 #ifndef NDEBUG
@@ -412,6 +497,60 @@ void FRenderer::renderStandaloneView(FView const* view) {
     }
 }
 
+void FRenderer::renderStandaloneViews(View const* const* views, size_t count,
+        backend::CallbackHandler* handler,
+        backend::CallbackHandler::Callback callback, void* user) {
+    SYSTRACE_CALL();
+
+    using namespace std::chrono;
+
+    for (size_t i = 0; i < count; i++) {
+        ASSERT_PRECONDITION(downcast(views[i])->getRenderTarget(),
+                "View \"%s\" must have a RenderTarget associated",
+                downcast(views[i])->getName());
+    }
+
+    FEngine& engine = mEngine;
+    FEngine::DriverApi& driver = engine.getDriverApi();
+
+    // The scene state is shared by the whole batch, upload it only once
+    // (this is the ask the engine to do what it needs to, e.g. updates light buffer,
+    // materials...)
+    engine.prepare();
+
+    for (size_t i = 0; i < count; i++) {
+        FView const* const view = downcast(views[i]);
+        if (UTILS_UNLIKELY(!view->getScene())) {
+            continue;
+        }
+        mPreviousRenderTargets.clear();
+        mFrameId++;
+
+        driver.beginFrame(steady_clock::now().time_since_epoch().count(), mFrameId);
+
+        renderInternal(view);
+
+        driver.endFrame(mFrameId);
+
+        // kick the backend so consecutive frames overlap with the encoding of the next one,
+        // instead of accumulating in the command buffer
+        driver.flush();
+    }
+
+    if (callback) {
+        // this executes on the backend thread once every frame of the batch has been
+        // processed; readbacks complete through their own callbacks, as usual
+        driver.queueCommand([handler, callback, user]() {
+            if (handler) {
+                handler->post(user, callback);
+            } else {
+                callback(user);
+            }
+        });
+        driver.flush();
+    }
+}
+
 void FRenderer::render(FView const* view) {
     SYSTRACE_CALL();
 
@@ -448,6 +587,15 @@ void FRenderer::renderInternal(FView const* view) {
     // execute the render pass
     renderJob(rootArena, const_cast<FView&>(*view));
 
+    // keep track of the per-frame arena usage. This underestimates the true peak slightly
+    // because nested ArenaScopes have already been rewound, but it's cheap enough to do in
+    // release builds (the arena's TrackingPolicy is debug-only).
+    auto const& allocator = mPerRenderPassArena.getAllocator();
+    size_t const used = allocator.allocated() - allocator.available();
+    if (UTILS_UNLIKELY(used > mPerRenderPassArenaHighWatermark)) {
+        mPerRenderPassArenaHighWatermark = used;
+    }
+
     // make sure to flush the command buffer
     engine.flush();
 
@@ -480,6 +628,13 @@ void FRenderer::renderJob(ArenaScope& arena, FView& view) {
     auto colorGrading = view.getColorGrading();
     auto ssReflectionsOptions = view.getScreenSpaceReflectionsOptions();
     auto guardBandOptions = view.getGuardBandOptions();
+
+    // apply the thermal governor's quality caps, all neutral when it is disabled or cool
+    ThermalGovernor::Caps const thermalCaps = mThermalGovernor.getCaps();
+    scale = min(scale, float2(thermalCaps.dynamicResolutionScale));
+    msaaOptions.enabled = msaaOptions.enabled && thermalCaps.msaa;
+    view.setShadowResolutionScale(thermalCaps.shadowResolutionScale);
+
     const uint8_t msaaSampleCount = msaaOptions.enabled ? msaaOptions.sampleCount : 1u;
     if (!hasPostProcess) {
         // disable all effects that are part of post-processing
@@ -495,22 +650,38 @@ void FRenderer::renderJob(ArenaScope& arena, FView& view) {
         // This configures post-process materials by setting constant parameters
         if (taaOptions.enabled) {
             ppm.configureTemporalAntiAliasingMaterial(taaOptions);
+            if (taaOptions.upscaling) {
+                // TAA 2x upscaling renders the scene at half resolution in each dimension
+                // and reconstructs the full resolution output from the temporal history.
+                // It supersedes dynamic resolution.
+                scale = 0.5f;
+                dsrOptions.enabled = false;
+            }
         }
     }
 
+    // when dynamic resolution is engaged, degrade the cheapest-looking stages first instead
+    // of letting every pass follow the primary scale factor uniformly
+    if (dsrOptions.enabled) {
+        ppm.applyStageScalePolicies(scale, aoOptions, bloomOptions);
+    }
+
     const bool blendModeTranslucent = view.getBlendMode() == BlendMode::TRANSLUCENT;
     // If the swap-chain is transparent or if we blend into it, we need to allocate our intermediate
     // buffers with an alpha channel.
     const bool needsAlphaChannel =
             (mSwapChain && mSwapChain->isTransparent()) || blendModeTranslucent;
 
-    // asSubpass is disabled with TAA (although it's supported) because performance was degraded
-    // on qualcomm hardware -- we might need a backend dependent toggle at some point
+    // with TAA, color grading runs as a subpass of the TAA pass instead of the color pass;
+    // backends where this degrades performance (e.g. qualcomm hardware) report it as a
+    // workaround, in which case we fall back to a separate color grading pass
     const PostProcessManager::ColorGradingConfig colorGradingConfig{
             .asSubpass =
                     hasColorGrading &&
                     msaaSampleCount <= 1 &&
-                    !bloomOptions.enabled && !dofOptions.enabled && !taaOptions.enabled &&
+                    !bloomOptions.enabled && !dofOptions.enabled &&
+                    (!taaOptions.enabled ||
+                            !driver.isWorkaroundNeeded(Workaround::DISABLE_SUBPASS_WITH_TAA)) &&
                     driver.isFrameBufferFetchSupported(),
             .customResolve =
                     msaaOptions.customResolve &&
@@ -525,7 +696,7 @@ void FRenderer::renderJob(ArenaScope& arena, FView& view) {
     };
 
     // whether we're scaled at all
-    const bool scaled = any(notEqual(scale, float2(1.0f)));
+    bool scaled = any(notEqual(scale, float2(1.0f)));
 
     // vp is the user defined viewport within the View
     filament::Viewport const& vp = view.getViewport();
@@ -649,6 +820,10 @@ void FRenderer::renderJob(ArenaScope& arena, FView& view) {
      */
 
     FrameGraph fg(engine.getResourceAllocator());
+    fg.setCullCache(&mFrameGraphCullCache);
+    if (UTILS_UNLIKELY(mPassTimingManager.isActive())) {
+        fg.setPassProfiler(&mPassTimingManager);
+    }
     auto& blackboard = fg.getBlackboard();
 
     /*
@@ -665,6 +840,16 @@ void FRenderer::renderJob(ArenaScope& arena, FView& view) {
         blackboard["shadows"] = shadows;
     }
 
+    if (dsrOptions.enabled) {
+        // from this point on the GPU time scales with the render target resolution; have the
+        // frame info manager account it separately, so the dynamic resolution controller can
+        // model the frame as fixed overhead plus resolution-sensitive work.
+        fg.addTrivialSideEffectPass("Begin Scaled Passes",
+                [this](DriverApi& driver) {
+                    mFrameInfoManager.beginScaledPasses(driver);
+                });
+    }
+
     // When we don't have a custom RenderTarget, currentRenderTarget below is nullptr and is
     // recorded in the list of targets already rendered into -- this ensures that
     // initializeClearFlags() is called only once for the default RenderTarget.
@@ -793,10 +978,25 @@ void FRenderer::renderJob(ArenaScope& arena, FView& view) {
     // Currently it consists of a simple depth pass.
     // This is normally used by SSAO and contact-shadows
 
+    // When the structure buffer has no consumer besides picking (no SSAO, contact
+    // shadows, screen-space reflections/refractions or occlusion culling), restrict
+    // rasterization to a small region around the pending picking queries -- the
+    // readbacks never touch pixels outside of it.
+    filament::Viewport structureScissor{};
+    if (view.hasPicking()
+            && !aoOptions.enabled
+            && !scene.hasContactShadows()
+            && !ssReflectionsOptions.enabled
+            && !view.isScreenSpaceRefractionEnabled()
+            && !view.isOcclusionCullingEnabled()) {
+        structureScissor = view.getPickingQueriesArea(aoOptions.resolution);
+    }
+
     // TODO: the scaling should depends on all passes that need the structure pass
     const auto [structure, picking_] = ppm.structure(fg, pass, renderFlags, svp.width, svp.height, {
             .scale = aoOptions.resolution,
-            .picking = view.hasPicking()
+            .picking = view.hasPicking(),
+            .scissor = structureScissor
     });
     blackboard["structure"] = structure;
     const auto picking = picking_;
@@ -822,6 +1022,37 @@ void FRenderer::renderJob(ArenaScope& arena, FView& view) {
                 });
     }
 
+    // --------------------------------------------------------------------------------------------
+    // occlusion depth pass -- reduces the structure buffer and reads it back asynchronously;
+    // the result is used by FView::prepare() to occlusion-cull renderables on a later frame.
+
+    if (UTILS_UNLIKELY(view.isOcclusionCullingEnabled()
+            && engine.getActiveFeatureLevel() != FeatureLevel::FEATURE_LEVEL_0)) {
+        auto const occlusionDepth = ppm.occlusionDepth(fg, structure);
+        // the clip-from-world matrix of this frame, saved with the readback so that the culling
+        // test later uses the same transform the depth buffer was rendered with
+        mat4f const occlusionViewProjection = cameraInfo.projection * cameraInfo.view;
+        struct OcclusionReadbackPassData {
+            FrameGraphId<FrameGraphTexture> occlusionDepth;
+        };
+        fg.addPass<OcclusionReadbackPassData>("Occlusion Depth Readback Pass",
+                [&](FrameGraph::Builder& builder, auto& data) {
+                    data.occlusionDepth = builder.read(occlusionDepth,
+                            FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+                    builder.declareRenderPass("Occlusion Depth Readback Target", {
+                            .attachments = { .color = { data.occlusionDepth }}
+                    });
+                    builder.sideEffect();
+                },
+                [=, &view](FrameGraphResources const& resources,
+                        auto const& data, DriverApi& driver) mutable {
+                    auto const& desc = resources.getDescriptor(data.occlusionDepth);
+                    auto out = resources.getRenderPassInfo();
+                    view.submitOcclusionDepthReadback(driver, out.target,
+                            desc.width, desc.height, occlusionViewProjection);
+                });
+    }
+
     // Store this frame's camera projection in the frame history.
     if (UTILS_UNLIKELY(taaOptions.enabled)) {
         // Apply the TAA jitter to everything after the structure pass, starting with the color pass.
@@ -852,12 +1083,18 @@ void FRenderer::renderJob(ArenaScope& arena, FView& view) {
     // screen-space reflections pass
 
     if (ssReflectionsOptions.enabled) {
+        // the reflections buffer can be scaled down (ssReflectionsOptions.resolution is
+        // either 1.0 or 0.5); generateMipmapSSR() below rescales it to the ssr array, and
+        // the temporal reprojection of the reflections hides the resolution loss
         auto reflections = ppm.ssr(fg, pass,
                 view.getFrameHistory(), cameraInfo,
                 view.getPerViewUniforms(),
                 structure,
                 ssReflectionsOptions,
-                { .width = svp.width, .height = svp.height });
+                { .width = std::max(32u, uint32_t(
+                          std::ceil(float(svp.width) * ssReflectionsOptions.resolution))),
+                  .height = std::max(32u, uint32_t(
+                          std::ceil(float(svp.height) * ssReflectionsOptions.resolution))) });
 
         if (UTILS_LIKELY(reflections)) {
             // generate the mipchain
@@ -897,7 +1134,9 @@ void FRenderer::renderJob(ArenaScope& arena, FView& view) {
                 });
     }
 
-    // sort commands once we're done adding commands
+    // sort commands once we're done adding commands; the view's persistent cache lets the
+    // sort be incremental when most commands kept last frame's keys
+    pass.setSortCache(&view.getColorPassSortCache());
     pass.sortCommands(engine);
 
 
@@ -1011,6 +1250,16 @@ void FRenderer::renderJob(ArenaScope& arena, FView& view) {
     if (taaOptions.enabled) {
         input = ppm.taa(fg, input, depth, view.getFrameHistory(), &FrameHistoryEntry::taa,
                 taaOptions, colorGradingConfig);
+        if (taaOptions.upscaling) {
+            // the TAA resolve reconstructed the full resolution output, from here on we're
+            // not scaled anymore and the spatial upscale pass below is not needed.
+            scale = 1.0f;
+            scaled = false;
+            auto const& upscaledDesc = fg.getDescriptor(input);
+            svp.width = upscaledDesc.width;
+            svp.height = upscaledDesc.height;
+            xvp = { xvp.left * 2, xvp.bottom * 2, xvp.width * 2, xvp.height * 2 };
+        }
     }
 
     // --------------------------------------------------------------------------------------------
@@ -1070,6 +1319,30 @@ void FRenderer::renderJob(ArenaScope& arena, FView& view) {
         }
     }
 
+    // Performance HUD overlay, drawn over the final image (see View::setPerformanceHudEnabled)
+    if (UTILS_UNLIKELY(view.isPerformanceHudEnabled() && hasPostProcess)) {
+        using PerformanceHudInfo = PostProcessManager::PerformanceHudInfo;
+        PerformanceHudInfo hudInfo;
+        FrameInfo const* const history = mFrameInfoManager.getFrameHistory();
+        uint32_t const historySize = std::min(mFrameInfoManager.getFrameHistorySize(),
+                uint32_t(PerformanceHudInfo::HISTORY_SIZE));
+        for (uint32_t i = 0; i < historySize; i++) {
+            hudInfo.frameTimesMs[i / 4u][i % 4u] = history[i].frameTime.count();
+        }
+        hudInfo.frameTimeCount = historySize;
+        hudInfo.targetFrameTimeMs = mDisplayInfo.refreshRate > 0.0
+                ? float(1000.0 / mDisplayInfo.refreshRate) : 16.667f;
+        JobSystem const& js = engine.getJobSystem();
+        hudInfo.jobSystemOccupancy = std::min(1.0f,
+                float(js.getActiveJobCount()) / float(std::max(size_t(1), js.getThreadCount())));
+        auto const memory = engine.getResourceAllocator().getMemoryReport();
+        size_t const transientSize = memory.inUseColorSize + memory.inUseDepthSize
+                + memory.cachedColorSize + memory.cachedDepthSize;
+        hudInfo.transientMemoryUsage = memory.capacity ? std::min(1.0f,
+                float(double(transientSize) / double(memory.capacity))) : 0.0f;
+        input = ppm.performanceHud(fg, input, hudInfo);
+    }
+
     // We need to do special processing when rendering directly into the swap-chain, that is when
     // the viewRenderTarget is the default render target (mRenderTarget) and we're rendering into
     // it.
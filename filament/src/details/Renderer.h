@@ -21,7 +21,10 @@
 
 #include "Allocators.h"
 #include "FrameInfo.h"
+#include "FramePacer.h"
 #include "FrameSkipper.h"
+#include "PassTimingManager.h"
+#include "ThermalGovernor.h"
 #include "PostProcessManager.h"
 #include "RenderPass.h"
 
@@ -31,6 +34,7 @@
 
 #include <fg/FrameGraphId.h>
 #include <fg/FrameGraphTexture.h>
+#include "fg/details/DependencyGraph.h"
 
 #include <filament/Renderer.h>
 #include <filament/Viewport.h>
@@ -43,6 +47,8 @@
 
 #include <tsl/robin_set.h>
 
+#include <vector>
+
 namespace filament {
 
 namespace backend {
@@ -75,6 +81,10 @@ public:
     // renders a single standalone view. The view must have a a custom rendertarget.
     void renderStandaloneView(FView const* view);
 
+    void renderStandaloneViews(View const* const* views, size_t count,
+            backend::CallbackHandler* handler,
+            backend::CallbackHandler::Callback callback, void* user);
+
 
     void setPresentationTime(int64_t monotonic_clock_ns);
 
@@ -84,6 +94,11 @@ public:
     // end a frame
     void endFrame();
 
+    // group several beginFrame/endFrame pairs into one multi-window frame:
+    // presents are deferred and issued in a batch by endFrameGroup()
+    void beginFrameGroup() noexcept;
+    void endFrameGroup();
+
     // render a view. must be called between beginFrame/enfFrame.
     void render(FView const* view);
 
@@ -123,6 +138,26 @@ public:
         frameRateOptions.headRoomRatio = std::max(frameRateOptions.headRoomRatio, 0.0f);
     }
 
+    void setThermalGovernorEnabled(bool enabled) noexcept {
+        mThermalGovernor.setEnabled(enabled);
+    }
+
+    bool isThermalGovernorEnabled() const noexcept {
+        return mThermalGovernor.isEnabled();
+    }
+
+    void setPassProfilingEnabled(bool enabled) noexcept {
+        mPassTimingManager.setEnabled(enabled);
+    }
+
+    bool isPassProfilingEnabled() const noexcept {
+        return mPassTimingManager.isEnabled();
+    }
+
+    size_t getPassTimings(PassTiming* timings, size_t count) const noexcept {
+        return mPassTimingManager.getPassTimings(timings, count);
+    }
+
     void setClearOptions(const ClearOptions& options) {
         mClearOptions = options;
     }
@@ -168,12 +203,17 @@ private:
     // keep a reference to our engine
     FEngine& mEngine;
     FrameSkipper mFrameSkipper;
+    FramePacer mFramePacer;
     backend::Handle<backend::HwRenderTarget> mRenderTargetHandle;
     FSwapChain* mSwapChain = nullptr;
     size_t mCommandsHighWatermark = 0;
     uint32_t mFrameId = 0;
     uint32_t mViewRenderedCount = 0;
     FrameInfoManager mFrameInfoManager;
+    PassTimingManager mPassTimingManager;
+    ThermalGovernor mThermalGovernor;
+    // lets the per-frame FrameGraph skip pass culling when its topology is unchanged
+    DependencyGraph::CullCache mFrameGraphCullCache;
     backend::TextureFormat mHdrTranslucent;
     backend::TextureFormat mHdrQualityMedium;
     backend::TextureFormat mHdrQualityHigh;
@@ -187,9 +227,16 @@ private:
     backend::TargetBufferFlags mClearFlags{};
     tsl::robin_set<FRenderTarget*> mPreviousRenderTargets;
     std::function<void()> mBeginFrameInternal;
+    // swapchains whose present was deferred by the current frame group (see beginFrameGroup())
+    std::vector<FSwapChain*> mDeferredPresents;
+    bool mGroupFrames = false;
 
     // per-frame arena for this Renderer
     LinearAllocatorArena& mPerRenderPassArena;
+
+    // most bytes ever used in mPerRenderPassArena during a frame (approximate, see
+    // renderInternal()); logged at destruction like the commands watermark above
+    size_t mPerRenderPassArenaHighWatermark = 0;
 };
 
 FILAMENT_DOWNCAST(Renderer)
@@ -43,6 +43,10 @@ using namespace utils;
 
 namespace filament {
 
+// entity count per parallel gather job in prepare(); also the threshold below which
+// the gather stays single-threaded
+static constexpr size_t GATHER_GROUP_SIZE = 4096;
+
 // ------------------------------------------------------------------------------------------------
 
 FScene::FScene(FEngine& engine) :
@@ -63,6 +67,18 @@ void FScene::prepare(utils::JobSystem& js,
 
     SYSTRACE_CONTEXT();
 
+    // Fast path: when the same scene is rendered from several views within one frame
+    // (e.g. main view + planar reflection + minimap), everything below only depends on the
+    // scene's content and our parameters, which haven't changed. The views merely toggle
+    // visibility bits and permute the renderable SoA's rows, neither of which invalidates
+    // the rows themselves, so the renderable data can be reused as-is. The light SoA
+    // however is truncated by per-view light culling and must be rebuilt each time.
+    if (isPreparedDataReusable(worldTransform, shadowReceiversAreCasters)) {
+        SYSTRACE_NAME("prepare (reused)");
+        prepareLightData(js, worldTransform);
+        return;
+    }
+
     // This will reset the allocator upon exiting
     ArenaScope const arena(allocator);
 
@@ -73,8 +89,23 @@ void FScene::prepare(utils::JobSystem& js,
     FLightManager const& lcm = engine.getLightManager();
     // go through the list of entities, and gather the data of those that are renderables
     auto& sceneData = mRenderableData;
-    auto& lightData = mLightData;
-    auto const& entities = mEntities;
+
+    /*
+     * Flatten the partitions into a single entity array. Each partition's entities stay
+     * contiguous, so its renderables end up contiguous in the SoA below, and the
+     * block-level culling in FView::cullRenderables() can then reject whole partitions
+     * (i.e. streamed world chunks) by bounds. This also gives the gather jobs random
+     * access to the entities.
+     */
+
+    using EntityContainer = FixedCapacityVector<Entity,
+            utils::STLAllocator<Entity, LinearAllocatorArena>, false>;
+    EntityContainer entities{ EntityContainer::with_capacity(getEntityCount(), allocator) };
+    for (Partition const& partition: mPartitions) {
+        for (Entity const e: partition.entities) {
+            entities.push_back(e);
+        }
+    }
 
     using RenderableContainerData = std::pair<RenderableManager::Instance, TransformManager::Instance>;
     using RenderableInstanceContainer = FixedCapacityVector<RenderableContainerData,
@@ -99,35 +130,128 @@ void FScene::prepare(utils::JobSystem& js,
     /*
      * First compute the exact number of renderables and lights in the scene.
      * Also find the main directional light.
+     *
+     * With large entity counts, the gather itself becomes the bottleneck, so we process
+     * fixed entity ranges in parallel. Each job writes into its own disjoint range of the
+     * (pre-sized) instance containers -- so jobs never share cache lines -- and the sparse
+     * ranges are compacted in-place afterwards, preserving entity order.
      */
 
-    for (Entity const e: entities) {
-        if (UTILS_LIKELY(em.isAlive(e))) {
-            auto ti = tcm.getInstance(e);
-            auto li = lcm.getInstance(e);
-            auto ri = rcm.getInstance(e);
-            if (li) {
-                // we handle the directional light here because it'd prevent multithreading below
-                if (UTILS_UNLIKELY(lcm.isDirectionalLight(li))) {
-                    // we don't store the directional lights, because we only have a single one
-                    if (lcm.getIntensity(li) >= maxIntensity) {
-                        maxIntensity = lcm.getIntensity(li);
-                        directionalLightInstances = { li, ti };
+    size_t const entityCount = entities.size();
+
+    if (entityCount < GATHER_GROUP_SIZE) {
+        // single-threaded gather, not worth spinning up jobs
+        for (Entity const e: entities) {
+            if (UTILS_LIKELY(em.isAlive(e))) {
+                auto ti = tcm.getInstance(e);
+                auto li = lcm.getInstance(e);
+                auto ri = rcm.getInstance(e);
+                if (li) {
+                    // we handle the directional light here because it'd prevent multithreading below
+                    if (UTILS_UNLIKELY(lcm.isDirectionalLight(li))) {
+                        // we don't store the directional lights, because we only have a single one
+                        if (lcm.getIntensity(li) >= maxIntensity) {
+                            maxIntensity = lcm.getIntensity(li);
+                            directionalLightInstances = { li, ti };
+                        }
+                    } else {
+                        lightInstances.emplace_back(li, ti);
+                    }
+                }
+                if (ri) {
+                    renderableInstances.emplace_back(ri, ti);
+                }
+            }
+        }
+    } else {
+        struct GatherGroup { // per-job results, written by one job only
+            uint32_t renderableCount = 0;
+            uint32_t lightCount = 0;
+            float maxIntensity = 0.0f;
+            std::pair<LightManager::Instance, TransformManager::Instance> directional{};
+        };
+
+        size_t const groupCount = (entityCount + GATHER_GROUP_SIZE - 1) / GATHER_GROUP_SIZE;
+
+        using GatherGroupContainer = FixedCapacityVector<GatherGroup,
+                utils::STLAllocator<GatherGroup, LinearAllocatorArena>, false>;
+        GatherGroupContainer groups{ GatherGroupContainer::with_capacity(groupCount, allocator) };
+        groups.resize(groupCount);
+
+        // each job writes into [base, base + count) of these, compacted below
+        renderableInstances.resize(entityCount);
+        lightInstances.resize(entityCount);
+
+        auto gather = [&em, &tcm, &lcm, &rcm, entityArray = entities.data(), entityCount,
+                       &groups,
+                       renderables = renderableInstances.data(),
+                       lights = lightInstances.data()](size_t const group) {
+            SYSTRACE_NAME("gatherInstances");
+            GatherGroup& g = groups[group];
+            size_t const base = group * GATHER_GROUP_SIZE;
+            size_t const count = std::min(base + GATHER_GROUP_SIZE, entityCount) - base;
+            for (size_t i = 0; i < count; i++) {
+                Entity const e = entityArray[base + i];
+                if (UTILS_LIKELY(em.isAlive(e))) {
+                    auto ti = tcm.getInstance(e);
+                    auto li = lcm.getInstance(e);
+                    auto ri = rcm.getInstance(e);
+                    if (li) {
+                        if (UTILS_UNLIKELY(lcm.isDirectionalLight(li))) {
+                            if (lcm.getIntensity(li) >= g.maxIntensity) {
+                                g.maxIntensity = lcm.getIntensity(li);
+                                g.directional = { li, ti };
+                            }
+                        } else {
+                            lights[base + g.lightCount++] = { li, ti };
+                        }
+                    }
+                    if (ri) {
+                        renderables[base + g.renderableCount++] = { ri, ti };
                     }
-                } else {
-                    lightInstances.emplace_back(li, ti);
                 }
             }
-            if (ri) {
-                renderableInstances.emplace_back(ri, ti);
+        };
+
+        JobSystem::Job* gatherJob = js.createJob();
+        for (size_t group = 0; group < groupCount; group++) {
+            js.run(jobs::createJob(js, gatherJob, std::cref(gather), group));
+        }
+        js.runAndWait(gatherJob);
+
+        // compact the sparse per-group ranges in-place (dst <= src, so moving forward is safe)
+        // and reduce the per-group directional light candidates, in entity order
+        size_t renderableCount = 0;
+        size_t lightCount = 0;
+        for (size_t group = 0; group < groupCount; group++) {
+            GatherGroup const& g = groups[group];
+            size_t const base = group * GATHER_GROUP_SIZE;
+            std::move(renderableInstances.data() + base,
+                    renderableInstances.data() + base + g.renderableCount,
+                    renderableInstances.data() + renderableCount);
+            std::move(lightInstances.data() + base,
+                    lightInstances.data() + base + g.lightCount,
+                    lightInstances.data() + lightCount);
+            renderableCount += g.renderableCount;
+            lightCount += g.lightCount;
+            if (g.maxIntensity >= maxIntensity && g.directional.first) {
+                maxIntensity = g.maxIntensity;
+                directionalLightInstances = g.directional;
             }
         }
+        renderableInstances.resize(renderableCount);
+        lightInstances.resize(lightCount);
     }
 
     SYSTRACE_NAME_END();
 
+    // Save the gathered light instances: if another view renders this scene within this
+    // frame, the fast path above only needs to rebuild the light SoA from these.
+    mGatheredLightInstances.assign(lightInstances.begin(), lightInstances.end());
+    mGatheredDirectionalLight = directionalLightInstances;
+
     /*
-     * Evaluate the capacity needed for the renderable and light SoAs
+     * Evaluate the capacity needed for the renderable SoA
      */
 
     // we need the capacity to be multiple of 16 for SIMD loops
@@ -136,14 +260,8 @@ void FScene::prepare(utils::JobSystem& js,
     renderableDataCapacity = (renderableDataCapacity + 0xFu) & ~0xFu;
     renderableDataCapacity = renderableDataCapacity + 1;
 
-    // The light data list will always contain at least one entry for the
-    // dominating directional light, even if there are no entities.
-    // we need the capacity to be multiple of 16 for SIMD loops
-    size_t lightDataCapacity = std::max<size_t>(DIRECTIONAL_LIGHTS_COUNT, entities.size());
-    lightDataCapacity = (lightDataCapacity + 0xFu) & ~0xFu;
-
     /*
-     * Now resize the SoAs if needed
+     * Now resize the SoA if needed
      */
 
     // TODO: the resize below could happen in a job
@@ -157,15 +275,6 @@ void FScene::prepare(utils::JobSystem& js,
         sceneData.resize(renderableInstances.size());
     }
 
-    if (lightData.size() != lightInstances.size() + DIRECTIONAL_LIGHTS_COUNT) {
-        lightData.clear();
-        if (lightData.capacity() < lightDataCapacity) {
-            lightData.setCapacity(lightDataCapacity);
-        }
-        assert_invariant(lightInstances.size() + DIRECTIONAL_LIGHTS_COUNT <= lightData.capacity());
-        lightData.resize(lightInstances.size() + DIRECTIONAL_LIGHTS_COUNT);
-    }
-
     /*
      * Fill the SoA with the JobSystem
      */
@@ -218,6 +327,89 @@ void FScene::prepare(utils::JobSystem& js,
         }
     };
 
+    SYSTRACE_NAME_BEGIN("Renderable and Light jobs");
+
+    JobSystem::Job* rootJob = js.createJob();
+
+    auto* renderableJob = jobs::parallel_for(js, rootJob,
+            renderableInstances.data(), renderableInstances.size(),
+            std::cref(renderableWork), jobs::CountSplitter<128, 5>());
+
+    js.run(renderableJob);
+
+    // Fill the light SoA; this kicks its own jobs -- which run in parallel with the
+    // renderable job above -- and waits for them.
+    prepareLightData(js, worldTransform);
+
+    // Purely for the benefit of MSAN, we can avoid uninitialized reads by zeroing out the
+    // unused scene elements between the end of the array and the rounded-up count.
+    if (UTILS_HAS_SANITIZE_MEMORY) {
+        for (size_t i = sceneData.size(), e = sceneData.capacity(); i < e; i++) {
+            sceneData.data<LAYERS>()[i] = 0;
+            sceneData.data<VISIBLE_MASK>()[i] = 0;
+            sceneData.data<VISIBILITY_STATE>()[i] = {};
+        }
+    }
+
+    js.runAndWait(rootJob);
+
+    SYSTRACE_NAME_END();
+
+    // Stamp the scene-level output so the fast path above can reuse it within this frame.
+    mPreparedFrameEpoch = engine.getFrameEpoch();
+    mPreparedSceneVersion = mVersion;
+    mPreparedTransformVersion = tcm.getVersion();
+    mPreparedRenderableVersion = rcm.getVersion();
+    mPreparedWorldTransform = worldTransform;
+    mPreparedShadowReceiversAreCasters = shadowReceiversAreCasters;
+    mPreparedDataValid = true;
+    mRenderableDataCanonicalOrder = true;
+}
+
+bool FScene::isPreparedDataReusable(mat4 const& worldTransform,
+        bool const shadowReceiversAreCasters) const noexcept {
+    FEngine const& engine = mEngine;
+    if (!mPreparedDataValid ||
+            mPreparedFrameEpoch != engine.getFrameEpoch() ||
+            mPreparedSceneVersion != mVersion ||
+            mPreparedTransformVersion != engine.getTransformManager().getVersion() ||
+            mPreparedRenderableVersion != engine.getRenderableManager().getVersion() ||
+            mPreparedShadowReceiversAreCasters != shadowReceiversAreCasters) {
+        return false;
+    }
+    for (size_t i = 0; i < 4; i++) {
+        if (mPreparedWorldTransform[i] != worldTransform[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void FScene::prepareLightData(utils::JobSystem& js, mat4 const& worldTransform) noexcept {
+    SYSTRACE_CALL();
+
+    FEngine& engine = mEngine;
+    FTransformManager const& tcm = engine.getTransformManager();
+    FLightManager const& lcm = engine.getLightManager();
+    auto& lightData = mLightData;
+    auto const& lightInstances = mGatheredLightInstances;
+
+    // The light data list will always contain at least one entry for the
+    // dominating directional light, even if there are no lights.
+    // we need the capacity to be multiple of 16 for SIMD loops
+    size_t lightDataCapacity = std::max<size_t>(DIRECTIONAL_LIGHTS_COUNT,
+            lightInstances.size() + DIRECTIONAL_LIGHTS_COUNT);
+    lightDataCapacity = (lightDataCapacity + 0xFu) & ~0xFu;
+
+    if (lightData.size() != lightInstances.size() + DIRECTIONAL_LIGHTS_COUNT) {
+        lightData.clear();
+        if (lightData.capacity() < lightDataCapacity) {
+            lightData.setCapacity(lightDataCapacity);
+        }
+        assert_invariant(lightInstances.size() + DIRECTIONAL_LIGHTS_COUNT <= lightData.capacity());
+        lightData.resize(lightInstances.size() + DIRECTIONAL_LIGHTS_COUNT);
+    }
+
     auto lightWork = [first = lightInstances.data(), &lcm, &tcm, &worldTransform,
             &lightData](auto* p, auto c) {
         SYSTRACE_NAME("lightWork");
@@ -241,20 +433,12 @@ void FScene::prepare(utils::JobSystem& js,
         }
     };
 
-
-    SYSTRACE_NAME_BEGIN("Renderable and Light jobs");
-
     JobSystem::Job* rootJob = js.createJob();
 
-    auto* renderableJob = jobs::parallel_for(js, rootJob,
-            renderableInstances.data(), renderableInstances.size(),
-            std::cref(renderableWork), jobs::CountSplitter<128, 5>());
-
     auto* lightJob = jobs::parallel_for(js, rootJob,
             lightInstances.data(), lightInstances.size(),
             std::cref(lightWork), jobs::CountSplitter<32, 5>());
 
-    js.run(renderableJob);
     js.run(lightJob);
 
     // Everything below can be done in parallel.
@@ -263,7 +447,7 @@ void FScene::prepare(utils::JobSystem& js,
      * Handle the directional light separately
      */
 
-    if (auto [li, ti] = directionalLightInstances ; li) {
+    if (auto [li, ti] = mGatheredDirectionalLight ; li) {
         // in the code below, we only transform directions, so the translation of the
         // world transform is irrelevant, and we don't need to use getWorldTransformAccurate()
 
@@ -304,6 +488,15 @@ void FScene::prepare(utils::JobSystem& js,
         lightData.elementAt<LIGHT_INSTANCE>(0) = 0;
     }
 
+    // cache whether any of the scene's lights has contact shadows enabled, so that
+    // hasContactShadows() doesn't have to walk the light array
+    auto const lightHasContactShadows = [&lcm](auto const& instances) {
+        auto const& [li, ti] = instances;
+        return bool(li) && lcm.getShadowOptions(li).screenSpaceContactShadows;
+    };
+    mHasLightContactShadows = lightHasContactShadows(mGatheredDirectionalLight) ||
+            std::any_of(lightInstances.begin(), lightInstances.end(), lightHasContactShadows);
+
     // some elements past the end of the array will be accessed by SIMD code, we need to make
     // sure the data is valid enough as not to produce errors such as divide-by-zero
     // (e.g. in computeLightRanges())
@@ -311,19 +504,7 @@ void FScene::prepare(utils::JobSystem& js,
         new(lightData.data<POSITION_RADIUS>() + i) float4{ 0, 0, 0, 1 };
     }
 
-    // Purely for the benefit of MSAN, we can avoid uninitialized reads by zeroing out the
-    // unused scene elements between the end of the array and the rounded-up count.
-    if (UTILS_HAS_SANITIZE_MEMORY) {
-        for (size_t i = sceneData.size(), e = sceneData.capacity(); i < e; i++) {
-            sceneData.data<LAYERS>()[i] = 0;
-            sceneData.data<VISIBLE_MASK>()[i] = 0;
-            sceneData.data<VISIBILITY_STATE>()[i] = {};
-        }
-    }
-
     js.runAndWait(rootJob);
-
-    SYSTRACE_NAME_END();
 }
 
 void FScene::prepareVisibleRenderables(Range<uint32_t> visibleRenderables) noexcept {
@@ -331,13 +512,21 @@ void FScene::prepareVisibleRenderables(Range<uint32_t> visibleRenderables) noexc
     RenderableSoa& sceneData = mRenderableData;
     FRenderableManager const& rcm = mEngine.getRenderableManager();
 
-    mHasContactShadows = false;
-    for (uint32_t const i : visibleRenderables) {
-        PerRenderableData& uboData = sceneData.elementAt<UBO>(i);
-
-        auto const visibility = sceneData.elementAt<VISIBILITY_STATE>(i);
-        auto const& model = sceneData.elementAt<WORLD_TRANSFORM>(i);
-        auto const ri = sceneData.elementAt<RENDERABLE_INSTANCE>(i);
+    // this loop streams several unrelated columns per renderable, more than the hardware
+    // prefetchers track, so declare them as a group and let the SoA prefetch ahead
+    bool hasContactShadows = false;
+    sceneData.forEachGroup<UBO, VISIBILITY_STATE, WORLD_TRANSFORM, RENDERABLE_INSTANCE,
+            INSTANCES, CHANNELS, MORPHING_BUFFER, USER_DATA>(
+            visibleRenderables.first, visibleRenderables.last,
+            [&rcm, &hasContactShadows](size_t,
+                    PerRenderableData& uboData,
+                    auto const& visibility,
+                    mat4f const& model,
+                    auto const ri,
+                    auto const& instances,
+                    uint8_t const channels,
+                    auto const& morphing,
+                    float const userData) {
 
         // Using mat3f::getTransformForNormals handles non-uniform scaling, but DOESN'T guarantee that
         // the transformed normals will have unit-length, therefore they need to be normalized
@@ -368,18 +557,19 @@ void FScene::prepareVisibleRenderables(Range<uint32_t> visibleRenderables) noexc
                 visibility.skinning,
                 visibility.morphing,
                 visibility.screenSpaceContactShadows,
-                sceneData.elementAt<INSTANCES>(i).buffer != nullptr,
-                sceneData.elementAt<CHANNELS>(i));
+                instances.buffer != nullptr,
+                channels);
 
-        uboData.morphTargetCount = sceneData.elementAt<MORPHING_BUFFER>(i).count;
+        uboData.morphTargetCount = morphing.count;
 
         uboData.objectId = rcm.getEntity(ri).getId();
 
         // TODO: We need to find a better way to provide the scale information per object
-        uboData.userData = sceneData.elementAt<USER_DATA>(i);
+        uboData.userData = userData;
 
-        mHasContactShadows = mHasContactShadows || visibility.screenSpaceContactShadows;
-    }
+        hasContactShadows = hasContactShadows || visibility.screenSpaceContactShadows;
+    });
+    mHasContactShadows = hasContactShadows;
 }
 
 void FScene::updateUBOs(
@@ -534,19 +724,44 @@ inline void FScene::computeLightRanges(
     }
 }
 
+UTILS_NOINLINE
+FScene::Partition& FScene::getOrCreatePartition(uint32_t const id) {
+    auto& partitions = mPartitions;
+    auto pos = std::find_if(partitions.begin(), partitions.end(),
+            [id](Partition const& partition) { return partition.id == id; });
+    if (pos == partitions.end()) {
+        partitions.push_back({ id, {} });
+        return partitions.back();
+    }
+    return *pos;
+}
+
 UTILS_NOINLINE
 void FScene::addEntity(Entity entity) {
-    mEntities.insert(entity);
+    mVersion++;
+    getOrCreatePartition(DEFAULT_PARTITION).entities.insert(entity);
 }
 
 UTILS_NOINLINE
 void FScene::addEntities(const Entity* entities, size_t count) {
-    mEntities.insert(entities, entities + count);
+    mVersion++;
+    getOrCreatePartition(DEFAULT_PARTITION).entities.insert(entities, entities + count);
+}
+
+UTILS_NOINLINE
+void FScene::addEntities(const Entity* entities, size_t count, uint32_t partition) {
+    mVersion++;
+    getOrCreatePartition(partition).entities.insert(entities, entities + count);
 }
 
 UTILS_NOINLINE
 void FScene::remove(Entity entity) {
-    mEntities.erase(entity);
+    for (Partition& partition: mPartitions) {
+        if (partition.entities.erase(entity)) {
+            mVersion++;
+            return;
+        }
+    }
 }
 
 UTILS_NOINLINE
@@ -556,15 +771,28 @@ void FScene::removeEntities(const Entity* entities, size_t count) {
     }
 }
 
+UTILS_NOINLINE
+void FScene::removePartition(uint32_t const partition) {
+    auto& partitions = mPartitions;
+    auto pos = std::find_if(partitions.begin(), partitions.end(),
+            [partition](Partition const& p) { return p.id == partition; });
+    if (pos != partitions.end()) {
+        // the partition's entities go away all at once, the rest of the scene is untouched
+        mVersion++;
+        partitions.erase(pos);
+    }
+}
+
 UTILS_NOINLINE
 size_t FScene::getRenderableCount() const noexcept {
     FEngine& engine = mEngine;
     EntityManager const& em = engine.getEntityManager();
     FRenderableManager const& rcm = engine.getRenderableManager();
     size_t count = 0;
-    auto const& entities = mEntities;
-    for (Entity const e : entities) {
-        count += em.isAlive(e) && rcm.getInstance(e) ? 1 : 0;
+    for (auto const& partition: mPartitions) {
+        for (Entity const e: partition.entities) {
+            count += em.isAlive(e) && rcm.getInstance(e) ? 1 : 0;
+        }
     }
     return count;
 }
@@ -575,16 +803,22 @@ size_t FScene::getLightCount() const noexcept {
     EntityManager const& em = engine.getEntityManager();
     FLightManager const& lcm = engine.getLightManager();
     size_t count = 0;
-    auto const& entities = mEntities;
-    for (Entity const e : entities) {
-        count += em.isAlive(e) && lcm.getInstance(e) ? 1 : 0;
+    for (auto const& partition: mPartitions) {
+        for (Entity const e: partition.entities) {
+            count += em.isAlive(e) && lcm.getInstance(e) ? 1 : 0;
+        }
     }
     return count;
 }
 
 UTILS_NOINLINE
 bool FScene::hasEntity(Entity entity) const noexcept {
-    return mEntities.find(entity) != mEntities.end();
+    for (auto const& partition: mPartitions) {
+        if (partition.entities.find(entity) != partition.entities.end()) {
+            return true;
+        }
+    }
+    return false;
 }
 
 UTILS_NOINLINE
@@ -599,32 +833,19 @@ void FScene::setSkybox(FSkybox* skybox) noexcept {
 }
 
 bool FScene::hasContactShadows() const noexcept {
-    // at least some renderables in the scene must have contact-shadows enabled
+    // at least some renderables and at least one light in the scene must have
+    // contact-shadows enabled; both bits are cached in prepare()
     // TODO: we should refine this with only the visible ones
-    if (!mHasContactShadows) {
-        return false;
-    }
-
-    // find out if at least one light has contact-shadow enabled
-    // TODO: we could cache the result of this Loop in the LightManager
-    auto& lcm = mEngine.getLightManager();
-    const auto *pFirst = mLightData.begin<LIGHT_INSTANCE>();
-    const auto *pLast = mLightData.end<LIGHT_INSTANCE>();
-    while (pFirst != pLast) {
-        if (pFirst->isValid()) {
-            auto const& shadowOptions = lcm.getShadowOptions(*pFirst);
-            if (shadowOptions.screenSpaceContactShadows) {
-                return true;
-            }
-        }
-        ++pFirst;
-    }
-    return false;
+    return mHasContactShadows && mHasLightContactShadows;
 }
 
 UTILS_NOINLINE
 void FScene::forEach(Invocable<void(Entity)>&& functor) const noexcept {
-    std::for_each(mEntities.begin(), mEntities.end(), std::move(functor));
+    for (auto const& partition: mPartitions) {
+        for (Entity const e: partition.entities) {
+            functor(e);
+        }
+    }
 }
 
 } // namespace filament
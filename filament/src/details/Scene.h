@@ -31,6 +31,8 @@
 #include <filament/Box.h>
 #include <filament/Scene.h>
 
+#include <math/mat4.h>
+
 #include <utils/compiler.h>
 #include <utils/Entity.h>
 #include <utils/Slice.h>
@@ -43,6 +45,8 @@
 #include <tsl/robin_set.h>
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace filament {
 
@@ -189,15 +193,34 @@ public:
 
     bool hasContactShadows() const noexcept;
 
+    // Incremented whenever the scene's content changes (entities added or removed); lets
+    // FView detect that culling inputs are unchanged (see FView's culling cache).
+    uint32_t getVersion() const noexcept { return mVersion; }
+
+    // Whether mRenderableData's rows are still in the order prepare() built them in.
+    // FView::prepare() permutes the rows when it partitions them by visibility, which
+    // invalidates positional snapshots of the SoA (e.g. FView's culling cache) -- but not
+    // the rows themselves, which are self-contained.
+    bool isRenderableDataInCanonicalOrder() const noexcept { return mRenderableDataCanonicalOrder; }
+    void markRenderableDataReordered() noexcept { mRenderableDataCanonicalOrder = false; }
+
 private:
     friend class Scene;
     void setSkybox(FSkybox* skybox) noexcept;
     void setIndirectLight(FIndirectLight* ibl) noexcept { mIndirectLight = ibl; }
     void addEntity(utils::Entity entity);
     void addEntities(const utils::Entity* entities, size_t count);
+    void addEntities(const utils::Entity* entities, size_t count, uint32_t partition);
     void remove(utils::Entity entity);
     void removeEntities(const utils::Entity* entities, size_t count);
-    size_t getEntityCount() const noexcept { return mEntities.size(); }
+    void removePartition(uint32_t partition);
+    size_t getEntityCount() const noexcept {
+        size_t count = 0;
+        for (auto const& partition: mPartitions) {
+            count += partition.entities.size();
+        }
+        return count;
+    }
     size_t getRenderableCount() const noexcept;
     size_t getLightCount() const noexcept;
     bool hasEntity(utils::Entity entity) const noexcept;
@@ -206,16 +229,53 @@ private:
     static inline void computeLightRanges(math::float2* zrange,
             CameraInfo const& camera, const math::float4* spheres, size_t count) noexcept;
 
+    // whether the previous prepare()'s output can be reused as-is (same frame, same
+    // parameters, nothing changed in the relevant component managers)
+    bool isPreparedDataReusable(math::mat4 const& worldTransform,
+            bool shadowReceiversAreCasters) const noexcept;
+
+    // (re)builds mLightData from the light instances gathered by the last prepare()
+    void prepareLightData(utils::JobSystem& js, math::mat4 const& worldTransform) noexcept;
+
     FEngine& mEngine;
     FSkybox* mSkybox = nullptr;
     FIndirectLight* mIndirectLight = nullptr;
 
     /*
-     * list of Entities in the scene. We use a robin_set<> so we can do efficient removes
-     * (a vector<> could work, but removes would be O(n)). robin_set<> iterates almost as
-     * nicely as vector<>, which is a good compromise.
+     * Entities in the scene, grouped by partition. We use a robin_set<> per partition so we
+     * can do efficient removes (a vector<> could work, but removes would be O(n)).
+     * Partitions let a streamer add and remove whole world chunks at once, and because a
+     * partition's entities stay contiguous when the RenderableSoa is built in prepare(),
+     * culling can reject whole chunks by bounds before the per-renderable tests.
+     * Entities added without a partition id go to partition DEFAULT_PARTITION (0).
+     */
+    static constexpr uint32_t DEFAULT_PARTITION = 0;
+    struct Partition {
+        uint32_t id;
+        tsl::robin_set<utils::Entity, utils::Entity::Hasher> entities;
+    };
+    Partition& getOrCreatePartition(uint32_t id);
+    std::vector<Partition> mPartitions;
+    uint32_t mVersion = 0;
+
+    /*
+     * Scene-level output of prepare() and the parameters it ran with. When the same scene
+     * is rendered from several views within one frame (e.g. main view + planar reflection),
+     * prepare() can keep mRenderableData as-is and only rebuild mLightData -- the views
+     * truncate the light SoA during per-view light culling -- from the gathered instances
+     * saved here.
      */
-    tsl::robin_set<utils::Entity, utils::Entity::Hasher> mEntities;
+    using LightGatherData = std::pair<LightManager::Instance, TransformManager::Instance>;
+    std::vector<LightGatherData> mGatheredLightInstances;
+    LightGatherData mGatheredDirectionalLight{};
+    math::mat4 mPreparedWorldTransform;
+    uint32_t mPreparedFrameEpoch = 0;
+    uint32_t mPreparedSceneVersion = 0;
+    uint32_t mPreparedTransformVersion = 0;
+    uint32_t mPreparedRenderableVersion = 0;
+    bool mPreparedShadowReceiversAreCasters = false;
+    bool mPreparedDataValid = false;
+    bool mRenderableDataCanonicalOrder = false;
 
 
     /*
@@ -228,6 +288,7 @@ private:
     LightSoa mLightData;
     backend::Handle<backend::HwBufferObject> mRenderableViewUbh; // This is actually owned by the view.
     bool mHasContactShadows = false;
+    bool mHasLightContactShadows = false;
 
     // State shared between Scene and driver callbacks.
     struct SharedState {
@@ -27,6 +27,8 @@
 #include <math/half.h>
 #include <math/mat4.h>
 
+#include <utils/Hash.h>
+
 #include <cstring>
 
 namespace filament {
@@ -94,6 +96,27 @@ void FSkinningBuffer::terminate(FEngine& engine) {
     driver.destroyBufferObject(mHandle);
 }
 
+// Returns true if the palette at [offset, offset + count) is identical to what was uploaded
+// there last, in which case the upload (and the bone data conversion) can be skipped; this is
+// the common case for the idle skeletons of a pooled crowd.
+template<typename T>
+bool FSkinningBuffer::isPaletteUnchanged(T const* transforms, size_t count, size_t offset) noexcept {
+    static_assert((sizeof(T) & 3u) == 0, "hashing requires a size that is a multiple of 4");
+    if (UTILS_UNLIKELY(count == 0)) {
+        return true;
+    }
+    size_t const wordCount = count * sizeof(T) / 4;
+    uint64_t const hash = (uint64_t(utils::hash::murmur3(
+                    (uint32_t const*)transforms, wordCount, 0)) << 32u) |
+            utils::hash::murmur3((uint32_t const*)transforms, wordCount, 0x5bd1e995u);
+    auto& entry = mPaletteHashes[uint32_t(offset)];
+    if (entry.count == count && entry.hash == hash) {
+        return true;
+    }
+    entry = { uint32_t(count), hash };
+    return false;
+}
+
 void FSkinningBuffer::setBones(FEngine& engine,
         RenderableManager::Bone const* transforms, size_t count, size_t offset) {
 
@@ -101,6 +124,10 @@ void FSkinningBuffer::setBones(FEngine& engine,
             "SkinningBuffer (size=%lu) overflow (boneCount=%u, offset=%u)",
             (unsigned)mBoneCount, (unsigned)count, (unsigned)offset);
 
+    if (isPaletteUnchanged(transforms, count, offset)) {
+        return;
+    }
+
     setBones(engine, mHandle, transforms, count, offset);
 }
 
@@ -111,6 +138,10 @@ void FSkinningBuffer::setBones(FEngine& engine,
             "SkinningBuffer (size=%lu) overflow (boneCount=%u, offset=%u)",
             (unsigned)mBoneCount, (unsigned)count, (unsigned)offset);
 
+    if (isPaletteUnchanged(transforms, count, offset)) {
+        return;
+    }
+
     setBones(engine, mHandle, transforms, count, offset);
 }
 
@@ -247,8 +278,9 @@ FSkinningBuffer::HandleIndicesAndWeights FSkinningBuffer::createIndicesAndWeight
     SamplerGroup samplerGroup(PerRenderPrimitiveSkinningSib::SAMPLER_COUNT);
     samplerGroup.setSampler(PerRenderPrimitiveSkinningSib::BONE_INDICES_AND_WEIGHTS,
             { textureHandle, {}});
+    uint64_t const dirtyMask = samplerGroup.getDirtyMask();
     driver.updateSamplerGroup(samplerHandle,
-            samplerGroup.toBufferDescriptor(driver));
+            samplerGroup.toBufferDescriptor(driver), dirtyMask);
     return {
             .sampler = samplerHandle,
             .texture = textureHandle
@@ -30,6 +30,8 @@
 #include <utils/compiler.h>
 #include <math/vec2.h>
 
+#include <tsl/robin_map.h>
+
 // for gtest
 class FilamentTest_Bones_Test;
 
@@ -49,6 +51,11 @@ public:
     void setBones(FEngine& engine, math::mat4f const* transforms, size_t count, size_t offset);
     size_t getBoneCount() const noexcept { return mBoneCount; }
 
+    // estimated video memory used by this skinning buffer, in bytes
+    size_t getEstimatedSizeInBytes() const noexcept {
+        return getPhysicalBoneCount(mBoneCount) * sizeof(PerRenderableBoneUib::BoneData);
+    }
+
     // round count to the size of the UBO in the shader
     static size_t getPhysicalBoneCount(size_t count) noexcept {
         static_assert((CONFIG_MAX_BONE_COUNT & (CONFIG_MAX_BONE_COUNT - 1)) == 0);
@@ -86,8 +93,19 @@ private:
           const utils::FixedCapacityVector<math::float2>& pairs,
           size_t count);
 
+    // Hash of the palette last uploaded at a given bone offset. Apps that pool many
+    // skeletons in a single SkinningBuffer re-set every palette each frame; this lets
+    // setBones() skip the upload entirely when a palette is unchanged (idle skeletons).
+    struct PaletteHash {
+        uint32_t count = 0;
+        uint64_t hash = 0;
+    };
+    template<typename T>
+    bool isPaletteUnchanged(T const* transforms, size_t count, size_t offset) noexcept;
+
     backend::Handle<backend::HwBufferObject> mHandle;
     uint32_t mBoneCount;
+    tsl::robin_map<uint32_t, PaletteHash> mPaletteHashes;
 };
 
 FILAMENT_DOWNCAST(SkinningBuffer)
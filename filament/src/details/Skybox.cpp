@@ -120,11 +120,11 @@ FMaterial const* FSkybox::createMaterial(FEngine& engine) {
     Material::Builder builder;
 #ifdef FILAMENT_ENABLE_FEATURE_LEVEL_0
     if (UTILS_UNLIKELY(engine.getActiveFeatureLevel() == Engine::FeatureLevel::FEATURE_LEVEL_0)) {
-        builder.package(MATERIALS_SKYBOX0_DATA, MATERIALS_SKYBOX0_SIZE);
+        builder.trustedPackage(MATERIALS_SKYBOX0_DATA, MATERIALS_SKYBOX0_SIZE);
     } else
 #endif
     {
-        builder.package(MATERIALS_SKYBOX_DATA, MATERIALS_SKYBOX_SIZE);
+        builder.trustedPackage(MATERIALS_SKYBOX_DATA, MATERIALS_SKYBOX_SIZE);
     }
     auto material = builder.build(engine);
     return downcast(material);
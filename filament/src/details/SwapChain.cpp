@@ -58,6 +58,14 @@ void FSwapChain::setFrameCompletedCallback(backend::CallbackHandler* handler,
     }
 }
 
+int32_t FSwapChain::getExportedImageFd(size_t index) noexcept {
+    return mEngine.getDriverApi().getSwapChainImageFd(mSwapChain, uint32_t(index));
+}
+
+uint64_t FSwapChain::getFrameLatencyNanos() noexcept {
+    return mEngine.getDriverApi().getFrameLatencyNanos(mSwapChain);
+}
+
 bool FSwapChain::isSRGBSwapChainSupported(FEngine& engine) noexcept {
     return engine.getDriverApi().isSRGBSwapChainSupported();
 }
@@ -66,6 +66,10 @@ public:
       return mSwapChain;
     }
 
+    int32_t getExportedImageFd(size_t index) noexcept;
+
+    uint64_t getFrameLatencyNanos() noexcept;
+
     void setFrameScheduledCallback(FrameScheduledCallback callback, void* user);
 
     void setFrameCompletedCallback(backend::CallbackHandler* handler,
@@ -220,6 +220,7 @@ FTexture::FTexture(FEngine& engine, const Builder& builder) {
 
 // frees driver resources, object becomes invalid
 void FTexture::terminate(FEngine& engine) {
+    engine.cancelMipmapGeneration(mHandle);
     FEngine::DriverApi& driver = engine.getDriverApi();
     driver.destroyTexture(mHandle);
 }
@@ -420,6 +421,80 @@ void FTexture::generateMipmaps(FEngine& engine) const noexcept {
     engine.getDriverApi().generateMipmaps(mHandle);
 }
 
+void FTexture::copyTo(FEngine& engine, FTexture* dst,
+        size_t dstLevel, uint32_t dstLayer, uint32_t dstX, uint32_t dstY,
+        size_t srcLevel, uint32_t srcLayer, uint32_t srcX, uint32_t srcY,
+        uint32_t width, uint32_t height) const {
+
+    ASSERT_PRECONDITION(dst, "destination Texture is null");
+
+    ASSERT_PRECONDITION(dst->mFormat == mFormat,
+            "source (%u) and destination (%u) texture formats don't match",
+            unsigned(mFormat), unsigned(dst->mFormat));
+
+    ASSERT_PRECONDITION(!isCompressed() && !dst->isCompressed(),
+            "copyTo() does not support compressed formats.");
+
+    ASSERT_PRECONDITION(mSampleCount <= 1 && dst->mSampleCount <= 1,
+            "copyTo() does not support multisample textures, use Renderer::resolve() instead.");
+
+    ASSERT_PRECONDITION(any(mUsage & Usage::BLIT_SRC),
+            "source texture was not created with TextureUsage::BLIT_SRC");
+
+    ASSERT_PRECONDITION(any(dst->mUsage & Usage::BLIT_DST),
+            "destination texture was not created with TextureUsage::BLIT_DST");
+
+    ASSERT_PRECONDITION(srcLevel < mLevelCount,
+            "srcLevel=%u is >= to levelCount=%u.", unsigned(srcLevel), unsigned(mLevelCount));
+
+    ASSERT_PRECONDITION(dstLevel < dst->mLevelCount,
+            "dstLevel=%u is >= to levelCount=%u.", unsigned(dstLevel), unsigned(dst->mLevelCount));
+
+    ASSERT_PRECONDITION(srcX + width <= valueForLevel(srcLevel, mWidth) &&
+            srcY + height <= valueForLevel(srcLevel, mHeight),
+            "source region [%u, %u) x [%u, %u) is out of bounds at level %u",
+            unsigned(srcX), unsigned(srcX + width),
+            unsigned(srcY), unsigned(srcY + height), unsigned(srcLevel));
+
+    ASSERT_PRECONDITION(dstX + width <= valueForLevel(dstLevel, dst->mWidth) &&
+            dstY + height <= valueForLevel(dstLevel, dst->mHeight),
+            "destination region [%u, %u) x [%u, %u) is out of bounds at level %u",
+            unsigned(dstX), unsigned(dstX + width),
+            unsigned(dstY), unsigned(dstY + height), unsigned(dstLevel));
+
+    if (width == 0 || height == 0) {
+        return;
+    }
+
+    engine.getDriverApi().blit(
+            dst->mHandle, uint8_t(dstLevel), uint8_t(dstLayer), { dstX, dstY },
+            mHandle, uint8_t(srcLevel), uint8_t(srcLayer), { srcX, srcY },
+            { width, height });
+}
+
+void FTexture::generateMipmapsAsync(FEngine& engine,
+        utils::Invocable<void()>&& callback) const noexcept {
+    ASSERT_PRECONDITION(mTarget != SamplerType::SAMPLER_EXTERNAL,
+            "External Textures are not mipmappable.");
+
+    ASSERT_PRECONDITION(mTarget != SamplerType::SAMPLER_3D,
+            "3D Textures are not mipmappable.");
+
+    const bool formatMipmappable = engine.getDriverApi().isTextureFormatMipmappable(mFormat);
+    ASSERT_PRECONDITION(formatMipmappable,
+            "Texture format %u is not mipmappable.", (unsigned)mFormat);
+
+    if (mLevelCount < 2 || (mWidth == 1 && mHeight == 1)) {
+        // there is nothing to generate, the request completes immediately
+        if (callback) {
+            callback();
+        }
+        return;
+    }
+
+    engine.scheduleMipmapGeneration(mHandle, std::move(callback));
+}
+
 bool FTexture::isTextureFormatSupported(FEngine& engine, InternalFormat format) noexcept {
     return engine.getDriverApi().isTextureFormatSupported(format);
 }
@@ -437,6 +512,37 @@ size_t FTexture::getFormatSize(InternalFormat format) noexcept {
     return backend::getFormatSize(format);
 }
 
+size_t FTexture::getEstimatedSizeInBytes() const noexcept {
+    if (mTarget == SamplerType::SAMPLER_EXTERNAL) {
+        // external images are not allocated by the engine
+        return 0;
+    }
+
+    size_t layers;
+    switch (mTarget) {
+        case SamplerType::SAMPLER_EXTERNAL:     // handled above, fallthrough...
+        case SamplerType::SAMPLER_2D:
+        case SamplerType::SAMPLER_3D:           layers = 1;          break;
+        case SamplerType::SAMPLER_2D_ARRAY:     layers = mDepth;     break;
+        case SamplerType::SAMPLER_CUBEMAP:      layers = 6;          break;
+        case SamplerType::SAMPLER_CUBEMAP_ARRAY:layers = mDepth * 6; break;
+    }
+
+    size_t bytes = 0;
+    for (size_t level = 0; level < mLevelCount; level++) {
+        size_t const pixels = valueForLevel(level, mWidth) * valueForLevel(level, mHeight)
+                * (mTarget == SamplerType::SAMPLER_3D ? valueForLevel(level, mDepth) : 1);
+        bytes += pixels * layers;
+    }
+
+    // getFormatSize() returns the size of a 4x4 block for compressed formats; the estimate
+    // below assumes 4x4 blocks for all of them, which is close enough for accounting purposes.
+    size_t const formatSize = getFormatSize(mFormat);
+    bytes = isCompressed() ? bytes * formatSize / 16u : bytes * formatSize;
+
+    return bytes * std::max(size_t(1), size_t(mSampleCount));
+}
+
 
 void FTexture::generatePrefilterMipmap(FEngine& engine,
         PixelBufferDescriptor&& buffer, const FaceOffsets& faceOffsets,
@@ -47,6 +47,9 @@ public:
     InternalFormat getFormat() const noexcept { return mFormat; }
     Usage getUsage() const noexcept { return mUsage; }
 
+    // estimated video memory used by this texture in bytes, all levels and layers included
+    size_t getEstimatedSizeInBytes() const noexcept;
+
     void setImage(FEngine& engine, size_t level,
             uint32_t xoffset, uint32_t yoffset, uint32_t zoffset,
             uint32_t width, uint32_t height, uint32_t depth,
@@ -65,6 +68,12 @@ public:
     void setExternalStream(FEngine& engine, FStream* stream) noexcept;
 
     void generateMipmaps(FEngine& engine) const noexcept;
+    void copyTo(FEngine& engine, FTexture* dst,
+            size_t dstLevel, uint32_t dstLayer, uint32_t dstX, uint32_t dstY,
+            size_t srcLevel, uint32_t srcLayer, uint32_t srcX, uint32_t srcY,
+            uint32_t width, uint32_t height) const;
+    void generateMipmapsAsync(FEngine& engine,
+            utils::Invocable<void()>&& callback) const noexcept;
 
     void setSampleCount(size_t sampleCount) noexcept { mSampleCount = uint8_t(sampleCount); }
     size_t getSampleCount() const noexcept { return mSampleCount; }
@@ -21,11 +21,15 @@
 
 #include "FilamentAPI-impl.h"
 
+#include <math/half.h>
+#include <math/norm.h>
 #include <math/quat.h>
 #include <math/vec2.h>
 
 #include <utils/Panic.h>
 
+#include <algorithm>
+
 namespace filament {
 
 using namespace backend;
@@ -38,6 +42,7 @@ struct VertexBuffer::BuilderDetails {
     uint8_t mBufferCount = 0;
     bool mBufferObjectsEnabled = false;
     bool mAdvancedSkinningEnabled = false; // TODO: use bits to save memory
+    bool mQuantizeAttributes = false;
 };
 
 using BuilderType = VertexBuffer;
@@ -114,6 +119,11 @@ VertexBuffer::Builder& VertexBuffer::Builder::normalized(VertexAttribute attribu
     return *this;
 }
 
+VertexBuffer::Builder& VertexBuffer::Builder::quantizeAttributes(bool enabled) noexcept {
+    mImpl->mQuantizeAttributes = enabled;
+    return *this;
+}
+
 VertexBuffer::Builder& VertexBuffer::Builder::advancedSkinning(bool enabled) noexcept {
     mImpl->mAdvancedSkinningEnabled = enabled;
     return *this;
@@ -139,9 +149,30 @@ VertexBuffer* VertexBuffer::Builder::build(Engine& engine) {
     ASSERT_PRECONDITION(attributedBuffers.count() == mImpl->mBufferCount,
             "At least one buffer slot was never assigned to an attribute.");
 
+    ASSERT_PRECONDITION(!(mImpl->mQuantizeAttributes && mImpl->mBufferObjectsEnabled),
+            "quantizeAttributes is incompatible with enableBufferObjects");
+
     return downcast(engine).createVertexBuffer(*this);
 }
 
+VertexBuffer::AttributeType VertexBuffer::getQuantizedAttributeType(VertexAttribute attribute,
+        AttributeType type) noexcept {
+    switch (attribute) {
+        case VertexAttribute::POSITION:
+            return (type == AttributeType::FLOAT3 || type == AttributeType::FLOAT4) ?
+                    AttributeType::HALF4 : type;
+        case VertexAttribute::TANGENTS:
+            return type == AttributeType::FLOAT4 ? AttributeType::SHORT4 : type;
+        case VertexAttribute::COLOR:
+            return type == AttributeType::FLOAT4 ? AttributeType::UBYTE4 : type;
+        case VertexAttribute::UV0:
+        case VertexAttribute::UV1:
+            return type == AttributeType::FLOAT2 ? AttributeType::HALF2 : type;
+        default:
+            return type;
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 
 FVertexBuffer::FVertexBuffer(FEngine& engine, const VertexBuffer::Builder& builder)
@@ -184,6 +215,55 @@ FVertexBuffer::FVertexBuffer(FEngine& engine, const VertexBuffer::Builder& build
         mBufferCount++;
     }
 
+    if (builder->mQuantizeAttributes) {
+        // Repack each buffer slot containing at least one attribute that quantizes to a more
+        // compact type. The attributes keep their relative memory order but become tightly
+        // interleaved, since the offsets and strides declared by the client assume float data.
+        // The declared layout is recorded in mQuantizationPlan so that setBufferAt() can
+        // convert incoming data. All quantized element sizes are multiples of 4 bytes, so the
+        // recomputed offsets preserve alignment.
+        for (uint8_t slot = 0; slot < MAX_VERTEX_BUFFER_COUNT; ++slot) {
+            uint8_t slotAttributes[MAX_VERTEX_ATTRIBUTE_COUNT];
+            size_t attributeCountInSlot = 0;
+            bool hasQuantizableAttribute = false;
+            for (uint8_t i = 0; i < MAX_VERTEX_ATTRIBUTE_COUNT; ++i) {
+                if (mDeclaredAttributes[i] && mAttributes[i].buffer == slot) {
+                    slotAttributes[attributeCountInSlot++] = i;
+                    hasQuantizableAttribute = hasQuantizableAttribute ||
+                            getQuantizedAttributeType((VertexAttribute)i, mAttributes[i].type)
+                                    != mAttributes[i].type;
+                }
+            }
+            if (!hasQuantizableAttribute) {
+                continue;
+            }
+            std::sort(slotAttributes, slotAttributes + attributeCountInSlot,
+                    [this](uint8_t a, uint8_t b) {
+                        return mAttributes[a].offset < mAttributes[b].offset;
+                    });
+            uint32_t offset = 0;
+            for (size_t k = 0; k < attributeCountInSlot; ++k) {
+                AttributeData& entry = mAttributes[slotAttributes[k]];
+                mQuantizationPlan.push_back({ slotAttributes[k], slot,
+                        entry.type, entry.stride, entry.offset });
+                const ElementType quantized = getQuantizedAttributeType(
+                        (VertexAttribute)slotAttributes[k], entry.type);
+                if (quantized != entry.type) {
+                    entry.type = quantized;
+                    if (quantized == ElementType::SHORT4 || quantized == ElementType::UBYTE4) {
+                        entry.flags |= Attribute::FLAG_NORMALIZED;
+                    }
+                }
+                entry.offset = offset;
+                offset += Driver::getElementTypeSize(entry.type);
+            }
+            for (size_t k = 0; k < attributeCountInSlot; ++k) {
+                mAttributes[slotAttributes[k]].stride = (uint8_t)offset;
+            }
+            mQuantizedStrides[slot] = (uint8_t)offset;
+        }
+    }
+
     size_t bufferSizes[MAX_VERTEX_BUFFER_COUNT] = {};
 
     auto const& declaredAttributes = mDeclaredAttributes;
@@ -255,11 +335,86 @@ size_t FVertexBuffer::getVertexCount() const noexcept {
     return mVertexCount;
 }
 
+size_t FVertexBuffer::getEstimatedSizeInBytes() const noexcept {
+    if (mBufferObjectsEnabled) {
+        // the storage belongs to user-supplied BufferObjects
+        return 0;
+    }
+    // attributes interleaved in the same buffer slot share the slot's stride, so the slot's
+    // size is its stride times the vertex count
+    std::array<uint8_t, backend::MAX_VERTEX_BUFFER_COUNT> strides = {};
+    mDeclaredAttributes.forEachSetBit([&](size_t i) {
+        auto const& attribute = mAttributes[i];
+        strides[attribute.buffer] = std::max(strides[attribute.buffer], attribute.stride);
+    });
+    size_t bytes = 0;
+    for (size_t i = 0; i < mBufferCount; i++) {
+        bytes += strides[i] * mVertexCount;
+    }
+    return bytes;
+}
+
+backend::BufferDescriptor FVertexBuffer::quantizeBuffer(uint8_t bufferIndex,
+        backend::BufferDescriptor const& buffer) const noexcept {
+    size_t const dstStride = mQuantizedStrides[bufferIndex];
+    uint8_t* const dstBase = (uint8_t*)malloc(dstStride * mVertexCount);
+    uint8_t const* const srcBase = (uint8_t const*)buffer.buffer;
+    for (auto const& entry : mQuantizationPlan) {
+        if (entry.buffer != bufferIndex) {
+            continue;
+        }
+        Attribute const& dst = mAttributes[entry.attribute];
+        size_t const srcSize = Driver::getElementTypeSize(entry.sourceType);
+        size_t count = 0;
+        if (buffer.size >= entry.sourceOffset + srcSize) {
+            count = std::min(size_t(mVertexCount),
+                    (buffer.size - entry.sourceOffset - srcSize) / entry.sourceStride + 1);
+        }
+        for (size_t i = 0; i < count; i++) {
+            uint8_t const* const src = srcBase + entry.sourceOffset + i * entry.sourceStride;
+            uint8_t* const out = dstBase + dst.offset + i * dstStride;
+            if (dst.type == entry.sourceType) {
+                memcpy(out, src, srcSize);
+                continue;
+            }
+            // the w default makes FLOAT3 positions quantize to a well-formed HALF4
+            float4 v{ 0.0f, 0.0f, 0.0f, 1.0f };
+            memcpy(&v, src, srcSize);
+            switch (dst.type) {
+                case ElementType::HALF2:
+                    *reinterpret_cast<half2*>(out) = half2{ v.xy };
+                    break;
+                case ElementType::HALF4:
+                    *reinterpret_cast<half4*>(out) = half4{ v };
+                    break;
+                case ElementType::SHORT4:
+                    *reinterpret_cast<short4*>(out) = packSnorm16(v);
+                    break;
+                case ElementType::UBYTE4:
+                    *reinterpret_cast<ubyte4*>(out) = packUnorm8(v);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+    return { dstBase, dstStride * mVertexCount,
+            [](void* base, size_t, void*) { free(base); } };
+}
+
 void FVertexBuffer::setBufferAt(FEngine& engine, uint8_t bufferIndex,
         backend::BufferDescriptor&& buffer, uint32_t byteOffset) {
     ASSERT_PRECONDITION(!mBufferObjectsEnabled, "Please use setBufferObjectAt()");
     if (bufferIndex < mBufferCount) {
         assert_invariant(mBufferObjects[bufferIndex]);
+        if (UTILS_UNLIKELY(mQuantizedStrides[bufferIndex])) {
+            ASSERT_PRECONDITION(byteOffset == 0,
+                    "Partial updates are not supported with quantizeAttributes");
+            engine.getDriverApi().updateBufferObject(mBufferObjects[bufferIndex],
+                    quantizeBuffer(bufferIndex, buffer), 0);
+            // the source descriptor is released when it goes out of scope
+            return;
+        }
         engine.getDriverApi().updateBufferObject(mBufferObjects[bufferIndex],
                std::move(buffer), byteOffset);
     } else {
@@ -32,6 +32,7 @@
 #include <array>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 namespace filament {
 
@@ -57,6 +58,10 @@ public:
         return mDeclaredAttributes;
     }
 
+    // estimated video memory used by this vertex buffer in bytes; zero when the storage is
+    // provided by user BufferObjects, which are accounted separately
+    size_t getEstimatedSizeInBytes() const noexcept;
+
     // no-op if bufferIndex out of range
     void setBufferAt(FEngine& engine, uint8_t bufferIndex,
             backend::BufferDescriptor&& buffer, uint32_t byteOffset = 0);
@@ -74,9 +79,26 @@ private:
         AttributeData() : backend::Attribute{ .type = backend::ElementType::FLOAT4 } {}
     };
 
+    // Source layout of each attribute living in a repacked buffer slot, used to convert
+    // client-supplied float data when attribute quantization is enabled. The destination
+    // layout is held in mAttributes.
+    struct QuantizationEntry {
+        uint8_t attribute;
+        uint8_t buffer;
+        backend::ElementType sourceType;
+        uint8_t sourceStride;
+        uint32_t sourceOffset;
+    };
+
+    backend::BufferDescriptor quantizeBuffer(uint8_t bufferIndex,
+            backend::BufferDescriptor const& buffer) const noexcept;
+
     VertexBufferHandle mHandle;
     std::array<AttributeData, backend::MAX_VERTEX_ATTRIBUTE_COUNT> mAttributes;
     std::array<BufferObjectHandle, backend::MAX_VERTEX_BUFFER_COUNT> mBufferObjects;
+    std::vector<QuantizationEntry> mQuantizationPlan;
+    // Stride of each repacked buffer slot; zero means the slot is passed through untouched.
+    std::array<uint8_t, backend::MAX_VERTEX_BUFFER_COUNT> mQuantizedStrides = {};
     AttributeBitset mDeclaredAttributes;
     uint32_t mVertexCount = 0;
     uint8_t mBufferCount = 0;
@@ -43,6 +43,7 @@
 #include <math/scalar.h>
 #include <math/fast.h>
 
+#include <limits>
 #include <memory>
 
 using namespace utils;
@@ -55,6 +56,11 @@ using namespace math;
 static constexpr float PID_CONTROLLER_Ki = 0.002f;
 static constexpr float PID_CONTROLLER_Kd = 0.0f;
 
+// number of renderables culled as one group in cullRenderables(); must be a
+// multiple of Culler::MODULO
+static constexpr size_t CULLING_BLOCK_SIZE = 64;
+static_assert(CULLING_BLOCK_SIZE % Culler::MODULO == 0);
+
 FView::FView(FEngine& engine)
         : mFroxelizer(engine),
           mFogEntity(engine.getEntityManager().create()),
@@ -109,6 +115,14 @@ void FView::terminate(FEngine& engine) {
         FPickingQuery::put(pQuery);
     }
 
+    // in-flight occlusion depth readbacks are orphaned here and freed by their callback
+    for (OcclusionDepthReadback* r = mOcclusionReadbacksInFlight; r; r = r->next) {
+        r->view = nullptr;
+    }
+    mOcclusionReadbacksInFlight = nullptr;
+    delete mOcclusionDepth;
+    mOcclusionDepth = nullptr;
+
     DriverApi& driver = engine.getDriverApi();
     driver.destroyBufferObject(mLightUbh);
     driver.destroyBufferObject(mRenderableUbh);
@@ -183,11 +197,31 @@ float2 FView::updateScale(FEngine& engine,
         const float dt = 1.0f; // we don't really need dt here, setting it to 1, means our parameters are in "frames"
         const float target = (1000.0f * float(frameRateOptions.interval)) / displayInfo.refreshRate;
         const float targetWithHeadroom = target * (1.0f - frameRateOptions.headRoomRatio);
-        float const measured = duration<float, std::milli>{ info.denoisedFrameTime }.count();
-        float const out = mPidController.update(measured / targetWithHeadroom, 1.0f, dt);
+        float measured = duration<float, std::milli>{ info.denoisedFrameTime }.count();
+        float budget = targetWithHeadroom;
+        if (info.scaledValid) {
+            // model the frame as fixed overhead (e.g. shadow maps) plus resolution-sensitive
+            // work; only the latter responds to scaling, so the controller tracks it against
+            // whatever budget remains once the overhead is paid.
+            float const scaled = duration<float, std::milli>{ info.denoisedScaledFrameTime }.count();
+            float const overhead = std::max(measured - scaled, 0.0f);
+            measured = scaled;
+            // keep a fraction of the budget so the controller stays responsive even when the
+            // overhead alone blows the frame budget.
+            budget = std::max(targetWithHeadroom - overhead, targetWithHeadroom * 0.1f);
+        }
+        float const out = mPidController.update(measured / budget, 1.0f, dt);
 
         // maps pid command to a scale (absolute or relative, see below)
-         const float command = out < 0.0f ? (1.0f / (1.0f - out)) : (1.0f + out);
+        float command = out < 0.0f ? (1.0f / (1.0f - out)) : (1.0f + out);
+
+        // quality recovery schedule: only allow scaling back up after the GPU has been under
+        // budget for a few consecutive frames, this prevents oscillations around the target
+        // frame time ("resolution pumping").
+        mUnderBudgetFrameCount = measured <= budget ? mUnderBudgetFrameCount + 1 : 0;
+        if (command > 1.0f && mUnderBudgetFrameCount < options.upscaleHoldFrameCount) {
+            command = 1.0f; // hold the current scale
+        }
 
         /*
          * There is two ways we can control the scale factor, either by having the PID controller
@@ -418,11 +452,9 @@ CameraInfo FView::computeCameraInfo(FEngine& engine) const noexcept {
 
     FIndirectLight const* const ibl = scene->getIndirectLight();
     if (ibl) {
-        // the IBL transformation must be a rigid transform
-        rotation = mat3{ transpose(scene->getIndirectLight()->getRotation()) };
-        // it is important to orthogonalize the matrix when converting it to doubles, because
-        // as float, it only has about a 1e-8 precision on the size of the basis vectors
-        rotation = orthogonalize(rotation);
+        // cached by FIndirectLight, so views only pay for the double-precision
+        // orthogonalization when the rotation actually changed
+        rotation = ibl->getWorldRotation();
     }
     return { *camera, mat4{ rotation } * mat4::translation(translation) };
 }
@@ -441,8 +473,14 @@ void FView::prepare(FEngine& engine, DriverApi& driver, ArenaScope& arena,
      * and in particular their world-space AABB.
      */
 
-    auto getFrustum = [this, &cameraInfo]() -> Frustum {
+    auto getFrustum = [this, &engine, &cameraInfo]() -> Frustum {
         if (UTILS_LIKELY(mViewingCamera == nullptr)) {
+            if (UTILS_UNLIKELY(hasInstancedStereo())) {
+                // with instanced stereo, all eyes share this one culling pass, so we must
+                // cull against a frustum that covers every eye
+                return computeStereoCullingFrustum(cameraInfo,
+                        engine.getConfig().stereoscopicEyeCount);
+            }
             // In the common case when we don't have a viewing camera, cameraInfo.view is
             // already the culling view matrix
             return Frustum{ mat4f{ highPrecisionMultiply(cameraInfo.cullingProjection, cameraInfo.view) }};
@@ -501,10 +539,28 @@ void FView::prepare(FEngine& engine, DriverApi& driver, ArenaScope& arena,
         /*
          * Culling: as soon as possible we perform our camera-culling
          * (this will set the VISIBLE_RENDERABLE bit)
+         *
+         * A static view (tripod camera, nothing moving) produces the exact same result as
+         * the previous frame, in which case we replay last frame's snapshot instead of
+         * re-testing every renderable.
          */
 
-        prepareVisibleRenderables(js, cullingFrustum, renderableData);
+        if (!tryReuseCulling(engine, cameraInfo, cullingFrustum, renderableData)) {
+            prepareVisibleRenderables(js, cullingFrustum, renderableData);
+            updateCullingCache(engine, cameraInfo, cullingFrustum, renderableData);
+        }
 
+        /*
+         * Occlusion culling: renderables entirely hidden behind the depth read back from a
+         * previous frame lose their VISIBLE_RENDERABLE bit; the shadow-related bits are left
+         * alone, so occluded renderables still cast shadows. The test is skipped when a debug
+         * camera is set, because the depth buffer was rendered from a different point of view.
+         */
+        if (UTILS_UNLIKELY(mOcclusionCullingEnabled && mOcclusionDepth)) {
+            if (UTILS_LIKELY(mViewingCamera == nullptr)) {
+                applyOcclusionCulling(renderableData, *mOcclusionDepth);
+            }
+        }
 
         /*
          * Shadowing: compute the shadow camera and cull shadow casters
@@ -614,6 +670,10 @@ void FView::prepare(FEngine& engine, DriverApi& driver, ArenaScope& arena,
 
         mSpotLightShadowCasters = merged;
 
+        // the partitioning above permuted the SoA's rows; positional snapshots of it
+        // (e.g. the culling cache) are no longer usable until the next full rebuild
+        scene->markRenderableDataReordered();
+
         SYSTRACE_NAME_END();
 
         // TODO: when any spotlight is used, `merged` ends-up being the whole list. However,
@@ -813,6 +873,122 @@ void FView::prepareVisibleRenderables(JobSystem& js,
     }
 }
 
+UTILS_NOINLINE
+bool FView::tryReuseCulling(FEngine& engine, CameraInfo const& cameraInfo,
+        Frustum const& frustum, FScene::RenderableSoa& renderableData) noexcept {
+    CullingCache& cache = mCullingCache;
+
+    if (UTILS_UNLIKELY(!isFrustumCullingEnabled())) {
+        // with culling disabled every renderable is visible; don't let a stale snapshot
+        // be replayed if culling is later re-enabled
+        cache.valid = false;
+        return false;
+    }
+
+    // the snapshot is positional: it can only be replayed onto the SoA in the canonical
+    // order FScene::prepare() built it in, not after another view has partitioned it
+    FScene const* const scene = getScene();
+    if (!scene->isRenderableDataInCanonicalOrder()) {
+        return false;
+    }
+
+    // all culling inputs must be unchanged: scene content, transforms, bounding boxes
+    // and the world origin (the world-space AABBs depend on it)
+    if (!cache.valid
+            || cache.visibility.size() != renderableData.size()
+            || cache.sceneVersion != scene->getVersion()
+            || cache.transformVersion != engine.getTransformManager().getVersion()
+            || cache.renderableVersion != engine.getRenderableManager().getVersion()) {
+        return false;
+    }
+    for (size_t i = 0; i < 4; i++) {
+        if (cache.worldTransform[i] != cameraInfo.worldTransform[i]) {
+            return false;
+        }
+    }
+
+    // The frustum is compared with a small relative tolerance so that sub-pixel camera
+    // jitter (e.g. a tripod-mounted viewer) doesn't defeat the cache; the only objects
+    // such jitter could flip sit within a fraction of a pixel of a frustum plane.
+    constexpr float epsilon = 1e-5f;
+    float4 planes[6];
+    frustum.getNormalizedPlanes(planes);
+    for (size_t i = 0; i < 6; i++) {
+        for (size_t j = 0; j < 4; j++) {
+            float const a = cache.planes[i][j];
+            float const b = planes[i][j];
+            if (std::abs(a - b) > epsilon * std::max(1.0f, std::abs(a))) {
+                return false;
+            }
+        }
+    }
+
+    std::copy_n(cache.visibility.data(), renderableData.size(),
+            renderableData.data<FScene::VISIBLE_MASK>());
+    return true;
+}
+
+UTILS_NOINLINE
+void FView::updateCullingCache(FEngine& engine, CameraInfo const& cameraInfo,
+        Frustum const& frustum, FScene::RenderableSoa const& renderableData) noexcept {
+    CullingCache& cache = mCullingCache;
+    if (UTILS_UNLIKELY(!isFrustumCullingEnabled())) {
+        cache.valid = false;
+        return;
+    }
+    if (!getScene()->isRenderableDataInCanonicalOrder()) {
+        // a previous view already partitioned the SoA this frame; a snapshot taken in
+        // that view-dependent row order could never be replayed, so don't store one
+        cache.valid = false;
+        return;
+    }
+    frustum.getNormalizedPlanes(cache.planes);
+    cache.worldTransform = cameraInfo.worldTransform;
+    cache.sceneVersion = getScene()->getVersion();
+    cache.transformVersion = engine.getTransformManager().getVersion();
+    cache.renderableVersion = engine.getRenderableManager().getVersion();
+    size_t const count = renderableData.size();
+    if (cache.visibility.size() != count) {
+        cache.visibility = utils::FixedCapacityVector<Culler::result_type>(count);
+    }
+    std::copy_n(renderableData.data<FScene::VISIBLE_MASK>(), count, cache.visibility.data());
+    cache.valid = true;
+}
+
+Frustum FView::computeStereoCullingFrustum(CameraInfo const& cameraInfo,
+        size_t const eyeCount) noexcept {
+    // The culling projection covers the union of the eyes' fields of view (see
+    // Camera::setCustomEyeProjection()), but the per-eye transforms (setEyeModelMatrix())
+    // are not baked into it; an object close to the head can be visible to one eye while
+    // lying outside the head's frustum. Push each plane of the head frustum out just far
+    // enough to contain the corners of every eye's frustum. This stays conservative -- the
+    // planes keep their orientation -- and is exact when the eyes differ by a translation,
+    // which is the common case.
+    Frustum const headFrustum{ mat4f{
+            highPrecisionMultiply(cameraInfo.cullingProjection, cameraInfo.view) }};
+    float4 planes[6];
+    headFrustum.getNormalizedPlanes(planes);
+    for (size_t eye = 0; eye < eyeCount; eye++) {
+        mat4f const clipFromWorld{ highPrecisionMultiply(cameraInfo.cullingProjection,
+                highPrecisionMultiply(cameraInfo.eyeFromView[eye], cameraInfo.view)) };
+        mat4f const worldFromClip = inverse(clipFromWorld);
+        for (float const z: { -1.0f, 1.0f }) {
+            for (float const y: { -1.0f, 1.0f }) {
+                for (float const x: { -1.0f, 1.0f }) {
+                    float4 const p = worldFromClip * float4{ x, y, z, 1.0f };
+                    float3 const corner = p.xyz * (1.0f / p.w);
+                    for (auto& plane: planes) {
+                        // a point is inside when dot(plane.xyz, p) + plane.w <= 0, so
+                        // lowering w can only grow the frustum
+                        plane.w = std::min(plane.w, -dot(plane.xyz, corner));
+                    }
+                }
+            }
+        }
+    }
+    return Frustum{ planes };
+}
+
 void FView::cullRenderables(JobSystem&,
         FScene::RenderableSoa& renderableData, Frustum const& frustum, size_t bit) noexcept {
     SYSTRACE_CALL();
@@ -836,7 +1012,43 @@ void FView::cullRenderables(JobSystem&,
     // Moreover, even with a large number of primitives, the overhead of the JobSystem is too
     // large compared to the run time of Culler::intersects, e.g.: ~100us for 4000 primitives
     // on Pixel4.
-    functor(0, renderableData.size());
+
+    size_t const count = renderableData.size();
+    if (count < 2 * CULLING_BLOCK_SIZE) {
+        functor(0, count);
+        return;
+    }
+
+    // Two-level hierarchical culling: classify the merged AABB of fixed-size blocks of
+    // renderables first, and only run the per-renderable kernel on blocks that straddle
+    // the frustum. Computing the merged bounds is a couple of min/max per object, much
+    // cheaper than the six plane tests, so mostly-invisible scenes (e.g. city-scale
+    // worlds) reject whole blocks in a handful of tests.
+    for (size_t base = 0; base < count; base += CULLING_BLOCK_SIZE) {
+        size_t const n = std::min(CULLING_BLOCK_SIZE, count - base);
+
+        float3 lo = worldAABBCenter[base] - worldAABBExtent[base];
+        float3 hi = worldAABBCenter[base] + worldAABBExtent[base];
+        for (size_t i = 1; i < n; i++) {
+            lo = min(lo, worldAABBCenter[base + i] - worldAABBExtent[base + i]);
+            hi = max(hi, worldAABBCenter[base + i] + worldAABBExtent[base + i]);
+        }
+
+        auto const containment = Culler::classify(frustum, (hi + lo) * 0.5f, (hi - lo) * 0.5f);
+        if (containment == Culler::Containment::INTERSECTING) {
+            functor(uint32_t(base), uint32_t(n));
+        } else {
+            // whole block is either culled or visible, just write the visibility bit
+            auto const v = FScene::VisibleMaskType(
+                    (containment == Culler::Containment::INSIDE ? 1u : 0u) << bit);
+            for (size_t i = 0; i < n; i++) {
+                auto r = visibleArray[base + i];
+                r &= ~FScene::VisibleMaskType(1u << bit);
+                r |= v;
+                visibleArray[base + i] = r;
+            }
+        }
+    }
 }
 
 void FView::prepareVisibleLights(FLightManager const& lcm, ArenaScope& rootArena,
@@ -950,13 +1162,29 @@ inline void FView::computeLightCameraDistances(
     }
 }
 
-void FView::updatePrimitivesLod(FEngine& engine, const CameraInfo&,
+void FView::updatePrimitivesLod(FEngine& engine, const CameraInfo& camera,
         FScene::RenderableSoa& renderableData, Range visible) noexcept {
     FRenderableManager const& rcm = engine.getRenderableManager();
+    // projection[2][3] is 0 for an orthographic projection, where the projected size doesn't
+    // depend on the distance to the camera
+    bool const perspective = camera.projection[2][3] != 0.0f;
+    float const projectionScale = camera.projection[1][1];
+    float3 const cameraPosition = camera.getPosition();
     for (uint32_t const index : visible) {
-        uint8_t const level = 0; // TODO: pick the proper level of detail
         auto ri = renderableData.elementAt<FScene::RENDERABLE_INSTANCE>(index);
-        renderableData.elementAt<FScene::PRIMITIVES>(index) = rcm.getRenderPrimitives(ri, level);
+        uint8_t level = 0;
+        if (UTILS_UNLIKELY(rcm.getLodGroupCount(ri) > 0)) {
+            // estimate of the fraction of the viewport height covered by the renderable's
+            // bounding sphere
+            float3 const center = renderableData.elementAt<FScene::WORLD_AABB_CENTER>(index);
+            float3 const extent = renderableData.elementAt<FScene::WORLD_AABB_EXTENT>(index);
+            float coverage = length(extent) * projectionScale;
+            if (perspective) {
+                coverage /= std::max(camera.zn, length(center - cameraPosition));
+            }
+            level = rcm.getLodLevel(ri, coverage);
+        }
+        renderableData.elementAt<FScene::PRIMITIVES>(index) = rcm.getLodPrimitives(ri, level);
     }
 }
 
@@ -1034,6 +1262,134 @@ void FView::executePickingQueries(backend::DriverApi& driver,
     }
 }
 
+filament::Viewport FView::getPickingQueriesArea(float scale) const noexcept {
+    uint32_t minX = std::numeric_limits<uint32_t>::max();
+    uint32_t minY = std::numeric_limits<uint32_t>::max();
+    uint32_t maxX = 0;
+    uint32_t maxY = 0;
+    for (FPickingQuery const* pQuery = mActivePickingQueriesList;
+            pQuery; pQuery = pQuery->next) {
+        // same conversion as executePickingQueries() above
+        const uint32_t x = uint32_t(float(pQuery->x) * (scale * mScale.x));
+        const uint32_t y = uint32_t(float(pQuery->y) * (scale * mScale.y));
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+    }
+    // a small margin, so that the region doesn't degenerate to the queried pixels alone
+    // and stays insensitive to rounding of the scaled coordinates
+    constexpr uint32_t MARGIN = 16u;
+    minX = minX >= MARGIN ? minX - MARGIN : 0u;
+    minY = minY >= MARGIN ? minY - MARGIN : 0u;
+    return { int32_t(minX), int32_t(minY),
+             maxX - minX + MARGIN + 1u, maxY - minY + MARGIN + 1u };
+}
+
+void FView::submitOcclusionDepthReadback(backend::DriverApi& driver,
+        backend::RenderTargetHandle handle, uint32_t width, uint32_t height,
+        mat4f const& viewProjection) noexcept {
+
+    auto* const readback = new OcclusionDepthReadback{
+            this, mOcclusionReadbacksInFlight, viewProjection, width, height,
+            std::vector<float>(size_t(width) * height) };
+    mOcclusionReadbacksInFlight = readback;
+
+    // like the picking queries above, the callback executes on the filament thread
+    driver.readPixels(handle, 0, 0, width, height, {
+            readback->depth.data(), readback->depth.size() * sizeof(float),
+            backend::PixelDataFormat::R, backend::PixelDataType::FLOAT,
+            [](void*, size_t, void* user) {
+                auto* const readback = static_cast<OcclusionDepthReadback*>(user);
+                FView* const view = readback->view;
+                if (UTILS_UNLIKELY(!view)) {
+                    // the view was terminated while the readback was in flight
+                    delete readback;
+                    return;
+                }
+                // unlink from the in-flight list and make it the current result
+                OcclusionDepthReadback** pCurrent = &view->mOcclusionReadbacksInFlight;
+                while (*pCurrent != readback) {
+                    pCurrent = &(*pCurrent)->next;
+                }
+                *pCurrent = readback->next;
+                delete view->mOcclusionDepth;
+                view->mOcclusionDepth = readback;
+            }, readback
+    });
+}
+
+UTILS_NOINLINE
+void FView::applyOcclusionCulling(FScene::RenderableSoa& renderableData,
+        OcclusionDepthReadback const& occlusion) noexcept {
+    SYSTRACE_CALL();
+
+    float3 const* const UTILS_RESTRICT worldAABBCenter = renderableData.data<FScene::WORLD_AABB_CENTER>();
+    float3 const* const UTILS_RESTRICT worldAABBExtent = renderableData.data<FScene::WORLD_AABB_EXTENT>();
+    FScene::VisibleMaskType* const UTILS_RESTRICT visibleArray = renderableData.data<FScene::VISIBLE_MASK>();
+
+    float const* const UTILS_RESTRICT tiles = occlusion.depth.data();
+    mat4f const& viewProjection = occlusion.viewProjection;
+    int32_t const w = int32_t(occlusion.width);
+    int32_t const h = int32_t(occlusion.height);
+
+    for (size_t i = 0, c = renderableData.size(); i < c; i++) {
+        if (!(visibleArray[i] & VISIBLE_RENDERABLE)) {
+            continue;
+        }
+
+        // project the corners of the world-space AABB with the clip-from-world matrix of the
+        // frame the depth was rendered from
+        float3 const center = worldAABBCenter[i];
+        float3 const extent = worldAABBExtent[i];
+        float2 minp{ std::numeric_limits<float>::max() };
+        float2 maxp{ std::numeric_limits<float>::lowest() };
+        float nearest = 0.0f; // inverted-z: larger is closer
+        bool crossesCameraPlane = false;
+        for (size_t j = 0; j < 8; j++) {
+            float3 const corner{
+                    center.x + ((j & 1u) ? extent.x : -extent.x),
+                    center.y + ((j & 2u) ? extent.y : -extent.y),
+                    center.z + ((j & 4u) ? extent.z : -extent.z) };
+            float4 const p = viewProjection * float4{ corner, 1.0f };
+            if (p.w < std::numeric_limits<float>::min()) {
+                // the box reaches behind the camera plane, it can't be occluded
+                crossesCameraPlane = true;
+                break;
+            }
+            float3 const ndc = p.xyz * (1.0f / p.w);
+            minp = min(minp, ndc.xy);
+            maxp = max(maxp, ndc.xy);
+            nearest = std::max(nearest, ndc.z);
+        }
+        if (UTILS_UNLIKELY(crossesCameraPlane)) {
+            continue;
+        }
+
+        // footprint of the box on the tile grid, clamped to the buffer. Tiles outside the
+        // viewport hold the clear value (0.0, i.e. infinity) and never report occlusion.
+        int32_t const x0 = clamp(int32_t(std::floor((minp.x * 0.5f + 0.5f) * float(w))), 0, w - 1);
+        int32_t const x1 = clamp(int32_t(std::floor((maxp.x * 0.5f + 0.5f) * float(w))), 0, w - 1);
+        int32_t const y0 = clamp(int32_t(std::floor((minp.y * 0.5f + 0.5f) * float(h))), 0, h - 1);
+        int32_t const y1 = clamp(int32_t(std::floor((maxp.y * 0.5f + 0.5f) * float(h))), 0, h - 1);
+
+        // the box is occluded only if its nearest point is farther than the farthest depth of
+        // every tile it touches
+        bool occluded = true;
+        for (int32_t y = y0; occluded && y <= y1; y++) {
+            for (int32_t x = x0; x <= x1; x++) {
+                if (tiles[y * w + x] <= nearest) {
+                    occluded = false;
+                    break;
+                }
+            }
+        }
+        if (occluded) {
+            visibleArray[i] &= ~VISIBLE_RENDERABLE;
+        }
+    }
+}
+
 void FView::setTemporalAntiAliasingOptions(TemporalAntiAliasingOptions options) noexcept {
     options.feedback = math::clamp(options.feedback, 0.0f, 1.0f);
     options.filterWidth = std::max(0.2f, options.filterWidth); // below 0.2 causes issues
@@ -1051,6 +1407,9 @@ void FView::setScreenSpaceReflectionsOptions(ScreenSpaceReflectionsOptions optio
     options.bias = std::max(0.0f, options.bias);
     options.maxDistance = std::max(0.0f, options.maxDistance);
     options.stride = std::max(1.0f, options.stride);
+    // snap to the closer of 0.5 or 1.0
+    options.resolution = std::floor(
+            math::clamp(options.resolution * 2.0f, 1.0f, 2.0f) + 0.5f) * 0.5f;
     mScreenSpaceReflectionsOptions = options;
 }
 
@@ -24,11 +24,13 @@
 #include "downcast.h"
 
 #include "Allocators.h"
+#include "FeatureFlags.h"
 #include "FrameHistory.h"
 #include "FrameInfo.h"
 #include "Froxelizer.h"
 #include "PerViewUniforms.h"
 #include "PIDController.h"
+#include "RenderPass.h"
 #include "ShadowMap.h"
 #include "ShadowMapManager.h"
 #include "TypedUniformBuffer.h"
@@ -46,6 +48,7 @@
 
 #include <utils/compiler.h>
 #include <utils/Allocator.h>
+#include <utils/FixedCapacityVector.h>
 #include <utils/StructureOfArrays.h>
 #include <utils/Range.h>
 #include <utils/Slice.h>
@@ -53,6 +56,8 @@
 #include <math/scalar.h>
 #include <math/mat4.h>
 
+#include <vector>
+
 namespace utils {
 class JobSystem;
 } // namespace utils;
@@ -159,12 +164,17 @@ public:
     utils::JobSystem::Job* getFroxelizerSync() const noexcept { return mFroxelizerSync; }
     void setFroxelizerSync(utils::JobSystem::Job* sync) noexcept { mFroxelizerSync = sync; }
 
+    // persistent cache for incremental color-pass command sorting
+    RenderPass::SortCache& getColorPassSortCache() noexcept { return mColorPassSortCache; }
+
     bool hasDirectionalLight() const noexcept { return mHasDirectionalLight; }
     bool hasDynamicLighting() const noexcept { return mHasDynamicLighting; }
     bool hasShadowing() const noexcept { return mHasShadowing; }
     bool needsShadowMap() const noexcept { return mNeedsShadowMap; }
-    bool hasFog() const noexcept { return mFogOptions.enabled && mFogOptions.density > 0.0f; }
-    bool hasVSM() const noexcept { return mShadowType == ShadowType::VSM; }
+    bool hasFog() const noexcept {
+        return features::FOG && mFogOptions.enabled && mFogOptions.density > 0.0f;
+    }
+    bool hasVSM() const noexcept { return features::VSM && mShadowType == ShadowType::VSM; }
     bool hasDPCF() const noexcept { return mShadowType == ShadowType::DPCF; }
     bool hasPCSS() const noexcept { return mShadowType == ShadowType::PCSS; }
     bool hasPicking() const noexcept { return mActivePickingQueriesList != nullptr; }
@@ -186,20 +196,37 @@ public:
 
     void setScreenSpaceRefractionEnabled(bool enabled) noexcept { mScreenSpaceRefractionEnabled = enabled; }
 
-    bool isScreenSpaceRefractionEnabled() const noexcept { return mScreenSpaceRefractionEnabled; }
+    bool isScreenSpaceRefractionEnabled() const noexcept {
+        return features::SSR && mScreenSpaceRefractionEnabled;
+    }
 
-    bool isScreenSpaceReflectionEnabled() const noexcept { return mScreenSpaceReflectionsOptions.enabled; }
+    bool isScreenSpaceReflectionEnabled() const noexcept {
+        return features::SSR && mScreenSpaceReflectionsOptions.enabled;
+    }
 
     void setStencilBufferEnabled(bool enabled) noexcept { mStencilBufferEnabled = enabled; }
 
     bool isStencilBufferEnabled() const noexcept { return mStencilBufferEnabled; }
 
+    void setPerformanceHudEnabled(bool enabled) noexcept { mPerformanceHudEnabled = enabled; }
+
+    bool isPerformanceHudEnabled() const noexcept { return mPerformanceHudEnabled; }
+
+    void setShadingRate(backend::ShadingRate rate) noexcept { mShadingRate = rate; }
+
+    backend::ShadingRate getShadingRate() const noexcept { return mShadingRate; }
+
     void setStereoscopicOptions(StereoscopicOptions const& options) noexcept;
 
     FCamera const* getDirectionalLightCamera() const noexcept {
         return mShadowMapManager.getDirectionalLightCamera();
     }
 
+    // global scale applied to all shadow map dimensions, used by the thermal governor
+    void setShadowResolutionScale(float scale) noexcept {
+        mShadowMapManager.setShadowResolutionScale(scale);
+    }
+
     void setRenderTarget(FRenderTarget* renderTarget) noexcept {
         assert_invariant(!renderTarget || !mMultiSampleAntiAliasingOptions.enabled ||
                 !renderTarget->hasSampleableDepth());
@@ -399,6 +426,11 @@ public:
     static void cullRenderables(utils::JobSystem& js, FScene::RenderableSoa& renderableData,
             Frustum const& frustum, size_t bit) noexcept;
 
+    // returns a frustum that conservatively contains the culling frustum of every eye, so
+    // that with instanced stereo a single culling pass provably covers all eyes
+    static Frustum computeStereoCullingFrustum(CameraInfo const& cameraInfo,
+            size_t eyeCount) noexcept;
+
     PerViewUniforms const& getPerViewUniforms() const noexcept { return mPerViewUniforms; }
     PerViewUniforms& getPerViewUniforms() noexcept { return mPerViewUniforms; }
 
@@ -419,6 +451,21 @@ public:
     void executePickingQueries(backend::DriverApi& driver,
             backend::RenderTargetHandle handle, float scale) noexcept;
 
+    // Smallest region of the picking buffer covering all pending picking queries, with a
+    // small margin, in physical coordinates (i.e. already adjusted for dynamic resolution
+    // and the structure buffer scale). Only meaningful when hasPicking() is true.
+    Viewport getPickingQueriesArea(float scale) const noexcept;
+
+    void setOcclusionCullingEnabled(bool enabled) noexcept { mOcclusionCullingEnabled = enabled; }
+    bool isOcclusionCullingEnabled() const noexcept { return mOcclusionCullingEnabled; }
+
+    // Issues the asynchronous readback of the reduced occlusion depth buffer
+    // (see PostProcessManager::occlusionDepth()). The result is consumed by prepare()
+    // on a later frame.
+    void submitOcclusionDepthReadback(backend::DriverApi& driver,
+            backend::RenderTargetHandle handle, uint32_t width, uint32_t height,
+            math::mat4f const& viewProjection) noexcept;
+
     void setMaterialGlobal(uint32_t index, math::float4 const& value);
 
     math::float4 getMaterialGlobal(uint32_t index) const;
@@ -455,9 +502,32 @@ private:
         PickingQueryResult result;
     };
 
+    // one readback of the reduced occlusion depth buffer (see submitOcclusionDepthReadback())
+    struct OcclusionDepthReadback {
+        FView* view;                        // cleared if the view is terminated while in flight
+        OcclusionDepthReadback* next;       // in-flight list link
+        math::mat4f viewProjection;         // clip-from-world matrix of the readback frame
+        uint32_t width;
+        uint32_t height;
+        std::vector<float> depth;           // farthest depth of each tile, inverted-z
+    };
+
+    // clears the VISIBLE_RENDERABLE bit of renderables whose bounds are entirely hidden
+    // behind the depth recorded in the given readback
+    static void applyOcclusionCulling(FScene::RenderableSoa& renderableData,
+            OcclusionDepthReadback const& occlusion) noexcept;
+
     void prepareVisibleRenderables(utils::JobSystem& js,
             Frustum const& frustum, FScene::RenderableSoa& renderableData) const noexcept;
 
+    // Temporal culling reuse: a static view (tripod camera, nothing moving) produces the
+    // exact same visibility as the previous frame. tryReuseCulling() replays the snapshot
+    // taken by updateCullingCache() when the frustum and all culling inputs are unchanged.
+    bool tryReuseCulling(FEngine& engine, CameraInfo const& cameraInfo,
+            Frustum const& frustum, FScene::RenderableSoa& renderableData) noexcept;
+    void updateCullingCache(FEngine& engine, CameraInfo const& cameraInfo,
+            Frustum const& frustum, FScene::RenderableSoa const& renderableData) noexcept;
+
     static void prepareVisibleLights(FLightManager const& lcm, ArenaScope& rootArena,
             math::mat4f const& viewMatrix, Frustum const& frustum,
             FScene::LightSoa& lightData) noexcept;
@@ -495,6 +565,20 @@ private:
     mutable Froxelizer mFroxelizer;
     utils::JobSystem::Job* mFroxelizerSync = nullptr;
 
+    RenderPass::SortCache mColorPassSortCache;
+
+    // snapshot of the camera-culling result (see tryReuseCulling())
+    struct CullingCache {
+        math::float4 planes[6] = {};
+        math::mat4 worldTransform;
+        uint32_t sceneVersion = 0;
+        uint32_t transformVersion = 0;
+        uint32_t renderableVersion = 0;
+        bool valid = false;
+        utils::FixedCapacityVector<Culler::result_type> visibility;
+    };
+    CullingCache mCullingCache;
+
     Viewport mViewport;
     bool mCulling = true;
     bool mFrontFaceWindingInverted = false;
@@ -508,6 +592,8 @@ private:
     bool mScreenSpaceRefractionEnabled = true;
     bool mHasPostProcessPass = true;
     bool mStencilBufferEnabled = false;
+    bool mPerformanceHudEnabled = false;
+    backend::ShadingRate mShadingRate = backend::ShadingRate::ONE_BY_ONE;
     AmbientOcclusionOptions mAmbientOcclusionOptions{};
     ShadowType mShadowType = ShadowType::PCF;
     VsmShadowOptions mVsmShadowOptions; // FIXME: this should probably be per-light
@@ -530,6 +616,7 @@ private:
     PIDController mPidController;
     DynamicResolutionOptions mDynamicResolution;
     math::float2 mScale = 1.0f;
+    uint32_t mUnderBudgetFrameCount = 0;    // consecutive frames the GPU was under budget
     bool mIsDynamicResolutionSupported = false;
 
     RenderQuality mRenderQuality;
@@ -540,6 +627,12 @@ private:
 
     FPickingQuery* mActivePickingQueriesList = nullptr;
 
+    bool mOcclusionCullingEnabled = false;
+    // latest completed occlusion depth readback (owned), and list of readbacks in flight
+    // (owned by their readPixels callback). Both are only touched on the filament thread.
+    OcclusionDepthReadback* mOcclusionDepth = nullptr;
+    OcclusionDepthReadback* mOcclusionReadbacksInFlight = nullptr;
+
     utils::CString mName;
 
     // the following values are set by prepare()
@@ -101,13 +101,66 @@ DependencyGraph::Node* DependencyGraph::getNode(DependencyGraph::NodeID id) noex
     return mNodes[id];
 }
 
-void DependencyGraph::cull() noexcept {
+uint32_t DependencyGraph::computeTopologyHash() const noexcept {
+    // FNV-1a over the graph's shape: the culling outcome only depends on the edges and on
+    // which nodes are targets, both of which are encoded here (node ids are indices)
+    uint32_t h = 2166136261u;
+    auto mix = [&h](uint32_t const v) {
+        h = (h ^ v) * 16777619u;
+    };
+    mix(uint32_t(mNodes.size()));
+    mix(uint32_t(mEdges.size()));
+    for (Node const* const pNode : mNodes) {
+        mix(pNode->isTarget() ? 1u : 0u);
+    }
+    for (Edge const* const pEdge : mEdges) {
+        mix(pEdge->from);
+        mix(pEdge->to);
+    }
+    return h;
+}
+
+bool DependencyGraph::matchesTopology(CullCache const& cache) const noexcept {
+    if (cache.targets.size() != mNodes.size() ||
+            cache.edges.size() != mEdges.size() * 2 ||
+            cache.refCounts.size() != mNodes.size()) {
+        return false;
+    }
+    for (size_t i = 0, c = mNodes.size(); i < c; i++) {
+        if (cache.targets[i] != uint8_t(mNodes[i]->isTarget())) {
+            return false;
+        }
+    }
+    for (size_t i = 0, c = mEdges.size(); i < c; i++) {
+        if (cache.edges[i * 2] != mEdges[i]->from || cache.edges[i * 2 + 1] != mEdges[i]->to) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void DependencyGraph::cull(CullCache* cache) noexcept {
 
     SYSTRACE_CALL();
 
     auto& nodes = mNodes;
     auto& edges = mEdges;
 
+    uint32_t topologyHash = 0;
+    if (cache) {
+        topologyHash = computeTopologyHash();
+        // the hash only serves to reject cheaply; a replay requires an exact topology
+        // match, otherwise a hash collision would replay the wrong reference counts and
+        // silently cull the wrong passes.
+        if (topologyHash == cache->topologyHash && matchesTopology(*cache)) {
+            // same passes, resources and dependencies as last frame: replay the result
+            for (size_t i = 0, c = nodes.size(); i < c; i++) {
+                nodes[i]->mRefCount = cache->refCounts[i];
+            }
+            return;
+        }
+    }
+
     // update reference counts
     for (Edge* const pEdge : edges) {
         Node* node = nodes[pEdge->from];
@@ -132,6 +185,24 @@ void DependencyGraph::cull() noexcept {
             }
         }
     }
+
+    if (cache) {
+        cache->topologyHash = topologyHash;
+        cache->targets = utils::FixedCapacityVector<uint8_t>::with_capacity(nodes.size());
+        cache->edges = utils::FixedCapacityVector<NodeID>::with_capacity(edges.size() * 2);
+        cache->refCounts = utils::FixedCapacityVector<uint32_t>::with_capacity(nodes.size());
+        for (Node const* const pNode : nodes) {
+            // note: mRefCount has the TARGET bit set for target nodes, so the targets
+            // snapshot below must not be derived from it after culling -- but isTarget()
+            // is precisely that bit, which cull() never clears.
+            cache->targets.push_back(uint8_t(pNode->isTarget()));
+            cache->refCounts.push_back(pNode->mRefCount);
+        }
+        for (Edge const* const pEdge : edges) {
+            cache->edges.push_back(pEdge->from);
+            cache->edges.push_back(pEdge->to);
+        }
+    }
 }
 
 void DependencyGraph::clear() noexcept {
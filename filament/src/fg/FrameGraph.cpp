@@ -21,6 +21,8 @@
 
 #include "details/Engine.h"
 
+#include "PassTimingManager.h"
+
 #include <backend/DriverEnums.h>
 #include <backend/Handle.h>
 
@@ -37,6 +39,10 @@ void FrameGraph::Builder::sideEffect() noexcept {
     mPassNode->makeTarget();
 }
 
+void FrameGraph::Builder::queueHint(QueueHint const hint) noexcept {
+    mPassNode->setQueueHint(hint);
+}
+
 const char* FrameGraph::Builder::getName(FrameGraphHandle handle) const noexcept {
     return mFrameGraph.getResource(handle)->name;
 }
@@ -106,8 +112,9 @@ FrameGraph& FrameGraph::compile() noexcept {
 
     DependencyGraph& dependencyGraph = mGraph;
 
-    // first we cull unreachable nodes
-    dependencyGraph.cull();
+    // first we cull unreachable nodes (replayed from the cull cache when the topology
+    // is the same as last frame)
+    dependencyGraph.cull(mCullCache);
 
     /*
      * update the reference counter of the resource themselves and
@@ -197,6 +204,10 @@ void FrameGraph::execute(backend::DriverApi& driver) noexcept {
 
         driver.pushGroupMarker(node->getName());
 
+        if (UTILS_UNLIKELY(mPassProfiler)) {
+            mPassProfiler->beginPass(driver, node->getName());
+        }
+
         // devirtualize resourcesList
         for (VirtualResource* resource : node->devirtualize) {
             assert_invariant(resource->first == node);
@@ -213,6 +224,10 @@ void FrameGraph::execute(backend::DriverApi& driver) noexcept {
             resource->destroy(resourceAllocator);
         }
 
+        if (UTILS_UNLIKELY(mPassProfiler)) {
+            mPassProfiler->endPass(driver);
+        }
+
         driver.popGroupMarker();
     }
     driver.popGroupMarker();
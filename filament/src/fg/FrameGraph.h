@@ -42,12 +42,25 @@ class ResourceAllocatorInterface;
 
 class FrameGraphPassExecutor;
 class PassNode;
+class PassTimingManager;
 class ResourceNode;
 class VirtualResource;
 
 class FrameGraph {
 public:
 
+    /**
+     * Queue a pass would like to execute on. This is a scheduling hint: backends with
+     * multiple hardware queues may overlap ASYNC_COMPUTE passes with graphics work
+     * (synchronization is derived from the pass's declared reads and writes); backends
+     * without simply keep everything on the graphics queue, so the hint never affects
+     * correctness.
+     */
+    enum class QueueHint : uint8_t {
+        GRAPHICS,       // default: the pass runs on the graphics queue, in declaration order
+        ASYNC_COMPUTE,  // self-contained work that may overlap preceding graphics passes
+    };
+
     class Builder {
     public:
         Builder(Builder const&) = delete;
@@ -154,6 +167,12 @@ public:
          */
         void sideEffect() noexcept;
 
+        /**
+         * Annotates the current pass with the queue it would like to execute on.
+         * See FrameGraph::QueueHint.
+         */
+        void queueHint(QueueHint hint) noexcept;
+
         /**
          * Retrieves the descriptor associated to a resource
          * @tparam RESOURCE Type of the resource
@@ -292,6 +311,12 @@ public:
      */
     void execute(backend::DriverApi& driver) noexcept;
 
+    /**
+     * When set, the profiler's beginPass()/endPass() hooks are invoked around each pass
+     * executed by execute(), e.g. to collect per-pass GPU timings.
+     */
+    void setPassProfiler(PassTimingManager* profiler) noexcept { mPassProfiler = profiler; }
+
     /**
      * Forwards a resource to another one which gets replaced.
      * The replaced resource's handle becomes forever invalid.
@@ -425,6 +450,13 @@ public:
      */
     bool isAcyclic() const noexcept;
 
+    /**
+     * Attaches a persistent cull cache, so compile() can skip the pass-culling graph
+     * traversal on frames where the graph topology didn't change. The cache must be kept
+     * alive by the caller (which outlives this per-frame FrameGraph).
+     */
+    void setCullCache(DependencyGraph::CullCache* cache) noexcept { mCullCache = cache; }
+
     //! export a graphviz view of the graph
     void export_graphviz(utils::io::ostream& out, const char* name = nullptr);
 
@@ -517,6 +549,8 @@ private:
     ResourceAllocatorInterface& mResourceAllocator;
     LinearAllocatorArena mArena;
     DependencyGraph mGraph;
+    DependencyGraph::CullCache* mCullCache = nullptr;
+    PassTimingManager* mPassProfiler = nullptr;
 
     Vector<ResourceSlot> mResourceSlots;
     Vector<VirtualResource*> mResources;
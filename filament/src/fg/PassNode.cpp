@@ -119,6 +119,9 @@ uint32_t RenderPassNode::declareRenderTarget(FrameGraph& fg, FrameGraph::Builder
     }
 
     uint32_t const id = mRenderTargetData.size();
+    if (UTILS_UNLIKELY(mRenderTargetData.size() == mRenderTargetData.capacity())) {
+        mRenderTargetData.reserve(mRenderTargetData.capacity() * 2);
+    }
     mRenderTargetData.push_back(data);
     return id;
 }
@@ -141,6 +144,7 @@ void RenderPassNode::resolve() noexcept {
         rt.backend.params.flags.discardStart    = TargetBufferFlags::NONE;
         rt.backend.params.flags.discardEnd      = TargetBufferFlags::NONE;
         rt.backend.params.readOnlyDepthStencil  = 0;
+        rt.backend.params.subpassMask           = 0;
 
         constexpr size_t DEPTH_INDEX = MRT::MAX_SUPPORTED_RENDER_TARGET_COUNT + 0;
         constexpr size_t STENCIL_INDEX = MRT::MAX_SUPPORTED_RENDER_TARGET_COUNT + 1;
@@ -170,6 +174,16 @@ void RenderPassNode::resolve() noexcept {
                 if (!rt.incoming[i] || !rt.incoming[i]->hasActiveWriters()) {
                     rt.backend.params.flags.discardStart |= target;
                 }
+                // A color attachment that this same pass also reads as SUBPASS_INPUT is
+                // consumed in a second subpass (e.g. color-grading as a subpass); record it
+                // so the backend creates the corresponding input attachment.
+                if (i < MRT::MAX_SUPPORTED_RENDER_TARGET_COUNT && rt.incoming[i]) {
+                    auto const* pEdge = static_cast<Resource<FrameGraphTexture>::ResourceEdge const*>(
+                            rt.incoming[i]->getReaderEdgeForPass(this));
+                    if (pEdge && any(pEdge->usage & FrameGraphTexture::Usage::SUBPASS_INPUT)) {
+                        rt.backend.params.subpassMask |= 1u << i;
+                    }
+                }
                 VirtualResource* pResource = mFrameGraph.getResource(rt.descriptor.attachments.array[i]);
                 Resource<FrameGraphTexture>* pTextureResource = static_cast<Resource<FrameGraphTexture>*>(pResource);
 
@@ -160,8 +160,26 @@ public:
 
     Node* getNode(NodeID id) noexcept;
 
-    //! cull unreferenced nodes. Links ARE NOT removed, only reference counts are updated.
-    void cull() noexcept;
+    /**
+     * Persistent cache for cull() results. The graph itself is typically rebuilt every frame,
+     * but its topology only changes when passes are added or removed (e.g. an effect is
+     * toggled); an owner that keeps a CullCache across frames lets cull() replay the previous
+     * reference counts whenever the topology is unchanged, skipping the graph traversal.
+     */
+    struct CullCache {
+        // hash is only a fast-path reject; the exact topology below is what authorizes a
+        // replay, so a hash collision can't resurrect the wrong result
+        uint32_t topologyHash = 0;
+        utils::FixedCapacityVector<uint8_t> targets;      // one entry per node
+        utils::FixedCapacityVector<NodeID> edges;         // from/to pairs, interleaved
+        utils::FixedCapacityVector<uint32_t> refCounts;
+    };
+
+    /**
+     * cull unreferenced nodes. Links ARE NOT removed, only reference counts are updated.
+     * If a CullCache is supplied, it is used when the topology matches and updated otherwise.
+     */
+    void cull(CullCache* cache = nullptr) noexcept;
 
     /**
      * Return whether an edge is valid, that is if both ends are connected to nodes
@@ -176,6 +194,14 @@ public:
     bool isAcyclic() const noexcept;
 
 private:
+    // hash of the graph's nodes, edges and targets; only valid before cull() has
+    // modified the reference counts
+    uint32_t computeTopologyHash() const noexcept;
+
+    // exact comparison of the graph's topology against a cached one; only valid before
+    // cull() has modified the reference counts
+    bool matchesTopology(CullCache const& cache) const noexcept;
+
     // id must be the node key in the NodeContainer
     uint32_t generateNodeId() noexcept;
     void registerNode(Node* node, NodeID id) noexcept;
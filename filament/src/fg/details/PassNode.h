@@ -26,6 +26,8 @@
 
 #include <backend/TargetBufferInfo.h>
 
+#include <utils/FixedCapacityVector.h>
+
 #include <unordered_set>
 
 namespace utils {
@@ -58,8 +60,15 @@ public:
     virtual void resolve() noexcept = 0;
     utils::CString graphvizifyEdgeColor() const noexcept override;
 
+    // queue scheduling hint, see FrameGraph::QueueHint
+    void setQueueHint(FrameGraph::QueueHint hint) noexcept { mQueueHint = hint; }
+    FrameGraph::QueueHint getQueueHint() const noexcept { return mQueueHint; }
+
     Vector<VirtualResource*> devirtualize;         // resources we need to create before executing
     Vector<VirtualResource*> destroy;              // resources we need to destroy after executing
+
+private:
+    FrameGraph::QueueHint mQueueHint = FrameGraph::QueueHint::GRAPHICS;
 };
 
 class RenderPassNode : public PassNode {
@@ -103,8 +112,10 @@ private:
     const char* const mName = nullptr;
     UniquePtr<FrameGraphPassBase, LinearAllocatorArena> mPassBase;
 
-    // set during setup
-    std::vector<RenderPassData> mRenderTargetData;
+    // set during setup. Passes almost always declare a single render target, which the
+    // inline storage keeps off the heap.
+    using RenderTargetDataContainer = utils::SmallCapacityVector<RenderPassData, 1>;
+    RenderTargetDataContainer mRenderTargetData{ RenderTargetDataContainer::with_capacity(1) };
 };
 
 class PresentPassNode : public PassNode {
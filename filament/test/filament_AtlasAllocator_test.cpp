@@ -152,6 +152,97 @@ TEST(AtlasAllocator, AllocateBySizeOneOfEach) {
 
 }
 
+TEST(AtlasAllocator, FreeAndReallocate) {
+    AtlasAllocator allocator(1024);
+
+    auto a = allocator.allocate(512);
+    auto b = allocator.allocate(512);
+    auto c = allocator.allocate(512);
+
+    EXPECT_EQ(a.layer, 0);
+    EXPECT_EQ(b.layer, 0);
+    EXPECT_EQ(c.layer, 0);
+
+    allocator.free(b);
+
+    // the freed spot is reused
+    auto d = allocator.allocate(512);
+    EXPECT_EQ(d.layer, b.layer);
+    EXPECT_EQ(d.viewport, b.viewport);
+}
+
+TEST(AtlasAllocator, LayerCount) {
+    AtlasAllocator allocator(1024);
+    EXPECT_EQ(allocator.getLayerCount(), 0u);
+
+    auto a = allocator.allocate(1024);
+    auto b = allocator.allocate(1024);
+    auto c = allocator.allocate(1024);
+    EXPECT_EQ(allocator.getLayerCount(), 3u);
+
+    // freeing a layer in the middle doesn't reduce the layer count...
+    allocator.free(b);
+    EXPECT_EQ(allocator.getLayerCount(), 3u);
+
+    // ...freeing the last layer does
+    allocator.free(c);
+    EXPECT_EQ(allocator.getLayerCount(), 1u);
+
+    allocator.free(a);
+    EXPECT_EQ(allocator.getLayerCount(), 0u);
+}
+
+TEST(AtlasAllocator, Defragment) {
+    AtlasAllocator allocator(1024);
+
+    auto a = allocator.allocate(512);
+    auto b = allocator.allocate(512);
+    auto c = allocator.allocate(512);
+    allocator.free(a);
+    allocator.free(b);
+
+    // `c` is now alone in its layer, a single step moves it to `a`'s old spot
+    AtlasAllocator::Relocation r;
+    EXPECT_TRUE(allocator.defragment(r));
+    EXPECT_EQ(r.from.layer, c.layer);
+    EXPECT_EQ(r.from.viewport, c.viewport);
+    EXPECT_EQ(r.to.layer, a.layer);
+    EXPECT_EQ(r.to.viewport, a.viewport);
+
+    // the atlas is compact, there is nothing left to move
+    EXPECT_FALSE(allocator.defragment(r));
+}
+
+TEST(AtlasAllocator, DefragmentLayers) {
+    AtlasAllocator allocator(1024);
+
+    // half-fill layer 0, then push an allocation to layer 1
+    auto a0 = allocator.allocate(512);
+    auto a1 = allocator.allocate(512);
+    EXPECT_EQ(a0.layer, 0);
+    EXPECT_EQ(a1.layer, 0);
+    auto b0 = allocator.allocate(1024);
+    EXPECT_EQ(b0.layer, 1);
+    allocator.free(b0);
+    auto c0 = allocator.allocate(512);
+    auto c1 = allocator.allocate(512);
+    EXPECT_EQ(c0.layer, 0);
+    EXPECT_EQ(c1.layer, 0);
+    auto d0 = allocator.allocate(512);
+    EXPECT_EQ(d0.layer, 1);
+    EXPECT_EQ(allocator.getLayerCount(), 2u);
+
+    // make room in layer 0 and defragment: `d0` moves down, layer 1 can be released
+    allocator.free(c1);
+    AtlasAllocator::Relocation r;
+    EXPECT_TRUE(allocator.defragment(r));
+    EXPECT_EQ(r.from.layer, d0.layer);
+    EXPECT_EQ(r.to.layer, 0);
+    EXPECT_EQ(r.to.viewport, c1.viewport);
+    EXPECT_EQ(allocator.getLayerCount(), 1u);
+    EXPECT_FALSE(allocator.defragment(r));
+}
+
 TEST(AtlasAllocator, AllocateBySizeFullLayers) {
     AtlasAllocator allocator(512);
 
@@ -942,3 +942,50 @@ TEST_F(FrameGraphTest, WriteResourceReadAsAttachment) {
 
     fg.execute(driverApi);
 }
+
+TEST_F(FrameGraphTest, SubpassInput) {
+
+    // this checks that a color attachment read as SUBPASS_INPUT by the pass that renders
+    // into it results in the corresponding bit being set in RenderPassParams::subpassMask,
+    // so the backend creates a second subpass with an input attachment.
+
+    struct PassData {
+        FrameGraphId<FrameGraphTexture> inout;
+        FrameGraphId<FrameGraphTexture> output;
+    };
+    auto& writePass = fg.addPass<PassData>("Write Pass",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                data.inout = builder.create<FrameGraphTexture>("HDR buffer", {.width=16, .height=32});
+                data.inout = builder.write(data.inout, FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+                builder.declareRenderPass("HDR target", { .attachments = {
+                        .color = { data.inout }
+                }});
+            },
+            [=](FrameGraphResources const& resources, auto const&, backend::DriverApi&) {
+                auto rt = resources.getRenderPassInfo();
+                EXPECT_EQ(rt.params.subpassMask, 0);
+            });
+
+    auto& subpassPass = fg.addPass<PassData>("Subpass Pass",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                data.output = builder.create<FrameGraphTexture>("LDR buffer", {.width=16, .height=32});
+                data.inout = builder.read(writePass->inout, FrameGraphTexture::Usage::SUBPASS_INPUT);
+                data.inout = builder.write(data.inout, FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+                data.output = builder.write(data.output, FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+                builder.declareRenderPass("LDR target", { .attachments = {
+                        .color = { data.inout, data.output }
+                }});
+            },
+            [=](FrameGraphResources const& resources, auto const&, backend::DriverApi&) {
+                auto rt = resources.getRenderPassInfo();
+                EXPECT_EQ(rt.params.subpassMask, 1);
+            });
+
+    fg.present(subpassPass->output);
+
+    EXPECT_TRUE(fg.isAcyclic());
+
+    fg.compile();
+
+    fg.execute(driverApi);
+}
@@ -39,6 +39,7 @@
 #include "Allocators.h"
 #include "details/Material.h"
 #include "details/Camera.h"
+#include "details/View.h"
 #include "Froxelizer.h"
 #include "details/Engine.h"
 #include "components/RenderableManager.h"
@@ -595,6 +596,31 @@ TEST(FilamentTest, SphereCulling) {
     EXPECT_TRUE(frustum.intersects({ 0, 200 }));
 }
 
+TEST(FilamentTest, StereoCullingFrustum) {
+    // head camera at the origin looking down -z, eyes offset by +/- 0.5 on x
+    CameraInfo cameraInfo;
+    cameraInfo.cullingProjection = mat4f::frustum(-1, 1, -1, 1, 1, 100);
+    cameraInfo.view = mat4f{};
+    cameraInfo.eyeFromView[0] = mat4f::translation(float3{  0.5f, 0, 0 }); // eye at x = -0.5
+    cameraInfo.eyeFromView[1] = mat4f::translation(float3{ -0.5f, 0, 0 }); // eye at x = +0.5
+
+    Frustum const frustum = FView::computeStereoCullingFrustum(cameraInfo, 2);
+
+    // inside the head frustum
+    EXPECT_LT(frustum.contains({ 0, 0, -10 }), 0);
+
+    // at z = -1.1 the head frustum spans x in [-1.1, 1.1] and each eye frustum extends
+    // 0.5 further on its side; these points are visible to one eye only
+    EXPECT_LT(frustum.contains({ -1.5f, 0, -1.1f }), 0);
+    EXPECT_LT(frustum.contains({  1.5f, 0, -1.1f }), 0);
+
+    // outside of every eye's frustum
+    EXPECT_GT(frustum.contains({ -2.0f, 0, -1.1f }), 0);
+    EXPECT_GT(frustum.contains({  2.0f, 0, -1.1f }), 0);
+    EXPECT_GT(frustum.contains({ 0, 0, -101 }), 0);
+    EXPECT_GT(frustum.contains({ 0, 0, 0 }), 0);
+}
+
 TEST(FilamentTest, ColorConversion) {
     // Linear to Gamma
     // 0.0 stays 0.0
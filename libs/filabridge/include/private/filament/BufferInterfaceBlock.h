@@ -176,6 +176,20 @@ private:
     static uint8_t baseAlignmentForType(Type type) noexcept;
     static uint8_t strideForType(Type type, uint32_t stride) noexcept;
 
+    // Small direct-mapped cache memoizing recent name lookups by the string's address.
+    // Parameter names are almost always string literals with stable addresses, so
+    // repeated per-frame lookups are resolved with a pointer compare and a single
+    // verification compare against the interned copy, instead of hashing the name.
+    // Mutating it from const lookups is safe because all the calls for a given engine
+    // are made from a single thread.
+    struct NameLookupCacheEntry {
+        const char* data = nullptr;
+        uint32_t size = 0;
+        uint32_t index = 0;
+    };
+    static constexpr size_t NAME_LOOKUP_CACHE_SIZE = 8; // must be a power-of-two
+    mutable NameLookupCacheEntry mNameLookupCache[NAME_LOOKUP_CACHE_SIZE];
+
     utils::CString mName;
     utils::FixedCapacityVector<FieldInfo> mFieldInfoList;
     std::unordered_map<std::string_view , uint32_t> mInfoMap;
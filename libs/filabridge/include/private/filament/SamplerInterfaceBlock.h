@@ -127,6 +127,16 @@ private:
 
     explicit SamplerInterfaceBlock(Builder const& builder) noexcept;
 
+    // memoizes recent name lookups by the string's address, see the equivalent cache
+    // in BufferInterfaceBlock
+    struct NameLookupCacheEntry {
+        const char* data = nullptr;
+        uint32_t size = 0;
+        uint32_t index = 0;
+    };
+    static constexpr size_t NAME_LOOKUP_CACHE_SIZE = 8; // must be a power-of-two
+    mutable NameLookupCacheEntry mNameLookupCache[NAME_LOOKUP_CACHE_SIZE];
+
     utils::CString mName;
     backend::ShaderStageFlags mStageFlags{}; // It's needed to check if MAX_SAMPLER_COUNT is exceeded.
     utils::FixedCapacityVector<SamplerInfo> mSamplersInfoList;
@@ -21,6 +21,8 @@
 
 #include <utility>
 
+#include <stdint.h>
+
 using namespace utils;
 
 namespace filament {
@@ -165,9 +167,22 @@ ssize_t BufferInterfaceBlock::getFieldOffset(std::string_view name, size_t index
 
 BufferInterfaceBlock::FieldInfo const* BufferInterfaceBlock::getFieldInfo(
         std::string_view name) const {
+    // fast path: memoized lookup keyed on the string's address (see mNameLookupCache).
+    // The content compare against the interned copy keeps the cache correct even if a
+    // caller reuses a buffer with different contents.
+    auto& entry = mNameLookupCache[
+            (uintptr_t(name.data()) >> 2u) & (NAME_LOOKUP_CACHE_SIZE - 1u)];
+    if (UTILS_LIKELY(entry.data == name.data() && entry.size == name.size())) {
+        FieldInfo const& info = mFieldInfoList[entry.index];
+        std::string_view const interned{ info.name.data(), info.name.size() };
+        if (UTILS_LIKELY(interned == name)) {
+            return &info;
+        }
+    }
     auto pos = mInfoMap.find(name);
     ASSERT_PRECONDITION(pos != mInfoMap.end(),
             "uniform named \"%.*s\" not found", name.size(), name.data());
+    entry = { name.data(), uint32_t(name.size()), pos->second };
     return &mFieldInfoList[pos->second];
 }
 
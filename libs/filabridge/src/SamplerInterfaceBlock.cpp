@@ -92,9 +92,21 @@ SamplerInterfaceBlock::SamplerInterfaceBlock(Builder const& builder) noexcept
 
 const SamplerInterfaceBlock::SamplerInfo* SamplerInterfaceBlock::getSamplerInfo(
         std::string_view name) const {
+    // fast path: memoized lookup keyed on the string's address (see mNameLookupCache),
+    // verified against the interned copy
+    auto& entry = mNameLookupCache[
+            (uintptr_t(name.data()) >> 2u) & (NAME_LOOKUP_CACHE_SIZE - 1u)];
+    if (UTILS_LIKELY(entry.data == name.data() && entry.size == name.size())) {
+        SamplerInfo const& info = mSamplersInfoList[entry.index];
+        std::string_view const interned{ info.name.data(), info.name.size() };
+        if (UTILS_LIKELY(interned == name)) {
+            return &info;
+        }
+    }
     auto pos = mInfoMap.find(name);
     ASSERT_PRECONDITION(pos != mInfoMap.end(), "sampler named \"%.*s\" not found",
             name.size(), name.data());
+    entry = { name.data(), uint32_t(name.size()), pos->second };
     return &mSamplersInfoList[pos->second];
 }
 
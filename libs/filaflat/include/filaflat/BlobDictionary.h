@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAFLAT_BLOB_DICTIONARY_H
+#define TNT_FILAFLAT_BLOB_DICTIONARY_H
+
+#include <utils/compiler.h>
+#include <utils/FixedCapacityVector.h>
+
+#include <stddef.h>
+#include <vector>
+
+namespace filaflat {
+
+using ShaderContent = utils::FixedCapacityVector<uint8_t>;
+
+// Dictionary of shader blobs indexed by MaterialChunk. Entries reference the package's bytes
+// in place and are decoded (decompressed or copied) on first access only, so variants that are
+// never requested never pay the decode cost nor hold decoded memory. The referenced package
+// must outlive the dictionary. Like the rest of filaflat, this class is not thread-safe.
+class UTILS_PUBLIC BlobDictionary {
+public:
+    // Decodes an entry's raw bytes; returns an empty ShaderContent on failure.
+    using Decoder = ShaderContent (*)(const char* data, size_t size);
+
+    void reserve(size_t count) { mEntries.reserve(count); }
+
+    size_t size() const noexcept { return mEntries.size(); }
+
+    // Adds an already-decoded entry.
+    void addBlob(ShaderContent&& content) {
+        mEntries.push_back({ nullptr, 0, nullptr, std::move(content) });
+    }
+
+    // Adds an entry decoded on first access. [data, data + size) must remain valid for the
+    // lifetime of this dictionary.
+    void addLazyBlob(const char* data, size_t size, Decoder decoder) {
+        mEntries.push_back({ data, size, decoder, ShaderContent{} });
+    }
+
+    // Returns the decoded entry, decoding it first if this is its first access. A decode
+    // failure surfaces as an empty ShaderContent.
+    ShaderContent const& operator[](size_t index) const noexcept {
+        Entry& entry = mEntries[index];
+        if (UTILS_UNLIKELY(entry.decoder)) {
+            entry.content = entry.decoder(entry.data, entry.size);
+            entry.decoder = nullptr;
+        }
+        return entry.content;
+    }
+
+    // Mutable access for tools that edit entries in place (e.g. matdbg's shader replacer).
+    ShaderContent& operator[](size_t index) noexcept {
+        return const_cast<ShaderContent&>(
+                static_cast<BlobDictionary const&>(*this)[index]);
+    }
+
+    class const_iterator {
+        BlobDictionary const* mDictionary = nullptr;
+        size_t mIndex = 0;
+    public:
+        const_iterator(BlobDictionary const* dictionary, size_t index) noexcept
+                : mDictionary(dictionary), mIndex(index) {}
+        ShaderContent const& operator*() const noexcept { return (*mDictionary)[mIndex]; }
+        const_iterator& operator++() noexcept { ++mIndex; return *this; }
+        bool operator==(const_iterator const& rhs) const noexcept { return mIndex == rhs.mIndex; }
+        bool operator!=(const_iterator const& rhs) const noexcept { return mIndex != rhs.mIndex; }
+    };
+
+    const_iterator begin() const noexcept { return { this, 0 }; }
+    const_iterator end() const noexcept { return { this, mEntries.size() }; }
+
+private:
+    struct Entry {
+        const char* data;       // raw bytes in the package, unused once decoded
+        size_t size;
+        Decoder decoder;        // null once decoded (or for eager entries)
+        ShaderContent content;
+    };
+    // mutable so that operator[] can decode on demand behind a const dictionary reference
+    mutable std::vector<Entry> mEntries;
+};
+
+} // namespace filaflat
+
+#endif // TNT_FILAFLAT_BLOB_DICTIONARY_H
@@ -22,15 +22,14 @@
 
 #include <filament/MaterialChunkType.h>
 
+#include <filaflat/BlobDictionary.h>
+
 #include <utils/FixedCapacityVector.h>
 
 #include <tsl/robin_map.h>
 
 namespace filaflat {
 
-using ShaderContent = utils::FixedCapacityVector<uint8_t>;
-using BlobDictionary = utils::FixedCapacityVector<ShaderContent>;
-
 class Unflattener;
 
 // Allows to build a map of chunks in a Package and get direct individual access based on chunk ID.
@@ -26,10 +26,34 @@
 
 #include <assert.h>
 
+#include <string.h>
+
 using namespace filamat;
 
 namespace filaflat {
 
+#if defined (FILAMENT_DRIVER_SUPPORTS_VULKAN)
+static ShaderContent decodeSpirvBlob(const char* compressed, size_t compressedSize) {
+    size_t const spirvSize = smolv::GetDecodedBufferSize(compressed, compressedSize);
+    if (spirvSize == 0) {
+        return {};
+    }
+    ShaderContent spirv(spirvSize);
+    if (!smolv::Decode(compressed, compressedSize, spirv.data(), spirvSize)) {
+        return {};
+    }
+    return spirv;
+}
+#endif
+
+static ShaderContent copyTextBlob(const char* str, size_t size) {
+    // BlobDictionary hold binary chunks and does not care if the data holds text, it is
+    // therefore crucial to include the trailing null.
+    ShaderContent content(size);
+    memcpy(content.data(), str, size);
+    return content;
+}
+
 bool DictionaryReader::unflatten(ChunkContainer const& container,
         ChunkContainer::Type dictionaryTag,
         BlobDictionary& dictionary) {
@@ -63,15 +87,9 @@ bool DictionaryReader::unflatten(ChunkContainer const& container,
             assert_invariant((intptr_t(compressed) % 8) == 0);
 
 #if defined (FILAMENT_DRIVER_SUPPORTS_VULKAN)
-            size_t spirvSize = smolv::GetDecodedBufferSize(compressed, compressedSize);
-            if (spirvSize == 0) {
-                return false;
-            }
-            ShaderContent spirv(spirvSize);
-            if (!smolv::Decode(compressed, compressedSize, spirv.data(), spirvSize)) {
-                return false;
-            }
-            dictionary.emplace_back(std::move(spirv));
+            // Only index the compressed bytes here; the smol-v decode runs on first access,
+            // so variants that are never requested are never decompressed.
+            dictionary.addLazyBlob(compressed, compressedSize, decodeSpirvBlob);
 #else
             return false;
 #endif
@@ -90,10 +108,8 @@ bool DictionaryReader::unflatten(ChunkContainer const& container,
             if (!unflattener.read(&str)) {
                 return false;
             }
-            // BlobDictionary hold binary chunks and does not care if the data holds text, it is
-            // therefore crucial to include the trailing null.
-            dictionary.emplace_back(strlen(str) + 1);
-            memcpy(dictionary.back().data(), str, dictionary.back().size());
+            // Lines are copied out of the package on first access only.
+            dictionary.addLazyBlob(str, strlen(str) + 1, copyTextBlob);
         }
         return true;
     }
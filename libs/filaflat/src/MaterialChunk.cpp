@@ -21,6 +21,8 @@
 
 #include <utils/Log.h>
 
+#include <vector>
+
 namespace filaflat {
 
 static inline uint32_t makeKey(
@@ -95,6 +97,23 @@ bool MaterialChunk::initialize(filamat::ChunkType materialTag) {
     return true;
 }
 
+// Reads the line ids of a record stored in full (i.e. with a zero base offset).
+static bool readFullRecordLines(Unflattener& unflattener, std::vector<uint16_t>& lines) {
+    uint32_t lineCount = 0;
+    if (!unflattener.read(&lineCount)) {
+        return false;
+    }
+    lines.reserve(lineCount);
+    for (uint32_t i = 0; i < lineCount; i++) {
+        uint16_t lineIndex;
+        if (!unflattener.read(&lineIndex)) {
+            return false;
+        }
+        lines.push_back(lineIndex);
+    }
+    return true;
+}
+
 bool MaterialChunk::getTextShader(Unflattener unflattener,
         BlobDictionary const& dictionary, ShaderContent& shaderContent,
         ShaderModel shaderModel, Variant variant, ShaderStage shaderStage) {
@@ -122,22 +141,64 @@ bool MaterialChunk::getTextShader(Unflattener unflattener,
         return false;
     }
 
-    // Read how many lines there are.
-    uint32_t lineCount = 0;
-    if (!unflattener.read(&lineCount)){
+    // A non-zero base offset means this record is a delta against a full record: only the
+    // lines differing from the base are stored, plus how many of the base's leading and
+    // trailing lines to reuse.
+    uint32_t baseOffset = 0;
+    if (!unflattener.read(&baseOffset)){
         return false;
     }
 
+    std::vector<uint16_t> lines;
+    if (baseOffset == 0) {
+        if (!readFullRecordLines(unflattener, lines)) {
+            return false;
+        }
+    } else {
+        uint32_t prefixCount = 0;
+        uint32_t suffixCount = 0;
+        uint32_t literalCount = 0;
+        if (!unflattener.read(&prefixCount) ||
+                !unflattener.read(&suffixCount) ||
+                !unflattener.read(&literalCount)) {
+            return false;
+        }
+
+        // Read the base record's lines; base records are always stored in full.
+        Unflattener baseUnflattener{ unflattener };
+        baseUnflattener.setCursor(mBase + baseOffset);
+        uint32_t baseShaderSize = 0;
+        uint32_t baseBaseOffset = 0;
+        if (!baseUnflattener.read(&baseShaderSize) || !baseUnflattener.read(&baseBaseOffset)) {
+            return false;
+        }
+        assert_invariant(baseBaseOffset == 0);
+        std::vector<uint16_t> baseLines;
+        if (!readFullRecordLines(baseUnflattener, baseLines)) {
+            return false;
+        }
+        if (prefixCount + suffixCount > baseLines.size()) {
+            return false;
+        }
+
+        lines.reserve(prefixCount + literalCount + suffixCount);
+        lines.insert(lines.end(), baseLines.begin(), baseLines.begin() + prefixCount);
+        for (uint32_t i = 0; i < literalCount; i++) {
+            uint16_t lineIndex;
+            if (!unflattener.read(&lineIndex)) {
+                return false;
+            }
+            lines.push_back(lineIndex);
+        }
+        lines.insert(lines.end(), baseLines.end() - suffixCount, baseLines.end());
+    }
+
     shaderContent.reserve(shaderSize);
     shaderContent.resize(shaderSize);
     size_t cursor = 0;
 
-    // Read all lines.
-    for(int32_t i = 0 ; i < lineCount; i++) {
-        uint16_t lineIndex;
-        if (!unflattener.read(&lineIndex)) {
-            return false;
-        }
+    // Assemble all lines.
+    for (uint16_t const lineIndex : lines) {
         const auto& content = dictionary[lineIndex];
 
         // Replace null with newline.
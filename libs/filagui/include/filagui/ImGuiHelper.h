@@ -64,7 +64,9 @@ public:
     // Low-level alternative to render() that consumes an ImGui command list and translates it into
     // various Filament calls. This includes updating the vertex buffer, setting up material
     // instances, and rebuilding the Renderable component that encompasses the entire UI. Since this
-    // makes Filament calls, it must be called from the main thread.
+    // makes Filament calls, it must be called from the main thread. Draw lists whose content did
+    // not change since the previous frame are detected via hashing and their buffers are not
+    // re-uploaded; when the entire frame is unchanged this is close to a no-op.
     void processImGuiCommands(ImDrawData* commands, const ImGuiIO& io);
 
     // Helper method called after resolving fontPath; public so fonts can be added by caller.
@@ -87,6 +89,8 @@ public:
       filament::Camera* mCamera = nullptr;
       std::vector<filament::VertexBuffer*> mVertexBuffers;
       std::vector<filament::IndexBuffer*> mIndexBuffers;
+      std::vector<uint64_t> mGeometryHashes; // hash of each draw list's last uploaded geometry
+      size_t mPreviousFrameHash = 0;
       std::vector<filament::MaterialInstance*> mMaterialInstances;
       utils::Entity mRenderable;
       utils::Entity mCameraEntity;
@@ -34,6 +34,7 @@
 #include <filament/VertexBuffer.h>
 
 #include <utils/EntityManager.h>
+#include <utils/Hash.h>
 
 using namespace filament::math;
 using namespace filament;
@@ -176,6 +177,19 @@ void ImGuiHelper::render(float timeStepInSeconds, Callback imguiCommands) {
     processImGuiCommands(ImGui::GetDrawData(), ImGui::GetIO());
 }
 
+// Hashes a draw list's vertex and index data; used to detect draw lists whose geometry did not
+// change since the previous frame, so we can skip re-uploading their buffers.
+static uint64_t hashDrawListGeometry(const ImDrawList* cmds) noexcept {
+    static_assert(0 == (sizeof(ImDrawVert) & 3u), "ImDrawVert size must be a multiple of 4.");
+    uint32_t const vbHash = cmds->VtxBuffer.Size == 0 ? 0u :
+            hash::murmur3((uint32_t const*) cmds->VtxBuffer.Data,
+                    cmds->VtxBuffer.Size * sizeof(ImDrawVert) / 4, 0);
+    uint32_t const ibHash = cmds->IdxBuffer.Size == 0 ? 0u :
+            hash::murmurSlow((uint8_t const*) cmds->IdxBuffer.Data,
+                    cmds->IdxBuffer.Size * sizeof(ImDrawIdx), 0);
+    return (uint64_t(vbHash) << 32u) | ibHash;
+}
+
 void ImGuiHelper::processImGuiCommands(ImDrawData* commands, const ImGuiIO& io) {
     ImGui::SetCurrentContext(mImGuiContext);
 
@@ -189,16 +203,34 @@ void ImGuiHelper::processImGuiCommands(ImDrawData* commands, const ImGuiIO& io)
         return;
     commands->ScaleClipRects(io.DisplayFramebufferScale);
 
-    // Ensure that we have enough vertex buffers and index buffers.
-    createBuffers(commands->CmdListsCount);
-
-    // Count how many primitives we'll need, then create a Renderable builder.
+    // Count how many primitives we'll need and hash the draw data, so that we can skip the
+    // whole translation below -- and the buffer uploads in particular -- when the UI hasn't
+    // changed since the previous frame, which is the common case for a static HUD.
     size_t nPrims = 0;
-    std::unordered_map<uint64_t, filament::MaterialInstance*> scissorRects;
+    size_t frameHash = commands->CmdListsCount;
+    bool hasUserCallbacks = false;
     for (int cmdListIndex = 0; cmdListIndex < commands->CmdListsCount; cmdListIndex++) {
         const ImDrawList* cmds = commands->CmdLists[cmdListIndex];
         nPrims += cmds->CmdBuffer.size();
+        hash::combine_fast(frameHash, hashDrawListGeometry(cmds));
+        if (cmds->CmdBuffer.Size > 0) {
+            hash::combine_fast(frameHash, hash::murmurSlow((uint8_t const*) cmds->CmdBuffer.Data,
+                    cmds->CmdBuffer.Size * sizeof(ImDrawCmd), 0));
+        }
+        for (const auto& pcmd : cmds->CmdBuffer) {
+            hasUserCallbacks = hasUserCallbacks || pcmd.UserCallback != nullptr;
+        }
     }
+
+    // User callbacks must run every frame, so they disable the fast path.
+    if (frameHash == mPreviousFrameHash && !hasUserCallbacks) {
+        return;
+    }
+    mPreviousFrameHash = hasUserCallbacks ? 0 : frameHash;
+
+    // Ensure that we have enough vertex buffers and index buffers.
+    createBuffers(commands->CmdListsCount);
+
     auto rbuilder = RenderableManager::Builder(nPrims);
     rbuilder.boundingBox({{ 0, 0, 0 }, { 10000, 10000, 10000 }}).culling(false);
 
@@ -217,9 +249,13 @@ void ImGuiHelper::processImGuiCommands(ImDrawData* commands, const ImGuiIO& io)
     int primIndex = 0;
     for (int cmdListIndex = 0; cmdListIndex < commands->CmdListsCount; cmdListIndex++) {
         const ImDrawList* cmds = commands->CmdLists[cmdListIndex];
-        populateVertexData(bufferIndex,
-                cmds->VtxBuffer.Size * sizeof(ImDrawVert), cmds->VtxBuffer.Data,
-                cmds->IdxBuffer.Size * sizeof(ImDrawIdx), cmds->IdxBuffer.Data);
+        uint64_t const geometryHash = hashDrawListGeometry(cmds);
+        if (geometryHash != mGeometryHashes[bufferIndex]) {
+            mGeometryHashes[bufferIndex] = geometryHash;
+            populateVertexData(bufferIndex,
+                    cmds->VtxBuffer.Size * sizeof(ImDrawVert), cmds->VtxBuffer.Data,
+                    cmds->IdxBuffer.Size * sizeof(ImDrawIdx), cmds->IdxBuffer.Data);
+        }
         for (const auto& pcmd : cmds->CmdBuffer) {
             if (pcmd.UserCallback) {
                 pcmd.UserCallback(cmds, &pcmd);
@@ -279,6 +315,9 @@ void ImGuiHelper::createIndexBuffer(size_t bufferIndex, size_t capacity) {
 }
 
 void ImGuiHelper::createBuffers(int numRequiredBuffers) {
+    if (numRequiredBuffers > mGeometryHashes.size()) {
+        mGeometryHashes.resize(numRequiredBuffers, 0);
+    }
     if (numRequiredBuffers > mVertexBuffers.size()) {
         size_t previousSize = mVertexBuffers.size();
         mVertexBuffers.resize(numRequiredBuffers, nullptr);
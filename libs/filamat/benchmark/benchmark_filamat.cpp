@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Material compilation benchmarks for filamat, i.e. what matc spends its time on.
+ *
+ * A fixed matrix of representative materials is compiled for each backend target and
+ * optimization level. The phases aren't observable individually through the public
+ * MaterialBuilder API, but the matrix separates them well enough to attribute a
+ * regression: Optimization::NONE stops after codegen + glslang parse, PREPROCESSOR adds
+ * the preprocessor pass, SIZE/PERFORMANCE add spirv-opt, and the target axis isolates
+ * the respective cross-compilers (ESSL for OPENGL, spirv-cross MSL for METAL, SPIRV +
+ * smol-v compression for VULKAN).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <filamat/MaterialBuilder.h>
+
+#include <utils/JobSystem.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+using namespace filamat;
+using namespace utils;
+
+namespace {
+
+// an unlit passthrough, the floor of what a build costs
+constexpr char const* UNLIT_SIMPLE = R"(
+    void material(inout MaterialInputs material) {
+        prepareMaterial(material);
+        material.baseColor = vec4(0.8, 0.1, 0.1, 1.0);
+    }
+)";
+
+// a typical textured lit material
+constexpr char const* LIT_STANDARD = R"(
+    void material(inout MaterialInputs material) {
+        prepareMaterial(material);
+        material.baseColor = texture(materialParams_baseColorMap, getUV0());
+        material.metallic = materialParams.metallic;
+        material.roughness = texture(materialParams_roughnessMap, getUV0()).r;
+    }
+)";
+
+// math-heavy user code, closer to the biggest materials in our apps; this leans on the
+// optimizer and the cross-compilers much harder than the materials above
+constexpr char const* LIT_COMPLEX = R"(
+    float noise(vec3 p) {
+        vec3 i = floor(p);
+        vec3 f = fract(p);
+        f = f * f * (3.0 - 2.0 * f);
+        float n = dot(i, vec3(1.0, 57.0, 113.0));
+        return mix(mix(mix(fract(sin(n +   0.0) * 43758.5453),
+                           fract(sin(n +   1.0) * 43758.5453), f.x),
+                       mix(fract(sin(n +  57.0) * 43758.5453),
+                           fract(sin(n +  58.0) * 43758.5453), f.x), f.y),
+                   mix(mix(fract(sin(n + 113.0) * 43758.5453),
+                           fract(sin(n + 114.0) * 43758.5453), f.x),
+                       mix(fract(sin(n + 170.0) * 43758.5453),
+                           fract(sin(n + 171.0) * 43758.5453), f.x), f.y), f.z);
+    }
+
+    void material(inout MaterialInputs material) {
+        prepareMaterial(material);
+        vec3 p = getWorldPosition();
+        float accum = 0.0;
+        float amplitude = 0.5;
+        for (int i = 0; i < 6; i++) {
+            accum += amplitude * noise(p);
+            p *= 2.01;
+            amplitude *= 0.5;
+        }
+        material.baseColor = mix(materialParams.colorA, materialParams.colorB, accum);
+        material.roughness = clamp(accum + materialParams.roughness, 0.04, 1.0);
+        material.metallic = materialParams.metallic;
+        material.clearCoat = accum * accum;
+    }
+)";
+
+struct MaterialSpec {
+    char const* name;
+    char const* code;
+    MaterialBuilder::Shading shading;
+    bool textured;
+};
+
+constexpr MaterialSpec MATERIALS[] = {
+    { "unlitSimple", UNLIT_SIMPLE, MaterialBuilder::Shading::UNLIT, false },
+    { "litStandard", LIT_STANDARD, MaterialBuilder::Shading::LIT,   true  },
+    { "litComplex",  LIT_COMPLEX,  MaterialBuilder::Shading::LIT,   false },
+};
+
+constexpr std::pair<char const*, MaterialBuilder::TargetApi> TARGETS[] = {
+    { "essl",  MaterialBuilder::TargetApi::OPENGL },
+    { "spirv", MaterialBuilder::TargetApi::VULKAN },
+    { "msl",   MaterialBuilder::TargetApi::METAL  },
+};
+
+constexpr std::pair<char const*, MaterialBuilder::Optimization> OPTIMIZATIONS[] = {
+    { "optNone",         MaterialBuilder::Optimization::NONE },
+    { "optPreprocessor", MaterialBuilder::Optimization::PREPROCESSOR },
+    { "optSize",         MaterialBuilder::Optimization::SIZE },
+    { "optPerformance",  MaterialBuilder::Optimization::PERFORMANCE },
+};
+
+void compileMaterial(benchmark::State& state, MaterialSpec const& spec,
+        MaterialBuilder::TargetApi targetApi, MaterialBuilder::Optimization optimization) {
+    JobSystem jobSystem;
+    jobSystem.adopt();
+    MaterialBuilder::init();
+
+    size_t packageSize = 0;
+    for (auto _ : state) {
+        MaterialBuilder builder;
+        builder.name(spec.name)
+                .material(spec.code)
+                .shading(spec.shading)
+                .platform(MaterialBuilder::Platform::MOBILE)
+                .targetApi(targetApi)
+                .optimization(optimization);
+        if (spec.textured) {
+            builder.parameter("baseColorMap", MaterialBuilder::SamplerType::SAMPLER_2D);
+            builder.parameter("roughnessMap", MaterialBuilder::SamplerType::SAMPLER_2D);
+            builder.parameter("metallic", MaterialBuilder::UniformType::FLOAT);
+            builder.require(MaterialBuilder::VertexAttribute::UV0);
+        } else if (spec.shading == MaterialBuilder::Shading::LIT) {
+            builder.parameter("colorA", MaterialBuilder::UniformType::FLOAT4);
+            builder.parameter("colorB", MaterialBuilder::UniformType::FLOAT4);
+            builder.parameter("roughness", MaterialBuilder::UniformType::FLOAT);
+            builder.parameter("metallic", MaterialBuilder::UniformType::FLOAT);
+        }
+
+        Package const package = builder.build(jobSystem);
+        if (!package.isValid()) {
+            state.SkipWithError("material failed to compile");
+            break;
+        }
+        packageSize = package.getSize();
+        benchmark::DoNotOptimize(packageSize);
+    }
+    state.counters["packageSize"] =
+            benchmark::Counter(double(packageSize), benchmark::Counter::kDefaults);
+
+    MaterialBuilder::shutdown();
+    jobSystem.emancipate();
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    for (auto const& spec : MATERIALS) {
+        for (auto const& [targetName, targetApi] : TARGETS) {
+            for (auto const& [optName, optimization] : OPTIMIZATIONS) {
+                std::string const name = std::string("filamat/") + spec.name
+                        + "/" + targetName + "/" + optName;
+                benchmark::RegisterBenchmark(name.c_str(),
+                        [&spec, targetApi = targetApi, optimization = optimization]
+                        (benchmark::State& state) {
+                            compileMaterial(state, spec, targetApi, optimization);
+                        })->Unit(benchmark::kMillisecond)->UseRealTime();
+            }
+        }
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
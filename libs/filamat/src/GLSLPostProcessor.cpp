@@ -94,6 +94,32 @@ GLSLPostProcessor::GLSLPostProcessor(MaterialBuilder::Optimization optimization,
 
 GLSLPostProcessor::~GLSLPostProcessor() = default;
 
+std::string GLSLPostProcessor::makeCacheKey(const std::string& inputShader,
+        GLSLPostProcessor::Config const& config) {
+    // Everything that can influence the outputs for a given source must be part of the key.
+    // config.materialInfo is deliberately left out: it is identical for all variants compiled
+    // through a given GLSLPostProcessor instance, and so are the optimization/flags settings.
+    char header[80];
+    snprintf(header, sizeof(header), "%u.%u.%u.%u.%u.%u.%u.%u.%u|",
+            unsigned(config.variant.key),
+            unsigned(config.targetApi),
+            unsigned(config.targetLanguage),
+            unsigned(config.shaderType),
+            unsigned(config.shaderModel),
+            unsigned(config.featureLevel),
+            unsigned(config.domain),
+            unsigned(config.hasFramebufferFetch),
+            unsigned(config.usesClipDistance));
+    std::string key;
+    key.reserve(inputShader.size() + sizeof(header) + 16);
+    key.append(header);
+    for (auto const& [subpassInput, color] : config.glsl.subpassInputToColorLocation) {
+        key.append(std::to_string(subpassInput)).append(",").append(std::to_string(color));
+    }
+    key.append("|").append(inputShader);
+    return key;
+}
+
 static bool filterSpvOptimizerMessage(spv_message_level_t level) {
 #ifdef NDEBUG
     // In release builds, only log errors.
@@ -307,6 +333,20 @@ bool GLSLPostProcessor::process(const std::string& inputShader, Config const& co
         return true;
     }
 
+    // An exact duplicate of this compilation may already be cached (different variants often
+    // preprocess to the same source); if so, replay its outputs and skip the expensive
+    // optimization / cross-compilation work entirely.
+    std::string const cacheKey = makeCacheKey(inputShader, config);
+    {
+        std::unique_lock<Mutex> const lock(mCachedResultsLock);
+        if (auto it = mCachedResults.find(cacheKey); it != mCachedResults.end()) {
+            if (outputGlsl)  { *outputGlsl  = it->second.glsl;  }
+            if (outputSpirv) { *outputSpirv = it->second.spirv; }
+            if (outputMsl)   { *outputMsl   = it->second.msl;   }
+            return true;
+        }
+    }
+
     InternalConfig internalConfig{
             .glslOutput = outputGlsl,
             .spirvOutput = outputSpirv,
@@ -420,6 +460,16 @@ bool GLSLPostProcessor::process(const std::string& inputShader, Config const& co
             slog.i << *internalConfig.glslOutput << io::endl;
         }
     }
+
+    {
+        // Only successful compilations are cached. If two jobs race on the same key, both
+        // compute the same deterministic result and the last store wins, which is benign.
+        std::unique_lock<Mutex> const lock(mCachedResultsLock);
+        auto& entry = mCachedResults[cacheKey];
+        if (outputGlsl)  { entry.glsl  = *outputGlsl;  }
+        if (outputSpirv) { entry.spirv = *outputSpirv; }
+        if (outputMsl)   { entry.msl   = *outputMsl;   }
+    }
     return true;
 }
 
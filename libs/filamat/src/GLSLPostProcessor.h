@@ -30,9 +30,11 @@
 #include <backend/DriverEnums.h>
 
 #include <utils/FixedCapacityVector.h>
+#include <utils/Mutex.h>
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace filament {
@@ -114,6 +116,19 @@ private:
 
     void fixupClipDistance(SpirvBlob& spirv, GLSLPostProcessor::Config const& config) const;
 
+    // Content-addressed cache of post-processed results. Different variants frequently
+    // generate byte-identical sources (e.g. when a define doesn't affect a given stage), so
+    // we compile each unique input once and replay the outputs. Guarded by mCachedResultsLock
+    // because process() runs concurrently from MaterialBuilder's jobs.
+    struct CachedResult {
+        std::string glsl;
+        SpirvBlob spirv;
+        std::string msl;
+    };
+    static std::string makeCacheKey(const std::string& inputShader, Config const& config);
+    utils::Mutex mCachedResultsLock;
+    std::unordered_map<std::string, CachedResult> mCachedResults;
+
     const MaterialBuilder::Optimization mOptimization;
     const bool mPrintShaders;
     const bool mGenerateDebugInfo;
@@ -812,11 +812,11 @@ bool MaterialBuilder::generateShaders(JobSystem& jobSystem, const std::vector<Va
     std::atomic_bool cancelJobs(false);
     bool firstJob = true;
 
-    for (const auto& params : mCodeGenPermutations) {
-        if (cancelJobs.load()) {
-            return false;
-        }
+    // All permutations fan out under a single parent so the pool stays saturated across
+    // target APIs -- waiting per permutation would serialize the GLSL/SPIR-V/MSL backends.
+    JobSystem::Job* parent = jobSystem.createJob();
 
+    for (const auto& params : mCodeGenPermutations) {
         const ShaderModel shaderModel = ShaderModel(params.shaderModel);
         const TargetApi targetApi = params.targetApi;
         const TargetLanguage targetLanguage = params.targetLanguage;
@@ -830,11 +830,12 @@ bool MaterialBuilder::generateShaders(JobSystem& jobSystem, const std::vector<Va
         const bool targetApiNeedsMsl = targetApi == TargetApi::METAL;
         const bool targetApiNeedsGlsl = targetApi == TargetApi::OPENGL;
 
-        // Set when a job fails
-        JobSystem::Job* parent = jobSystem.createJob();
-
         for (const auto& v : variants) {
-            JobSystem::Job* job = jobs::createJob(jobSystem, parent, [&]() {
+            // The permutation-local values must be captured by value: the jobs can outlive
+            // this loop iteration now that we only join once, below.
+            JobSystem::Job* job = jobs::createJob(jobSystem, parent,
+                    [&, &params = params, shaderModel, targetApi, targetLanguage, featureLevel,
+                            targetApiNeedsSpirv, targetApiNeedsMsl, targetApiNeedsGlsl]() {
                 if (cancelJobs.load()) {
                     return;
                 }
@@ -964,10 +965,10 @@ bool MaterialBuilder::generateShaders(JobSystem& jobSystem, const std::vector<Va
                 jobSystem.run(job);
             }
         }
-
-        jobSystem.runAndWait(parent);
     }
 
+    jobSystem.runAndWait(parent);
+
     if (cancelJobs.load()) {
         return false;
     }
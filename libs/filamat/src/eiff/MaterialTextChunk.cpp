@@ -16,6 +16,9 @@
 
 #include "MaterialTextChunk.h"
 
+#include <algorithm>
+#include <utility>
+
 namespace filamat {
 
 void MaterialTextChunk::writeEntryAttributes(size_t entryIndex, Flattener& f) const noexcept {
@@ -25,14 +28,10 @@ void MaterialTextChunk::writeEntryAttributes(size_t entryIndex, Flattener& f) co
     f.writeUint8(uint8_t(entry.stage));
 }
 
-void compressShader(std::string_view src, Flattener &f, const LineDictionary& dictionary) {
-    f.writeUint32(static_cast<uint32_t>(src.size() + 1));
-    f.writeValuePlaceholder();
-
-    size_t numLines = 0;
-
+// Expresses a shader as a sequence of dictionary line ids.
+static std::vector<uint16_t> indexLines(std::string_view src, const LineDictionary& dictionary) {
+    std::vector<uint16_t> lines;
     size_t cur = 0;
-
     const char* s = src.data();
     while (s[cur] != '\0') {
         size_t pos = cur;
@@ -49,15 +48,59 @@ void compressShader(std::string_view src, Flattener &f, const LineDictionary& di
         if (index > UINT16_MAX) {
             slog.e << "Dictionary returned line index > UINT16_MAX" << io::endl;
             assert(false);
+            cur++;
             continue;
         }
 
-        f.writeUint16(static_cast<uint16_t>(index));
-        numLines += 1;
-
+        lines.push_back(static_cast<uint16_t>(index));
         cur++;
     }
-    f.writePlaceHoldValue(numLines);
+    return lines;
+}
+
+// Number of leading / trailing line ids shared with the base (non-overlapping).
+static std::pair<size_t, size_t> commonPrefixSuffix(
+        std::vector<uint16_t> const& lines, std::vector<uint16_t> const& base) noexcept {
+    size_t const maxShared = std::min(lines.size(), base.size());
+    size_t prefix = 0;
+    while (prefix < maxShared && lines[prefix] == base[prefix]) {
+        prefix++;
+    }
+    size_t suffix = 0;
+    while (suffix < maxShared - prefix
+            && lines[lines.size() - 1 - suffix] == base[base.size() - 1 - suffix]) {
+        suffix++;
+    }
+    return { prefix, suffix };
+}
+
+void MaterialTextChunk::writeShaderRecord(size_t entryIndex, Flattener& f,
+        std::vector<size_t> const& recordOffsets) const noexcept {
+    std::vector<uint16_t> const& lines = mLineIndices[entryIndex];
+    f.writeUint32(static_cast<uint32_t>(mEntries[entryIndex].shader.size() + 1));
+
+    size_t const baseIndex = mBaseIndex[entryIndex];
+    if (baseIndex == SIZE_MAX) {
+        // Full record: a zero base offset is unambiguous because the first record always
+        // starts past the chunk's index table.
+        f.writeUint32(0);
+        f.writeUint32(static_cast<uint32_t>(lines.size()));
+        for (uint16_t const line : lines) {
+            f.writeUint16(line);
+        }
+    } else {
+        // Delta record: lines shared with the base shader's start and end are not repeated,
+        // only the differing middle section is stored.
+        std::vector<uint16_t> const& base = mLineIndices[baseIndex];
+        auto const [prefix, suffix] = commonPrefixSuffix(lines, base);
+        f.writeUint32(static_cast<uint32_t>(recordOffsets[baseIndex]));
+        f.writeUint32(static_cast<uint32_t>(prefix));
+        f.writeUint32(static_cast<uint32_t>(suffix));
+        f.writeUint32(static_cast<uint32_t>(lines.size() - prefix - suffix));
+        for (size_t i = prefix; i < lines.size() - suffix; i++) {
+            f.writeUint16(lines[i]);
+        }
+    }
 }
 
 void MaterialTextChunk::flatten(Flattener& f) {
@@ -80,8 +123,37 @@ void MaterialTextChunk::flatten(Flattener& f) {
         }
     }
 
+    // Express each unique shader as dictionary line ids and pick, for each one, the base it is
+    // delta-encoded against: the first unique shader of the same model and stage. Variants of a
+    // material are largely identical, so sharing the base's leading and trailing lines typically
+    // collapses a variant to its few differing lines.
+    if (mLineIndices.empty()) {
+        mLineIndices.resize(mEntries.size());
+        mBaseIndex.resize(mEntries.size(), SIZE_MAX);
+        for (size_t i = 0; i < mEntries.size(); i++) {
+            if (mDuplicateMap[i].isDup) {
+                continue;
+            }
+            mLineIndices[i] = indexLines(mEntries[i].shader, mDictionary);
+            for (size_t j = 0; j < i; j++) {
+                if (!mDuplicateMap[j].isDup
+                        && mEntries[j].shaderModel == mEntries[i].shaderModel
+                        && mEntries[j].stage == mEntries[i].stage) {
+                    auto const [prefix, suffix] =
+                            commonPrefixSuffix(mLineIndices[i], mLineIndices[j]);
+                    // a delta only pays for its extra header when enough lines are shared
+                    if (prefix + suffix > 6) {
+                        mBaseIndex[i] = j;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
     // All offsets expressed later will start at the current flattener cursor position
     f.markOffsetBase();
+    size_t const offsetBase = f.getBytesWritten();
 
     // Write how many shaders we have
     f.writeUint64(mEntries.size());
@@ -93,13 +165,16 @@ void MaterialTextChunk::flatten(Flattener& f) {
         f.writeOffsetplaceholder(mapping.isDup ? mapping.dupOfIndex : i);
     }
 
-    // Write all strings
+    // Write all strings. Bases always precede the records that reference them, so their
+    // offsets are known by the time a delta record needs one.
+    std::vector<size_t> recordOffsets(mEntries.size(), 0);
     for (size_t i = 0; i < mEntries.size(); i++) {
         if (mDuplicateMap[i].isDup) {
             continue;
         }
         f.writeOffsets(i);
-        compressShader(mEntries.at(i).shader, f, mDictionary);
+        recordOffsets[i] = f.getBytesWritten() - offsetBase;
+        writeShaderRecord(i, f, recordOffsets);
     }
 }
 
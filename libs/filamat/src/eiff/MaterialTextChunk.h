@@ -37,6 +37,9 @@ private:
 
     void writeEntryAttributes(size_t entryIndex, Flattener& f) const noexcept;
 
+    void writeShaderRecord(size_t entryIndex, Flattener& f,
+            std::vector<size_t> const& recordOffsets) const noexcept;
+
     // Structure to keep track of duplicates.
     struct ShaderMapping {
         bool isDup = false;
@@ -44,6 +47,12 @@ private:
     };
     std::vector<ShaderMapping> mDuplicateMap;
 
+    // Each unique shader expressed as dictionary line ids, and the entry it is delta-encoded
+    // against (SIZE_MAX for records stored in full). Computed once, used by both the dry run
+    // and the actual flattening so the two passes agree on the encoding.
+    std::vector<std::vector<uint16_t>> mLineIndices;
+    std::vector<size_t> mBaseIndex;
+
     const std::vector<TextEntry> mEntries;
     const LineDictionary& mDictionary;
 };
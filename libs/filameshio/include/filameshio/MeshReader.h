@@ -89,6 +89,10 @@ public:
      * file cannot be matched to a material in the registry, a default material is
      * used instead. The default material can be overridden by adding a material
      * named "DefaultMaterial" to the registry.
+     *
+     * On platforms that support it, the file is memory-mapped and its vertex and
+     * index data is referenced in place until the driver has consumed it, so the
+     * mesh data is never copied on the CPU.
      */
     static Mesh loadMeshFromFile(filament::Engine* engine,
             const utils::Path& path,
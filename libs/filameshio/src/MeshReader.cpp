@@ -32,6 +32,7 @@
 #include <utils/Log.h>
 #include <utils/Path.h>
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <map>
@@ -39,6 +40,7 @@
 
 #include <fcntl.h>
 #if !defined(WIN32)
+#    include <sys/mman.h>
 #    include <unistd.h>
 #else
 #    include <io.h>
@@ -157,6 +159,26 @@ static size_t fileSize(int fd) {
     return filesize;
 }
 
+#if !defined(WIN32)
+
+// The vertex and index chunks are referenced in place from the mapped file; the mapping is
+// released once both of their BufferDescriptors have been consumed by the driver.
+struct MappedFile {
+    void* map;
+    size_t size;
+    std::atomic<int> remaining = { 2 };     // one vertex + one index descriptor
+};
+
+static void releaseMappedFile(void*, size_t, void* user) {
+    MappedFile* const mf = static_cast<MappedFile*>(user);
+    if (mf->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        munmap(mf->map, mf->size);
+        delete mf;
+    }
+}
+
+#endif
+
 namespace filamesh {
 
 MeshReader::Mesh MeshReader::loadMeshFromFile(filament::Engine* engine, const utils::Path& path,
@@ -165,8 +187,30 @@ MeshReader::Mesh MeshReader::loadMeshFromFile(filament::Engine* engine, const ut
     Mesh mesh;
 
     int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return mesh;
+    }
 
     size_t size = fileSize(fd);
+
+#if !defined(WIN32)
+    // map the file instead of reading it: the vertex/index chunks are handed to the driver
+    // in place, which copies them straight from the page cache, and there is no need to
+    // fence the GPU before releasing the data
+    void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map != MAP_FAILED) {
+        close(fd);
+        if (!strncmp(MAGICID, (const char*) map, 8)) {
+            MappedFile* const mf = new MappedFile{ map, size };
+            mesh = loadMeshFromBuffer(engine, map, releaseMappedFile, mf, materials);
+        } else {
+            munmap(map, size);
+        }
+        return mesh;
+    }
+    // fall through to the copying path if the file can't be mapped
+#endif
+
     char* data = (char*) malloc(size);
     read(fd, data, size);
 
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_GEOMETRY_MESHLETS_H
+#define TNT_GEOMETRY_MESHLETS_H
+
+#include <math/vec3.h>
+
+#include <utils/compiler.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament {
+namespace geometry {
+
+struct MeshletsBuilderImpl;
+struct MeshletsImpl;
+
+/**
+ * Meshlets splits an indexed triangle mesh into small clusters suitable for GPU-driven
+ * rendering -- e.g. mesh shader dispatch -- or for per-cluster culling on the CPU.
+ *
+ * Each meshlet references a bounded number of unique vertices and triangles of the original
+ * mesh, and carries a bounding sphere plus a normal cone so whole clusters can be rejected
+ * when they fall outside the frustum or face entirely away from the camera. Filament's render
+ * path does not consume meshlets directly yet, so clients are expected to upload the three
+ * arrays exposed here into their own buffers.
+ */
+class UTILS_PUBLIC Meshlets {
+public:
+    /**
+     * One cluster of the source mesh along with its culling data.
+     *
+     * Triangles are stored as 8-bit indices into the meshlet's own slice of the vertex index
+     * array: triangle t of meshlet m spans getTriangleIndices()[m.triangleOffset + 3t .. + 2],
+     * and each such value v resolves to source vertex getVertexIndices()[m.vertexOffset + v].
+     *
+     * A meshlet faces entirely away from a viewer at position eye when
+     *     dot(normalize(coneApex - eye), coneAxis) >= coneCutoff
+     */
+    struct Meshlet {
+        uint32_t vertexOffset;           //!< first entry in getVertexIndices()
+        uint32_t triangleOffset;         //!< first entry in getTriangleIndices()
+        uint32_t vertexCount;            //!< number of unique vertices referenced
+        uint32_t triangleCount;          //!< number of triangles
+        filament::math::float3 center;   //!< bounding sphere center
+        float radius;                    //!< bounding sphere radius
+        filament::math::float3 coneApex; //!< apex of the normal cone
+        filament::math::float3 coneAxis; //!< axis of the normal cone
+        float coneCutoff;                //!< cos(angle / 2) of the normal cone
+    };
+
+    /**
+     * The Builder is used to construct an immutable set of meshlets.
+     *
+     * Clients provide pointers into their own data, which is synchronously consumed during
+     * build(). Positions must be float3 and triangles must be uint3 or ushort3.
+     */
+    class Builder {
+    public:
+        Builder() noexcept;
+        ~Builder() noexcept;
+        Builder(Builder&& that) noexcept;
+        Builder& operator=(Builder&& that) noexcept;
+
+        /**
+         * This attribute is required.
+         */
+        Builder& vertexCount(size_t vertexCount) noexcept;
+
+        Builder& positions(const filament::math::float3*, size_t stride = 0) noexcept;
+
+        Builder& triangleCount(size_t triangleCount) noexcept;
+        Builder& triangles(const filament::math::uint3*) noexcept;
+        Builder& triangles(const filament::math::ushort3*) noexcept;
+
+        /**
+         * Maximum number of unique vertices per meshlet, at most 255. Defaults to 64, a good
+         * fit for the mesh shader workgroup sizes of current hardware.
+         */
+        Builder& maxVertices(size_t maxVertices) noexcept;
+
+        /**
+         * Maximum number of triangles per meshlet, at most 512 and rounded down to a multiple
+         * of 4. Defaults to 124.
+         */
+        Builder& maxTriangles(size_t maxTriangles) noexcept;
+
+        /**
+         * Weight given to normal cone quality during clustering, in [0, 1]. Higher values
+         * yield tighter cones -- better backface culling -- at the cost of slightly more
+         * meshlets. Defaults to 0.
+         */
+        Builder& coneWeight(float coneWeight) noexcept;
+
+        /**
+         * Generates meshlets, or returns null if the submitted data is incomplete.
+         */
+        Meshlets* build();
+
+    private:
+        MeshletsBuilderImpl* mImpl;
+        Builder(const Builder&) = delete;
+        Builder& operator=(const Builder&) = delete;
+    };
+
+    ~Meshlets() noexcept;
+    Meshlets(Meshlets&& that) noexcept;
+    Meshlets& operator=(Meshlets&& that) noexcept;
+
+    /**
+     * Returns the number of generated meshlets.
+     */
+    size_t getMeshletCount() const noexcept;
+    const Meshlet* getMeshlets() const noexcept;
+
+    /**
+     * Returns the indices into the source vertex buffer, shared by all meshlets.
+     */
+    const uint32_t* getVertexIndices() const noexcept;
+    size_t getVertexIndexCount() const noexcept;
+
+    /**
+     * Returns the per-meshlet 8-bit triangle indices, 3 per triangle.
+     */
+    const uint8_t* getTriangleIndices() const noexcept;
+    size_t getTriangleIndexCount() const noexcept;
+
+private:
+    Meshlets(MeshletsImpl*) noexcept;
+    Meshlets(const Meshlets&) = delete;
+    Meshlets& operator=(const Meshlets&) = delete;
+    MeshletsImpl* mImpl;
+    friend struct MeshletsBuilderImpl;
+};
+
+} // namespace geometry
+} // namespace filament
+
+#endif // TNT_GEOMETRY_MESHLETS_H
@@ -23,6 +23,10 @@
 
 #include <utils/compiler.h>
 
+namespace utils {
+class JobSystem;
+}
+
 namespace filament {
 
 /**
@@ -84,6 +88,15 @@ public:
         Builder& triangles(const filament::math::uint3*) noexcept;
         Builder& triangles(const filament::math::ushort3*) noexcept;
 
+        /**
+         * Optional JobSystem used to parallelize the computation within a single mesh.
+         *
+         * When supplied, large meshes are processed across multiple threads; results are
+         * bitwise identical to the single-threaded path. build() still blocks until the
+         * computation is complete, and may itself be called from inside a job.
+         */
+        Builder& jobSystem(utils::JobSystem* jobSystem) noexcept;
+
         /**
          * Generates quats or returns null if the submitted data is an incomplete combination.
          */
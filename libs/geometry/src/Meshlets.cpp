@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <geometry/Meshlets.h>
+
+#include <utils/Panic.h>
+
+#include <meshoptimizer.h>
+
+#include <utility>
+#include <vector>
+
+namespace filament {
+namespace geometry {
+
+using namespace filament::math;
+using std::vector;
+using Builder = Meshlets::Builder;
+
+struct MeshletsBuilderImpl {
+    size_t vertexCount = 0;
+    const float3* positions = nullptr;
+    size_t positionStride = 0;
+    const uint3* triangles32 = nullptr;
+    const ushort3* triangles16 = nullptr;
+    size_t triangleCount = 0;
+    size_t maxVertices = 64;
+    size_t maxTriangles = 124;
+    float coneWeight = 0.0f;
+    Meshlets* build();
+};
+
+struct MeshletsImpl {
+    vector<Meshlets::Meshlet> meshlets;
+    vector<uint32_t> vertexIndices;
+    vector<uint8_t> triangleIndices;
+};
+
+Builder::Builder() noexcept : mImpl(new MeshletsBuilderImpl) {}
+
+Builder::~Builder() noexcept { delete mImpl; }
+
+Builder::Builder(Builder&& that) noexcept {
+    std::swap(mImpl, that.mImpl);
+}
+
+Builder& Builder::operator=(Builder&& that) noexcept {
+    std::swap(mImpl, that.mImpl);
+    return *this;
+}
+
+Builder& Builder::vertexCount(size_t vertexCount) noexcept {
+    mImpl->vertexCount = vertexCount;
+    return *this;
+}
+
+Builder& Builder::positions(const float3* positions, size_t stride) noexcept {
+    mImpl->positions = positions;
+    mImpl->positionStride = stride;
+    return *this;
+}
+
+Builder& Builder::triangleCount(size_t triangleCount) noexcept {
+    mImpl->triangleCount = triangleCount;
+    return *this;
+}
+
+Builder& Builder::triangles(const uint3* triangles) noexcept {
+    mImpl->triangles32 = triangles;
+    return *this;
+}
+
+Builder& Builder::triangles(const ushort3* triangles) noexcept {
+    mImpl->triangles16 = triangles;
+    return *this;
+}
+
+Builder& Builder::maxVertices(size_t maxVertices) noexcept {
+    mImpl->maxVertices = maxVertices;
+    return *this;
+}
+
+Builder& Builder::maxTriangles(size_t maxTriangles) noexcept {
+    mImpl->maxTriangles = maxTriangles;
+    return *this;
+}
+
+Builder& Builder::coneWeight(float coneWeight) noexcept {
+    mImpl->coneWeight = coneWeight;
+    return *this;
+}
+
+Meshlets* Builder::build() {
+    if (!ASSERT_PRECONDITION_NON_FATAL(mImpl->vertexCount > 0, "Vertex count must be non-zero.")) {
+        return nullptr;
+    }
+    if (!ASSERT_PRECONDITION_NON_FATAL(mImpl->positions, "Positions are required.")) {
+        return nullptr;
+    }
+    if (!ASSERT_PRECONDITION_NON_FATAL(mImpl->triangleCount > 0, "Triangle count is required.")) {
+        return nullptr;
+    }
+    if (!ASSERT_PRECONDITION_NON_FATAL(mImpl->triangles16 || mImpl->triangles32,
+            "Triangles are required.")) {
+        return nullptr;
+    }
+    if (!ASSERT_PRECONDITION_NON_FATAL(!mImpl->triangles16 || !mImpl->triangles32,
+            "Choose 16 or 32-bit indices, not both.")) {
+        return nullptr;
+    }
+    if (!ASSERT_PRECONDITION_NON_FATAL(mImpl->maxVertices > 0 && mImpl->maxVertices <= 255,
+            "maxVertices must be in [1, 255].")) {
+        return nullptr;
+    }
+    if (!ASSERT_PRECONDITION_NON_FATAL(mImpl->maxTriangles >= 4 && mImpl->maxTriangles <= 512,
+            "maxTriangles must be in [4, 512].")) {
+        return nullptr;
+    }
+    return mImpl->build();
+}
+
+Meshlets* MeshletsBuilderImpl::build() {
+    const size_t indexCount = triangleCount * 3;
+    const size_t clampedMaxTriangles = maxTriangles & ~size_t(3); // multiple of 4 per meshopt
+
+    // meshopt reads positions as strided floats; repack only when the stride rules that out.
+    const float* vertexPositions = &positions->x;
+    size_t vertexPositionsStride = positionStride ? positionStride : sizeof(float3);
+    vector<float3> packedPositions;
+    if (vertexPositionsStride % sizeof(float) != 0) {
+        packedPositions.resize(vertexCount);
+        const uint8_t* src = (const uint8_t*) positions;
+        for (size_t i = 0; i < vertexCount; ++i, src += vertexPositionsStride) {
+            packedPositions[i] = *(const float3*) src;
+        }
+        vertexPositions = &packedPositions.data()->x;
+        vertexPositionsStride = sizeof(float3);
+    }
+
+    const size_t maxMeshlets =
+            meshopt_buildMeshletsBound(indexCount, maxVertices, clampedMaxTriangles);
+    vector<meshopt_Meshlet> meshlets(maxMeshlets);
+    vector<unsigned int> vertexIndices(maxMeshlets * maxVertices);
+    vector<unsigned char> triangleIndices(maxMeshlets * clampedMaxTriangles * 3);
+
+    size_t meshletCount;
+    if (triangles32) {
+        meshletCount = meshopt_buildMeshlets(meshlets.data(), vertexIndices.data(),
+                triangleIndices.data(), &triangles32->x, indexCount, vertexPositions,
+                vertexCount, vertexPositionsStride, maxVertices, clampedMaxTriangles,
+                coneWeight);
+    } else {
+        meshletCount = meshopt_buildMeshlets(meshlets.data(), vertexIndices.data(),
+                triangleIndices.data(), &triangles16->x, indexCount, vertexPositions,
+                vertexCount, vertexPositionsStride, maxVertices, clampedMaxTriangles,
+                coneWeight);
+    }
+
+    // Trim the conservatively sized arrays using the offsets of the last meshlet, then compute
+    // the culling data for each cluster.
+    MeshletsImpl* result = new MeshletsImpl;
+    result->meshlets.reserve(meshletCount);
+    const meshopt_Meshlet& last = meshlets[meshletCount - 1];
+    result->vertexIndices.assign(vertexIndices.begin(),
+            vertexIndices.begin() + last.vertex_offset + last.vertex_count);
+    result->triangleIndices.assign(triangleIndices.begin(),
+            triangleIndices.begin() + last.triangle_offset + last.triangle_count * 3);
+
+    for (size_t i = 0; i < meshletCount; ++i) {
+        const meshopt_Meshlet& m = meshlets[i];
+        const meshopt_Bounds bounds = meshopt_computeMeshletBounds(
+                &vertexIndices[m.vertex_offset], &triangleIndices[m.triangle_offset],
+                m.triangle_count, vertexPositions, vertexCount, vertexPositionsStride);
+        result->meshlets.push_back({
+            .vertexOffset = m.vertex_offset,
+            .triangleOffset = m.triangle_offset,
+            .vertexCount = m.vertex_count,
+            .triangleCount = m.triangle_count,
+            .center = { bounds.center[0], bounds.center[1], bounds.center[2] },
+            .radius = bounds.radius,
+            .coneApex = { bounds.cone_apex[0], bounds.cone_apex[1], bounds.cone_apex[2] },
+            .coneAxis = { bounds.cone_axis[0], bounds.cone_axis[1], bounds.cone_axis[2] },
+            .coneCutoff = bounds.cone_cutoff,
+        });
+    }
+
+    return new Meshlets(result);
+}
+
+Meshlets::Meshlets(MeshletsImpl* impl) noexcept : mImpl(impl) {}
+
+Meshlets::~Meshlets() noexcept { delete mImpl; }
+
+Meshlets::Meshlets(Meshlets&& that) noexcept {
+    std::swap(mImpl, that.mImpl);
+}
+
+Meshlets& Meshlets::operator=(Meshlets&& that) noexcept {
+    std::swap(mImpl, that.mImpl);
+    return *this;
+}
+
+size_t Meshlets::getMeshletCount() const noexcept {
+    return mImpl->meshlets.size();
+}
+
+const Meshlets::Meshlet* Meshlets::getMeshlets() const noexcept {
+    return mImpl->meshlets.data();
+}
+
+const uint32_t* Meshlets::getVertexIndices() const noexcept {
+    return mImpl->vertexIndices.data();
+}
+
+size_t Meshlets::getVertexIndexCount() const noexcept {
+    return mImpl->vertexIndices.size();
+}
+
+const uint8_t* Meshlets::getTriangleIndices() const noexcept {
+    return mImpl->triangleIndices.data();
+}
+
+size_t Meshlets::getTriangleIndexCount() const noexcept {
+    return mImpl->triangleIndices.size();
+}
+
+} // namespace geometry
+} // namespace filament
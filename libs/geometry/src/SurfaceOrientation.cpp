@@ -16,12 +16,14 @@
 
 #include <geometry/SurfaceOrientation.h>
 
+#include <utils/JobSystem.h>
 #include <utils/Panic.h>
 #include <utils/debug.h>
 
 #include <math/mat3.h>
 #include <math/norm.h>
 
+#include <utility>
 #include <vector>
 
 namespace filament {
@@ -44,6 +46,7 @@ struct OrientationBuilderImpl {
     size_t uvStride = 0;
     size_t positionStride = 0;
     size_t triangleCount = 0;
+    utils::JobSystem* jobSystem = nullptr;
     SurfaceOrientation* buildWithNormalsOnly();
     SurfaceOrientation* buildWithSuppliedTangents();
     SurfaceOrientation* buildWithUvs();
@@ -111,6 +114,26 @@ Builder& Builder::triangles(const ushort3* triangles) noexcept {
     return *this;
 }
 
+Builder& Builder::jobSystem(utils::JobSystem* jobSystem) noexcept {
+    mImpl->jobSystem = jobSystem;
+    return *this;
+}
+
+// Runs func(start, count) over [0, count), parallelized across the JobSystem when one was
+// supplied and the range is large enough to amortize job overhead. Each invocation must only
+// write to its own sub-range so that the result matches the serial loop.
+template<typename F>
+static void parallelRange(utils::JobSystem* js, size_t count, F func) {
+    constexpr size_t MIN_PARALLEL_COUNT = 16384;
+    if (js == nullptr || count < MIN_PARALLEL_COUNT) {
+        func(size_t(0), count);
+        return;
+    }
+    auto* job = utils::jobs::parallel_for(*js, nullptr, uint32_t(0), uint32_t(count),
+            std::move(func), utils::jobs::CountSplitter<4096>());
+    js->runAndWait(job);
+}
+
 SurfaceOrientation* Builder::build() {
     if (!ASSERT_PRECONDITION_NON_FATAL(mImpl->vertexCount > 0, "Vertex count must be non-zero.")) {
         return nullptr;
@@ -173,16 +196,17 @@ static void frisvadTangentSpace(const float3& N, float3& T, float3& B) {
 SurfaceOrientation* OrientationBuilderImpl::buildWithNormalsOnly() {
     vector<quatf> quats(vertexCount);
 
-    const float3* normal = this->normals;
-    size_t nstride = this->normalStride ? this->normalStride : sizeof(float3);
-
-    for (size_t qindex = 0; qindex < vertexCount; ++qindex) {
-        float3 n = *normal;
-        float3 b, t;
-        frisvadTangentSpace(n, t, b);
-        quats[qindex] = mat3f::packTangentFrame({t, b, n});
-        normal = (const float3*) (((const uint8_t*) normal) + nstride);
-    }
+    parallelRange(jobSystem, vertexCount, [this, quats = quats.data()](size_t start, size_t count) {
+        size_t const nstride = this->normalStride ? this->normalStride : sizeof(float3);
+        const float3* normal = (const float3*) (((const uint8_t*) this->normals) + start * nstride);
+        for (size_t qindex = start, end = start + count; qindex < end; ++qindex) {
+            float3 n = *normal;
+            float3 b, t;
+            frisvadTangentSpace(n, t, b);
+            quats[qindex] = mat3f::packTangentFrame({t, b, n});
+            normal = (const float3*) (((const uint8_t*) normal) + nstride);
+        }
+    });
 
     return new SurfaceOrientation(new OrientationImpl( { std::move(quats) } ));
 }
@@ -190,29 +214,33 @@ SurfaceOrientation* OrientationBuilderImpl::buildWithNormalsOnly() {
 SurfaceOrientation* OrientationBuilderImpl::buildWithSuppliedTangents() {
     vector<quatf> quats(vertexCount);
 
-    const float3* normal = this->normals;
-    size_t nstride = this->normalStride ? this->normalStride : sizeof(float3);
-
-    const float3* tanvec = (const float3*) this->tangents;
-    const float* tandir = &this->tangents->w;
-    size_t tstride = this->tangentStride ? this->tangentStride : sizeof(float4);
-
-    for (size_t qindex = 0; qindex < vertexCount; ++qindex) {
-        float3 n = *normal;
-        float3 t = *tanvec;
-        float3 b = *tandir > 0 ? cross(t, n) : cross(n, t);
-
-        // Some assets do not provide perfectly orthogonal tangents and normals, so we adjust the
-        // tangent to enforce orthonormality. We would rather honor the exact normal vector than
-        // the exact tangent vector since the latter is only used for bump mapping and anisotropic
-        // lighting.
-        t = *tandir > 0 ? cross(n, b) : cross(b, n);
-
-        quats[qindex] = mat3f::packTangentFrame({t, b, n});
-        normal = (const float3*) (((const uint8_t*) normal) + nstride);
-        tanvec = (const float3*) (((const uint8_t*) tanvec) + tstride);
-        tandir = (const float*) (((const uint8_t*) tandir) + tstride);
-    }
+    parallelRange(jobSystem, vertexCount, [this, quats = quats.data()](size_t start, size_t count) {
+        size_t const nstride = this->normalStride ? this->normalStride : sizeof(float3);
+        size_t const tstride = this->tangentStride ? this->tangentStride : sizeof(float4);
+        const float3* normal =
+                (const float3*) (((const uint8_t*) this->normals) + start * nstride);
+        const float3* tanvec =
+                (const float3*) (((const uint8_t*) this->tangents) + start * tstride);
+        const float* tandir =
+                (const float*) (((const uint8_t*) &this->tangents->w) + start * tstride);
+
+        for (size_t qindex = start, end = start + count; qindex < end; ++qindex) {
+            float3 n = *normal;
+            float3 t = *tanvec;
+            float3 b = *tandir > 0 ? cross(t, n) : cross(n, t);
+
+            // Some assets do not provide perfectly orthogonal tangents and normals, so we adjust
+            // the tangent to enforce orthonormality. We would rather honor the exact normal vector
+            // than the exact tangent vector since the latter is only used for bump mapping and
+            // anisotropic lighting.
+            t = *tandir > 0 ? cross(n, b) : cross(b, n);
+
+            quats[qindex] = mat3f::packTangentFrame({t, b, n});
+            normal = (const float3*) (((const uint8_t*) normal) + nstride);
+            tanvec = (const float3*) (((const uint8_t*) tanvec) + tstride);
+            tandir = (const float*) (((const uint8_t*) tandir) + tstride);
+        }
+    });
 
     return new SurfaceOrientation(new OrientationImpl( { std::move(quats) } ));
 }
@@ -239,67 +267,89 @@ SurfaceOrientation* OrientationBuilderImpl::buildWithUvs() {
     if (!ASSERT_PRECONDITION_NON_FATAL(this->positionStride == 0, "Non-zero positions stride not yet supported.")) {
         return nullptr;
     }
+    // The expensive per-triangle math runs in parallel and writes each triangle's contribution
+    // to its own slot. The scatter to shared vertices below stays serial and in triangle order,
+    // so the result is bitwise identical to the single-threaded loop regardless of thread count.
+    struct Facet {
+        float3 sdir;
+        float3 tdir;
+    };
+    vector<Facet> facets(triangleCount);
+    parallelRange(jobSystem, triangleCount,
+            [this, facets = facets.data()](size_t start, size_t count) {
+        for (size_t a = start, end = start + count; a < end; ++a) {
+            uint3 tri = triangles16 ? uint3(triangles16[a]) : triangles32[a];
+            assert_invariant(tri.x < vertexCount && tri.y < vertexCount && tri.z < vertexCount);
+            const float3& v1 = positions[tri.x];
+            const float3& v2 = positions[tri.y];
+            const float3& v3 = positions[tri.z];
+            const float2& w1 = uvs[tri.x];
+            const float2& w2 = uvs[tri.y];
+            const float2& w3 = uvs[tri.z];
+            float x1 = v2.x - v1.x;
+            float x2 = v3.x - v1.x;
+            float y1 = v2.y - v1.y;
+            float y2 = v3.y - v1.y;
+            float z1 = v2.z - v1.z;
+            float z2 = v3.z - v1.z;
+            float s1 = w2.x - w1.x;
+            float s2 = w3.x - w1.x;
+            float t1 = w2.y - w1.y;
+            float t2 = w3.y - w1.y;
+            float d = s1 * t2 - s2 * t1;
+            float3 sdir, tdir;
+            // In general we can't guarantee smooth tangents when the UV's are non-smooth, but
+            // let's at least avoid divide-by-zero and fall back to normals-only method.
+            if (d == 0.0) {
+                const float3& n1 = normals[tri.x];
+                sdir = randomPerp(n1);
+                tdir = cross(n1, sdir);
+            } else {
+                sdir = {t2 * x1 - t1 * x2, t2 * y1 - t1 * y2, t2 * z1 - t1 * z2};
+                tdir = {s1 * x2 - s2 * x1, s1 * y2 - s2 * y1, s1 * z2 - s2 * z1};
+                float r = 1.0f / d;
+                sdir *= r;
+                tdir *= r;
+            }
+            facets[a] = {sdir, tdir};
+        }
+    });
+
     vector<float3> tan1(vertexCount);
     vector<float3> tan2(vertexCount);
     memset(tan1.data(), 0, sizeof(float3) * vertexCount);
     memset(tan2.data(), 0, sizeof(float3) * vertexCount);
     for (size_t a = 0; a < triangleCount; ++a) {
         uint3 tri = triangles16 ? uint3(triangles16[a]) : triangles32[a];
-        assert_invariant(tri.x < vertexCount && tri.y < vertexCount && tri.z < vertexCount);
-        const float3& v1 = positions[tri.x];
-        const float3& v2 = positions[tri.y];
-        const float3& v3 = positions[tri.z];
-        const float2& w1 = uvs[tri.x];
-        const float2& w2 = uvs[tri.y];
-        const float2& w3 = uvs[tri.z];
-        float x1 = v2.x - v1.x;
-        float x2 = v3.x - v1.x;
-        float y1 = v2.y - v1.y;
-        float y2 = v3.y - v1.y;
-        float z1 = v2.z - v1.z;
-        float z2 = v3.z - v1.z;
-        float s1 = w2.x - w1.x;
-        float s2 = w3.x - w1.x;
-        float t1 = w2.y - w1.y;
-        float t2 = w3.y - w1.y;
-        float d = s1 * t2 - s2 * t1;
-        float3 sdir, tdir;
-        // In general we can't guarantee smooth tangents when the UV's are non-smooth, but let's at
-        // least avoid divide-by-zero and fall back to normals-only method.
-        if (d == 0.0) {
-            const float3& n1 = normals[tri.x];
-            sdir = randomPerp(n1);
-            tdir = cross(n1, sdir);
-        } else {
-            sdir = {t2 * x1 - t1 * x2, t2 * y1 - t1 * y2, t2 * z1 - t1 * z2};
-            tdir = {s1 * x2 - s2 * x1, s1 * y2 - s2 * y1, s1 * z2 - s2 * z1};
-            float r = 1.0f / d;
-            sdir *= r;
-            tdir *= r;
-        }
-        tan1[tri.x] += sdir;
-        tan1[tri.y] += sdir;
-        tan1[tri.z] += sdir;
-        tan2[tri.x] += tdir;
-        tan2[tri.y] += tdir;
-        tan2[tri.z] += tdir;
+        const Facet& facet = facets[a];
+        tan1[tri.x] += facet.sdir;
+        tan1[tri.y] += facet.sdir;
+        tan1[tri.z] += facet.sdir;
+        tan2[tri.x] += facet.tdir;
+        tan2[tri.y] += facet.tdir;
+        tan2[tri.z] += facet.tdir;
     }
+    facets = vector<Facet>();
 
     vector<quatf> quats(vertexCount);
-    for (size_t a = 0; a < vertexCount; a++) {
-        const float3& n = normals[a];
-        const float3& t1 = tan1[a];
-        const float3& t2 = tan2[a];
-
-        // Gram-Schmidt orthogonalize
-        float3 t = normalize(t1 - n * dot(n, t1));
-
-        // Calculate handedness
-        float w = (dot(cross(n, t1), t2) < 0.0f) ? -1.0f : 1.0f;
-
-        float3 b = w < 0 ? cross(t, n) : cross(n, t);
-        quats[a] = mat3f::packTangentFrame({t, b, n});
-    }
+    parallelRange(jobSystem, vertexCount,
+            [this, quats = quats.data(), tan1 = tan1.data(), tan2 = tan2.data()](
+                    size_t start, size_t count) {
+        for (size_t a = start, end = start + count; a < end; ++a) {
+            const float3& n = normals[a];
+            const float3& t1 = tan1[a];
+            const float3& t2 = tan2[a];
+
+            // Gram-Schmidt orthogonalize
+            float3 t = normalize(t1 - n * dot(n, t1));
+
+            // Calculate handedness
+            float w = (dot(cross(n, t1), t2) < 0.0f) ? -1.0f : 1.0f;
+
+            float3 b = w < 0 ? cross(t, n) : cross(n, t);
+            quats[a] = mat3f::packTangentFrame({t, b, n});
+        }
+    });
     return new SurfaceOrientation(new OrientationImpl( { std::move(quats) } ));
 }
 
@@ -18,11 +18,39 @@
 
 #include <math/half.h>
 
+#include <string.h>
+
 using filament::math::half;
 
 namespace filament {
 namespace geometry {
 
+// Fast path for tightly packed input, where the per-vertex structure is irrelevant and the whole
+// attribute array can be converted as one flat stream of components. The contiguous loads and
+// stores let the compiler auto-vectorize this into the same widen/convert/multiply SIMD sequence
+// (SSE/NEON) that a hand-written kernel would use, without the portability cost of intrinsics.
+template<typename SOURCE_TYPE, int NORMALIZATION_FACTOR>
+void convertPacked(float* UTILS_RESTRICT target, void const* UTILS_RESTRICT source,
+        size_t componentCount) noexcept {
+    constexpr float scale = 1.0f / float(NORMALIZATION_FACTOR);
+    SOURCE_TYPE const* UTILS_RESTRICT src = (SOURCE_TYPE const*) source;
+    for (size_t n = 0; n < componentCount; ++n) {
+        target[n] = float(src[n]) * scale;
+    }
+}
+
+// Flat variant of convertClamped (see below) for tightly packed input.
+template<typename SOURCE_TYPE, int NORMALIZATION_FACTOR>
+void convertClampedPacked(float* UTILS_RESTRICT target, void const* UTILS_RESTRICT source,
+        size_t componentCount) noexcept {
+    constexpr float scale = 1.0f / float(NORMALIZATION_FACTOR);
+    SOURCE_TYPE const* UTILS_RESTRICT src = (SOURCE_TYPE const*) source;
+    for (size_t n = 0; n < componentCount; ++n) {
+        const float value = float(src[n]) * scale;
+        target[n] = value < -1.0f ? -1.0f : value;
+    }
+}
+
 // The internal workhorse function of the Transcoder, which takes arbitrary input but always
 // produced packed floats. We expose a more readable interface than this to users, who often have
 // untyped blobs of interleaved data. Note that this variant takes an arbitrary number of
@@ -95,6 +123,14 @@ size_t Transcoder::operator()(float* UTILS_RESTRICT target, void const* UTILS_RE
     switch (mConfig.componentType) {
         case ComponentType::BYTE: {
             const uint32_t stride = mConfig.inputStrideBytes ? mConfig.inputStrideBytes : comp;
+            if (stride == comp) {
+                if (mConfig.normalized) {
+                    convertClampedPacked<int8_t, 127>(target, source, count * comp);
+                } else {
+                    convertPacked<int8_t, 1>(target, source, count * comp);
+                }
+                return required;
+            }
             if (mConfig.normalized) {
                 if (comp == 2) {
                     convertClamped<int8_t, 127, 2>(target, source, count, stride);
@@ -116,6 +152,14 @@ size_t Transcoder::operator()(float* UTILS_RESTRICT target, void const* UTILS_RE
         }
         case ComponentType::UBYTE: {
             const uint32_t stride = mConfig.inputStrideBytes ? mConfig.inputStrideBytes : comp;
+            if (stride == comp) {
+                if (mConfig.normalized) {
+                    convertPacked<uint8_t, 255>(target, source, count * comp);
+                } else {
+                    convertPacked<uint8_t, 1>(target, source, count * comp);
+                }
+                return required;
+            }
             if (mConfig.normalized) {
                 if (comp == 2) {
                     convert<uint8_t, 255, 2>(target, source, count, stride);
@@ -137,6 +181,14 @@ size_t Transcoder::operator()(float* UTILS_RESTRICT target, void const* UTILS_RE
         }
         case ComponentType::SHORT: {
             const uint32_t stride = mConfig.inputStrideBytes ? mConfig.inputStrideBytes : (2 * comp);
+            if (stride == 2 * comp) {
+                if (mConfig.normalized) {
+                    convertClampedPacked<int16_t, 32767>(target, source, count * comp);
+                } else {
+                    convertPacked<int16_t, 1>(target, source, count * comp);
+                }
+                return required;
+            }
             if (mConfig.normalized) {
                 if (comp == 2) {
                     convertClamped<int16_t, 32767, 2>(target, source, count, stride);
@@ -158,6 +210,14 @@ size_t Transcoder::operator()(float* UTILS_RESTRICT target, void const* UTILS_RE
         }
         case ComponentType::USHORT: {
             const uint32_t stride = mConfig.inputStrideBytes ? mConfig.inputStrideBytes : (2 * comp);
+            if (stride == 2 * comp) {
+                if (mConfig.normalized) {
+                    convertPacked<uint16_t, 65535>(target, source, count * comp);
+                } else {
+                    convertPacked<uint16_t, 1>(target, source, count * comp);
+                }
+                return required;
+            }
             if (mConfig.normalized) {
                 if (comp == 2) {
                     convert<uint16_t, 65535, 2>(target, source, count, stride);
@@ -179,6 +239,15 @@ size_t Transcoder::operator()(float* UTILS_RESTRICT target, void const* UTILS_RE
         }
         case ComponentType::HALF: {
             const uint32_t stride = mConfig.inputStrideBytes ? mConfig.inputStrideBytes : (2 * comp);
+            if (stride == 2 * comp) {
+                // Flat loop over all components; on ARM the half-to-float conversion in
+                // math::half lowers to the native NEON instruction.
+                half const* UTILS_RESTRICT src = (half const*) source;
+                for (size_t n = 0, c = count * comp; n < c; ++n) {
+                    target[n] = float(src[n]);
+                }
+                return required;
+            }
             uint8_t const* srcBytes = (uint8_t const*) source;
             for (size_t i = 0; i < count; ++i, target += comp, srcBytes += stride) {
                 half const* src = (half const*) srcBytes;
@@ -191,6 +260,10 @@ size_t Transcoder::operator()(float* UTILS_RESTRICT target, void const* UTILS_RE
         case ComponentType::FLOAT: {
             const uint32_t srcStride =
                     mConfig.inputStrideBytes ? mConfig.inputStrideBytes : (4 * comp);
+            if (srcStride == 4 * comp) {
+                memcpy(target, source, required);
+                return required;
+            }
             uint8_t const* srcBytes = (uint8_t const*) source;
             for (size_t i = 0; i < count; ++i, target += comp, srcBytes += srcStride) {
                 // This will never break alignment rules because the glTF spec stipulates that the
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <geometry/Meshlets.h>
+
+#include <math/vec3.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+class MeshletsTest : public testing::Test {};
+
+using namespace filament::geometry;
+using namespace filament::math;
+
+namespace {
+
+// A grid of quads in the z = 0 plane, all facing +z.
+void makeGrid(size_t n, std::vector<float3>* positions, std::vector<uint3>* triangles) {
+    for (size_t y = 0; y <= n; ++y) {
+        for (size_t x = 0; x <= n; ++x) {
+            positions->push_back(float3{float(x), float(y), 0.0f});
+        }
+    }
+    const uint32_t rowStride = uint32_t(n + 1);
+    for (uint32_t y = 0; y < n; ++y) {
+        for (uint32_t x = 0; x < n; ++x) {
+            const uint32_t v0 = y * rowStride + x;
+            triangles->push_back(uint3{v0, v0 + 1, v0 + rowStride});
+            triangles->push_back(uint3{v0 + 1, v0 + rowStride + 1, v0 + rowStride});
+        }
+    }
+}
+
+} // anonymous namespace
+
+TEST_F(MeshletsTest, CoversEveryTriangle) {
+    std::vector<float3> positions;
+    std::vector<uint3> triangles;
+    makeGrid(32, &positions, &triangles);
+
+    Meshlets* meshlets = Meshlets::Builder()
+            .vertexCount(positions.size())
+            .positions(positions.data())
+            .triangleCount(triangles.size())
+            .triangles(triangles.data())
+            .maxVertices(64)
+            .maxTriangles(124)
+            .build();
+    ASSERT_NE(meshlets, nullptr);
+    ASSERT_GT(meshlets->getMeshletCount(), 1u);
+
+    size_t triangleCount = 0;
+    for (size_t i = 0, n = meshlets->getMeshletCount(); i < n; ++i) {
+        const Meshlets::Meshlet& m = meshlets->getMeshlets()[i];
+        EXPECT_LE(m.vertexCount, 64u);
+        EXPECT_LE(m.triangleCount, 124u);
+        triangleCount += m.triangleCount;
+        // Every micro-index must stay within the meshlet's vertex slice, and every vertex
+        // index must refer to a source vertex.
+        for (size_t t = 0; t < m.triangleCount * 3; ++t) {
+            const uint8_t local = meshlets->getTriangleIndices()[m.triangleOffset + t];
+            ASSERT_LT(local, m.vertexCount);
+            const uint32_t vertex = meshlets->getVertexIndices()[m.vertexOffset + local];
+            ASSERT_LT(vertex, positions.size());
+        }
+    }
+    EXPECT_EQ(triangleCount, triangles.size());
+    delete meshlets;
+}
+
+TEST_F(MeshletsTest, CullingData) {
+    std::vector<float3> positions;
+    std::vector<uint3> triangles;
+    makeGrid(8, &positions, &triangles);
+
+    Meshlets* meshlets = Meshlets::Builder()
+            .vertexCount(positions.size())
+            .positions(positions.data())
+            .triangleCount(triangles.size())
+            .triangles(triangles.data())
+            .coneWeight(0.5f)
+            .build();
+    ASSERT_NE(meshlets, nullptr);
+
+    for (size_t i = 0, n = meshlets->getMeshletCount(); i < n; ++i) {
+        const Meshlets::Meshlet& m = meshlets->getMeshlets()[i];
+        // The grid spans [0, 8] x [0, 8] at z = 0; bounds must stay within it.
+        EXPECT_GT(m.radius, 0.0f);
+        EXPECT_GE(m.center.x, 0.0f);
+        EXPECT_LE(m.center.x, 8.0f);
+        EXPECT_EQ(m.center.z, 0.0f);
+        // All triangles face +z, so every normal cone must be degenerate and point at +z.
+        EXPECT_NEAR(m.coneAxis.z, 1.0f, 1e-3f);
+        // A viewer on the +z side must not be culled: dot(apex - eye, axis) is negative.
+        const float3 eye = { m.coneApex.x, m.coneApex.y, m.coneApex.z + 10.0f };
+        const float3 toApex = m.coneApex - eye;
+        EXPECT_LT(toApex.z * m.coneAxis.z, m.coneCutoff);
+    }
+    delete meshlets;
+}
+
+TEST_F(MeshletsTest, RejectsIncompleteInput) {
+    std::vector<float3> positions;
+    std::vector<uint3> triangles;
+    makeGrid(2, &positions, &triangles);
+
+    EXPECT_EQ(Meshlets::Builder().build(), nullptr);
+    EXPECT_EQ(Meshlets::Builder()
+            .vertexCount(positions.size())
+            .positions(positions.data())
+            .build(), nullptr);
+    EXPECT_EQ(Meshlets::Builder()
+            .vertexCount(positions.size())
+            .positions(positions.data())
+            .triangleCount(triangles.size())
+            .triangles(triangles.data())
+            .maxVertices(1024)
+            .build(), nullptr);
+}
@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * End-to-end asset loading benchmarks for gltfio, running against the NOOP backend so the
+ * whole CPU loading path (parse, draco/meshopt decode, tangent generation, texture decode,
+ * upload command generation) is exercised without a GPU.
+ *
+ * Assets are passed on the command line; without arguments the benchmark falls back to the
+ * AnimatedMorphCube.glb used by test_gltfio. For meaningful numbers, run it over a corpus of
+ * representative assets: draco-compressed, KTX2-textured, many-node and many-primitive
+ * scenes all stress different phases.
+ *
+ * Each asset gets a benchmark per loading phase:
+ *   parse      AssetLoader::createAsset() only: cgltf parse and entity/renderable creation
+ *   resources  ResourceLoader::loadResources() with the parse excluded: draco/meshopt
+ *              decode, tangent generation, vertex/index/texture upload
+ *   textures   the asyncUpdateLoad() drain after asyncBeginLoad(), i.e. mostly texture
+ *              decode and upload
+ *   load       parse + resources end-to-end, with a peak-RSS counter
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <filament/Engine.h>
+
+#include <gltfio/AssetLoader.h>
+#include <gltfio/FilamentAsset.h>
+#include <gltfio/MaterialProvider.h>
+#include <gltfio/ResourceLoader.h>
+#include <gltfio/TextureProvider.h>
+
+#include <utils/EntityManager.h>
+#include <utils/NameComponentManager.h>
+#include <utils/Path.h>
+
+#include "materials/uberarchive.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+
+using namespace filament;
+using namespace gltfio;
+using namespace utils;
+
+namespace {
+
+char const* const DEFAULT_ASSET = "AnimatedMorphCube.glb";
+
+// The process' high-water mark, i.e. this is monotonic: for per-asset attribution, run one
+// asset per invocation (pass it on the command line).
+double getPeakRssMiB() {
+    struct rusage usage = {};
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return double(usage.ru_maxrss) / (1024.0 * 1024.0); // bytes
+#else
+    return double(usage.ru_maxrss) / 1024.0;            // KiB
+#endif
+}
+
+std::vector<uint8_t> readFile(Path const& path) {
+    std::ifstream in(path.c_str(), std::ifstream::ate | std::ifstream::binary);
+    if (!in) {
+        std::cerr << "Unable to open " << path.c_str() << std::endl;
+        exit(1);
+    }
+    std::vector<uint8_t> buffer(static_cast<size_t>(in.tellg()));
+    in.seekg(0);
+    if (!in.read((char*) buffer.data(), std::streamsize(buffer.size()))) {
+        std::cerr << "Unable to read " << path.c_str() << std::endl;
+        exit(1);
+    }
+    return buffer;
+}
+
+// Engine and loaders shared by all iterations of one benchmark; this mirrors the setup in
+// test/gltfio_test.cpp.
+struct LoaderContext {
+    explicit LoaderContext(Path const& path)
+        : engine(Engine::Builder().backend(backend::Backend::NOOP).build()),
+          nameManager(new NameComponentManager(EntityManager::get())),
+          materialProvider(createUbershaderProvider(engine,
+                  UBERARCHIVE_DEFAULT_DATA, UBERARCHIVE_DEFAULT_SIZE)),
+          assetLoader(AssetLoader::create({ engine, materialProvider, nameManager })),
+          resourceLoader(new ResourceLoader({
+                  engine, path.getAbsolutePath().c_str(), false, /* normalizeSkinningWeights */
+          })),
+          stbDecoder(createStbProvider(engine)), ktxDecoder(createKtx2Provider(engine)) {
+        resourceLoader->addTextureProvider("image/png", stbDecoder);
+        resourceLoader->addTextureProvider("image/jpeg", stbDecoder);
+        resourceLoader->addTextureProvider("image/ktx2", ktxDecoder);
+    }
+
+    ~LoaderContext() {
+        delete resourceLoader;
+        delete stbDecoder;
+        delete ktxDecoder;
+        materialProvider->destroyMaterials();
+        AssetLoader::destroy(&assetLoader);
+        Engine::destroy(&engine);
+        delete materialProvider;
+        delete nameManager;
+    }
+
+    Engine* engine;
+    NameComponentManager* nameManager;
+    MaterialProvider* materialProvider;
+    AssetLoader* assetLoader;
+    ResourceLoader* resourceLoader;
+    TextureProvider* stbDecoder;
+    TextureProvider* ktxDecoder;
+};
+
+void registerAssetBenchmarks(Path const& path) {
+    std::string const name = path.getName();
+
+    benchmark::RegisterBenchmark(("gltfio/parse/" + name).c_str(),
+            [path](benchmark::State& state) {
+                LoaderContext context(path);
+                std::vector<uint8_t> const buffer = readFile(path);
+                for (auto _ : state) {
+                    FilamentAsset* const asset =
+                            context.assetLoader->createAsset(buffer.data(), buffer.size());
+                    benchmark::DoNotOptimize(asset);
+                    context.assetLoader->destroyAsset(asset);
+                }
+                state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(buffer.size()));
+            })->Unit(benchmark::kMillisecond)->UseRealTime();
+
+    benchmark::RegisterBenchmark(("gltfio/resources/" + name).c_str(),
+            [path](benchmark::State& state) {
+                LoaderContext context(path);
+                std::vector<uint8_t> const buffer = readFile(path);
+                for (auto _ : state) {
+                    state.PauseTiming();
+                    FilamentAsset* const asset =
+                            context.assetLoader->createAsset(buffer.data(), buffer.size());
+                    state.ResumeTiming();
+                    context.resourceLoader->loadResources(asset);
+                    state.PauseTiming();
+                    context.assetLoader->destroyAsset(asset);
+                    state.ResumeTiming();
+                }
+            })->Unit(benchmark::kMillisecond)->UseRealTime();
+
+    benchmark::RegisterBenchmark(("gltfio/textures/" + name).c_str(),
+            [path](benchmark::State& state) {
+                LoaderContext context(path);
+                std::vector<uint8_t> const buffer = readFile(path);
+                for (auto _ : state) {
+                    state.PauseTiming();
+                    FilamentAsset* const asset =
+                            context.assetLoader->createAsset(buffer.data(), buffer.size());
+                    // this does the geometry work and kicks off the decoder jobs...
+                    context.resourceLoader->asyncBeginLoad(asset);
+                    state.ResumeTiming();
+                    // ... while the timed section is the drive-to-completion loop
+                    while (context.resourceLoader->asyncGetLoadProgress() < 1.0f) {
+                        context.resourceLoader->asyncUpdateLoad();
+                    }
+                    state.PauseTiming();
+                    context.assetLoader->destroyAsset(asset);
+                    state.ResumeTiming();
+                }
+            })->Unit(benchmark::kMillisecond)->UseRealTime();
+
+    benchmark::RegisterBenchmark(("gltfio/load/" + name).c_str(),
+            [path](benchmark::State& state) {
+                LoaderContext context(path);
+                std::vector<uint8_t> const buffer = readFile(path);
+                for (auto _ : state) {
+                    FilamentAsset* const asset =
+                            context.assetLoader->createAsset(buffer.data(), buffer.size());
+                    context.resourceLoader->loadResources(asset);
+                    state.PauseTiming();
+                    context.assetLoader->destroyAsset(asset);
+                    state.ResumeTiming();
+                }
+                state.counters["peakRss(MiB)"] =
+                        benchmark::Counter(getPeakRssMiB(), benchmark::Counter::kDefaults);
+            })->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    // remaining arguments are the asset corpus
+    std::vector<Path> assets;
+    for (int i = 1; i < argc; i++) {
+        assets.emplace_back(argv[i]);
+    }
+    if (assets.empty()) {
+        assets.push_back(Path::getCurrentExecutable().getParent() + Path(DEFAULT_ASSET));
+    }
+
+    for (Path const& path : assets) {
+        registerAssetBenchmarks(path);
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
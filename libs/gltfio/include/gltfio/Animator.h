@@ -47,6 +47,30 @@ public:
      */
     void applyAnimation(size_t animationIndex, float time) const;
 
+    /**
+     * Begins evaluating the given animation on the engine's JobSystem.
+     *
+     * This is an alternative to applyAnimation() that takes animation sampling off the
+     * critical path: call it right after Renderer::render() returns so that the evaluation
+     * overlaps with otherwise idle time (e.g. waiting on the GPU), then call
+     * asyncCommitAnimation() before building the next frame.
+     *
+     * Only the sampler interpolation runs on worker threads; nothing is applied to the
+     * scene until asyncCommitAnimation() is called. If a previous evaluation was never
+     * committed, it is discarded.
+     *
+     * @param animationIndex Zero-based index for the \c animation of interest.
+     * @param time Elapsed time of interest in seconds.
+     */
+    void asyncEvaluateAnimation(size_t animationIndex, float time);
+
+    /**
+     * Waits for the evaluation started by asyncEvaluateAnimation() and pushes the results
+     * to filament::TransformManager and filament::RenderableManager in a single batched
+     * update. No-op if no evaluation is in flight.
+     */
+    void asyncCommitAnimation();
+
     /**
      * Computes root-to-node transforms for all bone nodes, then passes
      * the results into filament::RenderableManager::setBones.
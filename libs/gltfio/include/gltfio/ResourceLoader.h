@@ -49,6 +49,11 @@ struct ResourceConfiguration {
     //! If true, adjusts skinning weights to sum to 1. Well formed glTF files do not need this,
     //! but it is useful for robustness.
     bool normalizeSkinningWeights;
+
+    //! If true, re-orders triangle indices at load time to improve post-transform vertex cache
+    //! utilization. Only index data is touched, so this is safe for skinned and morphed meshes.
+    //! Assets that were already optimized offline gain nothing from this.
+    bool optimizeVertexCache;
 };
 
 /**
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GLTFIO_TEXTUREPAGER_H
+#define GLTFIO_TEXTUREPAGER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <utils/compiler.h>
+
+#include <math/vec4.h>
+
+namespace filament {
+    class Engine;
+    class Texture;
+}
+
+namespace filament::gltfio {
+
+/**
+ * TexturePager maintains a bounded-residency physical atlas over a virtually large texture, such
+ * as a terrain or decal atlas whose full content would not fit in GPU memory.
+ *
+ * The virtual texture is addressed as a grid of fixed-size pages. Clients request the pages they
+ * expect to sample from (e.g. from CPU-side visibility of terrain tiles or decals) and supply the
+ * encoded content of each page; the pager decodes pages on background jobs, following the same
+ * job-system pattern as the gltfio texture providers, and copies finished pages into free slots
+ * of a single physical Texture with Texture::setImage(). When the physical atlas is full, the
+ * least recently used page is evicted to make room, so resident memory never exceeds the
+ * configured budget.
+ *
+ * Because none of the supported backends expose hardware sparse residency, indirection is the
+ * caller's responsibility: getPageUv() reports where a resident page lives in the physical atlas,
+ * and the caller remaps its UVs accordingly (decals typically bake this into a per-instance
+ * material parameter).
+ *
+ * Like TextureProvider, all public methods must be called from the thread that the Filament
+ * engine was created on, and updateQueue() should be pumped once per frame.
+ */
+class UTILS_PUBLIC TexturePager {
+public:
+    using Texture = filament::Texture;
+
+    struct Config {
+        /** Edge size of a page in texels. Must be a power of two. */
+        uint32_t pageSize = 256;
+
+        /** Upper bound on the physical atlas memory, in bytes. */
+        size_t residencyBudgetBytes = 200 * 1024 * 1024;
+
+        /** Largest physical atlas dimension the device supports, in texels. */
+        uint32_t maxAtlasSize = 8192;
+
+        /** Whether page content should be decoded as sRGB. */
+        bool srgb = false;
+    };
+
+    /**
+     * Creates a pager for a virtual texture of the given dimensions, in texels.
+     *
+     * The physical atlas texture is created immediately, sized to the residency budget (and
+     * clamped to maxAtlasSize).
+     */
+    TexturePager(filament::Engine* engine,
+            uint32_t virtualWidth, uint32_t virtualHeight, Config const& config);
+    ~TexturePager();
+
+    TexturePager(TexturePager const&) = delete;
+    TexturePager& operator=(TexturePager const&) = delete;
+
+    /** Returns the physical atlas texture that resident pages can be sampled from. */
+    Texture* getPhysicalTexture() const noexcept;
+
+    /**
+     * Requests residency for the given page, supplying its encoded content.
+     *
+     * If the page is already resident or already decoding, this only refreshes its LRU stamp and
+     * the buffer is ignored. Otherwise the content is pushed to the decoder; the page becomes
+     * resident on a later call to updateQueue(). The given buffer is not held, so the caller can
+     * free it immediately. Returns false if the content could not be parsed or does not match the
+     * page size, in which case getPushMessage() describes the failure.
+     */
+    bool requestPage(uint32_t pageX, uint32_t pageY, const uint8_t* data, size_t byteCount);
+
+    /**
+     * Returns a failure message for the most recent call to requestPage(), or null for success.
+     *
+     * The returned string is owned by the pager and becomes invalid after the next call to
+     * requestPage().
+     */
+    const char* getPushMessage() const noexcept;
+
+    /**
+     * Queries residency for the given page.
+     *
+     * If the page is resident, refreshes its LRU stamp, optionally writes the page's physical
+     * atlas region as (minU, minV, maxU, maxV), and returns true. Callers should query every page
+     * they sample from each frame so that eviction order tracks actual use.
+     */
+    bool getPageUv(uint32_t pageX, uint32_t pageY, math::float4* uvRegion = nullptr) noexcept;
+
+    /**
+     * Uploads pages that have emerged from the decoder and advances the LRU clock.
+     *
+     * Call this once per frame. Pages can become resident only during this call.
+     */
+    void updateQueue();
+
+    /** Drops a page from the physical atlas, freeing its slot immediately. */
+    void evictPage(uint32_t pageX, uint32_t pageY) noexcept;
+
+    /** Number of pages currently resident in the physical atlas. */
+    size_t getResidentCount() const noexcept;
+
+    /** Number of page slots in the physical atlas. */
+    size_t getSlotCount() const noexcept;
+
+private:
+    struct Impl;
+    Impl* mImpl;
+};
+
+} // namespace filament::gltfio
+
+#endif // GLTFIO_TEXTUREPAGER_H
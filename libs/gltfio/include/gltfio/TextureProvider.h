@@ -167,18 +167,61 @@ public:
     virtual ~TextureProvider() = default;
 };
 
+/**
+ * ImageDecoderBackend lets clients replace the codec used by the stb_image-based provider,
+ * e.g. with a SIMD decoder such as libjpeg-turbo, without changing the push / pop contract.
+ *
+ * Both methods may be invoked concurrently from JobSystem worker threads and must therefore
+ * be thread-safe. Either method may reject an image (by returning false or nullptr), in
+ * which case the provider falls back to stb_image for that texture.
+ */
+class UTILS_PUBLIC ImageDecoderBackend {
+public:
+    virtual ~ImageDecoderBackend() = default;
+
+    /** Queries the dimensions of the given encoded image. */
+    virtual bool getDimensions(const uint8_t* data, size_t byteCount, const char* mimeType,
+            uint32_t* width, uint32_t* height) = 0;
+
+    /**
+     * Decodes the given encoded image into a tightly packed RGBA8 buffer allocated with
+     * malloc(); the provider frees it with free().
+     */
+    virtual uint8_t* decode(const uint8_t* data, size_t byteCount, const char* mimeType,
+            uint32_t* width, uint32_t* height) = 0;
+};
+
 /**
  * Creates a simple decoder based on stb_image that can handle "image/png" and "image/jpeg".
  * This works only if your build configuration includes STB.
  */
 TextureProvider* createStbProvider(filament::Engine* engine);
 
+/**
+ * Same as createStbProvider, but tries the given decode backend first for each pushed texture,
+ * falling back to stb_image when the backend rejects it. The backend is not owned and must
+ * remain valid for the provider's lifetime.
+ */
+TextureProvider* createStbProvider(filament::Engine* engine, ImageDecoderBackend* backend);
+
 /**
  * Creates a decoder that can handle certain types of "image/ktx2" content as specified in
  * the KHR_texture_basisu specification.
  */
 TextureProvider* createKtx2Provider(filament::Engine* engine);
 
+/**
+ * Same as createKtx2Provider, but additionally maintains a disk cache of transcoded textures
+ * in the given directory (created if needed).
+ *
+ * Cache entries are keyed on the hash of the source content and the resolved GPU format, and
+ * validated on load, so a second launch uploads the cached payloads directly instead of paying
+ * for BasisU transcoding. After each write the cache is trimmed back to maxCacheByteCount by
+ * evicting the oldest entries.
+ */
+TextureProvider* createKtx2Provider(filament::Engine* engine, const char* transcodeCacheDirectory,
+        size_t maxCacheByteCount = 256u * 1024u * 1024u);
+
 } // namespace filament::gltfio
 
 template<> struct utils::EnableBitMaskOperators<filament::gltfio::TextureProvider::TextureFlags>
@@ -26,6 +26,7 @@
 #include <filament/RenderableManager.h>
 #include <filament/TransformManager.h>
 
+#include <utils/JobSystem.h>
 #include <utils/Log.h>
 
 #include <math/mat4.h>
@@ -34,8 +35,9 @@
 #include <math/vec3.h>
 #include <math/vec4.h>
 
-#include <map>
+#include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace filament;
@@ -45,10 +47,23 @@ using namespace utils;
 
 namespace filament::gltfio {
 
-using TimeValues = map<float, size_t>;
 using SourceValues = vector<float>;
 using BoneVector = vector<mat4f>;
 
+// Sampler timeline, stored as a flat sorted array rather than a tree; binary search over
+// contiguous floats is much more cache friendly than chasing red-black tree nodes.
+struct TimeValues {
+    SourceValues keys;      // sorted, unique keyframe times
+    vector<size_t> indices; // original accessor index of each keyframe
+
+    // Position found by the previous evaluation. Playback time usually advances monotonically
+    // in small steps, so the next evaluation almost always lands on the same keyframe pair or
+    // the one right after it, letting us skip the binary search entirely.
+    mutable size_t cursor = 0;
+
+    size_t size() const noexcept { return keys.size(); }
+};
+
 struct Sampler {
     TimeValues times;
     SourceValues values;
@@ -69,6 +84,24 @@ struct Animation {
 };
 
 struct AnimatorImpl {
+    // One channel of an in-flight asynchronous evaluation. The keyframe pair is found on the
+    // calling thread, the interpolated value is filled in by a worker.
+    struct SampledChannel {
+        const Channel* channel = nullptr;
+        float t = 0.0f;
+        size_t prevIndex = 0;
+        size_t nextIndex = 0;
+        float4 value = {};          // sampled value; vectors in xyz, rotations stored as xyzw
+        uint32_t weightsOffset = 0; // slice into AsyncEvaluation::weights for WEIGHTS channels
+    };
+
+    // State of an asynchronous evaluation (see Animator::asyncEvaluateAnimation()).
+    struct AsyncEvaluation {
+        vector<SampledChannel> samples;
+        vector<float> weights;      // morph weights storage shared by all WEIGHTS channels
+        JobSystem::Job* job = nullptr;
+    };
+
     vector<Animation> animations;
     BoneVector boneMatrices;
     FFilamentAsset const* asset = nullptr;
@@ -78,9 +111,11 @@ struct AnimatorImpl {
     TrsTransformManager* trsTransformManager;
     vector<float> weights;
     FixedCapacityVector<mat4f> crossFade;
+    AsyncEvaluation asyncEvaluation;
     void addChannels(const FixedCapacityVector<Entity>& nodeMap, const cgltf_animation& srcAnim,
             Animation& dst);
     void applyAnimation(const Channel& channel, float t, size_t prevIndex, size_t nextIndex);
+    void commitSample(const SampledChannel& sample);
     void stashCrossFade();
     void applyCrossFade(float alpha);
     void resetBoneMatrices(FFilamentInstance* instance);
@@ -88,7 +123,7 @@ struct AnimatorImpl {
 };
 
 static void createSampler(const cgltf_animation_sampler& src, Sampler& dst) {
-    // Copy the time values into a red-black tree.
+    // Copy the time values into a sorted flat array.
     const cgltf_accessor* timelineAccessor = src.input;
     const uint8_t* timelineBlob = nullptr;
     const float* timelineFloats = nullptr;
@@ -100,8 +135,24 @@ static void createSampler(const cgltf_animation_sampler& src, Sampler& dst) {
         timelineFloats = (const float*) (timelineBlob + timelineAccessor->offset +
                 timelineAccessor->buffer_view->offset);
     }
-    for (size_t i = 0, len = timelineAccessor->count; i < len; ++i) {
-        dst.times[timelineFloats[i]] = i;
+    // glTF requires ascending input times but some assets in the wild violate this, so sort
+    // stably and collapse duplicated times, keeping the last entry as the old tree did.
+    const size_t keyCount = timelineAccessor->count;
+    vector<pair<float, size_t>> sortedTimes(keyCount);
+    for (size_t i = 0; i < keyCount; ++i) {
+        sortedTimes[i] = {timelineFloats[i], i};
+    }
+    std::stable_sort(sortedTimes.begin(), sortedTimes.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+    dst.times.keys.reserve(keyCount);
+    dst.times.indices.reserve(keyCount);
+    for (const auto& [time, index] : sortedTimes) {
+        if (!dst.times.keys.empty() && dst.times.keys.back() == time) {
+            dst.times.indices.back() = index;
+        } else {
+            dst.times.keys.push_back(time);
+            dst.times.indices.push_back(index);
+        }
     }
 
     // Convert source data to float.
@@ -185,6 +236,135 @@ static bool validateAnimation(const cgltf_animation& anim) {
     return true;
 }
 
+// Finds the keyframe pair bracketing the given time and computes the interpolant. This is the
+// only part of the evaluation that touches the (non thread-safe) sampler cursor.
+static void evaluateSamplerTime(const Sampler& sampler, float time, float& t,
+        size_t& prevIndex, size_t& nextIndex) {
+    const TimeValues& times = sampler.times;
+    const SourceValues& keys = times.keys;
+
+    // Find the position of the first keyframe at or after the given time. The cursor from
+    // the previous evaluation (and the position right after it) is checked first, so that
+    // monotonic playback avoids re-searching the timeline.
+    size_t pos = times.cursor;
+    if (!(pos < keys.size() && keys[pos] >= time && (pos == 0 || keys[pos - 1] < time))) {
+        ++pos;
+        if (!(pos < keys.size() && keys[pos] >= time && keys[pos - 1] < time)) {
+            pos = std::lower_bound(keys.begin(), keys.end(), time) - keys.begin();
+        }
+    }
+    times.cursor = pos;
+
+    // Compute the interpolant (between 0 and 1) and determine the keyframe pair.
+    t = 0.0f;
+    if (pos == keys.size()) {
+        nextIndex = times.indices.back();
+        prevIndex = nextIndex;
+    } else if (pos == 0) {
+        nextIndex = times.indices[0];
+        prevIndex = nextIndex;
+    } else {
+        nextIndex = times.indices[pos];
+        prevIndex = times.indices[pos - 1];
+        const float nextTime = keys[pos];
+        const float prevTime = keys[pos - 1];
+        float deltaTime = nextTime - prevTime;
+        assert(deltaTime >= 0);
+        if (deltaTime > 0) {
+            t = (time - prevTime) / deltaTime;
+        }
+    }
+
+    if (sampler.interpolation == Sampler::STEP) {
+        t = 0.0f;
+    }
+}
+
+static float3 sampleVec3(const Sampler& sampler, float t, size_t prevIndex, size_t nextIndex) {
+    const float3* srcVec3 = (const float3*) sampler.values.data();
+    if (sampler.interpolation == Sampler::CUBIC) {
+        float3 vert0 = srcVec3[prevIndex * 3 + 1];
+        float3 tang0 = srcVec3[prevIndex * 3 + 2];
+        float3 tang1 = srcVec3[nextIndex * 3];
+        float3 vert1 = srcVec3[nextIndex * 3 + 1];
+        return cubicSpline(vert0, tang0, vert1, tang1, t);
+    }
+    return ((1 - t) * srcVec3[prevIndex]) + (t * srcVec3[nextIndex]);
+}
+
+static quatf sampleQuat(const Sampler& sampler, float t, size_t prevIndex, size_t nextIndex) {
+    const quatf* srcQuat = (const quatf*) sampler.values.data();
+    if (sampler.interpolation == Sampler::CUBIC) {
+        quatf vert0 = srcQuat[prevIndex * 3 + 1];
+        quatf tang0 = srcQuat[prevIndex * 3 + 2];
+        quatf tang1 = srcQuat[nextIndex * 3];
+        quatf vert1 = srcQuat[nextIndex * 3 + 1];
+        return normalize(cubicSpline(vert0, tang0, vert1, tang1, t));
+    }
+    return slerp(srcQuat[prevIndex], srcQuat[nextIndex], t);
+}
+
+static size_t getMorphTargetCount(const Sampler& sampler) {
+    assert(sampler.values.size() % sampler.times.size() == 0);
+    const size_t valuesPerKeyframe = sampler.values.size() / sampler.times.size();
+    return sampler.interpolation == Sampler::CUBIC ? valuesPerKeyframe / 3 : valuesPerKeyframe;
+}
+
+static void sampleWeights(const Sampler& sampler, float t, size_t prevIndex, size_t nextIndex,
+        float* weights, size_t numMorphTargets) {
+    const float* const samplerValues = sampler.values.data();
+    const size_t valuesPerKeyframe = sampler.values.size() / sampler.times.size();
+
+    if (sampler.interpolation == Sampler::CUBIC) {
+        assert(valuesPerKeyframe % 3 == 0);
+        const float* const inTangents = samplerValues;
+        const float* const splineVerts = samplerValues + numMorphTargets;
+        const float* const outTangents = samplerValues + numMorphTargets * 2;
+
+        // Hoist the spline basis out of the loop (see cubicSpline() in math.h) so that
+        // the body reduces to four multiply-adds over contiguous arrays, which the
+        // compiler can vectorize across morph targets.
+        const float tt = t * t, ttt = tt * t;
+        const float s2 = -2 * ttt + 3 * tt, s3 = ttt - tt;
+        const float c0 = 1 - s2, c1 = (s3 - tt + t) * t, c2 = s2, c3 = s3 * t;
+        const float* const vert0 = splineVerts + prevIndex * valuesPerKeyframe;
+        const float* const tang0 = outTangents + prevIndex * valuesPerKeyframe;
+        const float* const tang1 = inTangents + nextIndex * valuesPerKeyframe;
+        const float* const vert1 = splineVerts + nextIndex * valuesPerKeyframe;
+
+        for (size_t comp = 0; comp < numMorphTargets; ++comp) {
+            weights[comp] = c0 * vert0[comp] + c1 * tang0[comp]
+                    + c2 * vert1[comp] + c3 * tang1[comp];
+        }
+    } else {
+        const float* const previous = samplerValues + prevIndex * valuesPerKeyframe;
+        const float* const current = samplerValues + nextIndex * valuesPerKeyframe;
+        for (size_t comp = 0; comp < numMorphTargets; ++comp) {
+            weights[comp] = (1 - t) * previous[comp] + t * current[comp];
+        }
+    }
+}
+
+// Worker-side part of an asynchronous evaluation: pure interpolation, no manager access.
+static void evaluateSample(AnimatorImpl::SampledChannel& sample, float* weights) {
+    const Sampler& sampler = *sample.channel->sourceData;
+    switch (sample.channel->transformType) {
+        case Channel::SCALE:
+        case Channel::TRANSLATION:
+            sample.value.xyz = sampleVec3(sampler, sample.t, sample.prevIndex, sample.nextIndex);
+            break;
+        case Channel::ROTATION: {
+            const quatf rotation = sampleQuat(sampler, sample.t, sample.prevIndex, sample.nextIndex);
+            sample.value = { rotation.x, rotation.y, rotation.z, rotation.w };
+            break;
+        }
+        case Channel::WEIGHTS:
+            sampleWeights(sampler, sample.t, sample.prevIndex, sample.nextIndex,
+                    weights + sample.weightsOffset, getMorphTargetCount(sampler));
+            break;
+    }
+}
+
 Animator::Animator(FFilamentAsset const* asset, FFilamentInstance* instance) {
     assert(asset->mResourcesLoaded && asset->mSourceAsset);
     mImpl = new AnimatorImpl();
@@ -222,7 +402,7 @@ Animator::Animator(FFilamentAsset const* asset, FFilamentInstance* instance) {
             Sampler& dstSampler = dstAnim.samplers[j];
             createSampler(srcSampler, dstSampler);
             if (dstSampler.times.size() > 1) {
-                float maxtime = (--dstSampler.times.end())->first;
+                float maxtime = dstSampler.times.keys.back();
                 dstAnim.duration = std::max(dstAnim.duration, maxtime);
             }
         }
@@ -255,6 +435,10 @@ void Animator::addInstance(FFilamentInstance* instance) {
 }
 
 Animator::~Animator() {
+    if (UTILS_UNLIKELY(mImpl->asyncEvaluation.job)) {
+        // the workers may still be writing into the evaluation buffers
+        mImpl->asset->mEngine->getJobSystem().waitAndRelease(mImpl->asyncEvaluation.job);
+    }
     delete mImpl;
 }
 
@@ -272,40 +456,74 @@ void Animator::applyAnimation(size_t animationIndex, float time) const {
         if (sampler->times.size() < 2) {
             continue;
         }
+        float t;
+        size_t prevIndex, nextIndex;
+        evaluateSamplerTime(*sampler, time, t, prevIndex, nextIndex);
+        mImpl->applyAnimation(channel, t, prevIndex, nextIndex);
+    }
+    transformManager.commitLocalTransformTransaction();
+}
 
-        const TimeValues& times = sampler->times;
+void Animator::asyncEvaluateAnimation(size_t animationIndex, float time) {
+    AnimatorImpl::AsyncEvaluation& async = mImpl->asyncEvaluation;
+    JobSystem& js = mImpl->asset->mEngine->getJobSystem();
+    if (UTILS_UNLIKELY(async.job)) {
+        // the previous evaluation was never committed, discard it
+        js.waitAndRelease(async.job);
+        async.job = nullptr;
+    }
 
-        // Find the first keyframe after the given time, or the keyframe that matches it exactly.
-        TimeValues::const_iterator iter = times.lower_bound(time);
+    const Animation& anim = mImpl->animations[animationIndex];
+    time = fmod(time, anim.duration);
 
-        // Compute the interpolant (between 0 and 1) and determine the keyframe pair.
-        float t = 0.0f;
-        size_t nextIndex;
-        size_t prevIndex;
-        if (iter == times.end()) {
-            nextIndex = times.size() - 1;
-            prevIndex = nextIndex;
-        } else if (iter == times.begin()) {
-            nextIndex = 0;
-            prevIndex = 0;
-        } else {
-            TimeValues::const_iterator prev = iter; --prev;
-            nextIndex = iter->second;
-            prevIndex = prev->second;
-            const float nextTime = iter->first;
-            const float prevTime = prev->first;
-            float deltaTime = nextTime - prevTime;
-            assert(deltaTime >= 0);
-            if (deltaTime > 0) {
-                t = (time - prevTime) / deltaTime;
-            }
+    // The timeline search is cheap and touches the sampler cursors, so it stays on the calling
+    // thread; only the interpolation work goes to the JobSystem.
+    async.samples.clear();
+    async.weights.clear();
+    for (const auto& channel : anim.channels) {
+        const Sampler* sampler = channel.sourceData;
+        if (sampler->times.size() < 2) {
+            continue;
         }
-
-        if (sampler->interpolation == Sampler::STEP) {
-            t = 0.0f;
+        AnimatorImpl::SampledChannel sample;
+        sample.channel = &channel;
+        evaluateSamplerTime(*sampler, time, sample.t, sample.prevIndex, sample.nextIndex);
+        if (channel.transformType == Channel::WEIGHTS) {
+            sample.weightsOffset = uint32_t(async.weights.size());
+            async.weights.resize(async.weights.size() + getMorphTargetCount(*sampler));
         }
+        async.samples.push_back(sample);
+    }
 
-        mImpl->applyAnimation(channel, t, prevIndex, nextIndex);
+    // Individual channel evaluations are tiny, so batch them per job.
+    constexpr size_t CHANNELS_PER_JOB = 64;
+    AnimatorImpl::SampledChannel* const samples = async.samples.data();
+    float* const weights = async.weights.data();
+    JobSystem::Job* parent = js.createJob();
+    for (size_t start = 0, count = async.samples.size(); start < count; start += CHANNELS_PER_JOB) {
+        const size_t end = std::min(start + CHANNELS_PER_JOB, count);
+        js.run(jobs::createJob(js, parent, [samples, weights, start, end] {
+            for (size_t i = start; i < end; ++i) {
+                evaluateSample(samples[i], weights);
+            }
+        }));
+    }
+    async.job = js.runAndRetain(parent);
+}
+
+void Animator::asyncCommitAnimation() {
+    AnimatorImpl::AsyncEvaluation& async = mImpl->asyncEvaluation;
+    if (UTILS_UNLIKELY(!async.job)) {
+        return;
+    }
+    JobSystem& js = mImpl->asset->mEngine->getJobSystem();
+    js.waitAndRelease(async.job);
+    async.job = nullptr;
+
+    TransformManager& transformManager = *mImpl->transformManager;
+    transformManager.openLocalTransformTransaction();
+    for (const auto& sample : async.samples) {
+        mImpl->commitSample(sample);
     }
     transformManager.commitLocalTransformTransaction();
 }
@@ -431,89 +649,30 @@ void AnimatorImpl::addChannels(const FixedCapacityVector<Entity>& nodeMap,
 void AnimatorImpl::applyAnimation(const Channel& channel, float t, size_t prevIndex,
         size_t nextIndex) {
     const Sampler* sampler = channel.sourceData;
-    const TimeValues& times = sampler->times;
     TrsTransformManager::Instance trsNode = trsTransformManager->getInstance(channel.targetEntity);
     TransformManager::Instance node = transformManager->getInstance(channel.targetEntity);
 
     switch (channel.transformType) {
 
-        case Channel::SCALE: {
-            float3 scale;
-            const float3* srcVec3 = (const float3*) sampler->values.data();
-            if (sampler->interpolation == Sampler::CUBIC) {
-                float3 vert0 = srcVec3[prevIndex * 3 + 1];
-                float3 tang0 = srcVec3[prevIndex * 3 + 2];
-                float3 tang1 = srcVec3[nextIndex * 3];
-                float3 vert1 = srcVec3[nextIndex * 3 + 1];
-                scale = cubicSpline(vert0, tang0, vert1, tang1, t);
-            } else {
-                scale = ((1 - t) * srcVec3[prevIndex]) + (t * srcVec3[nextIndex]);
-            }
-            trsTransformManager->setScale(trsNode, scale);
+        case Channel::SCALE:
+            trsTransformManager->setScale(trsNode,
+                    sampleVec3(*sampler, t, prevIndex, nextIndex));
             break;
-        }
 
-        case Channel::TRANSLATION: {
-            float3 translation;
-            const float3* srcVec3 = (const float3*) sampler->values.data();
-            if (sampler->interpolation == Sampler::CUBIC) {
-                float3 vert0 = srcVec3[prevIndex * 3 + 1];
-                float3 tang0 = srcVec3[prevIndex * 3 + 2];
-                float3 tang1 = srcVec3[nextIndex * 3];
-                float3 vert1 = srcVec3[nextIndex * 3 + 1];
-                translation = cubicSpline(vert0, tang0, vert1, tang1, t);
-            } else {
-                translation = ((1 - t) * srcVec3[prevIndex]) + (t * srcVec3[nextIndex]);
-            }
-            trsTransformManager->setTranslation(trsNode, translation);
+        case Channel::TRANSLATION:
+            trsTransformManager->setTranslation(trsNode,
+                    sampleVec3(*sampler, t, prevIndex, nextIndex));
             break;
-        }
 
-        case Channel::ROTATION: {
-            quatf rotation;
-            const quatf* srcQuat = (const quatf*) sampler->values.data();
-            if (sampler->interpolation == Sampler::CUBIC) {
-                quatf vert0 = srcQuat[prevIndex * 3 + 1];
-                quatf tang0 = srcQuat[prevIndex * 3 + 2];
-                quatf tang1 = srcQuat[nextIndex * 3];
-                quatf vert1 = srcQuat[nextIndex * 3 + 1];
-                rotation = normalize(cubicSpline(vert0, tang0, vert1, tang1, t));
-            } else {
-                rotation = slerp(srcQuat[prevIndex], srcQuat[nextIndex], t);
-            }
-            trsTransformManager->setRotation(trsNode, rotation);
+        case Channel::ROTATION:
+            trsTransformManager->setRotation(trsNode,
+                    sampleQuat(*sampler, t, prevIndex, nextIndex));
             break;
-        }
 
         case Channel::WEIGHTS: {
-            const float* const samplerValues = sampler->values.data();
-            assert(sampler->values.size() % times.size() == 0);
-            const int valuesPerKeyframe = sampler->values.size() / times.size();
-
-            if (sampler->interpolation == Sampler::CUBIC) {
-                assert(valuesPerKeyframe % 3 == 0);
-                const int numMorphTargets = valuesPerKeyframe / 3;
-                const float* const inTangents = samplerValues;
-                const float* const splineVerts = samplerValues + numMorphTargets;
-                const float* const outTangents = samplerValues + numMorphTargets * 2;
-
-                weights.resize(numMorphTargets);
-                for (int comp = 0; comp < numMorphTargets; ++comp) {
-                    float vert0 = splineVerts[comp + prevIndex * valuesPerKeyframe];
-                    float tang0 = outTangents[comp + prevIndex * valuesPerKeyframe];
-                    float tang1 = inTangents[comp + nextIndex * valuesPerKeyframe];
-                    float vert1 = splineVerts[comp + nextIndex * valuesPerKeyframe];
-                    weights[comp] = cubicSpline(vert0, tang0, vert1, tang1, t);
-                }
-            } else {
-                weights.resize(valuesPerKeyframe);
-                for (int comp = 0; comp < valuesPerKeyframe; ++comp) {
-                    float previous = samplerValues[comp + prevIndex * valuesPerKeyframe];
-                    float current = samplerValues[comp + nextIndex * valuesPerKeyframe];
-                    weights[comp] = (1 - t) * previous + t * current;
-                }
-            }
-
+            const size_t numMorphTargets = getMorphTargetCount(*sampler);
+            weights.resize(numMorphTargets);
+            sampleWeights(*sampler, t, prevIndex, nextIndex, weights.data(), numMorphTargets);
             auto ci = renderableManager->getInstance(channel.targetEntity);
             renderableManager->setMorphWeights(ci, weights.data(), weights.size());
             return;
@@ -523,6 +682,38 @@ void AnimatorImpl::applyAnimation(const Channel& channel, float t, size_t prevIn
     transformManager->setTransform(node, trsTransformManager->getTransform(trsNode));
 }
 
+void AnimatorImpl::commitSample(const SampledChannel& sample) {
+    const Channel& channel = *sample.channel;
+    TrsTransformManager::Instance trsNode = trsTransformManager->getInstance(channel.targetEntity);
+    TransformManager::Instance node = transformManager->getInstance(channel.targetEntity);
+
+    switch (channel.transformType) {
+
+        case Channel::SCALE:
+            trsTransformManager->setScale(trsNode, sample.value.xyz);
+            break;
+
+        case Channel::TRANSLATION:
+            trsTransformManager->setTranslation(trsNode, sample.value.xyz);
+            break;
+
+        case Channel::ROTATION:
+            trsTransformManager->setRotation(trsNode, quatf{
+                    sample.value.w, sample.value.x, sample.value.y, sample.value.z });
+            break;
+
+        case Channel::WEIGHTS: {
+            auto ci = renderableManager->getInstance(channel.targetEntity);
+            renderableManager->setMorphWeights(ci,
+                    asyncEvaluation.weights.data() + sample.weightsOffset,
+                    getMorphTargetCount(*channel.sourceData));
+            return;
+        }
+    }
+
+    transformManager->setTransform(node, trsTransformManager->getTransform(trsNode));
+}
+
 void AnimatorImpl::resetBoneMatrices(FFilamentInstance* instance) {
     for (const auto& skin : instance->mSkins) {
         size_t njoints = skin.joints.size();
@@ -17,10 +17,15 @@
 #include "ArchiveCache.h"
 
 #include <uberz/ReadableArchive.h>
+#include <utils/JobSystem.h>
 #include <utils/memalign.h>
 
 #include <zstd.h>
 
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
 using namespace utils;
 using namespace filament::uberz;
 
@@ -45,21 +50,62 @@ static bool strIsEqual(const CString& a, const char* b) {
 }
 
 void ArchiveCache::load(const void* archiveData, uint64_t archiveByteCount) {
-    assert_invariant(mArchive == nullptr && "Do not call load() twice");
+    assert_invariant(mArchive == nullptr && mDecompressJob == nullptr && "Do not call load() twice");
     const uint64_t decompSize = ZSTD_getFrameContentSize(archiveData, archiveByteCount);
     if (decompSize == ZSTD_CONTENTSIZE_UNKNOWN || decompSize == ZSTD_CONTENTSIZE_ERROR) {
         PANIC_POSTCONDITION("Decompression error.");
     }
+
+    // Decompressing the whole archive is long enough to be worth taking off the critical path:
+    // stash a copy of the (much smaller) compressed data -- the caller only guarantees its
+    // lifetime for the duration of this call -- kick off the decompression in the background,
+    // and wait for it only at the first material request.
+    void* const compressedData = malloc(archiveByteCount);
+    memcpy(compressedData, archiveData, archiveByteCount);
+    mCompressedData = compressedData;
+
     uint64_t* basePointer = (uint64_t*) utils::aligned_alloc(decompSize, 8);
-    ZSTD_decompress(basePointer, decompSize, archiveData, archiveByteCount);
     mArchive = (ReadableArchive*) basePointer;
-    convertOffsetsToPointers(mArchive);
-    mMaterials = FixedCapacityVector<Material*>(mArchive->specsCount, nullptr);
+
+    JobSystem& js = mEngine.getJobSystem();
+    mDecompressJob = js.runAndRetain(jobs::createJob(js, nullptr,
+            [basePointer, decompSize, compressedData, archiveByteCount] {
+        ZSTD_decompress(basePointer, decompSize, compressedData, archiveByteCount);
+        convertOffsetsToPointers((ReadableArchive*) basePointer);
+    }));
 }
 
-// This loops though all ubershaders and returns the first one that meets the given requirements.
-Material* ArchiveCache::getMaterial(const ArchiveRequirements& reqs) {
+void ArchiveCache::ensureLoaded() {
     assert_invariant(mArchive && "Please call load() before requesting any materials.");
+    if (UTILS_UNLIKELY(mDecompressJob)) {
+        JobSystem& js = mEngine.getJobSystem();
+        js.waitAndRelease(mDecompressJob);
+        mDecompressJob = nullptr;
+        free(mCompressedData);
+        mCompressedData = nullptr;
+        mMaterials = FixedCapacityVector<Material*>(mArchive->specsCount, nullptr);
+    }
+}
+
+const Material* const* ArchiveCache::getMaterials() noexcept {
+    ensureLoaded();
+    return mMaterials.data();
+}
+
+size_t ArchiveCache::getMaterialsCount() noexcept {
+    ensureLoaded();
+    return mMaterials.size();
+}
+
+// This loops though all ubershaders and returns the most specialized one that meets the given
+// requirements: among the suitable specs, the one supporting the fewest features beyond what the
+// mesh asked for. Feature-complete ubershaders pay for their disabled features on the GPU every
+// frame, so when the archive provides a tighter variant we want that one, not the first match.
+Material* ArchiveCache::getMaterial(const ArchiveRequirements& reqs) {
+    ensureLoaded();
+
+    uint64_t bestSpec = mArchive->specsCount;
+    uint64_t bestExtraFeatures = std::numeric_limits<uint64_t>::max();
 
     for (uint64_t i = 0; i < mArchive->specsCount; ++i) {
         const ArchiveSpec& spec = mArchive->specs[i];
@@ -114,20 +160,43 @@ Material* ArchiveCache::getMaterial(const ArchiveRequirements& reqs) {
         }
 
         if (specIsSuitable) {
-            if (mMaterials[i] == nullptr) {
-                mMaterials[i] = Material::Builder()
-                    .package(spec.package, spec.packageByteCount)
-                    .build(mEngine);
+            // count the features this spec supports that the mesh didn't ask for -- each one
+            // is dead weight in the shader
+            uint64_t extraFeatures = 0;
+            for (uint64_t j = 0; j < spec.flagsCount; ++j) {
+                const ArchiveFlag& flag = spec.flags[j];
+                if (flag.value != ArchiveFeature::UNSUPPORTED) {
+                    auto iter = reqs.features.find(CString(flag.name));
+                    if (iter == reqs.features.end() || iter->second == false) {
+                        extraFeatures++;
+                    }
+                }
+            }
+            if (extraFeatures < bestExtraFeatures) {
+                bestExtraFeatures = extraFeatures;
+                bestSpec = i;
+                if (extraFeatures == 0) {
+                    // this spec is an exact fit, no need to keep looking
+                    break;
+                }
             }
+        }
+    }
 
-            return mMaterials[i];
+    if (bestSpec < mArchive->specsCount) {
+        if (mMaterials[bestSpec] == nullptr) {
+            const ArchiveSpec& spec = mArchive->specs[bestSpec];
+            mMaterials[bestSpec] = Material::Builder()
+                .package(spec.package, spec.packageByteCount)
+                .build(mEngine);
         }
+        return mMaterials[bestSpec];
     }
     return nullptr;
 }
 
 Material* ArchiveCache::getDefaultMaterial() {
-    assert_invariant(mArchive && "Please call load() before requesting any materials.");
+    ensureLoaded();
     assert_invariant(!mMaterials.empty() && "Archive must have at least one material.");
     if (mMaterials[0] == nullptr) {
         mMaterials[0] = Material::Builder()
@@ -160,6 +229,11 @@ FeatureMap ArchiveCache::getFeatureMap(Material* material) const {
 ArchiveCache::~ArchiveCache() {
     assert_invariant(mMaterials.size() == 0 &&
         "Please call destroyMaterials explicitly to ensure correct destruction order");
+    if (mDecompressJob) {
+        // the decompression may still be writing into mArchive
+        mEngine.getJobSystem().waitAndRelease(mDecompressJob);
+        free(mCompressedData);
+    }
     utils::aligned_free(mArchive);
 }
 
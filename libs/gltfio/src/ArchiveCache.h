@@ -28,6 +28,7 @@
 
 #include <utils/CString.h>
 #include <utils/FixedCapacityVector.h>
+#include <utils/JobSystem.h>
 
 namespace filament::gltfio {
 
@@ -41,18 +42,25 @@ namespace filament::gltfio {
         ArchiveCache(Engine& engine) : mEngine(engine) {}
         ~ArchiveCache();
 
+        // Kicks off the decompression of the archive in the background; the result is waited
+        // on at the first material request.
         void load(const void* archiveData, uint64_t archiveByteCount);
         Material* getMaterial(const ArchiveRequirements& requirements);
         Material* getDefaultMaterial();
-        const Material* const* getMaterials() const noexcept { return mMaterials.data(); }
-        size_t getMaterialsCount() const noexcept { return mMaterials.size(); }
+        const Material* const* getMaterials() noexcept;
+        size_t getMaterialsCount() noexcept;
         void destroyMaterials();
         FeatureMap getFeatureMap(Material* material) const;
 
     private:
+        // waits for the decompression started by load() and publishes the archive
+        void ensureLoaded();
+
         Engine& mEngine;
         utils::FixedCapacityVector<Material*> mMaterials;
         uberz::ReadableArchive* mArchive = nullptr;
+        utils::JobSystem::Job* mDecompressJob = nullptr;
+        void* mCompressedData = nullptr;
     };
 
     struct ArchiveRequirements {
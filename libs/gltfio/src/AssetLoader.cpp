@@ -45,6 +45,7 @@
 #include <utils/compiler.h>
 #include <utils/EntityManager.h>
 #include <utils/FixedCapacityVector.h>
+#include <utils/Hash.h>
 #include <utils/Log.h>
 #include <utils/Panic.h>
 #include <utils/NameComponentManager.h>
@@ -260,7 +261,7 @@ private:
     void importSkins(FFilamentInstance* instance, const cgltf_data* srcAsset);
 
     // Methods used during the first traveral (creation of VertexBuffer, IndexBuffer, etc)
-    FFilamentAsset* createRootAsset(const cgltf_data* srcAsset);
+    FFilamentAsset* createRootAsset(FFilamentAsset::SourceHandle sourceAsset);
     void recursePrimitives(const cgltf_node* rootNode, FFilamentAsset* fAsset);
     void createPrimitives(const cgltf_node* node, const char* name, FFilamentAsset* fAsset);
     bool createPrimitive(const cgltf_primitive& inPrim, const char* name, Primitive* outPrim,
@@ -268,7 +269,8 @@ private:
 
     // Methods used during subsequent traverals (creation of entities, renderables, etc)
     void createInstances(size_t numInstances, FFilamentAsset* fAsset);
-    void recurseEntities(const cgltf_node* node, SceneMask scenes, Entity parent,
+    void createEntities(Entity instanceRoot, FFilamentAsset* fAsset, FFilamentInstance* instance);
+    void createEntity(const cgltf_node* node, SceneMask scenes, Entity parent, Entity entity,
             FFilamentAsset* fAsset, FFilamentInstance* instance);
     void createRenderable(const cgltf_node* node, Entity entity, const char* name,
             FFilamentAsset* fAsset);
@@ -307,6 +309,12 @@ public:
 
     // Weak reference to the largest dummy buffer so far in the current loading phase.
     BufferObject* mDummyBufferObject = nullptr;
+
+    // Parsed source hierarchies cached by content hash, so that reloading identical bytes
+    // skips cgltf parsing and validation entirely (see createInstancedAsset()). The cache
+    // holds weak references: a parsed source stays alive only while at least one asset
+    // still shares it.
+    tsl::robin_map<uint64_t, std::weak_ptr<FFilamentAsset::SourceAsset>> mParseCache;
 };
 
 FILAMENT_DOWNCAST(AssetLoader)
@@ -318,46 +326,70 @@ FFilamentAsset* FAssetLoader::createAsset(const uint8_t* bytes, uint32_t byteCou
 
 FFilamentAsset* FAssetLoader::createInstancedAsset(const uint8_t* bytes, uint32_t byteCount,
         FilamentInstance** instances, size_t numInstances) {
-    // This method can be used to load JSON or GLB. By using a default options struct, we are asking
-    // cgltf to examine the magic identifier to determine which type of file is being loaded.
-    cgltf_options options {};
-
-    if constexpr (!GLTFIO_USE_FILESYSTEM) {
-
-        // Provide a custom free callback for each buffer that was loaded from a "file", as opposed
-        // to a data:// URL.
-        //
-        // Since GLTFIO_USE_FILESYSTEM is false, ResourceLoader requires the app provide the file
-        // content from outside, so we need to do nothing here, as opposed to the default, which is
-        // to call "free".
-        //
-        // This callback also gets called for the root-level file_data, but since we use
-        // `cgltf_parse`, the file_data field is always null.
-        options.file.release = [](const cgltf_memory_options*, const cgltf_file_options*, void*) {};
-    }
-
-    // Clients can free up their source blob immediately, but cgltf has pointers into the data that
-    // need to stay valid. Therefore we create a copy of the source blob and stash it inside the
-    // asset.
-    utils::FixedCapacityVector<uint8_t> glbdata(byteCount);
-    std::copy_n(bytes, byteCount, glbdata.data());
-
-    // The ownership of an allocated `sourceAsset` will be moved to FFilamentAsset::mSourceAsset.
-    cgltf_data* sourceAsset;
-    cgltf_result result = cgltf_parse(&options, glbdata.data(), byteCount, &sourceAsset);
-    if (result != cgltf_result_success) {
-        slog.e << "Unable to parse glTF file." << io::endl;
-        return nullptr;
+    // Apps commonly reload the same content over and over (e.g. the same set of assets every
+    // session), and cgltf parsing plus validation dominates the load time of repeat content.
+    // Look up the parsed source hierarchy by content hash first, so that warm loads skip the
+    // JSON parse entirely and share the source blob with the assets already created from it.
+    const uint64_t contentHash = (uint64_t(byteCount) << 32u) |
+            uint64_t(hash::murmurSlow(bytes, byteCount, 0));
+
+    FFilamentAsset::SourceHandle sourceAsset;
+    if (auto iter = mParseCache.find(contentHash); iter != mParseCache.end()) {
+        sourceAsset = iter->second.lock();
+    }
+
+    if (!sourceAsset) {
+        // This method can be used to load JSON or GLB. By using a default options struct, we
+        // are asking cgltf to examine the magic identifier to determine which type of file is
+        // being loaded.
+        cgltf_options options {};
+
+        if constexpr (!GLTFIO_USE_FILESYSTEM) {
+
+            // Provide a custom free callback for each buffer that was loaded from a "file", as
+            // opposed to a data:// URL.
+            //
+            // Since GLTFIO_USE_FILESYSTEM is false, ResourceLoader requires the app provide the
+            // file content from outside, so we need to do nothing here, as opposed to the
+            // default, which is to call "free".
+            //
+            // This callback also gets called for the root-level file_data, but since we use
+            // `cgltf_parse`, the file_data field is always null.
+            options.file.release =
+                    [](const cgltf_memory_options*, const cgltf_file_options*, void*) {};
+        }
+
+        // Clients can free up their source blob immediately, but cgltf has pointers into the
+        // data that need to stay valid. Therefore we create a copy of the source blob and stash
+        // it inside the source asset.
+        utils::FixedCapacityVector<uint8_t> glbdata(byteCount);
+        std::copy_n(bytes, byteCount, glbdata.data());
+
+        cgltf_data* hierarchy;
+        cgltf_result result = cgltf_parse(&options, glbdata.data(), byteCount, &hierarchy);
+        if (result != cgltf_result_success) {
+            slog.e << "Unable to parse glTF file." << io::endl;
+            return nullptr;
+        }
+
+        sourceAsset = std::make_shared<FFilamentAsset::SourceAsset>();
+        sourceAsset->hierarchy = hierarchy;
+        sourceAsset->glbData = std::move(glbdata);
+
+        // Drop entries whose source has been released before caching the new one.
+        for (auto it = mParseCache.begin(); it != mParseCache.end();) {
+            it = it->second.expired() ? mParseCache.erase(it) : std::next(it);
+        }
+        mParseCache[contentHash] = sourceAsset;
     }
 
-    FFilamentAsset* fAsset = createRootAsset(sourceAsset);
+    FFilamentAsset* fAsset = createRootAsset(std::move(sourceAsset));
     if (mError) {
         delete fAsset;
         fAsset = nullptr;
         mError = false;
         return nullptr;
     }
-    glbdata.swap(fAsset->mSourceAsset->glbData);
 
     createInstances(numInstances, fAsset);
     if (mError) {
@@ -399,10 +431,8 @@ FilamentInstance* FAssetLoader::createInstance(FFilamentAsset* fAsset) {
         instance->mVariants.push_back({ CString(srcAsset->variants[i].name) });
     }
 
-    // For each scene root, recursively create all entities.
-    for (const auto& pair : fAsset->mRootNodes) {
-        recurseEntities(pair.first, pair.second, instanceRoot, fAsset, instance);
-    }
+    // For each scene root, create all entities.
+    createEntities(instanceRoot, fAsset, instance);
 
     importSkins(instance, srcAsset);
 
@@ -424,8 +454,9 @@ FilamentInstance* FAssetLoader::createInstance(FFilamentAsset* fAsset) {
     return instance;
 }
 
-FFilamentAsset* FAssetLoader::createRootAsset(const cgltf_data* srcAsset) {
+FFilamentAsset* FAssetLoader::createRootAsset(FFilamentAsset::SourceHandle sourceAsset) {
     SYSTRACE_CALL();
+    const cgltf_data* srcAsset = sourceAsset->hierarchy;
     #if !GLTFIO_DRACO_SUPPORTED
     for (cgltf_size i = 0; i < srcAsset->extensions_required_count; i++) {
         if (!strcmp(srcAsset->extensions_required[i], "KHR_draco_mesh_compression")) {
@@ -436,8 +467,18 @@ FFilamentAsset* FAssetLoader::createRootAsset(const cgltf_data* srcAsset) {
     #endif
 
     mDummyBufferObject = nullptr;
+
+    // Reuse the GPU geometry of assets previously created from this same source, so that
+    // identical content loaded through separate assets shares vertex/index data instead of
+    // duplicating it. The weak link dies with the last asset referencing the geometry.
+    FFilamentAsset::GeometryHandle geometry = sourceAsset->geometry.lock();
+    if (!geometry) {
+        geometry = std::make_shared<SharedGeometry>(&mEngine, srcAsset->meshes_count);
+        sourceAsset->geometry = geometry;
+    }
+
     FFilamentAsset* fAsset = new FFilamentAsset(&mEngine, mNameManager, &mEntityManager,
-            &mNodeManager, &mTrsTransformManager, srcAsset);
+            &mNodeManager, &mTrsTransformManager, std::move(sourceAsset), std::move(geometry));
 
     // It is not an error for a glTF file to have zero scenes.
     fAsset->mScenes.clear();
@@ -544,11 +585,46 @@ void FAssetLoader::createInstances(size_t numInstances, FFilamentAsset* fAsset)
     }
 }
 
-void FAssetLoader::recurseEntities(const cgltf_node* node, SceneMask scenes, Entity parent,
-        FFilamentAsset* fAsset, FFilamentInstance* instance) {
+void FAssetLoader::createEntities(Entity instanceRoot, FFilamentAsset* fAsset,
+        FFilamentInstance* instance) {
+    // Flatten the node hierarchy in preorder so that every entity can be allocated with a
+    // single bulk EntityManager call, which takes the free-list lock once instead of once per
+    // node. Appending children after their parent guarantees that parents always precede
+    // children in the flattened list.
+    struct PendingNode {
+        const cgltf_node* node;
+        SceneMask scenes;
+        size_t parent;  // index into the flattened list, or SIZE_MAX for scene roots
+    };
+    std::vector<PendingNode> flattened;
+    flattened.reserve(fAsset->mSourceAsset->hierarchy->nodes_count);
+    for (const auto& [node, scenes] : fAsset->mRootNodes) {
+        flattened.push_back({node, scenes, SIZE_MAX});
+    }
+    for (size_t i = 0; i < flattened.size(); ++i) {
+        // Note that push_back can invalidate references into the list, so copy first.
+        const cgltf_node* node = flattened[i].node;
+        const SceneMask scenes = flattened[i].scenes;
+        for (cgltf_size c = 0, len = node->children_count; c < len; ++c) {
+            flattened.push_back({node->children[c], scenes, i});
+        }
+    }
+
+    FixedCapacityVector<Entity> entities(flattened.size());
+    mEntityManager.create(entities.size(), entities.data());
+
+    for (size_t i = 0, n = flattened.size(); i < n; ++i) {
+        const PendingNode& pending = flattened[i];
+        const Entity parent = pending.parent == SIZE_MAX ?
+                instanceRoot : entities[pending.parent];
+        createEntity(pending.node, pending.scenes, parent, entities[i], fAsset, instance);
+    }
+}
+
+void FAssetLoader::createEntity(const cgltf_node* node, SceneMask scenes, Entity parent,
+        Entity entity, FFilamentAsset* fAsset, FFilamentInstance* instance) {
     NodeManager& nm = mNodeManager;
     const cgltf_data* srcAsset = fAsset->mSourceAsset->hierarchy;
-    const Entity entity = mEntityManager.create();
     nm.create(entity);
     const auto nodeInstance = nm.getInstance(entity);
     nm.setSceneMembership(nodeInstance, scenes);
@@ -609,10 +685,6 @@ void FAssetLoader::recurseEntities(const cgltf_node* node, SceneMask scenes, Ent
     if (node->camera) {
         createCamera(node->camera, entity, fAsset);
     }
-
-    for (cgltf_size i = 0, len = node->children_count; i < len; ++i) {
-        recurseEntities(node->children[i], scenes, entity, fAsset, instance);
-    }
 }
 
 void FAssetLoader::createPrimitives(const cgltf_node* node, const char* name,
@@ -625,7 +697,7 @@ void FAssetLoader::createPrimitives(const cgltf_node* node, const char* name,
     // If the mesh is already loaded, obtain the list of Filament VertexBuffer / IndexBuffer objects
     // that were already generated (one for each primitive), otherwise allocate a new list of
     // pointers for the primitives.
-    FixedCapacityVector<Primitive>& prims = fAsset->mMeshCache[mesh - srcAsset->meshes];
+    FixedCapacityVector<Primitive>& prims = fAsset->mGeometry->meshCache[mesh - srcAsset->meshes];
     if (prims.empty()) {
         prims.reserve(mesh->primitives_count);
         prims.resize(mesh->primitives_count);
@@ -664,7 +736,7 @@ void FAssetLoader::createRenderable(const cgltf_node* node, Entity entity, const
 
     // If the mesh is already loaded, obtain the list of Filament VertexBuffer / IndexBuffer objects
     // that were already generated (one for each primitive).
-    FixedCapacityVector<Primitive>& prims = fAsset->mMeshCache[mesh - srcAsset->meshes];
+    FixedCapacityVector<Primitive>& prims = fAsset->mGeometry->meshCache[mesh - srcAsset->meshes];
     assert_invariant(prims.size() == primitiveCount);
     Primitive* outputPrim = prims.data();
     const cgltf_primitive* inputPrim = &mesh->primitives[0];
@@ -801,7 +873,7 @@ bool FAssetLoader::createPrimitive(const cgltf_primitive& inPrim, const char* na
     // request from Google.
 
     // Create a little lambda that appends to the asset's vertex buffer slots.
-    auto slots = &fAsset->mBufferSlots;
+    auto slots = &fAsset->mGeometry->bufferSlots;
     auto addBufferSlot = [slots](BufferSlot entry) {
         slots->push_back(entry);
     };
@@ -823,6 +895,7 @@ bool FAssetLoader::createPrimitive(const cgltf_primitive& inPrim, const char* na
 
         BufferSlot slot = { accessor };
         slot.indexBuffer = indices;
+        slot.triangles = inPrim.type == cgltf_primitive_type_triangles;
         addBufferSlot(slot);
     } else if (inPrim.attributes_count > 0) {
         // If a primitive does not have an index buffer, generate a trivial one now.
@@ -841,7 +914,7 @@ bool FAssetLoader::createPrimitive(const cgltf_primitive& inPrim, const char* na
         IndexBuffer::BufferDescriptor bd(indexData, indexDataSize, FREE_CALLBACK);
         indices->setBuffer(mEngine, std::move(bd));
     }
-    fAsset->mIndexBuffers.push_back(indices);
+    fAsset->mGeometry->indexBuffers.push_back(indices);
 
     VertexBuffer::Builder vbb;
     vbb.enableBufferObjects();
@@ -849,7 +922,7 @@ bool FAssetLoader::createPrimitive(const cgltf_primitive& inPrim, const char* na
     bool hasUv0 = false, hasUv1 = false, hasVertexColor = false, hasNormals = false;
     uint32_t vertexCount = 0;
 
-    const size_t firstSlot = fAsset->mBufferSlots.size();
+    const size_t firstSlot = fAsset->mGeometry->bufferSlots.size();
     int slot = 0;
 
     for (cgltf_size aindex = 0; aindex < inPrim.attributes_count; aindex++) {
@@ -1062,11 +1135,11 @@ bool FAssetLoader::createPrimitive(const cgltf_primitive& inPrim, const char* na
 
     outPrim->indices = indices;
     outPrim->vertices = vertices;
-    fAsset->mPrimitives.push_back({&inPrim, vertices});
-    fAsset->mVertexBuffers.push_back(vertices);
+    fAsset->mGeometry->primitives.push_back({&inPrim, vertices});
+    fAsset->mGeometry->vertexBuffers.push_back(vertices);
 
-    for (size_t i = firstSlot; i < fAsset->mBufferSlots.size(); ++i) {
-        fAsset->mBufferSlots[i].vertexBuffer = vertices;
+    for (size_t i = firstSlot; i < fAsset->mGeometry->bufferSlots.size(); ++i) {
+        fAsset->mGeometry->bufferSlots[i].vertexBuffer = vertices;
     }
 
     if (targetsCount > 0) {
@@ -1075,7 +1148,7 @@ bool FAssetLoader::createPrimitive(const cgltf_primitive& inPrim, const char* na
                 .count(targetsCount)
                 .build(mEngine);
         outPrim->targets = targets;
-        fAsset->mMorphTargetBuffers.push_back(targets);
+        fAsset->mGeometry->morphTargetBuffers.push_back(targets);
         UTILS_UNUSED_IN_RELEASE cgltf_accessor const* previous = nullptr;
         for (int tindex = 0; tindex < targetsCount; ++tindex) {
             const cgltf_morph_target& inTarget = inPrim.targets[tindex];
@@ -1101,7 +1174,7 @@ bool FAssetLoader::createPrimitive(const cgltf_primitive& inPrim, const char* na
         const uint32_t requiredSize = sizeof(ubyte4) * vertexCount;
         if (mDummyBufferObject == nullptr || requiredSize > mDummyBufferObject->getByteCount()) {
             mDummyBufferObject = BufferObject::Builder().size(requiredSize).build(mEngine);
-            fAsset->mBufferObjects.push_back(mDummyBufferObject);
+            fAsset->mGeometry->bufferObjects.push_back(mDummyBufferObject);
             uint32_t* dummyData = (uint32_t*) malloc(requiredSize);
             memset(dummyData, 0xff, requiredSize);
             VertexBuffer::BufferDescriptor bd(dummyData, requiredSize, FREE_CALLBACK);
@@ -121,12 +121,35 @@ void DependencyGraph::markAsReady(MaterialInstance* material) {
         if (status.numReadyMaterials == status.materials.size()) {
             continue;
         }
-        if (++status.numReadyMaterials == status.materials.size()) {
+        if (++status.numReadyMaterials == status.materials.size()
+                && status.numPendingGeometry == 0) {
             mReadyRenderables.push(entity);
         }
     }
 }
 
+void DependencyGraph::addGeometryDependency(Entity entity) {
+    if (!mDisabled) {
+        mEntityToMaterial[entity].numPendingGeometry++;
+    }
+}
+
+void DependencyGraph::markGeometryReady(Entity entity) {
+    auto iter = mEntityToMaterial.find(entity);
+    if (iter == mEntityToMaterial.end()) {
+        return;
+    }
+    auto& status = iter.value();
+    if (status.numPendingGeometry == 0 || --status.numPendingGeometry > 0) {
+        return;
+    }
+    // Once the last pending upload clears, reveal the entity under the same rules that
+    // markAsReady() and the flush in disableProgressiveReveal() apply.
+    if (mDisabled || status.numReadyMaterials == status.materials.size()) {
+        mReadyRenderables.push(entity);
+    }
+}
+
 DependencyGraph::TextureNode* DependencyGraph::getStatus(Texture* texture) {
     assert_invariant(texture);
     auto iter = mTextureNodes.find(texture);
@@ -141,6 +164,11 @@ DependencyGraph::TextureNode* DependencyGraph::getStatus(Texture* texture) {
 void DependencyGraph::disableProgressiveReveal() {
     mDisabled = true;
     for (auto& [entity, status] : mEntityToMaterial) {
+        if (status.numPendingGeometry > 0) {
+            // Entities whose geometry is still streaming in are revealed by
+            // markGeometryReady() instead.
+            continue;
+        }
         if (status.numReadyMaterials < status.materials.size()) {
             mReadyRenderables.push(entity);
         }
@@ -79,6 +79,15 @@ public:
     // Marks the given texture as being fully decoded, with all miplevels initialized.
     void markAsReady(Texture* texture);
 
+    // Registers a pending geometry upload for the given entity. Entities with pending geometry
+    // are withheld from the ready queue until every upload has been cleared with
+    // markGeometryReady(), mirroring the way textures gate readiness.
+    void addGeometryDependency(Entity entity);
+
+    // Clears one pending geometry upload for the given entity, revealing it once nothing else
+    // holds it back.
+    void markGeometryReady(Entity entity);
+
     // Causes the dependency graph to enter a disabled state, whereby adding Entity <=> Material
     // edges will immediately mark the entity as ready without actually growing the graph.
     void disableProgressiveReveal();
@@ -96,6 +105,7 @@ private:
     struct EntityNode {
         tsl::robin_set<Material*> materials;
         size_t numReadyMaterials = 0;
+        size_t numPendingGeometry = 0;
     };
 
     void checkReadiness(Material* material);
@@ -37,16 +37,13 @@ using namespace utils;
 
 namespace filament::gltfio {
 
-DracoMesh* DracoCache::findOrCreateMesh(const cgltf_buffer_view* key) {
+DracoMesh* DracoCache::find(const cgltf_buffer_view* key) const {
     auto iter = mCache.find(key);
-    if (iter != mCache.end()) {
-        return iter->second.get();
-    }
-    assert(key->buffer && key->buffer->data);
-    const uint8_t* compressedData = key->offset + (uint8_t*) key->buffer->data;
-    DracoMesh* mesh = DracoMesh::decode(compressedData, key->size);
+    return iter != mCache.end() ? iter->second.get() : nullptr;
+}
+
+void DracoCache::add(const cgltf_buffer_view* key, DracoMesh* mesh) {
     mCache.emplace(key, mesh);
-    return mesh;
 }
 
 DracoMesh::DracoMesh(struct DracoMeshDetails* details) : mDetails(details) {}
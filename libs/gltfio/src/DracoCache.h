@@ -35,9 +35,14 @@ class DracoMesh;
 //
 // The cache key is the buffer view that holds the compressed data. This allows the loader to
 // avoid duplicated work when a single Draco mesh is referenced from multiple primitives.
+//
+// Lookups and insertions must stay on the loading thread; the decoding itself runs on
+// JobSystem workers, one job per buffer view (see decodeDracoMeshes in ResourceLoader.cpp),
+// and the results are added here once the jobs have completed.
 class DracoCache {
 public:
-    DracoMesh* findOrCreateMesh(const cgltf_buffer_view* key);
+    DracoMesh* find(const cgltf_buffer_view* key) const;
+    void add(const cgltf_buffer_view* key, DracoMesh* mesh);
 private:
     tsl::robin_map<const cgltf_buffer_view*, std::unique_ptr<DracoMesh>> mCache;
 };
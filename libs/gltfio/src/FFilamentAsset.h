@@ -81,6 +81,7 @@ struct BufferSlot {
     VertexBuffer* vertexBuffer;
     IndexBuffer* indexBuffer;
     MorphTargetBuffer* morphTargetBuffer;
+    bool triangles; // for index buffer only; gates load-time vertex cache optimization
 };
 
 // Stores a connection between Texture and MaterialInstance; consumed by resource loader so that it
@@ -108,15 +109,49 @@ struct Primitive {
 };
 using MeshCache = utils::FixedCapacityVector<utils::FixedCapacityVector<Primitive>>;
 
+// SharedGeometry
+// --------------
+// All GPU geometry created for a source hierarchy: the vertex / index / morph target buffers,
+// the buffer objects feeding them, and the mesh cache referencing them. It is refcounted so
+// that assets loaded from identical content (see the parse cache in FAssetLoader) share one
+// copy instead of duplicating GPU memory; the render primitives built on top of these buffers
+// are already deduplicated engine-side by HwRenderPrimitiveFactory. The upload work lists are
+// part of the bundle as well, so shared geometry is uploaded only once, by whichever asset
+// loads its resources first.
+struct SharedGeometry {
+    SharedGeometry(Engine* engine, size_t meshCount) : meshCache(meshCount), mEngine(engine) {}
+    ~SharedGeometry();
+
+    std::vector<VertexBuffer*> vertexBuffers;
+    std::vector<BufferObject*> bufferObjects;
+    std::vector<IndexBuffer*> indexBuffers;
+    std::vector<MorphTargetBuffer*> morphTargetBuffers;
+    MeshCache meshCache;
+
+    // Transient upload state, consumed (and cleared) by ResourceLoader.
+    std::vector<BufferSlot> bufferSlots;
+    std::vector<std::pair<const cgltf_primitive*, VertexBuffer*>> primitives;
+
+private:
+    Engine* mEngine;
+};
+
 struct FFilamentAsset : public FilamentAsset {
+    struct SourceAsset;
+    using SourceHandle = std::shared_ptr<SourceAsset>;
+    using GeometryHandle = std::shared_ptr<SharedGeometry>;
+
+    // The source hierarchy and geometry may be freshly created, or shared with previously
+    // created assets when the same content is loaded again (see the caches in FAssetLoader).
     FFilamentAsset(Engine* engine, utils::NameComponentManager* names,
             utils::EntityManager* entityManager, NodeManager* nodeManager,
-            TrsTransformManager* trsTransformManager, const cgltf_data* srcAsset) :
+            TrsTransformManager* trsTransformManager, SourceHandle srcAsset,
+            GeometryHandle geometry) :
             mEngine(engine), mNameManager(names), mEntityManager(entityManager),
             mNodeManager(nodeManager), mTrsTransformManager(trsTransformManager),
-            mSourceAsset(new SourceAsset {(cgltf_data*)srcAsset}),
-            mTextures(srcAsset->textures_count),
-            mMeshCache(srcAsset->meshes_count) {}
+            mSourceAsset(std::move(srcAsset)),
+            mGeometry(std::move(geometry)),
+            mTextures(mSourceAsset->hierarchy->textures_count) {}
 
     ~FFilamentAsset();
 
@@ -252,10 +287,6 @@ struct FFilamentAsset : public FilamentAsset {
     std::vector<utils::Entity> mLightEntities;
     std::vector<utils::Entity> mCameraEntities;
     size_t mRenderableCount = 0;
-    std::vector<VertexBuffer*> mVertexBuffers;
-    std::vector<BufferObject*> mBufferObjects;
-    std::vector<IndexBuffer*> mIndexBuffers;
-    std::vector<MorphTargetBuffer*> mMorphTargetBuffers;
     utils::FixedCapacityVector<Skin> mSkins;
     utils::FixedCapacityVector<utils::CString> mScenes;
     Aabb mBoundingBox;
@@ -279,17 +310,23 @@ struct FFilamentAsset : public FilamentAsset {
     // and potentially also includes buffer data that can be uploaded to the GPU.
     struct SourceAsset {
         ~SourceAsset() { cgltf_free(hierarchy); }
-        cgltf_data* hierarchy;
+        cgltf_data* hierarchy = nullptr;
         DracoCache dracoCache;
         utils::FixedCapacityVector<uint8_t> glbData;
+
+        // GPU geometry previously created from this source, reused by assets sharing it.
+        std::weak_ptr<SharedGeometry> geometry;
     };
 
     // We used shared ownership for the raw cgltf data in order to permit ResourceLoader to
     // complete various asynchronous work (e.g. uploading buffers to the GPU) even after the asset
     // or ResourceLoader have been destroyed.
-    using SourceHandle = std::shared_ptr<SourceAsset>;
     SourceHandle mSourceAsset;
 
+    // The GPU geometry referenced by this asset's renderables, possibly shared with other
+    // assets loaded from identical content. Destroyed with the last asset referencing it.
+    GeometryHandle mGeometry;
+
     // The mapping of root nodes to scene membership sets.
     tsl::robin_map<cgltf_node*, SceneMask> mRootNodes;
 
@@ -309,13 +346,6 @@ struct FFilamentAsset : public FilamentAsset {
 
     // Resource URIs can be queried by the end user.
     utils::FixedCapacityVector<const char*> mResourceUris;
-
-    // The mapping from cgltf_mesh to VertexBuffer* (etc) is required when creating new instances.
-    MeshCache mMeshCache;
-
-    // Asset information that is produced by AssetLoader and consumed by ResourceLoader:
-    std::vector<BufferSlot> mBufferSlots;
-    std::vector<std::pair<const cgltf_primitive*, VertexBuffer*> > mPrimitives;
 };
 
 FILAMENT_DOWNCAST(FilamentAsset)
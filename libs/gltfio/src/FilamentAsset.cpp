@@ -76,21 +76,27 @@ FFilamentAsset::~FFilamentAsset() {
         }
     }
 
-    for (auto vb : mVertexBuffers) {
+    for (auto tx : mTextures) {
+        if (UTILS_LIKELY(tx.isOwner)) {
+            mEngine->destroy(tx.texture);
+        }
+    }
+
+    // Note that the GPU geometry is not destroyed here: mGeometry may be shared with other
+    // assets loaded from identical content, and is destroyed with its last reference.
+}
+
+SharedGeometry::~SharedGeometry() {
+    for (auto vb : vertexBuffers) {
         mEngine->destroy(vb);
     }
-    for (auto bo : mBufferObjects) {
+    for (auto bo : bufferObjects) {
         mEngine->destroy(bo);
     }
-    for (auto ib : mIndexBuffers) {
+    for (auto ib : indexBuffers) {
         mEngine->destroy(ib);
     }
-    for (auto tx : mTextures) {
-        if (UTILS_LIKELY(tx.isOwner)) {
-            mEngine->destroy(tx.texture);
-        }
-    }
-    for (auto tb : mMorphTargetBuffers) {
+    for (auto tb : morphTargetBuffers) {
         mEngine->destroy(tb);
     }
 }
@@ -193,8 +199,10 @@ void FFilamentAsset::releaseSourceData() noexcept {
     for (auto& info : mTextures) {
         info.bindings = {};
     }
-    mMeshCache = {};
     mResourceUris = {};
+    // Note that the mesh cache is left alone: it lives in the (shared) geometry bundle and is
+    // still needed by other assets sharing it. mGeometry itself must stay as well, since this
+    // asset's renderables reference its buffers.
     mSourceAsset.reset();
 }
 
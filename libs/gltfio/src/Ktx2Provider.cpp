@@ -16,10 +16,18 @@
 
 #include <gltfio/TextureProvider.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <string>
 #include <vector>
 
+#include <sys/stat.h>
+
+#include <utils/Hash.h>
 #include <utils/JobSystem.h>
+#include <utils/Log.h>
+#include <utils/Path.h>
 
 #include <filament/Engine.h>
 #include <filament/Texture.h>
@@ -37,7 +45,7 @@ namespace filament::gltfio {
 
 class Ktx2Provider final : public TextureProvider {
 public:
-    Ktx2Provider(Engine* engine);
+    Ktx2Provider(Engine* engine, const char* transcodeCacheDirectory, size_t maxCacheByteCount);
     ~Ktx2Provider();
 
     Texture* pushTexture(const uint8_t* data, size_t byteCount,
@@ -71,21 +79,54 @@ private:
         QueueItemState state;
         atomic<TranscoderState> transcoderState;
         JobSystem::Job* job;
+        size_t estimatedDecodeBytes;
+        bool started;
+        // Where the transcoded output of this item should be cached, or empty if the disk cache
+        // is disabled or the item was satisfied from the cache.
+        std::string cachePath;
+        uint64_t sourceHash;
     };
 
     void transcodeSingleTexture();
+    void launchTranscoderJobs();
+    void startTranscoderJob(QueueItem* item);
+
+    std::string getCachePath(uint64_t sourceHash, Texture::InternalFormat format) const;
+    bool loadFromCache(QueueItem* item) const;
+    bool transcodeToCache(QueueItem* item) const;
+    void trimCache() const;
+
+    // Backpressure limit for transcoder jobs: no new job is launched while the decoded data
+    // held by in-flight jobs (conservatively estimated) exceeds this amount. A single job is
+    // always allowed so that arbitrarily large textures still make progress.
+    static constexpr size_t MAX_INFLIGHT_DECODE_BYTES = 64u * 1024u * 1024u;
 
     size_t mPushedCount = 0;
     size_t mPoppedCount = 0;
     size_t mDecodedCount = 0;
+    size_t mInflightDecodeBytes = 0;
     vector<unique_ptr<QueueItem> > mQueueItems;
     JobSystem::Job* mDecoderRootJob;
     std::string mRecentPushMessage;
     std::string mRecentPopMessage;
     std::unique_ptr<ktxreader::Ktx2Reader> mKtxReader;
+    const utils::Path mCacheDirectory;
+    const size_t mMaxCacheByteCount;
     Engine* const mEngine;
 };
 
+// On-disk layout of a transcode cache entry: this header, followed by levelCount records of
+// { uint32_t levelIndex; uint32_t byteCount; payload }.
+struct CacheEntryHeader {
+    static constexpr uint32_t MAGIC = 'F' | 'K' << 8u | 'T' << 16u | 'C' << 24u;
+    static constexpr uint32_t VERSION = 1;
+    uint32_t magic;
+    uint32_t version;
+    uint64_t sourceHash;
+    uint32_t format;
+    uint32_t levelCount;
+};
+
 Texture* Ktx2Provider::pushTexture(const uint8_t* data, size_t byteCount,
             const char* mimeType, TextureProvider::TextureFlags flags) {
     using TransferFunction = ktxreader::Ktx2Reader::TransferFunction;
@@ -106,24 +147,74 @@ Texture* Ktx2Provider::pushTexture(const uint8_t* data, size_t byteCount,
     item->async = async;
     item->state = QueueItemState::TRANSCODING;
     item->transcoderState.store(TranscoderState::NOT_STARTED);
+    item->job = nullptr;
+    item->started = false;
+
+    // Conservative upper bound for the decoded size of the full mip chain: level 0 at 4 bytes
+    // per pixel, plus one third for the remaining levels. This is used for the backpressure
+    // limit and for scheduling cheap textures first.
+    Texture* texture = async->getTexture();
+    item->estimatedDecodeBytes = size_t(texture->getWidth()) * texture->getHeight() * 4u * 4u / 3u;
+
+    if (!mCacheDirectory.isEmpty()) {
+        item->sourceHash = (uint64_t(byteCount) << 32u) | hash::murmurSlow(data, byteCount, 0);
+        item->cachePath = getCachePath(item->sourceHash, texture->getFormat());
+        if (loadFromCache(item)) {
+            // The cached payloads were injected into the async object, so skip the transcoder
+            // job entirely and let updateQueue() upload them as usual.
+            item->transcoderState.store(TranscoderState::SUCCESS);
+            item->cachePath.clear();
+            return texture;
+        }
+    }
 
     // On single threaded systems, it is usually fine to create jobs because the job system will
     // simply execute serially. However in our case, we wish to amortize the decoder cost across
     // several frames, so we instead use the updateQueue() method to perform decoding.
-    if constexpr (!UTILS_HAS_THREADING) {
-        item->job = nullptr;
-        return async->getTexture();
+    // On threaded systems, jobs are launched from updateQueue() as well, which lets us bound
+    // the amount of decoded data held in flight and pick cheap textures first.
+    if constexpr (UTILS_HAS_THREADING) {
+        launchTranscoderJobs();
     }
+    return texture;
+}
 
+void Ktx2Provider::startTranscoderJob(QueueItem* item) {
+    assert_invariant(!item->started);
     JobSystem* js = &mEngine->getJobSystem();
-    item->job = jobs::createJob(*js, mDecoderRootJob, [item] {
+    mInflightDecodeBytes += item->estimatedDecodeBytes;
+    item->started = true;
+    item->job = jobs::createJob(*js, mDecoderRootJob, [this, item] {
         using Result = ktxreader::Ktx2Reader::Result;
-        const bool success = Result::SUCCESS == item->async->doTranscoding();
+        const bool success = item->cachePath.empty()
+                ? Result::SUCCESS == item->async->doTranscoding()
+                : transcodeToCache(item);
         item->transcoderState.store(success ? TranscoderState::SUCCESS : TranscoderState::ERROR);
     });
-
     js->runAndRetain(item->job);
-    return async->getTexture();
+}
+
+void Ktx2Provider::launchTranscoderJobs() {
+    while (true) {
+        // Pick the cheapest unstarted item. Small textures finish (and can be popped) quickly,
+        // which lets a scene with many compressed textures become visually complete early,
+        // while the few expensive textures are still being transcoded.
+        QueueItem* next = nullptr;
+        for (auto& item : mQueueItems) {
+            if (item->state == QueueItemState::TRANSCODING && !item->started &&
+                    (!next || item->estimatedDecodeBytes < next->estimatedDecodeBytes)) {
+                next = item.get();
+            }
+        }
+        if (next == nullptr) {
+            return;
+        }
+        if (mInflightDecodeBytes > 0 &&
+                mInflightDecodeBytes + next->estimatedDecodeBytes > MAX_INFLIGHT_DECODE_BYTES) {
+            return;
+        }
+        startTranscoderJob(next);
+    }
 }
 
 Texture* Ktx2Provider::popTexture() {
@@ -152,6 +243,8 @@ Texture* Ktx2Provider::popTexture() {
 void Ktx2Provider::updateQueue() {
     if (!UTILS_HAS_THREADING) {
         transcodeSingleTexture();
+    } else {
+        launchTranscoderJobs();
     }
     JobSystem* js = &mEngine->getJobSystem();
     for (auto& item : mQueueItems) {
@@ -160,19 +253,31 @@ void Ktx2Provider::updateQueue() {
         }
         item->async->getTexture();
         const TranscoderState state = item->transcoderState.load();
-        if (state != TranscoderState::NOT_STARTED) {
-            if (item->job) {
-                js->waitAndRelease(item->job);
-            }
-            if (state == TranscoderState::ERROR) {
-                item->state = QueueItemState::READY;
-                ++mDecodedCount;
-                continue;
+        if (state == TranscoderState::NOT_STARTED) {
+            // The transcoder job publishes miplevels as they complete (coarsest first), so
+            // upload whatever is available now rather than waiting for the full chain. This
+            // also caps the amount of decoded data the job keeps in memory.
+            if (item->started) {
+                item->async->uploadImages();
             }
-            item->async->uploadImages();
+            continue;
+        }
+        if (item->job) {
+            js->waitAndRelease(item->job);
+            item->job = nullptr;
+        }
+        if (item->started) {
+            mInflightDecodeBytes -= item->estimatedDecodeBytes;
+            item->started = false;
+        }
+        if (state == TranscoderState::ERROR) {
             item->state = QueueItemState::READY;
             ++mDecodedCount;
+            continue;
         }
+        item->async->uploadImages();
+        item->state = QueueItemState::READY;
+        ++mDecodedCount;
     }
 
     // Here we periodically clean up the "queue" (which is really just a vector) by removing unused
@@ -185,17 +290,35 @@ void Ktx2Provider::updateQueue() {
 
 void Ktx2Provider::waitForCompletion() {
     JobSystem& js = mEngine->getJobSystem();
+    // Items held back by the backpressure limit need to be launched now, since the caller
+    // expects every pushed texture to finish decoding.
+    if constexpr (UTILS_HAS_THREADING) {
+        for (auto& item : mQueueItems) {
+            if (item->state == QueueItemState::TRANSCODING && !item->started) {
+                startTranscoderJob(item.get());
+            }
+        }
+    }
     for (auto& item : mQueueItems) {
         if (item->job) {
             js.waitAndRelease(item->job);
+            item->job = nullptr;
         }
     }
 }
 
 void Ktx2Provider::cancelDecoding() {
-    // TODO: Currently, Ktx2Provider runs jobs eagerly and JobSystem does not allow cancellation of
-    // in-flight jobs. We should consider throttling the number of simultaneous decoder jobs, which
-    // would allow for actual cancellation.
+    // Jobs that have not been launched yet (due to the backpressure limit) can be truly
+    // cancelled. JobSystem does not allow cancellation of in-flight jobs, so those are waited
+    // upon below.
+    for (auto& item : mQueueItems) {
+        if (item->state == QueueItemState::TRANSCODING && !item->started) {
+            mKtxReader->asyncDestroy(&item->async);
+            item->async = nullptr;
+            item->state = QueueItemState::POPPED;
+        }
+    }
+
     waitForCompletion();
 
     // For cancelled jobs, we need to set the QueueItemState to POPPED and free the decoded data
@@ -204,6 +327,10 @@ void Ktx2Provider::cancelDecoding() {
         if (item->state != QueueItemState::TRANSCODING) {
             continue;
         }
+        if (item->started) {
+            mInflightDecodeBytes -= item->estimatedDecodeBytes;
+            item->started = false;
+        }
         mKtxReader->asyncDestroy(&item->async);
         item->async = nullptr;
         item->state = QueueItemState::POPPED;
@@ -218,19 +345,170 @@ const char* Ktx2Provider::getPopMessage() const {
     return mRecentPopMessage.empty() ? nullptr : mRecentPopMessage.c_str();
 }
 
+std::string Ktx2Provider::getCachePath(uint64_t sourceHash, Texture::InternalFormat format) const {
+    char name[64];
+    snprintf(name, sizeof(name), "%016llx_%u.ktc", (unsigned long long) sourceHash,
+            unsigned(format));
+    return (mCacheDirectory + name).getPath();
+}
+
+bool Ktx2Provider::loadFromCache(QueueItem* item) const {
+    std::ifstream in(item->cachePath, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    Texture* texture = item->async->getTexture();
+    CacheEntryHeader header;
+    in.read((char*) &header, sizeof(header));
+    if (!in || header.magic != CacheEntryHeader::MAGIC ||
+            header.version != CacheEntryHeader::VERSION ||
+            header.sourceHash != item->sourceHash ||
+            header.format != uint32_t(texture->getFormat()) ||
+            header.levelCount == 0 || header.levelCount > texture->getLevels()) {
+        slog.w << "Ignoring invalid transcode cache entry " << item->cachePath.c_str() << io::endl;
+        return false;
+    }
+
+    // Read and validate the whole entry before injecting anything, so a truncated or corrupt
+    // file cannot leave the texture with a partial mip chain.
+    const size_t maxLevelByteCount = size_t(texture->getWidth()) * texture->getHeight() * 4u;
+    struct Level {
+        uint32_t index;
+        vector<uint8_t> payload;
+    };
+    vector<Level> levels(header.levelCount);
+    for (auto& level : levels) {
+        uint32_t byteCount;
+        in.read((char*) &level.index, sizeof(level.index));
+        in.read((char*) &byteCount, sizeof(byteCount));
+        if (!in || level.index >= texture->getLevels() ||
+                byteCount == 0 || byteCount > maxLevelByteCount) {
+            slog.w << "Ignoring invalid transcode cache entry " << item->cachePath.c_str()
+                    << io::endl;
+            return false;
+        }
+        level.payload.resize(byteCount);
+        in.read((char*) level.payload.data(), byteCount);
+        if (!in) {
+            slog.w << "Ignoring truncated transcode cache entry " << item->cachePath.c_str()
+                    << io::endl;
+            return false;
+        }
+    }
+    for (const auto& level : levels) {
+        item->async->setTranscodedLevel(level.index, level.payload.data(), level.payload.size());
+    }
+    return true;
+}
+
+bool Ktx2Provider::transcodeToCache(QueueItem* item) const {
+    using Result = ktxreader::Ktx2Reader::Result;
+    struct WriteState {
+        std::ofstream out;
+        uint32_t levelCount = 0;
+    };
+
+    // The temporary name embeds the item pointer so that concurrent jobs transcoding identical
+    // content cannot clobber each other; the finished entry is then published with rename().
+    const std::string tmpPath =
+            item->cachePath + "." + std::to_string(uintptr_t(item)) + ".tmp";
+    WriteState ws;
+    ws.out.open(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!ws.out) {
+        // The cache directory is unwritable; fall back to plain transcoding.
+        return Result::SUCCESS == item->async->doTranscoding();
+    }
+
+    CacheEntryHeader header = { CacheEntryHeader::MAGIC, CacheEntryHeader::VERSION,
+            item->sourceHash, uint32_t(item->async->getTexture()->getFormat()), 0 };
+    ws.out.write((const char*) &header, sizeof(header));
+
+    const Result result = item->async->doTranscoding(
+            [](uint32_t levelIndex, const void* data, size_t byteCount, void* user) {
+                WriteState* ws = (WriteState*) user;
+                const uint32_t recordByteCount = uint32_t(byteCount);
+                ws->out.write((const char*) &levelIndex, sizeof(levelIndex));
+                ws->out.write((const char*) &recordByteCount, sizeof(recordByteCount));
+                ws->out.write((const char*) data, std::streamsize(byteCount));
+                ++ws->levelCount;
+            }, &ws);
+
+    bool committed = false;
+    if (result == Result::SUCCESS && ws.out.good()) {
+        // Patch the level count now that it is known, then publish the entry.
+        ws.out.seekp(offsetof(CacheEntryHeader, levelCount));
+        ws.out.write((const char*) &ws.levelCount, sizeof(ws.levelCount));
+        ws.out.close();
+        committed = ws.out.good() && rename(tmpPath.c_str(), item->cachePath.c_str()) == 0;
+    } else {
+        ws.out.close();
+    }
+    if (committed) {
+        trimCache();
+    } else {
+        remove(tmpPath.c_str());
+    }
+    return result == Result::SUCCESS;
+}
+
+void Ktx2Provider::trimCache() const {
+    struct Entry {
+        utils::Path path;
+        size_t byteCount;
+        time_t modTime;
+    };
+    std::vector<Entry> entries;
+    size_t totalByteCount = 0;
+    for (const auto& file : mCacheDirectory.listContents()) {
+        if (file.getExtension() != "ktc") {
+            continue;
+        }
+        struct stat status = {};
+        if (stat(file.c_str(), &status) != 0) {
+            continue;
+        }
+        entries.push_back({ file, size_t(status.st_size), status.st_mtime });
+        totalByteCount += size_t(status.st_size);
+    }
+    if (totalByteCount <= mMaxCacheByteCount) {
+        return;
+    }
+    // Evict the oldest entries first. Note that eviction is by write time, not access time,
+    // which keeps the bookkeeping trivial; frequently used entries are simply re-created.
+    std::sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) { return a.modTime < b.modTime; });
+    for (const auto& entry : entries) {
+        if (totalByteCount <= mMaxCacheByteCount) {
+            break;
+        }
+        if (remove(entry.path.c_str()) == 0) {
+            totalByteCount -= entry.byteCount;
+        }
+    }
+}
+
 void Ktx2Provider::transcodeSingleTexture() {
     assert_invariant(!UTILS_HAS_THREADING);
     for (auto& item : mQueueItems) {
         if (item->state == QueueItemState::TRANSCODING) {
             using Result = ktxreader::Ktx2Reader::Result;
-            bool success = Result::SUCCESS == item->async->doTranscoding();
+            bool success = item->cachePath.empty()
+                    ? Result::SUCCESS == item->async->doTranscoding()
+                    : transcodeToCache(item.get());
             item->transcoderState.store(success ? TranscoderState::SUCCESS : TranscoderState::ERROR);
             break;
         }
     }
 }
 
-Ktx2Provider::Ktx2Provider(Engine* engine) : mEngine(engine) {
+Ktx2Provider::Ktx2Provider(Engine* engine, const char* transcodeCacheDirectory,
+        size_t maxCacheByteCount)
+        : mCacheDirectory(transcodeCacheDirectory ? transcodeCacheDirectory : ""),
+          mMaxCacheByteCount(maxCacheByteCount),
+          mEngine(engine) {
+    if (!mCacheDirectory.isEmpty()) {
+        mCacheDirectory.mkdirRecursive();
+    }
     mDecoderRootJob = mEngine->getJobSystem().createJob();
 #ifdef NDEBUG
     const bool quiet = true;
@@ -257,7 +535,12 @@ Ktx2Provider::~Ktx2Provider() {
 }
 
 TextureProvider* createKtx2Provider(Engine* engine) {
-    return new Ktx2Provider(engine);
+    return new Ktx2Provider(engine, nullptr, 0);
+}
+
+TextureProvider* createKtx2Provider(Engine* engine, const char* transcodeCacheDirectory,
+        size_t maxCacheByteCount) {
+    return new Ktx2Provider(engine, transcodeCacheDirectory, maxCacheByteCount);
 }
 
 } // namespace filament::gltfio
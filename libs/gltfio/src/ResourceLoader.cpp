@@ -47,9 +47,12 @@
 
 #include <tsl/robin_map.h>
 
+#include <cstring>
 #include <fstream>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 using namespace filament;
 using namespace filament::math;
@@ -78,11 +81,13 @@ struct ResourceLoader::Impl {
     explicit Impl(const ResourceConfiguration& config) :
         mEngine(config.engine),
         mNormalizeSkinningWeights(config.normalizeSkinningWeights),
+        mOptimizeVertexCache(config.optimizeVertexCache),
         mGltfPath(config.gltfPath ? config.gltfPath : ""),
         mUriDataCache(std::make_shared<UriDataCache>()) {}
 
     Engine* const mEngine;
     bool mNormalizeSkinningWeights;
+    bool mOptimizeVertexCache;
     std::string mGltfPath;
 
     // User-provided resource data with URI string keys, populated with addResourceData().
@@ -99,12 +104,28 @@ struct ResourceLoader::Impl {
     FFilamentAsset* mAsyncAsset = nullptr;
     size_t mRemainingTextureDownloads = 0;
 
+    // Streaming state for asyncBeginLoad: buffer slots whose source buffer had not been
+    // supplied yet, keyed by the missing cgltf buffer, along with the entities whose reveal is
+    // gated on them. Tangent generation for primitives touching a missing buffer is deferred
+    // the same way. Everything here is resolved from addResourceData() as buffers arrive.
+    struct PendingBuffer {
+        std::vector<BufferSlot> slots;
+        std::vector<utils::Entity> entities;
+    };
+    tsl::robin_map<const cgltf_buffer*, PendingBuffer> mPendingBuffers;
+    std::vector<std::pair<const cgltf_primitive*, std::pair<VertexBuffer*, uint8_t>>>
+            mPendingTangentPrims;
+
     void addResourceData(const char* uri, BufferDescriptor&& buffer);
     void computeTangents(FFilamentAsset* asset);
     void createTextures(FFilamentAsset* asset, bool async);
     void cancelTextureDecoding();
     std::pair<Texture*, CacheResult> getOrCreateTexture(FFilamentAsset* asset, size_t textureIndex,
             TextureProvider::TextureFlags flags);
+    void uploadBufferSlot(FFilamentAsset* asset, BufferSlot const& slot);
+    void deferBufferSlot(FFilamentAsset* asset, BufferSlot const& slot);
+    void resolvePendingBuffers(const char* uri);
+    void generatePendingTangents(FFilamentAsset* asset);
     ~Impl();
 };
 
@@ -166,7 +187,35 @@ static bool requiresPacking(const cgltf_accessor* accessor) {
     }
 }
 
-static void decodeDracoMeshes(FFilamentAsset* asset) {
+static bool primitiveUsesBuffer(const cgltf_primitive* prim, const cgltf_buffer* buffer) {
+    if (prim->indices && prim->indices->buffer_view
+            && prim->indices->buffer_view->buffer == buffer) {
+        return true;
+    }
+    for (cgltf_size i = 0; i < prim->attributes_count; i++) {
+        const cgltf_accessor* accessor = prim->attributes[i].data;
+        if (accessor->buffer_view && accessor->buffer_view->buffer == buffer) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool primitiveDataResident(const cgltf_primitive* prim) {
+    if (prim->indices && prim->indices->buffer_view
+            && !prim->indices->buffer_view->buffer->data) {
+        return false;
+    }
+    for (cgltf_size i = 0; i < prim->attributes_count; i++) {
+        const cgltf_accessor* accessor = prim->attributes[i].data;
+        if (accessor->buffer_view && !accessor->buffer_view->buffer->data) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void decodeDracoMeshes(FFilamentAsset* asset, JobSystem& js) {
     DracoCache* dracoCache = &asset->mSourceAsset->dracoCache;
 
     // For a given primitive and attribute, find the corresponding accessor.
@@ -180,52 +229,103 @@ static void decodeDracoMeshes(FFilamentAsset* asset) {
         return (cgltf_accessor*) nullptr;
     };
 
-    // Go through every primitive and check if it has a Draco mesh.
-    for (auto& [prim, vertexBuffer] : asset->mPrimitives) {
+    // Group primitives by the buffer view that holds their compressed data. Each workload
+    // decompresses one Draco mesh and converts it into the accessors of the primitives that
+    // reference it, so workloads touch disjoint data and can fan out across the JobSystem.
+    struct Workload {
+        const cgltf_buffer_view* view;
+        DracoMesh* mesh;                    // already decoded by a previous load, if any
+        std::unique_ptr<DracoMesh> decoded; // decoded by this call's job
+        std::vector<std::pair<const cgltf_primitive*, VertexBuffer**>> primitives;
+    };
+    std::vector<Workload> workloads;
+    tsl::robin_map<const cgltf_buffer_view*, size_t> groups;
+    for (auto& [prim, vertexBuffer] : asset->mGeometry->primitives) {
         if (!prim->has_draco_mesh_compression) {
             continue;
         }
+        const cgltf_buffer_view* view = prim->draco_mesh_compression.buffer_view;
+        auto [iter, added] = groups.emplace(view, workloads.size());
+        if (added) {
+            workloads.push_back({ view, dracoCache->find(view), nullptr, {} });
+        }
+        workloads[iter->second].primitives.emplace_back(prim, &vertexBuffer);
+    }
 
-        const cgltf_draco_mesh_compression& draco = prim->draco_mesh_compression;
-
-        // If an error occurs, we can simply set the primitive's associated VertexBuffer to null.
-        // This does not cause a leak because it is a weak reference.
+    if (workloads.empty()) {
+        return;
+    }
 
-        // Check if we have already decoded this mesh.
-        DracoMesh* mesh = dracoCache->findOrCreateMesh(draco.buffer_view);
+    auto processWorkload = [asset, &findAccessor](Workload& workload) {
+        DracoMesh* mesh = workload.mesh;
         if (!mesh) {
-            slog.e << "Cannot decompress mesh, Draco decoding error." << io::endl;
-            vertexBuffer = nullptr;
-            continue;
-        }
-
-        // Copy over the decompressed data, converting the data type if necessary.
-        if (prim->indices && !mesh->getFaceIndices(prim->indices)) {
-            vertexBuffer = nullptr;
-            continue;
+            const cgltf_buffer_view* view = workload.view;
+            assert(view->buffer && view->buffer->data);
+            const uint8_t* compressedData = view->offset + (uint8_t*) view->buffer->data;
+            workload.decoded.reset(DracoMesh::decode(compressedData, view->size));
+            mesh = workload.decoded.get();
         }
 
-        // Go through each attribute in the decompressed mesh.
-        for (cgltf_size i = 0; i < draco.attributes_count; i++) {
-
-            // In cgltf, each Draco attribute's data pointer is an attribute id, not an accessor.
-            const uint32_t id = draco.attributes[i].data - asset->mSourceAsset->hierarchy->accessors;
-
-            // Find the destination accessor; this contains the desired component type, etc.
-            const cgltf_attribute_type type = draco.attributes[i].type;
-            const cgltf_int index = draco.attributes[i].index;
-            cgltf_accessor* accessor = findAccessor(prim, type, index);
-            if (!accessor) {
-                slog.w << "Cannot find matching accessor for Draco id " << id << io::endl;
+        for (auto& [prim, vertexBuffer] : workload.primitives) {
+            // If an error occurs, we can simply set the primitive's associated VertexBuffer to
+            // null. This does not cause a leak because it is a weak reference.
+            if (!mesh) {
+                slog.e << "Cannot decompress mesh, Draco decoding error." << io::endl;
+                *vertexBuffer = nullptr;
                 continue;
             }
 
             // Copy over the decompressed data, converting the data type if necessary.
-            if (!mesh->getVertexAttributes(id, accessor)) {
-                vertexBuffer = nullptr;
-                break;
+            if (prim->indices && !mesh->getFaceIndices(prim->indices)) {
+                *vertexBuffer = nullptr;
+                continue;
+            }
+
+            const cgltf_draco_mesh_compression& draco = prim->draco_mesh_compression;
+
+            // Go through each attribute in the decompressed mesh.
+            for (cgltf_size i = 0; i < draco.attributes_count; i++) {
+
+                // In cgltf, each Draco attribute's data pointer is an attribute id, not an accessor.
+                const uint32_t id = draco.attributes[i].data - asset->mSourceAsset->hierarchy->accessors;
+
+                // Find the destination accessor; this contains the desired component type, etc.
+                const cgltf_attribute_type type = draco.attributes[i].type;
+                const cgltf_int index = draco.attributes[i].index;
+                cgltf_accessor* accessor = findAccessor(prim, type, index);
+                if (!accessor) {
+                    slog.w << "Cannot find matching accessor for Draco id " << id << io::endl;
+                    continue;
+                }
+
+                // Copy over the decompressed data, converting the data type if necessary.
+                if (!mesh->getVertexAttributes(id, accessor)) {
+                    *vertexBuffer = nullptr;
+                    break;
+                }
             }
         }
+    };
+
+    if constexpr (UTILS_HAS_THREADING) {
+        JobSystem::Job* parent = js.createJob();
+        for (Workload& workload : workloads) {
+            Workload* wptr = &workload;
+            js.run(jobs::createJob(js, parent,
+                    [wptr, &processWorkload] { processWorkload(*wptr); }));
+        }
+        js.runAndWait(parent);
+    } else {
+        for (Workload& workload : workloads) {
+            processWorkload(workload);
+        }
+    }
+
+    // The cache is not concurrent; insertions happen here, after all jobs have completed.
+    for (Workload& workload : workloads) {
+        if (workload.decoded) {
+            dracoCache->add(workload.view, workload.decoded.release());
+        }
     }
 }
 
@@ -323,6 +423,7 @@ ResourceLoader::~ResourceLoader() {
 
 void ResourceLoader::setConfiguration(const ResourceConfiguration& config) {
     pImpl->mNormalizeSkinningWeights = config.normalizeSkinningWeights;
+    pImpl->mOptimizeVertexCache = config.optimizeVertexCache;
     pImpl->mGltfPath = config.gltfPath;
 }
 
@@ -371,6 +472,12 @@ void ResourceLoader::Impl::addResourceData(const char* uri, BufferDescriptor&& b
     }
     mUriDataCache->emplace(uri, std::move(buffer));
 
+    // If async loading is underway and geometry uploads were deferred on this buffer, upload
+    // them now and reveal the renderables that were waiting on it.
+    if (mAsyncAsset && !mPendingBuffers.empty()) {
+        resolvePendingBuffers(uri);
+    }
+
     // If this is a texture and async loading has already started, add a new decoder job.
     if (isTexture(uri) && mAsyncAsset && mRemainingTextureDownloads > 0) {
         createTextures(mAsyncAsset, true);
@@ -400,11 +507,6 @@ bool ResourceLoader::loadResources(FFilamentAsset* asset, bool async) {
     }
     asset->mResourcesLoaded = true;
 
-    // At this point, any entities that are created in the future (i.e. dynamically added instances)
-    // will not need the progressive feature to be enabled. This simplifies the dependency graph and
-    // prevents it from growing.
-    asset->mDependencyGraph.disableProgressiveReveal();
-
     // Clear our texture caches. Previous calls to loadResources may have populated these, but the
     // Texture objects could have since been destroyed.
     pImpl->mBufferTextureCache.clear();
@@ -465,7 +567,7 @@ bool ResourceLoader::loadResources(FFilamentAsset* asset, bool async) {
     #endif
     // Decompress Draco meshes early on, which allows us to exploit subsequent processing such as
     // tangent generation.
-    decodeDracoMeshes(asset);
+    decodeDracoMeshes(asset, pImpl->mEngine->getJobSystem());
     decodeMeshoptCompression((cgltf_data*) gltf);
 
     // For each skin, optionally normalize skinning weights and store a copy of the bind matrices.
@@ -504,94 +606,36 @@ bool ResourceLoader::loadResources(FFilamentAsset* asset, bool async) {
         }
     }
 
-    Engine& engine = *pImpl->mEngine;
-
-    // Upload VertexBuffer and IndexBuffer data to the GPU.
-    for (auto slot : asset->mBufferSlots) {
+    // Upload VertexBuffer and IndexBuffer data to the GPU. In the async case, slots whose
+    // source buffer has not been supplied yet are deferred; they are uploaded from
+    // addResourceData() when their buffer arrives, and the affected renderables are revealed
+    // incrementally through the dependency graph.
+    for (auto slot : asset->mGeometry->bufferSlots) {
         const cgltf_accessor* accessor = slot.accessor;
         if (!accessor->buffer_view) {
             continue;
         }
-        const uint8_t* bufferData = nullptr;
-        const uint8_t* data = nullptr;
-        if (accessor->buffer_view->has_meshopt_compression) {
-            bufferData = (const uint8_t*) accessor->buffer_view->data;
-            data = bufferData + accessor->offset;
-        } else {
-            bufferData = (const uint8_t*) accessor->buffer_view->buffer->data;
-            data = computeBindingOffset(accessor) + bufferData;
-        }
-        assert_invariant(bufferData);
-        const uint32_t size = computeBindingSize(accessor);
-        if (slot.vertexBuffer) {
-            if (requiresConversion(accessor)) {
-                const size_t floatsCount = accessor->count * cgltf_num_components(accessor->type);
-                const size_t floatsByteCount = sizeof(float) * floatsCount;
-                float* floatsData = (float*) malloc(floatsByteCount);
-                cgltf_accessor_unpack_floats(accessor, floatsData, floatsCount);
-                BufferObject* bo = BufferObject::Builder().size(floatsByteCount).build(engine);
-                asset->mBufferObjects.push_back(bo);
-                bo->setBuffer(engine, BufferDescriptor(floatsData, floatsByteCount, FREE_CALLBACK));
-                slot.vertexBuffer->setBufferObjectAt(engine, slot.bufferIndex, bo);
-                continue;
-            }
-            BufferObject* bo = BufferObject::Builder().size(size).build(engine);
-            asset->mBufferObjects.push_back(bo);
-            bo->setBuffer(engine, BufferDescriptor(data, size,
-                    uploadCallback, uploadUserdata(asset, pImpl->mUriDataCache)));
-            slot.vertexBuffer->setBufferObjectAt(engine, slot.bufferIndex, bo);
-            continue;
-        } else if (slot.indexBuffer) {
-            if (accessor->component_type == cgltf_component_type_r_8u) {
-                const size_t size16 = size * 2;
-                uint16_t* data16 = (uint16_t*) malloc(size16);
-                convertBytesToShorts(data16, data, size);
-                IndexBuffer::BufferDescriptor bd(data16, size16, FREE_CALLBACK);
-                slot.indexBuffer->setBuffer(engine, std::move(bd));
-                continue;
-            }
-            IndexBuffer::BufferDescriptor bd(data, size, uploadCallback,
-                    uploadUserdata(asset, pImpl->mUriDataCache));
-            slot.indexBuffer->setBuffer(engine, std::move(bd));
-            continue;
-        }
-
-        // If the buffer slot does not have an associated VertexBuffer or IndexBuffer, then this
-        // must be a morph target.
-        assert(slot.morphTargetBuffer);
-
-        if (requiresPacking(accessor)) {
-            const size_t floatsCount = accessor->count * cgltf_num_components(accessor->type);
-            const size_t floatsByteCount = sizeof(float) * floatsCount;
-            float* floatsData = (float*) malloc(floatsByteCount);
-            cgltf_accessor_unpack_floats(accessor, floatsData, floatsCount);
-            if (accessor->type == cgltf_type_vec3) {
-                slot.morphTargetBuffer->setPositionsAt(engine, slot.bufferIndex,
-                        (const float3*) floatsData, slot.morphTargetBuffer->getVertexCount());
-            } else {
-                slot.morphTargetBuffer->setPositionsAt(engine, slot.bufferIndex,
-                        (const float4*) data, slot.morphTargetBuffer->getVertexCount());
-            }
-            free(floatsData);
+        if (async && UTILS_UNLIKELY(accessor->buffer_view->buffer->data == nullptr
+                && !accessor->buffer_view->has_meshopt_compression
+                && !accessor->is_sparse)) {
+            pImpl->deferBufferSlot(asset, slot);
             continue;
         }
-
-        if (accessor->type == cgltf_type_vec3) {
-            slot.morphTargetBuffer->setPositionsAt(engine, slot.bufferIndex,
-                    (const float3*) data, slot.morphTargetBuffer->getVertexCount());
-        } else {
-            assert_invariant(accessor->type == cgltf_type_vec4);
-            slot.morphTargetBuffer->setPositionsAt(engine, slot.bufferIndex,
-                    (const float4*) data, slot.morphTargetBuffer->getVertexCount());
-        }
+        pImpl->uploadBufferSlot(asset, slot);
     }
 
+    // At this point, any entities that are created in the future (i.e. dynamically added instances)
+    // will not need the progressive feature to be enabled. This simplifies the dependency graph and
+    // prevents it from growing. Entities gated on deferred geometry stay hidden until their
+    // buffers stream in.
+    asset->mDependencyGraph.disableProgressiveReveal();
+
     // Compute surface orientation quaternions if necessary. This is similar to sparse data in that
     // we need to generate the contents of a GPU buffer by processing one or more CPU buffer(s).
     pImpl->computeTangents(asset);
 
-    asset->mBufferSlots = {};
-    asset->mPrimitives = {};
+    asset->mGeometry->bufferSlots = {};
+    asset->mGeometry->primitives = {};
 
     // If any decoding jobs are still underway from a previous load, wait for them to finish.
     for (const auto& iter : pImpl->mTextureProviders) {
@@ -615,11 +659,15 @@ bool ResourceLoader::loadResources(FFilamentAsset* asset, bool async) {
 
 bool ResourceLoader::asyncBeginLoad(FilamentAsset* asset) {
     pImpl->mAsyncAsset = downcast(asset);
+    pImpl->mPendingBuffers.clear();
+    pImpl->mPendingTangentPrims.clear();
     return loadResources(downcast(asset), true);
 }
 
 void ResourceLoader::asyncCancelLoad() {
     pImpl->cancelTextureDecoding();
+    pImpl->mPendingBuffers.clear();
+    pImpl->mPendingTangentPrims.clear();
     pImpl->mAsyncAsset = nullptr;
     pImpl->mEngine->flushAndWait();
 }
@@ -807,6 +855,221 @@ void ResourceLoader::Impl::createTextures(FFilamentAsset* asset, bool async) {
     }
 }
 
+void ResourceLoader::Impl::uploadBufferSlot(FFilamentAsset* asset, BufferSlot const& slot) {
+    Engine& engine = *mEngine;
+    const cgltf_accessor* accessor = slot.accessor;
+    assert_invariant(accessor->buffer_view);
+    const uint8_t* bufferData = nullptr;
+    const uint8_t* data = nullptr;
+    if (accessor->buffer_view->has_meshopt_compression) {
+        bufferData = (const uint8_t*) accessor->buffer_view->data;
+        data = bufferData + accessor->offset;
+    } else {
+        bufferData = (const uint8_t*) accessor->buffer_view->buffer->data;
+        data = computeBindingOffset(accessor) + bufferData;
+    }
+    assert_invariant(bufferData);
+    const uint32_t size = computeBindingSize(accessor);
+    if (slot.vertexBuffer) {
+        if (requiresConversion(accessor)) {
+            const size_t floatsCount = accessor->count * cgltf_num_components(accessor->type);
+            const size_t floatsByteCount = sizeof(float) * floatsCount;
+            float* floatsData = (float*) malloc(floatsByteCount);
+            cgltf_accessor_unpack_floats(accessor, floatsData, floatsCount);
+            BufferObject* bo = BufferObject::Builder().size(floatsByteCount).build(engine);
+            asset->mGeometry->bufferObjects.push_back(bo);
+            bo->setBuffer(engine, BufferDescriptor(floatsData, floatsByteCount, FREE_CALLBACK));
+            slot.vertexBuffer->setBufferObjectAt(engine, slot.bufferIndex, bo);
+            return;
+        }
+        BufferObject* bo = BufferObject::Builder().size(size).build(engine);
+        asset->mGeometry->bufferObjects.push_back(bo);
+        bo->setBuffer(engine, BufferDescriptor(data, size,
+                uploadCallback, uploadUserdata(asset, mUriDataCache)));
+        slot.vertexBuffer->setBufferObjectAt(engine, slot.bufferIndex, bo);
+        return;
+    } else if (slot.indexBuffer) {
+        // Optionally re-order triangles for post-transform cache efficiency. Only index data is
+        // touched, so this is safe for skinned and morphed primitives; vertex fetch re-ordering
+        // would need to shuffle (potentially shared) vertex buffers and is left to offline tools
+        // such as filamesh.
+        if (mOptimizeVertexCache && slot.triangles && accessor->count % 3 == 0) {
+            const size_t indexCount = accessor->count;
+            std::vector<uint32_t> indices(indexCount);
+            uint32_t vertexCount = 0;
+            for (size_t i = 0; i < indexCount; ++i) {
+                indices[i] = cgltf_accessor_read_index(accessor, i);
+                vertexCount = std::max(vertexCount, indices[i] + 1);
+            }
+            meshopt_optimizeVertexCache(indices.data(), indices.data(), indexCount, vertexCount);
+            if (accessor->component_type == cgltf_component_type_r_32u) {
+                const size_t byteCount = indexCount * sizeof(uint32_t);
+                uint32_t* data32 = (uint32_t*) malloc(byteCount);
+                memcpy(data32, indices.data(), byteCount);
+                IndexBuffer::BufferDescriptor bd(data32, byteCount, FREE_CALLBACK);
+                slot.indexBuffer->setBuffer(engine, std::move(bd));
+            } else {
+                const size_t byteCount = indexCount * sizeof(uint16_t);
+                uint16_t* data16 = (uint16_t*) malloc(byteCount);
+                for (size_t i = 0; i < indexCount; ++i) {
+                    data16[i] = (uint16_t) indices[i];
+                }
+                IndexBuffer::BufferDescriptor bd(data16, byteCount, FREE_CALLBACK);
+                slot.indexBuffer->setBuffer(engine, std::move(bd));
+            }
+            return;
+        }
+        if (accessor->component_type == cgltf_component_type_r_8u) {
+            const size_t size16 = size * 2;
+            uint16_t* data16 = (uint16_t*) malloc(size16);
+            convertBytesToShorts(data16, data, size);
+            IndexBuffer::BufferDescriptor bd(data16, size16, FREE_CALLBACK);
+            slot.indexBuffer->setBuffer(engine, std::move(bd));
+            return;
+        }
+        IndexBuffer::BufferDescriptor bd(data, size, uploadCallback,
+                uploadUserdata(asset, mUriDataCache));
+        slot.indexBuffer->setBuffer(engine, std::move(bd));
+        return;
+    }
+
+    // If the buffer slot does not have an associated VertexBuffer or IndexBuffer, then this
+    // must be a morph target.
+    assert(slot.morphTargetBuffer);
+
+    if (requiresPacking(accessor)) {
+        const size_t floatsCount = accessor->count * cgltf_num_components(accessor->type);
+        const size_t floatsByteCount = sizeof(float) * floatsCount;
+        float* floatsData = (float*) malloc(floatsByteCount);
+        cgltf_accessor_unpack_floats(accessor, floatsData, floatsCount);
+        if (accessor->type == cgltf_type_vec3) {
+            slot.morphTargetBuffer->setPositionsAt(engine, slot.bufferIndex,
+                    (const float3*) floatsData, slot.morphTargetBuffer->getVertexCount());
+        } else {
+            slot.morphTargetBuffer->setPositionsAt(engine, slot.bufferIndex,
+                    (const float4*) data, slot.morphTargetBuffer->getVertexCount());
+        }
+        free(floatsData);
+        return;
+    }
+
+    if (accessor->type == cgltf_type_vec3) {
+        slot.morphTargetBuffer->setPositionsAt(engine, slot.bufferIndex,
+                (const float3*) data, slot.morphTargetBuffer->getVertexCount());
+    } else {
+        assert_invariant(accessor->type == cgltf_type_vec4);
+        slot.morphTargetBuffer->setPositionsAt(engine, slot.bufferIndex,
+                (const float4*) data, slot.morphTargetBuffer->getVertexCount());
+    }
+}
+
+void ResourceLoader::Impl::deferBufferSlot(FFilamentAsset* asset, BufferSlot const& slot) {
+    const cgltf_buffer* buffer = slot.accessor->buffer_view->buffer;
+    auto iter = mPendingBuffers.find(buffer);
+    if (iter != mPendingBuffers.end()) {
+        iter.value().slots.push_back(slot);
+        return;
+    }
+
+    // First deferred slot for this buffer: register a geometry dependency for every entity
+    // whose mesh touches the buffer, so that the dependency graph withholds them from the
+    // ready queue until the buffer arrives.
+    PendingBuffer& pending = mPendingBuffers[buffer];
+    pending.slots.push_back(slot);
+    const cgltf_data* gltf = asset->mSourceAsset->hierarchy;
+    for (cgltf_size i = 0, n = gltf->nodes_count; i < n; ++i) {
+        const cgltf_node& node = gltf->nodes[i];
+        if (!node.mesh) {
+            continue;
+        }
+        bool usesBuffer = false;
+        for (cgltf_size pindex = 0, pcount = node.mesh->primitives_count;
+                pindex < pcount && !usesBuffer; ++pindex) {
+            usesBuffer = primitiveUsesBuffer(&node.mesh->primitives[pindex], buffer);
+        }
+        if (!usesBuffer) {
+            continue;
+        }
+        for (FFilamentInstance* instance : asset->mInstances) {
+            Entity entity = instance->mNodeMap[i];
+            if (entity.isNull()) {
+                continue;
+            }
+            asset->mDependencyGraph.addGeometryDependency(entity);
+            pending.entities.push_back(entity);
+        }
+    }
+}
+
+void ResourceLoader::Impl::resolvePendingBuffers(const char* uri) {
+    FFilamentAsset* const asset = mAsyncAsset;
+    assert_invariant(asset);
+    auto cached = mUriDataCache->find(uri);
+    if (cached == mUriDataCache->end()) {
+        return;
+    }
+    for (auto iter = mPendingBuffers.begin(); iter != mPendingBuffers.end();) {
+        const cgltf_buffer* buffer = iter->first;
+        if (!buffer->uri || strcmp(buffer->uri, uri) != 0) {
+            ++iter;
+            continue;
+        }
+
+        // Point cgltf at the cached blob; the cache outlives the source hierarchy and the
+        // upload callbacks hold a reference to it, exactly as in the non-deferred path.
+        ((cgltf_buffer*) buffer)->data = cached->second.buffer;
+        ((cgltf_buffer*) buffer)->data_free_method = cgltf_data_free_method_none;
+
+        PendingBuffer& pending = iter.value();
+        for (BufferSlot const& slot : pending.slots) {
+            uploadBufferSlot(asset, slot);
+        }
+
+        // Some deferred tangent jobs may now have all of their source data.
+        generatePendingTangents(asset);
+
+        for (Entity const entity : pending.entities) {
+            asset->mDependencyGraph.markGeometryReady(entity);
+        }
+        iter = mPendingBuffers.erase(iter);
+    }
+}
+
+void ResourceLoader::Impl::generatePendingTangents(FFilamentAsset* asset) {
+    using Params = TangentsJob::Params;
+    JobSystem* js = &mEngine->getJobSystem();
+    std::vector<Params> jobParams;
+    for (auto iter = mPendingTangentPrims.begin(); iter != mPendingTangentPrims.end();) {
+        auto [prim, target] = *iter;
+        if (!primitiveDataResident(prim)) {
+            ++iter;
+            continue;
+        }
+        jobParams.emplace_back(Params {{ prim, TangentsJob::kMorphTargetUnused, js },
+                                       { target.first, nullptr, target.second }});
+        iter = mPendingTangentPrims.erase(iter);
+    }
+    if (jobParams.empty()) {
+        return;
+    }
+
+    JobSystem::Job* parent = js->createJob();
+    for (Params& params : jobParams) {
+        Params* pptr = &params;
+        js->run(jobs::createJob(*js, parent, [pptr] { TangentsJob::run(pptr); }));
+    }
+    js->runAndWait(parent);
+
+    for (Params& params : jobParams) {
+        BufferObject* bo = BufferObject::Builder()
+                .size(params.out.vertexCount * sizeof(short4)).build(*mEngine);
+        asset->mGeometry->bufferObjects.push_back(bo);
+        bo->setBuffer(*mEngine, BufferDescriptor(
+                params.out.results, bo->getByteCount(), FREE_CALLBACK));
+        params.context.vb->setBufferObjectAt(*mEngine, params.context.slot, bo);
+    }
+}
+
 void ResourceLoader::Impl::computeTangents(FFilamentAsset* asset) {
     SYSTRACE_CALL();
 
@@ -815,7 +1078,7 @@ void ResourceLoader::Impl::computeTangents(FFilamentAsset* asset) {
 
     // Collect all TANGENT vertex attribute slots that need to be populated.
     tsl::robin_map<VertexBuffer*, uint8_t> baseTangents;
-    for (auto slot : asset->mBufferSlots) {
+    for (auto slot : asset->mGeometry->bufferSlots) {
         if (slot.accessor != kGenerateTangents && slot.accessor != kGenerateNormals) {
             continue;
         }
@@ -824,21 +1087,29 @@ void ResourceLoader::Impl::computeTangents(FFilamentAsset* asset) {
 
     // Create a job description for each triangle-based primitive.
     using Params = TangentsJob::Params;
+    JobSystem* js = &mEngine->getJobSystem();
     std::vector<Params> jobParams;
-    for (auto [prim, vb] : asset->mPrimitives) {
+    for (auto [prim, vb] : asset->mGeometry->primitives) {
         if (UTILS_UNLIKELY(prim->type != cgltf_primitive_type_triangles)) {
             continue;
         }
         auto iter = baseTangents.find(vb);
         if (iter != baseTangents.end()) {
-            jobParams.emplace_back(Params {{ prim }, {vb, nullptr, iter->second }});
+            if (UTILS_UNLIKELY(!primitiveDataResident(prim))) {
+                // One of the primitive's source buffers is still streaming in; the job is
+                // created later by generatePendingTangents().
+                mPendingTangentPrims.emplace_back(prim, std::make_pair(vb, iter->second));
+                continue;
+            }
+            jobParams.emplace_back(Params {{ prim, TangentsJob::kMorphTargetUnused, js },
+                                           {vb, nullptr, iter->second }});
         }
     }
 
     // Create a job description for morph targets.
     for (size_t i = 0, n = asset->mSourceAsset->hierarchy->meshes_count; i < n; ++i) {
         const cgltf_mesh& mesh = asset->mSourceAsset->hierarchy->meshes[i];
-        const FixedCapacityVector<Primitive>& prims = asset->mMeshCache[i];
+        const FixedCapacityVector<Primitive>& prims = asset->mGeometry->meshCache[i];
         if (0 == mesh.weights_count) {
             continue;
         }
@@ -855,13 +1126,13 @@ void ResourceLoader::Impl::computeTangents(FFilamentAsset* asset) {
                         continue;
                     }
                     hasNormals = true;
-                    jobParams.emplace_back(Params { { &prim, (int) tindex },
+                    jobParams.emplace_back(Params { { &prim, (int) tindex, js },
                                                     { nullptr, tb, (uint8_t) pindex } });
                     break;
                 }
                 // Generate flat normals if necessary.
                 if (!hasNormals && prim.material && !prim.material->unlit) {
-                    jobParams.emplace_back(Params { { &prim, (int) tindex },
+                    jobParams.emplace_back(Params { { &prim, (int) tindex, js },
                                                     { nullptr, tb, (uint8_t) pindex } });
                 }
             }
@@ -869,7 +1140,6 @@ void ResourceLoader::Impl::computeTangents(FFilamentAsset* asset) {
     }
 
     // Kick off jobs for computing tangent frames.
-    JobSystem* js = &mEngine->getJobSystem();
     JobSystem::Job* parent = js->createJob();
     for (Params& params : jobParams) {
         Params* pptr = &params;
@@ -882,7 +1152,7 @@ void ResourceLoader::Impl::computeTangents(FFilamentAsset* asset) {
         if (params.context.vb) {
             BufferObject* bo = BufferObject::Builder()
                     .size(params.out.vertexCount * sizeof(short4)).build(*mEngine);
-            asset->mBufferObjects.push_back(bo);
+            asset->mGeometry->bufferObjects.push_back(bo);
             bo->setBuffer(*mEngine, BufferDescriptor(
                     params.out.results, bo->getByteCount(), FREE_CALLBACK));
             params.context.vb->setBufferObjectAt(*mEngine, params.context.slot, bo);
@@ -38,7 +38,7 @@ namespace filament::gltfio {
 
 class StbProvider final : public TextureProvider {
 public:
-    StbProvider(Engine* engine);
+    StbProvider(Engine* engine, ImageDecoderBackend* backend);
     ~StbProvider();
 
     Texture* pushTexture(const uint8_t* data, size_t byteCount,
@@ -66,9 +66,25 @@ private:
         TextureState state;
         atomic<intptr_t> decodedTexelsBaseMipmap;
         vector<uint8_t> sourceBuffer;
+        std::string mimeType;
         JobSystem::Job*  decoderJob;
     };
 
+    // Tries the pluggable backend first (if any), then falls back to stb_image. The returned
+    // buffer is malloc-allocated in both cases. May be called from worker threads.
+    static uint8_t* decodeTexels(ImageDecoderBackend* backend, const vector<uint8_t>& source,
+            const char* mimeType) {
+        if (backend) {
+            uint32_t width, height;
+            if (uint8_t* texels = backend->decode(source.data(), source.size(), mimeType,
+                    &width, &height)) {
+                return texels;
+            }
+        }
+        int width, height, comp;
+        return stbi_load_from_memory(source.data(), source.size(), &width, &height, &comp, 4);
+    }
+
     // Declare some sentinel values for the "decodedTexelsBaseMipmap" field.
     // Note that the "state" field can be modified only on the foreground thread.
     static const intptr_t DECODING_NOT_READY = 0x0;
@@ -83,13 +99,19 @@ private:
     JobSystem::Job* mDecoderRootJob;
     std::string mRecentPushMessage;
     std::string mRecentPopMessage;
+    ImageDecoderBackend* const mBackend;
     Engine* const mEngine;
 };
 
 Texture* StbProvider::pushTexture(const uint8_t* data, size_t byteCount,
             const char* mimeType, TextureFlags flags) {
     int width, height, numComponents;
-    if (!stbi_info_from_memory(data, byteCount, &width, &height, &numComponents)) {
+    uint32_t backendWidth, backendHeight;
+    if (mBackend && mBackend->getDimensions(data, byteCount, mimeType ? mimeType : "",
+            &backendWidth, &backendHeight)) {
+        width = int(backendWidth);
+        height = int(backendHeight);
+    } else if (!stbi_info_from_memory(data, byteCount, &width, &height, &numComponents)) {
         mRecentPushMessage = std::string("Unable to parse texture: ") + stbi_failure_reason();
         return nullptr;
     }
@@ -115,6 +137,7 @@ Texture* StbProvider::pushTexture(const uint8_t* data, size_t byteCount,
     info->texture = texture;
     info->state = TextureState::DECODING;
     info->sourceBuffer.assign(data, data + byteCount);
+    info->mimeType = mimeType ? mimeType : "";
     info->decodedTexelsBaseMipmap.store(DECODING_NOT_READY);
 
     // On single threaded systems, it is usually fine to create jobs because the job system will
@@ -126,15 +149,13 @@ Texture* StbProvider::pushTexture(const uint8_t* data, size_t byteCount,
     }
 
     JobSystem* js = &mEngine->getJobSystem();
-    info->decoderJob = jobs::createJob(*js, mDecoderRootJob, [info] {
+    info->decoderJob = jobs::createJob(*js, mDecoderRootJob, [info, backend = mBackend] {
         auto& source = info->sourceBuffer;
-        int width, height, comp;
 
         // Test asynchronous loading by uncommenting this line.
         // std::this_thread::sleep_for(std::chrono::milliseconds(rand() % 10000));
 
-        stbi_uc* texels = stbi_load_from_memory(source.data(), source.size(),
-                &width, &height, &comp, 4);
+        uint8_t* texels = decodeTexels(backend, source, info->mimeType.c_str());
         source.clear();
         source.shrink_to_fit();
         info->decodedTexelsBaseMipmap.store(texels ? intptr_t(texels) : DECODING_ERROR);
@@ -183,9 +204,10 @@ void StbProvider::updateQueue() {
                 ++mDecodedCount;
                 continue;
             }
+            // Both stb_image and decode backends return malloc-allocated buffers.
             Texture::PixelBufferDescriptor pbd((uint8_t*) data,
                     texture->getWidth() * texture->getHeight() * 4, Texture::Format::RGBA,
-                    Texture::Type::UBYTE, [](void* mem, size_t, void*) { stbi_image_free(mem); });
+                    Texture::Type::UBYTE, [](void* mem, size_t, void*) { free(mem); });
             texture->setImage(*mEngine, 0, std::move(pbd));
 
             // Call generateMipmaps unconditionally to fulfill the promise of the TextureProvider
@@ -231,7 +253,7 @@ void StbProvider::cancelDecoding() {
         // completion above. We also expect the TextureProvider API calls to be made only from one
         // thread.
         if (intptr_t data = info->decodedTexelsBaseMipmap.load()) {
-            delete [] (uint8_t*) data;
+            free((uint8_t*) data);
         }
         info->state = TextureState::POPPED;
     }
@@ -250,9 +272,7 @@ void StbProvider::decodeSingleTexture() {
     for (auto& info : mTextures) {
         if (info->state == TextureState::DECODING) {
             auto& source = info->sourceBuffer;
-            int width, height, comp;
-            stbi_uc* texels = stbi_load_from_memory(source.data(), source.size(),
-                    &width, &height, &comp, 4);
+            uint8_t* texels = decodeTexels(mBackend, source, info->mimeType.c_str());
             source.clear();
             source.shrink_to_fit();
             info->decodedTexelsBaseMipmap.store(texels ? intptr_t(texels) : DECODING_ERROR);
@@ -261,7 +281,8 @@ void StbProvider::decodeSingleTexture() {
     }
 }
 
-StbProvider::StbProvider(Engine* engine) : mEngine(engine) {
+StbProvider::StbProvider(Engine* engine, ImageDecoderBackend* backend)
+        : mBackend(backend), mEngine(engine) {
     mDecoderRootJob = mEngine->getJobSystem().createJob();
 #ifndef NDEBUG
     slog.i << "Texture Decoder has "
@@ -276,7 +297,11 @@ StbProvider::~StbProvider() {
 }
 
 TextureProvider* createStbProvider(Engine* engine) {
-    return new StbProvider(engine);
+    return new StbProvider(engine, nullptr);
+}
+
+TextureProvider* createStbProvider(Engine* engine, ImageDecoderBackend* backend) {
+    return new StbProvider(engine, backend);
 }
 
 } // namespace filament::gltfio
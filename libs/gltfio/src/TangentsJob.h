@@ -18,6 +18,10 @@
 
 #include <math/vec4.h>
 
+namespace utils {
+class JobSystem;
+}
+
 namespace filament {
 
 class VertexBuffer;
@@ -40,6 +44,8 @@ struct TangentsJob {
     struct InputParams {
         const cgltf_primitive* prim;
         const int morphTargetIndex = kMorphTargetUnused;
+        // Optional; when supplied, tangent generation is parallelized within the primitive.
+        utils::JobSystem* const jobSystem = nullptr;
     };
 
     // The context of the procedure. These fields are not used by the procedure but are provided as
@@ -0,0 +1,342 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gltfio/TexturePager.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <utils/JobSystem.h>
+
+#include <filament/Engine.h>
+#include <filament/Texture.h>
+
+#include <tsl/robin_map.h>
+
+#include <stb_image.h>
+
+using namespace filament;
+using namespace utils;
+
+using std::atomic;
+using std::vector;
+
+namespace filament::gltfio {
+
+struct TexturePager::Impl {
+    enum class PageState {
+        DECODING,  // Content has been pushed, texels have not reached the atlas yet.
+        RESIDENT,  // Page occupies a slot in the physical atlas.
+        CANCELLED, // Page was evicted while decoding; drop the texels when they arrive.
+    };
+
+    struct Page {
+        PageState state;
+        uint32_t slot;
+        uint64_t lastUsed;
+        atomic<intptr_t> decodedTexels;
+        vector<uint8_t> sourceBuffer;
+        JobSystem::Job* decoderJob;
+    };
+
+    // Sentinel values for the "decodedTexels" field, same convention as StbProvider.
+    static const intptr_t DECODING_NOT_READY = 0x0;
+    static const intptr_t DECODING_ERROR = 0x1;
+
+    static uint64_t makeKey(uint32_t pageX, uint32_t pageY) noexcept {
+        return (uint64_t(pageY) << 32) | pageX;
+    }
+
+    uint32_t allocateSlot();
+    void decodeSinglePage();
+
+    Engine* engine;
+    Config config;
+    uint32_t pagesX;
+    uint32_t pagesY;
+    uint32_t slotsPerRow;
+    uint32_t slotCount;
+    Texture* atlas;
+    uint64_t frame = 0;
+    size_t residentCount = 0;
+    tsl::robin_map<uint64_t, std::unique_ptr<Page>> pages;
+    vector<uint32_t> freeSlots;
+    JobSystem::Job* decoderRootJob;
+    std::string recentPushMessage;
+};
+
+TexturePager::TexturePager(Engine* engine, uint32_t virtualWidth, uint32_t virtualHeight,
+        Config const& config) : mImpl(new Impl) {
+    Impl& impl = *mImpl;
+    impl.engine = engine;
+    impl.config = config;
+    impl.pagesX = (virtualWidth + config.pageSize - 1) / config.pageSize;
+    impl.pagesY = (virtualHeight + config.pageSize - 1) / config.pageSize;
+
+    // Size the physical atlas to the residency budget: a roughly square grid of page slots,
+    // clamped to the largest dimension the device supports.
+    const size_t bytesPerPage = size_t(config.pageSize) * config.pageSize * 4;
+    const size_t budgetSlots = std::max(size_t(1), config.residencyBudgetBytes / bytesPerPage);
+    const uint32_t maxSlotsPerRow = std::max(1u, config.maxAtlasSize / config.pageSize);
+    const uint32_t side = uint32_t(std::sqrt(double(budgetSlots)));
+    impl.slotsPerRow = std::min(std::max(1u, side), maxSlotsPerRow);
+    const uint32_t rows = std::min<uint32_t>(
+            std::max<size_t>(1, budgetSlots / impl.slotsPerRow), maxSlotsPerRow);
+    impl.slotCount = impl.slotsPerRow * rows;
+
+    impl.freeSlots.reserve(impl.slotCount);
+    for (uint32_t slot = impl.slotCount; slot > 0; --slot) {
+        impl.freeSlots.push_back(slot - 1);
+    }
+
+    using InternalFormat = Texture::InternalFormat;
+    impl.atlas = Texture::Builder()
+            .width(impl.slotsPerRow * config.pageSize)
+            .height(rows * config.pageSize)
+            .levels(1)
+            .format(config.srgb ? InternalFormat::SRGB8_A8 : InternalFormat::RGBA8)
+            .build(*engine);
+
+    impl.decoderRootJob = engine->getJobSystem().createJob();
+}
+
+TexturePager::~TexturePager() {
+    Impl& impl = *mImpl;
+    JobSystem& js = impl.engine->getJobSystem();
+    for (auto& pair : impl.pages) {
+        Impl::Page* page = pair.second.get();
+        if (page->decoderJob) {
+            js.waitAndRelease(page->decoderJob);
+        }
+        const intptr_t data = page->decodedTexels.load();
+        if (page->state != Impl::PageState::RESIDENT &&
+                data != Impl::DECODING_NOT_READY && data != Impl::DECODING_ERROR) {
+            stbi_image_free((void*) data);
+        }
+    }
+    js.runAndWait(impl.decoderRootJob);
+    impl.engine->destroy(impl.atlas);
+    delete mImpl;
+}
+
+Texture* TexturePager::getPhysicalTexture() const noexcept {
+    return mImpl->atlas;
+}
+
+bool TexturePager::requestPage(uint32_t pageX, uint32_t pageY, const uint8_t* data,
+        size_t byteCount) {
+    Impl& impl = *mImpl;
+    if (pageX >= impl.pagesX || pageY >= impl.pagesY) {
+        impl.recentPushMessage = "Page coordinates exceed the virtual texture.";
+        return false;
+    }
+
+    const uint64_t key = Impl::makeKey(pageX, pageY);
+    if (auto iter = impl.pages.find(key); iter != impl.pages.end()) {
+        Impl::Page* page = iter->second.get();
+        if (page->state == Impl::PageState::CANCELLED) {
+            // The page was evicted while its previous content was still decoding; treat the
+            // request as a refresh and let it become resident after all.
+            page->state = Impl::PageState::DECODING;
+        }
+        page->lastUsed = impl.frame;
+        impl.recentPushMessage.clear();
+        return true;
+    }
+
+    int width, height, numComponents;
+    if (!stbi_info_from_memory(data, byteCount, &width, &height, &numComponents)) {
+        impl.recentPushMessage = std::string("Unable to parse page: ") + stbi_failure_reason();
+        return false;
+    }
+    if (uint32_t(width) != impl.config.pageSize || uint32_t(height) != impl.config.pageSize) {
+        impl.recentPushMessage = "Page content does not match the configured page size.";
+        return false;
+    }
+
+    impl.recentPushMessage.clear();
+    Impl::Page* page = (impl.pages[key] = std::make_unique<Impl::Page>()).get();
+    page->state = Impl::PageState::DECODING;
+    page->slot = 0;
+    page->lastUsed = impl.frame;
+    page->sourceBuffer.assign(data, data + byteCount);
+    page->decodedTexels.store(Impl::DECODING_NOT_READY);
+
+    // As in StbProvider, single threaded systems decode from updateQueue() instead, so the
+    // decoder cost is amortized across frames.
+    if constexpr (!UTILS_HAS_THREADING) {
+        page->decoderJob = nullptr;
+        return true;
+    }
+
+    JobSystem* js = &impl.engine->getJobSystem();
+    page->decoderJob = jobs::createJob(*js, impl.decoderRootJob, [page] {
+        auto& source = page->sourceBuffer;
+        int width, height, comp;
+        stbi_uc* texels = stbi_load_from_memory(source.data(), source.size(),
+                &width, &height, &comp, 4);
+        source.clear();
+        source.shrink_to_fit();
+        page->decodedTexels.store(texels ? intptr_t(texels) : Impl::DECODING_ERROR);
+    });
+    js->runAndRetain(page->decoderJob);
+    return true;
+}
+
+const char* TexturePager::getPushMessage() const noexcept {
+    return mImpl->recentPushMessage.empty() ? nullptr : mImpl->recentPushMessage.c_str();
+}
+
+bool TexturePager::getPageUv(uint32_t pageX, uint32_t pageY, math::float4* uvRegion) noexcept {
+    Impl& impl = *mImpl;
+    auto iter = impl.pages.find(Impl::makeKey(pageX, pageY));
+    if (iter == impl.pages.end() || iter->second->state != Impl::PageState::RESIDENT) {
+        return false;
+    }
+    Impl::Page* page = iter->second.get();
+    page->lastUsed = impl.frame;
+    if (uvRegion) {
+        const float atlasWidth = float(impl.atlas->getWidth());
+        const float atlasHeight = float(impl.atlas->getHeight());
+        const uint32_t slotX = (page->slot % impl.slotsPerRow) * impl.config.pageSize;
+        const uint32_t slotY = (page->slot / impl.slotsPerRow) * impl.config.pageSize;
+        *uvRegion = math::float4{
+                slotX / atlasWidth, slotY / atlasHeight,
+                (slotX + impl.config.pageSize) / atlasWidth,
+                (slotY + impl.config.pageSize) / atlasHeight };
+    }
+    return true;
+}
+
+uint32_t TexturePager::Impl::allocateSlot() {
+    if (!freeSlots.empty()) {
+        const uint32_t slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+
+    // The atlas is full; evict the least recently used resident page.
+    auto victim = pages.end();
+    for (auto iter = pages.begin(); iter != pages.end(); ++iter) {
+        if (iter->second->state != PageState::RESIDENT) {
+            continue;
+        }
+        if (victim == pages.end() || iter->second->lastUsed < victim->second->lastUsed) {
+            victim = iter;
+        }
+    }
+    const uint32_t slot = victim->second->slot;
+    pages.erase(victim);
+    --residentCount;
+    return slot;
+}
+
+void TexturePager::Impl::decodeSinglePage() {
+    for (auto& pair : pages) {
+        Impl::Page* page = pair.second.get();
+        if (page->state != PageState::RESIDENT &&
+                page->decodedTexels.load() == DECODING_NOT_READY) {
+            auto& source = page->sourceBuffer;
+            int width, height, comp;
+            stbi_uc* texels = stbi_load_from_memory(source.data(), source.size(),
+                    &width, &height, &comp, 4);
+            source.clear();
+            source.shrink_to_fit();
+            page->decodedTexels.store(texels ? intptr_t(texels) : DECODING_ERROR);
+            return;
+        }
+    }
+}
+
+void TexturePager::updateQueue() {
+    Impl& impl = *mImpl;
+    if (!UTILS_HAS_THREADING) {
+        impl.decodeSinglePage();
+    }
+    JobSystem* js = &impl.engine->getJobSystem();
+
+    // Since eviction and cleanup both erase map entries, and robin_map erasure invalidates
+    // iterators, first collect the pages whose texels have emerged from the decoder.
+    vector<uint64_t> ready;
+    for (auto& pair : impl.pages) {
+        Impl::Page* page = pair.second.get();
+        if (page->state != Impl::PageState::RESIDENT &&
+                page->decodedTexels.load() != Impl::DECODING_NOT_READY) {
+            ready.push_back(pair.first);
+        }
+    }
+
+    for (const uint64_t key : ready) {
+        Impl::Page* page = impl.pages.at(key).get();
+        const intptr_t data = page->decodedTexels.load();
+        if (page->decoderJob) {
+            js->waitAndRelease(page->decoderJob);
+            page->decoderJob = nullptr;
+        }
+        if (data == Impl::DECODING_ERROR || page->state == Impl::PageState::CANCELLED) {
+            if (data != Impl::DECODING_ERROR) {
+                stbi_image_free((void*) data);
+            }
+            impl.pages.erase(key);
+            continue;
+        }
+
+        const uint32_t slot = impl.allocateSlot();
+        const uint32_t pageSize = impl.config.pageSize;
+        Texture::PixelBufferDescriptor pbd((uint8_t*) data,
+                size_t(pageSize) * pageSize * 4, Texture::Format::RGBA, Texture::Type::UBYTE,
+                [](void* mem, size_t, void*) { stbi_image_free(mem); });
+        impl.atlas->setImage(*impl.engine, 0,
+                (slot % impl.slotsPerRow) * pageSize, (slot / impl.slotsPerRow) * pageSize, 0,
+                pageSize, pageSize, 1, std::move(pbd));
+
+        page->state = Impl::PageState::RESIDENT;
+        page->slot = slot;
+        page->lastUsed = impl.frame;
+        ++impl.residentCount;
+    }
+    ++impl.frame;
+}
+
+void TexturePager::evictPage(uint32_t pageX, uint32_t pageY) noexcept {
+    Impl& impl = *mImpl;
+    auto iter = impl.pages.find(Impl::makeKey(pageX, pageY));
+    if (iter == impl.pages.end()) {
+        return;
+    }
+    Impl::Page* page = iter->second.get();
+    if (page->state == Impl::PageState::RESIDENT) {
+        impl.freeSlots.push_back(page->slot);
+        --impl.residentCount;
+        impl.pages.erase(iter);
+    } else {
+        // The decoder job may still be running; drop the texels when they arrive.
+        page->state = Impl::PageState::CANCELLED;
+    }
+}
+
+size_t TexturePager::getResidentCount() const noexcept {
+    return mImpl->residentCount;
+}
+
+size_t TexturePager::getSlotCount() const noexcept {
+    return mImpl->slotCount;
+}
+
+} // namespace filament::gltfio
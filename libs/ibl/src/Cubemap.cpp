@@ -205,13 +205,17 @@ Cubemap::Texel Cubemap::trilinearFilterAt(const Cubemap& l0, const Cubemap& l1,
 {
     Cubemap::Address addr(getAddressFor(L));
     const Image& i0 = l0.getImageForFace(addr.face);
-    const Image& i1 = l1.getImageForFace(addr.face);
     float x0 = std::min(addr.s * l0.mDimensions, l0.mUpperBound);
     float y0 = std::min(addr.t * l0.mDimensions, l0.mUpperBound);
-    float x1 = std::min(addr.s * l1.mDimensions, l1.mUpperBound);
-    float y1 = std::min(addr.t * l1.mDimensions, l1.mUpperBound);
     float3 c0 = filterAt(i0, x0, y0);
-    c0 += lerp * (filterAt(i1, x1, y1) - c0);
+    // The second fetch contributes nothing when the mip lerp is zero, which is the case for
+    // every sample when prefiltering is disabled. Skipping it halves the filtering cost.
+    if (lerp != 0) {
+        const Image& i1 = l1.getImageForFace(addr.face);
+        float x1 = std::min(addr.s * l1.mDimensions, l1.mUpperBound);
+        float y1 = std::min(addr.t * l1.mDimensions, l1.mUpperBound);
+        c0 += lerp * (filterAt(i1, x1, y1) - c0);
+    }
     return c0;
 }
 
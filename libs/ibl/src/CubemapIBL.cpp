@@ -400,7 +400,8 @@ void CubemapIBL::roughnessFilter(
 
             uint8_t l0 = uint8_t(mipLevel);
             uint8_t l1 = uint8_t(std::min(maxLevel, size_t(l0 + 1)));
-            float lerp = mipLevel - (float) l0;
+            // force the bilinear fast path when both levels resolve to the same cubemap
+            float lerp = l0 == l1 ? 0.0f : mipLevel - (float) l0;
 
             cache.push_back({ L, brdf_NoL, lerp, l0, l1 });
         }
@@ -592,7 +593,8 @@ void CubemapIBL::diffuseIrradiance(JobSystem& js, Cubemap& dst, const std::vecto
 
             uint8_t l0 = uint8_t(mipLevel);
             uint8_t l1 = uint8_t(std::min(maxLevel, size_t(l0 + 1)));
-            float lerp = mipLevel - (float) l0;
+            // force the bilinear fast path when both levels resolve to the same cubemap
+            float lerp = l0 == l1 ? 0.0f : mipLevel - (float) l0;
 
             cache.push_back({ L, lerp, l0, l1 });
         }
@@ -22,6 +22,8 @@
 
 #include <filament/Texture.h>
 
+#include <math/vec3.h>
+
 namespace filament {
 class Engine;
 class View;
@@ -321,6 +323,67 @@ public:
         uint8_t mLevelCount = 1u;
     };
 
+    /**
+     * ShProjection is a GPU based implementation of the 3-band spherical harmonics projection
+     * performed on the CPU by ibl::CubemapSH::computeSH. The projection runs entirely on the GPU
+     * and the nine coefficients are read back asynchronously, so dynamically captured
+     * environments (e.g. time-of-day lighting) can update their irradiance without blocking the
+     * main thread.
+     */
+    class ShProjection {
+    public:
+        /**
+         * Number of coefficients produced (3 bands).
+         */
+        static constexpr size_t SH_COEFFICIENTS_COUNT = 9;
+
+        /**
+         * Callback invoked when the coefficients are available. `sh` points to
+         * SH_COEFFICIENTS_COUNT coefficients pre-convolved with the truncated cos() lobe, i.e.
+         * equivalent to CubemapSH::computeSH() with 3 bands and irradiance enabled, and suitable
+         * for IndirectLight::Builder::irradiance(). The pointer is only valid during the
+         * callback. The callback is invoked from the filament main thread.
+         */
+        using Callback = void(*)(filament::math::float3 const* sh, size_t count, void* user);
+
+        /**
+         * Creates a ShProjection processor.
+         * @param context IBLPrefilterContext to use
+         */
+        explicit ShProjection(IBLPrefilterContext& context);
+
+        /**
+         * Destroys all GPU resources created during initialization.
+         */
+        ~ShProjection() noexcept;
+
+        ShProjection(ShProjection const&) = delete;
+        ShProjection& operator=(ShProjection const&) = delete;
+        ShProjection(ShProjection&& rhs) noexcept;
+        ShProjection& operator=(ShProjection&& rhs) noexcept;
+
+        /**
+         * Projects an environment cubemap onto 3-band spherical harmonics.
+         *
+         * The GPU work is enqueued immediately; the coefficients are delivered later through the
+         * callback, once the readback completes. At most one projection may be in flight per
+         * ShProjection instance.
+         *
+         * @param environmentCubemap Environment cubemap (input). Can't be null, must be a
+         *                           SAMPLEABLE cubemap with a power-of-two dimension of at
+         *                           least 16.
+         * @param callback           Invoked with the coefficients when they are available.
+         * @param user               User pointer passed to the callback.
+         */
+        void operator()(filament::Texture const* environmentCubemap,
+                Callback callback, void* user = nullptr);
+
+    private:
+        IBLPrefilterContext& mContext;
+        filament::Material* mProjectionMaterial = nullptr;
+        filament::Texture* mCoefficientsTexture = nullptr;
+    };
+
 private:
     friend class Filter;
     filament::Engine& mEngine;
@@ -680,3 +680,122 @@ Texture* IBLPrefilterContext::SpecularFilter::operator()(
 
     return outReflectionsTexture;
 }
+
+// ------------------------------------------------------------------------------------------------
+
+// number of horizontal integration bands; each fragment of the coefficients texture integrates
+// 1/16th of the environment, and the 16 partial sums are reduced on the CPU after readback.
+constexpr static uint32_t SH_BLOCK_COUNT = 16u;
+
+IBLPrefilterContext::ShProjection::ShProjection(IBLPrefilterContext& context)
+        : mContext(context) {
+    SYSTRACE_CALL();
+
+    Engine& engine = mContext.mEngine;
+
+    mProjectionMaterial = Material::Builder().package(
+            IBLPREFILTER_MATERIALS_SHPROJECTION_DATA,
+            IBLPREFILTER_MATERIALS_SHPROJECTION_SIZE).build(engine);
+
+    // one column per SH coefficient, one row per integration band
+    mCoefficientsTexture = Texture::Builder()
+            .sampler(Texture::Sampler::SAMPLER_2D)
+            .format(Texture::InternalFormat::RGBA32F)
+            .usage(Texture::Usage::COLOR_ATTACHMENT)
+            .width(SH_COEFFICIENTS_COUNT)
+            .height(SH_BLOCK_COUNT)
+            .build(engine);
+}
+
+IBLPrefilterContext::ShProjection::~ShProjection() noexcept {
+    Engine& engine = mContext.mEngine;
+    engine.destroy(mCoefficientsTexture);
+    engine.destroy(mProjectionMaterial);
+}
+
+IBLPrefilterContext::ShProjection::ShProjection(ShProjection&& rhs) noexcept
+        : mContext(rhs.mContext) {
+    this->operator=(std::move(rhs));
+}
+
+IBLPrefilterContext::ShProjection&
+IBLPrefilterContext::ShProjection::operator=(ShProjection&& rhs) noexcept {
+    using std::swap;
+    if (this != &rhs) {
+        swap(mProjectionMaterial, rhs.mProjectionMaterial);
+        swap(mCoefficientsTexture, rhs.mCoefficientsTexture);
+    }
+    return *this;
+}
+
+void IBLPrefilterContext::ShProjection::operator()(
+        Texture const* environmentCubemap, Callback callback, void* user) {
+
+    SYSTRACE_CALL();
+    using namespace backend;
+
+    ASSERT_PRECONDITION(environmentCubemap != nullptr, "environmentCubemap is null!");
+
+    ASSERT_PRECONDITION(environmentCubemap->getTarget() == Texture::Sampler::SAMPLER_CUBEMAP,
+            "environmentCubemap must be a cubemap.");
+
+    const uint32_t dim = environmentCubemap->getWidth();
+
+    ASSERT_PRECONDITION(dim >= SH_BLOCK_COUNT && !(dim & (dim - 1u)),
+            "environmentCubemap dimension must be a power-of-two of at least %u.",
+            +SH_BLOCK_COUNT);
+
+    ASSERT_PRECONDITION(callback != nullptr, "callback is null!");
+
+    Engine& engine = mContext.mEngine;
+    View* const view = mContext.mView;
+    Renderer* const renderer = mContext.mRenderer;
+    MaterialInstance* const mi = mProjectionMaterial->getDefaultInstance();
+
+    RenderableManager& rcm = engine.getRenderableManager();
+    rcm.setMaterialInstanceAt(
+            rcm.getInstance(mContext.mFullScreenQuadEntity), 0, mi);
+
+    mi->setParameter("environment", environmentCubemap,
+            TextureSampler{ SamplerMagFilter::NEAREST });
+    mi->setParameter("size", uint2{ SH_COEFFICIENTS_COUNT, SH_BLOCK_COUNT });
+    mi->setParameter("dim", dim);
+
+    RenderTarget* const rt = RenderTarget::Builder()
+            .texture(RenderTarget::AttachmentPoint::COLOR0, mCoefficientsTexture)
+            .build(engine);
+
+    view->setRenderTarget(rt);
+    view->setViewport({ 0, 0, SH_COEFFICIENTS_COUNT, SH_BLOCK_COUNT });
+
+    renderer->renderStandaloneView(view);
+
+    // Read the partial sums back asynchronously; the per-band reduction is small enough
+    // (16 partial sums per coefficient) to finish inside the readback callback.
+    struct Readback {
+        Callback callback;
+        void* user;
+        float data[SH_COEFFICIENTS_COUNT * SH_BLOCK_COUNT * 4];
+    };
+    Readback* const readback = new Readback{ callback, user, {} };
+
+    PixelBufferDescriptor buffer(readback->data, sizeof(readback->data),
+            PixelBufferDescriptor::PixelDataFormat::RGBA,
+            PixelBufferDescriptor::PixelDataType::FLOAT,
+            [](void*, size_t, void* user) {
+                Readback* const readback = static_cast<Readback*>(user);
+                float3 sh[SH_COEFFICIENTS_COUNT] = {};
+                for (size_t block = 0; block < SH_BLOCK_COUNT; block++) {
+                    float const* row = readback->data + block * SH_COEFFICIENTS_COUNT * 4;
+                    for (size_t i = 0; i < SH_COEFFICIENTS_COUNT; i++) {
+                        sh[i] += *reinterpret_cast<float3 const*>(row + i * 4);
+                    }
+                }
+                readback->callback(sh, SH_COEFFICIENTS_COUNT, readback->user);
+                delete readback;
+            }, readback);
+
+    renderer->readPixels(rt, 0, 0, SH_COEFFICIENTS_COUNT, SH_BLOCK_COUNT, std::move(buffer));
+
+    engine.destroy(rt);
+}
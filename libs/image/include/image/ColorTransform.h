@@ -264,22 +264,32 @@ std::unique_ptr<uint8_t[]> fromLinearToGrayscale(const LinearImage& image) {
     return dst;
 }
 
-// Constructs a 3-channel LinearImage from an untyped data blob.
-// The "proc" lambda converts a single color component into a float.
-// The "transform" lambda performs an arbitrary float-to-float transformation.
+// Converts a range of rows of an untyped data blob into an existing 3-channel LinearImage.
+// Rows outside the range are left untouched, which allows the conversion to be spread
+// across several threads.
 template<typename T, typename PROCESS, typename TRANSFORM>
-static LinearImage toLinear(size_t w, size_t h, size_t bpr,
-            const uint8_t* src, PROCESS proc, TRANSFORM transform) {
-    LinearImage result((uint32_t) w, (uint32_t) h, 3);
-    auto d = result.get< filament::math::float3>();
-    for (size_t y = 0; y < h; ++y) {
+static void toLinearRows(LinearImage& result, uint32_t firstRow, uint32_t rowCount,
+        size_t bpr, const uint8_t* src, PROCESS proc, TRANSFORM transform) {
+    const size_t w = result.getWidth();
+    for (size_t y = firstRow; y < firstRow + rowCount; ++y) {
         T const* p = reinterpret_cast<T const*>(src + y * bpr);
+        auto d = reinterpret_cast< filament::math::float3*>(result.getPixelRef(0, (uint32_t) y));
         for (size_t x = 0; x < w; ++x, p += 3) {
              filament::math::float3 sRGB(proc(p[0]), proc(p[1]), proc(p[2]));
             sRGB /= std::numeric_limits<T>::max();
             *d++ = transform(sRGB);
         }
     }
+}
+
+// Constructs a 3-channel LinearImage from an untyped data blob.
+// The "proc" lambda converts a single color component into a float.
+// The "transform" lambda performs an arbitrary float-to-float transformation.
+template<typename T, typename PROCESS, typename TRANSFORM>
+static LinearImage toLinear(size_t w, size_t h, size_t bpr,
+            const uint8_t* src, PROCESS proc, TRANSFORM transform) {
+    LinearImage result((uint32_t) w, (uint32_t) h, 3);
+    toLinearRows<T>(result, 0, (uint32_t) h, bpr, src, proc, transform);
     return result;
 }
 
@@ -292,22 +302,32 @@ static LinearImage toLinear(size_t w, size_t h, size_t bpr,
     return toLinear<T>(w, h, bpr, src.get(), proc, transform);
 }
 
-// Constructs a 4-channel LinearImage from an untyped data blob.
-// The "proc" lambda converts a single color component into a float.
-// the "transform" lambda performs an arbitrary float-to-float transformation.
+// Converts a range of rows of an untyped data blob into an existing 4-channel LinearImage.
+// Rows outside the range are left untouched, which allows the conversion to be spread
+// across several threads.
 template<typename T, typename PROCESS, typename TRANSFORM>
-static LinearImage toLinearWithAlpha(size_t w, size_t h, size_t bpr,
-        const uint8_t* src, PROCESS proc, TRANSFORM transform) {
-    LinearImage result((uint32_t) w, (uint32_t) h, 4);
-    auto d = result.get< filament::math::float4>();
-    for (size_t y = 0; y < h; ++y) {
+static void toLinearWithAlphaRows(LinearImage& result, uint32_t firstRow, uint32_t rowCount,
+        size_t bpr, const uint8_t* src, PROCESS proc, TRANSFORM transform) {
+    const size_t w = result.getWidth();
+    for (size_t y = firstRow; y < firstRow + rowCount; ++y) {
         T const* p = reinterpret_cast<T const*>(src + y * bpr);
+        auto d = reinterpret_cast< filament::math::float4*>(result.getPixelRef(0, (uint32_t) y));
         for (size_t x = 0; x < w; ++x, p += 4) {
              filament::math::float4 sRGB(proc(p[0]), proc(p[1]), proc(p[2]), proc(p[3]));
             sRGB /= std::numeric_limits<T>::max();
             *d++ = transform(sRGB);
         }
     }
+}
+
+// Constructs a 4-channel LinearImage from an untyped data blob.
+// The "proc" lambda converts a single color component into a float.
+// the "transform" lambda performs an arbitrary float-to-float transformation.
+template<typename T, typename PROCESS, typename TRANSFORM>
+static LinearImage toLinearWithAlpha(size_t w, size_t h, size_t bpr,
+        const uint8_t* src, PROCESS proc, TRANSFORM transform) {
+    LinearImage result((uint32_t) w, (uint32_t) h, 4);
+    toLinearWithAlphaRows<T>(result, 0, (uint32_t) h, bpr, src, proc, transform);
     return result;
 }
 
@@ -24,8 +24,18 @@
 #include <cstddef>
 #include <initializer_list>
 
+namespace utils {
+class JobSystem;
+}
+
 namespace image {
 
+// Sets the JobSystem used to parallelize image operations over horizontal bands of rows.
+// Operations run single-threaded until a JobSystem is supplied (the default). The JobSystem is
+// not owned and must outlive all subsequent image operations; pass nullptr to return to
+// single-threaded execution.
+UTILS_PUBLIC void setJobSystem(utils::JobSystem* js);
+
 // Concatenates images horizontally to create a filmstrip atlas, similar to numpy's hstack.
 UTILS_PUBLIC LinearImage horizontalStack(std::initializer_list<LinearImage> images);
 UTILS_PUBLIC LinearImage horizontalStack(LinearImage const* img, size_t count);
@@ -34,6 +44,12 @@ UTILS_PUBLIC LinearImage horizontalStack(LinearImage const* img, size_t count);
 UTILS_PUBLIC LinearImage verticalStack(std::initializer_list<LinearImage> images);
 UTILS_PUBLIC LinearImage verticalStack(LinearImage const* img, size_t count);
 
+// Converts between the two pixel storage modes, e.g. to store intermediate results of a
+// processing chain compactly. Returns the given image (sharing its pixels) when it already
+// uses the requested storage. Conversion to HALF rounds to nearest.
+UTILS_PUBLIC LinearImage convertToHalf(const LinearImage& image);
+UTILS_PUBLIC LinearImage convertToFloat(const LinearImage& image);
+
 // Horizontally or vertically mirror the given image.
 UTILS_PUBLIC LinearImage horizontalFlip(const LinearImage& image);
 UTILS_PUBLIC LinearImage verticalFlip(const LinearImage& image);
@@ -19,6 +19,8 @@
 
 #include <utils/compiler.h>
 
+#include <math/half.h>
+
 #include <cstdint>
 
 /**
@@ -44,6 +46,19 @@ namespace image {
 class UTILS_PUBLIC LinearImage {
 public:
 
+    /**
+     * Underlying representation of the pixel data.
+     *
+     * Processing always happens with 32-bit floats; HALF merely halves the at-rest footprint
+     * and memory bandwidth, which matters for very large images and long processing chains.
+     * Half images must be accessed with getHalfRef() rather than getPixelRef(); see
+     * ImageOps convertToHalf / convertToFloat for converting between the two modes.
+     */
+    enum class PixelStorage : uint8_t {
+        FLOAT,  //!< one 32-bit float per channel (the default)
+        HALF,   //!< one 16-bit half float per channel
+    };
+
     ~LinearImage();
 
     /**
@@ -51,6 +66,11 @@ public:
      */
     LinearImage(uint32_t width, uint32_t height, uint32_t channels);
 
+    /**
+     * Allocates a zeroed-out image with the given pixel storage.
+     */
+    LinearImage(uint32_t width, uint32_t height, uint32_t channels, PixelStorage storage);
+
     /**
      * Makes a shallow copy with shared pixel data.
      */
@@ -99,6 +119,28 @@ public:
         return reinterpret_cast<T const*>(getPixelRef(column, row));
     }
 
+    /**
+     * Gets a pointer to the underlying pixel data of a HALF image. The float accessors above
+     * must not be used on half images, and vice versa. (not checked)
+     * @{
+     */
+    filament::math::half* getHalfRef() { return reinterpret_cast<filament::math::half*>(mData); }
+    filament::math::half const* getHalfRef() const {
+        return reinterpret_cast<filament::math::half const*>(mData);
+    }
+
+    filament::math::half* getHalfRef(uint32_t column, uint32_t row) {
+        return getHalfRef() + (column + row * mWidth) * mChannels;
+    }
+    filament::math::half const* getHalfRef(uint32_t column, uint32_t row) const {
+        return getHalfRef() + (column + row * mWidth) * mChannels;
+    }
+    /**
+     * @}
+     */
+
+    PixelStorage getStorage() const { return mStorage; }
+
     uint32_t getWidth() const { return mWidth; }
     uint32_t getHeight() const { return mHeight; }
     uint32_t getChannels() const { return mChannels; }
@@ -114,6 +156,7 @@ private:
     uint32_t mWidth;
     uint32_t mHeight;
     uint32_t mChannels;
+    PixelStorage mStorage = PixelStorage::FLOAT;
 };
 
 } // namespace image
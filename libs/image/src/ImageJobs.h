@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_IMAGEJOBS_H
+#define IMAGE_IMAGEJOBS_H
+
+#include <utils/JobSystem.h>
+
+#include <cstdint>
+#include <utility>
+
+namespace image {
+
+// Returns the JobSystem supplied via image::setJobSystem, or null for single-threaded execution.
+utils::JobSystem* getJobSystem() noexcept;
+
+// Runs func(startRow, rowCount) over [0, height), split into horizontal bands of rows when a
+// JobSystem has been supplied. Since images use row-major storage, bands of rows are the natural
+// tiles. Callers must ensure that distinct bands never write to the same memory. forEachRowBand
+// does not return until all bands have been processed, and may itself be called from inside a
+// job.
+template<typename Func>
+void forEachRowBand(uint32_t height, Func func) {
+    utils::JobSystem* js = getJobSystem();
+    constexpr uint32_t MIN_PARALLEL_ROWS = 64;
+    if (js == nullptr || height < MIN_PARALLEL_ROWS) {
+        func(uint32_t(0), height);
+        return;
+    }
+    auto* job = utils::jobs::parallel_for(*js, nullptr, uint32_t(0), height,
+            std::move(func), utils::jobs::CountSplitter<16>());
+    js->runAndWait(job);
+}
+
+} // namespace image
+
+#endif // IMAGE_IMAGEJOBS_H
@@ -16,6 +16,9 @@
 
 #include <image/ImageOps.h>
 
+#include "ImageJobs.h"
+
+#include <math/half.h>
 #include <math/vec3.h>
 #include <math/vec4.h>
 #include <utils/Panic.h>
@@ -28,6 +31,16 @@ using namespace filament::math;
 
 namespace image {
 
+static utils::JobSystem* sJobSystem = nullptr;
+
+void setJobSystem(utils::JobSystem* js) {
+    sJobSystem = js;
+}
+
+utils::JobSystem* getJobSystem() noexcept {
+    return sJobSystem;
+}
+
 LinearImage horizontalStack(std::initializer_list<LinearImage> images) {
     size_t count = images.end() - images.begin();
     return horizontalStack(images.begin(), count);
@@ -89,6 +102,38 @@ LinearImage verticalStack(const LinearImage* first, size_t count) {
     return transpose(result);
 }
 
+LinearImage convertToHalf(const LinearImage& image) {
+    if (image.getStorage() == LinearImage::PixelStorage::HALF) {
+        return image;
+    }
+    const uint32_t width = image.getWidth();
+    const uint32_t height = image.getHeight();
+    const uint32_t channels = image.getChannels();
+    LinearImage result(width, height, channels, LinearImage::PixelStorage::HALF);
+    half* dst = result.getHalfRef();
+    float const* src = image.getPixelRef();
+    for (uint32_t n = 0, count = width * height * channels; n < count; ++n) {
+        dst[n] = half(src[n]);
+    }
+    return result;
+}
+
+LinearImage convertToFloat(const LinearImage& image) {
+    if (image.getStorage() == LinearImage::PixelStorage::FLOAT) {
+        return image;
+    }
+    const uint32_t width = image.getWidth();
+    const uint32_t height = image.getHeight();
+    const uint32_t channels = image.getChannels();
+    LinearImage result(width, height, channels);
+    float* dst = result.getPixelRef();
+    half const* src = image.getHalfRef();
+    for (uint32_t n = 0, count = width * height * channels; n < count; ++n) {
+        dst[n] = float(src[n]);
+    }
+    return result;
+}
+
 LinearImage horizontalFlip(const LinearImage& image) {
     const uint32_t width = image.getWidth();
     const uint32_t height = image.getHeight();
@@ -200,17 +245,28 @@ LinearImage transpose(const LinearImage& image) {
     const uint32_t height = image.getHeight();
     const uint32_t channels = image.getChannels();
     LinearImage result(height, width, channels);
-    float const* source = image.getPixelRef();
-    float* target = result.getPixelRef();
-    for (uint32_t n = 0; n < width * height; ++n) {
-        const uint32_t i = n / width;
-        const uint32_t j = n % width;
-        float const* src = source + channels * n;
-        float* dst = target + channels * (height * j + i);
-        for (uint32_t c = 0; c < channels; ++c) {
-            dst[c] = src[c];
+    float const* const source = image.getPixelRef();
+    float* const target = result.getPixelRef();
+    // Each source row maps to a distinct target column, so bands of source rows never overlap.
+    struct {
+        float const* source;
+        float* target;
+        uint32_t width;
+        uint32_t height;
+        uint32_t channels;
+    } ctx = { source, target, width, height, channels };
+    forEachRowBand(height, [&ctx](uint32_t startRow, uint32_t rowCount) {
+        for (uint32_t n = startRow * ctx.width, end = (startRow + rowCount) * ctx.width;
+                n < end; ++n) {
+            const uint32_t i = n / ctx.width;
+            const uint32_t j = n % ctx.width;
+            float const* src = ctx.source + ctx.channels * n;
+            float* dst = ctx.target + ctx.channels * (ctx.height * j + i);
+            for (uint32_t c = 0; c < ctx.channels; ++c) {
+                dst[c] = src[c];
+            }
         }
-    }
+    });
     return result;
 }
 
@@ -318,15 +374,25 @@ static LinearImage computeHorizontalEdt(const LinearImage& src, LinearImage cx)
     LinearImage tmp1(width + 1, height + 1, 1);
     LinearImage dst(width, height, 1);
 
-    // TODO: use utils::job::parallel_for.
-    for (uint32_t row = 0; row < height; ++row) {
-        const float* f = src.getPixelRef(0, row);
-        float* d = dst.getPixelRef(0, row);
-        float* z = tmp0.getPixelRef(0, row);
-        float* v = tmp1.getPixelRef(0, row);
-        float* i = cx.getPixelRef(0, row);
-        edt(f, d, z, v, i, width);
-    }
+    // Each row is processed independently, so fan the rows out across the JobSystem.
+    struct {
+        const LinearImage* src;
+        LinearImage* dst;
+        LinearImage* tmp0;
+        LinearImage* tmp1;
+        LinearImage* cx;
+        uint32_t width;
+    } ctx = { &src, &dst, &tmp0, &tmp1, &cx, width };
+    forEachRowBand(height, [&ctx](uint32_t startRow, uint32_t rowCount) {
+        for (uint32_t row = startRow, end = startRow + rowCount; row < end; ++row) {
+            const float* f = ctx.src->getPixelRef(0, row);
+            float* d = ctx.dst->getPixelRef(0, row);
+            float* z = ctx.tmp0->getPixelRef(0, row);
+            float* v = ctx.tmp1->getPixelRef(0, row);
+            float* i = ctx.cx->getPixelRef(0, row);
+            edt(f, d, z, v, i, ctx.width);
+        }
+    });
 
     return dst;
 }
@@ -17,6 +17,8 @@
 #include <image/ImageSampler.h>
 #include <image/ImageOps.h>
 
+#include "ImageJobs.h"
+
 #include <math/scalar.h>
 #include <math/vec3.h>
 #include <math/vec4.h>
@@ -207,25 +209,6 @@ FilterFunction createFilterFunction(Filter ftype) {
     return fn;
 }
 
-template <class VecT>
-void normalizeImpl(LinearImage& image) {
-    const uint32_t width = image.getWidth(), height = image.getHeight();
-    auto vecs = (VecT*) image.getPixelRef();
-    for (uint32_t n = 0; n < width * height; ++n) {
-        vecs[n] = normalize(vecs[n]);
-    }
-}
-
-void normalize(LinearImage& image) {
-    ASSERT_PRECONDITION(image.getChannels() == 3 || image.getChannels() == 4,
-                        "Must be a 3 or 4 channel image");
-    if (image.getChannels() == 3) {
-      normalizeImpl< filament::math::float3>(image);
-    } else {
-      normalizeImpl< filament::math::float4>(image);
-    }
-}
-
 LinearImage resampleImage1D(const LinearImage& source, MadProgram* program,
         uint32_t twidth, Filter filter, float left, float right, float filterRadiusMultiplier) {
     const uint32_t swidth = source.getWidth();
@@ -234,47 +217,76 @@ LinearImage resampleImage1D(const LinearImage& source, MadProgram* program,
     const bool mag = twidth > swidth;
     if (filter == Filter::DEFAULT) filter = mag ? Filter::MITCHELL : Filter::LANCZOS;
     const FilterFunction hfn = createFilterFunction(filter);
+    if (filter == Filter::GAUSSIAN_NORMALS) {
+        ASSERT_PRECONDITION(nchan == 3 || nchan == 4, "Must be a 3 or 4 channel image");
+    }
 
     // Generate a flat list of multiply-add (MAD) instructions.
     program->clear();
     generateMadProgram(twidth, swidth, left, right, hfn, filterRadiusMultiplier, program);
     expandMadProgram(nchan, program);
 
-    // Allocate the target image.
+    // Allocate the target image. Each target row depends only on its own source row, so the rows
+    // are fanned out across the JobSystem in bands; the MAD program itself is read-only.
     LinearImage result(twidth, sheight, nchan);
-    float const* sourceRow = source.getPixelRef();
-    float* targetRow = result.getPixelRef();
+    struct {
+        float const* sourcePixels;
+        float* targetPixels;
+        MadProgram const* program;
+        uint32_t swidth;
+        uint32_t twidth;
+        uint32_t nchan;
+        Filter filter;
+    } ctx = { source.getPixelRef(), result.getPixelRef(), program, swidth, twidth, nchan, filter };
 
     // The MIN filter is special because it starts with non-zero values and ignores filter weights.
     if (filter == Filter::MINIMUM) {
-        for (uint32_t n = 0; n < twidth * sheight * nchan; ++n) {
-            targetRow[n] = std::numeric_limits<float>::max();
-        }
-        for (uint32_t row = 0; row < sheight; ++row) {
-            for (auto mad : *program) {
-                const float a = sourceRow[mad.sourceIndex];
-                const float b = targetRow[mad.targetIndex];
-                targetRow[mad.targetIndex] = std::min(a, b);
+        forEachRowBand(sheight, [&ctx](uint32_t startRow, uint32_t rowCount) {
+            float const* sourceRow = ctx.sourcePixels + startRow * ctx.swidth * ctx.nchan;
+            float* targetRow = ctx.targetPixels + startRow * ctx.twidth * ctx.nchan;
+            for (uint32_t row = 0; row < rowCount; ++row) {
+                for (uint32_t n = 0; n < ctx.twidth * ctx.nchan; ++n) {
+                    targetRow[n] = std::numeric_limits<float>::max();
+                }
+                for (auto mad : *ctx.program) {
+                    const float a = sourceRow[mad.sourceIndex];
+                    const float b = targetRow[mad.targetIndex];
+                    targetRow[mad.targetIndex] = std::min(a, b);
+                }
+                targetRow += ctx.twidth * ctx.nchan;
+                sourceRow += ctx.swidth * ctx.nchan;
             }
-            targetRow += twidth * nchan;
-            sourceRow += swidth * nchan;
-        }
+        });
         return result;
     }
 
-    // Resize the image horizontally by executing the MAD instructions over each row.
-    for (uint32_t row = 0; row < sheight; ++row) {
-        for (auto mad : *program) {
-            targetRow[mad.targetIndex] += sourceRow[mad.sourceIndex] * mad.weight;
+    // Resize the image horizontally by executing the MAD instructions over each row. The
+    // GAUSSIAN_NORMALS post-pass is fused into the row loop so the pipeline makes a single pass
+    // over the target memory while each row is still warm in the cache.
+    forEachRowBand(sheight, [&ctx](uint32_t startRow, uint32_t rowCount) {
+        float const* sourceRow = ctx.sourcePixels + startRow * ctx.swidth * ctx.nchan;
+        float* targetRow = ctx.targetPixels + startRow * ctx.twidth * ctx.nchan;
+        for (uint32_t row = 0; row < rowCount; ++row) {
+            for (auto mad : *ctx.program) {
+                targetRow[mad.targetIndex] += sourceRow[mad.sourceIndex] * mad.weight;
+            }
+            if (ctx.filter == Filter::GAUSSIAN_NORMALS) {
+                if (ctx.nchan == 3) {
+                    auto vecs = (float3*) targetRow;
+                    for (uint32_t n = 0; n < ctx.twidth; ++n) {
+                        vecs[n] = normalize(vecs[n]);
+                    }
+                } else {
+                    auto vecs = (float4*) targetRow;
+                    for (uint32_t n = 0; n < ctx.twidth; ++n) {
+                        vecs[n] = normalize(vecs[n]);
+                    }
+                }
+            }
+            targetRow += ctx.twidth * ctx.nchan;
+            sourceRow += ctx.swidth * ctx.nchan;
         }
-        targetRow += twidth * nchan;
-        sourceRow += swidth * nchan;
-    }
-
-    // Perform post processing for the current pass.
-    if (filter == Filter::GAUSSIAN_NORMALS) {
-        normalize(result);
-    }
+    });
     return result;
 }
 
@@ -288,6 +300,10 @@ SingleSample::~SingleSample() {
 
 LinearImage resampleImage(const LinearImage& source, uint32_t width, uint32_t height,
         const ImageSampler& sampler) {
+    if (UTILS_UNLIKELY(source.getStorage() == LinearImage::PixelStorage::HALF)) {
+        // convert at load, compute in float, store half
+        return convertToHalf(resampleImage(convertToFloat(source), width, height, sampler));
+    }
     ASSERT_PRECONDITION(
         sampler.east.mode == Boundary::EXCLUDE &&
         sampler.north.mode == Boundary::EXCLUDE &&
@@ -317,6 +333,10 @@ LinearImage resampleImage(const LinearImage& source, uint32_t width, uint32_t he
 
 void computeSingleSample(const LinearImage& source, float x, float y, SingleSample* result,
         Filter filter) {
+    if (UTILS_UNLIKELY(source.getStorage() == LinearImage::PixelStorage::HALF)) {
+        computeSingleSample(convertToFloat(source), x, y, result, filter);
+        return;
+    }
     const float radius = 1.0f;
     const float left = x - radius / source.getWidth();
     const float top = y - radius / source.getHeight();
@@ -342,10 +362,17 @@ void generateMipmaps(const LinearImage& source, Filter filter, LinearImage* resu
     mips = std::min(mips, getMipmapCount(source));
     uint32_t width = source.getWidth();
     uint32_t height = source.getHeight();
+    // For half sources, convert once up front rather than per level, then store each level
+    // compactly again; only one full-size float copy is ever alive.
+    const bool half = source.getStorage() == LinearImage::PixelStorage::HALF;
+    const LinearImage floatSource = half ? convertToFloat(source) : source;
     for (uint32_t n = 0; n < mips; ++n) {
         width = std::max(width >> 1u, 1u);
         height = std::max(height >> 1u, 1u);
-        result[n] = resampleImage(source, width, height, filter);
+        result[n] = resampleImage(floatSource, width, height, filter);
+        if (half) {
+            result[n] = convertToHalf(result[n]);
+        }
     }
 }
 
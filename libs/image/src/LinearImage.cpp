@@ -22,8 +22,10 @@
 namespace image  {
 
 struct LinearImage::SharedReference {
-    SharedReference(uint32_t width, uint32_t height, uint32_t channels) {
-        const uint32_t nfloats = width * height * channels;
+    SharedReference(uint32_t width, uint32_t height, uint32_t channels, PixelStorage storage) {
+        const uint32_t nchannels = width * height * channels;
+        // half floats are packed two per float of backing store
+        const uint32_t nfloats = storage == PixelStorage::HALF ? (nchannels + 1) / 2 : nchannels;
         float* floats = new float[nfloats];
         memset(floats, 0, sizeof(float) * nfloats);
         pixels = std::shared_ptr<float>(floats, std::default_delete<float[]>());
@@ -36,9 +38,13 @@ LinearImage::~LinearImage() {
 }
 
 LinearImage::LinearImage(uint32_t width, uint32_t height, uint32_t channels) :
-    mDataRef(new SharedReference(width, height, channels)),
+    LinearImage(width, height, channels, PixelStorage::FLOAT) {}
+
+LinearImage::LinearImage(uint32_t width, uint32_t height, uint32_t channels,
+        PixelStorage storage) :
+    mDataRef(new SharedReference(width, height, channels, storage)),
     mData(mDataRef->pixels.get()),
-    mWidth(width), mHeight(height), mChannels(channels) {}
+    mWidth(width), mHeight(height), mChannels(channels), mStorage(storage) {}
 
 LinearImage::LinearImage(const LinearImage& that) {
     *this = that;
@@ -55,6 +61,7 @@ LinearImage& LinearImage::operator=(const LinearImage& that) {
     mWidth = that.mWidth;
     mHeight = that.mHeight;
     mChannels = that.mChannels;
+    mStorage = that.mStorage;
     return *this;
 }
 
@@ -362,6 +362,37 @@ TEST_F(ImageTest, Mipmaps) { // NOLINT
     }
 }
 
+TEST_F(ImageTest, HalfStorage) { // NOLINT
+    LinearImage src = createColorFromAscii("12345 67890 13579 24680");
+
+    // A float -> half -> float round trip must be exact for values that fit in a half.
+    LinearImage halved = convertToHalf(src);
+    ASSERT_EQ(halved.getStorage(), LinearImage::PixelStorage::HALF);
+    LinearImage restored = convertToFloat(halved);
+    ASSERT_EQ(restored.getStorage(), LinearImage::PixelStorage::FLOAT);
+    ASSERT_EQ(compare(src, restored, 0.0f), 0);
+
+    // Converting to the current storage shares the pixels rather than copying them.
+    ASSERT_EQ(convertToHalf(halved).getHalfRef(), halved.getHalfRef());
+    ASSERT_EQ(convertToFloat(src).getPixelRef(), src.getPixelRef());
+
+    // Resampling a half image yields a half image whose content matches the float path
+    // within half precision.
+    LinearImage expected = resampleImage(src, 10, 8, Filter::HERMITE);
+    LinearImage actual = resampleImage(halved, 10, 8, Filter::HERMITE);
+    ASSERT_EQ(actual.getStorage(), LinearImage::PixelStorage::HALF);
+    ASSERT_EQ(compare(expected, convertToFloat(actual), 0.001f), 0);
+
+    // Mipmaps of a half image are stored as halves as well.
+    vector<LinearImage> mips(getMipmapCount(halved));
+    generateMipmaps(halved, Filter::HERMITE, mips.data(), mips.size());
+    for (auto const& mip : mips) {
+        ASSERT_EQ(mip.getStorage(), LinearImage::PixelStorage::HALF);
+    }
+    ASSERT_EQ(mips.back().getWidth(), 1);
+    ASSERT_EQ(mips.back().getHeight(), 1);
+}
+
 TEST_F(ImageTest, Ktx) { // NOLINT
     uint8_t foo[] = {1, 2, 3};
     uint8_t* data;
@@ -17,6 +17,7 @@
 #ifndef IMAGE_IMAGEDECODER_H_
 #define IMAGE_IMAGEDECODER_H_
 
+#include <cstdint>
 #include <iosfwd>
 #include <string>
 
@@ -24,6 +25,10 @@
 
 #include <utils/compiler.h>
 
+namespace utils {
+class JobSystem;
+} // namespace utils
+
 namespace image {
 
 class UTILS_PUBLIC ImageDecoder {
@@ -33,10 +38,23 @@ public:
         SRGB
     };
 
+    // Invoked with ranges of fully decoded and linearized rows as they become available.
+    // When decoding runs on a JobSystem, the callback may be invoked from several worker
+    // threads concurrently, each with a disjoint range of rows.
+    using ScanlineCallback = void(*)(const LinearImage& image, uint32_t firstRow,
+            uint32_t rowCount, void* user);
+
     // Returns linear floating-point data, or a non-valid image if an error occured.
     static LinearImage decode(std::istream& stream, const std::string& sourceName,
             ColorSpace sourceSpace = ColorSpace::SRGB);
 
+    // Same as above, but spreads the linearization of the decoded scanlines across the
+    // given JobSystem. The optional callback is notified as scanline ranges complete,
+    // allowing downstream processing to overlap with the rest of the decode.
+    static LinearImage decode(utils::JobSystem& js, std::istream& stream,
+            const std::string& sourceName, ColorSpace sourceSpace = ColorSpace::SRGB,
+            ScanlineCallback callback = nullptr, void* user = nullptr);
+
     class Decoder {
     public:
         virtual LinearImage decode() = 0;
@@ -50,8 +68,29 @@ public:
             mColorSpace = colorSpace;
         }
 
+        void setAsync(utils::JobSystem* js, ScanlineCallback callback, void* user) noexcept {
+            mJobSystem = js;
+            mScanlineCallback = callback;
+            mScanlineCallbackUser = user;
+        }
+
+    protected:
+        utils::JobSystem* getJobSystem() const noexcept {
+            return mJobSystem;
+        }
+
+        void notifyScanlines(const LinearImage& image, uint32_t firstRow,
+                uint32_t rowCount) const {
+            if (mScanlineCallback) {
+                mScanlineCallback(image, firstRow, rowCount, mScanlineCallbackUser);
+            }
+        }
+
     private:
         ColorSpace mColorSpace = ColorSpace::SRGB;
+        utils::JobSystem* mJobSystem = nullptr;
+        ScanlineCallback mScanlineCallback = nullptr;
+        void* mScanlineCallbackUser = nullptr;
     };
 
 private:
@@ -62,6 +101,10 @@ private:
         PSD,
         EXR
     };
+
+    static LinearImage decodeImpl(utils::JobSystem* js, std::istream& stream,
+            const std::string& sourceName, ColorSpace sourceSpace,
+            ScanlineCallback callback, void* user);
 };
 
 } // namespace image
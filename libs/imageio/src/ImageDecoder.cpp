@@ -47,6 +47,8 @@
 
 #include <imageio/HDRDecoder.h>
 
+#include <utils/JobSystem.h>
+
 namespace image {
 
 class PNGDecoder : public ImageDecoder::Decoder {
@@ -127,6 +129,18 @@ private:
 
 LinearImage ImageDecoder::decode(std::istream& stream, const std::string& sourceName,
         ColorSpace sourceSpace) {
+    return decodeImpl(nullptr, stream, sourceName, sourceSpace, nullptr, nullptr);
+}
+
+LinearImage ImageDecoder::decode(utils::JobSystem& js, std::istream& stream,
+        const std::string& sourceName, ColorSpace sourceSpace,
+        ScanlineCallback callback, void* user) {
+    return decodeImpl(&js, stream, sourceName, sourceSpace, callback, user);
+}
+
+LinearImage ImageDecoder::decodeImpl(utils::JobSystem* js, std::istream& stream,
+        const std::string& sourceName, ColorSpace sourceSpace,
+        ScanlineCallback callback, void* user) {
 
     Format format = Format::NONE;
 
@@ -168,7 +182,16 @@ LinearImage ImageDecoder::decode(std::istream& stream, const std::string& source
             break;
     }
 
-    return decoder->decode();
+    // HDR and PSD decode in storage order rather than scanline order, so they cannot stream
+    // partial results; for those, the callback fires once with the whole image below.
+    const bool streams = format == Format::PNG || format == Format::EXR;
+    decoder->setAsync(js, streams ? callback : nullptr, user);
+
+    LinearImage image = decoder->decode();
+    if (callback && !streams && image.isValid()) {
+        callback(image, 0, image.getHeight(), user);
+    }
+    return image;
 }
 
 // -----------------------------------------------------------------------------------------------
@@ -186,6 +209,19 @@ static inline float read16(std::istream& istream) {
     return static_cast<float>(ntohs(data)) / std::numeric_limits<uint16_t>::max();
 }
 
+// Runs the given row-range functor over the JobSystem when one is available, otherwise invokes
+// it once with the whole image on the calling thread. The functor must only touch its own rows.
+template<typename F>
+static void forEachScanlineRange(utils::JobSystem* js, uint32_t height, F functor) {
+    if (js) {
+        auto* job = utils::jobs::parallel_for(*js, nullptr, 0, height,
+                std::move(functor), utils::jobs::CountSplitter<64, 8>());
+        js->runAndWait(job);
+    } else {
+        functor(0, height);
+    }
+}
+
 // -----------------------------------------------------------------------------------------------
 
 PNGDecoder* PNGDecoder::create(std::istream& stream) {
@@ -264,27 +300,42 @@ LinearImage PNGDecoder::decode() {
         png_read_image(mPNG, rowPointers.get());
         png_read_end(mPNG, mInfo);
 
+        // The rows themselves decode sequentially (the deflate stream is order dependent), but
+        // the conversion to linear float is spread across the JobSystem when one is available,
+        // streaming completed scanline ranges out to the client as we go.
         if (colorType == PNG_COLOR_TYPE_RGBA) {
-            if (getColorSpace() == ImageDecoder::ColorSpace::SRGB) {
-                return toLinearWithAlpha<uint16_t>(width, height, rowBytes, imageData,
-                        [](uint16_t v) -> uint16_t { return ntohs(v); },
-                        sRGBToLinear<filament::math::float4>);
-            } else {
-                return toLinearWithAlpha<uint16_t>(width, height, rowBytes, imageData,
-                        [](uint16_t v) -> uint16_t { return ntohs(v); },
-                        [](const filament::math::float4& color) ->  filament::math::float4 { return color; });
-            }
+            LinearImage image(width, height, 4);
+            forEachScanlineRange(getJobSystem(), height,
+                    [this, &image, src = imageData.get(), rowBytes](uint32_t row, uint32_t count) {
+                if (getColorSpace() == ImageDecoder::ColorSpace::SRGB) {
+                    toLinearWithAlphaRows<uint16_t>(image, row, count, rowBytes, src,
+                            [](uint16_t v) -> uint16_t { return ntohs(v); },
+                            sRGBToLinear<filament::math::float4>);
+                } else {
+                    toLinearWithAlphaRows<uint16_t>(image, row, count, rowBytes, src,
+                            [](uint16_t v) -> uint16_t { return ntohs(v); },
+                            [](const filament::math::float4& color) ->  filament::math::float4 { return color; });
+                }
+                notifyScanlines(image, row, count);
+            });
+            return image;
         } else {
             // Convert to linear float (PNG 16 stores data in network order (big endian).
-            if (getColorSpace() == ImageDecoder::ColorSpace::SRGB) {
-                return toLinear<uint16_t>(width, height, rowBytes, imageData,
-                        [](uint16_t v) -> uint16_t { return ntohs(v); },
-                        sRGBToLinear< filament::math::float3>);
-            } else {
-                return toLinear<uint16_t>(width, height, rowBytes, imageData,
-                        [](uint16_t v) -> uint16_t { return ntohs(v); },
-                        [](const filament::math::float3& color) ->  filament::math::float3 { return color; });
-            }
+            LinearImage image(width, height, 3);
+            forEachScanlineRange(getJobSystem(), height,
+                    [this, &image, src = imageData.get(), rowBytes](uint32_t row, uint32_t count) {
+                if (getColorSpace() == ImageDecoder::ColorSpace::SRGB) {
+                    toLinearRows<uint16_t>(image, row, count, rowBytes, src,
+                            [](uint16_t v) -> uint16_t { return ntohs(v); },
+                            sRGBToLinear< filament::math::float3>);
+                } else {
+                    toLinearRows<uint16_t>(image, row, count, rowBytes, src,
+                            [](uint16_t v) -> uint16_t { return ntohs(v); },
+                            [](const filament::math::float3& color) ->  filament::math::float3 { return color; });
+                }
+                notifyScanlines(image, row, count);
+            });
+            return image;
         }
     } catch(std::runtime_error& e) {
         // reset the stream, like we found it
@@ -449,13 +500,11 @@ EXRDecoder::~EXRDecoder() = default;
 
 LinearImage EXRDecoder::decode() {
     try {
-        // copy the EXR data in memory
-        std::vector<unsigned char> src;
-        unsigned char buffer[4096];
-        while (mStream.read(reinterpret_cast<char*>(buffer), sizeof(buffer))) {
-            src.insert(src.end(), &buffer[0], &buffer[4096]);
-        }
-        src.insert(src.end(), &buffer[0], &buffer[mStream.gcount()]);
+        // copy the EXR data in memory, in a single pre-sized read
+        mStream.seekg(0, std::istream::end);
+        std::vector<unsigned char> src(size_t(mStream.tellg() - mStreamStartPos));
+        mStream.seekg(mStreamStartPos);
+        mStream.read(reinterpret_cast<char*>(src.data()), std::streamsize(src.size()));
 
         int width;
         int height;
@@ -475,18 +524,27 @@ LinearImage EXRDecoder::decode() {
 
         LinearImage image((uint32_t) width, (uint32_t) height, 3);
 
-        size_t i = 0;
-        for (uint32_t y = 0; y < height; y++) {
-            for (uint32_t x = 0; x < width; x++) {
-                filament::math::float3& pixel =
-                        *reinterpret_cast< filament::math::float3*>(image.getPixelRef(x, y));
-                pixel.r = rgba[i++];
-                pixel.g = rgba[i++];
-                pixel.b = rgba[i++];
-                // skip alpha
-                i++;
+        // tinyexr has already decompressed the scanline blocks on worker threads
+        // (TINYEXR_USE_THREAD); here we spread the RGBA to packed-float3 conversion across
+        // the JobSystem, streaming completed scanline ranges out to the client as we go.
+        const float* rgbaData = rgba;
+        const uint32_t w = (uint32_t) width;
+        forEachScanlineRange(getJobSystem(), (uint32_t) height,
+                [this, &image, rgbaData, w](uint32_t row, uint32_t count) {
+            const float* p = rgbaData + size_t(row) * w * 4;
+            for (uint32_t y = row; y < row + count; y++) {
+                for (uint32_t x = 0; x < w; x++) {
+                    filament::math::float3& pixel =
+                            *reinterpret_cast< filament::math::float3*>(image.getPixelRef(x, y));
+                    pixel.r = p[0];
+                    pixel.g = p[1];
+                    pixel.b = p[2];
+                    // skip alpha
+                    p += 4;
+                }
             }
-        }
+            notifyScanlines(image, row, count);
+        });
 
         free(rgba);
 
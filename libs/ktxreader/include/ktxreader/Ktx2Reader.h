@@ -127,7 +127,8 @@ class Ktx2Reader {
              * Loads all mipmaps from the KTX2 file and transcodes them to the resolved format.
              *
              * This does not return until all mipmaps have been transcoded. This is typically
-             * called from a background thread.
+             * called from a background thread. Levels are transcoded coarsest-first so that
+             * interleaved uploadImages() calls can populate a usable mip chain early.
              */
             Result doTranscoding();
 
@@ -140,6 +141,31 @@ class Ktx2Reader {
              */
             void uploadImages();
 
+            /** \see doTranscoding(TranscodedLevelVisitor, void*) */
+            using TranscodedLevelVisitor = void(*)(uint32_t levelIndex, const void* data,
+                    size_t byteCount, void* user);
+
+            /**
+             * Same as doTranscoding(), but invokes the given visitor with each miplevel's
+             * transcoded payload before publishing it for upload.
+             *
+             * The visitor runs on the calling (background) thread, before the level becomes
+             * visible to interleaved uploadImages() calls, so the payload can safely be stashed
+             * in a cache and later re-injected with setTranscodedLevel() to skip transcoding.
+             */
+            Result doTranscoding(TranscodedLevelVisitor visitor, void* user);
+
+            /**
+             * Injects an already-transcoded payload for the given miplevel, e.g. one previously
+             * observed via the doTranscoding() visitor for the same source data and resolved
+             * format.
+             *
+             * This replaces doTranscoding() for that level: a subsequent uploadImages() call
+             * uploads injected levels just like transcoded ones. The payload is copied. Returns
+             * false if the level index is out of range.
+             */
+            bool setTranscodedLevel(uint32_t levelIndex, const void* data, size_t byteCount);
+
         protected:
             Async() noexcept = default;
             virtual ~Async();
@@ -183,6 +209,86 @@ class Ktx2Reader {
          */
         void asyncDestroy(Async** async);
 
+        /**
+         * Streaming Interface
+         * ===================
+         *
+         * Incremental variant suitable for sources that become available progressively, such as
+         * mmap'd files or network downloads into a preallocated buffer. KTX2 stores mip level
+         * images from coarsest to finest with an offset index at the front of the file, so a
+         * usable low-resolution mip can be uploaded as soon as the first few kilobytes have
+         * arrived, while the finer mips trickle in.
+         *
+         * Usage pseudocode:
+         *
+         *    auto stream = reader->streamCreate(buffer, fileSize, TransferFunction::LINEAR);
+         *    mTexture = stream->getTexture();
+         *    while (!stream->isComplete()) {
+         *        ... receive more bytes into buffer ...
+         *        stream->advance(bytesReceivedSoFar);
+         *    }
+         *    reader->streamDestroy(&stream);
+         */
+        class Stream {
+        public:
+            /**
+             * Retrieves the Texture object.
+             *
+             * The texture is available immediately; its miplevels become populated as advance()
+             * consumes them, coarsest first. The caller has ownership over this texture and is
+             * responsible for freeing it after all miplevels have been uploaded.
+             */
+            Texture* getTexture() const noexcept;
+
+            /**
+             * Notifies the stream that the first validByteCount bytes of the source buffer are
+             * now valid, then transcodes and uploads every level whose byte range has become
+             * fully available, coarsest first.
+             *
+             * Since this calls Texture::setImage(), it should be called from the foreground
+             * thread; see "Thread safety" in the documentation for filament::Engine.
+             */
+            Result advance(size_t validByteCount);
+
+            /**
+             * Returns true once all miplevels have been transcoded and uploaded.
+             */
+            bool isComplete() const noexcept;
+
+        protected:
+            Stream() noexcept = default;
+            virtual ~Stream();
+
+        public:
+            Stream(Stream const&) = delete;
+            Stream(Stream&&) = delete;
+            Stream& operator=(Stream const&) = delete;
+            Stream& operator=(Stream&&) = delete;
+
+            friend class Ktx2Reader;
+        };
+
+        /**
+         * Creates a texture and begins consuming a progressively available KTX2 file.
+         *
+         * Unlike asyncCreate(), no copy of the source data is made: the buffer is caller-owned,
+         * must eventually contain the entire file (totalSize bytes), and must remain valid at a
+         * stable address until the stream is destroyed. Everything preceding the first (coarsest)
+         * level image -- the header, level index, data format descriptor, key/value data and
+         * supercompression global data, all of which live at the front of the file -- must
+         * already be valid when this is called.
+         *
+         * Returns null if none of the requested formats can be extracted from the data.
+         */
+        Stream* streamCreate(const void* data, size_t totalSize, TransferFunction transfer);
+
+        /**
+         * Frees the given stream object and sets it to null.
+         *
+         * This frees neither the source buffer nor the associated Texture object.
+         */
+        void streamDestroy(Stream** stream);
+
     private:
         Ktx2Reader(const Ktx2Reader&) = delete;
         Ktx2Reader& operator=(const Ktx2Reader&) = delete;
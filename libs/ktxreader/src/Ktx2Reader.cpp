@@ -22,6 +22,7 @@
 #include <utils/Log.h>
 
 #include <atomic>
+#include <cstring>
 #include <vector>
 
 #pragma clang diagnostic push
@@ -169,8 +170,9 @@ public:
             mTexture(texture), mEngine(engine), mTranscoder(transcoder),
             mSourceBuffer(std::move(buf)) {}
     Texture* getTexture() const noexcept { return mTexture; }
-    Result doTranscoding();
+    Result doTranscoding(Async::TranscodedLevelVisitor visitor, void* user);
     void uploadImages();
+    bool setTranscodedLevel(uint32_t levelIndex, const void* data, size_t byteCount);
 
 protected:
     ~FAsync();
@@ -196,6 +198,39 @@ private:
     Buffer mSourceBuffer;
 };
 
+// Note: "Stream" clashes with filament::Stream, so it is fully qualified throughout.
+class FStream : public Ktx2Reader::Stream {
+public:
+    FStream(Texture* texture, Engine& engine, ktx2_transcoder* transcoder, const uint8_t* data);
+    Texture* getTexture() const noexcept { return mTexture; }
+    Result advance(size_t validByteCount);
+    bool isComplete() const noexcept { return mNextLevel < 0; }
+
+protected:
+    ~FStream() = default;
+
+private:
+    // Byte range of one level image within the file, taken from the KTX2 level index.
+    struct LevelRange {
+        uint64_t byteOffset;
+        uint64_t byteLength;
+    };
+
+    Texture* const mTexture;
+    Engine& mEngine;
+
+    // See the comment in FAsync for why the transcoder is not shared.
+    std::unique_ptr<ktx2_transcoder> const mTranscoder;
+
+    LevelRange mLevelRanges[KTX2_MAX_SUPPORTED_LEVEL_COUNT] = {};
+
+    // Index of the next level to upload. KTX2 stores levels coarsest-first within the file,
+    // with level 0 (the finest) last, so this counts down and goes negative upon completion.
+    int32_t mNextLevel;
+
+    ktx2_transcoder_state mTranscoderState;
+};
+
 Ktx2Reader::Ktx2Reader(Engine& engine, bool quiet) :
     mEngine(engine),
     mQuiet(quiet),
@@ -272,16 +307,24 @@ FAsync::~FAsync() {
     }
 }
 
-Result FAsync::doTranscoding() {
+Result FAsync::doTranscoding(Async::TranscodedLevelVisitor visitor, void* user) {
     ktx2_transcoder_state basisThreadState;
     basisThreadState.clear();
-    for (uint32_t levelIndex = 0, n = mTranscoder->get_levels(); levelIndex < n; levelIndex++) {
+    // Transcode the coarsest levels first; they are orders of magnitude cheaper than level 0,
+    // so publishing them early lets the foreground thread upload a usable (if blurry) mip chain
+    // with periodic uploadImages() calls while the finest levels are still in flight.
+    for (uint32_t levelIndex = mTranscoder->get_levels(); levelIndex-- > 0;) {
         Texture::PixelBufferDescriptor* pbd;
         Result result = transcodeImageLevel(*mTranscoder, basisThreadState, mTexture->getFormat(),
                 levelIndex, &pbd);
         if (UTILS_UNLIKELY(result != Result::SUCCESS)) {
             return result;
         }
+        // The visitor must run before the store; once published, an interleaved uploadImages()
+        // call on the foreground thread may consume (and free) the payload at any time.
+        if (visitor) {
+            visitor(levelIndex, pbd->buffer, pbd->size, user);
+        }
         mTranscoderResults[levelIndex].store(pbd);
     }
     return Result::SUCCESS;
@@ -301,6 +344,27 @@ void FAsync::uploadImages() {
     }
 }
 
+bool FAsync::setTranscodedLevel(uint32_t levelIndex, const void* data, size_t byteCount) {
+    if (levelIndex >= KTX2_MAX_SUPPORTED_LEVEL_COUNT) {
+        return false;
+    }
+    const FinalFormatInfo formatInfo = getFinalFormatInfo(mTexture->getFormat());
+    void* const payload = malloc(byteCount);
+    memcpy(payload, data, byteCount);
+    Texture::PixelBufferDescriptor* pbd;
+    if (formatInfo.isCompressed) {
+        pbd = new Texture::PixelBufferDescriptor(payload, byteCount,
+                formatInfo.compressedPixelDataType, uint32_t(byteCount), freeCallback);
+    } else {
+        pbd = new Texture::PixelBufferDescriptor(payload, byteCount,
+                formatInfo.pixelDataFormat, formatInfo.pixelDataType, freeCallback);
+    }
+    if (Texture::PixelBufferDescriptor* previous = mTranscoderResults[levelIndex].exchange(pbd)) {
+        delete previous;
+    }
+    return true;
+}
+
 Async* Ktx2Reader::asyncCreate(const void* data, size_t size, TransferFunction transfer) {
     Buffer ktx2content((uint8_t*)data, (uint8_t*)data + size);
     ktx2_transcoder* transcoder = new ktx2_transcoder();
@@ -325,6 +389,66 @@ void Ktx2Reader::asyncDestroy(Async** async) {
     *async = nullptr;
 }
 
+FStream::FStream(Texture* texture, Engine& engine, ktx2_transcoder* transcoder,
+        const uint8_t* data) :
+        mTexture(texture), mEngine(engine), mTranscoder(transcoder),
+        mNextLevel(int32_t(transcoder->get_levels()) - 1) {
+    // The KTX2 level index immediately follows the 80-byte header; each entry holds the
+    // byteOffset / byteLength / uncompressedByteLength of one level image. The transcoder does
+    // not expose the file offsets, so extract them directly. memcpy avoids alignment issues.
+    constexpr size_t KTX2_HEADER_SIZE = 80;
+    constexpr size_t KTX2_LEVEL_INDEX_ENTRY_SIZE = 3 * sizeof(uint64_t);
+    for (uint32_t levelIndex = 0, n = transcoder->get_levels(); levelIndex < n; levelIndex++) {
+        const uint8_t* entry = data + KTX2_HEADER_SIZE + levelIndex * KTX2_LEVEL_INDEX_ENTRY_SIZE;
+        memcpy(&mLevelRanges[levelIndex].byteOffset, entry, sizeof(uint64_t));
+        memcpy(&mLevelRanges[levelIndex].byteLength, entry + sizeof(uint64_t), sizeof(uint64_t));
+    }
+    mTranscoderState.clear();
+}
+
+Result FStream::advance(size_t validByteCount) {
+    while (mNextLevel >= 0) {
+        const LevelRange range = mLevelRanges[mNextLevel];
+        if (range.byteOffset + range.byteLength > validByteCount) {
+            break;
+        }
+        const uint32_t levelIndex = uint32_t(mNextLevel);
+        Texture::PixelBufferDescriptor* pbd;
+        Result result = transcodeImageLevel(*mTranscoder, mTranscoderState, mTexture->getFormat(),
+                levelIndex, &pbd);
+        if (UTILS_UNLIKELY(result != Result::SUCCESS)) {
+            return result;
+        }
+        mTexture->setImage(mEngine, levelIndex, std::move(*pbd));
+        delete pbd;
+        --mNextLevel;
+    }
+    return Result::SUCCESS;
+}
+
+Ktx2Reader::Stream* Ktx2Reader::streamCreate(const void* data, size_t totalSize,
+        TransferFunction transfer) {
+    ktx2_transcoder* transcoder = new ktx2_transcoder();
+    // The transcoder only reads the front-of-file metadata here; level images are read lazily by
+    // transcode_image_level(), which is what makes streaming possible.
+    Texture* texture = createTexture(transcoder, data, totalSize, transfer);
+    if (texture == nullptr) {
+        delete transcoder;
+        return nullptr;
+    }
+    if (!transcoder->start_transcoding()) {
+        delete transcoder;
+        mEngine.destroy(texture);
+        return nullptr;
+    }
+    return new FStream(texture, mEngine, transcoder, (const uint8_t*) data);
+}
+
+void Ktx2Reader::streamDestroy(Stream** stream) {
+    delete *stream;
+    *stream = nullptr;
+}
+
 Texture* Ktx2Reader::createTexture(ktx2_transcoder* transcoder, const void* data, size_t size,
         TransferFunction transfer) {
     if (!transcoder->init(data, size)) {
@@ -431,11 +555,33 @@ Texture* Async::getTexture() const noexcept {
 }
 
 Result Async::doTranscoding() {
-    return static_cast<FAsync*>(this)->doTranscoding();
+    return static_cast<FAsync*>(this)->doTranscoding(nullptr, nullptr);
+}
+
+Result Async::doTranscoding(TranscodedLevelVisitor visitor, void* user) {
+    return static_cast<FAsync*>(this)->doTranscoding(visitor, user);
 }
 
 void Async::uploadImages() {
     return static_cast<FAsync*>(this)->uploadImages();
 }
 
+bool Async::setTranscodedLevel(uint32_t levelIndex, const void* data, size_t byteCount) {
+    return static_cast<FAsync*>(this)->setTranscodedLevel(levelIndex, data, byteCount);
+}
+
+Ktx2Reader::Stream::~Stream() = default;
+
+Texture* Ktx2Reader::Stream::getTexture() const noexcept {
+    return static_cast<FStream const*>(this)->getTexture();
+}
+
+Result Ktx2Reader::Stream::advance(size_t validByteCount) {
+    return static_cast<FStream*>(this)->advance(validByteCount);
+}
+
+bool Ktx2Reader::Stream::isComplete() const noexcept {
+    return static_cast<FStream const*>(this)->isComplete();
+}
+
 } // namespace ktxreader
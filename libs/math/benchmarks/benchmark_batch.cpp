@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PerformanceCounters.h"
+
+#include <benchmark/benchmark.h>
+
+#include <math/batch.h>
+#include <math/mat4.h>
+#include <math/quat.h>
+#include <math/vec3.h>
+
+#include <random>
+#include <vector>
+
+using namespace filament::math;
+
+static constexpr size_t COUNT = 1024;
+
+static std::vector<float3> randomPoints() noexcept {
+    std::default_random_engine gen(82828); // NOLINT
+    std::uniform_real_distribution<float> rand(-100.0f, 100.0f);
+    std::vector<float3> points(COUNT);
+    for (auto& p : points) {
+        p = { rand(gen), rand(gen), rand(gen) };
+    }
+    return points;
+}
+
+static void BM_transformPoints(benchmark::State& state) noexcept {
+    mat4f const m = mat4f::translation(float3{ 1, 2, 3 }) * mat4f::rotation(1.0f, float3{ 0, 0, 1 });
+    auto const in = randomPoints();
+    std::vector<float3> out(COUNT);
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            batch::transformPoints(out.data(), in.data(), COUNT, m);
+            benchmark::ClobberMemory();
+            benchmark::DoNotOptimize(out);
+        }
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * COUNT);
+    }
+}
+
+static void BM_transformBoxes(benchmark::State& state) noexcept {
+    mat4f const m = mat4f::translation(float3{ 1, 2, 3 }) * mat4f::rotation(1.0f, float3{ 0, 0, 1 });
+    auto const center = randomPoints();
+    auto const halfExtent = randomPoints();
+    std::vector<float3> outCenter(COUNT);
+    std::vector<float3> outHalfExtent(COUNT);
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            batch::transformBoxes(outCenter.data(), outHalfExtent.data(),
+                    center.data(), halfExtent.data(), COUNT, m);
+            benchmark::ClobberMemory();
+            benchmark::DoNotOptimize(outCenter);
+            benchmark::DoNotOptimize(outHalfExtent);
+        }
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * COUNT);
+    }
+}
+
+static void BM_multiply(benchmark::State& state) noexcept {
+    std::vector<mat4f> lhs(COUNT);
+    std::vector<mat4f> rhs(COUNT);
+    for (size_t i = 0; i < COUNT; i++) {
+        lhs[i] = mat4f::rotation(float(i) * 0.1f, float3{ 0, 1, 0 });
+        rhs[i] = mat4f::translation(float3{ float(i), 0, 0 });
+    }
+    std::vector<mat4f> out(COUNT);
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            batch::multiply(out.data(), lhs.data(), rhs.data(), COUNT);
+            benchmark::ClobberMemory();
+            benchmark::DoNotOptimize(out);
+        }
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * COUNT);
+    }
+}
+
+static void BM_normalize(benchmark::State& state) noexcept {
+    auto const in = randomPoints();
+    std::vector<float3> out(COUNT);
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            batch::normalize(out.data(), in.data(), COUNT);
+            benchmark::ClobberMemory();
+            benchmark::DoNotOptimize(out);
+        }
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * COUNT);
+    }
+}
+
+static void BM_slerp(benchmark::State& state) noexcept {
+    std::vector<quatf> p(COUNT);
+    std::vector<quatf> q(COUNT);
+    for (size_t i = 0; i < COUNT; i++) {
+        p[i] = quatf::fromAxisAngle(float3{ 0, 1, 0 }, float(i) * 0.01f);
+        q[i] = quatf::fromAxisAngle(float3{ 1, 0, 0 }, float(i) * 0.02f);
+    }
+    std::vector<quatf> out(COUNT);
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            batch::slerp(out.data(), p.data(), q.data(), COUNT, 0.25f);
+            benchmark::ClobberMemory();
+            benchmark::DoNotOptimize(out);
+        }
+        pc.stop();
+        state.SetItemsProcessed(state.iterations() * COUNT);
+    }
+}
+
+BENCHMARK(BM_transformPoints);
+BENCHMARK(BM_transformBoxes);
+BENCHMARK(BM_multiply);
+BENCHMARK(BM_normalize);
+BENCHMARK(BM_slerp);
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_MATH_BATCH_H
+#define TNT_MATH_BATCH_H
+
+#include <math/compiler.h>
+#include <math/mat3.h>
+#include <math/mat4.h>
+#include <math/quat.h>
+#include <math/vec3.h>
+
+#include <stddef.h>
+
+namespace filament {
+namespace math {
+namespace batch {
+
+/*
+ * Batch kernels for applying the same operation to arrays of math types.
+ *
+ * These are written as plain loops on purpose: the pointers are declared restrict and the
+ * per-element work is branch-free, which is all the compiler needs to vectorize them at the
+ * target's natural width. We ship per-ABI binaries, so instruction selection is a
+ * compile-time decision and runtime dispatch would only put an indirect call in front of
+ * each loop.
+ *
+ * None of the arrays may overlap (this is what restrict promises the compiler).
+ */
+
+// transforms count points by the affine transformation m (the projective row is ignored)
+inline void transformPoints(float3* MATH_RESTRICT out, float3 const* MATH_RESTRICT in,
+        size_t count, mat4f const& m) noexcept {
+    mat3f const u = m.upperLeft();
+    float3 const t = m[3].xyz;
+    for (size_t i = 0; i < count; i++) {
+        out[i] = u * in[i] + t;
+    }
+}
+
+// transforms count points by the projective transformation m, with perspective divide
+inline void projectPoints(float3* MATH_RESTRICT out, float3 const* MATH_RESTRICT in,
+        size_t count, mat4f const& m) noexcept {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = mat4f::project(m, in[i]);
+    }
+}
+
+// transforms count AABBs given as {center, halfExtent} pairs by the affine transformation m
+// (same math as Box::transform())
+inline void transformBoxes(
+        float3* MATH_RESTRICT outCenter, float3* MATH_RESTRICT outHalfExtent,
+        float3 const* MATH_RESTRICT center, float3 const* MATH_RESTRICT halfExtent,
+        size_t count, mat4f const& m) noexcept {
+    mat3f const u = m.upperLeft();
+    mat3f const a = abs(u);
+    float3 const t = m[3].xyz;
+    for (size_t i = 0; i < count; i++) {
+        outCenter[i] = u * center[i] + t;
+        outHalfExtent[i] = a * halfExtent[i];
+    }
+}
+
+// multiplies count matrix pairs: out[i] = lhs[i] * rhs[i]
+inline void multiply(mat4f* MATH_RESTRICT out,
+        mat4f const* MATH_RESTRICT lhs, mat4f const* MATH_RESTRICT rhs,
+        size_t count) noexcept {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = lhs[i] * rhs[i];
+    }
+}
+
+// normalizes count vectors
+inline void normalize(float3* MATH_RESTRICT out, float3 const* MATH_RESTRICT in,
+        size_t count) noexcept {
+    for (size_t i = 0; i < count; i++) {
+        float3 const v = in[i];
+        out[i] = normalize(v); // found by ADL, normalize() is a hidden friend of TVec3
+    }
+}
+
+// spherical interpolation of count quaternion pairs at parameter t
+inline void slerp(quatf* MATH_RESTRICT out,
+        quatf const* MATH_RESTRICT p, quatf const* MATH_RESTRICT q,
+        size_t count, float t) noexcept {
+    for (size_t i = 0; i < count; i++) {
+        quatf const a = p[i];
+        quatf const b = q[i];
+        out[i] = slerp(a, b, t); // found by ADL, slerp() is a hidden friend of TQuaternion
+    }
+}
+
+} // namespace batch
+} // namespace math
+} // namespace filament
+
+#endif // TNT_MATH_BATCH_H
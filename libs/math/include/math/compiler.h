@@ -75,6 +75,8 @@
 #ifdef _MSC_VER
 #   define MATH_EMPTY_BASES __declspec(empty_bases)
 
+#   define MATH_RESTRICT __restrict
+
 // MSVC does not support loop unrolling hints
 #   define MATH_NOUNROLL
 
@@ -98,6 +100,9 @@
 #else // _MSC_VER
 
 #   define MATH_EMPTY_BASES
+
+#   define MATH_RESTRICT __restrict__
+
 // C++11 allows pragmas to be specified as part of defines using the _Pragma syntax.
 #   define MATH_NOUNROLL _Pragma("nounroll")
 
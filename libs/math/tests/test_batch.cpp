@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include <math/batch.h>
+#include <math/mat4.h>
+#include <math/quat.h>
+#include <math/vec3.h>
+
+using namespace filament::math;
+
+class BatchTest : public testing::Test {
+protected:
+    static constexpr size_t COUNT = 100;
+
+    std::vector<float3> randomPoints() {
+        std::default_random_engine gen(82828); // NOLINT
+        std::uniform_real_distribution<float> rand(-100.0f, 100.0f);
+        std::vector<float3> points(COUNT);
+        for (auto& p : points) {
+            p = { rand(gen), rand(gen), rand(gen) };
+        }
+        return points;
+    }
+};
+
+TEST_F(BatchTest, TransformPoints) {
+    mat4f const m = mat4f::translation(float3{ 1, 2, 3 }) * mat4f::rotation(1.0f, float3{ 0, 0, 1 });
+    auto const in = randomPoints();
+    std::vector<float3> out(COUNT);
+    batch::transformPoints(out.data(), in.data(), COUNT, m);
+    for (size_t i = 0; i < COUNT; i++) {
+        float3 const expected = (m * float4{ in[i], 1.0f }).xyz;
+        EXPECT_FLOAT_EQ(expected.x, out[i].x);
+        EXPECT_FLOAT_EQ(expected.y, out[i].y);
+        EXPECT_FLOAT_EQ(expected.z, out[i].z);
+    }
+}
+
+TEST_F(BatchTest, ProjectPoints) {
+    mat4f const m = mat4f::perspective(45.0f, 1.0f, 0.1f, 100.0f);
+    auto in = randomPoints();
+    for (auto& p : in) {
+        p.z = -1.0f - std::abs(p.z); // keep the points in front of the camera
+    }
+    std::vector<float3> out(COUNT);
+    batch::projectPoints(out.data(), in.data(), COUNT, m);
+    for (size_t i = 0; i < COUNT; i++) {
+        float3 const expected = mat4f::project(m, in[i]);
+        EXPECT_FLOAT_EQ(expected.x, out[i].x);
+        EXPECT_FLOAT_EQ(expected.y, out[i].y);
+        EXPECT_FLOAT_EQ(expected.z, out[i].z);
+    }
+}
+
+TEST_F(BatchTest, TransformBoxes) {
+    mat4f const m = mat4f::translation(float3{ -5, 0, 9 }) * mat4f::rotation(0.5f, float3{ 1, 1, 0 });
+    auto const center = randomPoints();
+    auto halfExtent = randomPoints();
+    for (auto& e : halfExtent) {
+        e = abs(e);
+    }
+    std::vector<float3> outCenter(COUNT);
+    std::vector<float3> outHalfExtent(COUNT);
+    batch::transformBoxes(outCenter.data(), outHalfExtent.data(),
+            center.data(), halfExtent.data(), COUNT, m);
+    mat3f const u = m.upperLeft();
+    for (size_t i = 0; i < COUNT; i++) {
+        float3 const expectedCenter = u * center[i] + m[3].xyz;
+        float3 const expectedHalfExtent = abs(u) * halfExtent[i];
+        EXPECT_FLOAT_EQ(expectedCenter.x, outCenter[i].x);
+        EXPECT_FLOAT_EQ(expectedCenter.y, outCenter[i].y);
+        EXPECT_FLOAT_EQ(expectedCenter.z, outCenter[i].z);
+        EXPECT_FLOAT_EQ(expectedHalfExtent.x, outHalfExtent[i].x);
+        EXPECT_FLOAT_EQ(expectedHalfExtent.y, outHalfExtent[i].y);
+        EXPECT_FLOAT_EQ(expectedHalfExtent.z, outHalfExtent[i].z);
+    }
+}
+
+TEST_F(BatchTest, Multiply) {
+    std::vector<mat4f> lhs(COUNT);
+    std::vector<mat4f> rhs(COUNT);
+    for (size_t i = 0; i < COUNT; i++) {
+        lhs[i] = mat4f::rotation(float(i) * 0.1f, float3{ 0, 1, 0 });
+        rhs[i] = mat4f::translation(float3{ float(i), 0, 0 });
+    }
+    std::vector<mat4f> out(COUNT);
+    batch::multiply(out.data(), lhs.data(), rhs.data(), COUNT);
+    for (size_t i = 0; i < COUNT; i++) {
+        mat4f const expected = lhs[i] * rhs[i];
+        for (size_t c = 0; c < 4; c++) {
+            for (size_t r = 0; r < 4; r++) {
+                EXPECT_FLOAT_EQ(expected[c][r], out[i][c][r]);
+            }
+        }
+    }
+}
+
+TEST_F(BatchTest, Normalize) {
+    auto const in = randomPoints();
+    std::vector<float3> out(COUNT);
+    batch::normalize(out.data(), in.data(), COUNT);
+    for (size_t i = 0; i < COUNT; i++) {
+        float3 const expected = normalize(in[i]);
+        EXPECT_FLOAT_EQ(expected.x, out[i].x);
+        EXPECT_FLOAT_EQ(expected.y, out[i].y);
+        EXPECT_FLOAT_EQ(expected.z, out[i].z);
+        EXPECT_NEAR(1.0f, length(out[i]), 1e-6f);
+    }
+}
+
+TEST_F(BatchTest, Slerp) {
+    std::vector<quatf> p(COUNT);
+    std::vector<quatf> q(COUNT);
+    for (size_t i = 0; i < COUNT; i++) {
+        p[i] = quatf::fromAxisAngle(float3{ 0, 1, 0 }, float(i) * 0.01f);
+        q[i] = quatf::fromAxisAngle(float3{ 1, 0, 0 }, float(i) * 0.02f);
+    }
+    std::vector<quatf> out(COUNT);
+    batch::slerp(out.data(), p.data(), q.data(), COUNT, 0.25f);
+    for (size_t i = 0; i < COUNT; i++) {
+        quatf const expected = slerp(p[i], q[i], 0.25f);
+        EXPECT_FLOAT_EQ(expected.x, out[i].x);
+        EXPECT_FLOAT_EQ(expected.y, out[i].y);
+        EXPECT_FLOAT_EQ(expected.z, out[i].z);
+        EXPECT_FLOAT_EQ(expected.w, out[i].w);
+    }
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PerformanceCounters.h"
+
+#include <utils/compiler.h>
+#include <utils/Hash.h>
+
+#include <tsl/robin_map.h>
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace utils;
+
+// mimics the keys used by the engine's render-loop caches (e.g. HwRenderPrimitiveFactory)
+struct Key { // 20 bytes
+    uint32_t a;
+    uint32_t b;
+    uint32_t offset;
+    uint32_t count;
+    uint8_t type;
+};
+
+struct KeyHasher {
+    size_t operator()(Key const& key) const noexcept {
+        uint32_t const words[5] = { key.a, key.b, key.offset, key.count, key.type };
+        return hash::murmur3(words, 5, 0);
+    }
+};
+
+struct KeyEqual {
+    bool operator()(Key const& lhs, Key const& rhs) const noexcept {
+        return lhs.a == rhs.a && lhs.b == rhs.b
+                && lhs.offset == rhs.offset && lhs.count == rhs.count
+                && lhs.type == rhs.type;
+    }
+};
+
+struct KeyLess {
+    bool operator()(Key const& lhs, Key const& rhs) const noexcept {
+        if (lhs.a != rhs.a) return lhs.a < rhs.a;
+        if (lhs.b != rhs.b) return lhs.b < rhs.b;
+        if (lhs.offset != rhs.offset) return lhs.offset < rhs.offset;
+        if (lhs.count != rhs.count) return lhs.count < rhs.count;
+        return lhs.type < rhs.type;
+    }
+};
+
+class HashMaps : public benchmark::Fixture {
+public:
+    HashMaps();
+    ~HashMaps() override;
+
+protected:
+    std::vector<Key> keys;
+
+    std::vector<Key> prepareItems(size_t size);
+};
+
+HashMaps::HashMaps() {
+    keys.resize(1 << 16);
+    std::default_random_engine gen{123}; // NOLINT
+    std::uniform_int_distribution<uint32_t> nd;
+    std::generate(keys.begin(), keys.end(), [&]() {
+        return Key{ nd(gen), nd(gen), nd(gen), nd(gen), uint8_t(nd(gen) & 7u) };
+    });
+}
+
+HashMaps::~HashMaps() = default;
+
+UTILS_NOINLINE
+std::vector<Key> HashMaps::prepareItems(size_t size) {
+    std::vector<Key> items(keys.begin(), keys.begin() + size);
+    std::default_random_engine gen{123}; // NOLINT
+    std::shuffle(items.begin(), items.end(), gen);
+    return items;
+}
+
+BENCHMARK_DEFINE_F(HashMaps, stdMap)(benchmark::State& state) {
+    std::map<Key, uint32_t, KeyLess> map;
+    for (size_t i = 0, c = state.range(0); i < c; i++) {
+        map[keys[i]] = uint32_t(i);
+    }
+    std::vector<Key> items = prepareItems(state.range(0));
+    Key const* ip = items.data();
+    size_t i = 0;
+
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            auto const& pos = map.find(ip[i++ % state.range(0)]);
+            benchmark::DoNotOptimize(pos);
+        }
+    }
+}
+
+BENCHMARK_DEFINE_F(HashMaps, stdUnorderedMap)(benchmark::State& state) {
+    std::unordered_map<Key, uint32_t, KeyHasher, KeyEqual> map;
+    for (size_t i = 0, c = state.range(0); i < c; i++) {
+        map[keys[i]] = uint32_t(i);
+    }
+    std::vector<Key> items = prepareItems(state.range(0));
+    Key const* ip = items.data();
+    size_t i = 0;
+
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            auto const& pos = map.find(ip[i++ % state.range(0)]);
+            benchmark::DoNotOptimize(pos);
+        }
+    }
+}
+
+BENCHMARK_DEFINE_F(HashMaps, robinMap)(benchmark::State& state) {
+    tsl::robin_map<Key, uint32_t, KeyHasher, KeyEqual> map;
+    for (size_t i = 0, c = state.range(0); i < c; i++) {
+        map[keys[i]] = uint32_t(i);
+    }
+    std::vector<Key> items = prepareItems(state.range(0));
+    Key const* ip = items.data();
+    size_t i = 0;
+
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            auto const& pos = map.find(ip[i++ % state.range(0)]);
+            benchmark::DoNotOptimize(pos);
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(HashMaps, stdMap)->Range(8, 1 << 16);
+BENCHMARK_REGISTER_F(HashMaps, stdUnorderedMap)->Range(8, 1 << 16);
+BENCHMARK_REGISTER_F(HashMaps, robinMap)->Range(8, 1 << 16);
@@ -107,6 +107,14 @@ public:
         set_current(p);
     }
 
+    // highest address allocated since the last call; intended for
+    // AreaPolicy::VirtualArea::releaseUnusedPages(), typically once per frame
+    void* takeWatermark() UTILS_RESTRICT noexcept {
+        void* const p = pointermath::add(mBegin, mWatermark);
+        mWatermark = mCur;
+        return p;
+    }
+
     // frees all allocated blocks
     void reset() UTILS_RESTRICT noexcept {
         rewind(mBegin);
@@ -131,11 +139,14 @@ private:
     void* current() UTILS_RESTRICT noexcept { return pointermath::add(mBegin, mCur); }
     void set_current(void* p) UTILS_RESTRICT noexcept {
         mCur = uint32_t(uintptr_t(p) - uintptr_t(mBegin));
+        // branchless high-water mark tracking (see takeWatermark())
+        mWatermark = mCur > mWatermark ? mCur : mWatermark;
     }
 
     void* mBegin = nullptr;
     uint32_t mSize = 0;
     uint32_t mCur = 0;
+    uint32_t mWatermark = 0;
 };
 
 /* ------------------------------------------------------------------------------------------------
@@ -204,6 +215,15 @@ public:
         return mHead;
     }
 
+    // adds the [begin, end) range to this free list
+    void extend(void* begin, void* end,
+            size_t elementSize, size_t alignment, size_t extra) noexcept;
+
+    // rebuilds the free list over the [begin, end) range, returning all its elements at
+    // once; all outstanding allocations from that range become invalid
+    void reset(void* begin, void* end,
+            size_t elementSize, size_t alignment, size_t extra) noexcept;
+
 private:
     struct Node {
         Node* next;
@@ -273,6 +293,18 @@ public:
         return mStorage + mHead.load(std::memory_order_relaxed).offset;
     }
 
+    // Adds the [begin, end) range to this free list. The range must be above the one the
+    // free list was constructed with (offsets are relative to the original storage).
+    // Can proceed concurrently with pop()/push().
+    void extend(void* begin, void* end,
+            size_t elementSize, size_t alignment, size_t extra) noexcept;
+
+    // Rebuilds the free list over the [begin, end) range, returning all its elements at
+    // once; all outstanding allocations from that range become invalid. Unlike extend(),
+    // this must NOT proceed concurrently with pop()/push().
+    void reset(void* begin, void* end,
+            size_t elementSize, size_t alignment, size_t extra) noexcept;
+
 private:
     struct Node {
         // This should be a regular (non-atomic) pointer, but this causes TSAN to complain
@@ -369,6 +401,18 @@ public:
         return mFreeList.getFirst();
     }
 
+    // grows the pool with the [begin, end) range
+    void extend(void* begin, void* end) noexcept {
+        mFreeList.extend(begin, end, ELEMENT_SIZE, ALIGNMENT, OFFSET);
+    }
+
+    // bulk-free: returns all elements of the [begin, end) range to the pool in a single
+    // pass, which is much cheaper than free()ing them one by one. All outstanding
+    // allocations from that range become invalid.
+    void drain(void* begin, void* end) noexcept {
+        mFreeList.reset(begin, end, ELEMENT_SIZE, ALIGNMENT, OFFSET);
+    }
+
 private:
     FREELIST mFreeList;
 };
@@ -459,6 +503,51 @@ private:
     void* mEnd = nullptr;
 };
 
+/*
+ * An area backed by reserved virtual address space. Physical pages are committed by the
+ * OS on first touch, so an arena sized for the worst case only consumes the memory it
+ * actually uses. releaseUnusedPages() returns the pages above a high-water mark to the
+ * OS (madvise), with a decay so that a transient spike (e.g. loading) is given back over
+ * a few calls while sustained usage keeps its pages committed.
+ * Falls back to a HeapArea-like malloc() on OSes without virtual memory support.
+ */
+class VirtualArea {
+public:
+    VirtualArea() noexcept = default;
+
+    explicit VirtualArea(size_t size);
+
+    ~VirtualArea() noexcept;
+
+    VirtualArea(const VirtualArea& rhs) = delete;
+    VirtualArea& operator=(const VirtualArea& rhs) = delete;
+    VirtualArea(VirtualArea&& rhs) noexcept = delete;
+    VirtualArea& operator=(VirtualArea&& rhs) noexcept = delete;
+
+    void* data() const noexcept { return mBegin; }
+    void* begin() const noexcept { return mBegin; }
+    void* end() const noexcept { return mEnd; }
+    size_t size() const noexcept { return uintptr_t(mEnd) - uintptr_t(mBegin); }
+
+    // releases unused pages back to the OS. highWatermark is the highest address used
+    // since the previous call (see LinearAllocator::takeWatermark()); intended to be
+    // called at a regular cadence, typically once per frame.
+    void releaseUnusedPages(void* highWatermark) noexcept;
+
+    friend void swap(VirtualArea& lhs, VirtualArea& rhs) noexcept {
+        using std::swap;
+        swap(lhs.mBegin, rhs.mBegin);
+        swap(lhs.mEnd, rhs.mEnd);
+        swap(lhs.mCommittedSize, rhs.mCommittedSize);
+    }
+
+private:
+    void* mBegin = nullptr;
+    void* mEnd = nullptr;
+    // page-aligned commit high-water mark, decays in releaseUnusedPages()
+    size_t mCommittedSize = 0;
+};
+
 class NullArea {
 public:
     void* data() const noexcept { return nullptr; }
@@ -62,6 +62,17 @@ public:
     // destroys n entities. Thread safe.
     void destroy(size_t n, Entity* entities) noexcept;
 
+    // Queues n entities for deferred destruction. Thread safe.
+    // The entities are dead (isAlive() returns false) as soon as this call returns, so stale
+    // handles are safe, but the heavier bookkeeping (index recycling, listener notification)
+    // is postponed until flushDeferredDestroys() is called. Use this to despawn large batches
+    // of entities without hitching the calling thread.
+    void destroyDeferred(size_t n, Entity const* entities) noexcept;
+
+    // Performs the deferred work of all pending destroyDeferred() calls in one batch.
+    // Typically called once per frame from a worker thread. Thread safe.
+    void flushDeferredDestroys() noexcept;
+
     // Create a new Entity. Thread safe.
     // Return Entity.isNull() if the entity cannot be allocated.
     Entity create() {
@@ -75,6 +86,11 @@ public:
         destroy(1, &e);
     }
 
+    // Queues an Entity for deferred destruction. Thread safe.
+    void destroyDeferred(Entity e) noexcept {
+        destroyDeferred(1, &e);
+    }
+
     // Return whether the given Entity has been destroyed (false) or not (true).
     // Thread safe.
     bool isAlive(Entity e) const noexcept {
@@ -20,6 +20,7 @@
 #include <utils/compressed_pair.h>
 #include <utils/Panic.h>
 
+#include <algorithm>
 #include <initializer_list>
 #include <limits>
 #include <memory>
@@ -72,6 +73,17 @@ public:
 private:
     using storage_traits = std::allocator_traits<allocator_type>;
 
+    template<typename U, typename = void>
+    struct is_inline_allocator : std::false_type {};
+    template<typename U>
+    struct is_inline_allocator<U, std::void_t<decltype(
+            std::declval<U const&>().owns(std::declval<const_pointer>()))>> : std::true_type {};
+
+    // Whether the allocator can place the storage inside the vector itself (e.g.
+    // SmallBufferAllocator below), in which case buffers can't simply be exchanged
+    // between vectors; move and swap then handle the elements individually.
+    static constexpr bool has_inline_storage = is_inline_allocator<allocator_type>::value;
+
 public:
     /** returns an empty vector with the specified capacity */
     static FixedCapacityVector with_capacity(
@@ -117,7 +129,11 @@ public:
     }
 
     FixedCapacityVector(FixedCapacityVector&& rhs) noexcept {
-        this->swap(rhs);
+        if constexpr (has_inline_storage) {
+            move_from(std::move(rhs));
+        } else {
+            this->swap(rhs);
+        }
     }
 
     ~FixedCapacityVector() noexcept {
@@ -128,13 +144,28 @@ public:
     FixedCapacityVector& operator=(FixedCapacityVector const& rhs) {
         if (this != &rhs) {
             FixedCapacityVector t(rhs);
-            this->swap(t);
+            if constexpr (has_inline_storage) {
+                *this = std::move(t);
+            } else {
+                this->swap(t);
+            }
         }
         return *this;
     }
 
     FixedCapacityVector& operator=(FixedCapacityVector&& rhs) noexcept {
-        this->swap(rhs);
+        if constexpr (has_inline_storage) {
+            if (this != &rhs) {
+                destroy(begin(), end());
+                allocator().deallocate(data(), capacity());
+                mData = nullptr;
+                mSize = 0;
+                mCapacityAllocator.first() = 0;
+                move_from(std::move(rhs));
+            }
+        } else {
+            this->swap(rhs);
+        }
         return *this;
     }
 
@@ -281,19 +312,49 @@ public:
     }
 
     void swap(FixedCapacityVector& other) {
-        using std::swap;
-        swap(mData, other.mData);
-        swap(mSize, other.mSize);
-        mCapacityAllocator.swap(other.mCapacityAllocator);
+        if constexpr (has_inline_storage) {
+            if (allocator().owns(data()) || other.allocator().owns(other.data())) {
+                // one of the storages lives inside its vector, exchange the elements
+                // instead of the buffers. Each vector keeps its own capacity.
+                swap_inline(other);
+                return;
+            }
+            // neither storage is inline, the buffers can be exchanged; the capacities
+            // are swapped by hand because the allocators must stay put
+            using std::swap;
+            swap(mData, other.mData);
+            swap(mSize, other.mSize);
+            size_type const c = capacity();
+            mCapacityAllocator.first() = other.capacity();
+            other.mCapacityAllocator.first() = c;
+        } else {
+            using std::swap;
+            swap(mData, other.mData);
+            swap(mSize, other.mSize);
+            mCapacityAllocator.swap(other.mCapacityAllocator);
+        }
     }
 
     UTILS_NOINLINE
     void reserve(size_type c) {
         if (c > capacity()) {
-            FixedCapacityVector t(construct_with_capacity, c, allocator());
-            t.mSize = size();
-            std::uninitialized_move(begin(), end(), t.begin());
-            this->swap(t);
+            if constexpr (has_inline_storage) {
+                // the new buffer can be the inline storage itself while c still fits it,
+                // in which case there is nothing to move
+                pointer const p = allocator().allocate(c);
+                if (p != data()) {
+                    std::uninitialized_move(begin(), end(), p);
+                    destroy(begin(), end());
+                    allocator().deallocate(data(), capacity());
+                    mData = p;
+                }
+                mCapacityAllocator.first() = c;
+            } else {
+                FixedCapacityVector t(construct_with_capacity, c, allocator());
+                t.mSize = size();
+                std::uninitialized_move(begin(), end(), t.begin());
+                this->swap(t);
+            }
         }
     }
 
@@ -314,6 +375,62 @@ private:
         return mCapacityAllocator.second();
     }
 
+    // move-construction when the storage may be inline: steal the buffer when it isn't,
+    // move the elements one by one when it is. *this must be empty.
+    void move_from(FixedCapacityVector&& rhs) {
+        assert(data() == nullptr);
+        if (rhs.allocator().owns(rhs.data())) {
+            mCapacityAllocator.first() = rhs.capacity();
+            mData = allocator().allocate(rhs.capacity());
+            mSize = rhs.mSize;
+            std::uninitialized_move(rhs.begin(), rhs.end(), begin());
+            rhs.clear();
+        } else {
+            mData = rhs.mData;
+            mSize = rhs.mSize;
+            mCapacityAllocator.first() = rhs.capacity();
+            rhs.mData = nullptr;
+            rhs.mSize = 0;
+            rhs.mCapacityAllocator.first() = 0;
+        }
+    }
+
+    // element-wise swap, for when either storage is inline
+    void swap_inline(FixedCapacityVector& other) {
+        bool const thisInline = allocator().owns(data());
+        bool const otherInline = other.allocator().owns(other.data());
+        if (thisInline != otherInline) {
+            // exactly one storage is inline: move its elements into the other vector's
+            // inline storage and take the non-inline buffer in exchange
+            auto& in = thisInline ? *this : other;
+            auto& out = thisInline ? other : *this;
+            pointer const p = out.mData;
+            size_type const c = out.capacity();
+            size_type const s = out.mSize;
+            out.mCapacityAllocator.first() = in.capacity();
+            out.mData = out.allocator().allocate(in.capacity());
+            out.mSize = in.mSize;
+            std::uninitialized_move(in.begin(), in.end(), out.begin());
+            in.destroy(in.begin(), in.end());
+            in.mData = p;
+            in.mCapacityAllocator.first() = c;
+            in.mSize = s;
+            return;
+        }
+        // both storages are inline: exchange the elements in place. The physical storage
+        // is the same size on both sides, so capacities can be raised as needed.
+        mCapacityAllocator.first() = std::max(capacity(), other.size());
+        other.mCapacityAllocator.first() = std::max(other.capacity(), size());
+        auto& small = size() < other.size() ? *this : other;
+        auto& large = size() < other.size() ? other : *this;
+        std::swap_ranges(small.begin(), small.end(), large.begin());
+        std::uninitialized_move(large.begin() + small.size(), large.end(), small.end());
+        large.destroy(large.begin() + small.size(), large.end());
+        size_type const s = mSize;
+        mSize = other.mSize;
+        other.mSize = s;
+    }
+
     iterator assertCapacityForSize(size_type s) {
         if constexpr(CapacityCheck || FILAMENT_FORCE_CAPACITY_CHECK) {
             ASSERT_PRECONDITION(capacity() >= s,
@@ -415,6 +532,53 @@ private:
     compressed_pair<SizeTypeWrapper<size_type>, allocator_type> mCapacityAllocator{};
 };
 
+/**
+ * An allocator for FixedCapacityVector that holds storage for up to N elements inline;
+ * only larger capacities are served by the fallback allocator A, which must be stateless.
+ * Because the storage lives inside the allocator -- and therefore inside the vector --
+ * moving or swapping such a vector moves the elements individually instead of exchanging
+ * buffers. This is meant to be used through SmallCapacityVector, see below.
+ */
+template<typename T, size_t N, typename A = std::allocator<T>>
+class UTILS_PUBLIC SmallBufferAllocator {
+    static_assert(std::is_empty_v<A>, "the fallback allocator must be stateless");
+public:
+    using value_type = T;
+
+    SmallBufferAllocator() noexcept = default;
+
+    // the inline storage is raw memory managed by the vector, there is nothing to copy
+    SmallBufferAllocator(SmallBufferAllocator const&) noexcept {}
+    SmallBufferAllocator& operator=(SmallBufferAllocator const&) noexcept { return *this; }
+
+    T* allocate(size_t n) {
+        return n <= N ? reinterpret_cast<T*>(mStorage) : A{}.allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) {
+        if (!owns(p)) {
+            A{}.deallocate(p, n);
+        }
+    }
+
+    // whether p points to the inline storage. FixedCapacityVector uses the presence of
+    // this method to detect inline-storage allocators.
+    bool owns(T const* p) const noexcept {
+        return p == reinterpret_cast<T const*>(mStorage);
+    }
+
+private:
+    alignas(alignof(T)) char mStorage[N * sizeof(T)];
+};
+
+/**
+ * SmallCapacityVector is a FixedCapacityVector with inline storage for up to N elements;
+ * the heap is only involved for capacities larger than N. Useful for containers that live
+ * in render-loop code and almost always hold just a few elements.
+ */
+template<typename T, size_t N, typename A = std::allocator<T>, bool CapacityCheck = true>
+using SmallCapacityVector = FixedCapacityVector<T, SmallBufferAllocator<T, N, A>, CapacityCheck>;
+
 } // namespace utils
 
 #endif // TNT_UTILS_FIXEDCAPACITYVECTOR_H
@@ -21,7 +21,9 @@
 
 #include <atomic>
 #include <functional>
+#include <memory>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 #include <tsl/robin_map.h>
@@ -70,9 +72,10 @@ public:
         void* storage[JOB_STORAGE_SIZE_WORDS];                  // 48 | 48
         JobFunc function;                                       //  4 |  8
         uint16_t parent;                                        //  2 |  2
+        uint16_t successor;                                     //  2 |  2
         std::atomic<uint16_t> runningJobCount = { 1 };          //  2 |  2
         mutable std::atomic<uint16_t> refCount = { 1 };         //  2 |  2
-                                                                //  6 |  2 (padding)
+                                                                //  4 |  0 (padding)
                                                                 // 64 | 64
     };
 
@@ -252,6 +255,24 @@ public:
 
     void signal() noexcept;
 
+    /*
+     * Declares a dependency edge: `successor` becomes eligible to run only once `predecessor`
+     * and all its children have finished, at which point it is enqueued automatically by the
+     * worker that retired the last dependency. This allows expressing a whole frame as a job
+     * graph and joining only once at the end, instead of blocking on runAndWait() fences
+     * between phases.
+     *
+     * - all the edges into a successor must be declared before any of its predecessors is
+     *   run, otherwise the dependency count can transiently reach zero and release the
+     *   successor early.
+     * - the successor must NOT be run() by the caller; retain() it to wait on it.
+     * - a job has a single successor slot, but a successor can have any number of
+     *   predecessors (fan-in). Fan-out is expressed with edges from an empty proxy job's
+     *   children, or several proxy jobs.
+     * - a successor with pending dependencies must not be cancelled.
+     */
+    void runAfter(Job* predecessor, Job* successor) noexcept;
+
     /*
      * Add job to this thread's execution queue and keep a reference to it.
      * Current thread must be owned by JobSystem's thread pool. See adopt().
@@ -269,6 +290,12 @@ public:
      */
     void waitAndRelease(Job*& job) noexcept;
 
+    /*
+     * Returns whether the job and all its children have completed. The job must be kept
+     * alive with runAndRetain() or retain() for this to be safe to call.
+     */
+    bool hasJobCompleted(Job const* job) noexcept;
+
     /*
      * Runs and wait for a job. This is equivalent to calling
      *  runAndRetain(job);
@@ -301,12 +328,74 @@ public:
     static void setThreadPriority(Priority priority) noexcept;
     static void setThreadAffinityById(size_t id) noexcept;
 
+    /*
+     * Controls where the worker threads are pinned on heterogeneous (big.LITTLE) CPUs.
+     * The default pins one worker per core in core id order, which can land
+     * latency-critical jobs on efficiency cores. PERFORMANCE_CORES distributes the
+     * workers over the performance cores instead (a no-op on homogeneous CPUs, or when
+     * the topology can't be queried, see arch::getPerformanceCoreMask()). The policy can
+     * be changed at runtime; workers re-apply their affinity as they wake up.
+     */
+    enum class AffinityPolicy {
+        DEFAULT,            // one worker per core, in core id order
+        PERFORMANCE_CORES   // workers distributed over the performance cores
+    };
+
+    void setAffinityPolicy(AffinityPolicy policy) noexcept;
+
+    AffinityPolicy getAffinityPolicy() const noexcept {
+        return mAffinityPolicy.load(std::memory_order_relaxed);
+    }
+
     size_t getParallelSplitCount() const noexcept {
         return mParallelSplitCount;
     }
 
     size_t getThreadCount() const { return mThreadCount; }
 
+    // number of jobs currently queued or executing. This is an instantaneous, racy sample,
+    // only meant for monitoring (e.g. the performance HUD).
+    size_t getActiveJobCount() const noexcept {
+        return mActiveJobs.load(std::memory_order_relaxed);
+    }
+
+    /*
+     * Optional profiling, for tuning parallel sections.
+     *
+     * When enabled, each worker keeps track of how many jobs it ran, how its steal attempts
+     * fared, how often it parked, and a histogram of job latencies (the time between run()
+     * and the job starting to execute). Counters are only ever written by their own worker,
+     * so enabling profiling adds no contention; when disabled the cost is a single
+     * well-predicted branch per job.
+     */
+
+    struct WorkerProfile {
+        // bucket i counts jobs whose latency was in [2^i, 2^(i+1)) microseconds,
+        // the last bucket also counts everything above
+        static constexpr size_t LATENCY_BUCKET_COUNT = 16;
+        uint64_t jobsExecuted = 0;          // jobs this worker ran (popped or stolen)
+        uint64_t successfulSteals = 0;      // steal attempts that yielded a job
+        uint64_t failedSteals = 0;          // steal attempts on an empty queue
+        uint64_t parkedCount = 0;           // how many times this worker went to sleep
+        uint64_t wakeUpCount = 0;           // how many times it woke up (incl. spurious)
+        uint64_t latencyHistogram[LATENCY_BUCKET_COUNT] = {};
+    };
+
+    // enables or disables profiling; counters are reset when profiling is enabled
+    void setProfilingEnabled(bool enabled) noexcept;
+
+    bool isProfilingEnabled() const noexcept {
+        return mProfilingEnabled.load(std::memory_order_relaxed);
+    }
+
+    /*
+     * Returns a snapshot of each worker's counters accumulated since the last call (or since
+     * profiling was enabled) and resets them. Because the counters are written without
+     * synchronization by the workers, this is intended to be called at a frame boundary,
+     * while no jobs are in flight.
+     */
+    std::vector<WorkerProfile> getProfileAndReset() noexcept;
+
 private:
     // this is just to avoid using std::default_random_engine, since we're in a public header.
     class default_random_engine {
@@ -325,6 +414,10 @@ private:
         // make sure storage is cache-line aligned
         WorkQueue workQueue;
 
+        // written only by the owning worker, and only when profiling is enabled
+        alignas(CACHELINE_SIZE)
+        WorkerProfile profile;
+
         // these are not accessed by the worker threads
         alignas(CACHELINE_SIZE)     // this causes 56-bytes padding
         JobSystem* js;
@@ -343,14 +436,15 @@ private:
 
     Job* allocateJob() noexcept;
     JobSystem::ThreadState* getStateToStealFrom(JobSystem::ThreadState& state) noexcept;
-    bool hasJobCompleted(Job const* job) noexcept;
 
     void requestExit() noexcept;
     bool exitRequested() const noexcept;
     bool hasActiveJobs() const noexcept;
 
     void loop(ThreadState* state) noexcept;
+    void applyThreadAffinity(size_t id) noexcept;
     bool execute(JobSystem::ThreadState& state) noexcept;
+    void recordJobProfile(ThreadState& state, Job const* job) noexcept;
     Job* steal(JobSystem::ThreadState& state) noexcept;
     void finish(Job* job) noexcept;
 
@@ -381,7 +475,15 @@ private:
     alignas(16) // at least we align to half (or quarter) cache-line
     aligned_vector<ThreadState> mThreadStates;          // actual data is stored offline
     std::atomic<bool> mExitRequested = { false };       // this one is almost never written
+    std::atomic<bool> mProfilingEnabled = { false };    // this one is almost never written
+    std::atomic<AffinityPolicy> mAffinityPolicy = { AffinityPolicy::DEFAULT };
     std::atomic<uint16_t> mAdoptedThreads = { 0 };      // this one is almost never written
+    // per-job enqueue timestamps (ns), only allocated and maintained while profiling; writes
+    // are ordered with the reads by the work queue's own push/pop synchronization
+    std::unique_ptr<int64_t[]> mJobEnqueueTime;
+    // per-job count of pending dependency edges (see runAfter()); kept out of Job
+    // because there is no room left in its cache line on 64-bit architectures
+    std::unique_ptr<std::atomic<uint16_t>[]> mDependencyCounts;
     Job* const mJobStorageBase;                         // Base for conversion to indices
     uint16_t mThreadCount = 0;                          // total # of threads in the pool
     uint8_t mParallelSplitCount = 0;                    // # of split allowable in parallel_for
@@ -432,6 +534,15 @@ JobSystem::Job* createJob(JobSystem& js, JobSystem::Job* parent,
 
 namespace details {
 
+// detects splitters that need the range's start in addition to its size, which is
+// required for cost-based splitting (see jobs::CostSplitter below).
+template<typename S, typename = void>
+struct is_range_splitter : std::false_type {};
+
+template<typename S>
+struct is_range_splitter<S, std::void_t<decltype(
+        std::declval<S const&>().split(size_t(0), size_t(0), size_t(0)))>> : std::true_type {};
+
 template<typename S, typename F>
 struct ParallelForJobData {
     using SplitterType = S;
@@ -453,7 +564,7 @@ struct ParallelForJobData {
 
         // this branch is often miss-predicted (it both sides happen 50% of the calls)
 right_side:
-        if (splitter.split(splits, count)) {
+        if (shouldSplit()) {
             const size_type lc = count / 2;
             JobData ld(start, lc, splits + uint8_t(1), functor, splitter);
             JobSystem::Job* l = js.createJob<JobData, &JobData::parallelWithJobs>(parent, std::move(ld));
@@ -481,6 +592,14 @@ execute:
     }
 
 private:
+    bool shouldSplit() const noexcept {
+        if constexpr (is_range_splitter<SplitterType>::value) {
+            return splitter.split(splits, start, count);
+        } else {
+            return splitter.split(splits, count);
+        }
+    }
+
     size_type start;            // 4
     size_type count;            // 4
     Functor functor;            // ?
@@ -528,6 +647,50 @@ public:
     }
 };
 
+/*
+ * A splitter that drives parallel_for with a per-item cost hint instead of a plain item
+ * count, for workloads where the cost per item varies wildly (the work-stealing scheduler
+ * can only back-fill a straggler if the expensive items don't all end up in one job).
+ *
+ * The caller supplies the inclusive prefix-sum of the per-item costs, so the cost of any
+ * sub-range is evaluated in O(1), and a target cost per job; a range keeps splitting
+ * while it holds at least two jobs' worth of work. Use cost_splitter() below to derive
+ * the target from the JobSystem's parallelism.
+ */
+template <size_t MAX_SPLITS = 12>
+class CostSplitter {
+public:
+    // costPrefixSum[i] must be the total cost of items [0, i]
+    CostSplitter(uint32_t const* costPrefixSum, uint32_t targetCost) noexcept
+            : mCostPrefixSum(costPrefixSum),
+              mTargetCost(targetCost > 0 ? targetCost : 1) {
+    }
+
+    bool split(size_t splits, size_t start, size_t count) const noexcept {
+        if (splits >= MAX_SPLITS || count < 2) {
+            return false;
+        }
+        uint32_t const below = start ? mCostPrefixSum[start - 1] : 0;
+        uint32_t const cost = mCostPrefixSum[start + count - 1] - below;
+        return cost >= mTargetCost * 2;
+    }
+
+private:
+    uint32_t const* mCostPrefixSum;
+    uint32_t mTargetCost;
+};
+
+// Builds a CostSplitter with a target cost derived from the JobSystem's parallelism.
+// We aim for several jobs per hardware thread, which leaves the work-stealing queues
+// enough slack to absorb imbalance without drowning in per-job overhead.
+template <size_t MAX_SPLITS = 12>
+CostSplitter<MAX_SPLITS> cost_splitter(JobSystem& js,
+        uint32_t const* costPrefixSum, uint32_t count) noexcept {
+    uint32_t const totalCost = count ? costPrefixSum[count - 1] : 0;
+    uint32_t const targetCost = totalCost / uint32_t(js.getThreadCount() * 4u + 1u);
+    return CostSplitter<MAX_SPLITS>(costPrefixSum, targetCost);
+}
+
 } // namespace jobs
 } // namespace utils
 
@@ -115,7 +115,7 @@ class QuadTreeArray : public std::array<T, QuadTreeUtils::size(HEIGHT)> {
     };
 
 public:
-    using code_t = uint8_t;
+    using code_t = uint16_t;
 
     struct NodeId {
         int8_t l;       // height of the node or -1 if invalid
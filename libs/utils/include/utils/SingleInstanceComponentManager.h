@@ -116,6 +116,15 @@ public:
         return elementAt<ENTITY_INDEX>(i);
     }
 
+    // Pre-allocates storage for the given total number of components, so that a subsequent
+    // batch of addComponent() calls performs at most one array grow and no map rehash.
+    // This invalidates all pointers components.
+    void reserve(size_t capacity) {
+        // +1 for the reserved dummy component at index 0
+        mData.ensureCapacity(capacity + 1);
+        mInstanceMap.reserve(capacity);
+    }
+
     // Add a component to the given Entity. If the entity already has a component from this
     // manager, this function is a no-op.
     // This invalidates all pointers components.
@@ -18,6 +18,7 @@
 #define TNT_UTILS_STRUCTUREOFARRAYS_H
 
 #include <utils/Allocator.h>
+#include <utils/architecture.h>
 #include <utils/compiler.h>
 #include <utils/Slice.h>
 
@@ -273,7 +274,7 @@ public:
         // capacity cannot change when optional storage is specified
         if (capacity >= mSize) {
             // TODO: not entirely sure if "max" of all alignments is always correct
-            constexpr size_t align = std::max({ std::max(alignof(std::max_align_t), alignof(Elements))... });
+            constexpr size_t align = std::max({ std::max(CACHELINE_SIZE, alignof(Elements))... });
             const size_t sizeNeeded = getNeededSize(capacity);
             void* buffer = mAllocator.alloc(sizeNeeded, align);
             auto const oldBuffer = std::get<0>(mArrays);
@@ -411,6 +412,35 @@ public:
         });
     }
 
+    // Number of bytes of each row touched when the given group of columns is streamed
+    // together. Useful to static_assert that a hot loop's per-element working set stays
+    // within a few cache lines.
+    template<size_t ... Group>
+    static constexpr size_t getGroupRowSize() noexcept {
+        return (sizeof(TypeAt<Group>) + ... + 0);
+    }
+
+    // Calls f(index, fields...) for each index in [first, last), where fields are references
+    // into the declared group of columns. Each column of the group is software-prefetched a
+    // few rows ahead of the loop; hardware prefetchers typically track only a handful of
+    // streams, which is what makes wide rows memory-latency bound. Because the body only
+    // receives the columns it declared, the group cannot silently get out of sync with the
+    // accesses.
+    template<size_t ... Group, typename F>
+    void forEachGroup(size_t first, size_t last, F&& f) noexcept {
+        // far enough ahead to cover the latency of a miss, close enough to stay resident
+        constexpr size_t kPrefetchRows = 8;
+        size_t const split = (last - first > kPrefetchRows) ? last - kPrefetchRows : first;
+        size_t i = first;
+        for (; i < split; i++) {
+            ([&]{ UTILS_PREFETCH(std::get<Group>(mArrays) + i + kPrefetchRows); }(), ...);
+            f(i, elementAt<Group>(i)...);
+        }
+        for (; i < last; i++) {
+            f(i, elementAt<Group>(i)...);
+        }
+    }
+
     // return a pointer to the first element of the ElementIndex]th array
     template<size_t ElementIndex>
     TypeAt<ElementIndex>* data() noexcept {
@@ -577,8 +607,9 @@ private:
         // compute the required size of each array
         const size_t sizes[] = { (sizeof(Elements) * capacity)... };
 
-        // we align each array to at least the same alignment guaranteed by malloc
-        constexpr size_t const alignments[] = { std::max(alignof(std::max_align_t), alignof(Elements))... };
+        // we align each array to a cache line, so that two arrays never share one and the
+        // streaming access pattern of one column can't evict partial lines of another
+        constexpr size_t const alignments[] = { std::max(CACHELINE_SIZE, alignof(Elements))... };
 
         // hopefully most of this gets unrolled and inlined
         std::array<size_t, kArrayCount> offsets;
@@ -41,6 +41,10 @@
 #include <utils/android/Systrace.h>
 #elif defined(__APPLE__) && FILAMENT_APPLE_SYSTRACE
 #include <utils/darwin/Systrace.h>
+#elif (defined(__linux__) || defined(WIN32)) && !defined(__EMSCRIPTEN__)
+// Desktop platforms have no native trace sink; record spans ourselves and dump them
+// in chrome://tracing JSON format on demand (see SYSTRACE_DUMP).
+#include <utils/generic/Systrace.h>
 #else
 
 #define SYSTRACE_ENABLE()
@@ -58,4 +62,10 @@
 
 #endif // ANDROID
 
+// Only the generic recorder buffers events, platforms with a native sink (ATrace,
+// os_signpost) have nothing to dump.
+#ifndef SYSTRACE_DUMP
+#define SYSTRACE_DUMP(path) ((void)(path), false)
+#endif
+
 #endif // TNT_UTILS_SYSTRACE_H
@@ -19,12 +19,18 @@
 
 #include <thread>
 
+#include <stdint.h>
+
 namespace utils {
 
 class ThreadUtils {
 public:
     static std::thread::id getThreadId() noexcept;
     static bool isThisThread(std::thread::id id) noexcept;
+
+    // restricts the calling thread to the cores set in coreMask (bit i = core i);
+    // a no-op if the mask is empty or on OSes without thread affinity support
+    static void setThisThreadAffinity(uint64_t coreMask) noexcept;
 };
 
 } // namespace utils
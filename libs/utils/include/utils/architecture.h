@@ -18,6 +18,7 @@
 #define TNT_UTILS_ARCHITECTURE_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 namespace utils {
 
@@ -27,6 +28,15 @@ namespace arch {
 
 size_t getPageSize() noexcept;
 
+/*
+ * Core topology of heterogeneous (e.g. big.LITTLE) CPUs. Cores are classified by
+ * comparing their maximum frequency; bit i of a mask is set if core i belongs to that
+ * group. Both masks are 0 on homogeneous CPUs, or when the topology can't be queried
+ * (only the first 64 cores are considered).
+ */
+uint64_t getPerformanceCoreMask() noexcept;
+uint64_t getEfficiencyCoreMask() noexcept;
+
 } // namespace arch
 } // namespace utils
 
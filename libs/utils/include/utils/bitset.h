@@ -34,6 +34,9 @@
 #       include <arm_neon.h>
 #       define TNT_UTILS_BITSET_USE_NEON 1
 #   endif
+#elif defined(__SSE2__)
+#   include <emmintrin.h>
+#   define TNT_UTILS_BITSET_USE_SSE2 1
 #endif
 
 namespace utils {
@@ -85,9 +88,9 @@ public:
         for (size_t i = 0; i < N; i++) {
             T v = storage[i];
             while (v) {
-                T k = utils::ctz(v);
-                v &= ~(T(1) << k);
-                exec(size_t(k + BITS_PER_WORD * i));
+                exec(size_t(utils::ctz(v) + BITS_PER_WORD * i));
+                // clear the lowest set bit, a single instruction (blsr) on x86
+                v &= v - T(1);
             }
         }
     }
@@ -160,6 +163,16 @@ public:
             }
             return bool(r[0] | r[1]);
         } else
+#elif defined(TNT_UTILS_BITSET_USE_SSE2)
+        if (BIT_COUNT % 128 == 0) {
+            // storage is only aligned to alignof(T), so use unaligned loads
+            __m128i const* const p = (__m128i const*) storage;
+            __m128i r = _mm_loadu_si128(p);
+            for (size_t i = 1; i < BIT_COUNT / 128; ++i) {
+                r = _mm_or_si128(r, _mm_loadu_si128(p + i));
+            }
+            return _mm_movemask_epi8(_mm_cmpeq_epi8(r, _mm_setzero_si128())) != 0xffff;
+        } else
 #endif
         {
             T r = storage[0];
@@ -184,6 +197,15 @@ public:
             }
             return T(~(r[0] & r[1])) == T(0);
         } else
+#elif defined(TNT_UTILS_BITSET_USE_SSE2)
+        if (BIT_COUNT % 128 == 0) {
+            __m128i const* const p = (__m128i const*) storage;
+            __m128i r = _mm_loadu_si128(p);
+            for (size_t i = 1; i < BIT_COUNT / 128; ++i) {
+                r = _mm_and_si128(r, _mm_loadu_si128(p + i));
+            }
+            return _mm_movemask_epi8(_mm_cmpeq_epi8(r, _mm_set1_epi8(-1))) == 0xffff;
+        } else
 #endif
         {
             T r = storage[0];
@@ -205,6 +227,17 @@ public:
             }
             return bool(r[0] | r[1]);
         } else
+#elif defined(TNT_UTILS_BITSET_USE_SSE2)
+        if (BIT_COUNT % 128 == 0) {
+            __m128i const* const p = (__m128i const*) storage;
+            __m128i const* const q = (__m128i const*) b.storage;
+            __m128i r = _mm_xor_si128(_mm_loadu_si128(p), _mm_loadu_si128(q));
+            for (size_t i = 1; i < BIT_COUNT / 128; ++i) {
+                r = _mm_or_si128(r,
+                        _mm_xor_si128(_mm_loadu_si128(p + i), _mm_loadu_si128(q + i)));
+            }
+            return _mm_movemask_epi8(_mm_cmpeq_epi8(r, _mm_setzero_si128())) != 0xffff;
+        } else
 #endif
         {
             T r = storage[0] ^ b.storage[0];
@@ -228,6 +261,15 @@ public:
                 p[i] &= q[i];
             }
         } else
+#elif defined(TNT_UTILS_BITSET_USE_SSE2)
+        if (BIT_COUNT % 128 == 0) {
+            __m128i* const p = (__m128i*) storage;
+            __m128i const* const q = (__m128i const*) b.storage;
+            for (size_t i = 0; i < BIT_COUNT / 128; ++i) {
+                _mm_storeu_si128(p + i,
+                        _mm_and_si128(_mm_loadu_si128(p + i), _mm_loadu_si128(q + i)));
+            }
+        } else
 #endif
         {
             for (size_t i = 0; i < N; ++i) {
@@ -246,6 +288,15 @@ public:
                 p[i] |= q[i];
             }
         } else
+#elif defined(TNT_UTILS_BITSET_USE_SSE2)
+        if (BIT_COUNT % 128 == 0) {
+            __m128i* const p = (__m128i*) storage;
+            __m128i const* const q = (__m128i const*) b.storage;
+            for (size_t i = 0; i < BIT_COUNT / 128; ++i) {
+                _mm_storeu_si128(p + i,
+                        _mm_or_si128(_mm_loadu_si128(p + i), _mm_loadu_si128(q + i)));
+            }
+        } else
 #endif
         {
             for (size_t i = 0; i < N; ++i) {
@@ -264,6 +315,15 @@ public:
                 p[i] ^= q[i];
             }
         } else
+#elif defined(TNT_UTILS_BITSET_USE_SSE2)
+        if (BIT_COUNT % 128 == 0) {
+            __m128i* const p = (__m128i*) storage;
+            __m128i const* const q = (__m128i const*) b.storage;
+            for (size_t i = 0; i < BIT_COUNT / 128; ++i) {
+                _mm_storeu_si128(p + i,
+                        _mm_xor_si128(_mm_loadu_si128(p + i), _mm_loadu_si128(q + i)));
+            }
+        } else
 #endif
         {
             for (size_t i = 0; i < N; ++i) {
@@ -283,6 +343,15 @@ public:
                 p[i] = ~q[i];
             }
         } else
+#elif defined(TNT_UTILS_BITSET_USE_SSE2)
+        if (BIT_COUNT % 128 == 0) {
+            __m128i* const p = (__m128i*) r.storage;
+            __m128i const* const q = (__m128i const*) storage;
+            for (size_t i = 0; i < BIT_COUNT / 128; ++i) {
+                _mm_storeu_si128(p + i,
+                        _mm_xor_si128(_mm_loadu_si128(q + i), _mm_set1_epi8(-1)));
+            }
+        } else
 #endif
         {
             for (size_t i = 0; i < N; ++i) {
@@ -16,6 +16,7 @@
 
 #include <utils/Allocator.h>
 
+#include <utils/architecture.h>
 #include <utils/Log.h>
 
 #include <algorithm>
@@ -24,6 +25,12 @@
 #include <assert.h>
 #include <string.h>
 
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+#   include <sys/mman.h>
+#elif defined(WIN32)
+#   include <windows.h>
+#endif
+
 namespace utils {
 
 // ------------------------------------------------------------------------------------------------
@@ -50,6 +57,7 @@ void LinearAllocator::swap(LinearAllocator& rhs) noexcept {
     std::swap(mBegin, rhs.mBegin);
     std::swap(mSize, rhs.mSize);
     std::swap(mCur, rhs.mCur);
+    std::swap(mWatermark, rhs.mWatermark);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -92,6 +100,34 @@ FreeList::FreeList(void* begin, void* end,
 {
 }
 
+void FreeList::extend(void* begin, void* end,
+        size_t elementSize, size_t alignment, size_t extra) noexcept
+{
+    Node* const head = init(begin, end, elementSize, alignment, extra);
+    // find the tail of the new chain and splice the current list after it
+    Node* tail = head;
+    while (tail->next) {
+        tail = tail->next;
+    }
+    tail->next = mHead;
+    mHead = head;
+#ifndef NDEBUG
+    // the bounds become the convex hull of all ranges ever added
+    mBegin = std::min(mBegin, begin);
+    mEnd = std::max(mEnd, end);
+#endif
+}
+
+void FreeList::reset(void* begin, void* end,
+        size_t elementSize, size_t alignment, size_t extra) noexcept
+{
+    mHead = init(begin, end, elementSize, alignment, extra);
+#ifndef NDEBUG
+    mBegin = begin;
+    mEnd = end;
+#endif
+}
+
 AtomicFreeList::AtomicFreeList(void* begin, void* end,
         size_t elementSize, size_t alignment, size_t extra) noexcept
 {
@@ -126,6 +162,128 @@ AtomicFreeList::AtomicFreeList(void* begin, void* end,
     mHead.store({ int32_t(head - mStorage), 0 });
 }
 
+void AtomicFreeList::extend(void* begin, void* end,
+        size_t elementSize, size_t alignment, size_t extra) noexcept
+{
+    void* const p = pointermath::align(begin, alignment, extra);
+    void* const n = pointermath::align(pointermath::add(p, elementSize), alignment, extra);
+    assert(p >= begin && p < end);
+    assert(n >= begin && n < end && n > p);
+
+    const size_t d = uintptr_t(n) - uintptr_t(p);
+    const size_t num = (uintptr_t(end) - uintptr_t(p)) / d;
+
+    // build the new chain; these nodes are not yet visible to other threads
+    Node* const head = static_cast<Node*>(p);
+    assert(mStorage && head > mStorage);
+
+    Node* tail = head;
+    for (size_t i = 1; i < num; ++i) {
+        Node* next = pointermath::add(tail, d);
+        tail->next.store(next, std::memory_order_relaxed);
+        tail = next;
+    }
+    assert(tail < end);
+    assert(pointermath::add(tail, d) <= end);
+
+    // splice the current list after the new chain
+    Node* const storage = mStorage;
+    HeadPtr currentHead = mHead.load();
+    HeadPtr newHead = { int32_t(head - storage), currentHead.tag + 1 };
+    do {
+        newHead.tag = currentHead.tag + 1;
+        Node* const next = (currentHead.offset >= 0) ? (storage + currentHead.offset) : nullptr;
+        tail->next.store(next, std::memory_order_relaxed);
+    } while (!mHead.compare_exchange_weak(currentHead, newHead));
+}
+
+void AtomicFreeList::reset(void* begin, void* end,
+        size_t elementSize, size_t alignment, size_t extra) noexcept
+{
+    void* const p = pointermath::align(begin, alignment, extra);
+    void* const n = pointermath::align(pointermath::add(p, elementSize), alignment, extra);
+    assert(p >= begin && p < end);
+    assert(n >= begin && n < end && n > p);
+
+    const size_t d = uintptr_t(n) - uintptr_t(p);
+    const size_t num = (uintptr_t(end) - uintptr_t(p)) / d;
+
+    // rebuild the whole chain; this must not race with pop()/push() (see the header)
+    Node* const head = static_cast<Node*>(p);
+    mStorage = head;
+
+    Node* cur = head;
+    for (size_t i = 1; i < num; ++i) {
+        Node* next = pointermath::add(cur, d);
+        cur->next.store(next, std::memory_order_relaxed);
+        cur = next;
+    }
+    assert(cur < end);
+    assert(pointermath::add(cur, d) <= end);
+    cur->next.store(nullptr, std::memory_order_relaxed);
+
+    // bump the tag so a stale pop() can't succeed against the rebuilt list
+    HeadPtr const currentHead = mHead.load();
+    mHead.store({ int32_t(head - mStorage), currentHead.tag + 1 });
+}
+
+// ------------------------------------------------------------------------------------------------
+// VirtualArea
+// ------------------------------------------------------------------------------------------------
+
+AreaPolicy::VirtualArea::VirtualArea(size_t size) {
+    if (size) {
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+        void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        mBegin = (p == MAP_FAILED) ? nullptr : p;
+#elif defined(WIN32)
+        mBegin = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+        mBegin = malloc(size);
+#endif
+        if (mBegin) {
+            mEnd = pointermath::add(mBegin, size);
+        }
+    }
+}
+
+AreaPolicy::VirtualArea::~VirtualArea() noexcept {
+    if (mBegin) {
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+        munmap(mBegin, size());
+#elif defined(WIN32)
+        VirtualFree(mBegin, 0, MEM_RELEASE);
+#else
+        free(mBegin);
+#endif
+    }
+}
+
+void AreaPolicy::VirtualArea::releaseUnusedPages(void* const highWatermark) noexcept {
+    assert(highWatermark >= mBegin && highWatermark <= mEnd);
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+    size_t const pageMask = arch::getPageSize() - 1;
+    size_t const used = (uintptr_t(highWatermark) - uintptr_t(mBegin) + pageMask) & ~pageMask;
+
+    // pages touched since the last call can extend past our decayed commit watermark
+    size_t const committed = std::max(mCommittedSize, used);
+
+    // release a quarter of the unused pages per call (typically one call per frame), so
+    // a transient spike decays over a few frames instead of holding its peak forever
+    size_t const release = ((committed - used) / 4 + pageMask) & ~pageMask;
+    if (release && release <= committed - used) {
+        madvise(pointermath::add(mBegin, committed - release), release, MADV_DONTNEED);
+        mCommittedSize = committed - release;
+    } else {
+        mCommittedSize = committed;
+    }
+#else
+    // pages can't be released on this OS
+    (void)highWatermark;
+#endif
+}
+
 // ------------------------------------------------------------------------------------------------
 
 void TrackingPolicy::HighWatermark::onAlloc(
@@ -49,6 +49,14 @@ void EntityManager::destroy(size_t n, Entity* entities) noexcept {
     static_cast<EntityManagerImpl *>(this)->destroy(n, entities);
 }
 
+void EntityManager::destroyDeferred(size_t n, Entity const* entities) noexcept {
+    static_cast<EntityManagerImpl *>(this)->destroyDeferred(n, entities);
+}
+
+void EntityManager::flushDeferredDestroys() noexcept {
+    static_cast<EntityManagerImpl *>(this)->flushDeferredDestroys();
+}
+
 void EntityManager::registerListener(EntityManager::Listener* l) noexcept {
     static_cast<EntityManagerImpl *>(this)->registerListener(l);
 }
@@ -47,6 +47,7 @@ public:
     using EntityManager::makeIdentity;
     using EntityManager::create;
     using EntityManager::destroy;
+    using EntityManager::destroyDeferred;
 
     UTILS_NOINLINE
     size_t getEntityCount() const noexcept {
@@ -139,6 +140,61 @@ public:
         }
     }
 
+    UTILS_NOINLINE
+    void destroyDeferred(size_t n, Entity const* entities) noexcept {
+        uint8_t* const gens = mGens;
+
+        std::lock_guard<Mutex> const lock(mDeferredLock);
+        mDeferredDestroys.reserve(mDeferredDestroys.size() + n);
+        for (size_t i = 0; i < n; i++) {
+            if (!entities[i]) {
+                // behave like free(), ok to free null Entity.
+                continue;
+            }
+
+            // it's an error to delete an Entity twice...
+            assert(isAlive(entities[i]));
+
+            if (isAlive(entities[i])) {
+                // Bumping the generation kills the entity immediately, so stale handles are
+                // safe; the index is recycled later, in flushDeferredDestroys(). This doesn't
+                // require the free-list lock because the index can't be reused until then.
+                gens[getIndex(entities[i])]++;
+                mDeferredDestroys.push_back(entities[i]);
+
+#if FILAMENT_UTILS_TRACK_ENTITIES
+                mDebugActiveEntities.erase(entities[i]);
+#endif
+            }
+        }
+    }
+
+    UTILS_NOINLINE
+    void flushDeferredDestroys() noexcept {
+        std::vector<Entity> deferred;
+        {
+            std::lock_guard<Mutex> const lock(mDeferredLock);
+            deferred.swap(mDeferredDestroys);
+        }
+        if (deferred.empty()) {
+            return;
+        }
+
+        // recycle all the queued indices in one batch
+        {
+            std::lock_guard<Mutex> const lock(mFreeListLock);
+            for (Entity const e : deferred) {
+                mFreeList.push_back(getIndex(e));
+            }
+        }
+
+        // notify our listeners that some entities have been destroyed
+        auto listeners = getListeners();
+        for (auto const& l : listeners) {
+            l->onEntitiesDestroyed(deferred.size(), deferred.data());
+        }
+    }
+
     void registerListener(EntityManager::Listener* l) noexcept {
         std::lock_guard<Mutex> const lock(mListenerLock);
         mListeners.insert(l);
@@ -184,6 +240,10 @@ private:
     mutable Mutex mFreeListLock;
     std::deque<Entity::Type> mFreeList;
 
+    // stores entities queued by destroyDeferred()
+    mutable Mutex mDeferredLock;
+    std::vector<Entity> mDeferredDestroys;
+
     mutable Mutex mListenerLock;
     tsl::robin_set<Listener*> mListeners;
 
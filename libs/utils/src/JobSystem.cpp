@@ -28,12 +28,16 @@ static constexpr bool DEBUG_FINISH_HANGS = false;
 
 #include <utils/JobSystem.h>
 
+#include <utils/algorithm.h>
 #include <utils/compiler.h>
 #include <utils/Log.h>
 #include <utils/memalign.h>
 #include <utils/Panic.h>
 #include <utils/Systrace.h>
+#include <utils/ThreadUtils.h>
 
+#include <algorithm>
+#include <chrono>
 #include <random>
 
 #include <math.h>
@@ -159,6 +163,9 @@ JobSystem::JobSystem(const size_t userThreadCount, const size_t adoptableThreads
     // and also limit the pool to 32 threads
     threadPoolCount = std::min(UTILS_HAS_THREADING ? 32 : 0, threadPoolCount);
 
+    // zero-initialized, each counter must return to zero when its job's dependencies retire
+    mDependencyCounts = std::make_unique<std::atomic<uint16_t>[]>(MAX_JOB_COUNT);
+
     mThreadStates = aligned_vector<ThreadState>(threadPoolCount + adoptableThreadsCount);
     mThreadCount = uint16_t(threadPoolCount);
     mParallelSplitCount = (uint8_t)std::ceil((std::log2f(threadPoolCount + adoptableThreadsCount)));
@@ -308,6 +315,11 @@ void JobSystem::put(WorkQueue& workQueue, Job* job) noexcept {
     size_t index = job - mJobStorageBase;
     assert(index >= 0 && index < MAX_JOB_COUNT);
 
+    if (UTILS_UNLIKELY(isProfilingEnabled())) {
+        // the push() below orders this write with the read on the executing thread
+        mJobEnqueueTime[index] = std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+
     // put the job into the queue first
     workQueue.push(uint16_t(index + 1));
     // then increase our active job count
@@ -391,6 +403,13 @@ JobSystem::Job* JobSystem::steal(JobSystem::ThreadState& state) noexcept {
         ThreadState* const stateToStealFrom = getStateToStealFrom(state);
         if (UTILS_LIKELY(stateToStealFrom)) {
             job = steal(stateToStealFrom->workQueue);
+            if (UTILS_UNLIKELY(isProfilingEnabled())) {
+                if (job) {
+                    state.profile.successfulSteals++;
+                } else {
+                    state.profile.failedSteals++;
+                }
+            }
         }
         // nullptr -> nothing to steal in that queue either, if there are active jobs,
         // continue to try stealing one.
@@ -410,6 +429,10 @@ bool JobSystem::execute(JobSystem::ThreadState& state) noexcept {
     if (job) {
         assert(job->runningJobCount.load(std::memory_order_relaxed) >= 1);
 
+        if (UTILS_UNLIKELY(isProfilingEnabled())) {
+            recordJobProfile(state, job);
+        }
+
         if (UTILS_LIKELY(job->function)) {
             HEAVY_SYSTRACE_NAME("job->function");
             job->function(job->storage, *this, job);
@@ -419,13 +442,46 @@ bool JobSystem::execute(JobSystem::ThreadState& state) noexcept {
     return job != nullptr;
 }
 
+UTILS_NOINLINE
+void JobSystem::recordJobProfile(ThreadState& state, Job const* job) noexcept {
+    int64_t const now = std::chrono::steady_clock::now().time_since_epoch().count();
+    size_t const index = job - mJobStorageBase;
+    // jobs queued before profiling was enabled read the enable timestamp instead (see
+    // setProfilingEnabled()), which folds them into the small buckets
+    uint64_t const latencyUs =
+            uint64_t(std::max(now - mJobEnqueueTime[index], int64_t(0))) / 1000u;
+    size_t bucket = 0;
+    while ((latencyUs >> (bucket + 1)) && bucket < WorkerProfile::LATENCY_BUCKET_COUNT - 1) {
+        bucket++;
+    }
+    WorkerProfile& profile = state.profile;
+    profile.jobsExecuted++;
+    profile.latencyHistogram[bucket]++;
+}
+
+void JobSystem::applyThreadAffinity(size_t id) noexcept {
+    if (UTILS_UNLIKELY(getAffinityPolicy() == AffinityPolicy::PERFORMANCE_CORES)) {
+        uint64_t const mask = arch::getPerformanceCoreMask();
+        if (mask) {
+            // distribute the workers over the performance cores, round-robin
+            uint64_t m = mask;
+            for (size_t n = id % size_t(popcount(mask)); n; n--) {
+                m &= m - 1u; // clear the lowest set bit
+            }
+            ThreadUtils::setThisThreadAffinity(uint64_t(1) << ctz(m));
+            return;
+        }
+    }
+    setThreadAffinityById(id);
+}
+
 void JobSystem::loop(ThreadState* state) noexcept {
     setThreadName("JobSystem::loop");
     setThreadPriority(Priority::DISPLAY);
 
     // set a CPU affinity on each of our JobSystem thread to prevent them from jumping from core
     // to core. On Android, it looks like the affinity needs to be reset from time to time.
-    setThreadAffinityById(state->id);
+    applyThreadAffinity(state->id);
 
     // record our work queue
     mThreadMapLock.lock();
@@ -438,8 +494,14 @@ void JobSystem::loop(ThreadState* state) noexcept {
         if (!execute(*state)) {
             std::unique_lock<Mutex> lock(mWaiterLock);
             while (!exitRequested() && !hasActiveJobs()) {
+                if (UTILS_UNLIKELY(isProfilingEnabled())) {
+                    state->profile.parkedCount++;
+                }
                 wait(lock);
-                setThreadAffinityById(state->id);
+                if (UTILS_UNLIKELY(isProfilingEnabled())) {
+                    state->profile.wakeUpCount++;
+                }
+                applyThreadAffinity(state->id);
             }
         }
     } while (!exitRequested());
@@ -462,7 +524,19 @@ void JobSystem::finish(Job* job) noexcept {
             // no more work, destroy this job and notify its parent
             notify = true;
             Job* const parent = job->parent == 0x7FFF ? nullptr : &storage[job->parent];
+            uint16_t const successor = job->successor;
             decRef(job);
+            if (UTILS_UNLIKELY(successor != 0x7FFF)) {
+                // we were a dependency of a successor job; if we're the last one to
+                // retire, release it to the ready queue. memory_order_acq_rel makes our
+                // writes visible to the successor even if it's stolen immediately.
+                auto dependencies = mDependencyCounts[successor].fetch_sub(1,
+                        std::memory_order_acq_rel);
+                assert(dependencies > 0);
+                if (dependencies == 1) {
+                    run(&storage[successor]);
+                }
+            }
             job = parent;
         } else {
             // there is still work (e.g.: children), we're done.
@@ -499,6 +573,7 @@ JobSystem::Job* JobSystem::create(JobSystem::Job* parent, JobFunc func) noexcept
         }
         job->function = func;
         job->parent = uint16_t(index);
+        job->successor = 0x7FFF;
     }
     return job;
 }
@@ -534,6 +609,22 @@ void JobSystem::run(Job*& job) noexcept {
     job = nullptr;
 }
 
+void JobSystem::runAfter(Job* predecessor, Job* successor) noexcept {
+    assert(predecessor);
+    assert(successor);
+
+    // a job only has a single successor slot
+    assert(predecessor->successor == 0x7FFF);
+
+    size_t index = successor - mJobStorageBase;
+    assert(index < MAX_JOB_COUNT);
+
+    // account for the new incoming edge. memory_order_relaxed is safe because the
+    // predecessor hasn't been run yet, so this can't race with the decrement in finish().
+    mDependencyCounts[index].fetch_add(1, std::memory_order_relaxed);
+    predecessor->successor = uint16_t(index);
+}
+
 JobSystem::Job* JobSystem::runAndRetain(Job* job) noexcept {
     JobSystem::Job* retained = retain(job);
     run(job);
@@ -582,6 +673,44 @@ void JobSystem::runAndWait(JobSystem::Job*& job) noexcept {
     waitAndRelease(job);
 }
 
+void JobSystem::setAffinityPolicy(AffinityPolicy const policy) noexcept {
+    mAffinityPolicy.store(policy, std::memory_order_relaxed);
+    // wake everyone up, so parked workers re-apply their affinity promptly; busy
+    // workers pick the new policy up the next time they wake from a park.
+    wakeAll();
+}
+
+void JobSystem::setProfilingEnabled(bool const enabled) noexcept {
+    if (enabled == isProfilingEnabled()) {
+        return;
+    }
+    if (enabled) {
+        if (!mJobEnqueueTime) {
+            mJobEnqueueTime = std::make_unique<int64_t[]>(MAX_JOB_COUNT);
+        }
+        // jobs already in flight have no enqueue timestamp; use the enable time so they
+        // don't pollute the latency histogram
+        int64_t const now = std::chrono::steady_clock::now().time_since_epoch().count();
+        std::fill_n(mJobEnqueueTime.get(), MAX_JOB_COUNT, now);
+        for (auto& state : mThreadStates) {
+            state.profile = {};
+        }
+    }
+    // this is not meant to be toggled while jobs are in flight (e.g. mJobEnqueueTime above
+    // is not synchronized with the workers), call it at a frame boundary.
+    mProfilingEnabled.store(enabled, std::memory_order_release);
+}
+
+std::vector<JobSystem::WorkerProfile> JobSystem::getProfileAndReset() noexcept {
+    std::vector<WorkerProfile> profiles;
+    profiles.reserve(mThreadStates.size());
+    for (auto& state : mThreadStates) {
+        profiles.push_back(state.profile);
+        state.profile = {};
+    }
+    return profiles;
+}
+
 void JobSystem::adopt() {
     const auto tid = std::this_thread::get_id();
 
@@ -18,6 +18,10 @@
 
 #include <utils/compiler.h>
 
+#if defined(__linux__)
+#   include <sched.h>
+#endif
+
 namespace utils {
 
 UTILS_NOINLINE
@@ -29,4 +33,21 @@ bool ThreadUtils::isThisThread(std::thread::id id) noexcept {
     return getThreadId() == id;
 }
 
+void ThreadUtils::setThisThreadAffinity(uint64_t coreMask) noexcept {
+#if defined(__linux__)
+    if (coreMask) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (size_t i = 0; i < 64; i++) {
+            if (coreMask & (uint64_t(1) << i)) {
+                CPU_SET(i, &set);
+            }
+        }
+        sched_setaffinity(0, sizeof(set), &set);
+    }
+#else
+    (void)coreMask;
+#endif
+}
+
 } // namespace utils
@@ -22,6 +22,11 @@
 #   include <windows.h>
 #endif
 
+#if defined(__linux__)
+#   include <algorithm>
+#   include <stdio.h>
+#endif
+
 namespace utils::arch {
 
 size_t getPageSize() noexcept {
@@ -36,4 +41,64 @@ size_t getPageSize() noexcept {
 #endif
 }
 
+#if defined(__linux__)
+static void computeCoreMasks(uint64_t& performance, uint64_t& efficiency) noexcept {
+    performance = 0;
+    efficiency = 0;
+
+    long const coreCount = sysconf(_SC_NPROCESSORS_CONF);
+    size_t const n = std::min(coreCount < 0 ? size_t(0) : size_t(coreCount), size_t(64));
+
+    uint64_t freqs[64] = {};
+    uint64_t maxFreq = 0;
+    for (size_t i = 0; i < n; i++) {
+        char path[80];
+        snprintf(path, sizeof(path),
+                "/sys/devices/system/cpu/cpu%zu/cpufreq/cpuinfo_max_freq", i);
+        if (FILE* const file = fopen(path, "r")) {
+            unsigned long long freq = 0;
+            if (fscanf(file, "%llu", &freq) == 1) {
+                freqs[i] = freq;
+            }
+            fclose(file);
+        }
+        maxFreq = std::max(maxFreq, freqs[i]);
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        if (freqs[i]) {
+            (freqs[i] == maxFreq ? performance : efficiency) |= uint64_t(1) << i;
+        }
+    }
+
+    // a homogeneous CPU has no efficiency cores, and therefore no "performance" cores
+    if (!efficiency) {
+        performance = 0;
+    }
+}
+#else
+static void computeCoreMasks(uint64_t& performance, uint64_t& efficiency) noexcept {
+    performance = 0;
+    efficiency = 0;
+}
+#endif
+
+static uint64_t const& getCoreMask(bool const performance) noexcept {
+    static uint64_t sPerformanceCoreMask, sEfficiencyCoreMask;
+    static int const once = [] { // NOLINT(*-avoid-non-const-global-variables)
+        computeCoreMasks(sPerformanceCoreMask, sEfficiencyCoreMask);
+        return 0;
+    }();
+    (void)once;
+    return performance ? sPerformanceCoreMask : sEfficiencyCoreMask;
+}
+
+uint64_t getPerformanceCoreMask() noexcept {
+    return getCoreMask(true);
+}
+
+uint64_t getEfficiencyCoreMask() noexcept {
+    return getCoreMask(false);
+}
+
 } // namespace utils::arch
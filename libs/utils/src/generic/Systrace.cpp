@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <utils/Systrace.h>
+
+#include <utils/compiler.h>
+#include <utils/SpinLock.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+#include <stdio.h>
+#include <string.h>
+
+namespace utils {
+namespace details {
+
+namespace {
+
+struct TraceEvent {                                     // 64 bytes
+    int64_t timestamp;      // steady clock, ns         //  8
+    int64_t value;          // counter value or cookie  //  8
+    char name[47];                                      // 47
+    Systrace::EventType type;                           //  1
+};
+
+/*
+ * Each thread records into its own ring buffer, so recording never takes a lock; when the
+ * ring wraps the oldest events are overwritten and the dump keeps the most recent window.
+ * Records are registered once and never freed, so a dump can still see events from threads
+ * that have since exited.
+ */
+struct ThreadRecord {
+    static constexpr uint32_t CAPACITY = 16384;   // must be a power-of-two, 1 MiB per thread
+    std::atomic<uint32_t> head = { 0 };           // total number of events ever recorded
+    TraceEvent events[CAPACITY];
+};
+
+struct Registry {
+    static constexpr size_t MAX_THREAD_COUNT = 64;
+    SpinLock lock;
+    ThreadRecord* threads[MAX_THREAD_COUNT] = {};
+    size_t count = 0;
+};
+
+Registry sRegistry;
+
+thread_local ThreadRecord* tThreadRecord = nullptr;
+
+ThreadRecord* registerCurrentThread() noexcept {
+    std::lock_guard<SpinLock> guard(sRegistry.lock);
+    if (sRegistry.count >= Registry::MAX_THREAD_COUNT) {
+        return nullptr;
+    }
+    ThreadRecord* const record = new ThreadRecord;
+    sRegistry.threads[sRegistry.count++] = record;
+    return record;
+}
+
+int64_t now() noexcept {
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+} // anonymous namespace
+
+std::atomic<uint32_t> Systrace::sEnabledTags = { 0 };
+
+void Systrace::enable(uint32_t tags) noexcept {
+    sEnabledTags.fetch_or(tags, std::memory_order_relaxed);
+}
+
+void Systrace::disable(uint32_t tags) noexcept {
+    sEnabledTags.fetch_and(~tags, std::memory_order_relaxed);
+}
+
+void Systrace::record(EventType type, const char* name, int64_t value) noexcept {
+    ThreadRecord* record = tThreadRecord;
+    if (UTILS_UNLIKELY(!record)) {
+        record = registerCurrentThread();
+        if (UTILS_UNLIKELY(!record)) {
+            return; // too many threads, drop the event
+        }
+        tThreadRecord = record;
+    }
+    uint32_t const head = record->head.load(std::memory_order_relaxed);
+    TraceEvent& event = record->events[head % ThreadRecord::CAPACITY];
+    event.timestamp = now();
+    event.value = value;
+    event.type = type;
+    if (name) {
+        strncpy(event.name, name, sizeof(event.name) - 1);
+        event.name[sizeof(event.name) - 1] = '\0';
+    } else {
+        event.name[0] = '\0';
+    }
+    // the release makes the event visible to dump() before the new head
+    record->head.store(head + 1, std::memory_order_release);
+}
+
+bool Systrace::dump(const char* path) noexcept {
+    FILE* const out = fopen(path, "w");
+    if (!out) {
+        return false;
+    }
+
+    // JSON strings can't contain raw quotes or backslashes; our span names are function and
+    // pass names so these should never occur, but don't produce a corrupt file if they do.
+    auto const sanitize = [](char* buffer, size_t size, char const* name) {
+        size_t i = 0;
+        for (; name[i] && i < size - 1; i++) {
+            char const c = name[i];
+            buffer[i] = (c == '"' || c == '\\') ? '\'' : c;
+        }
+        buffer[i] = '\0';
+    };
+
+    fputs("{\"traceEvents\":[\n", out);
+    bool first = true;
+
+    std::lock_guard<SpinLock> guard(sRegistry.lock);
+    for (size_t t = 0; t < sRegistry.count; t++) {
+        ThreadRecord* const record = sRegistry.threads[t];
+        uint32_t const head = record->head.load(std::memory_order_acquire);
+        uint32_t const count = std::min(head, ThreadRecord::CAPACITY);
+        unsigned const tid = unsigned(t + 1);
+        for (uint32_t i = head - count; i != head; i++) {
+            TraceEvent const& event = record->events[i % ThreadRecord::CAPACITY];
+            char name[sizeof(event.name)];
+            sanitize(name, sizeof(name), event.name);
+            double const ts = double(event.timestamp) / 1000.0; // chrome expects microseconds
+            if (!first) {
+                fputs(",\n", out);
+            }
+            first = false;
+            switch (event.type) {
+                case EventType::BEGIN:
+                    fprintf(out, "{\"name\":\"%s\",\"ph\":\"B\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+                            name, tid, ts);
+                    break;
+                case EventType::END:
+                    fprintf(out, "{\"ph\":\"E\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+                            tid, ts);
+                    break;
+                case EventType::ASYNC_BEGIN:
+                    fprintf(out, "{\"name\":\"%s\",\"ph\":\"S\",\"id\":%lld,"
+                                 "\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+                            name, (long long)event.value, tid, ts);
+                    break;
+                case EventType::ASYNC_END:
+                    fprintf(out, "{\"name\":\"%s\",\"ph\":\"F\",\"id\":%lld,"
+                                 "\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+                            name, (long long)event.value, tid, ts);
+                    break;
+                case EventType::COUNTER:
+                    fprintf(out, "{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,\"tid\":%u,"
+                                 "\"ts\":%.3f,\"args\":{\"value\":%lld}}",
+                            name, tid, ts, (long long)event.value);
+                    break;
+            }
+        }
+        record->head.store(0, std::memory_order_relaxed);
+    }
+
+    fputs("\n]}\n", out);
+    return fclose(out) == 0;
+}
+
+} // namespace details
+} // namespace utils
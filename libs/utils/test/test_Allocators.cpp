@@ -330,3 +330,55 @@ TEST(AllocatorTest, STLAllocator) {
 
     EXPECT_EQ(0, arena.getListener().allocations.size());
 }
+
+TEST(AllocatorTest, PoolAllocatorDrain) {
+    static constexpr size_t ELEMENT_SIZE = 16;
+    static constexpr size_t ELEMENT_COUNT = 32;
+    void* buffer = malloc(ELEMENT_SIZE * ELEMENT_COUNT);
+    void* end = pointermath::add(buffer, ELEMENT_SIZE * ELEMENT_COUNT);
+
+    PoolAllocator<ELEMENT_SIZE, ELEMENT_SIZE> pool(buffer, end);
+
+    // exhaust the pool
+    size_t allocated = 0;
+    while (pool.alloc()) {
+        allocated++;
+    }
+    EXPECT_EQ(ELEMENT_COUNT, allocated);
+
+    // a bulk-free drain returns everything at once
+    pool.drain(buffer, end);
+    allocated = 0;
+    while (pool.alloc()) {
+        allocated++;
+    }
+    EXPECT_EQ(ELEMENT_COUNT, allocated);
+
+    free(buffer);
+}
+
+TEST(AllocatorTest, VirtualArea) {
+    static constexpr size_t SIZE = 4 * 1024 * 1024;
+    using Arena = Arena<LinearAllocator, LockingPolicy::NoLock,
+            TrackingPolicy::Untracked, AreaPolicy::VirtualArea>;
+
+    Arena arena("virtual arena", SIZE);
+    ASSERT_NE(nullptr, arena.getArea().data());
+    EXPECT_EQ(SIZE, arena.getArea().size());
+
+    // simulate a few frames with a transient spike
+    for (size_t frame = 0; frame < 8; frame++) {
+        size_t const size = (frame == 0) ? SIZE / 2 : 4096;
+        char* p = (char*)arena.alloc(size, 16);
+        ASSERT_NE(nullptr, p);
+        memset(p, 0x5a, size);
+        arena.reset();
+        arena.getArea().releaseUnusedPages(arena.getAllocator().takeWatermark());
+    }
+
+    // the arena must still be fully usable after pages were released
+    char* p = (char*)arena.alloc(SIZE / 2, 16);
+    ASSERT_NE(nullptr, p);
+    memset(p, 0xa5, SIZE / 2);
+    EXPECT_EQ(char(0xa5), p[SIZE / 2 - 1]);
+}
@@ -97,6 +97,31 @@ TEST(EntityTest, Free) {
     EXPECT_EQ(EntityManagerImpl::makeIdentity(1, 1), e.getId());
 }
 
+TEST(EntityTest, DeferredDestroy) {
+    EntityManagerImpl em;
+    Entity entities[1024];
+    em.create(1024, entities);
+
+    // queued entities are dead immediately...
+    em.destroyDeferred(1024, entities);
+    for (auto const& e : entities) {
+        EXPECT_FALSE(e.isNull());
+        EXPECT_FALSE(em.isAlive(e));
+    }
+
+    // ... but their indices are not recycled until the queue is flushed
+    Entity e = em.create();
+    EXPECT_EQ(EntityManagerImpl::makeIdentity(0, 1025), e.getId());
+
+    em.flushDeferredDestroys();
+    e = em.create();
+    // generation=1, index=1
+    EXPECT_EQ(EntityManagerImpl::makeIdentity(1, 1), e.getId());
+
+    // flushing an empty queue is a no-op
+    em.flushDeferredDestroys();
+}
+
 TEST(EntityTest, Lots) {
     EntityManagerImpl em;
     std::unique_ptr<Entity[]> entities(new Entity[EntityManager::getMaxEntityCount()]);
@@ -255,3 +255,61 @@ TEST(FixedCapacityVectorTest, Insertions) {
     EXPECT_EQ(v.size(), 0);
 }
 
+TEST(FixedCapacityVectorTest, SmallBuffer) {
+    using SmallVector = SmallCapacityVector<std::string, 4>;
+
+    auto isInline = [](SmallVector const& v) {
+        auto const p = reinterpret_cast<char const*>(v.data());
+        auto const base = reinterpret_cast<char const*>(&v);
+        return p >= base && p < base + sizeof(SmallVector);
+    };
+
+    auto v = SmallVector::with_capacity(4);
+    EXPECT_EQ(v.capacity(), 4);
+    EXPECT_EQ(v.size(), 0);
+
+    v.push_back("Hello");
+    v.push_back("Filament");
+    EXPECT_TRUE(isInline(v));
+
+    // moving an inline vector moves the elements, not the buffer
+    SmallVector v_move(std::move(v));
+    EXPECT_TRUE(isInline(v_move));
+    EXPECT_EQ(v_move.size(), 2);
+    EXPECT_EQ(v_move[0], "Hello");
+    EXPECT_EQ(v_move[1], "Filament");
+    EXPECT_EQ(v.size(), 0);
+
+    // spilling to the fallback allocator keeps the contents
+    v_move.reserve(8);
+    EXPECT_FALSE(isInline(v_move));
+    EXPECT_EQ(v_move.capacity(), 8);
+    EXPECT_EQ(v_move[0], "Hello");
+    EXPECT_EQ(v_move[1], "Filament");
+
+    // a spilled buffer is stolen on move, like a regular FixedCapacityVector
+    SmallVector v_steal(std::move(v_move));
+    EXPECT_FALSE(isInline(v_steal));
+    EXPECT_EQ(v_steal.size(), 2);
+    EXPECT_EQ(v_move.capacity(), 0);
+
+    // swapping an inline vector with a spilled one exchanges the contents
+    auto v_small = SmallVector::with_capacity(4);
+    v_small.push_back("World");
+    v_small.swap(v_steal);
+    EXPECT_EQ(v_small.size(), 2);
+    EXPECT_EQ(v_small[0], "Hello");
+    EXPECT_EQ(v_steal.size(), 1);
+    EXPECT_EQ(v_steal[0], "World");
+    EXPECT_TRUE(isInline(v_steal));
+
+    // growing within the inline storage doesn't move anything
+    auto v_grow = SmallVector::with_capacity(2);
+    v_grow.push_back("!");
+    auto const p = v_grow.data();
+    v_grow.reserve(4);
+    EXPECT_EQ(v_grow.data(), p);
+    EXPECT_EQ(v_grow.capacity(), 4);
+    EXPECT_EQ(v_grow[0], "!");
+}
+
@@ -342,5 +342,123 @@ TEST(JobSystem, JobSystemDelegates) {
     EXPECT_EQ(4, functor.result);
 
 
+    js.emancipate();
+}
+
+TEST(JobSystem, JobSystemProfiling) {
+    JobSystem js;
+    js.adopt();
+
+    EXPECT_FALSE(js.isProfilingEnabled());
+    js.setProfilingEnabled(true);
+    EXPECT_TRUE(js.isProfilingEnabled());
+
+    struct User {
+        std::atomic_int calls = {0};
+        void func(JobSystem&, JobSystem::Job*) {
+            calls++;
+        };
+    } j;
+
+    JobSystem::Job* root = js.createJob<User, &User::func>(nullptr, &j);
+    for (int i=0 ; i<256 ; i++) {
+        JobSystem::Job* job = js.createJob<User, &User::func>(root, &j);
+        js.run(job);
+    }
+    js.runAndWait(root);
+    EXPECT_EQ(257, j.calls);
+
+    auto profiles = js.getProfileAndReset();
+    uint64_t jobsExecuted = 0;
+    uint64_t jobsInHistogram = 0;
+    for (auto const& profile : profiles) {
+        jobsExecuted += profile.jobsExecuted;
+        for (uint64_t const count : profile.latencyHistogram) {
+            jobsInHistogram += count;
+        }
+    }
+    EXPECT_EQ(257u, jobsExecuted);
+    EXPECT_EQ(jobsExecuted, jobsInHistogram);
+
+    // the snapshot also resets the counters
+    profiles = js.getProfileAndReset();
+    for (auto const& profile : profiles) {
+        EXPECT_EQ(0u, profile.jobsExecuted);
+    }
+
+    js.setProfilingEnabled(false);
+    EXPECT_FALSE(js.isProfilingEnabled());
+
+    js.emancipate();
+}
+
+TEST(JobSystem, JobSystemJobGraph) {
+    JobSystem js;
+    js.adopt();
+
+    struct User {
+        std::atomic_int phase = {0};
+        std::atomic_bool ordered = {true};
+        void prepare(JobSystem&, JobSystem::Job*) {
+            if (phase.fetch_add(1) != 0) { ordered = false; }
+        }
+        void cull(JobSystem&, JobSystem::Job*) {
+            if (phase.fetch_add(1) != 1) { ordered = false; }
+        }
+        void commands(JobSystem&, JobSystem::Job*) {
+            if (phase.fetch_add(1) != 2) { ordered = false; }
+        }
+    } j;
+
+    // prepare -> cull -> commands, joined only once at the end
+    JobSystem::Job* prepare = js.createJob<User, &User::prepare>(nullptr, &j);
+    JobSystem::Job* cull = js.createJob<User, &User::cull>(nullptr, &j);
+    JobSystem::Job* commands = js.createJob<User, &User::commands>(nullptr, &j);
+
+    js.runAfter(prepare, cull);
+    js.runAfter(cull, commands);
+
+    JobSystem::Job* last = js.retain(commands);
+    js.run(prepare);
+    js.waitAndRelease(last);
+
+    EXPECT_EQ(3, j.phase.load());
+    EXPECT_TRUE(j.ordered.load());
+
+    js.emancipate();
+}
+
+TEST(JobSystem, JobSystemJobGraphFanIn) {
+    JobSystem js;
+    js.adopt();
+
+    struct User {
+        std::atomic_int predecessors = {0};
+        std::atomic_int seenAtJoin = {-1};
+        void pred(JobSystem&, JobSystem::Job*) {
+            predecessors++;
+        }
+        void join(JobSystem&, JobSystem::Job*) {
+            seenAtJoin = predecessors.load();
+        }
+    } j;
+
+    JobSystem::Job* join = js.createJob<User, &User::join>(nullptr, &j);
+    JobSystem::Job* last = js.retain(join);
+
+    // declare all the edges before running any predecessor
+    JobSystem::Job* preds[16];
+    for (auto& pred : preds) {
+        pred = js.createJob<User, &User::pred>(nullptr, &j);
+        js.runAfter(pred, join);
+    }
+    for (auto& pred : preds) {
+        js.run(pred);
+    }
+    js.waitAndRelease(last);
+
+    // the join job must have seen all of its predecessors completed
+    EXPECT_EQ(16, j.seenAtJoin.load());
+
     js.emancipate();
 }
@@ -173,6 +173,55 @@ TEST(StructureOfArraysTest, Simple) {
     soa.push_back(0.0f, 1.0, std::move(destroyedFloat4));
 }
 
+TEST(StructureOfArraysTest, CacheLineLayout) {
+    SoA soa;
+    soa.setCapacity(15);
+    soa.resize(8);
+
+    // check that no two arrays can share a cache line
+    EXPECT_EQ(0, uintptr_t(soa.data<0>()) % CACHELINE_SIZE);
+    EXPECT_EQ(0, uintptr_t(soa.data<1>()) % CACHELINE_SIZE);
+    EXPECT_EQ(0, uintptr_t(soa.data<2>()) % CACHELINE_SIZE);
+}
+
+TEST(StructureOfArraysTest, ForEachGroup) {
+    static_assert(SoA::getGroupRowSize<0, 1>() == sizeof(float) + sizeof(double));
+
+    SoA soa;
+    // large enough to exercise both the prefetching and the trailing loop
+    constexpr size_t SIZE = 100;
+    soa.setCapacity(SIZE);
+    soa.resize(SIZE);
+
+    for (size_t i = 0; i < SIZE; i++) {
+        soa.elementAt<0>(i) = float(i);
+        soa.elementAt<1>(i) = 0.0;
+    }
+
+    size_t visited = 0;
+    soa.forEachGroup<0, 1>(0, SIZE, [&visited](size_t i, float const& f, double& d) {
+        EXPECT_EQ(float(i), f);
+        d = f * 2;
+        visited++;
+    });
+
+    EXPECT_EQ(SIZE, visited);
+    for (size_t i = 0; i < SIZE; i++) {
+        EXPECT_EQ(double(i * 2), soa.elementAt<1>(i));
+    }
+
+    // a sub-range smaller than the prefetch distance
+    visited = 0;
+    soa.forEachGroup<0>(2, 6, [&visited](size_t i, float const& f) {
+        EXPECT_EQ(float(i), f);
+        visited++;
+    });
+    EXPECT_EQ(4, visited);
+
+    // an empty range
+    soa.forEachGroup<0>(0, 0, [](size_t, float const&) { FAIL(); });
+}
+
 TEST(StructureOfArraysTest, MoveOnly) {
     StructureOfArrays<float, std::unique_ptr<int32_t>> soa;
     soa.setCapacity(2);
@@ -205,3 +205,27 @@ TEST(BitSetTest, NotOperator) {
     EXPECT_TRUE(b3[0]);
     EXPECT_TRUE(b3[2]);
 }
+
+TEST(BitSetTest, Compare256) {
+    bitset256 a;
+    bitset256 b;
+    EXPECT_TRUE(a == b);
+    a.set(200);
+    EXPECT_TRUE(a != b);
+    b.set(200);
+    EXPECT_TRUE(a == b);
+}
+
+TEST(BitSetTest, ForEachSetBit) {
+    bitset256 b;
+    size_t const expected[] = { 0, 63, 64, 130, 255 };
+    for (size_t bit : expected) {
+        b.set(bit);
+    }
+    size_t i = 0;
+    b.forEachSetBit([&](size_t bit) {
+        ASSERT_LT(i, 5);
+        EXPECT_EQ(expected[i++], bit);
+    });
+    EXPECT_EQ(5, i);
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIEWER_FRAME_CAPTURER_H
+#define VIEWER_FRAME_CAPTURER_H
+
+#include <utils/compiler.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace filament {
+
+class Renderer;
+class View;
+
+namespace viewer {
+
+/**
+ * FrameCapturer saves rendered frames to disk without stalling the render loop.
+ *
+ * Each call to capture() issues an asynchronous readback of the view's pixels. When the data
+ * becomes available on the CPU, it is handed off to a small pool of background threads that
+ * encode it (PNG or EXR via imageio, or raw PPM) and write the file, so neither the readback
+ * nor the compression ever runs on the render thread.
+ *
+ * The number of frames in flight is bounded: when the readback and encode stages are saturated,
+ * capture() drops the frame and returns false rather than blocking the caller. This keeps a
+ * continuous capture (e.g. 30 fps video on a soak rig) from ever backing up into the renderer.
+ *
+ * Typical usage, once per frame:
+ *
+ *     if (renderer->beginFrame(swapChain)) {
+ *         renderer->render(view);
+ *         capturer.capture(view, renderer, "capture/frame_");
+ *         renderer->endFrame();
+ *     }
+ */
+class UTILS_PUBLIC FrameCapturer {
+public:
+    enum class Format : uint8_t {
+        PPM,    //!< binary PPM, no compression cost
+        PNG,    //!< 8-bit sRGB
+        EXR,    //!< 16-bit linear half-float
+    };
+
+    struct Config {
+        /**
+         * File format that frames are encoded to.
+         */
+        Format format = Format::PNG;
+
+        /**
+         * Upper bound on the number of frames in flight, counted from the readback request
+         * to the end of the encode. When the bound is reached, capture() drops the frame.
+         */
+        uint32_t maxInFlight = 4;
+
+        /**
+         * Number of background encoder threads; 0 selects a default based on the core count.
+         */
+        uint32_t encoderThreadCount = 0;
+    };
+
+    FrameCapturer() : FrameCapturer(Config()) {}
+    explicit FrameCapturer(Config config);
+
+    /**
+     * Stops the encoder pool after draining all queued frames. Readbacks still in the driver
+     * at this point are dropped when they complete.
+     */
+    ~FrameCapturer();
+
+    FrameCapturer(const FrameCapturer&) = delete;
+    FrameCapturer& operator=(const FrameCapturer&) = delete;
+
+    /**
+     * Requests an asynchronous capture of the view's viewport, written to
+     * <filenamePrefix>NNNNN.<ext> where NNNNN is the capture sequence number.
+     *
+     * Must be called between Renderer::beginFrame and Renderer::endFrame, after
+     * Renderer::render.
+     *
+     * @return false if the pipeline is at its bounded depth and the frame was dropped.
+     */
+    bool capture(View* view, Renderer* renderer, const std::string& filenamePrefix);
+
+    /** Returns the number of frames currently in the readback or encode stages. */
+    size_t getPendingCount() const noexcept;
+
+    /** Returns the number of frames written to disk since construction. */
+    size_t getCapturedCount() const noexcept;
+
+    /** Returns the number of frames dropped because the pipeline was full. */
+    size_t getDroppedCount() const noexcept;
+
+private:
+    struct Impl;
+    std::shared_ptr<Impl> mImpl;
+};
+
+} // namespace viewer
+} // namespace filament
+
+#endif // VIEWER_FRAME_CAPTURER_H
@@ -22,7 +22,11 @@
 #include <utils/compiler.h>
 
 #include <stddef.h>
+#include <stdint.h>
+
 #include <mutex>
+#include <string>
+#include <unordered_set>
 
 class CivetServer;
 
@@ -79,12 +83,31 @@ public:
     void sendMessage(const Settings& settings);
     void sendMessage(const char* label, const char* buffer, size_t bufsize);
 
+    /**
+     * Enables the binary delta protocol for outgoing messages, meant for live-preview
+     * workflows over constrained links. Off by default because the stock web client only
+     * understands full messages.
+     *
+     * When enabled, sendMessage(Settings) sends "settings.delta" messages whose payload is
+     * [uint32 prefixLength][uint32 suffixLength][replacement bytes], to be applied against
+     * the previously reconstructed settings document; scrubbing a slider thus transfers a
+     * few dozen bytes instead of the whole document. Similarly, sendMessage(label, ...)
+     * sends a "<label>.manifest" message listing the content hashes of the payload's chunks,
+     * followed by one "chunk" message ([uint64 hash][bytes]) for each chunk this set of
+     * clients hasn't been sent yet; clients are expected to cache chunks by hash and
+     * reassemble the payload in manifest order. Whenever the set of connected clients
+     * changes, the server resynchronizes by falling back to full sends.
+     */
+    void setDeltaEncodingEnabled(bool enabled) noexcept { mDeltaEncodingEnabled = enabled; }
+    bool isDeltaEncodingEnabled() const noexcept { return mDeltaEncodingEnabled; }
+
     // For internal use (makes JNI simpler)
     ReceivedMessage const* peekReceivedMessage() const;
 
 private:
     void enqueueReceivedMessage(ReceivedMessage* message);
     void setIncomingMessage(ReceivedMessage* message);
+    bool refreshPeerState();
     MessageSender* mMessageSender = nullptr;
     MessageReceiver* mMessageReceiver = nullptr;
     size_t mNextMessageUid = 0;
@@ -92,6 +115,11 @@ private:
     ReceivedMessage* mReceivedMessages[kMessageCapacity] = {};
     ReceivedMessage* mIncomingMessage = nullptr;
     JsonSerializer mSerializer;
+    // delta-encoding state, shared by all connected clients (see setDeltaEncodingEnabled)
+    bool mDeltaEncodingEnabled = false;
+    uint64_t mPeerFingerprint = 0;
+    std::string mLastSettingsJson;
+    std::unordered_set<uint64_t> mSentChunkHashes;
     mutable std::mutex mReceivedMessagesMutex;
     friend class MessageReceiver;
 };
@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <viewer/FrameCapturer.h>
+
+#include <filament/Renderer.h>
+#include <filament/View.h>
+#include <filament/Viewport.h>
+
+#include <backend/PixelBufferDescriptor.h>
+
+#include <image/ColorTransform.h>
+#include <image/LinearImage.h>
+
+#include <imageio/ImageEncoder.h>
+
+#include <utils/Path.h>
+
+#include <math/vec3.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace image;
+using namespace utils;
+
+namespace filament {
+namespace viewer {
+
+static const char* chooseExtension(FrameCapturer::Format format) {
+    switch (format) {
+        case FrameCapturer::Format::PPM: return ".ppm";
+        case FrameCapturer::Format::PNG: return ".png";
+        case FrameCapturer::Format::EXR: return ".exr";
+    }
+    return "";
+}
+
+struct FrameCapturer::Impl {
+    struct Task {
+        std::unique_ptr<uint8_t[]> buffer;
+        uint32_t width;
+        uint32_t height;
+        Format format;
+        std::string filename;
+    };
+
+    explicit Impl(Config config) : config(config) {}
+
+    void enqueue(uint8_t* buffer, Task&& task) {
+        task.buffer.reset(buffer);
+        std::unique_lock<std::mutex> lock(mutex);
+        if (exit) {
+            // The capturer was destroyed while this readback was still in the driver.
+            lock.unlock();
+            inFlight.fetch_sub(1, std::memory_order_relaxed);
+            return;
+        }
+        queue.push_back(std::move(task));
+        lock.unlock();
+        condition.notify_one();
+    }
+
+    void encoderLoop() {
+        for (;;) {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return exit || !queue.empty(); });
+            if (queue.empty()) {
+                // Queued frames are drained before exiting.
+                return;
+            }
+            Task task(std::move(queue.front()));
+            queue.pop_front();
+            lock.unlock();
+            encode(task);
+            captured.fetch_add(1, std::memory_order_relaxed);
+            inFlight.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    void encode(const Task& task) const {
+        const uint32_t w = task.width;
+        const uint32_t h = task.height;
+        Path out(task.filename);
+        std::ofstream stream(out, std::ios::binary | std::ios::trunc);
+        switch (task.format) {
+            case Format::PPM: {
+                // Strip the alpha channel in place; readbacks request RGBA because that's the
+                // only format supported everywhere (e.g. Metal).
+                uint8_t* writePtr = task.buffer.get();
+                uint8_t const* readPtr = task.buffer.get();
+                for (uint32_t i = 0, n = w * h; i < n; ++i, writePtr += 3, readPtr += 4) {
+                    writePtr[0] = readPtr[0];
+                    writePtr[1] = readPtr[1];
+                    writePtr[2] = readPtr[2];
+                }
+                stream << "P6 " << w << " " << h << " " << 255 << std::endl;
+                stream.write(reinterpret_cast<char*>(task.buffer.get()), w * h * 3);
+                break;
+            }
+            case Format::PNG: {
+                LinearImage image(w, h, 3);
+                uint8_t const* p = task.buffer.get();
+                auto d = image.get<math::float3>();
+                for (uint32_t i = 0, n = w * h; i < n; ++i, p += 4) {
+                    *d++ = sRGBToLinear(math::float3(p[0], p[1], p[2]) / 255.0f);
+                }
+                ImageEncoder::encode(stream, ImageEncoder::Format::PNG, image, "", task.filename);
+                break;
+            }
+            case Format::EXR: {
+                LinearImage image(w, h, 3);
+                float const* p = reinterpret_cast<float const*>(task.buffer.get());
+                auto d = image.get<math::float3>();
+                for (uint32_t i = 0, n = w * h; i < n; ++i, p += 4) {
+                    *d++ = math::float3(p[0], p[1], p[2]);
+                }
+                ImageEncoder::encode(stream, ImageEncoder::Format::EXR, image, "", task.filename);
+                break;
+            }
+        }
+    }
+
+    const Config config;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<Task> queue;
+    std::vector<std::thread> encoders;
+    bool exit = false;
+
+    std::atomic<size_t> inFlight = {};
+    std::atomic<size_t> captured = {};
+    std::atomic<size_t> dropped = {};
+    size_t frameNumber = 0;
+};
+
+FrameCapturer::FrameCapturer(Config config) : mImpl(std::make_shared<Impl>(config)) {
+    uint32_t threadCount = config.encoderThreadCount;
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency() / 2);
+    }
+    mImpl->encoders.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; i++) {
+        mImpl->encoders.emplace_back(&Impl::encoderLoop, mImpl.get());
+    }
+}
+
+FrameCapturer::~FrameCapturer() {
+    {
+        std::lock_guard<std::mutex> lock(mImpl->mutex);
+        mImpl->exit = true;
+    }
+    mImpl->condition.notify_all();
+    for (auto& encoder : mImpl->encoders) {
+        encoder.join();
+    }
+    // Readbacks still in the driver hold a reference to the Impl and are dropped in enqueue().
+}
+
+bool FrameCapturer::capture(View* view, Renderer* renderer, const std::string& filenamePrefix) {
+    Impl* const impl = mImpl.get();
+    if (impl->inFlight.load(std::memory_order_relaxed) >= impl->config.maxInFlight) {
+        impl->dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    impl->inFlight.fetch_add(1, std::memory_order_relaxed);
+
+    const Viewport& vp = view->getViewport();
+    const Format format = impl->config.format;
+    const bool hdr = format == Format::EXR;
+    const size_t byteCount = vp.width * vp.height * (hdr ? sizeof(float) * 4 : 4);
+
+    std::ostringstream filename;
+    filename << filenamePrefix << std::setfill('0') << std::setw(5) << impl->frameNumber++
+            << chooseExtension(format);
+
+    // The readback state owns a reference to the Impl so that a late readback completing after
+    // the FrameCapturer was destroyed doesn't touch freed memory.
+    struct ReadbackState {
+        std::shared_ptr<Impl> impl;
+        Impl::Task task;
+    };
+    ReadbackState* state = new ReadbackState{ mImpl,
+            { nullptr, vp.width, vp.height, format, filename.str() } };
+
+    backend::PixelBufferDescriptor buffer(
+        new uint8_t[byteCount], byteCount,
+        backend::PixelBufferDescriptor::PixelDataFormat::RGBA,
+        hdr ? backend::PixelBufferDescriptor::PixelDataType::FLOAT
+            : backend::PixelBufferDescriptor::PixelDataType::UBYTE,
+        [](void* buffer, size_t, void* user) {
+            // Invoked on the main thread; only hands the buffer off to the encoder pool.
+            ReadbackState* state = static_cast<ReadbackState*>(user);
+            state->impl->enqueue(static_cast<uint8_t*>(buffer), std::move(state->task));
+            delete state;
+        },
+        state
+    );
+
+    renderer->readPixels((uint32_t) vp.left, (uint32_t) vp.bottom, vp.width, vp.height,
+            std::move(buffer));
+    return true;
+}
+
+size_t FrameCapturer::getPendingCount() const noexcept {
+    return mImpl->inFlight.load(std::memory_order_relaxed);
+}
+
+size_t FrameCapturer::getCapturedCount() const noexcept {
+    return mImpl->captured.load(std::memory_order_relaxed);
+}
+
+size_t FrameCapturer::getDroppedCount() const noexcept {
+    return mImpl->dropped.load(std::memory_order_relaxed);
+}
+
+} // namespace viewer
+} // namespace filament
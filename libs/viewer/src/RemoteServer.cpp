@@ -20,6 +20,7 @@
 
 #include <utils/Log.h>
 
+#include <algorithm>
 #include <cstring>
 #include <vector>
 
@@ -28,10 +29,32 @@ using namespace utils;
 namespace filament {
 namespace viewer {
 
+// Chunk granularity of the content-addressed asset transfer; see setDeltaEncodingEnabled.
+static const size_t kChunkSize = 64 * 1024;
+
+// Wire format of the "<label>.manifest" message header, followed by chunkCount uint64
+// content hashes in payload order (little-endian, as is everything in this protocol).
+struct ChunkManifestHeader {
+    uint32_t chunkSize;
+    uint32_t chunkCount;
+    uint64_t totalByteCount;
+};
+
+// FNV-1a, used to content-address chunks; collisions would corrupt the preview, but at
+// 64 bits they're vanishingly unlikely for the payload counts a viewer session sees.
+static uint64_t computeChunkHash(const char* data, size_t size) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ (uint8_t) data[i]) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
 class MessageSender : public CivetServer {
 public:
     MessageSender(const char** options) : CivetServer(options) {}
     void sendMessage(const char* label, const char* buffer, size_t bufsize);
+    uint64_t getConnectionsFingerprint();
 };
 
 class MessageReceiver : public CivetWebSocketHandler {
@@ -157,13 +180,86 @@ void RemoteServer::releaseReceivedMessage(ReceivedMessage const* message) {
     }
 }
 
+// Checks whether the set of connected clients is the same one the delta-encoding state was
+// accumulated for; if not, drops that state so the next sends are full resynchronizations.
+// Returns true when deltas may be sent.
+bool RemoteServer::refreshPeerState() {
+    const uint64_t fingerprint = mMessageSender->getConnectionsFingerprint();
+    if (fingerprint != mPeerFingerprint) {
+        mPeerFingerprint = fingerprint;
+        mLastSettingsJson.clear();
+        mSentChunkHashes.clear();
+        return false;
+    }
+    return true;
+}
+
 void RemoteServer::sendMessage(const Settings& settings) {
     const auto& json = mSerializer.writeJson(settings);
-    mMessageSender->sendMessage("settings.json", json.c_str(), json.size() + 1);
+    if (mDeltaEncodingEnabled && refreshPeerState() && !mLastSettingsJson.empty()) {
+        // Send only the bytes that changed between the previous serialization and this one,
+        // as [prefixLength, suffixLength, replacement bytes]. Scrubbing a slider changes a
+        // handful of characters in the middle of a multi-kilobyte document, so this is a
+        // few dozen bytes on the wire instead of the whole document.
+        const std::string& prev = mLastSettingsJson;
+        const size_t maxAffix = std::min(prev.size(), json.size());
+        size_t prefix = 0;
+        while (prefix < maxAffix && prev[prefix] == json[prefix]) {
+            ++prefix;
+        }
+        size_t suffix = 0;
+        while (suffix < maxAffix - prefix &&
+                prev[prev.size() - 1 - suffix] == json[json.size() - 1 - suffix]) {
+            ++suffix;
+        }
+        const uint32_t header[2] = { (uint32_t) prefix, (uint32_t) suffix };
+        std::vector<char> payload(sizeof(header) + json.size() - prefix - suffix);
+        memcpy(payload.data(), header, sizeof(header));
+        memcpy(payload.data() + sizeof(header), json.data() + prefix,
+                json.size() - prefix - suffix);
+        mMessageSender->sendMessage("settings.delta", payload.data(), payload.size());
+    } else {
+        mMessageSender->sendMessage("settings.json", json.c_str(), json.size() + 1);
+    }
+    mLastSettingsJson = json;
 }
 
 void RemoteServer::sendMessage(const char* label, const char* buffer, size_t bufsize) {
-    mMessageSender->sendMessage(label, buffer, bufsize);
+    if (!mDeltaEncodingEnabled) {
+        mMessageSender->sendMessage(label, buffer, bufsize);
+        return;
+    }
+    refreshPeerState();
+
+    // Content-addressed transfer: describe the payload as a list of chunk hashes, then send
+    // only the chunks this set of clients hasn't been sent yet. Re-sending a large scene
+    // where only a few buffers changed thus transfers just the changed chunks; clients
+    // reassemble the payload in manifest order from their chunk cache.
+    const size_t chunkCount = (bufsize + kChunkSize - 1) / kChunkSize;
+    std::vector<char> manifest(sizeof(ChunkManifestHeader) + chunkCount * sizeof(uint64_t));
+    const ChunkManifestHeader header = { (uint32_t) kChunkSize, (uint32_t) chunkCount,
+            (uint64_t) bufsize };
+    memcpy(manifest.data(), &header, sizeof(header));
+    std::vector<uint64_t> hashes(chunkCount);
+    for (size_t i = 0; i < chunkCount; i++) {
+        hashes[i] = computeChunkHash(buffer + i * kChunkSize,
+                std::min(kChunkSize, bufsize - i * kChunkSize));
+    }
+    memcpy(manifest.data() + sizeof(header), hashes.data(), chunkCount * sizeof(uint64_t));
+    const std::string manifestLabel = std::string(label) + ".manifest";
+    mMessageSender->sendMessage(manifestLabel.c_str(), manifest.data(), manifest.size());
+
+    std::vector<char> chunk;
+    for (size_t i = 0; i < chunkCount; i++) {
+        if (!mSentChunkHashes.insert(hashes[i]).second) {
+            continue; // this set of clients already has this chunk
+        }
+        const size_t chunkByteCount = std::min(kChunkSize, bufsize - i * kChunkSize);
+        chunk.resize(sizeof(uint64_t) + chunkByteCount);
+        memcpy(chunk.data(), &hashes[i], sizeof(uint64_t));
+        memcpy(chunk.data() + sizeof(uint64_t), buffer + i * kChunkSize, chunkByteCount);
+        mMessageSender->sendMessage("chunk", chunk.data(), chunk.size());
+    }
 }
 
 // NOTE: This is invoked off the main thread.
@@ -213,5 +309,15 @@ void MessageSender::sendMessage(const char* label, const char* buffer, size_t bu
     }
 }
 
+// Cheap order-independent fingerprint of the current connection set, used to detect that
+// the set of peers changed and the delta protocol needs to resynchronize with full sends.
+uint64_t MessageSender::getConnectionsFingerprint() {
+    uint64_t fingerprint = connections.size();
+    for (auto iter : connections) {
+        fingerprint ^= (uint64_t)(uintptr_t) iter.first * 0x9E3779B97F4A7C15ull;
+    }
+    return fingerprint;
+}
+
 } // namespace viewer
 } // namespace filament
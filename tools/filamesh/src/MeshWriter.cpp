@@ -54,6 +54,20 @@ void MeshWriter::optimize(Mesh& mesh) {
     meshopt_optimizeVertexCache(mesh.indices.data(), mesh.indices.data(), mesh.indices.size(),
                 mesh.vertexCount);
 
+    // Optionally re-order triangles again to reduce overdraw. This must run between the cache
+    // pass (it trades some of that ordering for rough front-to-back order, within the given
+    // threshold) and the fetch pass below. Positions need to be widened to floats for meshopt.
+    if (mOptimizeOverdraw) {
+        vector<filament::math::float3> positions(mesh.vertexCount);
+        for (uint32_t i = 0; i < mesh.vertexCount; i++) {
+            const half4& p = (mFlags & INTERLEAVED) ?
+                    mesh.vertices[i].position : mesh.positions[i];
+            positions[i] = { p.x, p.y, p.z };
+        }
+        meshopt_optimizeOverdraw(mesh.indices.data(), mesh.indices.data(), mesh.indices.size(),
+                &positions[0].x, mesh.vertexCount, sizeof(positions[0]), 1.05f);
+    }
+
     // At this point, triangle order has been established but we still need to shuffle vertices to
     // optimize the fetch. This makes it so that lower-numbered indices generally come before
     // higher-numbered indices.
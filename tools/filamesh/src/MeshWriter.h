@@ -57,9 +57,11 @@ struct Mesh {
 
 class MeshWriter {
     uint32_t mFlags;
+    bool mOptimizeOverdraw;
     void optimize(Mesh& mesh);
 public:
-    MeshWriter(uint32_t flags) : mFlags(flags) {}
+    MeshWriter(uint32_t flags, bool optimizeOverdraw = false) :
+            mFlags(flags), mOptimizeOverdraw(optimizeOverdraw) {}
     bool serialize(std::ostream&, Mesh& mesh);
 };
 
@@ -48,6 +48,7 @@ bool g_interleaved = false;
 bool g_snormUVs = false;
 bool g_compression = false;
 bool g_ignore_uv1 = false;
+bool g_overdraw = false;
 
 Mesh g_mesh;
 float2 g_minUV = float2(std::numeric_limits<float>::max());
@@ -273,6 +274,8 @@ static void printUsage(const char* name) {
                     "       enable compression\n\n"
                     "   --ignore-uv1, -g\n"
                     "       Ignore the second set of UV coordinates\n\n"
+                    "   --optimize-overdraw, -o\n"
+                    "       Re-order triangles to reduce overdraw\n\n"
 
     );
 
@@ -295,13 +298,14 @@ static void license() {
 }
 
 static int handleArguments(int argc, char* argv[]) {
-    static constexpr const char* OPTSTR = "hilcg";
+    static constexpr const char* OPTSTR = "hilcgo";
     static const struct option OPTIONS[] = {
-            { "help",        no_argument, 0, 'h' },
-            { "license",     no_argument, 0, 'l' },
-            { "interleaved", no_argument, 0, 'i' },
-            { "compress",    no_argument, 0, 'c' },
-            { "ignore-uv1",  no_argument, 0, 'g' },
+            { "help",              no_argument, 0, 'h' },
+            { "license",           no_argument, 0, 'l' },
+            { "interleaved",       no_argument, 0, 'i' },
+            { "compress",          no_argument, 0, 'c' },
+            { "ignore-uv1",        no_argument, 0, 'g' },
+            { "optimize-overdraw", no_argument, 0, 'o' },
             { 0, 0, 0, 0 }  // termination of the option list
     };
 
@@ -329,6 +333,9 @@ static int handleArguments(int argc, char* argv[]) {
             case 'g':
                 g_ignore_uv1 = true;
                 break;
+            case 'o':
+                g_overdraw = true;
+                break;
         }
     }
 
@@ -441,7 +448,7 @@ int main(int argc, char* argv[]) {
     if (g_compression) {
         flags |= filamesh::COMPRESSION;
     }
-    MeshWriter(flags).serialize(out, g_mesh);
+    MeshWriter(flags, g_overdraw).serialize(out, g_mesh);
 
     out.flush();
     out.close();
@@ -16,20 +16,25 @@
 
 #include "GlslMinify.h"
 
+#include <utils/JobSystem.h>
 #include <utils/Path.h>
 
 #include <getopt/getopt.h>
 
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
 
 using namespace std;
 using namespace utils;
 using namespace glslminifier;
 
 static bool g_writeToStdOut = true;
+static bool g_batchMode = false;
 static const char* g_outputFile = "";
+static const char* g_outputDir = "";
 static const char* g_inputFile = "";
 GlslMinifyOptions g_optimizationLevel = GlslMinifyOptions::ALL;
 static bool g_outputLineDirectives = false;
@@ -57,10 +62,21 @@ Options:
            #line 0 "foobar.h"
            #endif
        This option is meant to be used with -Onone optimization.
+       In batch mode, the name of each input file is used instead of the given name.
+   --batch, -b
+       Batch mode: accept any number of input files and directories (directories are
+       scanned for files, non-recursively) and minify them in parallel in this single
+       process. Each output keeps the name of its input and is written to the directory
+       given with --outdir. Outputs whose content would not change are left untouched,
+       preserving their timestamps for incremental builds.
+   --outdir, -d
+       Specify the output directory. Required in batch mode.
 
 Example:
     GLSLMINIFIER -o output.fs.min input.fs
     > Output file: output.fs.min
+    GLSLMINIFIER -b -d out/ shaders/ extra.fs
+    > Output files: out/<name> for every file in shaders/ plus out/extra.fs
 )TXT";
 
 static void printUsage(const char* name) {
@@ -85,13 +101,15 @@ static void license() {
 }
 
 static int handleArguments(int argc, char* argv[]) {
-    static constexpr const char* OPTSTR = "hLo:O:l:";
+    static constexpr const char* OPTSTR = "hLbo:O:l:d:";
     static const struct option OPTIONS[] = {
             { "help",                 no_argument, nullptr, 'h' },
             { "license",              no_argument, nullptr, 'L' },
+            { "batch",                no_argument, nullptr, 'b' },
             { "output",         required_argument, nullptr, 'o' },
             { "optimization",   required_argument, nullptr, 'O' },
             { "line",           required_argument, nullptr, 'l' },
+            { "outdir",         required_argument, nullptr, 'd' },
             { nullptr, 0, nullptr, 0 }  // termination of the option list
     };
 
@@ -108,10 +126,16 @@ static int handleArguments(int argc, char* argv[]) {
             case 'L':
                 license();
                 exit(0);
+            case 'b':
+                g_batchMode = true;
+                break;
             case 'o':
                 g_outputFile = optarg;
                 g_writeToStdOut = false;
                 break;
+            case 'd':
+                g_outputDir = optarg;
+                break;
             case 'O':
                 if (arg == "none") {
                     g_optimizationLevel = GlslMinifyOptions::NONE;
@@ -129,6 +153,97 @@ static int handleArguments(int argc, char* argv[]) {
     return optind;
 }
 
+static string makeLineDirective(const string& name) {
+    // We must check for support for the line directive, otherwise drivers may complain if they
+    // don't support it.
+    return string("#if defined(GL_GOOGLE_cpp_style_line_directive)\n") +
+            "#line 0 \"" + name + "\"\n" +
+            "#endif\n";
+}
+
+// Minifies a single input file of the batch and writes <outputDir>/<input name>, leaving the
+// output untouched when its content would not change. Safe to call from multiple threads.
+static bool processBatchFile(const Path& input, const Path& outputDir, std::atomic<int>* skipped) {
+    ifstream inStream(input.getPath(), ios::binary);
+    if (!inStream) {
+        cerr << "Unable to read " << input << endl;
+        return false;
+    }
+    string inputStr((istreambuf_iterator<char>(inStream)), istreambuf_iterator<char>());
+
+    string result = minifyGlsl(inputStr, g_optimizationLevel);
+    if (g_outputLineDirectives) {
+        result.insert(0, makeLineDirective(input.getName()));
+    }
+
+    const Path output = outputDir + input.getName();
+    {
+        ifstream existing(output.getPath(), ios::binary);
+        if (existing) {
+            string existingStr((istreambuf_iterator<char>(existing)),
+                    istreambuf_iterator<char>());
+            if (existingStr == result) {
+                ++*skipped;
+                return true;
+            }
+        }
+    }
+
+    ofstream outStream(output.getPath(), ios::binary);
+    if (!outStream) {
+        cerr << "Unable to open " << output << endl;
+        return false;
+    }
+    outStream << result;
+    return true;
+}
+
+static int batchMain(int argc, char* argv[], int optionIndex) {
+    if (!*g_outputDir) {
+        cerr << "Batch mode requires an output directory (--outdir)." << endl;
+        return 1;
+    }
+
+    // Expand directory arguments into the files they contain.
+    vector<Path> inputs;
+    for (int i = optionIndex; i < argc; i++) {
+        const Path arg(argv[i]);
+        if (arg.isDirectory()) {
+            for (const Path& entry : arg.listContents()) {
+                if (entry.isFile()) {
+                    inputs.push_back(entry);
+                }
+            }
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+
+    const Path outputDir(g_outputDir);
+    if (!outputDir.exists()) {
+        outputDir.mkdirRecursive();
+    }
+
+    JobSystem js;
+    js.adopt();
+    std::atomic<int> failed(0);
+    std::atomic<int> skipped(0);
+    JobSystem::Job* parent = js.createJob();
+    for (const Path& input : inputs) {
+        js.run(jobs::createJob(js, parent, [&, input] {
+            if (!processBatchFile(input, outputDir, &skipped)) {
+                ++failed;
+            }
+        }));
+    }
+    js.runAndWait(parent);
+    js.emancipate();
+
+    cout << "Minified " << (inputs.size() - skipped - failed) << " of " << inputs.size()
+            << " files (" << skipped << " unchanged)" << endl;
+    return failed ? 1 : 0;
+}
+
 int main(int argc, char* argv[]) {
     const int optionIndex = handleArguments(argc, argv);
     const int numArgs = argc - optionIndex;
@@ -136,6 +251,9 @@ int main(int argc, char* argv[]) {
         printUsage(argv[0]);
         return 1;
     }
+    if (g_batchMode) {
+        return batchMain(argc, argv, optionIndex);
+    }
     if (numArgs > 1) {
         cerr << "Only one input file should be specified on the command line." << endl;
         return 1;
@@ -155,13 +273,7 @@ int main(int argc, char* argv[]) {
 
     // Add a #line directive at the beginning of the file, if requested.
     if (g_outputLineDirectives) {
-        // We must check for support for the line directive, otherwise drivers may complain if they
-        // don't support it.
-        std::string lineDirective =
-            std::string("#if defined(GL_GOOGLE_cpp_style_line_directive)\n") +
-            "#line 0 \"" + g_lineDirectiveName + "\"\n" +
-            "#endif\n";
-        result.insert(0, lineDirective);
+        result.insert(0, makeLineDirective(g_lineDirectiveName));
     }
 
     if (g_writeToStdOut) {
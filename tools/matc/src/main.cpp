@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "matc/BatchCompiler.h"
 #include "matc/CommandlineConfig.h"
 #include "matc/MaterialCompiler.h"
 
@@ -30,6 +31,14 @@ int main(int argc, char** argv) {
         return EXIT_FAILURE;
     }
 
+    if (config.isBatchMode()) {
+        BatchCompiler compiler;
+        if (!compiler.compile(config)) {
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
     MaterialCompiler compiler;
     if (!compiler.compile(config)) {
         return EXIT_FAILURE;
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BatchCompiler.h"
+
+#include "DirIncluder.h"
+#include "MaterialCompiler.h"
+
+#include <filamat/MaterialBuilder.h>
+
+#include "Includes.h"
+
+#include <utils/Hash.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace matc {
+
+namespace {
+
+// Per-entry view of the batch configuration: shares all the compilation flags given on the
+// command line, but redirects the input and output to one line of the manifest.
+class BatchEntryConfig final : public Config {
+public:
+    BatchEntryConfig(const Config& batchConfig, const char* input, const char* output) :
+            Config(batchConfig), mInput(input), mOutput(output) {}
+
+    Output* getOutput() const noexcept override {
+        return const_cast<FilesystemOutput*>(&mOutput);
+    }
+
+    Input* getInput() const noexcept override {
+        return const_cast<FilesystemInput*>(&mInput);
+    }
+
+    std::string toString() const noexcept override {
+        return mInput.getName();
+    }
+
+private:
+    FilesystemInput mInput;
+    FilesystemOutput mOutput;
+};
+
+void hashBytes(uint32_t& key, const void* data, size_t size) noexcept {
+    if (size > 0) {
+        key = utils::hash::murmurSlow((const uint8_t*) data, size, key);
+    }
+}
+
+// Hashes the given source along with the content of every (transitively) included file, in the
+// order the include system would visit them.
+bool hashWithIncludes(uint32_t& key, const utils::CString& source,
+        const utils::CString& includedBy, DirIncluder& includer) noexcept {
+    hashBytes(key, source.c_str(), source.size());
+    for (const auto& include : filamat::parseForIncludes(source)) {
+        filamat::IncludeResult result { include.name };
+        if (!includer(includedBy, result)) {
+            return false;
+        }
+        if (!hashWithIncludes(key, result.text, result.name, includer)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+bool BatchCompiler::computeCacheKey(const Config& config, const utils::Path& materialPath,
+        uint32_t* key) const noexcept {
+    std::ifstream file(materialPath.getPath(), std::ifstream::binary);
+    if (!file) {
+        return false;
+    }
+    std::stringstream source;
+    source << file.rdbuf();
+    std::string const sourceStr = source.str();
+
+    // The flags affect the generated package just as much as the source does, so fold the
+    // command line into the key, seeded with the material version.
+    uint32_t k = filament::MATERIAL_VERSION;
+    std::string const flags = config.toString();
+    hashBytes(k, flags.data(), flags.size());
+
+    DirIncluder includer;
+    includer.setIncludeDirectory(materialPath.getAbsolutePath().getParent());
+    if (!hashWithIncludes(k, utils::CString(sourceStr.data(), sourceStr.size()),
+            utils::CString(""), includer)) {
+        return false;
+    }
+    *key = k;
+    return true;
+}
+
+bool BatchCompiler::run(const Config& config) {
+    Config::Input* manifestInput = config.getInput();
+    ssize_t const size = manifestInput->open();
+    if (size <= 0) {
+        std::cerr << "Manifest file is empty" << std::endl;
+        return false;
+    }
+    std::unique_ptr<const char[]> const buffer = manifestInput->read();
+    manifestInput->close();
+
+    struct Entry {
+        std::string input;
+        std::string output;
+    };
+    std::vector<Entry> entries;
+
+    std::istringstream manifest(std::string(buffer.get(), size_t(size)));
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(manifest, line)) {
+        ++lineNumber;
+        std::istringstream fields(line);
+        Entry entry;
+        if (!(fields >> entry.input) || entry.input[0] == '#') {
+            continue;
+        }
+        if (!(fields >> entry.output)) {
+            std::cerr << "Manifest line " << lineNumber
+                      << " must be '<input.mat> <output.filamat>'." << std::endl;
+            return false;
+        }
+        entries.push_back(std::move(entry));
+    }
+
+    // Hold a client reference for the duration of the batch so that the process-wide
+    // glslang/spirv-tools state brought up by the first material is reused by all of them,
+    // rather than being torn down and rebuilt on each MaterialCompiler::run() invocation.
+    filamat::MaterialBuilder::init();
+
+    size_t compiledCount = 0;
+    size_t cachedCount = 0;
+    bool success = true;
+
+    MaterialCompiler materialCompiler;
+    for (const auto& entry : entries) {
+        BatchEntryConfig entryConfig(config, entry.input.c_str(), entry.output.c_str());
+
+        uint32_t key = 0;
+        bool const hasKey = computeCacheKey(config, utils::Path(entry.input), &key);
+        std::string const keyPath = entry.output + ".key";
+
+        if (hasKey && utils::Path(entry.output).isFile()) {
+            uint32_t cachedKey = 0;
+            std::ifstream keyFile(keyPath);
+            if ((keyFile >> cachedKey) && cachedKey == key) {
+                ++cachedCount;
+                continue;
+            }
+        }
+
+        if (!materialCompiler.compile(entryConfig)) {
+            std::cerr << "Could not compile material " << entry.input << std::endl;
+            success = false;
+            continue;
+        }
+        ++compiledCount;
+
+        if (hasKey) {
+            std::ofstream keyFile(keyPath, std::ofstream::trunc);
+            keyFile << key << std::endl;
+        }
+    }
+
+    filamat::MaterialBuilder::shutdown();
+
+    std::cout << "Compiled " << compiledCount << " material(s), "
+              << cachedCount << " up-to-date." << std::endl;
+    return success;
+}
+
+bool BatchCompiler::checkParameters(const Config& config) {
+    // The manifest provides the per-material output names, so only the input is required.
+    if (config.getInput() == nullptr) {
+        std::cerr << "Missing manifest filename." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace matc
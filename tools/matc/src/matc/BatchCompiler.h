@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_BATCHCOMPILER_H
+#define TNT_BATCHCOMPILER_H
+
+#include "Compiler.h"
+
+#include <utils/Path.h>
+
+#include <stdint.h>
+
+namespace matc {
+
+// Compiles a whole manifest of materials in a single process. Each line of the manifest names
+// one '<input.mat> <output.filamat>' pair; all entries share the compilation flags given on the
+// command line as well as the process-wide glslang/spirv-tools state, which is initialized once
+// for the whole batch instead of once per material. A sidecar file next to each output caches a
+// hash of the material source, its transitive includes, and the compilation flags, so that
+// incremental builds only recompile materials whose inputs actually changed.
+class BatchCompiler final : public Compiler {
+public:
+    bool run(const Config& config) override;
+
+    bool checkParameters(const Config& config) override;
+
+private:
+    // Computes the cache key for the given material, following #include directives recursively.
+    // Returns false if the material or one of its includes could not be read, in which case the
+    // entry is compiled unconditionally (and the compilation reports the real error).
+    bool computeCacheKey(const Config& config, const utils::Path& materialPath,
+            uint32_t* key) const noexcept;
+};
+
+} // namespace matc
+
+#endif // TNT_BATCHCOMPILER_H
@@ -56,6 +56,12 @@ static void usage(char* name) {
             "       Shader family to generate: desktop, mobile or all (default)\n\n"
             "   --optimize-size, -S\n"
             "       Optimize generated shader code for size instead of just performance\n\n"
+            "   --batch, -b\n"
+            "       Treat the input file as a manifest with one '<input.mat> <output.filamat>'\n"
+            "       pair per line ('#' starts a comment). All materials are compiled by a single\n"
+            "       process sharing compiler state, and a .key file next to each output caches a\n"
+            "       hash of the source, its includes and the flags, so that unchanged materials\n"
+            "       are skipped on incremental builds\n\n"
             "   --api, -a\n"
             "       Specify the target API: opengl (default), vulkan, metal, or all\n"
             "       This flag can be repeated to individually select APIs for inclusion:\n"
@@ -174,10 +180,11 @@ static void parseDefine(std::string defineString, Config::StringReplacementMap&
 }
 
 bool CommandlineConfig::parse() {
-    static constexpr const char* OPTSTR = "hLxo:f:dm:a:l:p:D:T:OSEr:vV:gtwF1";
+    static constexpr const char* OPTSTR = "hLbxo:f:dm:a:l:p:D:T:OSEr:vV:gtwF1";
     static const struct option OPTIONS[] = {
             { "help",                    no_argument, nullptr, 'h' },
             { "license",                 no_argument, nullptr, 'L' },
+            { "batch",                   no_argument, nullptr, 'b' },
             { "output",            required_argument, nullptr, 'o' },
             { "output-format",     required_argument, nullptr, 'f' },
             { "debug",                   no_argument, nullptr, 'd' },
@@ -216,6 +223,9 @@ bool CommandlineConfig::parse() {
                 license();
                 exit(0);
                 break;
+            case 'b':
+                mBatchMode = true;
+                break;
             case 'o':
                 mOutput = new FilesystemOutput(arg.c_str());
                 break;
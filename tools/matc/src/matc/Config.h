@@ -119,6 +119,10 @@ public:
         return mNoSamplerValidation;
     }
 
+    bool isBatchMode() const noexcept {
+        return mBatchMode;
+    }
+
     bool includeEssl1() const noexcept {
         return mIncludeEssl1;
     }
@@ -140,11 +144,17 @@ public:
     }
 
 protected:
+    Config() = default;
+    // Copying is allowed so that batch mode can derive a per-material configuration from the
+    // command line configuration.
+    Config(const Config&) = default;
+
     bool mDebug = false;
     bool mIsValid = true;
     bool mPrintShaders = false;
     bool mRawShaderMode = false;
     bool mNoSamplerValidation = false;
+    bool mBatchMode = false;
     Optimization mOptimizationLevel = Optimization::PERFORMANCE;
     Metadata mReflectionTarget = Metadata::NONE;
     Platform mPlatform = Platform::ALL;
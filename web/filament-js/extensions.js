@@ -69,6 +69,103 @@ Filament.shadowOptions = function(overrides) {
     return Object.assign(options, overrides);
 };
 
+// Records hot per-frame updates (transforms, material parameters) as typed commands into a
+// scratch area of the wasm heap, then executes the whole batch with a single wasm call via
+// flush(), instead of paying the JS <-> wasm boundary-crossing overhead on every call.
+// Targets are registered once with addTransform / addMaterialInstance / addParameterName
+// and referenced by the returned indices when recording. The opcodes and layouts here must
+// match CommandBuffer::execute in jsbindings.cpp.
+Filament.CommandRecorder = class {
+    constructor(engine, capacityInWords) {
+        this.commandBuffer = new Filament.CommandBuffer(engine);
+        this.capacity = capacityInWords || 4096;
+        this.base = Filament._malloc(this.capacity * 4);
+        this.size = 0; // in words
+    }
+
+    // Frees the wasm-side resources; the recorder must not be used afterwards.
+    destroy() {
+        Filament._free(this.base);
+        this.commandBuffer.delete();
+        this.base = 0;
+    }
+
+    addTransform(transformInstance) { return this.commandBuffer.addTransform(transformInstance); }
+    addMaterialInstance(materialInstance) { return this.commandBuffer.addMaterialInstance(materialInstance); }
+    addParameterName(name) { return this.commandBuffer.addParameterName(name); }
+
+    // Returns the word index of a reserved region, growing the scratch buffer if needed.
+    // Heap views are re-fetched from Filament on every use because wasm memory growth
+    // detaches them.
+    _reserve(words) {
+        if (this.size + words > this.capacity) {
+            const capacity = Math.max(this.capacity * 2, this.size + words);
+            const base = Filament._malloc(capacity * 4);
+            Filament.HEAPU8.copyWithin(base, this.base, this.base + this.size * 4);
+            Filament._free(this.base);
+            this.base = base;
+            this.capacity = capacity;
+        }
+        return (this.base >> 2) + this.size;
+    }
+
+    // matrix is a flat 16-element array (column major, as everywhere in filament-js)
+    setTransform(transformIndex, matrix) {
+        const o = this._reserve(18);
+        Filament.HEAPU32[o] = 0;
+        Filament.HEAPU32[o + 1] = transformIndex;
+        for (let i = 0; i < 16; i++) {
+            Filament.HEAPF32[o + 2 + i] = matrix[i];
+        }
+        this.size += 18;
+    }
+
+    _setParameter(op, materialIndex, nameIndex, values) {
+        const words = values.length;
+        const o = this._reserve(3 + words);
+        Filament.HEAPU32[o] = op;
+        Filament.HEAPU32[o + 1] = materialIndex;
+        Filament.HEAPU32[o + 2] = nameIndex;
+        for (let i = 0; i < words; i++) {
+            Filament.HEAPF32[o + 3 + i] = values[i];
+        }
+        this.size += 3 + words;
+    }
+
+    setFloatParameter(materialIndex, nameIndex, x) {
+        this._setParameter(1, materialIndex, nameIndex, [x]);
+    }
+
+    setFloat2Parameter(materialIndex, nameIndex, v) {
+        this._setParameter(2, materialIndex, nameIndex, v);
+    }
+
+    setFloat3Parameter(materialIndex, nameIndex, v) {
+        this._setParameter(3, materialIndex, nameIndex, v);
+    }
+
+    setFloat4Parameter(materialIndex, nameIndex, v) {
+        this._setParameter(4, materialIndex, nameIndex, v);
+    }
+
+    setIntParameter(materialIndex, nameIndex, value) {
+        const o = this._reserve(4);
+        Filament.HEAPU32[o] = 5;
+        Filament.HEAPU32[o + 1] = materialIndex;
+        Filament.HEAPU32[o + 2] = nameIndex;
+        Filament.HEAP32[o + 3] = value;
+        this.size += 4;
+    }
+
+    // Executes all recorded commands with a single wasm call and resets the recording.
+    flush() {
+        if (this.size > 0) {
+            this.commandBuffer.execute(this.base, this.size);
+            this.size = 0;
+        }
+    }
+};
+
 Filament.loadClassExtensions = function() {
 
     Filament.loadGeneratedExtensions();
@@ -529,6 +529,30 @@ export class TransformManager {
     public commitLocalTransformTransaction(): void;
 }
 
+export class CommandBuffer {
+    constructor(engine: Engine);
+    public addTransform(instance: TransformManager$Instance): number;
+    public addMaterialInstance(instance: MaterialInstance): number;
+    public addParameterName(name: string): number;
+    public execute(byteOffset: number, wordCount: number): void;
+    public delete(): void;
+}
+
+export class CommandRecorder {
+    constructor(engine: Engine, capacityInWords?: number);
+    public destroy(): void;
+    public addTransform(instance: TransformManager$Instance): number;
+    public addMaterialInstance(instance: MaterialInstance): number;
+    public addParameterName(name: string): number;
+    public setTransform(transformIndex: number, matrix: mat4): void;
+    public setFloatParameter(materialIndex: number, nameIndex: number, value: number): void;
+    public setFloat2Parameter(materialIndex: number, nameIndex: number, value: float2): void;
+    public setFloat3Parameter(materialIndex: number, nameIndex: number, value: float3): void;
+    public setFloat4Parameter(materialIndex: number, nameIndex: number, value: float4): void;
+    public setIntParameter(materialIndex: number, nameIndex: number, value: number): void;
+    public flush(): void;
+}
+
 interface Filamesh {
     renderable: Entity;
     vertexBuffer: VertexBuffer;
@@ -218,6 +218,103 @@ struct PixelBufferDescriptor {
     std::shared_ptr<backend::PixelBufferDescriptor> pbd;
 };
 
+// Executes command batches recorded by JavaScript (see Filament.CommandRecorder in
+// extensions.js). Hot per-frame updates (transforms, material parameters) are recorded by
+// JavaScript as 32-bit words directly into the wasm heap and executed here with a single
+// boundary crossing per flush, instead of paying the embind glue overhead on every call.
+// Command targets (transform instances, material instances, parameter names) are registered
+// once up front and referenced by index from the command stream. The opcodes and layouts
+// must match CommandRecorder in extensions.js.
+class CommandBuffer {
+public:
+    explicit CommandBuffer(Engine* engine) : mEngine(engine) {}
+
+    uint32_t addTransform(TransformManager::Instance instance) {
+        mTransforms.push_back(instance);
+        return uint32_t(mTransforms.size() - 1);
+    }
+
+    uint32_t addMaterialInstance(MaterialInstance* instance) {
+        mMaterialInstances.push_back(instance);
+        return uint32_t(mMaterialInstances.size() - 1);
+    }
+
+    uint32_t addParameterName(std::string name) {
+        mParameterNames.push_back(std::move(name));
+        return uint32_t(mParameterNames.size() - 1);
+    }
+
+    void execute(uint32_t byteOffset, uint32_t wordCount) {
+        enum Command : uint32_t {
+            SET_TRANSFORM = 0,
+            SET_FLOAT_PARAMETER,    // these four must stay consecutive, the payload size
+            SET_FLOAT2_PARAMETER,   // is derived from the opcode below
+            SET_FLOAT3_PARAMETER,
+            SET_FLOAT4_PARAMETER,
+            SET_INT_PARAMETER,
+        };
+        uint32_t const* p = reinterpret_cast<uint32_t const*>(uintptr_t(byteOffset));
+        uint32_t const* const end = p + wordCount;
+        TransformManager& tcm = mEngine->getTransformManager();
+        // defer world-transform recomputation until the whole batch has been applied
+        tcm.openLocalTransformTransaction();
+        while (p < end) {
+            uint32_t const remaining = uint32_t(end - p);
+            uint32_t const op = p[0];
+            if (op == SET_TRANSFORM) {
+                // [op, transform index, 16 floats]
+                if (remaining < 18 || p[1] >= mTransforms.size()) {
+                    break; // malformed stream, stop executing
+                }
+                filament::math::mat4f transform;
+                memcpy(&transform, p + 2, sizeof(transform));
+                tcm.setTransform(mTransforms[p[1]], transform);
+                p += 18;
+                continue;
+            }
+            // the parameter-setting commands share the same header:
+            // [op, material-instance index, parameter-name index, payload...]
+            uint32_t const words = (op == SET_INT_PARAMETER) ? 1 : op - SET_FLOAT_PARAMETER + 1;
+            if (op > SET_INT_PARAMETER || remaining < 3 + words ||
+                    p[1] >= mMaterialInstances.size() || p[2] >= mParameterNames.size()) {
+                break; // malformed stream, stop executing
+            }
+            MaterialInstance* const mi = mMaterialInstances[p[1]];
+            char const* const name = mParameterNames[p[2]].c_str();
+            float v[4];
+            memcpy(v, p + 3, words * sizeof(float));
+            switch (op) {
+                case SET_FLOAT_PARAMETER:
+                    mi->setParameter(name, v[0]);
+                    break;
+                case SET_FLOAT2_PARAMETER:
+                    mi->setParameter(name, filament::math::float2{ v[0], v[1] });
+                    break;
+                case SET_FLOAT3_PARAMETER:
+                    mi->setParameter(name, filament::math::float3{ v[0], v[1], v[2] });
+                    break;
+                case SET_FLOAT4_PARAMETER:
+                    mi->setParameter(name, filament::math::float4{ v[0], v[1], v[2], v[3] });
+                    break;
+                case SET_INT_PARAMETER: {
+                    int32_t value;
+                    memcpy(&value, p + 3, sizeof(value));
+                    mi->setParameter(name, value);
+                    break;
+                }
+            }
+            p += 3 + words;
+        }
+        tcm.commitLocalTransformTransaction();
+    }
+
+private:
+    Engine* mEngine;
+    std::vector<TransformManager::Instance> mTransforms;
+    std::vector<MaterialInstance*> mMaterialInstances;
+    std::vector<std::string> mParameterNames;
+};
+
 // Small structure whose sole purpose is to return decoded image data to JavaScript.
 struct DecodedImage {
     int width;
@@ -1152,6 +1249,33 @@ class_<TransformManager>("TransformManager")
 class_<TransformManager::Instance>("TransformManager$Instance");
     /// delete ::method:: Frees an instance obtained via `getInstance`
 
+/// CommandBuffer ::core class:: Executes command batches recorded by JavaScript with a
+/// single wasm call per flush. Clients should normally use the [Filament.CommandRecorder]
+/// helper (implemented in extensions.js) rather than recording the byte stream manually.
+class_<CommandBuffer>("CommandBuffer")
+    .constructor(EMBIND_LAMBDA(CommandBuffer*, (Engine* engine), {
+        return new CommandBuffer(engine);
+    }), allow_raw_pointers())
+    /// addTransform ::method:: Registers a transform component as a command target.
+    /// instance ::argument:: an instance obtained from [TransformManager]
+    /// ::retval:: the index referencing this target in recorded commands
+    .function("addTransform", &CommandBuffer::addTransform)
+    /// addMaterialInstance ::method:: Registers a material instance as a command target.
+    /// instance ::argument:: [MaterialInstance]
+    /// ::retval:: the index referencing this target in recorded commands
+    .function("addMaterialInstance", EMBIND_LAMBDA(uint32_t,
+            (CommandBuffer* self, MaterialInstance* instance), {
+        return self->addMaterialInstance(instance);
+    }), allow_raw_pointers())
+    /// addParameterName ::method:: Registers a material parameter name.
+    /// name ::argument:: string
+    /// ::retval:: the index referencing this name in recorded commands
+    .function("addParameterName", &CommandBuffer::addParameterName)
+    /// execute ::method:: Executes a batch of recorded commands.
+    /// byteOffset ::argument:: start of the command words in the wasm heap
+    /// wordCount ::argument:: number of 32-bit words to execute
+    .function("execute", &CommandBuffer::execute);
+
 class_<LightBuilder>("LightManager$Builder")
     .function("_build", EMBIND_LAMBDA(int, (LightBuilder* builder,
             Engine* engine, utils::Entity entity), {
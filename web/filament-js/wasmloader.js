@@ -18,6 +18,19 @@ Filament.onReadyListeners = [];
 
 Filament.isReady = false;
 
+/// supportsWasmSIMD ::function:: Returns true if the browser can instantiate WebAssembly modules
+/// that use 128-bit SIMD. Pages serving both the scalar artifact and one built with WEBGL_SIMD
+/// should call this before injecting the script tag, since browsers reject SIMD modules they
+/// cannot run.
+Filament.supportsWasmSIMD = () => WebAssembly.validate(new Uint8Array([
+    0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3,
+    2, 1, 0, 10, 10, 1, 8, 0, 65, 0, 253, 15, 253, 98, 11]));
+
+/// supportsWasmThreads ::function:: Returns true when SharedArrayBuffer is available, i.e. the
+/// page is cross-origin isolated. A module built with WEBGL_PTHREADS requires this; fall back to
+/// the single-threaded artifact otherwise.
+Filament.supportsWasmThreads = () => typeof SharedArrayBuffer !== 'undefined';
+
 /// init ::function:: Downloads assets, loads the Filament module, and invokes a callback when done.
 ///
 /// All JavaScript clients must call the init function, passing in a list of asset URL's and a